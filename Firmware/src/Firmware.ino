@@ -90,6 +90,7 @@
 #include "datastore.h"
 
 #include "ntp_server.h"
+#include "roughtime_server.h"
 #include "network.h"
 
 #define  GPSBAUD ( 9600 )
@@ -102,8 +103,9 @@ WiFiClient serverClients[MAX_SRV_CLIENTS];
 
 Timecore timec;
 
-hw_timer_t * timer = NULL;
-uint32_t millisec;
+/* Free running 64 bit timer, 80MHz APB / 2 , used to interpolate the sub seconds */
+hw_timer_t * timebase = NULL;
+#define TIMEBASE_FREQUENCY ( 40000000 )
 
 
 
@@ -112,11 +114,14 @@ uint32_t millisec;
 
 RTC_DS3231 rtc_clock;
 //RTC_DS1307 rtc_clock;
+/* The DS3231 is also the temperature sensor for the holdover */
+bool rtc_present = false;
 
 HardwareSerial hws(1);
 Ticker TimeKeeper;
 TinyGPSPlus gps;
 NTP_Server NTPServer;
+RoughtimeServer Roughtime;
 
 //U8G2_SSD1306_128X64_NONAME_F_HW_I2C oled_left(U8G2_R0, /* reset=*/ U8X8_PIN_NONE);
 //U8G2_SSD1306_128X64_NONAME_F_HW_I2C oled_right(U8G2_R0, /* reset=*/ U8X8_PIN_NONE);
@@ -142,8 +147,8 @@ volatile uint32_t pps_counter=0;
 bool pps_active = false;
 gps_settings_t gps_config;
 void Display_Task( void* param );
-uint32_t RTC_ReadUnixTimeStamp(bool* delayed_result);
-void RTC_WriteUnixTimestamp( uint32_t ts);
+ntp_time64_t RTC_ReadUnixTimeStamp(bool* delayed_result);
+void RTC_WriteUnixTimestamp( ntp_time64_t ts);
 
 
 
@@ -152,10 +157,10 @@ void RTC_WriteUnixTimestamp( uint32_t ts);
  *    Function      : GetUTCTime
  *    Description   : Reads the UTCTime
  *    Input         : none 
- *    Output        : uint32_t 
+ *    Output        : int64_t 
  *    Remarks       : none
  **************************************************************************************************/
- uint32_t GetUTCTime( void );
+ int64_t GetUTCTime( void );
 
 /**************************************************************************************************
  *    Function      : handlePPSInterrupt
@@ -167,36 +172,45 @@ void RTC_WriteUnixTimestamp( uint32_t ts);
 void IRAM_ATTR handlePPSInterrupt() {
  pps_counter++;
  UptimeCounter++;
- timec.RTC_Tick();
+ timec.PPS_Tick();
+ NTPServer.SecondTick();
  decGPSTimeout();
  pps_active = true; 
- //This needs to ne atomic
- millisec = 0; //The problem is that we may be interrupte by the subsecond ISR
  xSemaphoreGiveFromISR( xSemaphore, NULL );       
 }
 
 /**************************************************************************************************
- *    Function      : handleS
- *    Description   : Interrupt from internal Timer to get subseconds
+ *    Function      : GetSubsecond
+ *    Description   : Return the subseconds
  *    Input         : none 
- *    Output        : none
- *    Remarks       : needs to be placed in RAM ans is only allowed to call functions also in RAM
+ *    Output        : uint32_t 
+ *    Remarks       : return 0 to 999, read on demand from the timebase
  **************************************************************************************************/
-void IRAM_ATTR handleSubSecondInterrupt(){
-  if(millisec<999){
-    millisec++; //We coudl to some overhead and use a counting semaphore 
-  }
+uint32_t GetSubsecond( void ){
+  ntp_timestamp_t ts = timec.GetNTPTimestamp();
+  return (uint32_t)( ( (uint64_t)ts.fraction * 1000 ) >> 32 );
 }
 
 /**************************************************************************************************
- *    Function      : GetSubsecond
- *    Description   : Return the subseconds
+ *    Function      : ReadTimebase
+ *    Description   : Reads the free running timebase 
  *    Input         : none 
- *    Output        : uint32_t 
- *    Remarks       : return 0 to 999
+ *    Output        : uint64_t 
+ *    Remarks       : needs to be placed in RAM as it is called from the PPS interrupt
  **************************************************************************************************/
-uint32_t GetSubsecond( void ){
-  return millisec;
+uint64_t IRAM_ATTR ReadTimebase( void ){
+  return timerRead(timebase);
+}
+
+/**************************************************************************************************
+ *    Function      : GetNTPTime
+ *    Description   : Returns the UTC time as NTP timestamp
+ *    Input         : none 
+ *    Output        : ntp_timestamp_t 
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_timestamp_t GetNTPTime( void ){
+  return timec.GetNTPTimestamp();
 }
 
 /**************************************************************************************************
@@ -224,6 +238,7 @@ void setup()
   Serial.println(F("Read Timecore Config"));
   timecoreconf_t cfg = read_timecoreconf();
   timec.SetConfig(cfg);
+  timec.SetLeap( read_leap_config() );
   /* This creates a new task bound to the APP CPU */
   xTaskCreatePinnedToCore(
    Display_Task,
@@ -271,6 +286,7 @@ void setup()
     Serial.println(F("I2C RTC at 0x68 found"));
     /* We need to initalize the rtc_clock */
     rtc_clock.begin(&Wire);
+    rtc_present = true;
 
     /* We now register the clock in the time core component */
     rtc_source_t I2C_DS3231;
@@ -283,7 +299,7 @@ void setup()
 
     /* Force a snyc to the clock */
     DateTime now = rtc_clock.now();
-    timec.SetUTC(now.unixtime()  , RTC_CLOCK );
+    timec.SetUTC(ntp_time64_from_unix(now.unixtime(), 0)  , RTC_CLOCK );
     
     /* Next is to output the time we have form the clock to the user */
     Serial.print(F("Read RTC Time:"));
@@ -294,8 +310,29 @@ void setup()
     Serial.println("RTC is Missing");
   }
   
+  /* The timebase needs to run before the first PPS interrupt will latch it */
+  timebase = timerBegin(1, 2, true);
+  timerStart(timebase);
+  /* A learned frequency lets the servo lock on the first edges */
+  timec.SetServoConfig( read_servo_config() );
+  timec.SetHoldoverConfig( read_holdover_config() );
+  timec.SetTimebase(ReadTimebase, TIMEBASE_FREQUENCY);
+
   /* Last step is to get the NTP running */
-  NTPServer.begin(123 , GetUTCTime, GetSubsecond );
+  NTPServer.begin(123 , GetNTPTime );
+  NTPServer.SetRateLimit( read_ratelimit_config() );
+  NTPServer.SetTimecore( &timec );
+  NTPServer.SetBroadcast( read_broadcast_config() );
+  ntp_keys_settings_t ntp_keys = read_ntp_keys_config();
+  NTPServer.SetKeys( &ntp_keys );
+  nts_settings_t nts_conf = read_nts_config();
+  NTPServer.SetNTS( &nts_conf );
+  ntp_txcal_settings_t txcal_conf = read_txcal_config();
+  NTPServer.SetTxCalibration( &txcal_conf );
+  /* Roughtime runs next to NTP on its own port */
+  Roughtime.begin(2002 , GetNTPTime );
+  roughtime_settings_t rt_conf = read_roughtime_config();
+  Roughtime.SetConfig( &rt_conf );
   /* Now we start with the config for the Timekeeping and sync */
   TimeKeeper.attach_ms(200, _200mSecondTick);
 
@@ -308,11 +345,6 @@ void setup()
   if (hws.available() > 0) {
                 byte incomingByte = hws.read();
   }
-
-  timer = timerBegin(0, 80, true);
-  timerAttachInterrupt(timer, &handleSubSecondInterrupt, true);
-  timerAlarmWrite(timer, 1000, true);
-  timerAlarmEnable(timer);
   
 }
 
@@ -323,10 +355,10 @@ void setup()
  *    Output        : none
  *    Remarks       : none
  **************************************************************************************************/
-uint32_t GetUTCTime( void ){
-  uint32_t timest = 0;
-  timest = timec.GetUTC();
-  Serial.printf("Timestamp is %i\n\r",timest);
+int64_t GetUTCTime( void ){
+  int64_t timest = 0;
+  timest = timec.GetUnixTime();
+  Serial.printf("Timestamp is %lld\n\r",timest);
   return timest;
 }
 
@@ -369,6 +401,7 @@ void _200mSecondTick( void ){
    if( callcount >=5 ){
      if(false == pps_active ){
        timec.RTC_Tick();
+       NTPServer.SecondTick();
        GPS_Timeout=0;
        UptimeCounter++; 
        xSemaphoreGive(  xSemaphore );   
@@ -390,6 +423,7 @@ void _200mSecondTick( void ){
     pps_active=false;
     callcount=2;
     timec.RTC_Tick();
+    NTPServer.SecondTick();
     GPS_Timeout=0;
     UptimeCounter++; 
     xSemaphoreGive(  xSemaphore );       
@@ -399,6 +433,10 @@ void _200mSecondTick( void ){
    
    pps_count_last=pps_counter;
    last_pps_state = pps_active;   
+
+   /* Keep the NTP response header up to date, it is only rebuilt if something has changed */
+   NTPServer.RefreshServerState();
+   Roughtime.UpdateServerState( NTPServer.GetServerState() );
 }
 
 /**************************************************************************************************
@@ -486,6 +524,120 @@ void TelenetDebugServerTx( int16_t Data ){
 }
 
 
+/**************************************************************************************************
+ *    Function      : PrintLatency
+ *    Description   : Prints the latency histograms of the NTP packet path to the console
+ *    Input         : none 
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void PrintLatency( void ){
+  uint32_t cycles_per_us = NTP_LatencyStats::GetCyclesPerUs();
+  if( NTP_LATENCY_STATS == 0 ){
+    Serial.println(F("Latency stats compiled out"));
+    return;
+  }
+  Serial.printf("NTP latency in cycles, %u per us\n\r", cycles_per_us);
+  for(uint8_t i=0;i<NTP_LATENCY_STAGES;i++){
+    ntp_latency_summary_t s = NTPServer.GetLatency((ntp_latency_stage_t)i);
+    Serial.printf("%-9s count %u p50 %u p99 %u max %u\n\r", NTP_LatencyStats::GetStageName((ntp_latency_stage_t)i), s.count, s.p50, s.p99, s.max);
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : SerialConsoleService
+ *    Description   : Reads commands from the USB serial console
+ *    Input         : none 
+ *    Output        : none
+ *    Remarks       : "latency" prints the packet path latency, "latency reset" clears it
+ **************************************************************************************************/
+void SerialConsoleService( void ){
+  static char line[32];
+  static uint8_t len = 0;
+  while(Serial.available()){
+    char c = Serial.read();
+    if( (c != '\r') && (c != '\n') ){
+      if(len < ( sizeof(line) - 1 ) ){
+        line[len++] = c;
+      }
+      continue;
+    }
+    line[len] = 0;
+    if(0 == strcmp(line, "latency")){
+      PrintLatency();
+    } else if(0 == strcmp(line, "latency reset")){
+      NTPServer.ResetLatency();
+      Serial.println(F("Latency stats cleared"));
+    }
+    len = 0;
+  }
+}
+
+
+/**************************************************************************************************
+ *    Function      : TxCalibrationService
+ *    Description   : Stores the result of a finished transmit calibration
+ *    Input         : none 
+ *    Output        : none
+ *    Remarks       : Done from here, the packet path can't wait for the EEPROM
+ **************************************************************************************************/
+void TxCalibrationService( void ){
+  ntp_txcal_settings_t conf;
+  if(true == NTPServer.TakeTxCalibration(&conf)){
+    write_txcal_config(conf);
+    Serial.println(F("Transmit delay calibrated"));
+  }
+}
+
+
+/**************************************************************************************************
+ *    Function      : ServoService
+ *    Description   : Stores the timebase frequency learned from the PPS
+ *    Input         : none 
+ *    Output        : none
+ *    Remarks       : Only if it moved, the EEPROM is not written every second
+ **************************************************************************************************/
+void ServoService( void ){
+  ntp_servo_settings_t conf;
+  if(true == timec.TakeServoSettings(&conf)){
+    write_servo_config(conf);
+    Serial.printf("Timebase frequency %d ppb stored\n\r", conf.frequency);
+  }
+}
+
+
+/**************************************************************************************************
+ *    Function      : HoldoverService
+ *    Description   : Feeds the DS3231 temperature to the holdover and stores the learned curve
+ *    Input         : none 
+ *    Output        : none
+ *    Remarks       : Runs without a sensor too, the holdover then goes without compensation
+ **************************************************************************************************/
+void HoldoverService( void ){
+  static uint32_t last_sample = 0;
+  static bool sampled = false;
+  if( (true == sampled) && ( (millis() - last_sample) < (NTP_HOLDOVER_SAMPLE_INTERVAL * 1000) ) ){
+    return;
+  }
+  sampled = true;
+  last_sample = millis();
+  bool valid = false;
+  int16_t temperature = 0;
+  if( (true == rtc_present) && (true == xSemaphoreTake(xi2cmtx,(100 / portTICK_PERIOD_MS) ) ) ){
+    /* 0.25°C steps */
+    temperature = (int16_t)lroundf( rtc_clock.getTemperature() * 4 );
+    xSemaphoreGive(xi2cmtx);
+    valid = true;
+  }
+  timec.SampleTemperature(valid, temperature);
+  ntp_holdover_settings_t conf;
+  if(true == timec.TakeHoldoverSettings(&conf)){
+    write_holdover_config(conf);
+    Serial.println(F("Holdover curve stored"));
+  }
+}
+
+
 /**************************************************************************************************
  *    Function      : loop
  *    Description   : Superloop
@@ -499,6 +651,12 @@ void loop()
   /* Process all networkservices */
   NetworkTask();
   TelnetDebugService();
+  SerialConsoleService();
+  TxCalibrationService();
+  ServoService();
+  HoldoverService();
+  /* A changed clock source is measured here, the busy reads would stall the timer task */
+  NTPServer.PrecisionService();
   /* timeupdate done here is here */
   while (hws.available()){
       int16_t Data = hws.read();
@@ -525,11 +683,11 @@ void loop()
           
           // Added by T. Godau DL9SEC 30.05.2020 
           // Fix for older GPS with the week number rollover problem (see https://en.wikipedia.org/wiki/GPS_Week_Number_Rollover)
-          uint32_t newtimestamp= timec.TimeStructToTimeStamp(newtime);
+          int64_t newtimestamp= timec.TimeStructToTimeStamp(newtime);
 
           if(gps_config.rollover_cnt>0){
 
-           newtimestamp += (  SECS_PER_WEEK * 1024 *gps_config.rollover_cnt );
+           newtimestamp += (  (int64_t)SECS_PER_WEEK * 1024 *gps_config.rollover_cnt );
           
           }
           
@@ -537,8 +695,8 @@ void loop()
           if( (true == gps_config.sync_on_gps) && (GPS_Timeout<=0) ){
             Serial.println("Update Time from GPS");
             Serial.printf("Date is: %i/%i/%i at %i:%i:%i \r\n",newtime.year,newtime.month,newtime.day,newtime.hour,newtime.minute,newtime.second);
-            //This function is overloaded and takes timestamps as time_t structs
-            timec.SetUTC(newtimestamp,GPS_CLOCK);
+            //The NTP era is resolved against the current time
+            timec.SetUTC(ntp_time64_from_unix(newtimestamp, 0),GPS_CLOCK);
             GPS_Timeout= 600; //10 Minute timeout
           } else {
             // Do nothing           
@@ -650,7 +808,7 @@ void Display_Task( void* param ){
           oled_ptr->drawGlyph(120,8,121);
       }
       oled_ptr->setFont(u8g2_font_inb16_mn ); 
-      datum_t utc_time = timec.ConvertToDatum(timec.GetUTC());
+      datum_t utc_time = timec.ConvertToDatum(timec.GetUnixTime());
       snprintf(timestr, sizeof(timestr),"%02d:%02d:%02d",utc_time.hour,utc_time.minute,utc_time.second);
       oled_ptr->drawStr(8,42,timestr);
       oled_ptr->setFont(u8g2_font_amstrad_cpc_extended_8f );
@@ -727,28 +885,29 @@ void Display_Task( void* param ){
  *    Function      : RTC_ReadUnixTimeStamp
  *    Description   : Writes a UTC Timestamp to the RTC
  *    Input         : bool*  
- *    Output        : uint32_t
- *    Remarks       : Requiered to do some conversation
+ *    Output        : ntp_time64_t
+ *    Remarks       : The DS3231 counts 2000 to 2099, well inside the NTP era pivot
  **************************************************************************************************/
-uint32_t RTC_ReadUnixTimeStamp(bool* delayed_result){
+ntp_time64_t RTC_ReadUnixTimeStamp(bool* delayed_result){
   DateTime now =  time(0);
   if( true == xSemaphoreTake(xi2cmtx,(100 / portTICK_PERIOD_MS) ) ){
    now = rtc_clock.now();
    xSemaphoreGive(xi2cmtx);
   }
    *delayed_result=false;
-   return now.unixtime();
+   return ntp_time64_from_unix(now.unixtime(), 0);
 }
 
 
 /**************************************************************************************************
  *    Function      : RTC_WriteUnixTimestamp
  *    Description   : Writes a UTC Timestamp to the RTC
- *    Input         : uint32_t 
+ *    Input         : ntp_time64_t 
  *    Output        : none
  *    Remarks       : Requiered to do some conversation
  **************************************************************************************************/
-void RTC_WriteUnixTimestamp( uint32_t ts){
+void RTC_WriteUnixTimestamp( ntp_time64_t time){
+   uint32_t ts = (uint32_t)ntp_time64_to_unix(time, timec.GetUnixTime());
    uint32_t start_wait = millis();
    if( true == xSemaphoreTake(xi2cmtx,(40 / portTICK_PERIOD_MS) ) ){  
     ts = ts + ( ( millis()-start_wait)/1000);
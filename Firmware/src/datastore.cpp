@@ -23,6 +23,36 @@ bool eepread_struct( void* element, uint32_t e_size, uint32_t startaddr  );
 #define NOTES_START 500
 /* notes take 512 byte */
 
+#define RATELIMITCONFIG_START 1100
+/* config is 6 byte + 4 byte */
+
+#define BROADCASTCONFIG_START 1120
+/* config is 4 byte + 4 byte */
+
+#define NTPKEYS_START 1140
+/* config is 224 byte + 4 byte */
+
+#define LEAPCONFIG_START 1380
+/* config is 8 byte + 4 byte */
+
+#define NTSCONFIG_START 1400
+/* config is 76 byte + 4 byte */
+
+#define ROUGHTIMECONFIG_START 1480
+/* config is 36 byte + 4 byte */
+
+#define TXCALCONFIG_START 1520
+/* config is 40 byte + 4 byte */
+
+#define SOFTAPCONFIG_START 1568
+/* config is 66 byte + 4 byte */
+
+#define SERVOCONFIG_START 1640
+/* config is 8 byte + 4 byte */
+
+#define HOLDOVERCONFIG_START 1660
+/* config is 320 byte + 4 byte */
+
 
 
 /**************************************************************************************************
@@ -182,6 +212,288 @@ ipv4_settings read_ipv4_settings( void ){
   return retval;
 }
 
+/**************************************************************************************************
+ *    Function      : write_ratelimit_config
+ *    Description   : writes the ntp rate limit config
+ *    Input         : ratelimit_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_ratelimit_config(ratelimit_settings_t c){
+  eepwrite_struct( ( (void*)(&c) ), sizeof(ratelimit_settings_t) , RATELIMITCONFIG_START );
+}
+
+/**************************************************************************************************
+ *    Function      : read_ratelimit_config
+ *    Description   : reads the ntp rate limit config
+ *    Input         : none
+ *    Output        : ratelimit_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ratelimit_settings_t read_ratelimit_config( void ){
+  ratelimit_settings_t retval;
+  if(false == eepread_struct( (void*)(&retval), sizeof(ratelimit_settings_t) , RATELIMITCONFIG_START ) ){ 
+    Serial.println("RATELIMIT CONF");
+    retval = NTP_RateLimiter::GetDefaultConfig();
+    write_ratelimit_config(retval);
+  }
+  return retval;
+}
+
+/**************************************************************************************************
+ *    Function      : write_broadcast_config
+ *    Description   : writes the ntp broadcast config
+ *    Input         : broadcast_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_broadcast_config(broadcast_settings_t c){
+  eepwrite_struct( ( (void*)(&c) ), sizeof(broadcast_settings_t) , BROADCASTCONFIG_START );
+}
+
+/**************************************************************************************************
+ *    Function      : read_broadcast_config
+ *    Description   : reads the ntp broadcast config
+ *    Input         : none
+ *    Output        : broadcast_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+broadcast_settings_t read_broadcast_config( void ){
+  broadcast_settings_t retval;
+  if(false == eepread_struct( (void*)(&retval), sizeof(broadcast_settings_t) , BROADCASTCONFIG_START ) ){ 
+    Serial.println("BROADCAST CONF");
+    retval = ntp_broadcast_default_config();
+    write_broadcast_config(retval);
+  }
+  return retval;
+}
+
+/**************************************************************************************************
+ *    Function      : write_ntp_keys_config
+ *    Description   : writes the ntp symmetric key table
+ *    Input         : ntp_keys_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_ntp_keys_config(ntp_keys_settings_t c){
+  eepwrite_struct( ( (void*)(&c) ), sizeof(ntp_keys_settings_t) , NTPKEYS_START );
+}
+
+/**************************************************************************************************
+ *    Function      : read_ntp_keys_config
+ *    Description   : reads the ntp symmetric key table
+ *    Input         : none
+ *    Output        : ntp_keys_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_keys_settings_t read_ntp_keys_config( void ){
+  ntp_keys_settings_t retval;
+  if(false == eepread_struct( (void*)(&retval), sizeof(ntp_keys_settings_t) , NTPKEYS_START ) ){ 
+    Serial.println("NTP KEYS");
+    retval = NTP_KeyTable::GetDefaultConfig();
+    write_ntp_keys_config(retval);
+  }
+  return retval;
+}
+
+/**************************************************************************************************
+ *    Function      : write_leap_config
+ *    Description   : writes the leap second announcement
+ *    Input         : leap_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_leap_config(leap_settings_t c){
+  eepwrite_struct( ( (void*)(&c) ), sizeof(leap_settings_t) , LEAPCONFIG_START );
+}
+
+/**************************************************************************************************
+ *    Function      : read_leap_config
+ *    Description   : reads the leap second announcement
+ *    Input         : none
+ *    Output        : leap_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+leap_settings_t read_leap_config( void ){
+  leap_settings_t retval;
+  if(false == eepread_struct( (void*)(&retval), sizeof(leap_settings_t) , LEAPCONFIG_START ) ){ 
+    Serial.println("LEAP CONF");
+    retval = Timecore::GetDefaultLeap();
+    write_leap_config(retval);
+  }
+  return retval;
+}
+
+/**************************************************************************************************
+ *    Function      : write_nts_config
+ *    Description   : writes the nts master keys
+ *    Input         : nts_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_nts_config(nts_settings_t c){
+  eepwrite_struct( ( (void*)(&c) ), sizeof(nts_settings_t) , NTSCONFIG_START );
+}
+
+/**************************************************************************************************
+ *    Function      : read_nts_config
+ *    Description   : reads the nts master keys
+ *    Input         : none
+ *    Output        : nts_settings_t
+ *    Remarks       : A new random master key is created if none is stored
+ **************************************************************************************************/
+nts_settings_t read_nts_config( void ){
+  nts_settings_t retval;
+  if(false == eepread_struct( (void*)(&retval), sizeof(nts_settings_t) , NTSCONFIG_START ) ){ 
+    Serial.println("NTS CONF");
+    retval = NTP_NTS::GetDefaultConfig();
+    write_nts_config(retval);
+  }
+  return retval;
+}
+
+/**************************************************************************************************
+ *    Function      : write_roughtime_config
+ *    Description   : writes the roughtime config and long term key
+ *    Input         : roughtime_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_roughtime_config(roughtime_settings_t c){
+  eepwrite_struct( ( (void*)(&c) ), sizeof(roughtime_settings_t) , ROUGHTIMECONFIG_START );
+}
+
+/**************************************************************************************************
+ *    Function      : read_roughtime_config
+ *    Description   : reads the roughtime config and long term key
+ *    Input         : none
+ *    Output        : roughtime_settings_t
+ *    Remarks       : A new random long term key is created if none is stored
+ **************************************************************************************************/
+roughtime_settings_t read_roughtime_config( void ){
+  roughtime_settings_t retval;
+  if(false == eepread_struct( (void*)(&retval), sizeof(roughtime_settings_t) , ROUGHTIMECONFIG_START ) ){ 
+    Serial.println("ROUGHTIME CONF");
+    retval = RoughtimeServer::GetDefaultConfig();
+    write_roughtime_config(retval);
+  }
+  return retval;
+}
+
+/**************************************************************************************************
+ *    Function      : write_txcal_config
+ *    Description   : writes the calibrated transmit delays
+ *    Input         : ntp_txcal_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_txcal_config(ntp_txcal_settings_t c){
+  eepwrite_struct( ( (void*)(&c) ), sizeof(ntp_txcal_settings_t) , TXCALCONFIG_START );
+}
+
+/**************************************************************************************************
+ *    Function      : read_txcal_config
+ *    Description   : reads the calibrated transmit delays
+ *    Input         : none
+ *    Output        : ntp_txcal_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_txcal_settings_t read_txcal_config( void ){
+  ntp_txcal_settings_t retval;
+  if(false == eepread_struct( (void*)(&retval), sizeof(ntp_txcal_settings_t) , TXCALCONFIG_START ) ){ 
+    Serial.println("TXCAL CONF");
+    retval = NTP_TxCalibration::GetDefaultConfig();
+    write_txcal_config(retval);
+  }
+  return retval;
+}
+
+/**************************************************************************************************
+ *    Function      : write_softap_settings
+ *    Description   : writes the access point settings
+ *    Input         : softap_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_softap_settings(softap_settings_t c){
+  eepwrite_struct( ( (void*)(&c) ), sizeof(softap_settings_t) , SOFTAPCONFIG_START );
+}
+
+/**************************************************************************************************
+ *    Function      : read_softap_settings
+ *    Description   : reads the access point settings
+ *    Input         : none
+ *    Output        : softap_settings_t
+ *    Remarks       : Defaults to the open access point for one station, only without a network
+ **************************************************************************************************/
+softap_settings_t read_softap_settings( void ){
+  softap_settings_t retval;
+  if(false == eepread_struct( (void*)(&retval), sizeof(softap_settings_t) , SOFTAPCONFIG_START ) ){ 
+    Serial.println("SOFTAP CONF");
+    bzero((void*)&retval,sizeof( softap_settings_t ));
+    retval.max_clients = 1;
+    write_softap_settings(retval);
+  }
+  retval.pass[sizeof(retval.pass) - 1] = 0;
+  return retval;
+}
+
+/**************************************************************************************************
+ *    Function      : write_servo_config
+ *    Description   : writes the learned timebase frequency
+ *    Input         : ntp_servo_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_servo_config(ntp_servo_settings_t c){
+  eepwrite_struct( ( (void*)(&c) ), sizeof(ntp_servo_settings_t) , SERVOCONFIG_START );
+}
+
+/**************************************************************************************************
+ *    Function      : read_servo_config
+ *    Description   : reads the learned timebase frequency
+ *    Input         : none
+ *    Output        : ntp_servo_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_servo_settings_t read_servo_config( void ){
+  ntp_servo_settings_t retval;
+  if(false == eepread_struct( (void*)(&retval), sizeof(ntp_servo_settings_t) , SERVOCONFIG_START ) ){ 
+    Serial.println("SERVO CONF");
+    retval = NTP_ClockServo::GetDefaultConfig();
+    write_servo_config(retval);
+  }
+  return retval;
+}
+
+/**************************************************************************************************
+ *    Function      : write_holdover_config
+ *    Description   : writes the learned frequency over temperature curve
+ *    Input         : ntp_holdover_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_holdover_config(ntp_holdover_settings_t c){
+  eepwrite_struct( ( (void*)(&c) ), sizeof(ntp_holdover_settings_t) , HOLDOVERCONFIG_START );
+}
+
+/**************************************************************************************************
+ *    Function      : read_holdover_config
+ *    Description   : reads the learned frequency over temperature curve
+ *    Input         : none
+ *    Output        : ntp_holdover_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_holdover_settings_t read_holdover_config( void ){
+  ntp_holdover_settings_t retval;
+  if(false == eepread_struct( (void*)(&retval), sizeof(ntp_holdover_settings_t) , HOLDOVERCONFIG_START ) ){ 
+    Serial.println("HOLDOVER CONF");
+    retval = NTP_Holdover::GetDefaultConfig();
+    write_holdover_config(retval);
+  }
+  return retval;
+}
+
 /**************************************************************************************************
  *    Function      : eepread_struct
  *    Description   : reads a given block from flash / eeprom 
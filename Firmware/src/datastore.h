@@ -20,6 +20,14 @@
  #define DATASTORE_H_
  
 #include "timecore.h"
+#include "ntp_ratelimit.h"
+#include "ntp_broadcast.h"
+#include "ntp_auth.h"
+#include "ntp_nts.h"
+#include "roughtime_server.h"
+#include "ntp_txcal.h"
+#include "ntp_servo.h"
+#include "ntp_holdover.h"
 
 typedef struct {
   char ssid[128];
@@ -37,6 +45,13 @@ typedef struct {
 } ipv4_settings;
 
 
+typedef struct {
+  bool with_sta;        /* Keep the access point up while connected to a network */
+  uint8_t max_clients;  /* Stations the access point takes, 1 to 10 */
+  char pass[64];        /* WPA2 passphrase of the access point, empty for an open one */
+} softap_settings_t;
+/* 66 byte */
+
 typedef struct{
   bool sync_on_gps;
 // uint16_t baudrate;
@@ -150,6 +165,186 @@ void write_ipv4_settings(ipv4_settings c);
  **************************************************************************************************/
 ipv4_settings read_ipv4_settings( void );
 
+/**************************************************************************************************
+ *    Function      : write_ratelimit_config
+ *    Description   : writes the ntp rate limit config
+ *    Input         : ratelimit_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_ratelimit_config(ratelimit_settings_t c);
+
+/**************************************************************************************************
+ *    Function      : read_ratelimit_config
+ *    Description   : reads the ntp rate limit config
+ *    Input         : none
+ *    Output        : ratelimit_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ratelimit_settings_t read_ratelimit_config( void );
+
+/**************************************************************************************************
+ *    Function      : write_broadcast_config
+ *    Description   : writes the ntp broadcast config
+ *    Input         : broadcast_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_broadcast_config(broadcast_settings_t c);
+
+/**************************************************************************************************
+ *    Function      : read_broadcast_config
+ *    Description   : reads the ntp broadcast config
+ *    Input         : none
+ *    Output        : broadcast_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+broadcast_settings_t read_broadcast_config( void );
+
+/**************************************************************************************************
+ *    Function      : write_ntp_keys_config
+ *    Description   : writes the ntp symmetric key table
+ *    Input         : ntp_keys_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_ntp_keys_config(ntp_keys_settings_t c);
+
+/**************************************************************************************************
+ *    Function      : read_ntp_keys_config
+ *    Description   : reads the ntp symmetric key table
+ *    Input         : none
+ *    Output        : ntp_keys_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_keys_settings_t read_ntp_keys_config( void );
+
+/**************************************************************************************************
+ *    Function      : write_leap_config
+ *    Description   : writes the leap second announcement
+ *    Input         : leap_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_leap_config(leap_settings_t c);
+
+/**************************************************************************************************
+ *    Function      : read_leap_config
+ *    Description   : reads the leap second announcement
+ *    Input         : none
+ *    Output        : leap_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+leap_settings_t read_leap_config( void );
+
+/**************************************************************************************************
+ *    Function      : write_nts_config
+ *    Description   : writes the nts master keys
+ *    Input         : nts_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_nts_config(nts_settings_t c);
+
+/**************************************************************************************************
+ *    Function      : read_nts_config
+ *    Description   : reads the nts master keys
+ *    Input         : none
+ *    Output        : nts_settings_t
+ *    Remarks       : A new random master key is created if none is stored
+ **************************************************************************************************/
+nts_settings_t read_nts_config( void );
+
+/**************************************************************************************************
+ *    Function      : write_roughtime_config
+ *    Description   : writes the roughtime config and long term key
+ *    Input         : roughtime_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_roughtime_config(roughtime_settings_t c);
+
+/**************************************************************************************************
+ *    Function      : read_roughtime_config
+ *    Description   : reads the roughtime config and long term key
+ *    Input         : none
+ *    Output        : roughtime_settings_t
+ *    Remarks       : A new random long term key is created if none is stored
+ **************************************************************************************************/
+roughtime_settings_t read_roughtime_config( void );
+
+/**************************************************************************************************
+ *    Function      : write_txcal_config
+ *    Description   : writes the calibrated transmit delays
+ *    Input         : ntp_txcal_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_txcal_config(ntp_txcal_settings_t c);
+
+/**************************************************************************************************
+ *    Function      : read_txcal_config
+ *    Description   : reads the calibrated transmit delays
+ *    Input         : none
+ *    Output        : ntp_txcal_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_txcal_settings_t read_txcal_config( void );
+
+/**************************************************************************************************
+ *    Function      : write_softap_settings
+ *    Description   : writes the access point settings
+ *    Input         : softap_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_softap_settings(softap_settings_t c);
+
+/**************************************************************************************************
+ *    Function      : read_softap_settings
+ *    Description   : reads the access point settings
+ *    Input         : none
+ *    Output        : softap_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+softap_settings_t read_softap_settings( void );
+
+/**************************************************************************************************
+ *    Function      : write_servo_config
+ *    Description   : writes the learned timebase frequency
+ *    Input         : ntp_servo_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_servo_config(ntp_servo_settings_t c);
+
+/**************************************************************************************************
+ *    Function      : read_servo_config
+ *    Description   : reads the learned timebase frequency
+ *    Input         : none
+ *    Output        : ntp_servo_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_servo_settings_t read_servo_config( void );
+
+/**************************************************************************************************
+ *    Function      : write_holdover_config
+ *    Description   : writes the learned frequency over temperature curve
+ *    Input         : ntp_holdover_settings_t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void write_holdover_config(ntp_holdover_settings_t c);
+
+/**************************************************************************************************
+ *    Function      : read_holdover_config
+ *    Description   : reads the learned frequency over temperature curve
+ *    Input         : none
+ *    Output        : ntp_holdover_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_holdover_settings_t read_holdover_config( void );
+
 /**************************************************************************************************
  *    Function      : eepwrite_notes
  *    Description   : writes the user notes 
@@ -192,12 +192,17 @@ credentials_t c =  read_credentials();
    
   }
   else {
-    Serial.println("STA");
+    softap_settings_t ap = read_softap_settings();
+    Serial.println( ( true == ap.with_sta ) ? "AP+STA" : "STA" );
     
  
       ssid=String(c.ssid);
       pass=String(c.pass);
       if(true==connectWiFi()){
+        if(true == ap.with_sta){
+          /* One radio, the access point has to follow the channel of the network */
+          startSoftAP(WiFi.channel());
+        }
         configureServer();
       } else {
         configureSoftAP();
@@ -222,7 +227,8 @@ bool connectWiFi() {
    
     return false;
   }
-  WiFi.mode(WIFI_STA);
+  /* With the access point kept up both interfaces run, NTP is bound to any address and serves both */
+  WiFi.mode( ( true == read_softap_settings().with_sta ) ? WIFI_AP_STA : WIFI_STA );
   Serial.println("Attempting to connect to " + ssid + ", pass: " + pass);
   if(false != nws.use_static ){
     IPAddress local_IP(nws.address);
@@ -274,28 +280,49 @@ bool connectWiFi() {
   Serial.print("Local IP: ");
   ip = WiFi.localIP();
   Serial.println(ip);   
+  /* NTP is served on IPv6 too, the link-local address is made here, global ones follow the router advertisements */
+  WiFi.enableIpV6();
   return true;
 }
 
 
 /**************************************************************************************************
- *    Function      : configureSoftAP
- *    Description   : Configures the ESP as SoftAP
- *    Input         : none 
+ *    Function      : startSoftAP
+ *    Description   : Brings up the access point
+ *    Input         : uint8_t channel
  *    Output        : none
- *    Remarks       : configure the access point of the esp
+ *    Remarks       : Also used next to a station connection, then on the channel of that network
  **************************************************************************************************/
-void configureSoftAP() {
-  IsAP=true;
+void startSoftAP( uint8_t channel ) {
+  softap_settings_t ap = read_softap_settings();
+  const char* ap_pass = NULL;
   Serial.println("Configuring AP: " + String(APSSID));
-  
+  /* WPA2 needs at least 8 characters, anything shorter leaves the access point open */
+  if(strlen(ap.pass) >= 8){
+    ap_pass = ap.pass;
+  }
+  if( (ap.max_clients < 1) || (ap.max_clients > 10) ){
+    ap.max_clients = 1;
+  }
   /* This seems to stop crashing the ESP32 if in SoftAP mode */
   WiFi.enableAP(true);
   delay(100);
   WiFi.softAPConfig(IPAddress(192, 168, 4, 1), IPAddress(192, 168, 4, 1), IPAddress(255, 255, 255, 0));
-  WiFi.softAP(APSSID.c_str(), NULL, 1, 0, 1);
+  WiFi.softAP(APSSID.c_str(), ap_pass, channel, 0, ap.max_clients);
   delay(500); // Without delay the IP address is sometimes blank
+  WiFi.softAPenableIpV6();
+}
 
+/**************************************************************************************************
+ *    Function      : configureSoftAP
+ *    Description   : Configures the ESP as SoftAP
+ *    Input         : none 
+ *    Output        : none
+ *    Remarks       : configure the access point of the esp
+ **************************************************************************************************/
+void configureSoftAP() {
+  IsAP=true;
+  startSoftAP(1);
   
   Serial.print("AP IP: ");
   Serial.println(ip);
@@ -333,6 +360,29 @@ void configureServer() {
   server->on("/display/settings",HTTP_POST,update_display_settings);  
   server->on("/ipv4settings.json",HTTP_GET,getipv4settings_settings);
   server->on("/ipv4settings.json",HTTP_POST,update_ipv4_settings);
+  server->on("/softap.json",HTTP_GET,send_softap_settings);
+  server->on("/softap.json",HTTP_POST,update_softap_settings);
+  server->on("/ntp/status",HTTP_GET,send_ntp_status);
+  server->on("/ntp/latency",HTTP_GET,send_ntp_latency);
+  server->on("/ntp/latency",HTTP_POST,reset_ntp_latency);
+  server->on("/ntp/servo",HTTP_GET,send_ntp_servo);
+  server->on("/ntp/holdover",HTTP_GET,send_ntp_holdover);
+  server->on("/ntp/txcal",HTTP_GET,send_ntp_txcal);
+  server->on("/ntp/txcal",HTTP_POST,update_ntp_txcal);
+  server->on("/ntp/ratelimit",HTTP_GET,send_ntp_ratelimit_settings);
+  server->on("/ntp/ratelimit",HTTP_POST,update_ntp_ratelimit_settings);
+  server->on("/ntp/clients.json",HTTP_GET,send_ntp_clients);
+  server->on("/ntp/census.json",HTTP_GET,send_ntp_census);
+  server->on("/ntp/broadcast",HTTP_GET,send_ntp_broadcast_settings);
+  server->on("/ntp/broadcast",HTTP_POST,update_ntp_broadcast_settings);
+  server->on("/ntp/keys",HTTP_GET,send_ntp_keys);
+  server->on("/ntp/keys",HTTP_POST,update_ntp_key);
+  server->on("/ntp/leap",HTTP_GET,send_leap_settings);
+  server->on("/ntp/leap",HTTP_POST,update_leap_settings);
+  server->on("/ntp/nts",HTTP_GET,send_nts_settings);
+  server->on("/ntp/nts",HTTP_POST,update_nts_settings);
+  server->on("/roughtime/settings",HTTP_GET,send_roughtime_settings);
+  server->on("/roughtime/settings",HTTP_POST,update_roughtime_settings);
   server->onNotFound(sendFile); //handle everything except the above things
   server->begin();
   Serial.println("Webserver started");
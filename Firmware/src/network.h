@@ -13,6 +13,7 @@ void sendFile( void );
 void sendData(String data);
 void initWiFi( void );
 bool connectWiFi( void );
+void startSoftAP( uint8_t channel );
 void configureSoftAP( void );
 void configureServer( void );
 String WiFiStatusToString( void );
@@ -0,0 +1,306 @@
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "ntp_addr.h"
+
+/* Prefix of IPv4 addresses mapped into IPv6 */
+static const uint8_t ntp_addr_v4_prefix[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF };
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_from_v4
+ *    Description   : Returns the address of an IPv4 client
+ *    Input         : uint32_t addr
+ *    Output        : ntp_addr_t
+ *    Remarks       : addr in network order
+ **************************************************************************************************/
+ntp_addr_t ntp_addr_from_v4( uint32_t addr ){
+  ntp_addr_t a;
+  memcpy(a.bytes, ntp_addr_v4_prefix, sizeof(ntp_addr_v4_prefix));
+  memcpy(&a.bytes[12], &addr, sizeof(addr));
+  return a;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_from_v6
+ *    Description   : Returns the address of an IPv6 client
+ *    Input         : const uint8_t* addr
+ *    Output        : ntp_addr_t
+ *    Remarks       : The 16 bytes in network order
+ **************************************************************************************************/
+ntp_addr_t ntp_addr_from_v6( const uint8_t* addr ){
+  ntp_addr_t a;
+  memcpy(a.bytes, addr, NTP_ADDR_LEN);
+  return a;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_is_v4
+ *    Description   : Checks if an address is a mapped IPv4 one
+ *    Input         : const ntp_addr_t* addr
+ *    Output        : bool
+ *    Remarks       : The IPv4 address is in the last 4 bytes
+ **************************************************************************************************/
+bool ntp_addr_is_v4( const ntp_addr_t* addr ){
+  return ( 0 == memcmp(addr->bytes, ntp_addr_v4_prefix, sizeof(ntp_addr_v4_prefix)) );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_equal
+ *    Description   : Compares two addresses
+ *    Input         : const ntp_addr_t* a, const ntp_addr_t* b
+ *    Output        : bool
+ *    Remarks       : The low half is compared first, IPv4 clients only differ there
+ **************************************************************************************************/
+bool ntp_addr_equal( const ntp_addr_t* a, const ntp_addr_t* b ){
+  uint64_t wa[2];
+  uint64_t wb[2];
+  memcpy(wa, a->bytes, sizeof(wa));
+  memcpy(wb, b->bytes, sizeof(wb));
+  return ( (wa[1] == wb[1]) && (wa[0] == wb[0]) );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_get64
+ *    Description   : Reads 8 bytes little endian, as SipHash takes its words
+ *    Input         : const uint8_t* p
+ *    Output        : uint64_t
+ *    Remarks       : none
+ **************************************************************************************************/
+static inline uint64_t ntp_addr_get64( const uint8_t* p ){
+  uint64_t v = 0;
+  for(int8_t i=7;i>=0;i--){
+    v = ( v << 8 ) | p[i];
+  }
+  return v;
+}
+
+#define NTP_ADDR_ROTL( x, b ) ( (uint64_t)( ( (x) << (b) ) | ( (x) >> ( 64 - (b) ) ) ) )
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_sipround
+ *    Description   : One SipRound
+ *    Input         : uint64_t* v
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+static inline void ntp_addr_sipround( uint64_t* v ){
+  v[0] += v[1];
+  v[1] = NTP_ADDR_ROTL(v[1], 13);
+  v[1] ^= v[0];
+  v[0] = NTP_ADDR_ROTL(v[0], 32);
+  v[2] += v[3];
+  v[3] = NTP_ADDR_ROTL(v[3], 16);
+  v[3] ^= v[2];
+  v[0] += v[3];
+  v[3] = NTP_ADDR_ROTL(v[3], 21);
+  v[3] ^= v[0];
+  v[2] += v[1];
+  v[1] = NTP_ADDR_ROTL(v[1], 17);
+  v[1] ^= v[2];
+  v[2] = NTP_ADDR_ROTL(v[2], 32);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_hash
+ *    Description   : Returns the hash that places an address in the tables
+ *    Input         : const ntp_addr_t* addr, const uint8_t* key
+ *    Output        : uint32_t
+ *    Remarks       : SipHash-2-4 under the NTP_ADDR_KEY_LEN bytes of key, without the key the slots
+ *                    of an address can't be told in advance. A hit still compares the full address
+ **************************************************************************************************/
+uint32_t ntp_addr_hash( const ntp_addr_t* addr, const uint8_t* key ){
+  uint64_t k0 = ntp_addr_get64(key);
+  uint64_t k1 = ntp_addr_get64(&key[8]);
+  uint64_t v[4] = { k0 ^ 0x736f6d6570736575ull, k1 ^ 0x646f72616e646f6dull,
+                    k0 ^ 0x6c7967656e657261ull, k1 ^ 0x7465646279746573ull };
+  /* Two words of message and the last block, which only holds the length */
+  uint64_t m[3] = { ntp_addr_get64(addr->bytes), ntp_addr_get64(&addr->bytes[8]), (uint64_t)NTP_ADDR_LEN << 56 };
+  for(uint8_t i=0;i<3;i++){
+    v[3] ^= m[i];
+    ntp_addr_sipround(v);
+    ntp_addr_sipround(v);
+    v[0] ^= m[i];
+  }
+  v[2] ^= 0xFF;
+  for(uint8_t i=0;i<4;i++){
+    ntp_addr_sipround(v);
+  }
+  uint64_t h = v[0] ^ v[1] ^ v[2] ^ v[3];
+  return (uint32_t)( h ^ ( h >> 32 ) );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_format
+ *    Description   : Writes an address as text
+ *    Input         : const ntp_addr_t* addr, char* buf, size_t size
+ *    Output        : none
+ *    Remarks       : Dotted for IPv4, RFC 5952 for IPv6, size should be NTP_ADDR_STR_LEN
+ **************************************************************************************************/
+void ntp_addr_format( const ntp_addr_t* addr, char* buf, size_t size ){
+  const uint8_t* b = addr->bytes;
+  if(true == ntp_addr_is_v4(addr)){
+    snprintf(buf, size, "%u.%u.%u.%u", b[12], b[13], b[14], b[15]);
+    return;
+  }
+  /* The longest run of two or more zero groups is left out, the first one if two are as long */
+  uint16_t groups[8];
+  int8_t best = -1;
+  uint8_t best_len = 1;
+  int8_t run = -1;
+  for(uint8_t i=0;i<8;i++){
+    groups[i] = ( (uint16_t)b[2 * i] << 8 ) | b[( 2 * i ) + 1];
+    if(groups[i] != 0){
+      run = -1;
+      continue;
+    }
+    if(run < 0){
+      run = i;
+    }
+    if( ( i + 1 - run ) > best_len ){
+      best = run;
+      best_len = i + 1 - run;
+    }
+  }
+  size_t pos = 0;
+  buf[0] = '\0';
+  for(uint8_t i=0;( i < 8 ) && ( pos < size );i++){
+    if(i == best){
+      pos += snprintf(&buf[pos], size - pos, "::");
+      i += best_len - 1;
+      continue;
+    }
+    if( (pos > 0) && (buf[pos - 1] != ':') ){
+      pos += snprintf(&buf[pos], size - pos, ":");
+    }
+    pos += snprintf(&buf[pos], size - pos, "%x", groups[i]);
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_parse_v4
+ *    Description   : Reads a dotted IPv4 address
+ *    Input         : const char* str, uint8_t* b
+ *    Output        : bool
+ *    Remarks       : Whatever follows the fourth number is ignored
+ **************************************************************************************************/
+static bool ntp_addr_parse_v4( const char* str, uint8_t* b ){
+  for(uint8_t i=0;i<4;i++){
+    char* end;
+    unsigned long v = strtoul(str, &end, 10);
+    if( (end == str) || (v > 255) ){
+      return false;
+    }
+    if( (i < 3) && (*end != '.') ){
+      return false;
+    }
+    b[i] = (uint8_t)v;
+    str = end + 1;
+  }
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_parse_v6
+ *    Description   : Reads an IPv6 address in hex groups, one run of zeros may be left out
+ *    Input         : const char* str, const char* end, uint8_t* b
+ *    Output        : bool
+ *    Remarks       : An IPv4 address in the last 32 bits is not taken
+ **************************************************************************************************/
+static bool ntp_addr_parse_v6( const char* str, const char* end, uint8_t* b ){
+  uint16_t groups[8];
+  uint8_t count = 0;
+  int8_t gap = -1;
+  const char* p = str;
+  if( (end - p >= 2) && (p[0] == ':') && (p[1] == ':') ){
+    gap = 0;
+    p += 2;
+  }
+  while(p < end){
+    uint32_t v = 0;
+    uint8_t digits = 0;
+    while( (p < end) && (digits < 5) ){
+      char c = *p;
+      uint8_t d;
+      if( (c >= '0') && (c <= '9') ){
+        d = c - '0';
+      } else if( (c >= 'a') && (c <= 'f') ){
+        d = c - 'a' + 10;
+      } else if( (c >= 'A') && (c <= 'F') ){
+        d = c - 'A' + 10;
+      } else {
+        break;
+      }
+      v = ( v << 4 ) | d;
+      digits++;
+      p++;
+    }
+    if( (digits == 0) || (digits > 4) || (count >= 8) ){
+      return false;
+    }
+    groups[count++] = (uint16_t)v;
+    if(p == end){
+      break;
+    }
+    if(*p != ':'){
+      return false;
+    }
+    p++;
+    if( (p < end) && (*p == ':') ){
+      if(gap >= 0){
+        return false;
+      }
+      gap = count;
+      p++;
+    } else if(p == end){
+      return false;
+    }
+  }
+  if( ( (gap < 0) && (count != 8) ) || ( (gap >= 0) && (count > 7) ) ){
+    return false;
+  }
+  memset(b, 0, NTP_ADDR_LEN);
+  uint8_t tail = ( gap < 0 ) ? 0 : count - gap;
+  for(uint8_t i=0;i<count;i++){
+    uint8_t at = ( (gap >= 0) && (i >= gap) ) ? ( 8 - tail + ( i - gap ) ) : i;
+    b[2 * at] = groups[i] >> 8;
+    b[( 2 * at ) + 1] = groups[i];
+  }
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_parse
+ *    Description   : Reads an address as ntp_addr_format writes it
+ *    Input         : const char* str, ntp_addr_t* addr
+ *    Output        : bool
+ *    Remarks       : IPv6 may be put in brackets, a port behind the address is ignored
+ **************************************************************************************************/
+bool ntp_addr_parse( const char* str, ntp_addr_t* addr ){
+  uint8_t b[NTP_ADDR_LEN];
+  const char* end;
+  if(str[0] == '['){
+    str++;
+    end = strchr(str, ']');
+    if(end == NULL){
+      return false;
+    }
+  } else {
+    /* An IPv4 address with a port has one colon, an IPv6 one at least two */
+    const char* colon = strchr(str, ':');
+    if( (colon == NULL) || (strchr(colon + 1, ':') == NULL) ){
+      if(false == ntp_addr_parse_v4(str, b)){
+        return false;
+      }
+      uint32_t v4;
+      memcpy(&v4, b, sizeof(v4));
+      *addr = ntp_addr_from_v4(v4);
+      return true;
+    }
+    end = str + strcspn(str, " ,");
+  }
+  if(false == ntp_addr_parse_v6(str, end, b)){
+    return false;
+  }
+  *addr = ntp_addr_from_v6(b);
+  return true;
+}
@@ -0,0 +1,87 @@
+#ifndef NTP_ADDR_H_
+ #define NTP_ADDR_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Bytes of an address and of the key its hash is taken with */
+#define NTP_ADDR_LEN ( 16 )
+#define NTP_ADDR_KEY_LEN ( 16 )
+
+/* Longest text of an address, as INET6_ADDRSTRLEN */
+#define NTP_ADDR_STR_LEN ( 46 )
+
+/*
+ * A client address as the per client tables keep it. IPv6 addresses are kept
+ * as they are, IPv4 addresses are mapped into ::ffff:0:0/96 of RFC 4291, so an
+ * IPv4 client that reaches a dual-stack socket as a mapped address is the same.
+ */
+typedef struct {
+  uint8_t bytes[NTP_ADDR_LEN];
+} ntp_addr_t;
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_from_v4
+ *    Description   : Returns the address of an IPv4 client
+ *    Input         : uint32_t addr
+ *    Output        : ntp_addr_t
+ *    Remarks       : addr in network order
+ **************************************************************************************************/
+ntp_addr_t ntp_addr_from_v4( uint32_t addr );
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_from_v6
+ *    Description   : Returns the address of an IPv6 client
+ *    Input         : const uint8_t* addr
+ *    Output        : ntp_addr_t
+ *    Remarks       : The 16 bytes in network order
+ **************************************************************************************************/
+ntp_addr_t ntp_addr_from_v6( const uint8_t* addr );
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_is_v4
+ *    Description   : Checks if an address is a mapped IPv4 one
+ *    Input         : const ntp_addr_t* addr
+ *    Output        : bool
+ *    Remarks       : The IPv4 address is in the last 4 bytes
+ **************************************************************************************************/
+bool ntp_addr_is_v4( const ntp_addr_t* addr );
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_equal
+ *    Description   : Compares two addresses
+ *    Input         : const ntp_addr_t* a, const ntp_addr_t* b
+ *    Output        : bool
+ *    Remarks       : The low half is compared first, IPv4 clients only differ there
+ **************************************************************************************************/
+bool ntp_addr_equal( const ntp_addr_t* a, const ntp_addr_t* b );
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_hash
+ *    Description   : Returns the hash that places an address in the tables
+ *    Input         : const ntp_addr_t* addr, const uint8_t* key
+ *    Output        : uint32_t
+ *    Remarks       : SipHash-2-4 under the NTP_ADDR_KEY_LEN bytes of key, without the key the slots
+ *                    of an address can't be told in advance. A hit still compares the full address
+ **************************************************************************************************/
+uint32_t ntp_addr_hash( const ntp_addr_t* addr, const uint8_t* key );
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_format
+ *    Description   : Writes an address as text
+ *    Input         : const ntp_addr_t* addr, char* buf, size_t size
+ *    Output        : none
+ *    Remarks       : Dotted for IPv4, RFC 5952 for IPv6, size should be NTP_ADDR_STR_LEN
+ **************************************************************************************************/
+void ntp_addr_format( const ntp_addr_t* addr, char* buf, size_t size );
+
+/**************************************************************************************************
+ *    Function      : ntp_addr_parse
+ *    Description   : Reads an address as ntp_addr_format writes it
+ *    Input         : const char* str, ntp_addr_t* addr
+ *    Output        : bool
+ *    Remarks       : IPv6 may be put in brackets, a port behind the address is ignored
+ **************************************************************************************************/
+bool ntp_addr_parse( const char* str, ntp_addr_t* addr );
+
+#endif
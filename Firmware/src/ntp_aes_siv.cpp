@@ -0,0 +1,130 @@
+#include <string.h>
+#include "ntp_aes_siv.h"
+
+/**************************************************************************************************
+ *    Function      : ntp_siv_setkey
+ *    Description   : Prepares a key for AES-SIV-CMAC-256
+ *    Input         : ntp_siv_key_t* key, const uint8_t* raw
+ *    Output        : none
+ *    Remarks       : raw is 32 bytes, RFC 5297
+ **************************************************************************************************/
+void ntp_siv_setkey( ntp_siv_key_t* key, const uint8_t* raw ){
+  ntp_cmac_setkey(&key->mac, raw);
+  mbedtls_aes_init(&key->ctr);
+  mbedtls_aes_setkey_enc(&key->ctr, &raw[NTP_SIV_KEY_LEN / 2], 128);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_siv_free
+ *    Description   : Releases a prepared key
+ *    Input         : ntp_siv_key_t* key
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void ntp_siv_free( ntp_siv_key_t* key ){
+  ntp_cmac_free(&key->mac);
+  mbedtls_aes_free(&key->ctr);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_siv_s2v
+ *    Description   : Computes the synthetic IV over associated data, nonce and plaintext
+ *    Input         : ntp_siv_key_t* key, const uint8_t* ad, uint16_t ad_len,
+ *                    const uint8_t* nonce, uint16_t nonce_len, const uint8_t* data, uint16_t len, uint8_t* v
+ *    Output        : none
+ *    Remarks       : The plaintext is streamed, its last block is the only one that gets copied
+ **************************************************************************************************/
+static void ntp_siv_s2v( ntp_siv_key_t* key, const uint8_t* ad, uint16_t ad_len, const uint8_t* nonce, uint16_t nonce_len, const uint8_t* data, uint16_t len, uint8_t* v ){
+  uint8_t d[NTP_CMAC_BLOCK];
+  uint8_t t[NTP_CMAC_BLOCK];
+  ntp_cmac_ctx_t ctx;
+
+  memset(t, 0, sizeof(t));
+  ntp_cmac(&key->mac, t, NTP_CMAC_BLOCK, d);
+
+  ntp_cmac(&key->mac, ad, ad_len, t);
+  ntp_cmac_dbl(d, d);
+  for(uint8_t i=0;i<NTP_CMAC_BLOCK;i++){
+    d[i] ^= t[i];
+  }
+
+  ntp_cmac(&key->mac, nonce, nonce_len, t);
+  ntp_cmac_dbl(d, d);
+  for(uint8_t i=0;i<NTP_CMAC_BLOCK;i++){
+    d[i] ^= t[i];
+  }
+
+  ntp_cmac_start(&ctx, &key->mac);
+  if(len >= NTP_CMAC_BLOCK){
+    /* xorend, D goes into the last block of the plaintext */
+    uint16_t head = len - NTP_CMAC_BLOCK;
+    ntp_cmac_update(&ctx, data, head);
+    for(uint8_t i=0;i<NTP_CMAC_BLOCK;i++){
+      t[i] = data[head+i] ^ d[i];
+    }
+  } else {
+    ntp_cmac_dbl(d, d);
+    memset(t, 0, sizeof(t));
+    memcpy(t, data, len);
+    t[len] = 0x80;
+    for(uint8_t i=0;i<NTP_CMAC_BLOCK;i++){
+      t[i] ^= d[i];
+    }
+  }
+  ntp_cmac_update(&ctx, t, NTP_CMAC_BLOCK);
+  ntp_cmac_finish(&ctx, v);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_siv_ctr
+ *    Description   : Runs data through AES-CTR with the synthetic IV as counter
+ *    Input         : ntp_siv_key_t* key, const uint8_t* v, uint8_t* data, uint16_t len
+ *    Output        : none
+ *    Remarks       : Two bits of the IV are cleared so the counter can be a 32 bit add
+ **************************************************************************************************/
+static void ntp_siv_ctr( ntp_siv_key_t* key, const uint8_t* v, uint8_t* data, uint16_t len ){
+  uint8_t q[NTP_CMAC_BLOCK];
+  uint8_t stream[NTP_CMAC_BLOCK];
+  size_t off = 0;
+  memcpy(q, v, sizeof(q));
+  q[8] &= 0x7F;
+  q[12] &= 0x7F;
+  mbedtls_aes_crypt_ctr(&key->ctr, len, &off, q, stream, data, data);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_siv_encrypt
+ *    Description   : Encrypts data in place and computes the tag
+ *    Input         : ntp_siv_key_t* key, const uint8_t* ad, uint16_t ad_len,
+ *                    const uint8_t* nonce, uint16_t nonce_len, uint8_t* data, uint16_t len, uint8_t* tag
+ *    Output        : none
+ *    Remarks       : tag is 16 bytes, the associated data and the nonce are the two S2V inputs
+ **************************************************************************************************/
+void ntp_siv_encrypt( ntp_siv_key_t* key, const uint8_t* ad, uint16_t ad_len, const uint8_t* nonce, uint16_t nonce_len, uint8_t* data, uint16_t len, uint8_t* tag ){
+  ntp_siv_s2v(key, ad, ad_len, nonce, nonce_len, data, len, tag);
+  ntp_siv_ctr(key, tag, data, len);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_siv_decrypt
+ *    Description   : Decrypts data in place and checks the tag
+ *    Input         : ntp_siv_key_t* key, const uint8_t* ad, uint16_t ad_len,
+ *                    const uint8_t* nonce, uint16_t nonce_len, uint8_t* data, uint16_t len, const uint8_t* tag
+ *    Output        : bool ( false if the tag does not match, data is cleared then )
+ *    Remarks       : none
+ **************************************************************************************************/
+bool ntp_siv_decrypt( ntp_siv_key_t* key, const uint8_t* ad, uint16_t ad_len, const uint8_t* nonce, uint16_t nonce_len, uint8_t* data, uint16_t len, const uint8_t* tag ){
+  uint8_t v[NTP_SIV_TAG_LEN];
+  uint8_t diff = 0;
+  ntp_siv_ctr(key, tag, data, len);
+  ntp_siv_s2v(key, ad, ad_len, nonce, nonce_len, data, len, v);
+  /* Compare in constant time */
+  for(uint8_t i=0;i<NTP_SIV_TAG_LEN;i++){
+    diff |= v[i] ^ tag[i];
+  }
+  if(diff != 0){
+    memset(data, 0, len);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,58 @@
+#ifndef NTP_AES_SIV_H_
+ #define NTP_AES_SIV_H_
+
+#include <stdint.h>
+#include "mbedtls/aes.h"
+#include "ntp_cmac.h"
+
+/* AEAD_AES_SIV_CMAC_256 takes two AES-128 keys */
+#define NTP_SIV_KEY_LEN ( 32 )
+
+/* The synthetic IV is the tag and the IV of the CTR mode */
+#define NTP_SIV_TAG_LEN ( 16 )
+
+/* Both halves of the key prepared for use */
+typedef struct {
+  ntp_cmac_key_t mac;          /* K1, used by S2V */
+  mbedtls_aes_context ctr;     /* K2, used by the CTR mode */
+} ntp_siv_key_t;
+
+/**************************************************************************************************
+ *    Function      : ntp_siv_setkey
+ *    Description   : Prepares a key for AES-SIV-CMAC-256
+ *    Input         : ntp_siv_key_t* key, const uint8_t* raw
+ *    Output        : none
+ *    Remarks       : raw is 32 bytes, RFC 5297
+ **************************************************************************************************/
+void ntp_siv_setkey( ntp_siv_key_t* key, const uint8_t* raw );
+
+/**************************************************************************************************
+ *    Function      : ntp_siv_free
+ *    Description   : Releases a prepared key
+ *    Input         : ntp_siv_key_t* key
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void ntp_siv_free( ntp_siv_key_t* key );
+
+/**************************************************************************************************
+ *    Function      : ntp_siv_encrypt
+ *    Description   : Encrypts data in place and computes the tag
+ *    Input         : ntp_siv_key_t* key, const uint8_t* ad, uint16_t ad_len,
+ *                    const uint8_t* nonce, uint16_t nonce_len, uint8_t* data, uint16_t len, uint8_t* tag
+ *    Output        : none
+ *    Remarks       : tag is 16 bytes, the associated data and the nonce are the two S2V inputs
+ **************************************************************************************************/
+void ntp_siv_encrypt( ntp_siv_key_t* key, const uint8_t* ad, uint16_t ad_len, const uint8_t* nonce, uint16_t nonce_len, uint8_t* data, uint16_t len, uint8_t* tag );
+
+/**************************************************************************************************
+ *    Function      : ntp_siv_decrypt
+ *    Description   : Decrypts data in place and checks the tag
+ *    Input         : ntp_siv_key_t* key, const uint8_t* ad, uint16_t ad_len,
+ *                    const uint8_t* nonce, uint16_t nonce_len, uint8_t* data, uint16_t len, const uint8_t* tag
+ *    Output        : bool ( false if the tag does not match, data is cleared then )
+ *    Remarks       : none
+ **************************************************************************************************/
+bool ntp_siv_decrypt( ntp_siv_key_t* key, const uint8_t* ad, uint16_t ad_len, const uint8_t* nonce, uint16_t nonce_len, uint8_t* data, uint16_t len, const uint8_t* tag );
+
+#endif
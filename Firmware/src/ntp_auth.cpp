@@ -0,0 +1,266 @@
+#include <string.h>
+#include "ntp_auth.h"
+#include "ntp_packet.h"
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_KeyTable
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_KeyTable::NTP_KeyTable( ){
+  memset(keys, 0, sizeof(keys));
+  count = 0;
+}
+
+/**************************************************************************************************
+ *    Function      : Destructor
+ *    Class         : NTP_KeyTable
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_KeyTable::~NTP_KeyTable( ){
+  Free();
+}
+
+/**************************************************************************************************
+ *    Function      : GetDefaultConfig
+ *    Class         : NTP_KeyTable
+ *    Description   : Returns an empty key table
+ *    Input         : none
+ *    Output        : ntp_keys_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_keys_settings_t NTP_KeyTable::GetDefaultConfig( void ){
+  ntp_keys_settings_t conf;
+  memset(&conf, 0, sizeof(conf));
+  return conf;
+}
+
+/**************************************************************************************************
+ *    Function      : DigestLength
+ *    Class         : NTP_KeyTable
+ *    Description   : Returns the length of the digest a key type produces
+ *    Input         : uint8_t type
+ *    Output        : uint8_t ( 0 for unknown types )
+ *    Remarks       : none
+ **************************************************************************************************/
+uint8_t NTP_KeyTable::DigestLength( uint8_t type ){
+  switch(type){
+    case NTP_KEY_MD5:
+    case NTP_KEY_AES128CMAC:{
+      return 16;
+    }
+
+    case NTP_KEY_SHA1:{
+      return 20;
+    }
+
+    default:{
+      return 0;
+    }
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : IsValid
+ *    Class         : NTP_KeyTable
+ *    Description   : Checks if a key can be loaded
+ *    Input         : const ntp_key_t* key
+ *    Output        : bool
+ *    Remarks       : AES-128-CMAC keys need to be 16 bytes long
+ **************************************************************************************************/
+bool NTP_KeyTable::IsValid( const ntp_key_t* key ){
+  if( (key->id == 0) || (0 == DigestLength(key->type)) ){
+    return false;
+  }
+  if(key->type == NTP_KEY_AES128CMAC){
+    return ( key->len == NTP_KEY_AES128_LEN );
+  }
+  return ( (key->len > 0) && (key->len <= NTP_KEY_LEN_MAX) );
+}
+
+/**************************************************************************************************
+ *    Function      : Free
+ *    Class         : NTP_KeyTable
+ *    Description   : Releases the prepared keys
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_KeyTable::Free( void ){
+  for(uint8_t i=0;i<count;i++){
+    switch(keys[i].type){
+      case NTP_KEY_MD5:{
+        mbedtls_md5_free(&keys[i].ctx.md5);
+      } break;
+
+      case NTP_KEY_SHA1:{
+        mbedtls_sha1_free(&keys[i].ctx.sha1);
+      } break;
+
+      case NTP_KEY_AES128CMAC:{
+        ntp_cmac_free(&keys[i].ctx.cmac);
+      } break;
+
+      default:{
+      } break;
+    }
+  }
+  memset(keys, 0, sizeof(keys));
+  count = 0;
+}
+
+/**************************************************************************************************
+ *    Function      : Load
+ *    Class         : NTP_KeyTable
+ *    Description   : Replaces the keys and prepares them for use
+ *    Input         : const ntp_keys_settings_t* conf
+ *    Output        : none
+ *    Remarks       : Invalid keys are skipped
+ **************************************************************************************************/
+void NTP_KeyTable::Load( const ntp_keys_settings_t* conf ){
+  Free();
+  for(uint8_t i=0;i<NTP_KEYS_MAX;i++){
+    const ntp_key_t* key = &conf->keys[i];
+    if( false == IsValid(key) ){
+      continue;
+    }
+    ntp_key_schedule_t* slot = &keys[count];
+    slot->id = key->id;
+    slot->type = key->type;
+    switch(key->type){
+      case NTP_KEY_MD5:{
+        /* The legacy digest is taken over key and packet, so the key is hashed once here */
+        mbedtls_md5_init(&slot->ctx.md5);
+        mbedtls_md5_starts_ret(&slot->ctx.md5);
+        mbedtls_md5_update_ret(&slot->ctx.md5, key->key, key->len);
+      } break;
+
+      case NTP_KEY_SHA1:{
+        mbedtls_sha1_init(&slot->ctx.sha1);
+        mbedtls_sha1_starts_ret(&slot->ctx.sha1);
+        mbedtls_sha1_update_ret(&slot->ctx.sha1, key->key, key->len);
+      } break;
+
+      case NTP_KEY_AES128CMAC:{
+        ntp_cmac_setkey(&slot->ctx.cmac, key->key);
+      } break;
+
+      default:{
+      } break;
+    }
+    count++;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : Find
+ *    Class         : NTP_KeyTable
+ *    Description   : Looks up a key by its id
+ *    Input         : uint32_t id
+ *    Output        : int8_t ( slot of the key or -1 )
+ *    Remarks       : none
+ **************************************************************************************************/
+int8_t NTP_KeyTable::Find( uint32_t id ){
+  for(uint8_t i=0;i<count;i++){
+    if(keys[i].id == id){
+      return i;
+    }
+  }
+  return -1;
+}
+
+/**************************************************************************************************
+ *    Function      : Digest
+ *    Class         : NTP_KeyTable
+ *    Description   : Computes the digest of a message with a prepared key
+ *    Input         : ntp_key_schedule_t* key, const uint8_t* data, uint16_t len, uint8_t* digest
+ *    Output        : bool
+ *    Remarks       : The prepared key state is copied, so the per packet cost is the message only
+ **************************************************************************************************/
+bool NTP_KeyTable::Digest( ntp_key_schedule_t* key, const uint8_t* data, uint16_t len, uint8_t* digest ){
+  switch(key->type){
+    case NTP_KEY_MD5:{
+      mbedtls_md5_context md5;
+      mbedtls_md5_init(&md5);
+      mbedtls_md5_clone(&md5, &key->ctx.md5);
+      mbedtls_md5_update_ret(&md5, data, len);
+      mbedtls_md5_finish_ret(&md5, digest);
+      mbedtls_md5_free(&md5);
+    } break;
+
+    case NTP_KEY_SHA1:{
+      mbedtls_sha1_context sha1;
+      mbedtls_sha1_init(&sha1);
+      mbedtls_sha1_clone(&sha1, &key->ctx.sha1);
+      mbedtls_sha1_update_ret(&sha1, data, len);
+      mbedtls_sha1_finish_ret(&sha1, digest);
+      mbedtls_sha1_free(&sha1);
+    } break;
+
+    case NTP_KEY_AES128CMAC:{
+      ntp_cmac(&key->ctx.cmac, data, len, digest);
+    } break;
+
+    default:{
+      return false;
+    }
+  }
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : Verify
+ *    Class         : NTP_KeyTable
+ *    Description   : Checks the MAC of a packet
+ *    Input         : int8_t slot, const uint8_t* data, uint16_t len, const uint8_t* mac, uint16_t mac_len
+ *    Output        : bool
+ *    Remarks       : len is the part of the packet in front of the MAC
+ **************************************************************************************************/
+bool NTP_KeyTable::Verify( int8_t slot, const uint8_t* data, uint16_t len, const uint8_t* mac, uint16_t mac_len ){
+  uint8_t digest[20];
+  uint8_t diff = 0;
+  if( (slot < 0) || (slot >= count) ){
+    return false;
+  }
+  uint8_t digest_len = DigestLength(keys[slot].type);
+  if( mac_len != ( 4 + digest_len ) ){
+    return false;
+  }
+  if( false == Digest(&keys[slot], data, len, digest) ){
+    return false;
+  }
+  /* Compare in constant time */
+  for(uint8_t i=0;i<digest_len;i++){
+    diff |= digest[i] ^ mac[4+i];
+  }
+  return ( diff == 0 );
+}
+
+/**************************************************************************************************
+ *    Function      : Sign
+ *    Class         : NTP_KeyTable
+ *    Description   : Appends the MAC to a packet
+ *    Input         : int8_t slot, uint8_t* data, uint16_t len
+ *    Output        : uint16_t ( length of the MAC )
+ *    Remarks       : data needs room for NTP_MAC_MAX_LEN bytes behind len
+ **************************************************************************************************/
+uint16_t NTP_KeyTable::Sign( int8_t slot, uint8_t* data, uint16_t len ){
+  if( (slot < 0) || (slot >= count) ){
+    return 0;
+  }
+  uint32_t id = keys[slot].id;
+  data[len] = id >> 24;
+  data[len+1] = id >> 16;
+  data[len+2] = id >> 8;
+  data[len+3] = id;
+  if( false == Digest(&keys[slot], data, len, &data[len+4]) ){
+    return 0;
+  }
+  return 4 + DigestLength(keys[slot].type);
+}
@@ -0,0 +1,138 @@
+#ifndef NTP_AUTH_H_
+ #define NTP_AUTH_H_
+
+#include <stdint.h>
+#include "mbedtls/md5.h"
+#include "mbedtls/sha1.h"
+#include "ntp_cmac.h"
+
+/* Symmetric keys the server knows */
+#ifndef NTP_KEYS_MAX
+ #define NTP_KEYS_MAX ( 8 )
+#endif
+
+/* Longest key we store, enough for a SHA1 key in hex notation of ntpd */
+#define NTP_KEY_LEN_MAX ( 20 )
+
+/* Length of an AES-128 key */
+#define NTP_KEY_AES128_LEN ( 16 )
+
+typedef enum {
+  NTP_KEY_NONE = 0,
+  NTP_KEY_MD5,
+  NTP_KEY_SHA1,
+  NTP_KEY_AES128CMAC
+} ntp_key_type_t;
+
+typedef struct {
+  uint32_t id;                   /* Key id as sent with the MAC, 0 is not valid */
+  uint8_t type;                  /* ntp_key_type_t */
+  uint8_t len;
+  uint8_t key[NTP_KEY_LEN_MAX];
+} ntp_key_t;
+
+/* The key table as it is stored */
+typedef struct {
+  ntp_key_t keys[NTP_KEYS_MAX];
+} ntp_keys_settings_t;
+
+/* A key prepared for use, the expensive part of the MAC is done once the key is loaded */
+typedef struct {
+  uint32_t id;
+  uint8_t type;
+  union {
+    mbedtls_md5_context md5;     /* State after the key was hashed */
+    mbedtls_sha1_context sha1;   /* State after the key was hashed */
+    ntp_cmac_key_t cmac;         /* Key schedule and subkeys */
+  } ctx;
+} ntp_key_schedule_t;
+
+/*
+ * Key table for the symmetric key authentication of RFC 5905 with
+ * MD5 and SHA1 digests and AES-128-CMAC as of RFC 8573.
+ */
+class NTP_KeyTable {
+
+public:
+    NTP_KeyTable( );
+    ~NTP_KeyTable( );
+
+    /**************************************************************************************************
+     *    Function      : Load
+     *    Class         : NTP_KeyTable
+     *    Description   : Replaces the keys and prepares them for use
+     *    Input         : const ntp_keys_settings_t* conf
+     *    Output        : none
+     *    Remarks       : Invalid keys are skipped
+     **************************************************************************************************/
+    void Load( const ntp_keys_settings_t* conf );
+
+    /**************************************************************************************************
+     *    Function      : Find
+     *    Class         : NTP_KeyTable
+     *    Description   : Looks up a key by its id
+     *    Input         : uint32_t id
+     *    Output        : int8_t ( slot of the key or -1 )
+     *    Remarks       : none
+     **************************************************************************************************/
+    int8_t Find( uint32_t id );
+
+    /**************************************************************************************************
+     *    Function      : Verify
+     *    Class         : NTP_KeyTable
+     *    Description   : Checks the MAC of a packet
+     *    Input         : int8_t slot, const uint8_t* data, uint16_t len, const uint8_t* mac, uint16_t mac_len
+     *    Output        : bool
+     *    Remarks       : len is the part of the packet in front of the MAC
+     **************************************************************************************************/
+    bool Verify( int8_t slot, const uint8_t* data, uint16_t len, const uint8_t* mac, uint16_t mac_len );
+
+    /**************************************************************************************************
+     *    Function      : Sign
+     *    Class         : NTP_KeyTable
+     *    Description   : Appends the MAC to a packet
+     *    Input         : int8_t slot, uint8_t* data, uint16_t len
+     *    Output        : uint16_t ( length of the MAC )
+     *    Remarks       : data needs room for NTP_MAC_MAX_LEN bytes behind len
+     **************************************************************************************************/
+    uint16_t Sign( int8_t slot, uint8_t* data, uint16_t len );
+
+    /**************************************************************************************************
+     *    Function      : DigestLength
+     *    Class         : NTP_KeyTable
+     *    Description   : Returns the length of the digest a key type produces
+     *    Input         : uint8_t type
+     *    Output        : uint8_t ( 0 for unknown types )
+     *    Remarks       : none
+     **************************************************************************************************/
+    static uint8_t DigestLength( uint8_t type );
+
+    /**************************************************************************************************
+     *    Function      : IsValid
+     *    Class         : NTP_KeyTable
+     *    Description   : Checks if a key can be loaded
+     *    Input         : const ntp_key_t* key
+     *    Output        : bool
+     *    Remarks       : AES-128-CMAC keys need to be 16 bytes long
+     **************************************************************************************************/
+    static bool IsValid( const ntp_key_t* key );
+
+    /**************************************************************************************************
+     *    Function      : GetDefaultConfig
+     *    Class         : NTP_KeyTable
+     *    Description   : Returns an empty key table
+     *    Input         : none
+     *    Output        : ntp_keys_settings_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    static ntp_keys_settings_t GetDefaultConfig( void );
+
+private:
+    ntp_key_schedule_t keys[NTP_KEYS_MAX];
+    uint8_t count;
+
+    void Free( void );
+    bool Digest( ntp_key_schedule_t* key, const uint8_t* data, uint16_t len, uint8_t* digest );
+};
+
+#endif
@@ -0,0 +1,56 @@
+#include <string.h>
+#include "ntp_broadcast.h"
+
+/**************************************************************************************************
+ *    Function      : ntp_broadcast_default_config
+ *    Description   : Gets the default broadcast config
+ *    Input         : none
+ *    Output        : broadcast_settings_t
+ *    Remarks       : Broadcasts are off by default
+ **************************************************************************************************/
+broadcast_settings_t ntp_broadcast_default_config( void ){
+  broadcast_settings_t conf;
+  conf.broadcast = false;
+  conf.multicast = false;
+  conf.poll = 6;
+  conf.ttl = 1;
+  return conf;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_broadcast_due
+ *    Description   : Checks if a broadcast is to be sent in a second
+ *    Input         : const broadcast_settings_t* conf, uint32_t seconds
+ *    Output        : bool
+ *    Remarks       : Aligned to multiples of the interval, so all servers send at the same time
+ **************************************************************************************************/
+bool ntp_broadcast_due( const broadcast_settings_t* conf, uint32_t seconds ){
+  if( (false == conf->broadcast) && (false == conf->multicast) ){
+    return false;
+  }
+  uint8_t poll = conf->poll;
+  if(poll < NTP_BROADCAST_POLL_MIN){
+    poll = NTP_BROADCAST_POLL_MIN;
+  } else if(poll > NTP_BROADCAST_POLL_MAX){
+    poll = NTP_BROADCAST_POLL_MAX;
+  }
+  return ( 0 == ( seconds & ( ( 1UL << poll ) - 1 ) ) );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_build_broadcast
+ *    Description   : Builds a mode 5 packet from the template
+ *    Input         : ntp_packet_t* pkt, const ntp_packet_t* tpl, uint8_t poll
+ *    Output        : none
+ *    Remarks       : The transmit timestamp needs to be set with ntp_stamp_transmit
+ **************************************************************************************************/
+void ntp_build_broadcast( ntp_packet_t* pkt, const ntp_packet_t* tpl, uint8_t poll ){
+  memcpy(pkt, tpl, sizeof(ntp_packet_t));
+  pkt->flags.mode = 5; // Broadcast
+  pkt->poll = poll;
+  /* Nothing to originate from, the client uses the transmit time only */
+  pkt->origTm_s = 0;
+  pkt->origTm_f = 0;
+  pkt->rxTm_s = 0;
+  pkt->rxTm_f = 0;
+}
@@ -0,0 +1,45 @@
+#ifndef NTP_BROADCAST_H_
+ #define NTP_BROADCAST_H_
+
+#include <stdint.h>
+#include "ntp_packet.h"
+
+/* Limits for the broadcast interval, as log2 seconds */
+#define NTP_BROADCAST_POLL_MIN ( 4 )
+#define NTP_BROADCAST_POLL_MAX ( 10 )
+
+typedef struct {
+  bool broadcast;  /* Send to the IPv4 limited broadcast address */
+  bool multicast;  /* Send to the NTP multicast group 224.0.1.1 */
+  uint8_t poll;    /* Interval as log2 seconds */
+  uint8_t ttl;     /* Time to live for the multicast packets */
+} broadcast_settings_t;
+
+/**************************************************************************************************
+ *    Function      : ntp_broadcast_default_config
+ *    Description   : Gets the default broadcast config
+ *    Input         : none
+ *    Output        : broadcast_settings_t
+ *    Remarks       : Broadcasts are off by default
+ **************************************************************************************************/
+broadcast_settings_t ntp_broadcast_default_config( void );
+
+/**************************************************************************************************
+ *    Function      : ntp_broadcast_due
+ *    Description   : Checks if a broadcast is to be sent in a second
+ *    Input         : const broadcast_settings_t* conf, uint32_t seconds
+ *    Output        : bool
+ *    Remarks       : Aligned to multiples of the interval, so all servers send at the same time
+ **************************************************************************************************/
+bool ntp_broadcast_due( const broadcast_settings_t* conf, uint32_t seconds );
+
+/**************************************************************************************************
+ *    Function      : ntp_build_broadcast
+ *    Description   : Builds a mode 5 packet from the template
+ *    Input         : ntp_packet_t* pkt, const ntp_packet_t* tpl, uint8_t poll
+ *    Output        : none
+ *    Remarks       : The transmit timestamp needs to be set with ntp_stamp_transmit
+ **************************************************************************************************/
+void ntp_build_broadcast( ntp_packet_t* pkt, const ntp_packet_t* tpl, uint8_t poll );
+
+#endif
@@ -0,0 +1,222 @@
+#include <string.h>
+#include <math.h>
+#include "ntp_census.h"
+
+/* Lower ends of the decades of the histogram, 1ms to 10000s */
+static const float ntp_census_decades[NTP_CENSUS_DECADES] = { 1e-3f, 1e-2f, 1e-1f, 1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f };
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_ClientCensus
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_ClientCensus::NTP_ClientCensus( ){
+  memset(entries, 0, sizeof(entries));
+  memset(&stats, 0, sizeof(stats));
+}
+
+/**************************************************************************************************
+ *    Function      : Find
+ *    Class         : NTP_ClientCensus
+ *    Description   : Returns the entry of a client, a new one if it is not tracked yet
+ *    Input         : const ntp_addr_t* client, uint32_t hash, uint32_t now
+ *    Output        : ntp_census_entry_t*
+ *    Remarks       : The least recently seen client in the probe window is evicted
+ **************************************************************************************************/
+ntp_census_entry_t* NTP_ClientCensus::Find( const ntp_addr_t* client, uint32_t hash, uint32_t now ){
+  uint32_t idx = (uint32_t)( ( (uint64_t)hash * NTP_CENSUS_ENTRIES ) >> 32 );
+  ntp_census_entry_t* victim = NULL;
+  uint32_t victim_age = 0;
+
+  for(uint32_t i=0;i<NTP_CENSUS_PROBES;i++){
+    ntp_census_entry_t* e = &entries[ (idx + i) & ( NTP_CENSUS_ENTRIES - 1 ) ];
+    if( (e->last != 0) && (true == ntp_addr_equal(&e->client, client)) ){
+      return e;
+    }
+    if(e->last == 0){
+      victim = e;
+      break;
+    }
+    uint32_t age = now - e->last;
+    if( (victim == NULL) || (age > victim_age) ){
+      victim = e;
+      victim_age = age;
+    }
+  }
+
+  if(victim->last != 0){
+    stats.evictions++;
+  }
+  memset(victim, 0, sizeof(ntp_census_entry_t));
+  victim->client = *client;
+  victim->first = now;
+  return victim;
+}
+
+/**************************************************************************************************
+ *    Function      : Bin
+ *    Class         : NTP_ClientCensus
+ *    Description   : Returns the histogram bin of an estimate
+ *    Input         : float offset
+ *    Output        : uint8_t
+ *    Remarks       : none
+ **************************************************************************************************/
+uint8_t NTP_ClientCensus::Bin( float offset ){
+  float magnitude = fabsf(offset);
+  if(magnitude < ntp_census_decades[0]){
+    return NTP_CENSUS_DECADES;
+  }
+  uint8_t decade = 0;
+  while( (decade < ( NTP_CENSUS_DECADES - 1 ) ) && (magnitude >= ntp_census_decades[decade + 1]) ){
+    decade++;
+  }
+  if(offset > 0){
+    return NTP_CENSUS_DECADES + 1 + decade;
+  }
+  return NTP_CENSUS_DECADES - 1 - decade;
+}
+
+/**************************************************************************************************
+ *    Function      : Add
+ *    Class         : NTP_ClientCensus
+ *    Description   : Takes the clock error estimate of a request
+ *    Input         : const ntp_addr_t* client, uint32_t hash, ntp_time64_t client_tx, ntp_time64_t rx
+ *    Output        : none
+ *    Remarks       : client_tx is the transmit timestamp of the request, rx our receive time.
+ *                    hash is the keyed one of ntp_addr_hash, it only picks the slots to search
+ **************************************************************************************************/
+void NTP_ClientCensus::Add( const ntp_addr_t* client, uint32_t hash, ntp_time64_t client_tx, ntp_time64_t rx ){
+  /* The difference is taken modulo 2^64, so an era change in between does no harm */
+  int64_t diff = ntp_time64_diff(client_tx, rx);
+  if( (client_tx == 0) || (diff > ( (int64_t)NTP_CENSUS_OPAQUE_S << 32 ) ) || (diff < -( (int64_t)NTP_CENSUS_OPAQUE_S << 32 ) ) ){
+    stats.opaque++;
+    return;
+  }
+  float offset = (float)diff / 4294967296.0f;
+  stats.samples++;
+  stats.histogram[Bin(offset)]++;
+
+  uint32_t now = ( ntp_time64_seconds(rx) == 0 ) ? 1 : ntp_time64_seconds(rx);
+  ntp_census_entry_t* e = Find(client, hash, now);
+  float t = (float)( ntp_time64_seconds(rx) - e->first ) + ( (float)ntp_time64_fraction(rx) / 4294967296.0f );
+  e->last = now;
+  if(e->samples < 0xFFFFFFFF){
+    e->samples++;
+  }
+  /* Welford, the co-moment of time and estimate gives the slope without keeping samples */
+  float n = (float)e->samples;
+  float dt = t - e->mean_t;
+  float dx = offset - e->mean;
+  e->mean_t += dt / n;
+  e->mean += dx / n;
+  e->m2_t += dt * ( t - e->mean_t );
+  e->m2 += dx * ( offset - e->mean );
+  e->c_to += dt * ( offset - e->mean );
+
+  e->flags = 0;
+  if(e->samples >= NTP_CENSUS_MIN_SAMPLES){
+    if(fabsf(e->mean) > NTP_CENSUS_OFFSET_LIMIT){
+      e->flags |= NTP_CENSUS_FLAG_OFFSET;
+    }
+    if(fabsf(GetDrift(e)) > NTP_CENSUS_DRIFT_LIMIT){
+      e->flags |= NTP_CENSUS_FLAG_DRIFT;
+    }
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : GetStats
+ *    Class         : NTP_ClientCensus
+ *    Description   : Returns the population histogram and the number of flagged clients
+ *    Input         : none
+ *    Output        : ntp_census_stats_t
+ *    Remarks       : Walks the table
+ **************************************************************************************************/
+ntp_census_stats_t NTP_ClientCensus::GetStats( void ){
+  ntp_census_stats_t out = stats;
+  out.clients = 0;
+  out.far_off = 0;
+  out.drifting = 0;
+  for(uint32_t i=0;i<NTP_CENSUS_ENTRIES;i++){
+    if(entries[i].last == 0){
+      continue;
+    }
+    out.clients++;
+    if(0 != ( entries[i].flags & NTP_CENSUS_FLAG_OFFSET ) ){
+      out.far_off++;
+    }
+    if(0 != ( entries[i].flags & NTP_CENSUS_FLAG_DRIFT ) ){
+      out.drifting++;
+    }
+  }
+  return out;
+}
+
+/**************************************************************************************************
+ *    Function      : GetFlagged
+ *    Class         : NTP_ClientCensus
+ *    Description   : Copies the clients flagged for their offset or drift
+ *    Input         : ntp_census_entry_t* out, uint16_t max
+ *    Output        : uint16_t ( entries copied )
+ *    Remarks       : In table order
+ **************************************************************************************************/
+uint16_t NTP_ClientCensus::GetFlagged( ntp_census_entry_t* out, uint16_t max ){
+  uint16_t copied = 0;
+  for(uint32_t i=0;( i < NTP_CENSUS_ENTRIES ) && ( copied < max );i++){
+    if( (entries[i].last != 0) && (entries[i].flags != 0) ){
+      out[copied++] = entries[i];
+    }
+  }
+  return copied;
+}
+
+/**************************************************************************************************
+ *    Function      : GetStddev
+ *    Class         : NTP_ClientCensus
+ *    Description   : Returns the standard deviation of the estimates of a client
+ *    Input         : const ntp_census_entry_t* e
+ *    Output        : float ( seconds )
+ *    Remarks       : none
+ **************************************************************************************************/
+float NTP_ClientCensus::GetStddev( const ntp_census_entry_t* e ){
+  if( (e->samples < 2) || (e->m2 <= 0) ){
+    return 0;
+  }
+  return sqrtf(e->m2 / (float)( e->samples - 1 ));
+}
+
+/**************************************************************************************************
+ *    Function      : GetDrift
+ *    Class         : NTP_ClientCensus
+ *    Description   : Returns how fast the clock of a client runs off
+ *    Input         : const ntp_census_entry_t* e
+ *    Output        : float ( seconds per second )
+ *    Remarks       : 0 until the samples span NTP_CENSUS_MIN_SPAN seconds
+ **************************************************************************************************/
+float NTP_ClientCensus::GetDrift( const ntp_census_entry_t* e ){
+  if( (e->samples < NTP_CENSUS_MIN_SAMPLES) || ( ( e->last - e->first ) < NTP_CENSUS_MIN_SPAN ) || (e->m2_t <= 0) ){
+    return 0;
+  }
+  return e->c_to / e->m2_t;
+}
+
+/**************************************************************************************************
+ *    Function      : GetBinLimit
+ *    Class         : NTP_ClientCensus
+ *    Description   : Returns the upper end of a bin of the population histogram
+ *    Input         : uint8_t bin
+ *    Output        : float ( seconds )
+ *    Remarks       : The lowest bin has no lower end, the highest one no upper end
+ **************************************************************************************************/
+float NTP_ClientCensus::GetBinLimit( uint8_t bin ){
+  if(bin >= ( NTP_CENSUS_BINS - 1 ) ){
+    return NTP_CENSUS_OPAQUE_S;
+  }
+  if(bin >= NTP_CENSUS_DECADES){
+    return ntp_census_decades[bin - NTP_CENSUS_DECADES];
+  }
+  return -ntp_census_decades[NTP_CENSUS_DECADES - 1 - bin];
+}
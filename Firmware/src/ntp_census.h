@@ -0,0 +1,150 @@
+#ifndef NTP_CENSUS_H_
+ #define NTP_CENSUS_H_
+
+#include <stdint.h>
+#include "ntp_timestamp.h"
+#include "ntp_addr.h"
+
+/* Number of clients tracked by the census, needs to be a power of two */
+#ifndef NTP_CENSUS_ENTRIES
+ #define NTP_CENSUS_ENTRIES ( 256 )
+#endif
+
+/* Slots searched for a client before the least recently seen one is evicted */
+#define NTP_CENSUS_PROBES ( 4 )
+
+/*
+ * Clients off by more than a day are taken as sending a random transmit timestamp,
+ * as those do that hide their clock, and are left out
+ */
+#define NTP_CENSUS_OPAQUE_S ( 86400 )
+
+/* A client is flagged if the mean of its estimates is further off than this, seconds */
+#ifndef NTP_CENSUS_OFFSET_LIMIT
+ #define NTP_CENSUS_OFFSET_LIMIT ( 0.128f )
+#endif
+
+/* A client is flagged if its clock runs faster or slower than this, seconds per second */
+#ifndef NTP_CENSUS_DRIFT_LIMIT
+ #define NTP_CENSUS_DRIFT_LIMIT ( 100e-6f )
+#endif
+
+/* Samples and seconds needed before a client is judged, the drift of short spans is noise */
+#define NTP_CENSUS_MIN_SAMPLES ( 8 )
+#define NTP_CENSUS_MIN_SPAN ( 256 )
+
+#define NTP_CENSUS_FLAG_OFFSET ( 0x01 )
+#define NTP_CENSUS_FLAG_DRIFT ( 0x02 )
+
+/*
+ * Population histogram of the estimates, decades from 1ms to 10000s on either
+ * side and one bin for everything closer than 1ms in the middle
+ */
+#define NTP_CENSUS_DECADES ( 8 )
+#define NTP_CENSUS_BINS ( ( 2 * NTP_CENSUS_DECADES ) + 1 )
+
+/*
+ * Running statistics of one client, Welford style, so no samples are kept.
+ * The offset estimate is the client transmit time minus our receive time,
+ * the client clock error less the one way delay. The drift is the slope of
+ * a line fitted through the estimates over time.
+ */
+typedef struct {
+  ntp_addr_t client;
+  uint32_t first;     /* Seconds of our clock of the first sample */
+  uint32_t last;      /* Seconds of our clock of the last sample, 0 marks an empty slot */
+  uint32_t samples;
+  float mean;         /* Mean of the estimates in seconds */
+  float m2;           /* Sum of the squared deviations from the mean */
+  float mean_t;       /* Mean time of the samples in seconds since the first one */
+  float m2_t;         /* Sum of the squared deviations of the time */
+  float c_to;         /* Sum of the products of time and estimate deviations */
+  uint8_t flags;
+} ntp_census_entry_t;
+
+typedef struct {
+  uint32_t samples;   /* Estimates taken */
+  uint32_t opaque;    /* Requests whose transmit timestamp is zero or random */
+  uint32_t evictions; /* Clients thrown out to make room */
+  uint16_t clients;   /* Clients tracked */
+  uint16_t far_off;   /* Of them flagged for their offset */
+  uint16_t drifting;  /* Of them flagged for their drift */
+  uint32_t histogram[NTP_CENSUS_BINS];
+} ntp_census_stats_t;
+
+/* Fixed size open addressing hash table with running clock statistics per client */
+class NTP_ClientCensus {
+
+public:
+    NTP_ClientCensus( );
+
+    /**************************************************************************************************
+     *    Function      : Add
+     *    Class         : NTP_ClientCensus
+     *    Description   : Takes the clock error estimate of a request
+     *    Input         : const ntp_addr_t* client, uint32_t hash, ntp_time64_t client_tx, ntp_time64_t rx
+     *    Output        : none
+     *    Remarks       : client_tx is the transmit timestamp of the request, rx our receive time.
+     *                    hash is the keyed one of ntp_addr_hash, it only picks the slots to search
+     **************************************************************************************************/
+    void Add( const ntp_addr_t* client, uint32_t hash, ntp_time64_t client_tx, ntp_time64_t rx );
+
+    /**************************************************************************************************
+     *    Function      : GetStats
+     *    Class         : NTP_ClientCensus
+     *    Description   : Returns the population histogram and the number of flagged clients
+     *    Input         : none
+     *    Output        : ntp_census_stats_t
+     *    Remarks       : Walks the table
+     **************************************************************************************************/
+    ntp_census_stats_t GetStats( void );
+
+    /**************************************************************************************************
+     *    Function      : GetFlagged
+     *    Class         : NTP_ClientCensus
+     *    Description   : Copies the clients flagged for their offset or drift
+     *    Input         : ntp_census_entry_t* out, uint16_t max
+     *    Output        : uint16_t ( entries copied )
+     *    Remarks       : In table order
+     **************************************************************************************************/
+    uint16_t GetFlagged( ntp_census_entry_t* out, uint16_t max );
+
+    /**************************************************************************************************
+     *    Function      : GetStddev
+     *    Class         : NTP_ClientCensus
+     *    Description   : Returns the standard deviation of the estimates of a client
+     *    Input         : const ntp_census_entry_t* e
+     *    Output        : float ( seconds )
+     *    Remarks       : none
+     **************************************************************************************************/
+    static float GetStddev( const ntp_census_entry_t* e );
+
+    /**************************************************************************************************
+     *    Function      : GetDrift
+     *    Class         : NTP_ClientCensus
+     *    Description   : Returns how fast the clock of a client runs off
+     *    Input         : const ntp_census_entry_t* e
+     *    Output        : float ( seconds per second )
+     *    Remarks       : 0 until the samples span NTP_CENSUS_MIN_SPAN seconds
+     **************************************************************************************************/
+    static float GetDrift( const ntp_census_entry_t* e );
+
+    /**************************************************************************************************
+     *    Function      : GetBinLimit
+     *    Class         : NTP_ClientCensus
+     *    Description   : Returns the upper end of a bin of the population histogram
+     *    Input         : uint8_t bin
+     *    Output        : float ( seconds )
+     *    Remarks       : The lowest bin has no lower end, the highest one no upper end
+     **************************************************************************************************/
+    static float GetBinLimit( uint8_t bin );
+
+private:
+    ntp_census_entry_t entries[NTP_CENSUS_ENTRIES];
+    ntp_census_stats_t stats;
+
+    ntp_census_entry_t* Find( const ntp_addr_t* client, uint32_t hash, uint32_t now );
+    static uint8_t Bin( float offset );
+};
+
+#endif
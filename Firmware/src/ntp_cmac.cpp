@@ -0,0 +1,138 @@
+#include <string.h>
+#include "ntp_cmac.h"
+
+/* Bytes run through AES-CBC with a single call, keeps the stack small */
+#define NTP_CMAC_CHUNK ( 64 )
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac_dbl
+ *    Description   : Doubles a block in GF(2^128)
+ *    Input         : const uint8_t* in, uint8_t* out
+ *    Output        : none
+ *    Remarks       : Used for the CMAC subkeys and by S2V of AES-SIV
+ **************************************************************************************************/
+void ntp_cmac_dbl( const uint8_t* in, uint8_t* out ){
+  uint8_t carry = in[0] >> 7;
+  for(uint8_t i=0;i<NTP_CMAC_BLOCK-1;i++){
+    out[i] = ( in[i] << 1 ) | ( in[i+1] >> 7 );
+  }
+  out[NTP_CMAC_BLOCK-1] = ( in[NTP_CMAC_BLOCK-1] << 1 ) ^ ( carry * 0x87 );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac_setkey
+ *    Description   : Prepares an AES-128 key for CMAC
+ *    Input         : ntp_cmac_key_t* key, const uint8_t* raw
+ *    Output        : none
+ *    Remarks       : raw is 16 bytes, RFC 4493
+ **************************************************************************************************/
+void ntp_cmac_setkey( ntp_cmac_key_t* key, const uint8_t* raw ){
+  uint8_t l[NTP_CMAC_BLOCK];
+  memset(l, 0, sizeof(l));
+  mbedtls_aes_init(&key->aes);
+  mbedtls_aes_setkey_enc(&key->aes, raw, 128);
+  mbedtls_aes_crypt_ecb(&key->aes, MBEDTLS_AES_ENCRYPT, l, l);
+  ntp_cmac_dbl(l, key->k1);
+  ntp_cmac_dbl(key->k1, key->k2);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac_free
+ *    Description   : Releases a prepared key
+ *    Input         : ntp_cmac_key_t* key
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void ntp_cmac_free( ntp_cmac_key_t* key ){
+  mbedtls_aes_free(&key->aes);
+  memset(key->k1, 0, sizeof(key->k1));
+  memset(key->k2, 0, sizeof(key->k2));
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac_start
+ *    Description   : Starts a new CMAC
+ *    Input         : ntp_cmac_ctx_t* ctx, ntp_cmac_key_t* key
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void ntp_cmac_start( ntp_cmac_ctx_t* ctx, ntp_cmac_key_t* key ){
+  ctx->key = key;
+  ctx->len = 0;
+  memset(ctx->x, 0, sizeof(ctx->x));
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac_update
+ *    Description   : Adds data to a CMAC
+ *    Input         : ntp_cmac_ctx_t* ctx, const uint8_t* data, uint16_t len
+ *    Output        : none
+ *    Remarks       : Complete blocks are run through AES-CBC in one call
+ **************************************************************************************************/
+void ntp_cmac_update( ntp_cmac_ctx_t* ctx, const uint8_t* data, uint16_t len ){
+  uint8_t out[NTP_CMAC_CHUNK];
+  while(len > 0){
+    if(ctx->len == NTP_CMAC_BLOCK){
+      /* More data follows, so the held back block was not the last one */
+      mbedtls_aes_crypt_cbc(&ctx->key->aes, MBEDTLS_AES_ENCRYPT, NTP_CMAC_BLOCK, ctx->x, ctx->buf, out);
+      ctx->len = 0;
+    }
+    if( (ctx->len == 0) && (len > NTP_CMAC_BLOCK) ){
+      /* Everything but the last block goes straight through, the IV carries the state */
+      uint16_t chunk = ( ( len - 1 ) / NTP_CMAC_BLOCK ) * NTP_CMAC_BLOCK;
+      if(chunk > NTP_CMAC_CHUNK){
+        chunk = NTP_CMAC_CHUNK;
+      }
+      mbedtls_aes_crypt_cbc(&ctx->key->aes, MBEDTLS_AES_ENCRYPT, chunk, ctx->x, data, out);
+      data += chunk;
+      len -= chunk;
+      continue;
+    }
+    uint16_t take = NTP_CMAC_BLOCK - ctx->len;
+    if(take > len){
+      take = len;
+    }
+    memcpy(&ctx->buf[ctx->len], data, take);
+    ctx->len += take;
+    data += take;
+    len -= take;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac_finish
+ *    Description   : Completes a CMAC
+ *    Input         : ntp_cmac_ctx_t* ctx, uint8_t* tag
+ *    Output        : none
+ *    Remarks       : tag is 16 bytes
+ **************************************************************************************************/
+void ntp_cmac_finish( ntp_cmac_ctx_t* ctx, uint8_t* tag ){
+  uint8_t last[NTP_CMAC_BLOCK];
+  if(ctx->len == NTP_CMAC_BLOCK){
+    for(uint8_t i=0;i<NTP_CMAC_BLOCK;i++){
+      last[i] = ctx->buf[i] ^ ctx->key->k1[i];
+    }
+  } else {
+    memset(last, 0, sizeof(last));
+    memcpy(last, ctx->buf, ctx->len);
+    last[ctx->len] = 0x80;
+    for(uint8_t i=0;i<NTP_CMAC_BLOCK;i++){
+      last[i] ^= ctx->key->k2[i];
+    }
+  }
+  mbedtls_aes_crypt_cbc(&ctx->key->aes, MBEDTLS_AES_ENCRYPT, NTP_CMAC_BLOCK, ctx->x, last, tag);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac
+ *    Description   : Computes the CMAC of a message
+ *    Input         : ntp_cmac_key_t* key, const uint8_t* data, uint16_t len, uint8_t* tag
+ *    Output        : none
+ *    Remarks       : tag is 16 bytes
+ **************************************************************************************************/
+void ntp_cmac( ntp_cmac_key_t* key, const uint8_t* data, uint16_t len, uint8_t* tag ){
+  ntp_cmac_ctx_t ctx;
+  ntp_cmac_start(&ctx, key);
+  ntp_cmac_update(&ctx, data, len);
+  ntp_cmac_finish(&ctx, tag);
+}
@@ -0,0 +1,87 @@
+#ifndef NTP_CMAC_H_
+ #define NTP_CMAC_H_
+
+#include <stdint.h>
+#include "mbedtls/aes.h"
+
+#define NTP_CMAC_BLOCK ( 16 )
+
+/* AES-128 key schedule and the two CMAC subkeys, prepared once per key */
+typedef struct {
+  mbedtls_aes_context aes;
+  uint8_t k1[NTP_CMAC_BLOCK];   /* Subkey for a complete last block */
+  uint8_t k2[NTP_CMAC_BLOCK];   /* Subkey for a padded last block */
+} ntp_cmac_key_t;
+
+/* A CMAC in progress, the last block is held back until the end */
+typedef struct {
+  ntp_cmac_key_t* key;
+  uint8_t x[NTP_CMAC_BLOCK];
+  uint8_t buf[NTP_CMAC_BLOCK];
+  uint8_t len;
+} ntp_cmac_ctx_t;
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac_setkey
+ *    Description   : Prepares an AES-128 key for CMAC
+ *    Input         : ntp_cmac_key_t* key, const uint8_t* raw
+ *    Output        : none
+ *    Remarks       : raw is 16 bytes, RFC 4493
+ **************************************************************************************************/
+void ntp_cmac_setkey( ntp_cmac_key_t* key, const uint8_t* raw );
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac_free
+ *    Description   : Releases a prepared key
+ *    Input         : ntp_cmac_key_t* key
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void ntp_cmac_free( ntp_cmac_key_t* key );
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac_start
+ *    Description   : Starts a new CMAC
+ *    Input         : ntp_cmac_ctx_t* ctx, ntp_cmac_key_t* key
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void ntp_cmac_start( ntp_cmac_ctx_t* ctx, ntp_cmac_key_t* key );
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac_update
+ *    Description   : Adds data to a CMAC
+ *    Input         : ntp_cmac_ctx_t* ctx, const uint8_t* data, uint16_t len
+ *    Output        : none
+ *    Remarks       : Complete blocks are run through AES-CBC in one call
+ **************************************************************************************************/
+void ntp_cmac_update( ntp_cmac_ctx_t* ctx, const uint8_t* data, uint16_t len );
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac_finish
+ *    Description   : Completes a CMAC
+ *    Input         : ntp_cmac_ctx_t* ctx, uint8_t* tag
+ *    Output        : none
+ *    Remarks       : tag is 16 bytes
+ **************************************************************************************************/
+void ntp_cmac_finish( ntp_cmac_ctx_t* ctx, uint8_t* tag );
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac
+ *    Description   : Computes the CMAC of a message
+ *    Input         : ntp_cmac_key_t* key, const uint8_t* data, uint16_t len, uint8_t* tag
+ *    Output        : none
+ *    Remarks       : tag is 16 bytes
+ **************************************************************************************************/
+void ntp_cmac( ntp_cmac_key_t* key, const uint8_t* data, uint16_t len, uint8_t* tag );
+
+/**************************************************************************************************
+ *    Function      : ntp_cmac_dbl
+ *    Description   : Doubles a block in GF(2^128)
+ *    Input         : const uint8_t* in, uint8_t* out
+ *    Output        : none
+ *    Remarks       : Used for the CMAC subkeys and by S2V of AES-SIV
+ **************************************************************************************************/
+void ntp_cmac_dbl( const uint8_t* in, uint8_t* out );
+
+#endif
@@ -0,0 +1,784 @@
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "ntp_control.h"
+
+#ifdef ARDUINO
+ #include <lwip/def.h>
+#else
+ #include <arpa/inet.h>
+#endif
+
+/* Response, error and more bit in r_e_m_op */
+#define NTP_CONTROL_RESPONSE ( 0x80 )
+#define NTP_CONTROL_ERROR ( 0x40 )
+#define NTP_CONTROL_MORE ( 0x20 )
+#define NTP_CONTROL_OPCODE ( 0x1F )
+
+/* Clock source in the system status word */
+#define NTP_CONTROL_SRC_UNSPEC ( 0 )
+#define NTP_CONTROL_SRC_ATOM ( 1 )
+#define NTP_CONTROL_SRC_UHF ( 4 )
+#define NTP_CONTROL_SRC_NTP ( 6 )
+
+/* A nonce is valid for this many seconds */
+#define NTP_CONTROL_NONCE_LIFETIME ( 16 )
+
+/* System variables in the order sent by ntpq -c rv */
+typedef enum {
+  SYSVAR_VERSION = 0,
+  SYSVAR_PROCESSOR,
+  SYSVAR_SYSTEM,
+  SYSVAR_LEAP,
+  SYSVAR_STRATUM,
+  SYSVAR_PRECISION,
+  SYSVAR_ROOTDELAY,
+  SYSVAR_ROOTDISP,
+  SYSVAR_REFID,
+  SYSVAR_REFTIME,
+  SYSVAR_CLOCK,
+  SYSVAR_OFFSET,
+  SYSVAR_SYS_JITTER,
+  SYSVAR_CLK_JITTER,
+  SYSVAR_SS_UPTIME,
+  SYSVAR_SS_RECEIVED,
+  SYSVAR_SS_PROCESSED,
+  SYSVAR_SS_DECLINED,
+  SYSVAR_SS_LIMITED,
+  SYSVAR_SS_KODSENT,
+  SYSVAR_CNT
+} ntp_control_sysvar_t;
+
+static const char* const ntp_control_sysvar_names[SYSVAR_CNT] = {
+  "version",
+  "processor",
+  "system",
+  "leap",
+  "stratum",
+  "precision",
+  "rootdelay",
+  "rootdisp",
+  "refid",
+  "reftime",
+  "clock",
+  "offset",
+  "sys_jitter",
+  "clk_jitter",
+  "ss_uptime",
+  "ss_received",
+  "ss_processed",
+  "ss_declined",
+  "ss_limited",
+  "ss_kodsent"
+};
+
+/**************************************************************************************************
+ *    Function      : ntp_control_put_ms
+ *    Description   : Formats nanoseconds as milliseconds
+ *    Input         : char* buf, size_t size, const char* name, int64_t ns, bool fine
+ *    Output        : none
+ *    Remarks       : Six digits after the point if fine is set, three otherwise
+ **************************************************************************************************/
+static void ntp_control_put_ms( char* buf, size_t size, const char* name, int64_t ns, bool fine ){
+  const char* sign = "";
+  uint64_t value = ns;
+  if(ns < 0){
+    sign = "-";
+    value = -ns;
+  }
+  if(true == fine){
+    snprintf(buf, size, "%s=%s%u.%06u", name, sign, (unsigned)(value / 1000000), (unsigned)(value % 1000000));
+  } else {
+    value = value / 1000;
+    snprintf(buf, size, "%s=%s%u.%03u", name, sign, (unsigned)(value / 1000), (unsigned)(value % 1000));
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_control_put_addr
+ *    Description   : Formats an IPv4 address kept in network byte order
+ *    Input         : char* buf, size_t size, uint32_t addr
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+static void ntp_control_put_addr( char* buf, size_t size, uint32_t addr ){
+  uint8_t b[4];
+  memcpy(b, &addr, sizeof(b));
+  snprintf(buf, size, "%u.%u.%u.%u", b[0], b[1], b[2], b[3]);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_control_parse_ts
+ *    Description   : Reads a timestamp in the form 0xsssssssss.ffffffff
+ *    Input         : const char* str, ntp_timestamp_t* ts
+ *    Output        : bool
+ *    Remarks       : none
+ **************************************************************************************************/
+static bool ntp_control_parse_ts( const char* str, ntp_timestamp_t* ts ){
+  char* end;
+  ts->seconds = strtoul(str, &end, 16);
+  if(*end != '.'){
+    return false;
+  }
+  ts->fraction = strtoul(end + 1, &end, 16);
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_control_next_item
+ *    Description   : Splits the next name=value item off a request payload
+ *    Input         : char** pos, char** name, char** value
+ *    Output        : bool ( false if there are no more items )
+ *    Remarks       : Terminates name and value in place, value is an empty string if not given
+ **************************************************************************************************/
+static bool ntp_control_next_item( char** pos, char** name, char** value ){
+  char* p = *pos;
+  while( (*p == ',') || (*p == ' ') || (*p == '\r') || (*p == '\n') || (*p == '\t') ){
+    p++;
+  }
+  if(*p == '\0'){
+    return false;
+  }
+  char* end = strchr(p, ',');
+  if(end == NULL){
+    end = p + strlen(p);
+    *pos = end;
+  } else {
+    *end = '\0';
+    *pos = end + 1;
+  }
+  /* Strip trailing whitespace */
+  while( (end > p) && ( (end[-1] == ' ') || (end[-1] == '\r') || (end[-1] == '\n') || (end[-1] == '\t') ) ){
+    end--;
+    *end = '\0';
+  }
+  *name = p;
+  char* eq = strchr(p, '=');
+  if(eq == NULL){
+    *value = end;
+  } else {
+    *eq = '\0';
+    *value = eq + 1;
+  }
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_control_mix
+ *    Description   : Mixes the bits of a word
+ *    Input         : uint32_t x
+ *    Output        : uint32_t
+ *    Remarks       : none
+ **************************************************************************************************/
+static uint32_t ntp_control_mix( uint32_t x ){
+  x ^= x >> 16;
+  x *= 0x7FEB352D;
+  x ^= x >> 15;
+  x *= 0x846CA68B;
+  x ^= x >> 16;
+  return x;
+}
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_ControlResponder
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_ControlResponder::NTP_ControlResponder( ){
+  salt = 0;
+  resp_len = 0;
+  resp_offset = 0;
+  resp_frags = 0;
+  resp_frags_max = NTP_CONTROL_FRAGS_MAX;
+  resp_items = false;
+  resp_send = NULL;
+  resp_ctx = NULL;
+}
+
+/**************************************************************************************************
+ *    Function      : SetSalt
+ *    Class         : NTP_ControlResponder
+ *    Description   : Sets the secret the mrulist nonces are derived from
+ *    Input         : uint32_t salt
+ *    Output        : none
+ *    Remarks       : Should be random
+ **************************************************************************************************/
+void NTP_ControlResponder::SetSalt( uint32_t salt ){
+  this->salt = salt;
+}
+
+/**************************************************************************************************
+ *    Function      : IsControlRequest
+ *    Class         : NTP_ControlResponder
+ *    Description   : Checks if a datagram is a mode 6 request
+ *    Input         : const uint8_t* data, uint16_t len
+ *    Output        : bool
+ *    Remarks       : none
+ **************************************************************************************************/
+bool NTP_ControlResponder::IsControlRequest( const uint8_t* data, uint16_t len ){
+  if(len < NTP_CONTROL_HEADER_LEN){
+    return false;
+  }
+  uint8_t vn = ( data[0] >> 3 ) & 0x07;
+  return ( ( data[0] & 0x07 ) == 6 ) && ( vn >= 1 ) && ( vn <= 4 ) && ( 0 == ( data[1] & NTP_CONTROL_RESPONSE ) );
+}
+
+/**************************************************************************************************
+ *    Function      : Begin
+ *    Class         : NTP_ControlResponder
+ *    Description   : Starts a response to the request in req
+ *    Input         : uint8_t leap, uint16_t status, ntp_control_send_t send, void* ctx
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_ControlResponder::Begin( uint8_t leap, uint16_t status, ntp_control_send_t send, void* ctx ){
+  resp.li_vn_mode = ( leap << 6 ) | ( req.li_vn_mode & 0x38 ) | 6;
+  resp.r_e_m_op = NTP_CONTROL_RESPONSE | ( req.r_e_m_op & NTP_CONTROL_OPCODE );
+  resp.sequence = req.sequence;
+  resp.status = htons(status);
+  resp.associd = req.associd;
+  resp_len = 0;
+  resp_offset = 0;
+  resp_frags = 0;
+  resp_items = false;
+  resp_send = send;
+  resp_ctx = ctx;
+}
+
+/**************************************************************************************************
+ *    Function      : Flush
+ *    Class         : NTP_ControlResponder
+ *    Description   : Sends the current fragment
+ *    Input         : bool more
+ *    Output        : bool ( false if the fragment limit is reached )
+ *    Remarks       : The payload is padded to a multiple of four bytes
+ **************************************************************************************************/
+bool NTP_ControlResponder::Flush( bool more ){
+  if( (true == more) && ( resp_frags + 1 >= resp_frags_max ) ){
+    return false;
+  }
+  if(resp_frags >= resp_frags_max){
+    return false;
+  }
+  uint16_t padded = ( resp_len + 3 ) & ~3;
+  memset(&resp.data[resp_len], 0, padded - resp_len);
+  resp.r_e_m_op = ( resp.r_e_m_op & ~NTP_CONTROL_MORE ) | ( (true == more) ? NTP_CONTROL_MORE : 0 );
+  resp.offset = htons(resp_offset);
+  resp.count = htons(resp_len);
+  resp_send(resp_ctx, (const uint8_t*)&resp, NTP_CONTROL_HEADER_LEN + padded);
+  resp_frags++;
+  resp_offset += resp_len;
+  resp_len = 0;
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : Write
+ *    Class         : NTP_ControlResponder
+ *    Description   : Appends text to the response
+ *    Input         : const char* chars, uint16_t len
+ *    Output        : bool ( false if the fragment limit is reached )
+ *    Remarks       : Text may be split over two fragments, the client puts them together
+ **************************************************************************************************/
+bool NTP_ControlResponder::Write( const char* chars, uint16_t len ){
+  while(len > 0){
+    if(resp_len == NTP_CONTROL_DATA_MAX){
+      if(false == Flush(true)){
+        return false;
+      }
+    }
+    uint16_t chunk = NTP_CONTROL_DATA_MAX - resp_len;
+    if(chunk > len){
+      chunk = len;
+    }
+    memcpy(&resp.data[resp_len], chars, chunk);
+    resp_len += chunk;
+    chars += chunk;
+    len -= chunk;
+  }
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : Put
+ *    Class         : NTP_ControlResponder
+ *    Description   : Appends an item to the response
+ *    Input         : const char* item
+ *    Output        : bool ( false if the fragment limit is reached )
+ *    Remarks       : none
+ **************************************************************************************************/
+bool NTP_ControlResponder::Put( const char* item ){
+  if( (true == resp_items) && ( false == Write(", ", 2) ) ){
+    return false;
+  }
+  resp_items = true;
+  return Write(item, strlen(item));
+}
+
+/**************************************************************************************************
+ *    Function      : Space
+ *    Class         : NTP_ControlResponder
+ *    Description   : Returns the bytes that can still be added to the response
+ *    Input         : none
+ *    Output        : uint16_t
+ *    Remarks       : none
+ **************************************************************************************************/
+uint16_t NTP_ControlResponder::Space( void ){
+  if(resp_frags >= resp_frags_max){
+    return 0;
+  }
+  return ( ( resp_frags_max - resp_frags ) * NTP_CONTROL_DATA_MAX ) - resp_len;
+}
+
+/**************************************************************************************************
+ *    Function      : Finish
+ *    Class         : NTP_ControlResponder
+ *    Description   : Sends the last fragment
+ *    Input         : none
+ *    Output        : uint8_t ( fragments sent )
+ *    Remarks       : none
+ **************************************************************************************************/
+uint8_t NTP_ControlResponder::Finish( void ){
+  Flush(false);
+  return resp_frags;
+}
+
+/**************************************************************************************************
+ *    Function      : Error
+ *    Class         : NTP_ControlResponder
+ *    Description   : Sends an error response
+ *    Input         : uint8_t err, ntp_control_send_t send, void* ctx
+ *    Output        : uint8_t ( fragments sent )
+ *    Remarks       : none
+ **************************************************************************************************/
+uint8_t NTP_ControlResponder::Error( uint8_t err, ntp_control_send_t send, void* ctx ){
+  Begin(0, (uint16_t)err << 8, send, ctx);
+  resp.r_e_m_op |= NTP_CONTROL_ERROR;
+  return Finish();
+}
+
+/**************************************************************************************************
+ *    Function      : SystemStatus
+ *    Class         : NTP_ControlResponder
+ *    Description   : Builds the system status word
+ *    Input         : const ntp_control_sysvars_t* vars
+ *    Output        : uint16_t
+ *    Remarks       : There are no system events, so count and code are always zero
+ **************************************************************************************************/
+uint16_t NTP_ControlResponder::SystemStatus( const ntp_control_sysvars_t* vars ){
+  uint16_t source = NTP_CONTROL_SRC_UNSPEC;
+  if(vars->state.stratum > 1){
+    source = NTP_CONTROL_SRC_NTP;
+  } else if(vars->state.stratum == 1){
+    if(0 == memcmp(vars->state.refid, "PPS", 3)){
+      source = NTP_CONTROL_SRC_ATOM;
+    } else if(0 == memcmp(vars->state.refid, "GPS", 3)){
+      source = NTP_CONTROL_SRC_UHF;
+    }
+  }
+  return ( (uint16_t)( vars->state.leap & 0x03 ) << 14 ) | ( source << 8 );
+}
+
+/**************************************************************************************************
+ *    Function      : PutSystemVar
+ *    Class         : NTP_ControlResponder
+ *    Description   : Appends a system variable to the response
+ *    Input         : uint8_t var, const ntp_control_sysvars_t* vars
+ *    Output        : bool ( false if the fragment limit is reached )
+ *    Remarks       : none
+ **************************************************************************************************/
+bool NTP_ControlResponder::PutSystemVar( uint8_t var, const ntp_control_sysvars_t* vars ){
+  char buf[64];
+  const char* name = ntp_control_sysvar_names[var];
+
+  switch(var){
+    case SYSVAR_VERSION:{
+      snprintf(buf, sizeof(buf), "%s=\"mini-NTP\"", name);
+    } break;
+
+    case SYSVAR_PROCESSOR:{
+      snprintf(buf, sizeof(buf), "%s=\"esp32\"", name);
+    } break;
+
+    case SYSVAR_SYSTEM:{
+      snprintf(buf, sizeof(buf), "%s=\"FreeRTOS\"", name);
+    } break;
+
+    case SYSVAR_LEAP:{
+      snprintf(buf, sizeof(buf), "%s=%u", name, (unsigned)vars->state.leap);
+    } break;
+
+    case SYSVAR_STRATUM:{
+      snprintf(buf, sizeof(buf), "%s=%u", name, (unsigned)vars->state.stratum);
+    } break;
+
+    case SYSVAR_PRECISION:{
+      snprintf(buf, sizeof(buf), "%s=%d", name, (int)vars->state.precision);
+    } break;
+
+    case SYSVAR_ROOTDELAY:{
+      ntp_control_put_ms(buf, sizeof(buf), name, ( (int64_t)vars->state.rootDelay * 1000000000 ) >> 16, false);
+    } break;
+
+    case SYSVAR_ROOTDISP:{
+      ntp_control_put_ms(buf, sizeof(buf), name, ( (int64_t)vars->state.rootDispersion * 1000000000 ) >> 16, false);
+    } break;
+
+    case SYSVAR_REFID:{
+      if(vars->state.stratum > 1){
+        uint32_t addr;
+        char ip[16];
+        memcpy(&addr, vars->state.refid, sizeof(addr));
+        ntp_control_put_addr(ip, sizeof(ip), addr);
+        snprintf(buf, sizeof(buf), "%s=%s", name, ip);
+      } else {
+        char id[5];
+        uint8_t len = 0;
+        for(uint8_t i=0;i<4;i++){
+          char c = vars->state.refid[i];
+          if( (c < 0x21) || (c > 0x7E) ){
+            break;
+          }
+          id[len++] = c;
+        }
+        id[len] = '\0';
+        snprintf(buf, sizeof(buf), "%s=%s", name, id);
+      }
+    } break;
+
+    case SYSVAR_REFTIME:{
+      snprintf(buf, sizeof(buf), "%s=0x%08x.%08x", name, (unsigned)ntp_time64_seconds(vars->state.reference), (unsigned)ntp_time64_fraction(vars->state.reference));
+    } break;
+
+    case SYSVAR_CLOCK:{
+      snprintf(buf, sizeof(buf), "%s=0x%08x.%08x", name, (unsigned)vars->clock.seconds, (unsigned)vars->clock.fraction);
+    } break;
+
+    case SYSVAR_OFFSET:{
+      ntp_control_put_ms(buf, sizeof(buf), name, vars->offset, true);
+    } break;
+
+    case SYSVAR_SYS_JITTER:
+    case SYSVAR_CLK_JITTER:{
+      ntp_control_put_ms(buf, sizeof(buf), name, vars->jitter, true);
+    } break;
+
+    case SYSVAR_SS_UPTIME:{
+      snprintf(buf, sizeof(buf), "%s=%u", name, (unsigned)vars->uptime);
+    } break;
+
+    case SYSVAR_SS_RECEIVED:{
+      snprintf(buf, sizeof(buf), "%s=%u", name, (unsigned)vars->received);
+    } break;
+
+    case SYSVAR_SS_PROCESSED:{
+      snprintf(buf, sizeof(buf), "%s=%u", name, (unsigned)vars->processed);
+    } break;
+
+    case SYSVAR_SS_DECLINED:{
+      snprintf(buf, sizeof(buf), "%s=%u", name, (unsigned)vars->declined);
+    } break;
+
+    case SYSVAR_SS_LIMITED:{
+      snprintf(buf, sizeof(buf), "%s=%u", name, (unsigned)vars->limited);
+    } break;
+
+    case SYSVAR_SS_KODSENT:{
+      snprintf(buf, sizeof(buf), "%s=%u", name, (unsigned)vars->kodsent);
+    } break;
+
+    default:{
+      return true;
+    }
+  }
+  return Put(buf);
+}
+
+/**************************************************************************************************
+ *    Function      : ReadVar
+ *    Class         : NTP_ControlResponder
+ *    Description   : Answers a read variables request for the system
+ *    Input         : const ntp_control_sysvars_t* vars, ntp_control_send_t send, void* ctx
+ *    Output        : uint8_t ( fragments sent )
+ *    Remarks       : Sends all variables if the request names none
+ **************************************************************************************************/
+uint8_t NTP_ControlResponder::ReadVar( const ntp_control_sysvars_t* vars, ntp_control_send_t send, void* ctx ){
+  uint8_t selected[SYSVAR_CNT];
+  uint8_t count = 0;
+  char* pos = text;
+  char* name;
+  char* value;
+
+  if(req.associd != 0){
+    /* We have no peers */
+    return Error(NTP_CONTROL_ERR_BADASSOC, send, ctx);
+  }
+
+  while( (true == ntp_control_next_item(&pos, &name, &value)) && (count < SYSVAR_CNT) ){
+    uint8_t var = 0;
+    for(var=0;var<SYSVAR_CNT;var++){
+      if(0 == strcmp(name, ntp_control_sysvar_names[var])){
+        break;
+      }
+    }
+    if(var >= SYSVAR_CNT){
+      return Error(NTP_CONTROL_ERR_UNKNOWNVAR, send, ctx);
+    }
+    selected[count++] = var;
+  }
+
+  Begin(vars->state.leap, SystemStatus(vars), send, ctx);
+  if(count == 0){
+    for(uint8_t var=0;var<SYSVAR_CNT;var++){
+      PutSystemVar(var, vars);
+    }
+  } else {
+    for(uint8_t i=0;i<count;i++){
+      PutSystemVar(selected[i], vars);
+    }
+  }
+  return Finish();
+}
+
+/**************************************************************************************************
+ *    Function      : NonceHash
+ *    Class         : NTP_ControlResponder
+ *    Description   : Binds a nonce to a client and the time it was handed out
+ *    Input         : uint32_t client, ntp_timestamp_t ts
+ *    Output        : uint32_t
+ *    Remarks       : The nonce only proves that the client can receive our responses
+ **************************************************************************************************/
+uint32_t NTP_ControlResponder::NonceHash( uint32_t client, ntp_timestamp_t ts ){
+  uint32_t h = ntp_control_mix( salt ^ 0x9E3779B9 );
+  h = ntp_control_mix( h ^ client );
+  h = ntp_control_mix( h ^ ts.seconds );
+  h = ntp_control_mix( h ^ ts.fraction ^ salt );
+  return h;
+}
+
+/**************************************************************************************************
+ *    Function      : ValidateNonce
+ *    Class         : NTP_ControlResponder
+ *    Description   : Checks a nonce sent back by a client
+ *    Input         : const char* nonce, uint32_t client, ntp_timestamp_t now
+ *    Output        : bool
+ *    Remarks       : none
+ **************************************************************************************************/
+bool NTP_ControlResponder::ValidateNonce( const char* nonce, uint32_t client, ntp_timestamp_t now ){
+  char part[9];
+  uint32_t words[3];
+  if(strlen(nonce) != 24){
+    return false;
+  }
+  for(uint8_t i=0;i<3;i++){
+    char* end;
+    memcpy(part, &nonce[i * 8], 8);
+    part[8] = '\0';
+    words[i] = strtoul(part, &end, 16);
+    if(*end != '\0'){
+      return false;
+    }
+  }
+  ntp_timestamp_t issued;
+  issued.seconds = words[0];
+  issued.fraction = words[1];
+  if( (uint32_t)( now.seconds - issued.seconds ) > NTP_CONTROL_NONCE_LIFETIME ){
+    return false;
+  }
+  return ( words[2] == NonceHash(client, issued) );
+}
+
+/**************************************************************************************************
+ *    Function      : ReadMRU
+ *    Class         : NTP_ControlResponder
+ *    Description   : Answers a mrulist request
+ *    Input         : uint32_t client, const ntp_control_sysvars_t* vars, ntp_control_read_mru_t read_mru,
+ *                    void* mru_ctx, ntp_control_send_t send, void* ctx
+ *    Output        : uint8_t ( fragments sent )
+ *    Remarks       : The list is sent oldest client first, now= marks that the newest one was sent
+ **************************************************************************************************/
+uint8_t NTP_ControlResponder::ReadMRU( uint32_t client, const ntp_control_sysvars_t* vars, ntp_control_read_mru_t read_mru,
+                                       void* mru_ctx, ntp_control_send_t send, void* ctx ){
+  char* pos = text;
+  char* name;
+  char* value;
+  char buf[192];
+  char ip[NTP_ADDR_STR_LEN];
+  bool nonce_valid = false;
+  uint8_t frags = NTP_CONTROL_FRAGS_MAX;
+  uint32_t limit = NTP_CONTROL_MRU_BATCH;
+  uint32_t mincount = 0;
+  uint32_t resume_addr_set = 0;
+  uint32_t resume_last_set = 0;
+  uint8_t resume_cnt = 0;
+
+  while(true == ntp_control_next_item(&pos, &name, &value)){
+    if(0 == strcmp(name, "nonce")){
+      nonce_valid = ValidateNonce(value, client, vars->clock);
+    } else if(0 == strcmp(name, "frags")){
+      unsigned long v = strtoul(value, NULL, 10);
+      if( (v > 0) && (v < NTP_CONTROL_FRAGS_MAX) ){
+        frags = v;
+      }
+    } else if(0 == strcmp(name, "limit")){
+      unsigned long v = strtoul(value, NULL, 10);
+      if( (v > 0) && (v < NTP_CONTROL_MRU_BATCH) ){
+        limit = v;
+      }
+    } else if(0 == strcmp(name, "mincount")){
+      mincount = strtoul(value, NULL, 10);
+    } else if( (0 == strncmp(name, "addr.", 5)) || (0 == strncmp(name, "last.", 5)) ){
+      unsigned long idx = strtoul(&name[5], NULL, 10);
+      if(idx >= NTP_CONTROL_MRU_RESUME_MAX){
+        continue;
+      }
+      if(name[0] == 'a'){
+        if(true == ntp_addr_parse(value, &mru_resume[idx].client)){
+          resume_addr_set |= ( 1UL << idx );
+        }
+      } else {
+        if(true == ntp_control_parse_ts(value, &mru_resume[idx].last)){
+          resume_last_set |= ( 1UL << idx );
+        }
+      }
+    } else {
+      /* Everything else, like sort or laddr, is not supported and ignored */
+    }
+  }
+
+  if(false == nonce_valid){
+    /* Not answered at all, so spoofed requests can't be used for amplification */
+    return 0;
+  }
+
+  /* Resume points need to be complete and without gaps */
+  while( ( resume_cnt < NTP_CONTROL_MRU_RESUME_MAX ) &&
+         ( 0 != ( resume_addr_set & resume_last_set & ( 1UL << resume_cnt ) ) ) ){
+    resume_cnt++;
+  }
+
+  int32_t count = read_mru(mru_ctx, mru_resume, resume_cnt, mru, NTP_CONTROL_MRU_BATCH);
+  if(count < 0){
+    /* All clients the reader knows have been seen again, it needs to start over */
+    return Error(NTP_CONTROL_ERR_UNKNOWNVAR, send, ctx);
+  }
+
+  Begin(vars->state.leap, SystemStatus(vars), send, ctx);
+  resp_frags_max = frags;
+
+  ntp_timestamp_t nonce_ts = vars->clock;
+  snprintf(buf, sizeof(buf), "nonce=%08x%08x%08x", (unsigned)nonce_ts.seconds, (unsigned)nonce_ts.fraction, (unsigned)NonceHash(client, nonce_ts));
+  Put(buf);
+
+  ntp_timestamp_t newest = { 0, 0 };
+  if(resume_cnt > 0){
+    newest = mru_resume[0].last;
+  }
+  uint32_t sent = 0;
+  int32_t i = 0;
+  for(i=0;i<count;i++){
+    const ntp_mru_entry_t* e = &mru[i];
+    if(sent >= limit){
+      break;
+    }
+    if(e->count < mincount){
+      continue;
+    }
+    ntp_addr_format(&e->client, ip, sizeof(ip));
+    snprintf(buf, sizeof(buf),
+      "addr.%u=%s, last.%u=0x%08x.%08x, first.%u=0x%08x.%08x, ct.%u=%u, mv.%u=%u, rs.%u=0x0",
+      (unsigned)sent, ip,
+      (unsigned)sent, (unsigned)e->last.seconds, (unsigned)e->last.fraction,
+      (unsigned)sent, (unsigned)e->first.seconds, (unsigned)e->first.fraction,
+      (unsigned)sent, (unsigned)e->count,
+      (unsigned)sent, (unsigned)( ( e->version << 3 ) | e->mode ),
+      (unsigned)sent );
+    if( strlen(buf) + 2 > Space() ){
+      break;
+    }
+    Put(buf);
+    newest = e->last;
+    sent++;
+  }
+
+  /* A full batch may not have been the end of the list, the reader will ask again */
+  if( (i == count) && (count < NTP_CONTROL_MRU_BATCH) ){
+    snprintf(buf, sizeof(buf), "now=0x%08x.%08x, last.newest=0x%08x.%08x",
+      (unsigned)vars->clock.seconds, (unsigned)vars->clock.fraction,
+      (unsigned)newest.seconds, (unsigned)newest.fraction);
+    if( strlen(buf) + 2 <= Space() ){
+      Put(buf);
+    }
+  }
+  uint8_t sent_frags = Finish();
+  resp_frags_max = NTP_CONTROL_FRAGS_MAX;
+  return sent_frags;
+}
+
+/**************************************************************************************************
+ *    Function      : Process
+ *    Class         : NTP_ControlResponder
+ *    Description   : Answers a mode 6 request
+ *    Input         : const uint8_t* data, uint16_t len, uint32_t client,
+ *                    const ntp_control_sysvars_t* vars, ntp_control_read_mru_t read_mru, void* mru_ctx,
+ *                    ntp_control_send_t send, void* ctx
+ *    Output        : uint8_t ( fragments sent )
+ *    Remarks       : Requests with an invalid mrulist nonce are not answered. client is the keyed
+ *                    hash of the address, see ntp_addr_hash, the nonces are bound to it
+ **************************************************************************************************/
+uint8_t NTP_ControlResponder::Process( const uint8_t* data, uint16_t len, uint32_t client, const ntp_control_sysvars_t* vars,
+                                       ntp_control_read_mru_t read_mru, void* mru_ctx, ntp_control_send_t send, void* ctx ){
+  if(false == IsControlRequest(data, len)){
+    return 0;
+  }
+  memset(&req, 0, sizeof(req));
+  memcpy(&req, data, ( len > sizeof(req) ) ? sizeof(req) : len);
+  resp_frags_max = NTP_CONTROL_FRAGS_MAX;
+
+  /* Requests come in a single fragment */
+  uint16_t count = ntohs(req.count);
+  if( (req.offset != 0) || (0 != ( req.r_e_m_op & ( NTP_CONTROL_ERROR | NTP_CONTROL_MORE ) ) ) ||
+      (count > NTP_CONTROL_DATA_MAX) || (count > len - NTP_CONTROL_HEADER_LEN) ){
+    return Error(NTP_CONTROL_ERR_BADFMT, send, ctx);
+  }
+  memcpy(text, req.data, count);
+  text[count] = '\0';
+
+  switch( req.r_e_m_op & NTP_CONTROL_OPCODE ){
+    case NTP_CONTROL_OP_READSTAT:{
+      if(req.associd != 0){
+        return Error(NTP_CONTROL_ERR_BADASSOC, send, ctx);
+      }
+      /* There are no associations to list */
+      Begin(vars->state.leap, SystemStatus(vars), send, ctx);
+      return Finish();
+    }
+
+    case NTP_CONTROL_OP_READVAR:{
+      return ReadVar(vars, send, ctx);
+    }
+
+    case NTP_CONTROL_OP_REQ_NONCE:{
+      char buf[40];
+      Begin(vars->state.leap, SystemStatus(vars), send, ctx);
+      snprintf(buf, sizeof(buf), "nonce=%08x%08x%08x", (unsigned)vars->clock.seconds, (unsigned)vars->clock.fraction, (unsigned)NonceHash(client, vars->clock));
+      Put(buf);
+      return Finish();
+    }
+
+    case NTP_CONTROL_OP_READ_MRU:{
+      if(read_mru == NULL){
+        return Error(NTP_CONTROL_ERR_BADOP, send, ctx);
+      }
+      return ReadMRU(client, vars, read_mru, mru_ctx, send, ctx);
+    }
+
+    default:{
+      /* Anything that writes or needs authentication is not supported */
+      return Error(NTP_CONTROL_ERR_BADOP, send, ctx);
+    }
+  }
+}
@@ -0,0 +1,144 @@
+#ifndef NTP_CONTROL_H_
+ #define NTP_CONTROL_H_
+
+#include <stdint.h>
+#include "ntp_packet.h"
+#include "ntp_mru.h"
+
+/* Mode 6 header and payload size of a single fragment */
+#define NTP_CONTROL_HEADER_LEN ( 12 )
+#define NTP_CONTROL_DATA_MAX ( 468 )
+
+/* Most fragments sent as answer to a single request */
+#ifndef NTP_CONTROL_FRAGS_MAX
+ #define NTP_CONTROL_FRAGS_MAX ( 8 )
+#endif
+
+/* Clients read from the MRU list for a single mrulist request */
+#define NTP_CONTROL_MRU_BATCH ( 48 )
+
+/* Resume points accepted with a mrulist request */
+#define NTP_CONTROL_MRU_RESUME_MAX ( 16 )
+
+/* Opcodes */
+#define NTP_CONTROL_OP_READSTAT ( 1 )
+#define NTP_CONTROL_OP_READVAR ( 2 )
+#define NTP_CONTROL_OP_READ_MRU ( 10 )
+#define NTP_CONTROL_OP_REQ_NONCE ( 12 )
+
+/* Error codes */
+#define NTP_CONTROL_ERR_UNSPEC ( 0 )
+#define NTP_CONTROL_ERR_PERMISSION ( 1 )
+#define NTP_CONTROL_ERR_BADFMT ( 2 )
+#define NTP_CONTROL_ERR_BADOP ( 3 )
+#define NTP_CONTROL_ERR_BADASSOC ( 4 )
+#define NTP_CONTROL_ERR_UNKNOWNVAR ( 5 )
+#define NTP_CONTROL_ERR_BADVALUE ( 6 )
+
+typedef struct {
+  uint8_t li_vn_mode;
+  uint8_t r_e_m_op;        // Response, error and more bit, five bits opcode.
+  uint16_t sequence;
+  uint16_t status;
+  uint16_t associd;
+  uint16_t offset;         // Offset of the payload in the whole response.
+  uint16_t count;          // Length of the payload in this fragment.
+  uint8_t data[NTP_CONTROL_DATA_MAX];
+} ntp_control_packet_t;
+
+/* Everything the system variables are built from, taken at the time of the request */
+typedef struct {
+  ntp_server_state_t state;
+  ntp_timestamp_t clock;
+  int32_t offset;          // Nanoseconds.
+  uint32_t jitter;         // Nanoseconds.
+  uint32_t uptime;         // Seconds.
+  uint32_t received;
+  uint32_t processed;
+  uint32_t declined;
+  uint32_t limited;
+  uint32_t kodsent;
+} ntp_control_sysvars_t;
+
+/* Reads clients from the MRU list, see NTP_MRUList::GetNewer, ctx is the one passed to Process */
+typedef int32_t (*ntp_control_read_mru_t)( void* mru_ctx, const ntp_mru_resume_t* resume, uint8_t count, ntp_mru_entry_t* out, uint16_t max );
+
+/* Sends one fragment back to the client that sent the request */
+typedef bool (*ntp_control_send_t)( void* ctx, const uint8_t* data, uint16_t len );
+
+/*
+ * Answers the read only part of the mode 6 control protocol, enough for ntpq -c rv
+ * and ntpq -c mrulist. All buffers are part of the object, so a single responder
+ * must not be used from more than one task.
+ */
+class NTP_ControlResponder {
+
+public:
+    NTP_ControlResponder( );
+
+    /**************************************************************************************************
+     *    Function      : SetSalt
+     *    Class         : NTP_ControlResponder
+     *    Description   : Sets the secret the mrulist nonces are derived from
+     *    Input         : uint32_t salt
+     *    Output        : none
+     *    Remarks       : Should be random
+     **************************************************************************************************/
+    void SetSalt( uint32_t salt );
+
+    /**************************************************************************************************
+     *    Function      : IsControlRequest
+     *    Class         : NTP_ControlResponder
+     *    Description   : Checks if a datagram is a mode 6 request
+     *    Input         : const uint8_t* data, uint16_t len
+     *    Output        : bool
+     *    Remarks       : none
+     **************************************************************************************************/
+    static bool IsControlRequest( const uint8_t* data, uint16_t len );
+
+    /**************************************************************************************************
+     *    Function      : Process
+     *    Class         : NTP_ControlResponder
+     *    Description   : Answers a mode 6 request
+     *    Input         : const uint8_t* data, uint16_t len, uint32_t client,
+     *                    const ntp_control_sysvars_t* vars, ntp_control_read_mru_t read_mru, void* mru_ctx,
+     *                    ntp_control_send_t send, void* ctx
+     *    Output        : uint8_t ( fragments sent )
+     *    Remarks       : Requests with an invalid mrulist nonce are not answered. client is the keyed
+     *                    hash of the address, see ntp_addr_hash, the nonces are bound to it
+     **************************************************************************************************/
+    uint8_t Process( const uint8_t* data, uint16_t len, uint32_t client, const ntp_control_sysvars_t* vars,
+                     ntp_control_read_mru_t read_mru, void* mru_ctx, ntp_control_send_t send, void* ctx );
+
+private:
+    uint32_t salt;
+    ntp_control_packet_t req;
+    ntp_control_packet_t resp;
+    char text[NTP_CONTROL_DATA_MAX + 1]; /* Request payload as string */
+    uint16_t resp_len;       /* Payload in the current fragment */
+    uint16_t resp_offset;    /* Payload sent with the fragments before */
+    uint8_t resp_frags;
+    uint8_t resp_frags_max;
+    bool resp_items;         /* Set once an item is in the response */
+    ntp_control_send_t resp_send;
+    void* resp_ctx;
+    ntp_mru_entry_t mru[NTP_CONTROL_MRU_BATCH];
+    ntp_mru_resume_t mru_resume[NTP_CONTROL_MRU_RESUME_MAX];
+
+    void Begin( uint8_t leap, uint16_t status, ntp_control_send_t send, void* ctx );
+    bool Flush( bool more );
+    bool Write( const char* chars, uint16_t len );
+    bool Put( const char* item );
+    uint16_t Space( void );
+    uint8_t Finish( void );
+    uint8_t Error( uint8_t err, ntp_control_send_t send, void* ctx );
+    uint16_t SystemStatus( const ntp_control_sysvars_t* vars );
+    bool PutSystemVar( uint8_t var, const ntp_control_sysvars_t* vars );
+    uint8_t ReadVar( const ntp_control_sysvars_t* vars, ntp_control_send_t send, void* ctx );
+    uint32_t NonceHash( uint32_t client, ntp_timestamp_t ts );
+    bool ValidateNonce( const char* nonce, uint32_t client, ntp_timestamp_t now );
+    uint8_t ReadMRU( uint32_t client, const ntp_control_sysvars_t* vars, ntp_control_read_mru_t read_mru,
+                     void* mru_ctx, ntp_control_send_t send, void* ctx );
+};
+
+#endif
@@ -0,0 +1,381 @@
+#include <string.h>
+#include "ntp_holdover.h"
+
+#ifdef ARDUINO
+ #include "Arduino.h"
+#else
+ /* Second and Edge run from the PPS interrupt on the ESP32 */
+ #define IRAM_ATTR
+#endif
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_Holdover
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : Starts with nothing learned
+ **************************************************************************************************/
+NTP_Holdover::NTP_Holdover( ){
+  ntp_holdover_settings_t conf = GetDefaultConfig();
+  Begin(&conf);
+}
+
+/**************************************************************************************************
+ *    Function      : GetDefaultConfig
+ *    Class         : NTP_Holdover
+ *    Description   : Gets the default config, nothing learned
+ *    Input         : none
+ *    Output        : ntp_holdover_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_holdover_settings_t NTP_Holdover::GetDefaultConfig( void ){
+  ntp_holdover_settings_t conf;
+  memset(&conf, 0, sizeof(ntp_holdover_settings_t));
+  return conf;
+}
+
+/**************************************************************************************************
+ *    Function      : Begin
+ *    Class         : NTP_Holdover
+ *    Description   : Starts with a stored curve
+ *    Input         : const ntp_holdover_settings_t* conf
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_Holdover::Begin( const ntp_holdover_settings_t* conf ){
+  curve = *conf;
+  for(uint8_t i=0;i<NTP_HOLDOVER_BINS;i++){
+    if(curve.bins[i].samples > NTP_HOLDOVER_AVERAGE){
+      /* Not written by us */
+      curve = GetDefaultConfig();
+      break;
+    }
+  }
+  has_temperature = false;
+  temperature = 0;
+  referenced = false;
+  reference_has_temperature = false;
+  reference_temperature = 0;
+  reference = 0;
+  reference_uncertainty = 0;
+  compensated = false;
+  frequency = 0;
+  uncertainty = NTP_HOLDOVER_UNCOMP_PPB;
+  seconds = 0;
+  error = 0;
+  unsaved = 0;
+  usable_added = false;
+}
+
+/**************************************************************************************************
+ *    Function      : GetBin
+ *    Class         : NTP_Holdover
+ *    Description   : Returns the bin of a temperature
+ *    Input         : int16_t temperature ( 1/4 °C )
+ *    Output        : int8_t ( -1 if outside )
+ *    Remarks       : none
+ **************************************************************************************************/
+int8_t NTP_Holdover::GetBin( int16_t temperature ){
+  int32_t offset = (int32_t)temperature - ( NTP_HOLDOVER_TEMP_MIN * 4 );
+  if(offset < 0){
+    return -1;
+  }
+  int32_t bin = offset / ( NTP_HOLDOVER_BIN_WIDTH * 4 );
+  if(bin >= NTP_HOLDOVER_BINS){
+    return -1;
+  }
+  return (int8_t)bin;
+}
+
+/**************************************************************************************************
+ *    Function      : GetBinTemperature
+ *    Class         : NTP_Holdover
+ *    Description   : Returns the temperature in the middle of a bin
+ *    Input         : uint8_t bin
+ *    Output        : int16_t ( 1/4 °C )
+ *    Remarks       : none
+ **************************************************************************************************/
+int16_t NTP_Holdover::GetBinTemperature( uint8_t bin ){
+  return (int16_t)( ( NTP_HOLDOVER_TEMP_MIN * 4 ) + ( bin * NTP_HOLDOVER_BIN_WIDTH * 4 ) + ( NTP_HOLDOVER_BIN_WIDTH * 2 ) );
+}
+
+/**************************************************************************************************
+ *    Function      : Lookup
+ *    Class         : NTP_Holdover
+ *    Description   : Reads the curve at a temperature
+ *    Input         : int16_t temperature ( 1/4 °C ), int32_t* ppb, uint32_t* deviation
+ *    Output        : bool ( false if no learned bin is in reach )
+ *    Remarks       : Linear between the learned bins on both sides, beyond the last one the
+ *                    deviation grows with NTP_HOLDOVER_SLOPE_PPB
+ **************************************************************************************************/
+bool NTP_Holdover::Lookup( int16_t temperature, int32_t* ppb, uint32_t* deviation ){
+  int8_t bin = GetBin(temperature);
+  if(bin < 0){
+    return false;
+  }
+  int8_t lower = -1;
+  int8_t upper = -1;
+  int8_t start = ( GetBinTemperature(bin) <= temperature ) ? bin : bin - 1;
+  for(int8_t i = start; (i >= 0) && (i >= start - NTP_HOLDOVER_REACH); i--){
+    if(curve.bins[i].samples >= NTP_HOLDOVER_MIN_SAMPLES){
+      lower = i;
+      break;
+    }
+  }
+  start = ( GetBinTemperature(bin) >= temperature ) ? bin : bin + 1;
+  for(int8_t i = start; (i < NTP_HOLDOVER_BINS) && (i <= start + NTP_HOLDOVER_REACH); i++){
+    if(curve.bins[i].samples >= NTP_HOLDOVER_MIN_SAMPLES){
+      upper = i;
+      break;
+    }
+  }
+
+  if( (lower >= 0) && (upper >= 0) ){
+    const ntp_holdover_bin_t* l = &curve.bins[lower];
+    const ntp_holdover_bin_t* u = &curve.bins[upper];
+    int32_t span = GetBinTemperature(upper) - GetBinTemperature(lower);
+    if(span == 0){
+      *ppb = l->frequency;
+    } else {
+      *ppb = l->frequency + (int32_t)( ( (int64_t)( u->frequency - l->frequency ) * ( temperature - GetBinTemperature(lower) ) ) / span );
+    }
+    *deviation = ( l->deviation > u->deviation ) ? l->deviation : u->deviation;
+    return true;
+  }
+  if( (lower < 0) && (upper < 0) ){
+    return false;
+  }
+  /* Only one side is learned, hold its value */
+  uint8_t near = ( lower >= 0 ) ? lower : upper;
+  int32_t distance = temperature - GetBinTemperature(near);
+  if(distance < 0){
+    distance = -distance;
+  }
+  *ppb = curve.bins[near].frequency;
+  *deviation = curve.bins[near].deviation + ( ( (uint32_t)distance * NTP_HOLDOVER_SLOPE_PPB ) / 4 );
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : SetReference
+ *    Class         : NTP_Holdover
+ *    Description   : Takes the frequency of the locked servo the prediction starts from
+ *    Input         : bool has_temperature, int16_t temperature ( 1/4 °C ), int32_t ppb,
+ *                    uint32_t uncertainty ( ppb )
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_Holdover::SetReference( bool has_temperature, int16_t temperature, int32_t ppb, uint32_t uncertainty ){
+  referenced = true;
+  reference_has_temperature = has_temperature;
+  reference_temperature = temperature;
+  reference = ppb;
+  reference_uncertainty = uncertainty;
+}
+
+/**************************************************************************************************
+ *    Function      : Learn
+ *    Class         : NTP_Holdover
+ *    Description   : Adds the frequency of the settled servo to the curve
+ *    Input         : int16_t temperature ( 1/4 °C ), int32_t ppb
+ *    Output        : none
+ *    Remarks       : Temperatures outside the bins are dropped
+ **************************************************************************************************/
+void NTP_Holdover::Learn( int16_t temperature, int32_t ppb ){
+  int8_t bin = GetBin(temperature);
+  if(bin < 0){
+    return;
+  }
+  ntp_holdover_bin_t* b = &curve.bins[bin];
+  if(b->samples == 0){
+    b->frequency = ppb;
+    b->deviation = 0;
+  } else {
+    /* Mean of the samples so far, once full a running average of the same length */
+    int32_t weight = ( b->samples < NTP_HOLDOVER_AVERAGE ) ? ( b->samples + 1 ) : NTP_HOLDOVER_AVERAGE;
+    int32_t residual = ppb - b->frequency;
+    int32_t deviation = ( residual < 0 ) ? -residual : residual;
+    b->frequency += residual / weight;
+    deviation = (int32_t)b->deviation + ( ( deviation - (int32_t)b->deviation ) / weight );
+    b->deviation = (uint16_t)( ( deviation > UINT16_MAX ) ? UINT16_MAX : deviation );
+  }
+  if(b->samples < NTP_HOLDOVER_AVERAGE){
+    b->samples++;
+    if(b->samples == NTP_HOLDOVER_MIN_SAMPLES){
+      usable_added = true;
+    }
+  }
+  if(unsaved < UINT16_MAX){
+    unsaved++;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : Predict
+ *    Class         : NTP_Holdover
+ *    Description   : Predicts the frequency and its uncertainty for a temperature
+ *    Input         : bool has_temperature, int16_t temperature ( 1/4 °C )
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_Holdover::Predict( bool has_temperature, int16_t temperature ){
+  this->has_temperature = has_temperature;
+  this->temperature = temperature;
+  compensated = false;
+  if(false == referenced){
+    frequency = 0;
+    uncertainty = NTP_HOLDOVER_UNCOMP_PPB;
+    return;
+  }
+  frequency = reference;
+  if( (false == has_temperature) || (false == reference_has_temperature) ){
+    uncertainty = reference_uncertainty + NTP_HOLDOVER_UNCOMP_PPB;
+    return;
+  }
+  uncertainty = reference_uncertainty + NTP_HOLDOVER_FLOOR_PPB;
+  if(temperature == reference_temperature){
+    return;
+  }
+  int32_t now_ppb;
+  int32_t ref_ppb;
+  uint32_t now_deviation;
+  uint32_t ref_deviation;
+  if( (true == Lookup(temperature, &now_ppb, &now_deviation)) && (true == Lookup(reference_temperature, &ref_ppb, &ref_deviation)) ){
+    /* Only the change along the curve is used, an offset of the whole curve cancels out */
+    frequency = reference + ( now_ppb - ref_ppb );
+    uncertainty += ( now_deviation > ref_deviation ) ? now_deviation : ref_deviation;
+    compensated = true;
+  } else {
+    int32_t distance = temperature - reference_temperature;
+    if(distance < 0){
+      distance = -distance;
+    }
+    uncertainty += ( (uint32_t)distance * NTP_HOLDOVER_SLOPE_PPB ) / 4;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : Second
+ *    Class         : NTP_Holdover
+ *    Description   : Adds one second held on the prediction
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : ppb over one second are ns
+ **************************************************************************************************/
+void IRAM_ATTR NTP_Holdover::Second( void ){
+  seconds++;
+  if(error > UINT32_MAX - uncertainty){
+    error = UINT32_MAX;
+  } else {
+    error += uncertainty;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : Edge
+ *    Class         : NTP_Holdover
+ *    Description   : Ends the holdover on a PPS edge
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void IRAM_ATTR NTP_Holdover::Edge( void ){
+  seconds = 0;
+  error = 0;
+}
+
+/**************************************************************************************************
+ *    Function      : GetFrequency
+ *    Class         : NTP_Holdover
+ *    Description   : Returns the predicted frequency
+ *    Input         : none
+ *    Output        : int32_t ( ppb the timebase runs fast )
+ *    Remarks       : none
+ **************************************************************************************************/
+int32_t NTP_Holdover::GetFrequency( void ){
+  return frequency;
+}
+
+/**************************************************************************************************
+ *    Function      : GetUncertainty
+ *    Class         : NTP_Holdover
+ *    Description   : Returns the uncertainty of the predicted frequency
+ *    Input         : none
+ *    Output        : uint32_t ( ppb )
+ *    Remarks       : none
+ **************************************************************************************************/
+uint32_t NTP_Holdover::GetUncertainty( void ){
+  return uncertainty;
+}
+
+/**************************************************************************************************
+ *    Function      : GetError
+ *    Class         : NTP_Holdover
+ *    Description   : Returns the predicted time error since the last PPS edge
+ *    Input         : none
+ *    Output        : uint32_t ( ns )
+ *    Remarks       : 0 while there is PPS
+ **************************************************************************************************/
+uint32_t NTP_Holdover::GetError( void ){
+  return error;
+}
+
+/**************************************************************************************************
+ *    Function      : GetStatus
+ *    Class         : NTP_Holdover
+ *    Description   : Returns the state of the prediction
+ *    Input         : none
+ *    Output        : ntp_holdover_status_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_holdover_status_t NTP_Holdover::GetStatus( void ){
+  ntp_holdover_status_t status;
+  status.referenced = referenced;
+  status.compensated = compensated;
+  status.has_temperature = has_temperature;
+  status.temperature = temperature;
+  status.reference_temperature = reference_temperature;
+  status.reference = reference;
+  status.frequency = frequency;
+  status.uncertainty = uncertainty;
+  status.seconds = seconds;
+  status.error = error;
+  status.bins = 0;
+  for(uint8_t i=0;i<NTP_HOLDOVER_BINS;i++){
+    if(curve.bins[i].samples >= NTP_HOLDOVER_MIN_SAMPLES){
+      status.bins++;
+    }
+  }
+  return status;
+}
+
+/**************************************************************************************************
+ *    Function      : GetCurve
+ *    Class         : NTP_Holdover
+ *    Description   : Returns the learned curve
+ *    Input         : none
+ *    Output        : ntp_holdover_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_holdover_settings_t NTP_Holdover::GetCurve( void ){
+  return curve;
+}
+
+/**************************************************************************************************
+ *    Function      : TakeSettings
+ *    Class         : NTP_Holdover
+ *    Description   : Hands out the learned curve for storage
+ *    Input         : ntp_holdover_settings_t* out
+ *    Output        : bool
+ *    Remarks       : True after NTP_HOLDOVER_SAVE_SAMPLES samples or when a bin became usable
+ **************************************************************************************************/
+bool NTP_Holdover::TakeSettings( ntp_holdover_settings_t* out ){
+  if( (false == usable_added) && (unsaved < NTP_HOLDOVER_SAVE_SAMPLES) ){
+    return false;
+  }
+  *out = curve;
+  usable_added = false;
+  unsaved = 0;
+  return true;
+}
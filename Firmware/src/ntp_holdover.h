@@ -0,0 +1,238 @@
+#ifndef NTP_HOLDOVER_H_
+ #define NTP_HOLDOVER_H_
+
+#include <stdint.h>
+
+/* Temperature bins of the learned curve, 2°C wide from -20°C to +60°C */
+#define NTP_HOLDOVER_TEMP_MIN ( -20 )
+#define NTP_HOLDOVER_BIN_WIDTH ( 2 )
+#define NTP_HOLDOVER_BINS ( 40 )
+
+/* The DS3231 converts the temperature once every 64s, no use to sample faster */
+#define NTP_HOLDOVER_SAMPLE_INTERVAL ( 64 )
+
+/* Samples before a bin is used for a prediction */
+#define NTP_HOLDOVER_MIN_SAMPLES ( 4 )
+
+/* Samples averaged per bin, later ones go into a running average of the same length so the curve follows aging */
+#define NTP_HOLDOVER_AVERAGE ( 32 )
+
+/* Bins searched on each side for a learned one, 6°C */
+#define NTP_HOLDOVER_REACH ( 3 )
+
+/* Uncertainty of any prediction, aging and the 0.25°C steps of the sensor */
+#define NTP_HOLDOVER_FLOOR_PPB ( 50 )
+
+/* Change per °C assumed where the curve is not learned yet */
+#define NTP_HOLDOVER_SLOPE_PPB ( 300 )
+
+/* Uncertainty without a temperature, covers the drift of the crystal over the range */
+#define NTP_HOLDOVER_UNCOMP_PPB ( 1000 )
+
+/* The curve is handed out for storage after this many samples or when a bin became usable */
+#define NTP_HOLDOVER_SAVE_SAMPLES ( 360 )
+
+typedef struct {
+  int32_t frequency;    /* Mean ppb the timebase runs fast at this temperature */
+  uint16_t deviation;   /* Mean deviation of the samples, ppb */
+  uint16_t samples;     /* Up to NTP_HOLDOVER_AVERAGE */
+} ntp_holdover_bin_t;
+/* 8 byte */
+
+typedef struct {
+  ntp_holdover_bin_t bins[NTP_HOLDOVER_BINS];
+} ntp_holdover_settings_t;
+/* 320 byte */
+
+typedef struct {
+  bool referenced;      /* A locked frequency is known to predict from */
+  bool compensated;     /* The prediction uses the learned curve */
+  bool has_temperature;
+  int16_t temperature;  /* 1/4 °C */
+  int16_t reference_temperature; /* 1/4 °C at the last locked sample */
+  int32_t reference;    /* ppb at the last locked sample */
+  int32_t frequency;    /* Predicted ppb for the current temperature */
+  uint32_t uncertainty; /* ppb */
+  uint32_t seconds;     /* Held since the last PPS edge */
+  uint32_t error;       /* Predicted time error since the last PPS edge in ns */
+  uint8_t bins;         /* Bins usable for a prediction */
+} ntp_holdover_status_t;
+
+/*
+ * Predicts the frequency of the timebase while there is no PPS. While the
+ * servo is locked each temperature sample adds its frequency to a curve of
+ * frequency over temperature. In holdover the frequency is taken from the last
+ * locked one plus the difference of the curve between the temperature then and
+ * now, so an offset of the whole curve by aging cancels out. The uncertainty
+ * of the prediction adds up once per second held and is the time error
+ * reported in the root dispersion. Second and Edge are called from the PPS
+ * interrupt, everything else from the main loop.
+ */
+class NTP_Holdover {
+
+public:
+    NTP_Holdover( );
+
+    /**************************************************************************************************
+     *    Function      : GetDefaultConfig
+     *    Class         : NTP_Holdover
+     *    Description   : Gets the default config, nothing learned
+     *    Input         : none
+     *    Output        : ntp_holdover_settings_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    static ntp_holdover_settings_t GetDefaultConfig( void );
+
+    /**************************************************************************************************
+     *    Function      : Begin
+     *    Class         : NTP_Holdover
+     *    Description   : Starts with a stored curve
+     *    Input         : const ntp_holdover_settings_t* conf
+     *    Output        : none
+     *    Remarks       : none
+     **************************************************************************************************/
+    void Begin( const ntp_holdover_settings_t* conf );
+
+    /**************************************************************************************************
+     *    Function      : SetReference
+     *    Class         : NTP_Holdover
+     *    Description   : Takes the frequency of the locked servo the prediction starts from
+     *    Input         : bool has_temperature, int16_t temperature ( 1/4 °C ), int32_t ppb,
+     *                    uint32_t uncertainty ( ppb )
+     *    Output        : none
+     *    Remarks       : none
+     **************************************************************************************************/
+    void SetReference( bool has_temperature, int16_t temperature, int32_t ppb, uint32_t uncertainty );
+
+    /**************************************************************************************************
+     *    Function      : Learn
+     *    Class         : NTP_Holdover
+     *    Description   : Adds the frequency of the settled servo to the curve
+     *    Input         : int16_t temperature ( 1/4 °C ), int32_t ppb
+     *    Output        : none
+     *    Remarks       : Temperatures outside the bins are dropped
+     **************************************************************************************************/
+    void Learn( int16_t temperature, int32_t ppb );
+
+    /**************************************************************************************************
+     *    Function      : Predict
+     *    Class         : NTP_Holdover
+     *    Description   : Predicts the frequency and its uncertainty for a temperature
+     *    Input         : bool has_temperature, int16_t temperature ( 1/4 °C )
+     *    Output        : none
+     *    Remarks       : none
+     **************************************************************************************************/
+    void Predict( bool has_temperature, int16_t temperature );
+
+    /**************************************************************************************************
+     *    Function      : Second
+     *    Class         : NTP_Holdover
+     *    Description   : Adds one second held on the prediction
+     *    Input         : none
+     *    Output        : none
+     *    Remarks       : none
+     **************************************************************************************************/
+    void Second( void );
+
+    /**************************************************************************************************
+     *    Function      : Edge
+     *    Class         : NTP_Holdover
+     *    Description   : Ends the holdover on a PPS edge
+     *    Input         : none
+     *    Output        : none
+     *    Remarks       : none
+     **************************************************************************************************/
+    void Edge( void );
+
+    /**************************************************************************************************
+     *    Function      : GetFrequency
+     *    Class         : NTP_Holdover
+     *    Description   : Returns the predicted frequency
+     *    Input         : none
+     *    Output        : int32_t ( ppb the timebase runs fast )
+     *    Remarks       : none
+     **************************************************************************************************/
+    int32_t GetFrequency( void );
+
+    /**************************************************************************************************
+     *    Function      : GetUncertainty
+     *    Class         : NTP_Holdover
+     *    Description   : Returns the uncertainty of the predicted frequency
+     *    Input         : none
+     *    Output        : uint32_t ( ppb )
+     *    Remarks       : none
+     **************************************************************************************************/
+    uint32_t GetUncertainty( void );
+
+    /**************************************************************************************************
+     *    Function      : GetError
+     *    Class         : NTP_Holdover
+     *    Description   : Returns the predicted time error since the last PPS edge
+     *    Input         : none
+     *    Output        : uint32_t ( ns )
+     *    Remarks       : 0 while there is PPS
+     **************************************************************************************************/
+    uint32_t GetError( void );
+
+    /**************************************************************************************************
+     *    Function      : GetStatus
+     *    Class         : NTP_Holdover
+     *    Description   : Returns the state of the prediction
+     *    Input         : none
+     *    Output        : ntp_holdover_status_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    ntp_holdover_status_t GetStatus( void );
+
+    /**************************************************************************************************
+     *    Function      : GetCurve
+     *    Class         : NTP_Holdover
+     *    Description   : Returns the learned curve
+     *    Input         : none
+     *    Output        : ntp_holdover_settings_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    ntp_holdover_settings_t GetCurve( void );
+
+    /**************************************************************************************************
+     *    Function      : TakeSettings
+     *    Class         : NTP_Holdover
+     *    Description   : Hands out the learned curve for storage
+     *    Input         : ntp_holdover_settings_t* out
+     *    Output        : bool
+     *    Remarks       : True after NTP_HOLDOVER_SAVE_SAMPLES samples or when a bin became usable
+     **************************************************************************************************/
+    bool TakeSettings( ntp_holdover_settings_t* out );
+
+    /**************************************************************************************************
+     *    Function      : GetBinTemperature
+     *    Class         : NTP_Holdover
+     *    Description   : Returns the temperature in the middle of a bin
+     *    Input         : uint8_t bin
+     *    Output        : int16_t ( 1/4 °C )
+     *    Remarks       : none
+     **************************************************************************************************/
+    static int16_t GetBinTemperature( uint8_t bin );
+
+private:
+    ntp_holdover_settings_t curve;
+    bool has_temperature;
+    int16_t temperature;
+    bool referenced;
+    bool reference_has_temperature;
+    int16_t reference_temperature;
+    int32_t reference;
+    uint32_t reference_uncertainty;
+    bool compensated;
+    int32_t frequency;
+    uint32_t uncertainty;
+    uint32_t seconds;
+    uint32_t error;
+    uint16_t unsaved;     /* Samples learned since the curve was handed out */
+    bool usable_added;    /* A bin became usable since the curve was handed out */
+
+    int8_t GetBin( int16_t temperature );
+    bool Lookup( int16_t temperature, int32_t* ppb, uint32_t* deviation );
+};
+
+#endif
@@ -0,0 +1,69 @@
+#include <string.h>
+#include "ntp_interleave.h"
+
+#ifdef ARDUINO
+ #include <lwip/def.h>
+#else
+ #include <arpa/inet.h>
+#endif
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_InterleaveTable
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_InterleaveTable::NTP_InterleaveTable( ){
+  memset(entries, 0, sizeof(entries));
+}
+
+/**************************************************************************************************
+ *    Function      : Index
+ *    Class         : NTP_InterleaveTable
+ *    Description   : Maps a client to its slot
+ *    Input         : uint32_t hash
+ *    Output        : uint32_t
+ *    Remarks       : none
+ **************************************************************************************************/
+uint32_t NTP_InterleaveTable::Index( uint32_t hash ){
+  return (uint32_t)( ( (uint64_t)hash * NTP_INTERLEAVE_ENTRIES ) >> 32 );
+}
+
+/**************************************************************************************************
+ *    Function      : Lookup
+ *    Class         : NTP_InterleaveTable
+ *    Description   : Checks if a request asks for an interleaved response
+ *    Input         : const ntp_addr_t* client, uint32_t hash, const ntp_packet_t* req, ntp_timestamp_t* prev_tx
+ *    Output        : bool
+ *    Remarks       : Returns the real transmit time of the previous response in prev_tx.
+ *                    hash is the keyed one of ntp_addr_hash, it only picks the slot
+ **************************************************************************************************/
+bool NTP_InterleaveTable::Lookup( const ntp_addr_t* client, uint32_t hash, const ntp_packet_t* req, ntp_timestamp_t* prev_tx ){
+  ntp_interleave_entry_t* e = &entries[Index(hash)];
+  if( (e->rx.seconds == 0) || (false == ntp_addr_equal(&e->client, client)) ){
+    return false;
+  }
+  /* An interleaved client returns our last receive timestamp as origin */
+  if( (req->origTm_s != htonl(e->rx.seconds)) || (req->origTm_f != htonl(e->rx.fraction)) ){
+    return false;
+  }
+  *prev_tx = e->tx;
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : Store
+ *    Class         : NTP_InterleaveTable
+ *    Description   : Remembers the timestamps of a response sent to a client
+ *    Input         : const ntp_addr_t* client, uint32_t hash, ntp_timestamp_t rx, ntp_timestamp_t tx
+ *    Output        : none
+ *    Remarks       : tx needs to be taken after the response has left the stack
+ **************************************************************************************************/
+void NTP_InterleaveTable::Store( const ntp_addr_t* client, uint32_t hash, ntp_timestamp_t rx, ntp_timestamp_t tx ){
+  ntp_interleave_entry_t* e = &entries[Index(hash)];
+  e->client = *client;
+  e->rx = rx;
+  e->tx = tx;
+}
@@ -0,0 +1,55 @@
+#ifndef NTP_INTERLEAVE_H_
+ #define NTP_INTERLEAVE_H_
+
+#include <stdint.h>
+#include "ntp_packet.h"
+#include "ntp_addr.h"
+
+/* Number of clients tracked for the interleaved mode, needs to be a power of two */
+#ifndef NTP_INTERLEAVE_ENTRIES
+ #define NTP_INTERLEAVE_ENTRIES ( 256 )
+#endif
+
+/* Receive and real transmit time of the last response sent to a client */
+typedef struct {
+  ntp_addr_t client;
+  ntp_timestamp_t rx;
+  ntp_timestamp_t tx;
+} ntp_interleave_entry_t;
+
+/* 
+ * Direct mapped table for the NTPv4 interleaved mode, a client that collides with 
+ * another one just falls back to the basic mode for the next request
+ */
+class NTP_InterleaveTable {
+
+public:
+    NTP_InterleaveTable( );
+
+    /**************************************************************************************************
+     *    Function      : Lookup
+     *    Class         : NTP_InterleaveTable
+     *    Description   : Checks if a request asks for an interleaved response
+     *    Input         : const ntp_addr_t* client, uint32_t hash, const ntp_packet_t* req, ntp_timestamp_t* prev_tx
+     *    Output        : bool
+     *    Remarks       : Returns the real transmit time of the previous response in prev_tx.
+     *                    hash is the keyed one of ntp_addr_hash, it only picks the slot
+     **************************************************************************************************/
+    bool Lookup( const ntp_addr_t* client, uint32_t hash, const ntp_packet_t* req, ntp_timestamp_t* prev_tx );
+
+    /**************************************************************************************************
+     *    Function      : Store
+     *    Class         : NTP_InterleaveTable
+     *    Description   : Remembers the timestamps of a response sent to a client
+     *    Input         : const ntp_addr_t* client, uint32_t hash, ntp_timestamp_t rx, ntp_timestamp_t tx
+     *    Output        : none
+     *    Remarks       : tx needs to be taken after the response has left the stack
+     **************************************************************************************************/
+    void Store( const ntp_addr_t* client, uint32_t hash, ntp_timestamp_t rx, ntp_timestamp_t tx );
+
+private:
+    ntp_interleave_entry_t entries[NTP_INTERLEAVE_ENTRIES];
+    uint32_t Index( uint32_t hash );
+};
+
+#endif
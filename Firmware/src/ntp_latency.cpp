@@ -0,0 +1,151 @@
+#include <string.h>
+#ifdef ARDUINO
+ #include "Arduino.h"
+ #include "esp_timer.h"
+#endif
+#include "ntp_latency.h"
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_LatencyStats
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_LatencyStats::NTP_LatencyStats( ){
+  Reset();
+}
+
+/**************************************************************************************************
+ *    Function      : Reset
+ *    Class         : NTP_LatencyStats
+ *    Description   : Clears all histograms
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : A packet counted at the same time may be lost or half kept
+ **************************************************************************************************/
+void NTP_LatencyStats::Reset( void ){
+  for(uint8_t s=0;s<NTP_LATENCY_STAGES;s++){
+    for(uint8_t b=0;b<NTP_LATENCY_BUCKETS;b++){
+      histogram[s][b] = 0;
+    }
+    max[s] = 0;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : BucketLimit
+ *    Class         : NTP_LatencyStats
+ *    Description   : Returns the largest cycle count that falls into a bucket
+ *    Input         : uint8_t bucket
+ *    Output        : uint32_t
+ *    Remarks       : Inverse of Bucket
+ **************************************************************************************************/
+uint32_t NTP_LatencyStats::BucketLimit( uint8_t bucket ){
+  if(bucket < ( 1u << NTP_LATENCY_SUB_BITS ) ){
+    return bucket;
+  }
+  uint8_t shift = ( bucket >> NTP_LATENCY_SUB_BITS ) - 1;
+  uint64_t sub = ( 1u << NTP_LATENCY_SUB_BITS ) + ( bucket & ( ( 1u << NTP_LATENCY_SUB_BITS ) - 1 ) );
+  return (uint32_t)( ( ( sub + 1 ) << shift ) - 1 );
+}
+
+/**************************************************************************************************
+ *    Function      : GetSummary
+ *    Class         : NTP_LatencyStats
+ *    Description   : Returns count, median, 99th percentile and maximum of a stage
+ *    Input         : ntp_latency_stage_t stage
+ *    Output        : ntp_latency_summary_t
+ *    Remarks       : The percentiles are accurate to a quarter octave
+ **************************************************************************************************/
+ntp_latency_summary_t NTP_LatencyStats::GetSummary( ntp_latency_stage_t stage ){
+  ntp_latency_summary_t out;
+  uint32_t bins[NTP_LATENCY_BUCKETS];
+  memset(&out, 0, sizeof(out));
+  if(stage >= NTP_LATENCY_STAGES){
+    return out;
+  }
+  /* Copied first, so the percentiles are taken from one consistent count */
+  for(uint8_t b=0;b<NTP_LATENCY_BUCKETS;b++){
+    bins[b] = histogram[stage][b];
+    out.count += bins[b];
+  }
+  out.max = max[stage];
+  if(out.count == 0){
+    return out;
+  }
+  uint32_t p50_rank = ( out.count + 1 ) / 2;
+  uint32_t p99_rank = out.count - ( out.count / 100 );
+  uint32_t seen = 0;
+  bool p50_found = false;
+  for(uint8_t b=0;b<NTP_LATENCY_BUCKETS;b++){
+    seen += bins[b];
+    if( (false == p50_found) && (seen >= p50_rank) ){
+      out.p50 = BucketLimit(b);
+      p50_found = true;
+    }
+    if(seen >= p99_rank){
+      out.p99 = BucketLimit(b);
+      break;
+    }
+  }
+  /* The bucket may reach beyond the largest value seen */
+  if(out.p50 > out.max){
+    out.p50 = out.max;
+  }
+  if(out.p99 > out.max){
+    out.p99 = out.max;
+  }
+  return out;
+}
+
+/**************************************************************************************************
+ *    Function      : GetCyclesPerUs
+ *    Class         : NTP_LatencyStats
+ *    Description   : Returns the rate of the counter used by Now
+ *    Input         : none
+ *    Output        : uint32_t
+ *    Remarks       : none
+ **************************************************************************************************/
+uint32_t NTP_LatencyStats::GetCyclesPerUs( void ){
+#if defined(__XTENSA__) && defined(ARDUINO)
+  return getCpuFrequencyMhz();
+#else
+  return 1000;
+#endif
+}
+
+/**************************************************************************************************
+ *    Function      : Shared
+ *    Class         : NTP_LatencyStats
+ *    Description   : Returns a stamp in cycles that is the same on both cores
+ *    Input         : none
+ *    Output        : uint32_t
+ *    Remarks       : From the system timer on the ESP32, so with a resolution of 1us
+ **************************************************************************************************/
+uint32_t NTP_LatencyStats::Shared( void ){
+#if ( NTP_LATENCY_STATS > 0 ) && defined(__XTENSA__) && defined(ARDUINO)
+  return (uint32_t)( esp_timer_get_time() * GetCyclesPerUs() );
+#else
+  return Now();
+#endif
+}
+
+/**************************************************************************************************
+ *    Function      : GetStageName
+ *    Class         : NTP_LatencyStats
+ *    Description   : Returns the name of a stage for reports
+ *    Input         : ntp_latency_stage_t stage
+ *    Output        : const char*
+ *    Remarks       : none
+ **************************************************************************************************/
+const char* NTP_LatencyStats::GetStageName( ntp_latency_stage_t stage ){
+  switch(stage){
+    case NTP_LATENCY_DISPATCH: return "dispatch";
+    case NTP_LATENCY_RESPOND: return "respond";
+    case NTP_LATENCY_SEND: return "send";
+    case NTP_LATENCY_TOTAL: return "total";
+    default: return "";
+  }
+}
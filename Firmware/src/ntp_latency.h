@@ -0,0 +1,155 @@
+#ifndef NTP_LATENCY_H_
+ #define NTP_LATENCY_H_
+
+#include <stdint.h>
+#include <time.h>
+
+/*
+ * Set NTP_LATENCY_STATS to 0 to compile the cycle stamps out of the packet path,
+ * the calls stay in place and are optimized away
+ */
+#ifndef NTP_LATENCY_STATS
+ #define NTP_LATENCY_STATS ( 1 )
+#endif
+
+/* Sub buckets per power of two, 2 bits split every octave into 4 buckets */
+#define NTP_LATENCY_SUB_BITS ( 2 )
+#define NTP_LATENCY_BUCKETS ( 32 << NTP_LATENCY_SUB_BITS )
+
+/* Parts of the time a request is held, each one gets its own histogram */
+typedef enum {
+  NTP_LATENCY_DISPATCH = 0,   /* Arrival to the request being checked and its client known */
+  NTP_LATENCY_RESPOND,        /* Request parsed, rate limited and the response built */
+  NTP_LATENCY_SEND,           /* Handing the response to the stack */
+  NTP_LATENCY_TOTAL,          /* Arrival to the response being sent */
+  NTP_LATENCY_STAGES
+} ntp_latency_stage_t;
+
+typedef struct {
+  uint32_t count;
+  uint32_t p50;   /* Cycles, upper end of the bucket */
+  uint32_t p99;
+  uint32_t max;
+} ntp_latency_summary_t;
+
+/*
+ * Log scale histograms of the cycles spent per stage. There is one writer,
+ * the task answering the requests, so the counters are updated without a
+ * lock. Readers may see a packet that is only partly counted.
+ */
+class NTP_LatencyStats {
+
+public:
+    NTP_LatencyStats( );
+
+    /**************************************************************************************************
+     *    Function      : Now
+     *    Class         : NTP_LatencyStats
+     *    Description   : Returns the cycle counter of the CPU
+     *    Input         : none
+     *    Output        : uint32_t
+     *    Remarks       : Nanoseconds without a cycle counter, 0 if the stats are compiled out.
+     *                    The counters of the two cores are not in step, only stamps taken by the
+     *                    same task may be compared, Shared is for those taken by different tasks
+     **************************************************************************************************/
+    static inline uint32_t Now( void ){
+#if ( NTP_LATENCY_STATS > 0 )
+ #if defined(__XTENSA__)
+      uint32_t ccount;
+      __asm__ __volatile__("rsr %0, ccount" : "=a"(ccount));
+      return ccount;
+ #else
+      struct timespec ts;
+      clock_gettime(CLOCK_MONOTONIC, &ts);
+      return (uint32_t)( ( ts.tv_sec * 1000000000ull ) + ts.tv_nsec );
+ #endif
+#else
+      return 0;
+#endif
+    }
+
+    /**************************************************************************************************
+     *    Function      : Add
+     *    Class         : NTP_LatencyStats
+     *    Description   : Counts the cycles between two stamps for a stage
+     *    Input         : ntp_latency_stage_t stage, uint32_t start, uint32_t end
+     *    Output        : none
+     *    Remarks       : Only to be called from the task answering the requests
+     **************************************************************************************************/
+    inline void Add( ntp_latency_stage_t stage, uint32_t start, uint32_t end ){
+#if ( NTP_LATENCY_STATS > 0 )
+      uint32_t cycles = end - start;
+      histogram[stage][Bucket(cycles)]++;
+      if(cycles > max[stage]){
+        max[stage] = cycles;
+      }
+#endif
+    }
+
+    /**************************************************************************************************
+     *    Function      : GetSummary
+     *    Class         : NTP_LatencyStats
+     *    Description   : Returns count, median, 99th percentile and maximum of a stage
+     *    Input         : ntp_latency_stage_t stage
+     *    Output        : ntp_latency_summary_t
+     *    Remarks       : The percentiles are accurate to a quarter octave
+     **************************************************************************************************/
+    ntp_latency_summary_t GetSummary( ntp_latency_stage_t stage );
+
+    /**************************************************************************************************
+     *    Function      : Reset
+     *    Class         : NTP_LatencyStats
+     *    Description   : Clears all histograms
+     *    Input         : none
+     *    Output        : none
+     *    Remarks       : A packet counted at the same time may be lost or half kept
+     **************************************************************************************************/
+    void Reset( void );
+
+    /**************************************************************************************************
+     *    Function      : GetCyclesPerUs
+     *    Class         : NTP_LatencyStats
+     *    Description   : Returns the rate of the counter used by Now
+     *    Input         : none
+     *    Output        : uint32_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    static uint32_t GetCyclesPerUs( void );
+
+    /**************************************************************************************************
+     *    Function      : Shared
+     *    Class         : NTP_LatencyStats
+     *    Description   : Returns a stamp in cycles that is the same on both cores
+     *    Input         : none
+     *    Output        : uint32_t
+     *    Remarks       : From the system timer on the ESP32, so with a resolution of 1us
+     **************************************************************************************************/
+    static uint32_t Shared( void );
+
+    /**************************************************************************************************
+     *    Function      : GetStageName
+     *    Class         : NTP_LatencyStats
+     *    Description   : Returns the name of a stage for reports
+     *    Input         : ntp_latency_stage_t stage
+     *    Output        : const char*
+     *    Remarks       : none
+     **************************************************************************************************/
+    static const char* GetStageName( ntp_latency_stage_t stage );
+
+private:
+    volatile uint32_t histogram[NTP_LATENCY_STAGES][NTP_LATENCY_BUCKETS];
+    volatile uint32_t max[NTP_LATENCY_STAGES];
+
+    /* The top two bits below the highest set one select the sub bucket */
+    static inline uint8_t Bucket( uint32_t cycles ){
+      if(cycles < ( 1u << NTP_LATENCY_SUB_BITS ) ){
+        return cycles;
+      }
+      uint8_t msb = 31 - __builtin_clz(cycles);
+      return ( ( msb - NTP_LATENCY_SUB_BITS + 1 ) << NTP_LATENCY_SUB_BITS ) |
+             ( ( cycles >> ( msb - NTP_LATENCY_SUB_BITS ) ) & ( ( 1u << NTP_LATENCY_SUB_BITS ) - 1 ) );
+    }
+    static uint32_t BucketLimit( uint8_t bucket );
+};
+
+#endif
@@ -0,0 +1,172 @@
+#include "ntp_leap.h"
+
+#ifdef ARDUINO
+ #include "Arduino.h"
+#else
+ /* Next runs from the PPS interrupt on the ESP32 */
+ #define IRAM_ATTR
+#endif
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_LeapSecond
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : No leap announced
+ **************************************************************************************************/
+NTP_LeapSecond::NTP_LeapSecond( ){
+  SetConfig(GetDefaultConfig());
+}
+
+/**************************************************************************************************
+ *    Function      : GetDefaultConfig
+ *    Class         : NTP_LeapSecond
+ *    Description   : Gets an empty leap second announcement
+ *    Input         : none
+ *    Output        : leap_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+leap_settings_t NTP_LeapSecond::GetDefaultConfig( void ){
+  leap_settings_t conf;
+  conf.time = 0;
+  conf.direction = 0;
+  conf.smear = false;
+  return conf;
+}
+
+/**************************************************************************************************
+ *    Function      : SetConfig
+ *    Class         : NTP_LeapSecond
+ *    Description   : Announces a leap second
+ *    Input         : leap_settings_t conf
+ *    Output        : none
+ *    Remarks       : An announcement for a time that is not midnight is ignored
+ **************************************************************************************************/
+void NTP_LeapSecond::SetConfig( leap_settings_t conf ){
+  if( ( (conf.time % NTP_LEAP_DAY) != 0 ) || (conf.direction > 1) || (conf.direction < -1) ){
+    conf = GetDefaultConfig();
+  }
+  config = conf;
+  held = false;
+  leap = (uint64_t)conf.time + NTP_TIMESTAMP_DELTA;
+  step = leap;
+  if(true == conf.smear){
+    step += NTP_LEAP_SMEAR / 2;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : GetConfig
+ *    Class         : NTP_LeapSecond
+ *    Description   : Gets the leap second announcement
+ *    Input         : none
+ *    Output        : leap_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+leap_settings_t NTP_LeapSecond::GetConfig( void ){
+  return config;
+}
+
+/**************************************************************************************************
+ *    Function      : Next
+ *    Class         : NTP_LeapSecond
+ *    Description   : Advances the counter by one second
+ *    Input         : uint64_t seconds ( counter )
+ *    Output        : uint64_t ( counter )
+ *    Remarks       : Repeats the second before the step for an inserted leap and skips it for
+ *                    a deleted one
+ **************************************************************************************************/
+uint64_t IRAM_ATTR NTP_LeapSecond::Next( uint64_t seconds ){
+  if( (config.direction > 0) && (seconds + 1 == step) && (false == held) ){
+    /* 23:59:60, the second is repeated */
+    held = true;
+    return seconds;
+  }
+  held = false;
+  seconds++;
+  if( (config.direction < 0) && (seconds + 1 == step) ){
+    /* 23:59:59 is skipped */
+    seconds++;
+  }
+  return seconds;
+}
+
+/**************************************************************************************************
+ *    Function      : ToUTC
+ *    Class         : NTP_LeapSecond
+ *    Description   : Returns the UTC second of the counter
+ *    Input         : uint64_t seconds ( counter )
+ *    Output        : uint64_t ( seconds since 1.1.1900 across NTP eras )
+ *    Remarks       : Differs while smearing, the counter is stepped in the middle of the smear
+ **************************************************************************************************/
+uint64_t NTP_LeapSecond::ToUTC( uint64_t seconds ){
+  if( (config.direction != 0) && (false == held) && (seconds >= leap) && (seconds < step) ){
+    /* Smearing, the counter is still on the UTC from before the leap */
+    return seconds - config.direction;
+  }
+  return seconds;
+}
+
+/**************************************************************************************************
+ *    Function      : FromUTC
+ *    Class         : NTP_LeapSecond
+ *    Description   : Returns the counter for a UTC second read from a source
+ *    Input         : uint64_t time ( seconds since 1.1.1900 across NTP eras ), uint64_t* seconds
+ *    Output        : bool ( false around the leap, the counter is kept )
+ *    Remarks       : Around the leap itself the sources don't agree on what the second is
+ **************************************************************************************************/
+bool NTP_LeapSecond::FromUTC( uint64_t time, uint64_t* seconds ){
+  if( (config.direction != 0) && (time + 2 >= leap) && (time <= leap + 1) ){
+    return false;
+  }
+  *seconds = time;
+  if( (config.direction != 0) && (time >= leap) && (time + ( ( config.direction > 0 ) ? 1 : 0 ) < step) ){
+    /* While smearing the counter is stepped at the end, the source already is on the new UTC */
+    *seconds = time + config.direction;
+  }
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : GetIndicator
+ *    Class         : NTP_LeapSecond
+ *    Description   : Gets the NTP leap indicator
+ *    Input         : uint64_t now ( counter )
+ *    Output        : uint8_t ( 0 none, 1 insert, 2 delete )
+ *    Remarks       : Set on the day of the leap only, never while smearing
+ **************************************************************************************************/
+uint8_t NTP_LeapSecond::GetIndicator( uint64_t now ){
+  if( (config.direction == 0) || (true == config.smear) ){
+    return 0;
+  }
+  if( (now + NTP_LEAP_DAY < leap) || (now >= leap) ){
+    return 0;
+  }
+  return ( config.direction > 0 ) ? 1 : 2;
+}
+
+/**************************************************************************************************
+ *    Function      : Smear
+ *    Class         : NTP_LeapSecond
+ *    Description   : Returns the time read from the counter and a fraction
+ *    Input         : uint64_t seconds ( counter ), uint32_t fraction
+ *    Output        : ntp_time64_t
+ *    Remarks       : The era is dropped. Within the smear the leap is spread linearly from 0 at
+ *                    its start to one second at the step of the counter
+ **************************************************************************************************/
+ntp_time64_t NTP_LeapSecond::Smear( uint64_t seconds, uint32_t fraction ){
+  ntp_time64_t ts = ( (ntp_time64_t)seconds << 32 ) | fraction;
+  if( (config.direction == 0) || (false == config.smear) || (true == held) ){
+    return ts;
+  }
+  uint64_t start = leap - ( NTP_LEAP_SMEAR / 2 );
+  /* A deleted second is skipped at the end of the one before the step */
+  uint64_t end = ( config.direction > 0 ) ? step : step - 1;
+  if( (seconds >= start) && (seconds < end) ){
+    uint64_t since = ( ( seconds - start ) << 32 ) | fraction;
+    uint64_t offset = since / ( end - start );
+    ts = ( config.direction > 0 ) ? ( ts - offset ) : ( ts + offset );
+  }
+  return ts;
+}
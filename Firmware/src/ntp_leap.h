@@ -0,0 +1,123 @@
+#ifndef NTP_LEAP_H_
+ #define NTP_LEAP_H_
+
+#include <stdint.h>
+#include "ntp_timestamp.h"
+
+/* Length of the linear leap second smear, centered on the leap */
+#define NTP_LEAP_SMEAR ( 86400 )
+
+/* Leaps happen at the end of a UTC day */
+#define NTP_LEAP_DAY ( 86400 )
+
+/* Leap second announcement, the leap happens at the end of a UTC day */
+typedef struct {
+  uint32_t time;       /* UNIX time of the first second after the leap, needs to be midnight, up to 2106 */
+  int8_t direction;    /* 1 to insert a second, -1 to delete one, 0 for none */
+  bool smear;          /* Spread the leap over NTP_LEAP_SMEAR seconds instead of a step */
+} leap_settings_t;
+
+/*
+ * A leap second announcement applied to a second counter, seconds since
+ * 1.1.1900 counted on across NTP eras. With a step the counter repeats
+ * 23:59:59 for an inserted second and skips it for a deleted one. With a smear
+ * the counter keeps the UTC from before the leap until the middle of the smear
+ * and the leap is spread linearly over the time read from it. Next runs from
+ * the PPS interrupt, the object is small enough to be copied under the lock
+ * of the counter and read from the copy.
+ */
+class NTP_LeapSecond {
+
+public:
+    NTP_LeapSecond( );
+
+    /**************************************************************************************************
+     *    Function      : GetDefaultConfig
+     *    Class         : NTP_LeapSecond
+     *    Description   : Gets an empty leap second announcement
+     *    Input         : none
+     *    Output        : leap_settings_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    static leap_settings_t GetDefaultConfig( void );
+
+    /**************************************************************************************************
+     *    Function      : SetConfig
+     *    Class         : NTP_LeapSecond
+     *    Description   : Announces a leap second
+     *    Input         : leap_settings_t conf
+     *    Output        : none
+     *    Remarks       : An announcement for a time that is not midnight is ignored
+     **************************************************************************************************/
+    void SetConfig( leap_settings_t conf );
+
+    /**************************************************************************************************
+     *    Function      : GetConfig
+     *    Class         : NTP_LeapSecond
+     *    Description   : Gets the leap second announcement
+     *    Input         : none
+     *    Output        : leap_settings_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    leap_settings_t GetConfig( void );
+
+    /**************************************************************************************************
+     *    Function      : Next
+     *    Class         : NTP_LeapSecond
+     *    Description   : Advances the counter by one second
+     *    Input         : uint64_t seconds ( counter )
+     *    Output        : uint64_t ( counter )
+     *    Remarks       : Repeats the second before the step for an inserted leap and skips it for
+     *                    a deleted one
+     **************************************************************************************************/
+    uint64_t Next( uint64_t seconds );
+
+    /**************************************************************************************************
+     *    Function      : ToUTC
+     *    Class         : NTP_LeapSecond
+     *    Description   : Returns the UTC second of the counter
+     *    Input         : uint64_t seconds ( counter )
+     *    Output        : uint64_t ( seconds since 1.1.1900 across NTP eras )
+     *    Remarks       : Differs while smearing, the counter is stepped in the middle of the smear
+     **************************************************************************************************/
+    uint64_t ToUTC( uint64_t seconds );
+
+    /**************************************************************************************************
+     *    Function      : FromUTC
+     *    Class         : NTP_LeapSecond
+     *    Description   : Returns the counter for a UTC second read from a source
+     *    Input         : uint64_t time ( seconds since 1.1.1900 across NTP eras ), uint64_t* seconds
+     *    Output        : bool ( false around the leap, the counter is kept )
+     *    Remarks       : Around the leap itself the sources don't agree on what the second is
+     **************************************************************************************************/
+    bool FromUTC( uint64_t time, uint64_t* seconds );
+
+    /**************************************************************************************************
+     *    Function      : GetIndicator
+     *    Class         : NTP_LeapSecond
+     *    Description   : Gets the NTP leap indicator
+     *    Input         : uint64_t now ( counter )
+     *    Output        : uint8_t ( 0 none, 1 insert, 2 delete )
+     *    Remarks       : Set on the day of the leap only, never while smearing
+     **************************************************************************************************/
+    uint8_t GetIndicator( uint64_t now );
+
+    /**************************************************************************************************
+     *    Function      : Smear
+     *    Class         : NTP_LeapSecond
+     *    Description   : Returns the time read from the counter and a fraction
+     *    Input         : uint64_t seconds ( counter ), uint32_t fraction
+     *    Output        : ntp_time64_t
+     *    Remarks       : The era is dropped. Within the smear the leap is spread linearly from 0 at
+     *                    its start to one second at the step of the counter
+     **************************************************************************************************/
+    ntp_time64_t Smear( uint64_t seconds, uint32_t fraction );
+
+private:
+    leap_settings_t config;
+    uint64_t leap;    /* The first second after the leap, same scale as the counter */
+    uint64_t step;    /* The second the counter is stepped at, later than the leap while smearing */
+    bool held;        /* The current second is the repeated one */
+};
+
+#endif
@@ -0,0 +1,258 @@
+#include <string.h>
+#include "ntp_mru.h"
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_MRUList
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_MRUList::NTP_MRUList( ){
+  memset(entries, 0, sizeof(entries));
+  for(uint32_t i=0;i<NTP_MRU_ENTRIES;i++){
+    buckets[i] = NTP_MRU_NONE;
+  }
+  head = NTP_MRU_NONE;
+  tail = NTP_MRU_NONE;
+  used = 0;
+  evictions = 0;
+}
+
+/**************************************************************************************************
+ *    Function      : Bucket
+ *    Class         : NTP_MRUList
+ *    Description   : Returns the hash bucket of a client
+ *    Input         : uint32_t hash
+ *    Output        : uint32_t
+ *    Remarks       : none
+ **************************************************************************************************/
+uint32_t NTP_MRUList::Bucket( uint32_t hash ){
+  return (uint32_t)( ( (uint64_t)hash * NTP_MRU_ENTRIES ) >> 32 );
+}
+
+/**************************************************************************************************
+ *    Function      : Unlink
+ *    Class         : NTP_MRUList
+ *    Description   : Takes an entry out of the list
+ *    Input         : uint16_t idx
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_MRUList::Unlink( uint16_t idx ){
+  ntp_mru_entry_t* e = &entries[idx];
+  if(e->lru_prev != NTP_MRU_NONE){
+    entries[e->lru_prev].lru_next = e->lru_next;
+  } else {
+    head = e->lru_next;
+  }
+  if(e->lru_next != NTP_MRU_NONE){
+    entries[e->lru_next].lru_prev = e->lru_prev;
+  } else {
+    tail = e->lru_prev;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : PushFront
+ *    Class         : NTP_MRUList
+ *    Description   : Puts an entry in front of the list
+ *    Input         : uint16_t idx
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_MRUList::PushFront( uint16_t idx ){
+  ntp_mru_entry_t* e = &entries[idx];
+  e->lru_prev = NTP_MRU_NONE;
+  e->lru_next = head;
+  if(head != NTP_MRU_NONE){
+    entries[head].lru_prev = idx;
+  } else {
+    tail = idx;
+  }
+  head = idx;
+}
+
+/**************************************************************************************************
+ *    Function      : RemoveFromBucket
+ *    Class         : NTP_MRUList
+ *    Description   : Takes an entry out of its hash chain
+ *    Input         : uint16_t idx
+ *    Output        : none
+ *    Remarks       : Chains hold one entry on average as there are as many buckets as entries
+ **************************************************************************************************/
+void NTP_MRUList::RemoveFromBucket( uint16_t idx ){
+  uint16_t* link = &buckets[ Bucket(entries[idx].hash) ];
+  while(*link != NTP_MRU_NONE){
+    if(*link == idx){
+      *link = entries[idx].hash_next;
+      return;
+    }
+    link = &entries[*link].hash_next;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : Find
+ *    Class         : NTP_MRUList
+ *    Description   : Looks up a client
+ *    Input         : const ntp_addr_t* client, uint32_t hash
+ *    Output        : uint16_t ( index or NTP_MRU_NONE )
+ *    Remarks       : none
+ **************************************************************************************************/
+uint16_t NTP_MRUList::Find( const ntp_addr_t* client, uint32_t hash ){
+  uint16_t idx = buckets[ Bucket(hash) ];
+  while(idx != NTP_MRU_NONE){
+    if( (entries[idx].hash == hash) && (true == ntp_addr_equal(&entries[idx].client, client)) ){
+      break;
+    }
+    idx = entries[idx].hash_next;
+  }
+  return idx;
+}
+
+/**************************************************************************************************
+ *    Function      : Update
+ *    Class         : NTP_MRUList
+ *    Description   : Records a request from a client
+ *    Input         : const ntp_addr_t* client, uint32_t hash, ntp_timestamp_t now, uint8_t version, uint8_t mode
+ *    Output        : none
+ *    Remarks       : Constant time, the oldest client is evicted if the list is full.
+ *                    hash is the keyed one of ntp_addr_hash, it only picks the bucket
+ **************************************************************************************************/
+void NTP_MRUList::Update( const ntp_addr_t* client, uint32_t hash, ntp_timestamp_t now, uint8_t version, uint8_t mode ){
+  uint32_t bucket = Bucket(hash);
+  uint16_t idx = Find(client, hash);
+
+  if(idx == NTP_MRU_NONE){
+    if(used < NTP_MRU_ENTRIES){
+      idx = used;
+      used++;
+    } else {
+      /* Reuse the least recently seen client */
+      idx = tail;
+      Unlink(idx);
+      RemoveFromBucket(idx);
+      evictions++;
+    }
+    ntp_mru_entry_t* e = &entries[idx];
+    e->client = *client;
+    e->hash = hash;
+    e->first = now;
+    e->count = 0;
+    e->hash_next = buckets[bucket];
+    buckets[bucket] = idx;
+    PushFront(idx);
+  } else if(idx != head){
+    Unlink(idx);
+    PushFront(idx);
+  }
+
+  ntp_mru_entry_t* e = &entries[idx];
+  e->last = now;
+  e->count++;
+  e->version = version;
+  e->mode = mode;
+}
+
+/**************************************************************************************************
+ *    Function      : GetClients
+ *    Class         : NTP_MRUList
+ *    Description   : Copies a part of the list, most recently seen client first
+ *    Input         : ntp_mru_entry_t* out, uint16_t start, uint16_t max
+ *    Output        : uint16_t ( entries copied )
+ *    Remarks       : none
+ **************************************************************************************************/
+uint16_t NTP_MRUList::GetClients( ntp_mru_entry_t* out, uint16_t start, uint16_t max ){
+  uint16_t idx = head;
+  uint16_t copied = 0;
+  while( (idx != NTP_MRU_NONE) && (start > 0) ){
+    idx = entries[idx].lru_next;
+    start--;
+  }
+  while( (idx != NTP_MRU_NONE) && (copied < max) ){
+    out[copied] = entries[idx];
+    copied++;
+    idx = entries[idx].lru_next;
+  }
+  return copied;
+}
+
+/**************************************************************************************************
+ *    Function      : GetNewer
+ *    Class         : NTP_MRUList
+ *    Description   : Copies clients seen after a resume point, least recently seen first
+ *    Input         : const ntp_mru_resume_t* resume, uint8_t count, ntp_mru_entry_t* out, uint16_t max
+ *    Output        : int32_t ( entries copied, -1 if none of the resume points is valid )
+ *    Remarks       : The first resume point whose client has not been seen again is used,
+ *                    without any resume point the list is read from the oldest client on.
+ *                    The hash of a resume point needs to be set as for Update
+ **************************************************************************************************/
+int32_t NTP_MRUList::GetNewer( const ntp_mru_resume_t* resume, uint8_t count, ntp_mru_entry_t* out, uint16_t max ){
+  uint16_t idx = tail;
+  int32_t copied = 0;
+
+  if(count > 0){
+    idx = NTP_MRU_NONE;
+    for(uint8_t i=0;i<count;i++){
+      uint16_t found = Find(&resume[i].client, resume[i].hash);
+      if( (found != NTP_MRU_NONE) && 
+          (entries[found].last.seconds == resume[i].last.seconds) && 
+          (entries[found].last.fraction == resume[i].last.fraction) ){
+        idx = found;
+        break;
+      }
+    }
+    if(idx == NTP_MRU_NONE){
+      return -1;
+    }
+    idx = entries[idx].lru_prev;
+  }
+
+  while( (idx != NTP_MRU_NONE) && (copied < max) ){
+    out[copied] = entries[idx];
+    copied++;
+    idx = entries[idx].lru_prev;
+  }
+  return copied;
+}
+
+/**************************************************************************************************
+ *    Function      : Count
+ *    Class         : NTP_MRUList
+ *    Description   : Returns the number of clients in the list
+ *    Input         : none
+ *    Output        : uint16_t
+ *    Remarks       : none
+ **************************************************************************************************/
+uint16_t NTP_MRUList::Count( void ){
+  return used;
+}
+
+/**************************************************************************************************
+ *    Function      : GetEvictions
+ *    Class         : NTP_MRUList
+ *    Description   : Returns the number of clients thrown out to make room
+ *    Input         : none
+ *    Output        : uint32_t
+ *    Remarks       : none
+ **************************************************************************************************/
+uint32_t NTP_MRUList::GetEvictions( void ){
+  return evictions;
+}
+
+/**************************************************************************************************
+ *    Function      : AverageInterval
+ *    Class         : NTP_MRUList
+ *    Description   : Returns the average time between two requests of a client
+ *    Input         : const ntp_mru_entry_t* e
+ *    Output        : uint32_t ( seconds )
+ *    Remarks       : none
+ **************************************************************************************************/
+uint32_t NTP_MRUList::AverageInterval( const ntp_mru_entry_t* e ){
+  if(e->count < 2){
+    return 0;
+  }
+  return ( e->last.seconds - e->first.seconds ) / ( e->count - 1 );
+}
@@ -0,0 +1,123 @@
+#ifndef NTP_MRU_H_
+ #define NTP_MRU_H_
+
+#include <stdint.h>
+#include "ntp_timestamp.h"
+#include "ntp_addr.h"
+
+/* Number of clients kept in the most recently used list, needs to be a power of two */
+#ifndef NTP_MRU_ENTRIES
+ #define NTP_MRU_ENTRIES ( 512 )
+#endif
+
+/* Marks the end of a list */
+#define NTP_MRU_NONE ( 0xFFFF )
+
+typedef struct {
+  ntp_addr_t client;
+  uint32_t hash;          /* Keyed hash of the client, picks its bucket */
+  ntp_timestamp_t first;  /* First request seen from the client */
+  ntp_timestamp_t last;   /* Last request seen from the client */
+  uint32_t count;         /* Requests seen from the client */
+  uint8_t version;        /* NTP version of the last request */
+  uint8_t mode;           /* NTP mode of the last request */
+  uint16_t lru_prev;
+  uint16_t lru_next;
+  uint16_t hash_next;
+} ntp_mru_entry_t;
+
+/* A client and the time of its last request as reported to a reader before */
+typedef struct {
+  ntp_addr_t client;
+  uint32_t hash;
+  ntp_timestamp_t last;
+} ntp_mru_resume_t;
+
+/* 
+ * Fixed size list of the clients seen, ordered by the time of their last request.
+ * A hash table finds a client, a double linked list keeps the order and the least 
+ * recently seen client is reused once the list is full.
+ */
+class NTP_MRUList {
+
+public:
+    NTP_MRUList( );
+
+    /**************************************************************************************************
+     *    Function      : Update
+     *    Class         : NTP_MRUList
+     *    Description   : Records a request from a client
+     *    Input         : const ntp_addr_t* client, uint32_t hash, ntp_timestamp_t now, uint8_t version, uint8_t mode
+     *    Output        : none
+     *    Remarks       : Constant time, the oldest client is evicted if the list is full.
+     *                    hash is the keyed one of ntp_addr_hash, it only picks the bucket
+     **************************************************************************************************/
+    void Update( const ntp_addr_t* client, uint32_t hash, ntp_timestamp_t now, uint8_t version, uint8_t mode );
+
+    /**************************************************************************************************
+     *    Function      : GetClients
+     *    Class         : NTP_MRUList
+     *    Description   : Copies a part of the list, most recently seen client first
+     *    Input         : ntp_mru_entry_t* out, uint16_t start, uint16_t max
+     *    Output        : uint16_t ( entries copied )
+     *    Remarks       : none
+     **************************************************************************************************/
+    uint16_t GetClients( ntp_mru_entry_t* out, uint16_t start, uint16_t max );
+
+    /**************************************************************************************************
+     *    Function      : GetNewer
+     *    Class         : NTP_MRUList
+     *    Description   : Copies clients seen after a resume point, least recently seen first
+     *    Input         : const ntp_mru_resume_t* resume, uint8_t count, ntp_mru_entry_t* out, uint16_t max
+     *    Output        : int32_t ( entries copied, -1 if none of the resume points is valid )
+     *    Remarks       : The first resume point whose client has not been seen again is used,
+     *                    without any resume point the list is read from the oldest client on.
+     *                    The hash of a resume point needs to be set as for Update
+     **************************************************************************************************/
+    int32_t GetNewer( const ntp_mru_resume_t* resume, uint8_t count, ntp_mru_entry_t* out, uint16_t max );
+
+    /**************************************************************************************************
+     *    Function      : Count
+     *    Class         : NTP_MRUList
+     *    Description   : Returns the number of clients in the list
+     *    Input         : none
+     *    Output        : uint16_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    uint16_t Count( void );
+
+    /**************************************************************************************************
+     *    Function      : GetEvictions
+     *    Class         : NTP_MRUList
+     *    Description   : Returns the number of clients thrown out to make room
+     *    Input         : none
+     *    Output        : uint32_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    uint32_t GetEvictions( void );
+
+    /**************************************************************************************************
+     *    Function      : AverageInterval
+     *    Class         : NTP_MRUList
+     *    Description   : Returns the average time between two requests of a client
+     *    Input         : const ntp_mru_entry_t* e
+     *    Output        : uint32_t ( seconds )
+     *    Remarks       : none
+     **************************************************************************************************/
+    static uint32_t AverageInterval( const ntp_mru_entry_t* e );
+
+private:
+    ntp_mru_entry_t entries[NTP_MRU_ENTRIES];
+    uint16_t buckets[NTP_MRU_ENTRIES];
+    uint16_t head;   /* Most recently seen */
+    uint16_t tail;   /* Least recently seen */
+    uint16_t used;
+    uint32_t evictions;
+    uint32_t Bucket( uint32_t hash );
+    void Unlink( uint16_t idx );
+    void PushFront( uint16_t idx );
+    void RemoveFromBucket( uint16_t idx );
+    uint16_t Find( const ntp_addr_t* client, uint32_t hash );
+};
+
+#endif
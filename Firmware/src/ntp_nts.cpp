@@ -0,0 +1,397 @@
+#include <string.h>
+#include "ntp_nts.h"
+
+#ifdef ARDUINO
+ #include "Arduino.h"
+#else
+ #include <sys/random.h>
+#endif
+
+/* Type, length, nonce length, ciphertext length, nonce and tag of the authenticator we send */
+#define NTP_NTS_AUTH_HEADER_LEN ( 8 + NTP_NTS_NONCE_LEN + NTP_SIV_TAG_LEN )
+
+/* A cookie with its field header */
+#define NTP_NTS_COOKIE_EF_LEN ( 4 + NTP_NTS_COOKIE_LEN )
+
+static uint16_t ntp_nts_get16( const uint8_t* p ){
+  return ( (uint16_t)p[0] << 8 ) | p[1];
+}
+
+static void ntp_nts_put16( uint8_t* p, uint16_t v ){
+  p[0] = v >> 8;
+  p[1] = v;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_nts_random
+ *    Description   : Fills a buffer with random bytes
+ *    Input         : uint8_t* out, uint16_t len
+ *    Output        : none
+ *    Remarks       : The hardware RNG is only truly random with the radio running
+ **************************************************************************************************/
+static void ntp_nts_random( uint8_t* out, uint16_t len ){
+#ifdef ARDUINO
+  while(len > 0){
+    uint32_t r = esp_random();
+    uint8_t take = ( len > 4 ) ? 4 : len;
+    memcpy(out, &r, take);
+    out += take;
+    len -= take;
+  }
+#else
+  while(len > 0){
+    ssize_t got = getrandom(out, len, 0);
+    if(got <= 0){
+      continue;
+    }
+    out += got;
+    len -= got;
+  }
+#endif
+}
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_NTS
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_NTS::NTP_NTS( ){
+  memset(master, 0, sizeof(master));
+  memset(master_id, 0, sizeof(master_id));
+  memset(&session, 0, sizeof(session));
+  enabled = false;
+}
+
+/**************************************************************************************************
+ *    Function      : Destructor
+ *    Class         : NTP_NTS
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_NTS::~NTP_NTS( ){
+  Free();
+}
+
+/**************************************************************************************************
+ *    Function      : GetDefaultConfig
+ *    Class         : NTP_NTS
+ *    Description   : Returns a disabled config with a random master key
+ *    Input         : none
+ *    Output        : nts_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+nts_settings_t NTP_NTS::GetDefaultConfig( void ){
+  nts_settings_t conf;
+  memset(&conf, 0, sizeof(conf));
+  NewKey(&conf);
+  conf.prev_keyid = 0;
+  memset(conf.prev_key, 0, sizeof(conf.prev_key));
+  return conf;
+}
+
+/**************************************************************************************************
+ *    Function      : NewKey
+ *    Class         : NTP_NTS
+ *    Description   : Creates a new master key, the current one becomes the previous one
+ *    Input         : nts_settings_t* conf
+ *    Output        : none
+ *    Remarks       : Cookies of the key before the previous one are no longer accepted
+ **************************************************************************************************/
+void NTP_NTS::NewKey( nts_settings_t* conf ){
+  conf->prev_keyid = conf->keyid;
+  memcpy(conf->prev_key, conf->key, sizeof(conf->prev_key));
+  if(conf->keyid == 0){
+    ntp_nts_random((uint8_t*)&conf->keyid, sizeof(conf->keyid));
+  }
+  conf->keyid++;
+  if(conf->keyid == 0){
+    conf->keyid = 1;
+  }
+  ntp_nts_random(conf->key, sizeof(conf->key));
+}
+
+/**************************************************************************************************
+ *    Function      : Free
+ *    Class         : NTP_NTS
+ *    Description   : Releases the master keys
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_NTS::Free( void ){
+  for(uint8_t i=0;i<2;i++){
+    if(master_id[i] != 0){
+      ntp_siv_free(&master[i]);
+    }
+    master_id[i] = 0;
+  }
+  enabled = false;
+}
+
+/**************************************************************************************************
+ *    Function      : Load
+ *    Class         : NTP_NTS
+ *    Description   : Replaces the master keys and prepares them for use
+ *    Input         : const nts_settings_t* conf
+ *    Output        : none
+ *    Remarks       : Key id 0 marks an unused key
+ **************************************************************************************************/
+void NTP_NTS::Load( const nts_settings_t* conf ){
+  Free();
+  if(conf->keyid != 0){
+    ntp_siv_setkey(&master[0], conf->key);
+    master_id[0] = conf->keyid;
+  }
+  if( (conf->prev_keyid != 0) && (conf->prev_keyid != conf->keyid) ){
+    ntp_siv_setkey(&master[1], conf->prev_key);
+    master_id[1] = conf->prev_keyid;
+  }
+  /* Without NTS-KE the keys are loaded for a later build but not used */
+  enabled = ( (NTP_NTS_EXPERIMENTAL != 0) && conf->enabled && (master_id[0] != 0) );
+}
+
+/**************************************************************************************************
+ *    Function      : IsEnabled
+ *    Class         : NTP_NTS
+ *    Description   : Returns if NTS requests are answered
+ *    Input         : none
+ *    Output        : bool
+ *    Remarks       : Always false unless built with NTP_NTS_EXPERIMENTAL
+ **************************************************************************************************/
+bool NTP_NTS::IsEnabled( void ){
+  return enabled;
+}
+
+/**************************************************************************************************
+ *    Function      : OpenCookie
+ *    Class         : NTP_NTS
+ *    Description   : Decrypts a cookie and takes the keys of the client from it
+ *    Input         : const uint8_t* cookie, ntp_nts_request_t* req
+ *    Output        : bool ( false if the cookie is not one of ours )
+ *    Remarks       : The key id is authenticated as associated data
+ **************************************************************************************************/
+bool NTP_NTS::OpenCookie( const uint8_t* cookie, ntp_nts_request_t* req ){
+  uint8_t plain[NTP_NTS_COOKIE_PLAIN_LEN];
+  uint32_t id = ( (uint32_t)cookie[0] << 24 ) | ( (uint32_t)cookie[1] << 16 ) | ( (uint32_t)cookie[2] << 8 ) | cookie[3];
+  int8_t slot = -1;
+  for(uint8_t i=0;i<2;i++){
+    if( (master_id[i] != 0) && (master_id[i] == id) ){
+      slot = i;
+    }
+  }
+  if(slot < 0){
+    return false;
+  }
+  memcpy(plain, &cookie[4 + NTP_NTS_NONCE_LEN + NTP_SIV_TAG_LEN], sizeof(plain));
+  if( false == ntp_siv_decrypt(&master[slot], cookie, 4, &cookie[4], NTP_NTS_NONCE_LEN, plain, sizeof(plain), &cookie[4 + NTP_NTS_NONCE_LEN]) ){
+    return false;
+  }
+  if(ntp_nts_get16(plain) != NTP_NTS_AEAD_AES_SIV_CMAC_256){
+    return false;
+  }
+  memcpy(req->c2s, &plain[4], NTP_SIV_KEY_LEN);
+  memcpy(req->s2c, &plain[4 + NTP_SIV_KEY_LEN], NTP_SIV_KEY_LEN);
+  memset(plain, 0, sizeof(plain));
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : MakeCookie
+ *    Class         : NTP_NTS
+ *    Description   : Encrypts the keys of the client into a new cookie
+ *    Input         : const ntp_nts_request_t* req, uint8_t* cookie
+ *    Output        : none
+ *    Remarks       : The cookie is NTP_NTS_COOKIE_LEN bytes, made with the current master key
+ **************************************************************************************************/
+void NTP_NTS::MakeCookie( const ntp_nts_request_t* req, uint8_t* cookie ){
+  uint8_t* plain = &cookie[4 + NTP_NTS_NONCE_LEN + NTP_SIV_TAG_LEN];
+  cookie[0] = master_id[0] >> 24;
+  cookie[1] = master_id[0] >> 16;
+  cookie[2] = master_id[0] >> 8;
+  cookie[3] = master_id[0];
+  ntp_nts_random(&cookie[4], NTP_NTS_NONCE_LEN);
+  ntp_nts_put16(plain, NTP_NTS_AEAD_AES_SIV_CMAC_256);
+  ntp_nts_put16(&plain[2], 0);
+  memcpy(&plain[4], req->c2s, NTP_SIV_KEY_LEN);
+  memcpy(&plain[4 + NTP_SIV_KEY_LEN], req->s2c, NTP_SIV_KEY_LEN);
+  ntp_siv_encrypt(&master[0], cookie, 4, &cookie[4], NTP_NTS_NONCE_LEN, plain, NTP_NTS_COOKIE_PLAIN_LEN, &cookie[4 + NTP_NTS_NONCE_LEN]);
+}
+
+/**************************************************************************************************
+ *    Function      : Verify
+ *    Class         : NTP_NTS
+ *    Description   : Checks the cookie and the authenticator of a request
+ *    Input         : const uint8_t* data, uint16_t len, const ntp_packet_info_t* info,
+ *                    ntp_nts_request_t* req, uint8_t* scratch
+ *    Output        : ntp_nts_result_t
+ *    Remarks       : scratch needs room for len bytes, the encrypted fields of the client land there
+ **************************************************************************************************/
+ntp_nts_result_t NTP_NTS::Verify( const uint8_t* data, uint16_t len, const ntp_packet_info_t* info, ntp_nts_request_t* req, uint8_t* scratch ){
+  const uint8_t* cookie = NULL;
+  uint16_t cookie_len = 0;
+  uint16_t auth = 0;
+  uint16_t auth_len = 0;
+  uint8_t placeholders = 0;
+  bool nts = false;
+  uint16_t pos = NTP_HEADER_LEN;
+  uint16_t end = NTP_HEADER_LEN + info->ext_len;
+
+  memset(req, 0, sizeof(ntp_nts_request_t));
+  /* ntp_parse_packet has checked the field lengths already, a caller passing other info must not make us read past data */
+  if(end > len){
+    return NTP_NTS_DROP;
+  }
+  while(pos < end){
+    uint16_t type = ntp_nts_get16(&data[pos]);
+    uint16_t field_len = ntp_nts_get16(&data[pos+2]);
+    if( (field_len < 4) || ( ( pos + field_len ) > end ) ){
+      return NTP_NTS_DROP;
+    }
+    switch(type){
+      case NTP_NTS_EF_UID:{
+        if(req->uid_len != 0){
+          return NTP_NTS_DROP;
+        }
+        req->uid_offset = pos;
+        req->uid_len = field_len;
+        nts = true;
+      } break;
+
+      case NTP_NTS_EF_COOKIE:{
+        if(cookie != NULL){
+          return NTP_NTS_DROP;
+        }
+        cookie = &data[pos+4];
+        cookie_len = field_len - 4;
+        nts = true;
+      } break;
+
+      case NTP_NTS_EF_PLACEHOLDER:{
+        /* Only placeholders as long as a cookie keep the response from growing */
+        if( (field_len == NTP_NTS_COOKIE_EF_LEN) && (placeholders < ( NTP_NTS_COOKIES_MAX - 1 ) ) ){
+          placeholders++;
+        }
+        nts = true;
+      } break;
+
+      case NTP_NTS_EF_AUTH:{
+        /* Anything behind the authenticator would not be authenticated */
+        if( (pos + field_len) != end ){
+          return NTP_NTS_DROP;
+        }
+        auth = pos;
+        auth_len = field_len;
+        nts = true;
+      } break;
+
+      default:{
+      } break;
+    }
+    pos += field_len;
+  }
+
+  if( (false == nts) || (false == enabled) ){
+    return NTP_NTS_NONE;
+  }
+  if( (info->mac_len > 0) || (req->uid_len < ( 4 + NTP_NTS_UID_MIN_LEN ) ) || (cookie == NULL) || (auth == 0) ){
+    return NTP_NTS_DROP;
+  }
+  if( (cookie_len != NTP_NTS_COOKIE_LEN) || (false == OpenCookie(cookie, req)) ){
+    return NTP_NTS_NAK;
+  }
+
+  /* Nonce and ciphertext are each padded to a word */
+  const uint8_t* body = &data[auth+4];
+  uint16_t nonce_len = ntp_nts_get16(body);
+  uint16_t ct_len = ntp_nts_get16(&body[2]);
+  uint16_t nonce_pad = ( nonce_len + 3 ) & ~3;
+  uint16_t ct_pad = ( ct_len + 3 ) & ~3;
+  if( (nonce_len < NTP_NTS_NONCE_LEN) || (ct_len < NTP_SIV_TAG_LEN) || ( ( 8 + nonce_pad + ct_pad ) > auth_len ) ){
+    return NTP_NTS_NAK;
+  }
+  const uint8_t* ct = &body[4 + nonce_pad];
+  uint16_t plain_len = ct_len - NTP_SIV_TAG_LEN;
+  memcpy(scratch, &ct[NTP_SIV_TAG_LEN], plain_len);
+  ntp_siv_setkey(&session, req->c2s);
+  bool valid = ntp_siv_decrypt(&session, data, auth, &body[4], nonce_len, scratch, plain_len, ct);
+  ntp_siv_free(&session);
+  if(false == valid){
+    return NTP_NTS_NAK;
+  }
+  /* The encrypted fields of the client carry nothing we act on */
+  req->cookies = 1 + placeholders;
+  return NTP_NTS_OK;
+}
+
+/**************************************************************************************************
+ *    Function      : Prepare
+ *    Class         : NTP_NTS
+ *    Description   : Writes the extension fields of the response behind its header
+ *    Input         : ntp_nts_request_t* req, const uint8_t* data, uint16_t len, uint8_t* out
+ *    Output        : uint16_t ( length of the response )
+ *    Remarks       : The new cookies are made here, before the transmit timestamp is taken.
+ *                    The response is never longer than the request
+ **************************************************************************************************/
+uint16_t NTP_NTS::Prepare( ntp_nts_request_t* req, const uint8_t* data, uint16_t len, uint8_t* out ){
+  uint16_t pos = NTP_HEADER_LEN;
+  memcpy(&out[pos], &data[req->uid_offset], req->uid_len);
+  pos += req->uid_len;
+
+  uint16_t fixed = pos + NTP_NTS_AUTH_HEADER_LEN;
+  while( (req->cookies > 1) && ( ( fixed + ( req->cookies * NTP_NTS_COOKIE_EF_LEN ) ) > len ) ){
+    req->cookies--;
+  }
+  req->auth_offset = pos;
+  req->plain_len = req->cookies * NTP_NTS_COOKIE_EF_LEN;
+
+  ntp_nts_put16(&out[pos], NTP_NTS_EF_AUTH);
+  ntp_nts_put16(&out[pos+2], NTP_NTS_AUTH_HEADER_LEN + req->plain_len);
+  ntp_nts_put16(&out[pos+4], NTP_NTS_NONCE_LEN);
+  ntp_nts_put16(&out[pos+6], NTP_SIV_TAG_LEN + req->plain_len);
+  ntp_nts_random(&out[pos+8], NTP_NTS_NONCE_LEN);
+
+  uint8_t* plain = &out[fixed];
+  for(uint8_t i=0;i<req->cookies;i++){
+    ntp_nts_put16(plain, NTP_NTS_EF_COOKIE);
+    ntp_nts_put16(&plain[2], NTP_NTS_COOKIE_EF_LEN);
+    MakeCookie(req, &plain[4]);
+    plain += NTP_NTS_COOKIE_EF_LEN;
+  }
+  return fixed + req->plain_len;
+}
+
+/**************************************************************************************************
+ *    Function      : Seal
+ *    Class         : NTP_NTS
+ *    Description   : Encrypts the cookies and authenticates the response
+ *    Input         : ntp_nts_request_t* req, uint8_t* out
+ *    Output        : none
+ *    Remarks       : Call it once the header with the transmit timestamp is in out
+ **************************************************************************************************/
+void NTP_NTS::Seal( ntp_nts_request_t* req, uint8_t* out ){
+  uint8_t* nonce = &out[req->auth_offset + 8];
+  uint8_t* tag = &nonce[NTP_NTS_NONCE_LEN];
+  ntp_siv_setkey(&session, req->s2c);
+  ntp_siv_encrypt(&session, out, req->auth_offset, nonce, NTP_NTS_NONCE_LEN, &tag[NTP_SIV_TAG_LEN], req->plain_len, tag);
+  ntp_siv_free(&session);
+  memset(req->c2s, 0, sizeof(req->c2s));
+  memset(req->s2c, 0, sizeof(req->s2c));
+}
+
+/**************************************************************************************************
+ *    Function      : Nak
+ *    Class         : NTP_NTS
+ *    Description   : Adds the unique identifier to a NTSN Kiss-o'-Death
+ *    Input         : const ntp_nts_request_t* req, const uint8_t* data, uint8_t* out
+ *    Output        : uint16_t ( length of the response )
+ *    Remarks       : The header needs to be in out already
+ **************************************************************************************************/
+uint16_t NTP_NTS::Nak( const ntp_nts_request_t* req, const uint8_t* data, uint8_t* out ){
+  memcpy(&out[NTP_HEADER_LEN], &data[req->uid_offset], req->uid_len);
+  return NTP_HEADER_LEN + req->uid_len;
+}
@@ -0,0 +1,188 @@
+#ifndef NTP_NTS_H_
+ #define NTP_NTS_H_
+
+#include <stdint.h>
+#include "ntp_packet.h"
+#include "ntp_aes_siv.h"
+
+/* NTS-KE on TCP/4460 is not part of the firmware, it needs a TLS 1.3 server. The cookies have to
+   come from an external NTS-KE server, see NTP_NTS. Until then NTS requests are only answered in
+   builds with NTP_NTS_EXPERIMENTAL set to 1, in others they are treated as plain requests */
+#ifndef NTP_NTS_EXPERIMENTAL
+ #define NTP_NTS_EXPERIMENTAL ( 0 )
+#endif
+
+/* Extension field types of RFC 8915 */
+#define NTP_NTS_EF_UID ( 0x0104 )
+#define NTP_NTS_EF_COOKIE ( 0x0204 )
+#define NTP_NTS_EF_PLACEHOLDER ( 0x0304 )
+#define NTP_NTS_EF_AUTH ( 0x0404 )
+
+/* The only AEAD we support, AEAD_AES_SIV_CMAC_256 */
+#define NTP_NTS_AEAD_AES_SIV_CMAC_256 ( 15 )
+
+/* The unique identifier needs at least 32 bytes of random data */
+#define NTP_NTS_UID_MIN_LEN ( 32 )
+
+/* Length of the nonces we create and the shortest one we accept */
+#define NTP_NTS_NONCE_LEN ( 16 )
+
+/* Plaintext of a cookie, AEAD id, reserved, C2S and S2C key */
+#define NTP_NTS_COOKIE_PLAIN_LEN ( 4 + ( 2 * NTP_SIV_KEY_LEN ) )
+
+/* A cookie is the master key id, nonce, tag and the encrypted plaintext */
+#define NTP_NTS_COOKIE_LEN ( 4 + NTP_NTS_NONCE_LEN + NTP_SIV_TAG_LEN + NTP_NTS_COOKIE_PLAIN_LEN )
+
+/* Cookies handed out with one response, the one used and up to seven placeholders */
+#define NTP_NTS_COOKIES_MAX ( 8 )
+
+/* Master keys the cookies are made with, stored with the config */
+typedef struct {
+  uint32_t keyid;                     /* Cookies are made with this key */
+  uint32_t prev_keyid;                /* Cookies of the previous key are still accepted, 0 for none */
+  uint8_t key[NTP_SIV_KEY_LEN];
+  uint8_t prev_key[NTP_SIV_KEY_LEN];
+  bool enabled;
+} nts_settings_t;
+
+typedef enum {
+  NTP_NTS_NONE = 0,     /* No NTS extension fields, a plain request */
+  NTP_NTS_OK,           /* Cookie and authenticator are valid */
+  NTP_NTS_NAK,          /* Answer with a NTSN Kiss-o'-Death */
+  NTP_NTS_DROP          /* Malformed, don't answer */
+} ntp_nts_result_t;
+
+/* What we need to know about a request to answer it */
+typedef struct {
+  uint16_t uid_offset;                /* Unique identifier field, echoed with the response */
+  uint16_t uid_len;
+  uint16_t auth_offset;               /* Authenticator of the response, set by Prepare */
+  uint16_t plain_len;                 /* Cookie fields in the response, set by Prepare */
+  uint8_t cookies;                    /* New cookies the client asked for */
+  uint8_t c2s[NTP_SIV_KEY_LEN];
+  uint8_t s2c[NTP_SIV_KEY_LEN];
+} ntp_nts_request_t;
+
+/*
+ * Network Time Security for NTP of RFC 8915. The keys of a client are
+ * carried in its cookies, encrypted with a master key, so no state is
+ * kept per client.
+ *
+ * An external NTS-KE server hands out cookies for us if it shares the master
+ * key and its id, set through /ntp/nts:
+ *  - It negotiates NTPv4 ( protocol 0 ) and AEAD_AES_SIV_CMAC_256 ( 15 ) and
+ *    points the client at our address with the NTPv4 Server and Port records.
+ *  - C2S and S2C are exported from the TLS session with the label
+ *    "EXPORTER-network-time-security", 32 bytes each, with the context
+ *    00 00 00 0F 00 for C2S and 00 00 00 0F 01 for S2C, RFC 8915 5.1.
+ *  - A cookie is NTP_NTS_COOKIE_LEN ( 104 ) bytes: the master key id as 4 bytes
+ *    big endian, a 16 byte random nonce, the 16 byte SIV tag and the 68 bytes
+ *    of ciphertext, RFC 5297 SIV || C.
+ *  - The plaintext is the AEAD id 00 0F, two zero bytes, C2S and S2C.
+ *  - It is encrypted with AES-SIV-CMAC-256 under the 32 byte master key, the
+ *    S2V inputs are the 4 bytes of the key id as associated data and the nonce.
+ * Cookies of the current and the previous master key are accepted, a new key
+ * set on one side needs to be set on the other before the old one is dropped.
+ */
+class NTP_NTS {
+
+public:
+    NTP_NTS( );
+    ~NTP_NTS( );
+
+    /**************************************************************************************************
+     *    Function      : Load
+     *    Class         : NTP_NTS
+     *    Description   : Replaces the master keys and prepares them for use
+     *    Input         : const nts_settings_t* conf
+     *    Output        : none
+     *    Remarks       : Key id 0 marks an unused key
+     **************************************************************************************************/
+    void Load( const nts_settings_t* conf );
+
+    /**************************************************************************************************
+     *    Function      : Verify
+     *    Class         : NTP_NTS
+     *    Description   : Checks the cookie and the authenticator of a request
+     *    Input         : const uint8_t* data, uint16_t len, const ntp_packet_info_t* info,
+     *                    ntp_nts_request_t* req, uint8_t* scratch
+     *    Output        : ntp_nts_result_t
+     *    Remarks       : scratch needs room for len bytes, the encrypted fields of the client land there
+     **************************************************************************************************/
+    ntp_nts_result_t Verify( const uint8_t* data, uint16_t len, const ntp_packet_info_t* info, ntp_nts_request_t* req, uint8_t* scratch );
+
+    /**************************************************************************************************
+     *    Function      : Prepare
+     *    Class         : NTP_NTS
+     *    Description   : Writes the extension fields of the response behind its header
+     *    Input         : ntp_nts_request_t* req, const uint8_t* data, uint16_t len, uint8_t* out
+     *    Output        : uint16_t ( length of the response )
+     *    Remarks       : The new cookies are made here, before the transmit timestamp is taken.
+     *                    The response is never longer than the request
+     **************************************************************************************************/
+    uint16_t Prepare( ntp_nts_request_t* req, const uint8_t* data, uint16_t len, uint8_t* out );
+
+    /**************************************************************************************************
+     *    Function      : Seal
+     *    Class         : NTP_NTS
+     *    Description   : Encrypts the cookies and authenticates the response
+     *    Input         : ntp_nts_request_t* req, uint8_t* out
+     *    Output        : none
+     *    Remarks       : Call it once the header with the transmit timestamp is in out
+     **************************************************************************************************/
+    void Seal( ntp_nts_request_t* req, uint8_t* out );
+
+    /**************************************************************************************************
+     *    Function      : Nak
+     *    Class         : NTP_NTS
+     *    Description   : Adds the unique identifier to a NTSN Kiss-o'-Death
+     *    Input         : const ntp_nts_request_t* req, const uint8_t* data, uint8_t* out
+     *    Output        : uint16_t ( length of the response )
+     *    Remarks       : The header needs to be in out already
+     **************************************************************************************************/
+    uint16_t Nak( const ntp_nts_request_t* req, const uint8_t* data, uint8_t* out );
+
+    /**************************************************************************************************
+     *    Function      : IsEnabled
+     *    Class         : NTP_NTS
+     *    Description   : Returns if NTS requests are answered
+     *    Input         : none
+     *    Output        : bool
+     *    Remarks       : Always false unless built with NTP_NTS_EXPERIMENTAL
+     **************************************************************************************************/
+    bool IsEnabled( void );
+
+    /**************************************************************************************************
+     *    Function      : NewKey
+     *    Class         : NTP_NTS
+     *    Description   : Creates a new master key, the current one becomes the previous one
+     *    Input         : nts_settings_t* conf
+     *    Output        : none
+     *    Remarks       : Cookies of the key before the previous one are no longer accepted
+     **************************************************************************************************/
+    static void NewKey( nts_settings_t* conf );
+
+    /**************************************************************************************************
+     *    Function      : GetDefaultConfig
+     *    Class         : NTP_NTS
+     *    Description   : Returns a disabled config with a random master key
+     *    Input         : none
+     *    Output        : nts_settings_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    static nts_settings_t GetDefaultConfig( void );
+
+private:
+    ntp_siv_key_t master[2];          /* Current and previous master key */
+    uint32_t master_id[2];
+    bool enabled;
+
+    /* Keys of the request in work, only used from the task the requests come in */
+    ntp_siv_key_t session;
+
+    void Free( void );
+    bool OpenCookie( const uint8_t* cookie, ntp_nts_request_t* req );
+    void MakeCookie( const ntp_nts_request_t* req, uint8_t* cookie );
+};
+
+#endif
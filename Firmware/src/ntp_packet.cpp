@@ -0,0 +1,150 @@
+#include <string.h>
+#include "ntp_packet.h"
+
+#ifdef ARDUINO
+ #include <lwip/def.h>
+#else
+ #include <arpa/inet.h>
+#endif
+
+/**************************************************************************************************
+ *    Function      : ntp_put_time64
+ *    Description   : Writes a 32.32 time into a timestamp field in network byte order
+ *    Input         : uint32_t* s, uint32_t* f, ntp_time64_t t
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+static inline void ntp_put_time64( uint32_t* s, uint32_t* f, ntp_time64_t t ){
+  *s = htonl( ntp_time64_seconds(t) );
+  *f = htonl( ntp_time64_fraction(t) );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_parse_packet
+ *    Description   : Walks the extension fields and finds the MAC of a packet
+ *    Input         : const uint8_t* data, uint16_t len, ntp_packet_info_t* info
+ *    Output        : bool ( false if the packet is malformed )
+ *    Remarks       : Follows RFC 7822, the contents of the extension fields are not checked
+ **************************************************************************************************/
+bool ntp_parse_packet( const uint8_t* data, uint16_t len, ntp_packet_info_t* info ){
+  uint16_t pos = NTP_HEADER_LEN;
+  memset(info, 0, sizeof(ntp_packet_info_t));
+  if( (len < NTP_HEADER_LEN) || ( (len % 4) != 0 ) ){
+    return false;
+  }
+  while(pos < len){
+    uint16_t remaining = len - pos;
+    /* Whatever is left and fits a MAC is one, an extension field can't be the last one with this size */
+    if( (remaining == NTP_MAC_MIN_LEN) || (remaining == NTP_MAC_MAX_LEN) ){
+      info->mac_offset = pos;
+      info->mac_len = remaining;
+      info->keyid = ( (uint32_t)data[pos] << 24 ) | ( (uint32_t)data[pos+1] << 16 ) | ( (uint32_t)data[pos+2] << 8 ) | data[pos+3];
+      return true;
+    }
+    if(remaining < NTP_EXTENSION_MIN_LEN){
+      return false;
+    }
+    uint16_t field_len = ( (uint16_t)data[pos+2] << 8 ) | data[pos+3];
+    if( (field_len < NTP_EXTENSION_MIN_LEN) || ( (field_len % 4) != 0 ) || (field_len > remaining) ){
+      return false;
+    }
+    pos += field_len;
+    info->ext_len += field_len;
+  }
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_build_template
+ *    Description   : Encodes the server state into a response in network byte order
+ *    Input         : ntp_packet_t* tpl, const ntp_server_state_t* state
+ *    Output        : none
+ *    Remarks       : Only needs to be called if the server state changes
+ **************************************************************************************************/
+void ntp_build_template( ntp_packet_t* tpl, const ntp_server_state_t* state ){
+  memset(tpl, 0, sizeof(ntp_packet_t));
+  tpl->flags.li = state->leap;
+  tpl->flags.vn = 4;   // NTP Version 4
+  tpl->flags.mode = 4; // Server
+  tpl->stratum = state->stratum;
+  tpl->precision = (uint8_t)state->precision;
+  tpl->rootDelay = htonl( state->rootDelay );
+  tpl->rootDispersion = htonl( state->rootDispersion );
+  memcpy(tpl->refId.c_str, state->refid, sizeof(tpl->refId.c_str));
+  ntp_put_time64(&tpl->refTm_s, &tpl->refTm_f, state->reference);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_build_response
+ *    Description   : Builds the response for a request from the template
+ *    Input         : ntp_packet_t* resp, const ntp_packet_t* tpl, const ntp_packet_t* req, ntp_time64_t rx
+ *    Output        : none
+ *    Remarks       : The transmit timestamp needs to be set with ntp_stamp_transmit
+ **************************************************************************************************/
+void ntp_build_response( ntp_packet_t* resp, const ntp_packet_t* tpl, const ntp_packet_t* req, ntp_time64_t rx ){
+  memcpy(resp, tpl, sizeof(ntp_packet_t));
+  /* We don't touch the poll interval */
+  resp->poll = req->poll;
+  /* The client transmit timestamp is returned as originate timestamp, no need to swap it */
+  resp->origTm_s = req->txTm_s;
+  resp->origTm_f = req->txTm_f;
+  ntp_put_time64(&resp->rxTm_s, &resp->rxTm_f, rx);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_build_interleaved_response
+ *    Description   : Builds an interleaved mode response for a request from the template
+ *    Input         : ntp_packet_t* resp, const ntp_packet_t* tpl, const ntp_packet_t* req, 
+ *                    ntp_time64_t rx, ntp_time64_t prev_tx
+ *    Output        : none
+ *    Remarks       : prev_tx is the real transmit time of the previous response to this client
+ **************************************************************************************************/
+void ntp_build_interleaved_response( ntp_packet_t* resp, const ntp_packet_t* tpl, const ntp_packet_t* req, ntp_time64_t rx, ntp_time64_t prev_tx ){
+  memcpy(resp, tpl, sizeof(ntp_packet_t));
+  resp->poll = req->poll;
+  /* The client receive timestamp is returned as origin, this marks the response as interleaved */
+  resp->origTm_s = req->rxTm_s;
+  resp->origTm_f = req->rxTm_f;
+  ntp_put_time64(&resp->rxTm_s, &resp->rxTm_f, rx);
+  ntp_put_time64(&resp->txTm_s, &resp->txTm_f, prev_tx);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_build_kod
+ *    Description   : Builds a Kiss-o'-Death response for a request
+ *    Input         : ntp_packet_t* resp, const ntp_packet_t* tpl, const ntp_packet_t* req, 
+ *                    ntp_time64_t rx, const char* code
+ *    Output        : none
+ *    Remarks       : code is the four character kiss code, e.g. RATE
+ **************************************************************************************************/
+void ntp_build_kod( ntp_packet_t* resp, const ntp_packet_t* tpl, const ntp_packet_t* req, ntp_time64_t rx, const char* code ){
+  ntp_build_response(resp, tpl, req, rx);
+  /* Unsynchronized with stratum 0 so the client can't use the time */
+  resp->flags.li = 3;
+  resp->stratum = 0;
+  memcpy(resp->refId.c_str, code, sizeof(resp->refId.c_str));
+  resp->txTm_s = resp->rxTm_s;
+  resp->txTm_f = resp->rxTm_f;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_stamp_transmit
+ *    Description   : Writes the transmit timestamp into a response
+ *    Input         : ntp_packet_t* resp, ntp_time64_t tx
+ *    Output        : none
+ *    Remarks       : Call this as late as possible before the packet is sent
+ **************************************************************************************************/
+void ntp_stamp_transmit( ntp_packet_t* resp, ntp_time64_t tx ){
+  ntp_put_time64(&resp->txTm_s, &resp->txTm_f, tx);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_read_transmit
+ *    Description   : Reads the transmit timestamp of a packet
+ *    Input         : const ntp_packet_t* pkt
+ *    Output        : ntp_time64_t
+ *    Remarks       : In host order
+ **************************************************************************************************/
+ntp_time64_t ntp_read_transmit( const ntp_packet_t* pkt ){
+  return ntp_time64_make( ntohl( pkt->txTm_s ), ntohl( pkt->txTm_f ) );
+}
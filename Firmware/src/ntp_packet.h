@@ -0,0 +1,151 @@
+#ifndef NTP_PACKET_H_
+ #define NTP_PACKET_H_
+
+#include <stdint.h>
+#include "ntp_timestamp.h"
+
+/* Length of the fixed header, extension fields and the MAC follow it */
+#define NTP_HEADER_LEN ( 48 )
+
+/* Extension fields are at least 16 bytes, RFC 7822 */
+#define NTP_EXTENSION_MIN_LEN ( 16 )
+
+/* Key id and digest of a MAC, the digest is 16 or 20 bytes */
+#define NTP_MAC_MIN_LEN ( 20 )
+#define NTP_MAC_MAX_LEN ( 24 )
+
+/* A crypto-NAK is a MAC with key id 0 and no digest */
+#define NTP_CRYPTO_NAK_LEN ( 4 )
+
+/* Largest response we send, a header with a MAC */
+#define NTP_RESPONSE_MAX_LEN ( NTP_HEADER_LEN + NTP_MAC_MAX_LEN )
+
+/* Largest request we answer, NTS requests carry cookies and placeholders */
+#ifndef NTP_PACKET_MAX_LEN
+ #define NTP_PACKET_MAX_LEN ( 1024 )
+#endif
+
+typedef struct{
+    uint8_t mode:3;               // mode. Three bits. Client will pick mode 3 for client.
+    uint8_t vn:3;                 // vn.   Three bits. Version number of the protocol.
+    uint8_t li:2;                 // li.   Two bits.   Leap indicator.
+}ntp_flags_t;
+  
+typedef union {
+    uint32_t data;
+    uint8_t byte[4];
+    char c_str[4];
+} refID_t;
+
+typedef struct
+{
+
+  ntp_flags_t flags;
+  uint8_t stratum;         // Eight bits. Stratum level of the local clock.
+  uint8_t poll;            // Eight bits. Maximum interval between successive messages.
+  uint8_t precision;       // Eight bits. Precision of the local clock.
+
+  uint32_t rootDelay;      // 32 bits. Total round trip delay time.
+  uint32_t rootDispersion; // 32 bits. Max error aloud from primary clock source.
+  refID_t refId;           // 32 bits. Reference clock identifier.
+   
+
+  uint32_t refTm_s;        // 32 bits. Reference time-stamp seconds.
+  uint32_t refTm_f;        // 32 bits. Reference time-stamp fraction of a second.
+
+  uint32_t origTm_s;       // 32 bits. Originate time-stamp seconds.
+  uint32_t origTm_f;       // 32 bits. Originate time-stamp fraction of a second.
+
+  uint32_t rxTm_s;         // 32 bits. Received time-stamp seconds.
+  uint32_t rxTm_f;         // 32 bits. Received time-stamp fraction of a second.
+
+  uint32_t txTm_s;         // 32 bits and the most important field the client cares about. Transmit time-stamp seconds.
+  uint32_t txTm_f;         // 32 bits. Transmit time-stamp fraction of a second.
+
+} ntp_packet_t;    
+
+/* Layout of a request behind the fixed header */
+typedef struct {
+  uint16_t ext_len;        // Bytes of extension fields, they start right after the header.
+  uint16_t mac_offset;     // Offset of the MAC, only valid if mac_len is not 0.
+  uint16_t mac_len;        // Key id and digest.
+  uint32_t keyid;          // Host byte order.
+} ntp_packet_info_t;
+
+/* Everything in the response header that does not depend on the request */
+typedef struct {
+  uint8_t leap;              // Leap indicator.
+  uint8_t stratum;           // Stratum level of the local clock.
+  int8_t precision;          // Precision of the local clock as log2 seconds.
+  char refid[4];             // Reference clock identifier, not terminated.
+  uint32_t rootDelay;        // NTP short format, 16.16 seconds.
+  uint32_t rootDispersion;   // NTP short format, 16.16 seconds.
+  ntp_time64_t reference;    // Time the clock was last set or corrected.
+} ntp_server_state_t;
+
+/**************************************************************************************************
+ *    Function      : ntp_parse_packet
+ *    Description   : Walks the extension fields and finds the MAC of a packet
+ *    Input         : const uint8_t* data, uint16_t len, ntp_packet_info_t* info
+ *    Output        : bool ( false if the packet is malformed )
+ *    Remarks       : Follows RFC 7822, the contents of the extension fields are not checked
+ **************************************************************************************************/
+bool ntp_parse_packet( const uint8_t* data, uint16_t len, ntp_packet_info_t* info );
+
+/**************************************************************************************************
+ *    Function      : ntp_build_template
+ *    Description   : Encodes the server state into a response in network byte order
+ *    Input         : ntp_packet_t* tpl, const ntp_server_state_t* state
+ *    Output        : none
+ *    Remarks       : Only needs to be called if the server state changes
+ **************************************************************************************************/
+void ntp_build_template( ntp_packet_t* tpl, const ntp_server_state_t* state );
+
+/**************************************************************************************************
+ *    Function      : ntp_build_response
+ *    Description   : Builds the response for a request from the template
+ *    Input         : ntp_packet_t* resp, const ntp_packet_t* tpl, const ntp_packet_t* req, ntp_time64_t rx
+ *    Output        : none
+ *    Remarks       : The transmit timestamp needs to be set with ntp_stamp_transmit
+ **************************************************************************************************/
+void ntp_build_response( ntp_packet_t* resp, const ntp_packet_t* tpl, const ntp_packet_t* req, ntp_time64_t rx );
+
+/**************************************************************************************************
+ *    Function      : ntp_build_interleaved_response
+ *    Description   : Builds an interleaved mode response for a request from the template
+ *    Input         : ntp_packet_t* resp, const ntp_packet_t* tpl, const ntp_packet_t* req, 
+ *                    ntp_time64_t rx, ntp_time64_t prev_tx
+ *    Output        : none
+ *    Remarks       : prev_tx is the real transmit time of the previous response to this client
+ **************************************************************************************************/
+void ntp_build_interleaved_response( ntp_packet_t* resp, const ntp_packet_t* tpl, const ntp_packet_t* req, ntp_time64_t rx, ntp_time64_t prev_tx );
+
+/**************************************************************************************************
+ *    Function      : ntp_build_kod
+ *    Description   : Builds a Kiss-o'-Death response for a request
+ *    Input         : ntp_packet_t* resp, const ntp_packet_t* tpl, const ntp_packet_t* req, 
+ *                    ntp_time64_t rx, const char* code
+ *    Output        : none
+ *    Remarks       : code is the four character kiss code, e.g. RATE
+ **************************************************************************************************/
+void ntp_build_kod( ntp_packet_t* resp, const ntp_packet_t* tpl, const ntp_packet_t* req, ntp_time64_t rx, const char* code );
+
+/**************************************************************************************************
+ *    Function      : ntp_stamp_transmit
+ *    Description   : Writes the transmit timestamp into a response
+ *    Input         : ntp_packet_t* resp, ntp_time64_t tx
+ *    Output        : none
+ *    Remarks       : Call this as late as possible before the packet is sent
+ **************************************************************************************************/
+void ntp_stamp_transmit( ntp_packet_t* resp, ntp_time64_t tx );
+
+/**************************************************************************************************
+ *    Function      : ntp_read_transmit
+ *    Description   : Reads the transmit timestamp of a packet
+ *    Input         : const ntp_packet_t* pkt
+ *    Output        : ntp_time64_t
+ *    Remarks       : In host order
+ **************************************************************************************************/
+ntp_time64_t ntp_read_transmit( const ntp_packet_t* pkt );
+
+#endif
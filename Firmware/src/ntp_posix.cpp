@@ -0,0 +1,510 @@
+#include "ntp_posix.h"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/random.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+
+/* Only the error queue entries of the transmit timestamps are of interest */
+#ifndef SO_EE_ORIGIN_TIMESTAMPING
+ #define SO_EE_ORIGIN_TIMESTAMPING ( 4 )
+#endif
+
+#define NTP_POSIX_TSFLAGS ( SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_TX_SOFTWARE | \
+                            SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY )
+
+/* A response that has left, waiting for the kernel to report when */
+typedef struct {
+  ntp_client_t client;
+  ntp_timestamp_t rx;
+  uint32_t key;
+  bool used;
+} ntp_posix_pending_t;
+
+/* Where a mode 6 answer goes, the fragments are sent one by one */
+typedef struct {
+  ntp_posix_shard_t* shard;
+  const struct sockaddr_in6* addr;
+} ntp_posix_control_t;
+
+struct ntp_posix_shard_s {
+  NTP_Responder responder;
+  ntp_timestamp_t(*read_time)(void);
+  int fd;
+  uint8_t cpu;
+  pthread_t thread;
+  volatile bool run;
+  bool tx_stamps;
+  uint32_t tx_key;                    /* Key the kernel gives the next datagram we send */
+  ntp_posix_pending_t pending[NTP_POSIX_TX_PENDING];
+
+  /* Batch buffers, set up once, nothing is allocated per datagram */
+  struct mmsghdr rx_msg[NTP_POSIX_BATCH];
+  struct iovec rx_iov[NTP_POSIX_BATCH];
+  struct sockaddr_in6 rx_addr[NTP_POSIX_BATCH];
+  uint8_t rx_ctrl[NTP_POSIX_BATCH][NTP_POSIX_CTRL_LEN];
+  uint8_t rx_buf[NTP_POSIX_BATCH][NTP_PACKET_MAX_LEN];
+  struct mmsghdr tx_msg[NTP_POSIX_BATCH];
+  struct iovec tx_iov[NTP_POSIX_BATCH];
+  ntp_client_t tx_client[NTP_POSIX_BATCH];
+  ntp_timestamp_t tx_rx[NTP_POSIX_BATCH];
+  uint8_t tx_buf[NTP_POSIX_BATCH][NTP_PACKET_MAX_LEN];
+  struct mmsghdr err_msg[NTP_POSIX_BATCH];
+  uint8_t err_ctrl[NTP_POSIX_BATCH][NTP_POSIX_CTRL_LEN];
+};
+
+/**************************************************************************************************
+ *    Function      : ntp_posix_timestamp
+ *    Description   : Converts a kernel timestamp to NTP format
+ *    Input         : const struct timespec* ts
+ *    Output        : ntp_timestamp_t
+ *    Remarks       : none
+ **************************************************************************************************/
+static ntp_timestamp_t ntp_posix_timestamp( const struct timespec* ts ){
+  ntp_timestamp_t out;
+  out.seconds = (uint32_t)( ts->tv_sec + NTP_TIMESTAMP_DELTA );
+  out.fraction = (uint32_t)( ( (uint64_t)ts->tv_nsec << 32 ) / 1000000000ull );
+  return out;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_posix_find_stamp
+ *    Description   : Finds the software timestamp in the ancillary data of a message
+ *    Input         : struct msghdr* msg, ntp_timestamp_t* out
+ *    Output        : bool
+ *    Remarks       : none
+ **************************************************************************************************/
+static bool ntp_posix_find_stamp( struct msghdr* msg, ntp_timestamp_t* out ){
+  for(struct cmsghdr* c = CMSG_FIRSTHDR(msg); c != NULL; c = CMSG_NXTHDR(msg, c)){
+    if( (c->cmsg_level == SOL_SOCKET) && (c->cmsg_type == SO_TIMESTAMPING) ){
+      struct scm_timestamping ts;
+      memcpy(&ts, CMSG_DATA(c), sizeof(ts));
+      if( (ts.ts[0].tv_sec == 0) && (ts.ts[0].tv_nsec == 0) ){
+        return false;
+      }
+      *out = ntp_posix_timestamp(&ts.ts[0]);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_posix_client
+ *    Description   : Returns the client of a source address
+ *    Input         : const struct sockaddr_in6* addr
+ *    Output        : ntp_client_t
+ *    Remarks       : IPv4 clients arrive as v4 mapped addresses on the dual stack socket
+ **************************************************************************************************/
+static ntp_client_t ntp_posix_client( const struct sockaddr_in6* addr ){
+  if( IN6_IS_ADDR_V4MAPPED(&addr->sin6_addr) ){
+    uint32_t v4;
+    memcpy(&v4, &addr->sin6_addr.s6_addr[12], sizeof(v4));
+    return NTP_Responder::ClientV4(v4);
+  }
+  return NTP_Responder::ClientV6(addr->sin6_addr.s6_addr);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_posix_control_send
+ *    Description   : Sends a mode 6 fragment back to the client
+ *    Input         : void* ctx, const uint8_t* data, uint16_t len
+ *    Output        : bool
+ *    Remarks       : ctx is a ntp_posix_control_t, the fragment takes a transmit timestamp key too
+ **************************************************************************************************/
+static bool ntp_posix_control_send( void* ctx, const uint8_t* data, uint16_t len ){
+  ntp_posix_control_t* c = (ntp_posix_control_t*)ctx;
+  ssize_t sent = sendto(c->shard->fd, data, len, 0, (const struct sockaddr*)c->addr, sizeof(struct sockaddr_in6));
+  if(sent != len){
+    return false;
+  }
+  c->shard->tx_key++;
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_posix_drain_errqueue
+ *    Description   : Reads the transmit timestamps and hands them to the interleave table
+ *    Input         : ntp_posix_shard_t* s
+ *    Output        : none
+ *    Remarks       : Never blocks
+ **************************************************************************************************/
+static void ntp_posix_drain_errqueue( ntp_posix_shard_t* s ){
+  while(1==1){
+    for(uint8_t i=0;i<NTP_POSIX_BATCH;i++){
+      s->err_msg[i].msg_hdr.msg_control = s->err_ctrl[i];
+      s->err_msg[i].msg_hdr.msg_controllen = NTP_POSIX_CTRL_LEN;
+      s->err_msg[i].msg_hdr.msg_flags = 0;
+    }
+    int n = recvmmsg(s->fd, s->err_msg, NTP_POSIX_BATCH, MSG_ERRQUEUE | MSG_DONTWAIT, NULL);
+    if(n <= 0){
+      return;
+    }
+    for(int i=0;i<n;i++){
+      struct msghdr* msg = &s->err_msg[i].msg_hdr;
+      ntp_timestamp_t tx;
+      bool stamped = ntp_posix_find_stamp(msg, &tx);
+      for(struct cmsghdr* c = CMSG_FIRSTHDR(msg); c != NULL; c = CMSG_NXTHDR(msg, c)){
+        if( false == ( ( (c->cmsg_level == SOL_IP) && (c->cmsg_type == IP_RECVERR) ) ||
+                       ( (c->cmsg_level == SOL_IPV6) && (c->cmsg_type == IPV6_RECVERR) ) ) ){
+          continue;
+        }
+        struct sock_extended_err ee;
+        memcpy(&ee, CMSG_DATA(c), sizeof(ee));
+        if( (ee.ee_origin != SO_EE_ORIGIN_TIMESTAMPING) || (false == stamped) ){
+          continue;
+        }
+        ntp_posix_pending_t* p = &s->pending[ee.ee_data & ( NTP_POSIX_TX_PENDING - 1 )];
+        if( (true == p->used) && (p->key == ee.ee_data) ){
+          s->responder.Sent(&p->client, p->rx, tx);
+          p->used = false;
+        }
+      }
+    }
+    if(n < NTP_POSIX_BATCH){
+      return;
+    }
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_posix_shard_loop
+ *    Description   : Receives a batch, answers it and sends the answers with one call
+ *    Input         : void* param
+ *    Output        : void*
+ *    Remarks       : One thread per shard
+ **************************************************************************************************/
+static void* ntp_posix_shard_loop( void* param ){
+  ntp_posix_shard_t* s = (ntp_posix_shard_t*)param;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(s->cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+
+  while(true == s->run){
+    for(uint8_t i=0;i<NTP_POSIX_BATCH;i++){
+      s->rx_msg[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in6);
+      s->rx_msg[i].msg_hdr.msg_controllen = NTP_POSIX_CTRL_LEN;
+      s->rx_msg[i].msg_hdr.msg_flags = 0;
+    }
+    /* Blocks for the first datagram only, takes what else is queued */
+    int n = recvmmsg(s->fd, s->rx_msg, NTP_POSIX_BATCH, MSG_WAITFORONE, NULL);
+    if(n <= 0){
+      continue;
+    }
+    ntp_timestamp_t now = s->read_time();
+    if(true == s->tx_stamps){
+      /* Earlier responses first, so a client that polls again finds its transmit time */
+      ntp_posix_drain_errqueue(s);
+    }
+
+    uint8_t out = 0;
+    for(int i=0;i<n;i++){
+      const uint8_t* data = s->rx_buf[i];
+      uint16_t len = s->rx_msg[i].msg_len;
+      ntp_timestamp_t rx;
+      if( false == ntp_posix_find_stamp(&s->rx_msg[i].msg_hdr, &rx) ){
+        rx = now;
+      }
+      ntp_client_t client = ntp_posix_client(&s->rx_addr[i]);
+      if( true == NTP_ControlResponder::IsControlRequest(data, len) ){
+        ntp_posix_control_t ctx;
+        ctx.shard = s;
+        ctx.addr = &s->rx_addr[i];
+        s->responder.Control(&client, data, len, rx, ntp_posix_control_send, &ctx);
+        continue;
+      }
+      if(len < sizeof(ntp_packet_t)){
+        continue;
+      }
+      /* No advance, clients wanting the kernel transmit time use the interleaved mode */
+      uint16_t resp_len = s->responder.Respond(&client, data, len, s->tx_buf[out], rx, 0);
+      if(resp_len == 0){
+        continue;
+      }
+      s->tx_iov[out].iov_len = resp_len;
+      s->tx_msg[out].msg_hdr.msg_name = &s->rx_addr[i];
+      s->tx_msg[out].msg_hdr.msg_namelen = s->rx_msg[i].msg_hdr.msg_namelen;
+      s->tx_client[out] = client;
+      s->tx_rx[out] = rx;
+      out++;
+    }
+    if(out == 0){
+      continue;
+    }
+
+    int sent = sendmmsg(s->fd, s->tx_msg, out, 0);
+    if(sent < 0){
+      sent = 0;
+    }
+    for(int i=0;i<sent;i++){
+      if(true == s->tx_stamps){
+        ntp_posix_pending_t* p = &s->pending[s->tx_key & ( NTP_POSIX_TX_PENDING - 1 )];
+        p->client = s->tx_client[i];
+        p->rx = s->tx_rx[i];
+        p->key = s->tx_key;
+        p->used = true;
+        s->tx_key++;
+      } else {
+        s->responder.Sent(&s->tx_client[i], s->tx_rx[i], s->read_time());
+      }
+    }
+    for(int i=sent;i<out;i++){
+      s->responder.CountDrop(0);
+    }
+    if(true == s->tx_stamps){
+      ntp_posix_drain_errqueue(s);
+    }
+  }
+  return NULL;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_posix_open
+ *    Description   : Opens and binds the socket of a shard
+ *    Input         : ntp_posix_shard_t* s, uint16_t port
+ *    Output        : bool
+ *    Remarks       : Transmit timestamps are used if the kernel supports them
+ **************************************************************************************************/
+static bool ntp_posix_open( ntp_posix_shard_t* s, uint16_t port ){
+  int on = 1;
+  int off = 0;
+  int flags = NTP_POSIX_TSFLAGS;
+  struct sockaddr_in6 addr;
+  s->fd = socket(AF_INET6, SOCK_DGRAM, 0);
+  if(s->fd < 0){
+    return false;
+  }
+  setsockopt(s->fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+  if(0 != setsockopt(s->fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on))){
+    close(s->fd);
+    s->fd = -1;
+    return false;
+  }
+  s->tx_stamps = ( 0 == setsockopt(s->fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) );
+  if(false == s->tx_stamps){
+    /* Receive timestamps at least */
+    flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    setsockopt(s->fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags));
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sin6_family = AF_INET6;
+  addr.sin6_addr = in6addr_any;
+  addr.sin6_port = htons(port);
+  if(0 != bind(s->fd, (const struct sockaddr*)&addr, sizeof(addr))){
+    close(s->fd);
+    s->fd = -1;
+    return false;
+  }
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_PosixServer
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_PosixServer::NTP_PosixServer( ){
+  memset(shard, 0, sizeof(shard));
+  shard_count = 0;
+}
+
+/**************************************************************************************************
+ *    Function      : Destructor
+ *    Class         : NTP_PosixServer
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_PosixServer::~NTP_PosixServer( ){
+  end();
+}
+
+/**************************************************************************************************
+ *    Function      : begin
+ *    Class         : NTP_PosixServer
+ *    Description   : Opens the sockets and starts one thread per shard
+ *    Input         : uint16_t port, uint8_t shards, ntp_timestamp_t(*fnc_get_ntp_time)(void),
+ *                    ntp_sysvars_fnc_t fnc_sysvars
+ *    Output        : bool
+ *    Remarks       : Shard n is pinned to core n, the sockets take IPv4 and IPv6
+ **************************************************************************************************/
+bool NTP_PosixServer::begin( uint16_t port, uint8_t shards, ntp_timestamp_t(*fnc_get_ntp_time)(void), ntp_sysvars_fnc_t fnc_sysvars ){
+  uint8_t salt[NTP_RESPONDER_SALT_LEN];
+  if( (shards == 0) || (shards > NTP_POSIX_SHARDS_MAX) || (shard_count != 0) ){
+    return false;
+  }
+  for(uint8_t i=0;i<shards;i++){
+    ntp_posix_shard_t* s = new ntp_posix_shard_t;
+    s->read_time = fnc_get_ntp_time;
+    s->cpu = i;
+    s->run = true;
+    s->tx_key = 0;
+    memset(s->pending, 0, sizeof(s->pending));
+    memset(s->rx_msg, 0, sizeof(s->rx_msg));
+    memset(s->tx_msg, 0, sizeof(s->tx_msg));
+    memset(s->err_msg, 0, sizeof(s->err_msg));
+    for(uint8_t j=0;j<NTP_POSIX_BATCH;j++){
+      s->rx_iov[j].iov_base = s->rx_buf[j];
+      s->rx_iov[j].iov_len = NTP_PACKET_MAX_LEN;
+      s->rx_msg[j].msg_hdr.msg_name = &s->rx_addr[j];
+      s->rx_msg[j].msg_hdr.msg_iov = &s->rx_iov[j];
+      s->rx_msg[j].msg_hdr.msg_iovlen = 1;
+      s->rx_msg[j].msg_hdr.msg_control = s->rx_ctrl[j];
+      s->tx_iov[j].iov_base = s->tx_buf[j];
+      s->tx_msg[j].msg_hdr.msg_iov = &s->tx_iov[j];
+      s->tx_msg[j].msg_hdr.msg_iovlen = 1;
+    }
+    s->responder.SetClock(fnc_get_ntp_time, fnc_sysvars);
+    if(0 == getentropy(salt, sizeof(salt))){
+      s->responder.SetSalt(salt);
+    }
+    if(false == ntp_posix_open(s, port)){
+      delete s;
+      end();
+      return false;
+    }
+    shard[i] = s;
+    shard_count++;
+  }
+  for(uint8_t i=0;i<shard_count;i++){
+    if(0 != pthread_create(&shard[i]->thread, NULL, ntp_posix_shard_loop, shard[i])){
+      shard[i]->run = false;
+    }
+  }
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : end
+ *    Class         : NTP_PosixServer
+ *    Description   : Stops the threads and closes the sockets
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_PosixServer::end( void ){
+  for(uint8_t i=0;i<shard_count;i++){
+    ntp_posix_shard_t* s = shard[i];
+    if(true == s->run){
+      s->run = false;
+      /* Wakes the thread from recvmmsg */
+      shutdown(s->fd, SHUT_RDWR);
+      pthread_join(s->thread, NULL);
+    }
+    close(s->fd);
+    delete s;
+    shard[i] = NULL;
+  }
+  shard_count = 0;
+}
+
+/**************************************************************************************************
+ *    Function      : UpdateServerState
+ *    Class         : NTP_PosixServer
+ *    Description   : Sets the state the responses of all shards are built from
+ *    Input         : ntp_server_state_t state
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_PosixServer::UpdateServerState( ntp_server_state_t state ){
+  for(uint8_t i=0;i<shard_count;i++){
+    shard[i]->responder.SetServerState(&state);
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : SetRateLimit
+ *    Class         : NTP_PosixServer
+ *    Description   : Configures the per client rate limit of all shards
+ *    Input         : ratelimit_settings_t conf
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_PosixServer::SetRateLimit( ratelimit_settings_t conf ){
+  for(uint8_t i=0;i<shard_count;i++){
+    shard[i]->responder.SetRateLimit(conf);
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : SetKeys
+ *    Class         : NTP_PosixServer
+ *    Description   : Loads the symmetric keys into all shards
+ *    Input         : const ntp_keys_settings_t* conf
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_PosixServer::SetKeys( const ntp_keys_settings_t* conf ){
+  for(uint8_t i=0;i<shard_count;i++){
+    shard[i]->responder.SetKeys(conf);
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : SetNTS
+ *    Class         : NTP_PosixServer
+ *    Description   : Loads the NTS master keys into all shards
+ *    Input         : const nts_settings_t* conf
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_PosixServer::SetNTS( const nts_settings_t* conf ){
+  for(uint8_t i=0;i<shard_count;i++){
+    shard[i]->responder.SetNTS(conf);
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : GetShards
+ *    Class         : NTP_PosixServer
+ *    Description   : Returns the number of shards running
+ *    Input         : none
+ *    Output        : uint8_t
+ *    Remarks       : none
+ **************************************************************************************************/
+uint8_t NTP_PosixServer::GetShards( void ){
+  return shard_count;
+}
+
+/**************************************************************************************************
+ *    Function      : GetStats
+ *    Class         : NTP_PosixServer
+ *    Description   : Returns the counters of one shard
+ *    Input         : uint8_t shard
+ *    Output        : ntp_server_stats_t
+ *    Remarks       : The counters are read without a lock, they may be a packet behind
+ **************************************************************************************************/
+ntp_server_stats_t NTP_PosixServer::GetStats( uint8_t idx ){
+  ntp_server_stats_t stats;
+  if(idx >= shard_count){
+    memset(&stats, 0, sizeof(stats));
+    return stats;
+  }
+  return shard[idx]->responder.GetStats();
+}
+
+/**************************************************************************************************
+ *    Function      : GetTxTimestamping
+ *    Class         : NTP_PosixServer
+ *    Description   : Returns if the kernel reports transmit timestamps
+ *    Input         : none
+ *    Output        : bool
+ *    Remarks       : Without them the interleaved mode uses the time after sendmmsg returned
+ **************************************************************************************************/
+bool NTP_PosixServer::GetTxTimestamping( void ){
+  return ( shard_count > 0 ) && ( true == shard[0]->tx_stamps );
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef NTP_POSIX_H_
+ #define NTP_POSIX_H_
+
+/*
+ * Linux transport for the responder, used by the native build to serve
+ * from a gateway whose kernel clock is disciplined by the same GPS / PPS.
+ * Not part of the firmware.
+ */
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <stdint.h>
+#include <pthread.h>
+#include "ntp_responder.h"
+
+/* Datagrams taken with one recvmmsg and answered with one sendmmsg */
+#ifndef NTP_POSIX_BATCH
+ #define NTP_POSIX_BATCH ( 32 )
+#endif
+
+/* Responses waiting for their transmit timestamp from the error queue, a power of two */
+#ifndef NTP_POSIX_TX_PENDING
+ #define NTP_POSIX_TX_PENDING ( 256 )
+#endif
+
+#define NTP_POSIX_SHARDS_MAX ( 64 )
+
+/* Ancillary data of one datagram, the timestamps and the extended error */
+#define NTP_POSIX_CTRL_LEN ( 256 )
+
+typedef struct ntp_posix_shard_s ntp_posix_shard_t;
+
+/*
+ * One socket per shard, bound with SO_REUSEPORT, so the kernel hashes each
+ * client onto the same shard and its thread. Every shard has its own
+ * responder and counters, nothing is shared between the threads.
+ */
+class NTP_PosixServer {
+
+public:
+    NTP_PosixServer( );
+    ~NTP_PosixServer( );
+
+    /**************************************************************************************************
+     *    Function      : begin
+     *    Class         : NTP_PosixServer
+     *    Description   : Opens the sockets and starts one thread per shard
+     *    Input         : uint16_t port, uint8_t shards, ntp_timestamp_t(*fnc_get_ntp_time)(void),
+     *                    ntp_sysvars_fnc_t fnc_sysvars
+     *    Output        : bool
+     *    Remarks       : Shard n is pinned to core n, the sockets take IPv4 and IPv6
+     **************************************************************************************************/
+    bool begin( uint16_t port, uint8_t shards, ntp_timestamp_t(*fnc_get_ntp_time)(void), ntp_sysvars_fnc_t fnc_sysvars );
+
+    /**************************************************************************************************
+     *    Function      : end
+     *    Class         : NTP_PosixServer
+     *    Description   : Stops the threads and closes the sockets
+     *    Input         : none
+     *    Output        : none
+     *    Remarks       : none
+     **************************************************************************************************/
+    void end( void );
+
+    /**************************************************************************************************
+     *    Function      : UpdateServerState
+     *    Class         : NTP_PosixServer
+     *    Description   : Sets the state the responses of all shards are built from
+     *    Input         : ntp_server_state_t state
+     *    Output        : none
+     *    Remarks       : none
+     **************************************************************************************************/
+    void UpdateServerState( ntp_server_state_t state );
+
+    void SetRateLimit( ratelimit_settings_t conf );
+    void SetKeys( const ntp_keys_settings_t* conf );
+    void SetNTS( const nts_settings_t* conf );
+
+    /**************************************************************************************************
+     *    Function      : GetShards
+     *    Class         : NTP_PosixServer
+     *    Description   : Returns the number of shards running
+     *    Input         : none
+     *    Output        : uint8_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    uint8_t GetShards( void );
+
+    /**************************************************************************************************
+     *    Function      : GetStats
+     *    Class         : NTP_PosixServer
+     *    Description   : Returns the counters of one shard
+     *    Input         : uint8_t shard
+     *    Output        : ntp_server_stats_t
+     *    Remarks       : The counters are read without a lock, they may be a packet behind
+     **************************************************************************************************/
+    ntp_server_stats_t GetStats( uint8_t shard );
+
+    /**************************************************************************************************
+     *    Function      : GetTxTimestamping
+     *    Class         : NTP_PosixServer
+     *    Description   : Returns if the kernel reports transmit timestamps
+     *    Input         : none
+     *    Output        : bool
+     *    Remarks       : Without them the interleaved mode uses the time after sendmmsg returned
+     **************************************************************************************************/
+    bool GetTxTimestamping( void );
+
+private:
+    ntp_posix_shard_t* shard[NTP_POSIX_SHARDS_MAX];
+    uint8_t shard_count;
+};
+
+#endif
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * Entry point of the native build, serves NTP from a Linux gateway with the
+ * responder of the firmware. The kernel clock is expected to be disciplined
+ * by gpsd / chrony or ntpd from the same GPS and PPS, its sync state is
+ * taken from adjtimex.
+ *
+ *   pio run -e native && .pio/build/native/program -p 123 -t 4 -i 1
+ *
+ * Left out of pio test -e native, the tests bring their own main.
+ */
+#if defined(__linux__) && !defined(ARDUINO) && !defined(PIO_UNIT_TESTING)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/timex.h>
+#include "ntp_posix.h"
+#include "ntp_precision.h"
+
+/* Root dispersion of a synchronized clock never is reported below one microsecond */
+#define NTP_POSIX_MIN_DISPERSION_US ( 1 )
+
+static volatile bool ntp_posix_running = true;
+static struct timespec ntp_posix_started;
+
+/**************************************************************************************************
+ *    Function      : GetNTPTime
+ *    Description   : Returns the UTC time as NTP timestamp
+ *    Input         : none
+ *    Output        : ntp_timestamp_t
+ *    Remarks       : none
+ **************************************************************************************************/
+static ntp_timestamp_t GetNTPTime( void ){
+  struct timespec ts;
+  ntp_timestamp_t out;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  out.seconds = (uint32_t)( ts.tv_sec + NTP_TIMESTAMP_DELTA );
+  out.fraction = (uint32_t)( ( (uint64_t)ts.tv_nsec << 32 ) / 1000000000ull );
+  return out;
+}
+
+/**************************************************************************************************
+ *    Function      : ReadSysvars
+ *    Description   : Fills the mode 6 variables from the kernel clock
+ *    Input         : ntp_control_sysvars_t* vars
+ *    Output        : none
+ *    Remarks       : The offset is the one of the last update of the kernel PLL
+ **************************************************************************************************/
+static void ReadSysvars( ntp_control_sysvars_t* vars ){
+  struct timex tx;
+  struct timespec now;
+  memset(&tx, 0, sizeof(tx));
+  adjtimex(&tx);
+  vars->offset = ( 0 != ( tx.status & STA_NANO ) ) ? tx.offset : tx.offset * 1000;
+  vars->jitter = ( 0 != ( tx.status & STA_NANO ) ) ? tx.jitter : tx.jitter * 1000;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  vars->uptime = now.tv_sec - ntp_posix_started.tv_sec;
+}
+
+/**************************************************************************************************
+ *    Function      : ReadServerState
+ *    Description   : Builds the server state from the sync state of the kernel clock
+ *    Input         : ntp_server_state_t* state, uint8_t stratum, const char* refid, int8_t precision
+ *    Output        : none
+ *    Remarks       : The maximum error of the kernel is reported as root dispersion
+ **************************************************************************************************/
+static void ReadServerState( ntp_server_state_t* state, uint8_t stratum, const char* refid, int8_t precision ){
+  struct timex tx;
+  memset(&tx, 0, sizeof(tx));
+  int clock_state = adjtimex(&tx);
+  memset(state, 0, sizeof(ntp_server_state_t));
+  state->precision = precision;
+  if( (clock_state == TIME_ERROR) || (0 != ( tx.status & STA_UNSYNC ) ) ){
+    state->leap = 3;
+    state->stratum = NTP_STRATUM_UNSYNC;
+    memcpy(state->refid, "INIT", sizeof(state->refid));
+    state->rootDispersion = NTP_MAX_DISPERSION;
+    return;
+  }
+  if(0 != ( tx.status & STA_INS ) ){
+    state->leap = 1;
+  } else if(0 != ( tx.status & STA_DEL ) ){
+    state->leap = 2;
+  }
+  state->stratum = stratum;
+  strncpy((char*)state->refid, refid, sizeof(state->refid));
+  uint64_t maxerror = ( tx.maxerror < NTP_POSIX_MIN_DISPERSION_US ) ? NTP_POSIX_MIN_DISPERSION_US : tx.maxerror;
+  if( maxerror >= ( (uint64_t)( NTP_MAX_DISPERSION >> 16 ) * 1000000 ) ){
+    state->rootDispersion = NTP_MAX_DISPERSION;
+  } else {
+    state->rootDispersion = (uint32_t)( ( maxerror << 16 ) / 1000000 );
+  }
+  /* The kernel does not tell when it was last updated, the current second is close enough */
+  state->reference = ntp_time64_make(GetNTPTime().seconds, 0);
+}
+
+static void ntp_posix_stop( int sig ){
+  (void)sig;
+  ntp_posix_running = false;
+}
+
+static void usage( const char* name ){
+  fprintf(stderr, "usage: %s [-p port] [-t shards] [-s stratum] [-r refid] [-i report interval s] [-n]\n"
+                  "  -n  no rate limiting, for benchmarks from a single address\n", name);
+}
+
+int main( int argc, char** argv ){
+  NTP_PosixServer server;
+  ntp_server_state_t state;
+  uint16_t port = 123;
+  long shards = sysconf(_SC_NPROCESSORS_ONLN);
+  uint8_t stratum = 1;
+  const char* refid = "GPS";
+  uint32_t report = 0;
+  bool ratelimit = true;
+  int opt;
+
+  while( -1 != ( opt = getopt(argc, argv, "p:t:s:r:i:nh") ) ){
+    switch(opt){
+      case 'p': port = atoi(optarg); break;
+      case 't': shards = atoi(optarg); break;
+      case 's': stratum = atoi(optarg); break;
+      case 'r': refid = optarg; break;
+      case 'i': report = atoi(optarg); break;
+      case 'n': ratelimit = false; break;
+      default:{
+        usage(argv[0]);
+        return 1;
+      }
+    }
+  }
+  if( (shards < 1) || (shards > NTP_POSIX_SHARDS_MAX) || (stratum < 1) || (stratum > 15) ){
+    usage(argv[0]);
+    return 1;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &ntp_posix_started);
+  signal(SIGINT, ntp_posix_stop);
+  signal(SIGTERM, ntp_posix_stop);
+  ntp_precision_t measured = ntp_measure_precision(GetNTPTime);
+  int8_t precision = measured.precision;
+
+  if(false == server.begin(port, shards, GetNTPTime, ReadSysvars)){
+    perror("NTP server");
+    return 1;
+  }
+  if(false == ratelimit){
+    ratelimit_settings_t rl = NTP_RateLimiter::GetDefaultConfig();
+    rl.enabled = false;
+    server.SetRateLimit(rl);
+  }
+  printf("NTP on port %u, %u shards, transmit timestamps %s\n", port, server.GetShards(),
+         ( true == server.GetTxTimestamping() ) ? "from the kernel" : "after send");
+  printf("precision 2^%d s, resolution %.0f ns, read cost %.0f ns\n", precision,
+         ( (double)measured.resolution * 1e9 ) / 4294967296.0, ( (double)measured.read_cost * 1e9 ) / 4294967296.0);
+
+  ntp_server_stats_t last[NTP_POSIX_SHARDS_MAX];
+  memset(last, 0, sizeof(last));
+  uint32_t seconds = 0;
+  while(true == ntp_posix_running){
+    ReadServerState(&state, stratum, refid, precision);
+    server.UpdateServerState(state);
+    sleep(1);
+    seconds++;
+    if( (report == 0) || ( 0 != ( seconds % report ) ) ){
+      continue;
+    }
+    /* Per shard, so the packets per second per core can be read directly */
+    uint64_t total = 0;
+    for(uint8_t i=0;i<server.GetShards();i++){
+      ntp_server_stats_t s = server.GetStats(i);
+      uint32_t pps = ( s.responses - last[i].responses ) / report;
+      printf("shard %u: %u responses/s, %u requests, %u dropped\n", i, pps, s.requests, s.dropped);
+      total += pps;
+      last[i] = s;
+    }
+    printf("total: %llu responses/s\n", (unsigned long long)total);
+    fflush(stdout);
+  }
+  server.end();
+  return 0;
+}
+
+#endif
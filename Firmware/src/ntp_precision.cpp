@@ -0,0 +1,78 @@
+#include <string.h>
+#include "ntp_precision.h"
+
+/**************************************************************************************************
+ *    Function      : ntp_precision_log2
+ *    Description   : Returns the precision exponent of a time span
+ *    Input         : uint64_t span ( 1/2^32 s )
+ *    Output        : int8_t ( log2 seconds )
+ *    Remarks       : Rounded up, so a span is never advertised better than it is
+ **************************************************************************************************/
+int8_t ntp_precision_log2( uint64_t span ){
+  /* Bits needed for span - 1 is the exponent of the next power of two at or above span */
+  int8_t bits = 0;
+  uint64_t v = ( span > 0 ) ? ( span - 1 ) : 0;
+  while(v != 0){
+    bits++;
+    v >>= 1;
+  }
+  return bits - 32;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_measure_precision
+ *    Description   : Measures the resolution of a clock and the time it takes to read it
+ *    Input         : ntp_timestamp_t(*read)(void)
+ *    Output        : ntp_precision_t
+ *    Remarks       : Busy reads the clock for up to NTP_PRECISION_MAX_READS times, the
+ *                    resolution is the smallest step seen and covers the read cost as well
+ **************************************************************************************************/
+ntp_precision_t ntp_measure_precision( ntp_timestamp_t(*read)(void) ){
+  ntp_precision_t out;
+  memset(&out, 0, sizeof(out));
+  out.precision = NTP_PRECISION_UNKNOWN;
+  if(read == NULL){
+    return out;
+  }
+
+  ntp_timestamp_t ts = read();
+  uint64_t prev = ( (uint64_t)ts.seconds << 32 ) | ts.fraction;
+  uint64_t elapsed = 0;
+  uint64_t smallest = UINT64_MAX;
+  uint32_t dropped = 0;
+  bool stepped_back = false;
+  out.reads = 1;
+  while( (out.reads < NTP_PRECISION_MAX_READS) &&
+         ( (out.reads < NTP_PRECISION_READS) || (out.steps < NTP_PRECISION_STEPS) ) ){
+    ts = read();
+    uint64_t now = ( (uint64_t)ts.seconds << 32 ) | ts.fraction;
+    int64_t diff = (int64_t)( now - prev );
+    prev = now;
+    out.reads++;
+    if( (diff > 0) && (true == stepped_back) ){
+      /* The step back is made up again, the interval says nothing about the clock */
+      stepped_back = false;
+      dropped++;
+    } else if(diff > 0){
+      out.steps++;
+      elapsed += (uint64_t)diff;
+      if( (uint64_t)diff < smallest ){
+        smallest = (uint64_t)diff;
+      }
+    } else if(diff < 0){
+      /* The clock was set or a second latched late, the time in between is unknown */
+      out.backwards++;
+      dropped++;
+      stepped_back = true;
+    }
+  }
+
+  if(out.steps < NTP_PRECISION_STEPS){
+    return out;
+  }
+  out.valid = true;
+  out.resolution = smallest;
+  out.read_cost = elapsed / ( out.reads - 1 - dropped );
+  out.precision = ntp_precision_log2( ( out.resolution > out.read_cost ) ? out.resolution : out.read_cost );
+  return out;
+}
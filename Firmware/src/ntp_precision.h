@@ -0,0 +1,48 @@
+#ifndef NTP_PRECISION_H_
+ #define NTP_PRECISION_H_
+
+#include <stdint.h>
+#include "ntp_timestamp.h"
+
+/* Reads taken at least, their mean gives the cost of a read */
+#define NTP_PRECISION_READS ( 1024 )
+
+/* Steps of the clock needed before its resolution is trusted */
+#define NTP_PRECISION_STEPS ( 8 )
+
+/* Reads given up after, a clock that only counts seconds would need 8s of steps */
+#define NTP_PRECISION_MAX_READS ( 65536 )
+
+/* What is advertised if the clock never moved during the measurement, one second */
+#define NTP_PRECISION_UNKNOWN ( 0 )
+
+typedef struct {
+  bool valid;           /* The clock stepped often enough to be measured */
+  int8_t precision;     /* log2 seconds of the larger of resolution and read cost, RFC 5905 */
+  uint64_t resolution;  /* Smallest step seen between two reads, 1/2^32 s */
+  uint64_t read_cost;   /* Mean time a read takes, 1/2^32 s */
+  uint32_t reads;
+  uint32_t steps;       /* Reads that saw the clock move forward */
+  uint32_t backwards;   /* Reads that saw the clock go back, left out */
+} ntp_precision_t;
+
+/**************************************************************************************************
+ *    Function      : ntp_measure_precision
+ *    Description   : Measures the resolution of a clock and the time it takes to read it
+ *    Input         : ntp_timestamp_t(*read)(void)
+ *    Output        : ntp_precision_t
+ *    Remarks       : Busy reads the clock for up to NTP_PRECISION_MAX_READS times, the
+ *                    resolution is the smallest step seen and covers the read cost as well
+ **************************************************************************************************/
+ntp_precision_t ntp_measure_precision( ntp_timestamp_t(*read)(void) );
+
+/**************************************************************************************************
+ *    Function      : ntp_precision_log2
+ *    Description   : Returns the precision exponent of a time span
+ *    Input         : uint64_t span ( 1/2^32 s )
+ *    Output        : int8_t ( log2 seconds )
+ *    Remarks       : Rounded up, so a span is never advertised better than it is
+ **************************************************************************************************/
+int8_t ntp_precision_log2( uint64_t span );
+
+#endif
@@ -0,0 +1,173 @@
+#include <string.h>
+#include "ntp_ratelimit.h"
+
+/* Set as long as the client got its KoD and stays over the limit */
+#define RATELIMIT_FLAG_KOD_SENT ( 0x0001 )
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_RateLimiter
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_RateLimiter::NTP_RateLimiter( ){
+  memset(entries, 0, sizeof(entries));
+  memset(&stats, 0, sizeof(stats));
+  SetConfig(GetDefaultConfig());
+}
+
+/**************************************************************************************************
+ *    Function      : GetDefaultConfig
+ *    Class         : NTP_RateLimiter
+ *    Description   : Gets the default config 
+ *    Input         : none
+ *    Output        : ratelimit_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ratelimit_settings_t NTP_RateLimiter::GetDefaultConfig( void ){
+  ratelimit_settings_t conf;
+  conf.enabled = true;
+  conf.send_kod = true;
+  conf.rate = 30;
+  conf.burst = 8;
+  return conf;
+}
+
+/**************************************************************************************************
+ *    Function      : SetConfig
+ *    Class         : NTP_RateLimiter
+ *    Description   : Applys the passed config 
+ *    Input         : ratelimit_settings_t conf
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_RateLimiter::SetConfig( ratelimit_settings_t conf ){
+  if(conf.rate == 0){
+    conf.rate = 1;
+  }
+  if(conf.burst == 0){
+    conf.burst = 1;
+  }
+  config = conf;
+  /* rate / 60 tokens per second, 256 ticks per second, 24 bit fraction */
+  refill = (uint32_t)( ( (uint64_t)conf.rate << 24 ) / ( 60 * 256 ) );
+}
+
+/**************************************************************************************************
+ *    Function      : GetConfig
+ *    Class         : NTP_RateLimiter
+ *    Description   : Gets the current config 
+ *    Input         : none
+ *    Output        : ratelimit_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ratelimit_settings_t NTP_RateLimiter::GetConfig( void ){
+  return config;
+}
+
+/**************************************************************************************************
+ *    Function      : GetStats
+ *    Class         : NTP_RateLimiter
+ *    Description   : Gets the limiter counters
+ *    Input         : none
+ *    Output        : ntp_ratelimit_stats_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_ratelimit_stats_t NTP_RateLimiter::GetStats( void ){
+  return stats;
+}
+
+/**************************************************************************************************
+ *    Function      : Find
+ *    Class         : NTP_RateLimiter
+ *    Description   : Looks up a client, adds it if not found
+ *    Input         : const ntp_addr_t* client, uint32_t hash, uint32_t now
+ *    Output        : ntp_ratelimit_entry_t*
+ *    Remarks       : Linear probing, the least recently seen slot in the probe window is reused
+ **************************************************************************************************/
+ntp_ratelimit_entry_t* NTP_RateLimiter::Find( const ntp_addr_t* client, uint32_t hash, uint32_t now ){
+  uint32_t idx = (uint32_t)( ( (uint64_t)hash * NTP_RATELIMIT_ENTRIES ) >> 32 );
+  ntp_ratelimit_entry_t* victim = NULL;
+  uint32_t victim_age = 0;
+
+  for(uint32_t i=0;i<NTP_RATELIMIT_PROBES;i++){
+    ntp_ratelimit_entry_t* e = &entries[ (idx + i) & ( NTP_RATELIMIT_ENTRIES - 1 ) ];
+    if( (e->last != 0) && (true == ntp_addr_equal(&e->client, client)) ){
+      stats.hits++;
+      return e;
+    }
+    if(e->last == 0){
+      /* Empty slot, the client can't be further down the probe window */
+      victim = e;
+      break;
+    }
+    uint32_t age = now - e->last;
+    if( (victim == NULL) || (age > victim_age) ){
+      victim = e;
+      victim_age = age;
+    }
+  }
+
+  stats.misses++;
+  if(victim->last != 0){
+    stats.evictions++;
+  }
+  victim->client = *client;
+  victim->last = now;
+  victim->tokens = (uint16_t)config.burst << 8;
+  victim->flags = 0;
+  return victim;
+}
+
+/**************************************************************************************************
+ *    Function      : Check
+ *    Class         : NTP_RateLimiter
+ *    Description   : Takes a token from the bucket of a client
+ *    Input         : const ntp_addr_t* client, uint32_t hash, ntp_timestamp_t now
+ *    Output        : ntp_ratelimit_result_t
+ *    Remarks       : Only the first request over the limit gets a KoD, the others are dropped.
+ *                    hash is the keyed one of ntp_addr_hash, it only picks the slots to search
+ **************************************************************************************************/
+ntp_ratelimit_result_t NTP_RateLimiter::Check( const ntp_addr_t* client, uint32_t hash, ntp_timestamp_t now ){
+  if(false == config.enabled){
+    return NTP_RATELIMIT_PASS;
+  }
+  /* 1/256 seconds, wraps after 194 days, 0 marks an empty slot */
+  uint32_t ticks = ( now.seconds << 8 ) | ( now.fraction >> 24 );
+  if(ticks == 0){
+    ticks = 1;
+  }
+  ntp_ratelimit_entry_t* e = Find(client, hash, ticks);
+
+  /* Refill the bucket for the time passed, capped at the burst size */
+  uint32_t elapsed = ticks - e->last;
+  uint32_t max_tokens = (uint32_t)config.burst << 8;
+  uint64_t add = ( (uint64_t)elapsed * refill ) >> 16;
+  uint32_t tokens = e->tokens;
+  if( (elapsed > 0x7FFFFFFF) || ( add >= max_tokens ) ){
+    tokens = max_tokens;
+  } else {
+    tokens += (uint32_t)add;
+    if(tokens > max_tokens){
+      tokens = max_tokens;
+    }
+  }
+  e->last = ticks;
+
+  if(tokens >= 256){
+    e->tokens = (uint16_t)( tokens - 256 );
+    e->flags &= ~RATELIMIT_FLAG_KOD_SENT;
+    return NTP_RATELIMIT_PASS;
+  }
+
+  e->tokens = (uint16_t)tokens;
+  stats.limited++;
+  if( (true == config.send_kod) && ( 0 == ( e->flags & RATELIMIT_FLAG_KOD_SENT ) ) ){
+    e->flags |= RATELIMIT_FLAG_KOD_SENT;
+    stats.kod++;
+    return NTP_RATELIMIT_KOD;
+  }
+  return NTP_RATELIMIT_DROP;
+}
@@ -0,0 +1,110 @@
+#ifndef NTP_RATELIMIT_H_
+ #define NTP_RATELIMIT_H_
+
+#include <stdint.h>
+#include "ntp_timestamp.h"
+#include "ntp_addr.h"
+
+/* Number of clients tracked by the rate limiter, needs to be a power of two */
+#ifndef NTP_RATELIMIT_ENTRIES
+ #define NTP_RATELIMIT_ENTRIES ( 1024 )
+#endif
+
+/* Slots searched for a client before the least recently seen one is evicted. The keyed hash
+   spreads the clients at random, with 8 probes 10k clients in 16k slots had 3% evictions */
+#define NTP_RATELIMIT_PROBES ( 16 )
+
+typedef struct {
+  bool enabled;
+  bool send_kod;   /* Answer with a KoD RATE instead of dropping the request */
+  uint16_t rate;   /* Requests per minute a client may send on average */
+  uint8_t burst;   /* Requests a client may send back to back */
+} ratelimit_settings_t;
+
+typedef enum {
+  NTP_RATELIMIT_PASS = 0,
+  NTP_RATELIMIT_KOD,
+  NTP_RATELIMIT_DROP
+} ntp_ratelimit_result_t;
+
+typedef struct {
+  uint32_t hits;      /* Client was found in the table */
+  uint32_t misses;    /* Client was added to the table */
+  uint32_t evictions; /* A client was thrown out to make room */
+  uint32_t limited;   /* Requests over the limit */
+  uint32_t kod;       /* KoD RATE responses sent */
+} ntp_ratelimit_stats_t;
+
+typedef struct {
+  ntp_addr_t client;
+  uint32_t last;    /* Last request in 1/256 seconds */
+  uint16_t tokens;  /* Requests left, 8.8 fixed point */
+  uint16_t flags;
+} ntp_ratelimit_entry_t;
+
+/* Fixed size open addressing hash table with a token bucket per client */
+class NTP_RateLimiter {
+
+public:
+    NTP_RateLimiter( );
+
+    /**************************************************************************************************
+     *    Function      : SetConfig
+     *    Class         : NTP_RateLimiter
+     *    Description   : Applys the passed config 
+     *    Input         : ratelimit_settings_t conf
+     *    Output        : none
+     *    Remarks       : none
+     **************************************************************************************************/
+    void SetConfig( ratelimit_settings_t conf );
+
+    /**************************************************************************************************
+     *    Function      : GetConfig
+     *    Class         : NTP_RateLimiter
+     *    Description   : Gets the current config 
+     *    Input         : none
+     *    Output        : ratelimit_settings_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    ratelimit_settings_t GetConfig( void );
+
+    /**************************************************************************************************
+     *    Function      : GetDefaultConfig
+     *    Class         : NTP_RateLimiter
+     *    Description   : Gets the default config 
+     *    Input         : none
+     *    Output        : ratelimit_settings_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    static ratelimit_settings_t GetDefaultConfig( void );
+
+    /**************************************************************************************************
+     *    Function      : Check
+     *    Class         : NTP_RateLimiter
+     *    Description   : Takes a token from the bucket of a client
+     *    Input         : const ntp_addr_t* client, uint32_t hash, ntp_timestamp_t now
+     *    Output        : ntp_ratelimit_result_t
+     *    Remarks       : Only the first request over the limit gets a KoD, the others are dropped.
+     *                    hash is the keyed one of ntp_addr_hash, it only picks the slots to search
+     **************************************************************************************************/
+    ntp_ratelimit_result_t Check( const ntp_addr_t* client, uint32_t hash, ntp_timestamp_t now );
+
+    /**************************************************************************************************
+     *    Function      : GetStats
+     *    Class         : NTP_RateLimiter
+     *    Description   : Gets the limiter counters
+     *    Input         : none
+     *    Output        : ntp_ratelimit_stats_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    ntp_ratelimit_stats_t GetStats( void );
+
+private:
+    ratelimit_settings_t config;
+    ntp_ratelimit_stats_t stats;
+    uint32_t refill; /* Tokens per 1/256 second, 8.24 fixed point */
+    ntp_ratelimit_entry_t entries[NTP_RATELIMIT_ENTRIES];
+    ntp_ratelimit_entry_t* Find( const ntp_addr_t* client, uint32_t hash, uint32_t now );
+};
+
+#endif
@@ -0,0 +1,725 @@
+#include <string.h>
+#include "ntp_responder.h"
+
+#ifdef ARDUINO
+ #define NTP_MRU_LOCK( m ) portENTER_CRITICAL( m )
+ #define NTP_MRU_UNLOCK( m ) portEXIT_CRITICAL( m )
+ #define NTP_SPARE_YIELD( ) vTaskDelay( 1 )
+#else
+ #include <sched.h>
+ #define NTP_MRU_LOCK( m ) pthread_mutex_lock( m )
+ #define NTP_MRU_UNLOCK( m ) pthread_mutex_unlock( m )
+ #define NTP_SPARE_YIELD( ) sched_yield( )
+#endif
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_Responder
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : Unsynchronized until a server state is set
+ **************************************************************************************************/
+NTP_Responder::NTP_Responder( ){
+  read_time = NULL;
+  read_sysvars = NULL;
+  memset(addr_key, 0, sizeof(addr_key));
+  memset(stats, 0, sizeof(stats));
+  broadcasts = 0;
+  memset(&last_stamp, 0, sizeof(last_stamp));
+#ifdef ARDUINO
+  vPortCPUInitializeMutex(&mru_mux);
+#else
+  pthread_mutex_init(&mru_mux, NULL);
+#endif
+  keys_idx = 0;
+  nts_idx = 0;
+  header_idx = 0;
+  memset((void*)header_users, 0, sizeof(header_users));
+  memset((void*)keys_users, 0, sizeof(keys_users));
+  memset((void*)nts_users, 0, sizeof(nts_users));
+  memset(&header_state, 0, sizeof(header_state));
+  header_state.leap = 3;
+  header_state.stratum = NTP_STRATUM_UNSYNC;
+  memcpy(header_state.refid, "INIT", sizeof(header_state.refid));
+  header_state.rootDispersion = NTP_MAX_DISPERSION;
+  ntp_build_template(&header[0], &header_state);
+}
+
+/**************************************************************************************************
+ *    Function      : Destructor
+ *    Class         : NTP_Responder
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_Responder::~NTP_Responder( ){
+#ifndef ARDUINO
+  pthread_mutex_destroy(&mru_mux);
+#endif
+}
+
+/**************************************************************************************************
+ *    Function      : SetClock
+ *    Class         : NTP_Responder
+ *    Description   : Sets where the transmit time and the mode 6 clock variables come from
+ *    Input         : ntp_timestamp_t(*fnc_get_ntp_time)(void), ntp_sysvars_fnc_t fnc_sysvars
+ *    Output        : none
+ *    Remarks       : fnc_sysvars may be NULL
+ **************************************************************************************************/
+void NTP_Responder::SetClock( ntp_timestamp_t(*fnc_get_ntp_time)(void), ntp_sysvars_fnc_t fnc_sysvars ){
+  read_time = fnc_get_ntp_time;
+  read_sysvars = fnc_sysvars;
+}
+
+/**************************************************************************************************
+ *    Function      : SetServerState
+ *    Class         : NTP_Responder
+ *    Description   : Rebuilds the response header
+ *    Input         : const ntp_server_state_t* state
+ *    Output        : none
+ *    Remarks       : The header is built in the spare buffer and swapped in, once no response in
+ *                    flight uses the spare one any more. Not to be called from two tasks at once
+ **************************************************************************************************/
+void NTP_Responder::SetServerState( const ntp_server_state_t* state ){
+  uint8_t next = ( header_idx == 0 ) ? 1 : 0;
+  WaitSpare(header_users, next);
+  ntp_build_template(&header[next], state);
+  NTP_MRU_LOCK(&mru_mux);
+  header_state = *state;
+  header_idx = next;
+  NTP_MRU_UNLOCK(&mru_mux);
+}
+
+/**************************************************************************************************
+ *    Function      : GetServerState
+ *    Class         : NTP_Responder
+ *    Description   : Returns the state the response header is built from
+ *    Input         : none
+ *    Output        : ntp_server_state_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_server_state_t NTP_Responder::GetServerState( void ){
+  NTP_MRU_LOCK(&mru_mux);
+  ntp_server_state_t state = header_state;
+  NTP_MRU_UNLOCK(&mru_mux);
+  return state;
+}
+
+/**************************************************************************************************
+ *    Function      : GetTemplate
+ *    Class         : NTP_Responder
+ *    Description   : Returns the response header in use
+ *    Input         : none
+ *    Output        : ntp_packet_t
+ *    Remarks       : A copy, the buffer may be rebuilt as soon as the next header is swapped in
+ **************************************************************************************************/
+ntp_packet_t NTP_Responder::GetTemplate( void ){
+  NTP_MRU_LOCK(&mru_mux);
+  ntp_packet_t tmpl = header[header_idx];
+  NTP_MRU_UNLOCK(&mru_mux);
+  return tmpl;
+}
+
+/**************************************************************************************************
+ *    Function      : SetKeys
+ *    Class         : NTP_Responder
+ *    Description   : Loads the symmetric keys
+ *    Input         : const ntp_keys_settings_t* conf
+ *    Output        : none
+ *    Remarks       : The keys are prepared in the spare table, the one in use is left alone.
+ *                    Not to be called from two tasks at once
+ **************************************************************************************************/
+void NTP_Responder::SetKeys( const ntp_keys_settings_t* conf ){
+  uint8_t next = ( keys_idx == 0 ) ? 1 : 0;
+  WaitSpare(keys_users, next);
+  keys[next].Load(conf);
+  NTP_MRU_LOCK(&mru_mux);
+  keys_idx = next;
+  NTP_MRU_UNLOCK(&mru_mux);
+}
+
+/**************************************************************************************************
+ *    Function      : SetNTS
+ *    Class         : NTP_Responder
+ *    Description   : Loads the NTS master keys
+ *    Input         : const nts_settings_t* conf
+ *    Output        : none
+ *    Remarks       : The keys are prepared in the spare slot, the one in use is left alone.
+ *                    Not to be called from two tasks at once
+ **************************************************************************************************/
+void NTP_Responder::SetNTS( const nts_settings_t* conf ){
+  uint8_t next = ( nts_idx == 0 ) ? 1 : 0;
+  WaitSpare(nts_users, next);
+  nts[next].Load(conf);
+  NTP_MRU_LOCK(&mru_mux);
+  nts_idx = next;
+  NTP_MRU_UNLOCK(&mru_mux);
+}
+
+/**************************************************************************************************
+ *    Function      : WaitSpare
+ *    Class         : NTP_Responder
+ *    Description   : Waits until no response in flight uses the spare buffer
+ *    Input         : volatile uint16_t* users, uint8_t spare
+ *    Output        : none
+ *    Remarks       : Only responses that started before the last swap can still hold it, they are
+ *                    done within microseconds
+ **************************************************************************************************/
+void NTP_Responder::WaitSpare( volatile uint16_t* users, uint8_t spare ){
+  while(1==1){
+    NTP_MRU_LOCK(&mru_mux);
+    uint16_t busy = users[spare];
+    NTP_MRU_UNLOCK(&mru_mux);
+    if(busy == 0){
+      return;
+    }
+    NTP_SPARE_YIELD();
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : Acquire
+ *    Class         : NTP_Responder
+ *    Description   : Takes the header, keys and NTS keys in use for one response
+ *    Input         : ntp_responder_slots_t* slots
+ *    Output        : none
+ *    Remarks       : None of them is rebuilt until Release
+ **************************************************************************************************/
+void NTP_Responder::Acquire( ntp_responder_slots_t* slots ){
+  NTP_MRU_LOCK(&mru_mux);
+  slots->header = header_idx;
+  slots->keys = keys_idx;
+  slots->nts = nts_idx;
+  header_users[slots->header]++;
+  keys_users[slots->keys]++;
+  nts_users[slots->nts]++;
+  NTP_MRU_UNLOCK(&mru_mux);
+}
+
+/**************************************************************************************************
+ *    Function      : Release
+ *    Class         : NTP_Responder
+ *    Description   : Hands back what Acquire took
+ *    Input         : const ntp_responder_slots_t* slots
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_Responder::Release( const ntp_responder_slots_t* slots ){
+  NTP_MRU_LOCK(&mru_mux);
+  header_users[slots->header]--;
+  keys_users[slots->keys]--;
+  nts_users[slots->nts]--;
+  NTP_MRU_UNLOCK(&mru_mux);
+}
+
+/**************************************************************************************************
+ *    Function      : SetSalt
+ *    Class         : NTP_Responder
+ *    Description   : Sets the secret the client hash and the mode 6 nonces are derived from
+ *    Input         : const uint8_t* salt
+ *    Output        : none
+ *    Remarks       : NTP_RESPONDER_SALT_LEN random bytes. The client hash places the clients in
+ *                    the tables, known to a client it could pick addresses that crowd out others.
+ *                    Call it before the first request, the tables are not rehashed
+ **************************************************************************************************/
+void NTP_Responder::SetSalt( const uint8_t* salt ){
+  uint32_t nonce_salt;
+  memcpy(addr_key, salt, NTP_ADDR_KEY_LEN);
+  memcpy(&nonce_salt, &salt[NTP_ADDR_KEY_LEN], sizeof(nonce_salt));
+  control.SetSalt(nonce_salt);
+}
+
+/**************************************************************************************************
+ *    Function      : SetRateLimit
+ *    Class         : NTP_Responder
+ *    Description   : Configures the per client rate limit
+ *    Input         : ratelimit_settings_t conf
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_Responder::SetRateLimit( ratelimit_settings_t conf ){
+  for(uint8_t i=0;i<NTP_INTERFACES;i++){
+    ratelimit[i].SetConfig(conf);
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : GetRateLimit
+ *    Class         : NTP_Responder
+ *    Description   : Returns the per client rate limit config
+ *    Input         : none
+ *    Output        : ratelimit_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ratelimit_settings_t NTP_Responder::GetRateLimit( void ){
+  return ratelimit[0].GetConfig();
+}
+
+/**************************************************************************************************
+ *    Function      : GetRateLimitStats
+ *    Class         : NTP_Responder
+ *    Description   : Returns the rate limiter counters of all interfaces
+ *    Input         : none
+ *    Output        : ntp_ratelimit_stats_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_ratelimit_stats_t NTP_Responder::GetRateLimitStats( void ){
+  ntp_ratelimit_stats_t sum;
+  memset(&sum, 0, sizeof(sum));
+  for(uint8_t i=0;i<NTP_INTERFACES;i++){
+    ntp_ratelimit_stats_t s = ratelimit[i].GetStats();
+    sum.hits += s.hits;
+    sum.misses += s.misses;
+    sum.evictions += s.evictions;
+    sum.limited += s.limited;
+    sum.kod += s.kod;
+  }
+  return sum;
+}
+
+/**************************************************************************************************
+ *    Function      : GetRateLimitStats
+ *    Class         : NTP_Responder
+ *    Description   : Returns the rate limiter counters of one interface
+ *    Input         : uint8_t netif
+ *    Output        : ntp_ratelimit_stats_t
+ *    Remarks       : All zero for an interface without its own limiter
+ **************************************************************************************************/
+ntp_ratelimit_stats_t NTP_Responder::GetRateLimitStats( uint8_t netif ){
+  ntp_ratelimit_stats_t s;
+  memset(&s, 0, sizeof(s));
+  if(netif < NTP_INTERFACES){
+    s = ratelimit[netif].GetStats();
+  }
+  return s;
+}
+
+/**************************************************************************************************
+ *    Function      : GetStats
+ *    Class         : NTP_Responder
+ *    Description   : Returns the request and response counters of all interfaces
+ *    Input         : none
+ *    Output        : ntp_server_stats_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_server_stats_t NTP_Responder::GetStats( void ){
+  ntp_server_stats_t sum;
+  memset(&sum, 0, sizeof(sum));
+  for(uint8_t i=0;i<NTP_INTERFACES;i++){
+    sum.requests += stats[i].requests;
+    sum.requests_v4 += stats[i].requests_v4;
+    sum.requests_v6 += stats[i].requests_v6;
+    sum.responses += stats[i].responses;
+    sum.interleaved += stats[i].interleaved;
+    sum.dropped += stats[i].dropped;
+    sum.authenticated += stats[i].authenticated;
+    sum.authfailed += stats[i].authfailed;
+    sum.nts += stats[i].nts;
+    sum.ntsnak += stats[i].ntsnak;
+  }
+  sum.broadcasts = broadcasts;
+  return sum;
+}
+
+/**************************************************************************************************
+ *    Function      : GetStats
+ *    Class         : NTP_Responder
+ *    Description   : Returns the request and response counters of one interface
+ *    Input         : uint8_t netif
+ *    Output        : ntp_server_stats_t
+ *    Remarks       : Broadcasts are only in the sum of all interfaces
+ **************************************************************************************************/
+ntp_server_stats_t NTP_Responder::GetStats( uint8_t netif ){
+  ntp_server_stats_t s;
+  memset(&s, 0, sizeof(s));
+  if(netif < NTP_INTERFACES){
+    s = stats[netif];
+  }
+  return s;
+}
+
+/**************************************************************************************************
+ *    Function      : GetClients
+ *    Class         : NTP_Responder
+ *    Description   : Copies a part of the client list, most recently seen client first
+ *    Input         : ntp_mru_entry_t* out, uint16_t start, uint16_t max
+ *    Output        : uint16_t ( entries copied )
+ *    Remarks       : Safe to call from another thread
+ **************************************************************************************************/
+uint16_t NTP_Responder::GetClients( ntp_mru_entry_t* out, uint16_t start, uint16_t max ){
+  uint16_t copied;
+  NTP_MRU_LOCK(&mru_mux);
+  copied = mru.GetClients(out, start, max);
+  NTP_MRU_UNLOCK(&mru_mux);
+  return copied;
+}
+
+/**************************************************************************************************
+ *    Function      : GetClientCount
+ *    Class         : NTP_Responder
+ *    Description   : Returns the number of clients in the client list
+ *    Input         : none
+ *    Output        : uint16_t
+ *    Remarks       : none
+ **************************************************************************************************/
+uint16_t NTP_Responder::GetClientCount( void ){
+  return mru.Count();
+}
+
+/**************************************************************************************************
+ *    Function      : GetCensus
+ *    Class         : NTP_Responder
+ *    Description   : Returns the population histogram of the client clock errors
+ *    Input         : none
+ *    Output        : ntp_census_stats_t
+ *    Remarks       : Safe to call from another thread
+ **************************************************************************************************/
+ntp_census_stats_t NTP_Responder::GetCensus( void ){
+  ntp_census_stats_t out;
+  NTP_MRU_LOCK(&mru_mux);
+  out = census.GetStats();
+  NTP_MRU_UNLOCK(&mru_mux);
+  return out;
+}
+
+/**************************************************************************************************
+ *    Function      : GetCensusFlagged
+ *    Class         : NTP_Responder
+ *    Description   : Copies the clients whose clocks are far off or drifting
+ *    Input         : ntp_census_entry_t* out, uint16_t max
+ *    Output        : uint16_t ( entries copied )
+ *    Remarks       : Safe to call from another thread
+ **************************************************************************************************/
+uint16_t NTP_Responder::GetCensusFlagged( ntp_census_entry_t* out, uint16_t max ){
+  uint16_t copied;
+  NTP_MRU_LOCK(&mru_mux);
+  copied = census.GetFlagged(out, max);
+  NTP_MRU_UNLOCK(&mru_mux);
+  return copied;
+}
+
+/**************************************************************************************************
+ *    Function      : CountDrop
+ *    Class         : NTP_Responder
+ *    Description   : Counts a request the transport had to drop
+ *    Input         : uint8_t netif
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_Responder::CountDrop( uint8_t netif ){
+  stats[( netif < NTP_INTERFACES ) ? netif : 0].dropped++;
+}
+
+/**************************************************************************************************
+ *    Function      : CountBroadcast
+ *    Class         : NTP_Responder
+ *    Description   : Counts a broadcast or multicast packet sent
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_Responder::CountBroadcast( void ){
+  broadcasts++;
+}
+
+/**************************************************************************************************
+ *    Function      : ClientV4
+ *    Class         : NTP_Responder
+ *    Description   : Returns the client of an IPv4 address
+ *    Input         : uint32_t addr
+ *    Output        : ntp_client_t
+ *    Remarks       : addr in network order
+ **************************************************************************************************/
+ntp_client_t NTP_Responder::ClientV4( uint32_t addr ){
+  ntp_client_t client;
+  client.addr = ntp_addr_from_v4(addr);
+  client.ipv6 = false;
+  client.netif = 0;
+  return client;
+}
+
+/**************************************************************************************************
+ *    Function      : ClientV6
+ *    Class         : NTP_Responder
+ *    Description   : Returns the client of an IPv6 address
+ *    Input         : const uint8_t* addr
+ *    Output        : ntp_client_t
+ *    Remarks       : The 16 bytes in network order, a mapped IPv4 address is the IPv4 client
+ **************************************************************************************************/
+ntp_client_t NTP_Responder::ClientV6( const uint8_t* addr ){
+  ntp_client_t client;
+  client.addr = ntp_addr_from_v6(addr);
+  client.ipv6 = true;
+  client.netif = 0;
+  return client;
+}
+
+/**************************************************************************************************
+ *    Function      : InterfaceOf
+ *    Class         : NTP_Responder
+ *    Description   : Returns the counters and rate limiter a client is accounted with
+ *    Input         : const ntp_client_t* client
+ *    Output        : uint8_t
+ *    Remarks       : Interfaces without their own go with the first one
+ **************************************************************************************************/
+uint8_t NTP_Responder::InterfaceOf( const ntp_client_t* client ){
+  return ( client->netif < NTP_INTERFACES ) ? client->netif : 0;
+}
+
+/**************************************************************************************************
+ *    Function      : Account
+ *    Class         : NTP_Responder
+ *    Description   : Counts a request, records the client and checks its rate limit
+ *    Input         : const ntp_client_t* client, uint32_t hash, uint8_t version, uint8_t mode, ntp_timestamp_t rx
+ *    Output        : ntp_ratelimit_result_t
+ *    Remarks       : hash is the one of ntp_addr_hash under addr_key
+ **************************************************************************************************/
+ntp_ratelimit_result_t NTP_Responder::Account( const ntp_client_t* client, uint32_t hash, uint8_t version, uint8_t mode, ntp_timestamp_t rx ){
+  uint8_t nif = InterfaceOf(client);
+  stats[nif].requests++;
+  if(true == client->ipv6){
+    stats[nif].requests_v6++;
+  } else {
+    stats[nif].requests_v4++;
+  }
+  NTP_MRU_LOCK(&mru_mux);
+  mru.Update(&client->addr, hash, rx, version, mode);
+  NTP_MRU_UNLOCK(&mru_mux);
+  return ratelimit[nif].Check(&client->addr, hash, rx);
+}
+
+/**************************************************************************************************
+ *    Function      : ReadMRU
+ *    Class         : NTP_Responder
+ *    Description   : Reads clients from the MRU list for the mode 6 responder
+ *    Input         : void* mru_ctx, const ntp_mru_resume_t* resume, uint8_t count, ntp_mru_entry_t* out, uint16_t max
+ *    Output        : int32_t
+ *    Remarks       : mru_ctx is the responder, see NTP_MRUList::GetNewer. The mode 6 responder only
+ *                    has the addresses of the resume points, they are hashed here
+ **************************************************************************************************/
+int32_t NTP_Responder::ReadMRU( void* mru_ctx, const ntp_mru_resume_t* resume, uint8_t count, ntp_mru_entry_t* out, uint16_t max ){
+  NTP_Responder* self = (NTP_Responder*)mru_ctx;
+  ntp_mru_resume_t hashed[NTP_CONTROL_MRU_RESUME_MAX];
+  int32_t copied;
+  if(count > NTP_CONTROL_MRU_RESUME_MAX){
+    count = NTP_CONTROL_MRU_RESUME_MAX;
+  }
+  for(uint8_t i=0;i<count;i++){
+    hashed[i] = resume[i];
+    hashed[i].hash = ntp_addr_hash(&resume[i].client, self->addr_key);
+  }
+  NTP_MRU_LOCK(&self->mru_mux);
+  copied = self->mru.GetNewer(hashed, count, out, max);
+  NTP_MRU_UNLOCK(&self->mru_mux);
+  return copied;
+}
+
+/**************************************************************************************************
+ *    Function      : Control
+ *    Class         : NTP_Responder
+ *    Description   : Answers a mode 6 request
+ *    Input         : const ntp_client_t* client, const uint8_t* data, uint16_t len, ntp_timestamp_t rx,
+ *                    ntp_control_send_t send, void* ctx
+ *    Output        : none
+ *    Remarks       : The variables are taken from the live state, nothing is allocated
+ **************************************************************************************************/
+void NTP_Responder::Control( const ntp_client_t* client, const uint8_t* data, uint16_t len, ntp_timestamp_t rx, ntp_control_send_t send, void* ctx ){
+  ntp_control_sysvars_t vars;
+  ntp_server_stats_t* nif_stats = &stats[InterfaceOf(client)];
+  uint32_t hash = ntp_addr_hash(&client->addr, addr_key);
+  /* Never answered with a KoD, a client over the limit gets nothing */
+  if( NTP_RATELIMIT_PASS != Account(client, hash, ( data[0] >> 3 ) & 0x07, data[0] & 0x07, rx) ){
+    nif_stats->dropped++;
+    return;
+  }
+  /* The system variables are the ones of the whole server */
+  ntp_server_stats_t total = GetStats();
+  ntp_ratelimit_stats_t rl_stats = GetRateLimitStats();
+  vars.state = GetServerState();
+  vars.clock = rx;
+  vars.offset = 0;
+  vars.jitter = 0;
+  vars.uptime = 0;
+  if(read_sysvars != NULL){
+    read_sysvars(&vars);
+  }
+  vars.received = total.requests;
+  vars.processed = total.responses;
+  vars.declined = total.dropped;
+  vars.limited = rl_stats.limited;
+  vars.kodsent = rl_stats.kod;
+  nif_stats->responses += control.Process(data, len, hash, &vars, NTP_Responder::ReadMRU, this, send, ctx);
+}
+
+/**************************************************************************************************
+ *    Function      : Respond
+ *    Class         : NTP_Responder
+ *    Description   : Builds the response for a client request
+ *    Input         : const ntp_client_t* client, const uint8_t* data, uint16_t len, uint8_t* out,
+ *                    ntp_timestamp_t rx, uint32_t tx_advance
+ *    Output        : uint16_t ( length of the response, 0 if nothing shall be sent )
+ *    Remarks       : out needs room for len bytes, the response is never longer than the request.
+ *                    Only mode 3 is answered, other modes are not counted or recorded.
+ *                    Answers in interleaved mode if the client asks for it. The transmit timestamp
+ *                    is advanced by tx_advance ( 1/2^32 s ), the delay left until the packet is sent
+ **************************************************************************************************/
+uint16_t NTP_Responder::Respond( const ntp_client_t* client, const uint8_t* data, uint16_t len, uint8_t* out, ntp_timestamp_t rx, uint32_t tx_advance ){
+  ntp_responder_slots_t slots;
+  Acquire(&slots);
+  uint16_t resp_len = Answer(&slots, client, data, len, out, rx, tx_advance);
+  Release(&slots);
+  return resp_len;
+}
+
+/**************************************************************************************************
+ *    Function      : Answer
+ *    Class         : NTP_Responder
+ *    Description   : Builds the response for a client request
+ *    Input         : const ntp_responder_slots_t* slots, const ntp_client_t* client,
+ *                    const uint8_t* data, uint16_t len, uint8_t* out, ntp_timestamp_t rx,
+ *                    uint32_t tx_advance
+ *    Output        : uint16_t ( length of the response, 0 if nothing shall be sent )
+ *    Remarks       : See Respond, the header and keys are the ones in slots
+ **************************************************************************************************/
+uint16_t NTP_Responder::Answer( const ntp_responder_slots_t* slots, const ntp_client_t* client, const uint8_t* data, uint16_t len, uint8_t* out, ntp_timestamp_t rx, uint32_t tx_advance ){
+  ntp_timestamp_t prev_tx;
+  ntp_time64_t rx64 = ntp_time64_from_timestamp(rx);
+  ntp_packet_info_t info;
+  ntp_nts_request_t nts_req;
+  ntp_packet_t req;
+  ntp_packet_t resp;
+  const ntp_packet_t* tmpl = &header[slots->header];
+  ntp_server_stats_t* nif_stats = &stats[InterfaceOf(client)];
+  uint16_t resp_len = sizeof(ntp_packet_t);
+  memset(&last_stamp, 0, sizeof(last_stamp));
+  if( (len > NTP_PACKET_MAX_LEN) || (false == ntp_parse_packet(data, len, &info)) ){
+    return 0;
+  }
+  /* The data may not be aligned, so we work on a copy */
+  memcpy(&req, data, sizeof(ntp_packet_t));
+  /* Only client requests are answered. A server or broadcast packet answered would be answered
+     back by the box that sent it, two servers would keep each other busy */
+  if(req.flags.mode != 3){
+    return 0;
+  }
+  /* Keyed, so a client can't pick addresses that land in the slots of another one */
+  uint32_t hash = ntp_addr_hash(&client->addr, addr_key);
+  switch( Account(client, hash, req.flags.vn, req.flags.mode, rx) ){
+    case NTP_RATELIMIT_KOD:{
+      ntp_build_kod(&resp, tmpl, &req, rx64, "RATE");
+      memcpy(out, &resp, sizeof(ntp_packet_t));
+      return sizeof(ntp_packet_t);
+    }
+
+    case NTP_RATELIMIT_DROP:{
+      nif_stats->dropped++;
+      return 0;
+    }
+
+    default:{
+    } break;
+  }
+
+  /* The client transmit time against our receive time, only clients within the limit count */
+  NTP_MRU_LOCK(&mru_mux);
+  census.Add(&client->addr, hash, ntp_read_transmit(&req), rx64);
+  NTP_MRU_UNLOCK(&mru_mux);
+
+  /* The cookie and authenticator are only checked once the client passed the rate limit */
+  NTP_NTS* srv_nts = &nts[slots->nts];
+  ntp_nts_result_t nts_result = srv_nts->Verify(data, len, &info, &nts_req, out);
+  switch(nts_result){
+    case NTP_NTS_DROP:{
+      nif_stats->dropped++;
+      return 0;
+    }
+
+    case NTP_NTS_NAK:{
+      nif_stats->ntsnak++;
+      ntp_build_kod(&resp, tmpl, &req, rx64, "NTSN");
+      memcpy(out, &resp, sizeof(ntp_packet_t));
+      return srv_nts->Nak(&nts_req, data, out);
+    }
+
+    default:{
+    } break;
+  }
+
+  /* Extension fields we don't know are ignored, only the MAC is checked */
+  NTP_KeyTable* srv_keys = &keys[slots->keys];
+  int8_t key = -1;
+  if( (nts_result == NTP_NTS_NONE) && (info.mac_len > 0) ){
+    key = srv_keys->Find(info.keyid);
+    if( false == srv_keys->Verify(key, data, info.mac_offset, &data[info.mac_offset], info.mac_len) ){
+      nif_stats->authfailed++;
+      ntp_build_response(&resp, tmpl, &req, rx64);
+      ntp_stamp_transmit(&resp, Transmit(tx_advance));
+      memcpy(out, &resp, sizeof(ntp_packet_t));
+      memset(&out[sizeof(ntp_packet_t)], 0, NTP_CRYPTO_NAK_LEN);
+      return sizeof(ntp_packet_t) + NTP_CRYPTO_NAK_LEN;
+    }
+    nif_stats->authenticated++;
+  }
+
+  if(nts_result == NTP_NTS_OK){
+    /* The new cookies are made before the transmit timestamp is taken, only the seal follows it */
+    nif_stats->nts++;
+    resp_len = srv_nts->Prepare(&nts_req, data, len, out);
+  }
+
+  if( true == interleave.Lookup(&client->addr, hash, &req, &prev_tx) ){
+    nif_stats->interleaved++;
+    ntp_build_interleaved_response(&resp, tmpl, &req, rx64, ntp_time64_from_timestamp(prev_tx));
+  } else {
+    ntp_build_response(&resp, tmpl, &req, rx64);
+    /* The transmit timestamp is taken as late as possible, the MAC has to cover it */
+    ntp_stamp_transmit(&resp, Transmit(tx_advance));
+  }
+  memcpy(out, &resp, sizeof(ntp_packet_t));
+  if(nts_result == NTP_NTS_OK){
+    srv_nts->Seal(&nts_req, out);
+  } else if(key >= 0){
+    resp_len += srv_keys->Sign(key, out, sizeof(ntp_packet_t));
+  }
+  return resp_len;
+}
+
+/**************************************************************************************************
+ *    Function      : Transmit
+ *    Class         : NTP_Responder
+ *    Description   : Reads the clock for a transmit timestamp
+ *    Input         : uint32_t advance
+ *    Output        : ntp_time64_t
+ *    Remarks       : The reading is kept for GetLastStamp, the advance is added to the returned time
+ **************************************************************************************************/
+ntp_time64_t NTP_Responder::Transmit( uint32_t advance ){
+  last_stamp = read_time();
+  return ntp_time64_from_timestamp(last_stamp) + advance;
+}
+
+/**************************************************************************************************
+ *    Function      : GetLastStamp
+ *    Class         : NTP_Responder
+ *    Description   : Returns the clock reading the last transmit timestamp was made from
+ *    Input         : none
+ *    Output        : ntp_timestamp_t
+ *    Remarks       : Without the advance, zero if the last response had no fresh transmit timestamp
+ **************************************************************************************************/
+ntp_timestamp_t NTP_Responder::GetLastStamp( void ){
+  return last_stamp;
+}
+
+/**************************************************************************************************
+ *    Function      : Sent
+ *    Class         : NTP_Responder
+ *    Description   : Takes the real transmit time of a response
+ *    Input         : const ntp_client_t* client, ntp_timestamp_t rx, ntp_timestamp_t tx
+ *    Output        : none
+ *    Remarks       : The time is returned with the next interleaved response to this client
+ **************************************************************************************************/
+void NTP_Responder::Sent( const ntp_client_t* client, ntp_timestamp_t rx, ntp_timestamp_t tx ){
+  stats[InterfaceOf(client)].responses++;
+  interleave.Store(&client->addr, ntp_addr_hash(&client->addr, addr_key), rx, tx);
+}
@@ -0,0 +1,336 @@
+#ifndef NTP_RESPONDER_H_
+ #define NTP_RESPONDER_H_
+
+#include <stdint.h>
+#include "ntp_packet.h"
+#include "ntp_interleave.h"
+#include "ntp_ratelimit.h"
+#include "ntp_mru.h"
+#include "ntp_census.h"
+#include "ntp_control.h"
+#include "ntp_auth.h"
+#include "ntp_nts.h"
+#include "ntp_addr.h"
+
+#ifdef ARDUINO
+ #include "Arduino.h"
+#else
+ #include <pthread.h>
+#endif
+
+/* Stratum of an unsynchronized server */
+#define NTP_STRATUM_UNSYNC ( 16 )
+
+/*
+ * Interfaces with their own request counters and rate limiter, so the load of one
+ * network can't starve the other. The index follows tcpip_adapter_if_t, STA and AP,
+ * requests from other interfaces are counted with the first one
+ */
+#ifndef NTP_INTERFACES
+ #ifdef ARDUINO
+  #define NTP_INTERFACES ( 2 )
+ #else
+  #define NTP_INTERFACES ( 1 )
+ #endif
+#endif
+
+/* Secret of SetSalt, the key of the client hash and the one of the mode 6 nonces */
+#define NTP_RESPONDER_SALT_LEN ( NTP_ADDR_KEY_LEN + 4 )
+
+/* Largest root dispersion, 16 seconds in NTP short format */
+#define NTP_MAX_DISPERSION ( 16ul << 16 )
+
+typedef struct {
+  uint32_t requests;    /* Valid requests received */
+  uint32_t requests_v4; /* Of them received over IPv4 */
+  uint32_t requests_v6; /* Of them received over IPv6 */
+  uint32_t responses;   /* Responses sent, including KoD */
+  uint32_t interleaved; /* Responses sent in interleaved mode */
+  uint32_t dropped;     /* Requests dropped as the server was busy or the client over the limit */
+  uint32_t broadcasts;  /* Broadcast and multicast packets sent */
+  uint32_t authenticated; /* Requests with a valid MAC */
+  uint32_t authfailed;  /* Requests with an unknown key or a bad MAC, answered with a crypto-NAK */
+  uint32_t nts;         /* Requests with a valid NTS cookie and authenticator */
+  uint32_t ntsnak;      /* NTS requests answered with a NTSN Kiss-o'-Death */
+} ntp_server_stats_t;
+
+/* A client as the per client tables know it */
+typedef struct {
+  ntp_addr_t addr;      /* Full address, the tables compare all of it */
+  bool ipv6;
+  uint8_t netif;        /* Interface the request came in on, see NTP_INTERFACES */
+} ntp_client_t;
+
+/* Buffers one response is built from, see NTP_Responder::Acquire */
+typedef struct {
+  uint8_t header;
+  uint8_t keys;
+  uint8_t nts;
+} ntp_responder_slots_t;
+
+/* Fills the mode 6 variables only the clock knows, offset, jitter and uptime */
+typedef void (*ntp_sysvars_fnc_t)( ntp_control_sysvars_t* vars );
+
+/*
+ * The packet logic of the server, independent of the transport. Rate limit,
+ * client list and interleave table are part of the object, so a transport
+ * that serves from more than one thread uses one responder per thread and
+ * sends all requests of a client to the same one. Only the client list may
+ * be read from other threads.
+ */
+class NTP_Responder {
+
+public:
+    NTP_Responder( );
+    ~NTP_Responder( );
+
+    /**************************************************************************************************
+     *    Function      : SetClock
+     *    Class         : NTP_Responder
+     *    Description   : Sets where the transmit time and the mode 6 clock variables come from
+     *    Input         : ntp_timestamp_t(*fnc_get_ntp_time)(void), ntp_sysvars_fnc_t fnc_sysvars
+     *    Output        : none
+     *    Remarks       : fnc_sysvars may be NULL
+     **************************************************************************************************/
+    void SetClock( ntp_timestamp_t(*fnc_get_ntp_time)(void), ntp_sysvars_fnc_t fnc_sysvars );
+
+    /**************************************************************************************************
+     *    Function      : SetServerState
+     *    Class         : NTP_Responder
+     *    Description   : Rebuilds the response header
+     *    Input         : const ntp_server_state_t* state
+     *    Output        : none
+     *    Remarks       : The header is built in the spare buffer and swapped in, once no response in
+     *                    flight uses the spare one any more. Not to be called from two tasks at once
+     **************************************************************************************************/
+    void SetServerState( const ntp_server_state_t* state );
+
+    /**************************************************************************************************
+     *    Function      : GetServerState
+     *    Class         : NTP_Responder
+     *    Description   : Returns the state the response header is built from
+     *    Input         : none
+     *    Output        : ntp_server_state_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    ntp_server_state_t GetServerState( void );
+
+    /**************************************************************************************************
+     *    Function      : GetTemplate
+     *    Class         : NTP_Responder
+     *    Description   : Returns the response header in use
+     *    Input         : none
+     *    Output        : ntp_packet_t
+     *    Remarks       : A copy, the buffer may be rebuilt as soon as the next header is swapped in
+     **************************************************************************************************/
+    ntp_packet_t GetTemplate( void );
+
+    /**************************************************************************************************
+     *    Function      : SetKeys
+     *    Class         : NTP_Responder
+     *    Description   : Loads the symmetric keys
+     *    Input         : const ntp_keys_settings_t* conf
+     *    Output        : none
+     *    Remarks       : The keys are prepared in the spare table, the one in use is left alone.
+     *                    Not to be called from two tasks at once
+     **************************************************************************************************/
+    void SetKeys( const ntp_keys_settings_t* conf );
+
+    /**************************************************************************************************
+     *    Function      : SetNTS
+     *    Class         : NTP_Responder
+     *    Description   : Loads the NTS master keys
+     *    Input         : const nts_settings_t* conf
+     *    Output        : none
+     *    Remarks       : The keys are prepared in the spare slot, the one in use is left alone.
+     *                    Not to be called from two tasks at once
+     **************************************************************************************************/
+    void SetNTS( const nts_settings_t* conf );
+
+    /**************************************************************************************************
+     *    Function      : SetSalt
+     *    Class         : NTP_Responder
+     *    Description   : Sets the secret the client hash and the mode 6 nonces are derived from
+     *    Input         : const uint8_t* salt
+     *    Output        : none
+     *    Remarks       : NTP_RESPONDER_SALT_LEN random bytes. The client hash places the clients in
+     *                    the tables, known to a client it could pick addresses that crowd out others.
+     *                    Call it before the first request, the tables are not rehashed
+     **************************************************************************************************/
+    void SetSalt( const uint8_t* salt );
+
+    void SetRateLimit( ratelimit_settings_t conf );
+    ratelimit_settings_t GetRateLimit( void );
+    ntp_ratelimit_stats_t GetRateLimitStats( void );
+    ntp_ratelimit_stats_t GetRateLimitStats( uint8_t netif );
+    ntp_server_stats_t GetStats( void );
+    ntp_server_stats_t GetStats( uint8_t netif );
+
+    /**************************************************************************************************
+     *    Function      : GetClients
+     *    Class         : NTP_Responder
+     *    Description   : Copies a part of the client list, most recently seen client first
+     *    Input         : ntp_mru_entry_t* out, uint16_t start, uint16_t max
+     *    Output        : uint16_t ( entries copied )
+     *    Remarks       : Safe to call from another thread
+     **************************************************************************************************/
+    uint16_t GetClients( ntp_mru_entry_t* out, uint16_t start, uint16_t max );
+    uint16_t GetClientCount( void );
+
+    /**************************************************************************************************
+     *    Function      : GetCensus
+     *    Class         : NTP_Responder
+     *    Description   : Returns the population histogram of the client clock errors
+     *    Input         : none
+     *    Output        : ntp_census_stats_t
+     *    Remarks       : Safe to call from another thread
+     **************************************************************************************************/
+    ntp_census_stats_t GetCensus( void );
+
+    /**************************************************************************************************
+     *    Function      : GetCensusFlagged
+     *    Class         : NTP_Responder
+     *    Description   : Copies the clients whose clocks are far off or drifting
+     *    Input         : ntp_census_entry_t* out, uint16_t max
+     *    Output        : uint16_t ( entries copied )
+     *    Remarks       : Safe to call from another thread
+     **************************************************************************************************/
+    uint16_t GetCensusFlagged( ntp_census_entry_t* out, uint16_t max );
+
+    /**************************************************************************************************
+     *    Function      : CountDrop
+     *    Class         : NTP_Responder
+     *    Description   : Counts a request the transport had to drop
+     *    Input         : uint8_t netif
+     *    Output        : none
+     *    Remarks       : none
+     **************************************************************************************************/
+    void CountDrop( uint8_t netif );
+
+    /**************************************************************************************************
+     *    Function      : CountBroadcast
+     *    Class         : NTP_Responder
+     *    Description   : Counts a broadcast or multicast packet sent
+     *    Input         : none
+     *    Output        : none
+     *    Remarks       : none
+     **************************************************************************************************/
+    void CountBroadcast( void );
+
+    /**************************************************************************************************
+     *    Function      : Respond
+     *    Class         : NTP_Responder
+     *    Description   : Builds the response for a client request
+     *    Input         : const ntp_client_t* client, const uint8_t* data, uint16_t len, uint8_t* out,
+     *                    ntp_timestamp_t rx, uint32_t tx_advance
+     *    Output        : uint16_t ( length of the response, 0 if nothing shall be sent )
+     *    Remarks       : out needs room for len bytes, the response is never longer than the request.
+     *                    Only mode 3 is answered, other modes are not counted or recorded.
+     *                    Answers in interleaved mode if the client asks for it. The transmit timestamp
+     *                    is advanced by tx_advance ( 1/2^32 s ), the delay left until the packet is sent
+     **************************************************************************************************/
+    uint16_t Respond( const ntp_client_t* client, const uint8_t* data, uint16_t len, uint8_t* out, ntp_timestamp_t rx, uint32_t tx_advance );
+
+    /**************************************************************************************************
+     *    Function      : GetLastStamp
+     *    Class         : NTP_Responder
+     *    Description   : Returns the clock reading the last transmit timestamp was made from
+     *    Input         : none
+     *    Output        : ntp_timestamp_t
+     *    Remarks       : Without the advance, zero if the last response had no fresh transmit timestamp
+     **************************************************************************************************/
+    ntp_timestamp_t GetLastStamp( void );
+
+    /**************************************************************************************************
+     *    Function      : Control
+     *    Class         : NTP_Responder
+     *    Description   : Answers a mode 6 request
+     *    Input         : const ntp_client_t* client, const uint8_t* data, uint16_t len, ntp_timestamp_t rx,
+     *                    ntp_control_send_t send, void* ctx
+     *    Output        : none
+     *    Remarks       : The variables are taken from the live state, nothing is allocated
+     **************************************************************************************************/
+    void Control( const ntp_client_t* client, const uint8_t* data, uint16_t len, ntp_timestamp_t rx, ntp_control_send_t send, void* ctx );
+
+    /**************************************************************************************************
+     *    Function      : Sent
+     *    Class         : NTP_Responder
+     *    Description   : Takes the real transmit time of a response
+     *    Input         : const ntp_client_t* client, ntp_timestamp_t rx, ntp_timestamp_t tx
+     *    Output        : none
+     *    Remarks       : The time is returned with the next interleaved response to this client
+     **************************************************************************************************/
+    void Sent( const ntp_client_t* client, ntp_timestamp_t rx, ntp_timestamp_t tx );
+
+    /**************************************************************************************************
+     *    Function      : ClientV4
+     *    Class         : NTP_Responder
+     *    Description   : Returns the client of an IPv4 address
+     *    Input         : uint32_t addr
+     *    Output        : ntp_client_t
+     *    Remarks       : addr in network order
+     **************************************************************************************************/
+    static ntp_client_t ClientV4( uint32_t addr );
+
+    /**************************************************************************************************
+     *    Function      : ClientV6
+     *    Class         : NTP_Responder
+     *    Description   : Returns the client of an IPv6 address
+     *    Input         : const uint8_t* addr
+     *    Output        : ntp_client_t
+     *    Remarks       : The 16 bytes in network order, a mapped IPv4 address is the IPv4 client
+     **************************************************************************************************/
+    static ntp_client_t ClientV6( const uint8_t* addr );
+
+private:
+    ntp_timestamp_t(*read_time)(void);
+    ntp_sysvars_fnc_t read_sysvars;
+    /* Key of ntp_addr_hash for the client tables */
+    uint8_t addr_key[NTP_ADDR_KEY_LEN];
+    /* Counters and rate limiter per interface, broadcasts belong to none of them */
+    ntp_server_stats_t stats[NTP_INTERFACES];
+    NTP_RateLimiter ratelimit[NTP_INTERFACES];
+    uint32_t broadcasts;
+
+    /* The response header is kept pre encoded, a new one is built in the spare buffer and swapped in */
+    ntp_packet_t header[2];
+    volatile uint8_t header_idx;
+    ntp_server_state_t header_state;
+
+    NTP_InterleaveTable interleave;
+    NTP_ControlResponder control;
+
+    /* Clients seen and the census of their clocks, the only tables read from other threads */
+    NTP_MRUList mru;
+    NTP_ClientCensus census;
+#ifdef ARDUINO
+    portMUX_TYPE mru_mux;
+#else
+    pthread_mutex_t mru_mux;
+#endif
+
+    /* Symmetric keys and NTS master keys, a new set is loaded into the spare one and swapped in */
+    NTP_KeyTable keys[2];
+    volatile uint8_t keys_idx;
+    NTP_NTS nts[2];
+    volatile uint8_t nts_idx;
+
+    /* Responses in flight per buffer, counted under mru_mux. A spare is only rebuilt once its count is 0 */
+    volatile uint16_t header_users[2];
+    volatile uint16_t keys_users[2];
+    volatile uint16_t nts_users[2];
+
+    /* Clock reading behind the transmit timestamp of the last response */
+    ntp_timestamp_t last_stamp;
+
+    static uint8_t InterfaceOf( const ntp_client_t* client );
+    ntp_ratelimit_result_t Account( const ntp_client_t* client, uint32_t hash, uint8_t version, uint8_t mode, ntp_timestamp_t rx );
+    ntp_time64_t Transmit( uint32_t advance );
+    void WaitSpare( volatile uint16_t* users, uint8_t spare );
+    void Acquire( ntp_responder_slots_t* slots );
+    void Release( const ntp_responder_slots_t* slots );
+    uint16_t Answer( const ntp_responder_slots_t* slots, const ntp_client_t* client, const uint8_t* data, uint16_t len, uint8_t* out, ntp_timestamp_t rx, uint32_t tx_advance );
+    static int32_t ReadMRU( void* mru_ctx, const ntp_mru_resume_t* resume, uint8_t count, ntp_mru_entry_t* out, uint16_t max );
+};
+
+#endif
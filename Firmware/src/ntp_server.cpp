@@ -1,55 +1,84 @@
 #include "Arduino.h"
 #include "ntp_server.h"
-#include <lwip/def.h>
+#include "ntp_packet.h"
+#include "ntp_responder.h"
+#include "ntp_broadcast.h"
+#include "ntp_latency.h"
+#include "ntp_txcal.h"
+#include "ntp_precision.h"
+#include "tcpip_adapter.h"
+#include "lwip/udp.h"
+#include "lwip/priv/tcpip_priv.h"
 
-#define NTP_TIMESTAMP_DELTA  2208988800ull
+ntp_timestamp_t(*fnc_read_ntp_time)(void) = NULL;
 
-//this will try to get ms since PPS
+/* Resolution and read cost of the clock, measured again from the loop if its source changes */
+ntp_precision_t ntp_precision;
+timecore_sync_t ntp_precision_sync;
+volatile bool ntp_precision_due = false;
 
-typedef struct{
-    uint8_t mode:3;               // mode. Three bits. Client will pick mode 3 for client.
-    uint8_t vn:3;                 // vn.   Three bits. Version number of the protocol.
-    uint8_t li:2;                 // li.   Two bits.   Leap indicator.
-}ntp_flags_t;
-  
-typedef union {
-    uint32_t data;
-    uint8_t byte[4];
-    char c_str[4];
-} refID_t;
+/* The packet logic and the per client tables, fed by the transport below */
+NTP_Responder ntp_responder;
 
-typedef struct
-{
+/* Cycles a request spends from arrival to being sent, per stage, for all and per interface */
+NTP_LatencyStats ntp_latency;
+NTP_LatencyStats ntp_latency_nif[NTP_INTERFACES];
 
-  ntp_flags_t flags;
-  uint8_t stratum;         // Eight bits. Stratum level of the local clock.
-  uint8_t poll;            // Eight bits. Maximum interval between successive messages.
-  uint8_t precision;       // Eight bits. Precision of the local clock.
+/* Delay between the transmit timestamp and the send, per interface */
+NTP_TxCalibration ntp_txcal;
 
-  uint32_t rootDelay;      // 32 bits. Total round trip delay time.
-  uint32_t rootDispersion; // 32 bits. Max error aloud from primary clock source.
-  refID_t refId;           // 32 bits. Reference clock identifier.
-   
+/* Responses are built here, NTS ones don't fit the stack of the tasks */
+uint8_t ntp_resp_buffer[NTP_PACKET_MAX_LEN];
 
-  uint32_t refTm_s;        // 32 bits. Reference time-stamp seconds.
-  uint32_t refTm_f;        // 32 bits. Reference time-stamp fraction of a second.
+Timecore* ntp_timecore = NULL;
 
-  uint32_t origTm_s;       // 32 bits. Originate time-stamp seconds.
-  uint32_t origTm_f;       // 32 bits. Originate time-stamp fraction of a second.
+/* Mode 5 packets are sent from their own task, woken by every second tick */
+typedef struct {
+  struct tcpip_api_call_data call;
+  struct pbuf* p;
+  const ip_addr_t* addr;
+  uint8_t ttl;
+  err_t err;
+} ntp_bcast_api_call_t;
 
-  uint32_t rxTm_s;         // 32 bits. Received time-stamp seconds.
-  uint32_t rxTm_f;         // 32 bits. Received time-stamp fraction of a second.
+broadcast_settings_t ntp_bcast_conf;
+struct udp_pcb* ntp_bcast_pcb = NULL;
+uint16_t ntp_bcast_port = 123;
+ip_addr_t ntp_mcast_addr;
+TaskHandle_t ntp_bcast_task = NULL;
 
-  uint32_t txTm_s;         // 32 bits and the most important field the client cares about. Transmit time-stamp seconds.
-  uint32_t txTm_f;         // 32 bits. Transmit time-stamp fraction of a second.
+#if ( NTP_USE_RAW_LWIP > 0 )
 
-} ntp_packet_t;    
+/* A request handed from the lwIP receive callback to the responder task */
+typedef struct {
+  struct pbuf* p;
+  ip_addr_t addr;
+  uint16_t port;
+  ntp_timestamp_t rx;
+  uint32_t cycles;
+  uint8_t netif;
+} ntp_raw_request_t;
 
-uint8_t __calloverhead = 0;
+/* Calls into lwIP need to be done from the tcpip thread */
+typedef struct {
+  struct tcpip_api_call_data call;
+  struct udp_pcb* pcb;
+  struct pbuf* p;
+  const ip_addr_t* addr;
+  uint16_t port;
+  err_t err;
+} ntp_raw_api_call_t;
+
+/* One queue per interface, so a flood on one network can't fill the slots of the other */
+struct udp_pcb* ntp_pcb = NULL;
+QueueHandle_t ntp_raw_queue[NTP_INTERFACES];
+TaskHandle_t ntp_raw_task = NULL;
+
+#else
 
 AsyncUDP udp;
-uint32_t(*fnc_read_utc)(void) = NULL;
-uint32_t(*fnc_read_subsecond)(void) = NULL;
+
+#endif
 
 NTP_Server::NTP_Server( ){
     
@@ -61,35 +90,841 @@ NTP_Server::~NTP_Server(){
 }
 
 
-uint8_t DeterminePrecision( void ){
-    /* We need to compute the call overhead */
-    uint32_t utc_read=0;
-    uint32_t mil_read=0;
-    if(fnc_read_utc!=NULL){
-      uint32_t start = micros();
-      for(uint32_t i=0;i<1024;i++){
-        utc_read=fnc_read_utc();
-        mil_read=fnc_read_subsecond();
+/**************************************************************************************************
+ *    Function      : MeasurePrecision
+ *    Class         : NTP_Server
+ *    Description   : Asks for the clock precision to be measured again
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : The measurement is taken by PrecisionService
+ **************************************************************************************************/
+void NTP_Server::MeasurePrecision( void ){
+    ntp_precision_due = true;
+}
+
+/**************************************************************************************************
+ *    Function      : PrecisionService
+ *    Class         : NTP_Server
+ *    Description   : Measures the resolution of the clock and the time it takes to read it, if asked
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : Busy reads the clock for a few ms, so it is called from the loop and never from
+ *                    a timer. The next RefreshServerState puts the result into the response header
+ **************************************************************************************************/
+void NTP_Server::PrecisionService( void ){
+    if(false == ntp_precision_due){
+      return;
+    }
+    ntp_precision_due = false;
+    ntp_precision = ntp_measure_precision(fnc_read_ntp_time);
+}
+
+/**************************************************************************************************
+ *    Function      : GetPrecision
+ *    Class         : NTP_Server
+ *    Description   : Returns the last measurement of the clock precision
+ *    Input         : none
+ *    Output        : ntp_precision_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_precision_t NTP_Server::GetPrecision( void ){
+    return ntp_precision;
+}
+
+/**************************************************************************************************
+ *    Function      : UpdateServerState
+ *    Class         : NTP_Server
+ *    Description   : Sets the stratum, leap, refid, dispersion and reference time for responses
+ *    Input         : ntp_server_state_t state
+ *    Output        : none
+ *    Remarks       : The response template is only rebuilt if the state has changed
+ **************************************************************************************************/
+void NTP_Server::UpdateServerState( ntp_server_state_t state ){
+    /* The precision is measured by the server itself */
+    state.precision = ntp_precision.precision;
+    ntp_server_state_t current = ntp_responder.GetServerState();
+    if( (state.leap == current.leap) &&
+        (state.stratum == current.stratum) &&
+        (state.precision == current.precision) &&
+        (0 == memcmp(state.refid, current.refid, sizeof(state.refid) ) ) &&
+        (state.rootDelay == current.rootDelay) &&
+        (state.rootDispersion == current.rootDispersion) &&
+        (state.reference == current.reference) ){
+      return;
+    }
+    ntp_responder.SetServerState(&state);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_state_from_timecore
+ *    Description   : Builds the server state from the sync state of the clock
+ *    Input         : Timecore* tc, ntp_server_state_t* state
+ *    Output        : none
+ *    Remarks       : The root dispersion grows with the frequency error since the clock was last disciplined,
+ *                    in holdover with the error predicted for it
+ **************************************************************************************************/
+static void ntp_state_from_timecore( Timecore* tc, ntp_server_state_t* state ){
+    timecore_sync_t sync = tc->GetSyncState();
+    memset(state, 0, sizeof(ntp_server_state_t));
+    state->rootDelay = 0;
+    if(false == sync.synced){
+      state->leap = 3;
+      state->stratum = NTP_STRATUM_UNSYNC;
+      memcpy(state->refid, "INIT", sizeof(state->refid));
+      state->rootDispersion = NTP_MAX_DISPERSION;
+      return;
+    }
+
+    state->leap = tc->GetLeapIndicator();
+    if(sync.source == GPS_CLOCK){
+      state->stratum = 1;
+      memcpy(state->refid, ( ( true == sync.pps ) ? "PPS\0" : "GPS\0" ), sizeof(state->refid));
+    } else if(sync.source == RTC_CLOCK){
+      state->stratum = NTP_STRATUM_LOCAL;
+      memcpy(state->refid, "RTC\0", sizeof(state->refid));
+    } else {
+      state->stratum = NTP_STRATUM_LOCAL;
+      memcpy(state->refid, "LOCL", sizeof(state->refid));
+    }
+
+    /* The last PPS edge or the time set by a source, whatever was last */
+    uint64_t dispersion;
+    ntp_time64_t last;
+    if( (sync.last_pps != 0) && (ntp_time64_diff(sync.last_pps, sync.last_set) >= 0) ){
+      last = sync.last_pps;
+      dispersion = tc->GetPPSJitter();
+    } else {
+      last = sync.last_set;
+      dispersion = NTP_DISPERSION_NO_PPS;
+    }
+    if( false == sync.pps ){
+      if( (true == sync.holdover) && (last == sync.last_pps) ){
+        /* Predicted second by second from the temperature since the edge */
+        dispersion += sync.holdover_error;
+      } else {
+        /* parts per billion times seconds gives nanoseconds */
+        dispersion += (uint64_t)tc->GetFrequencyError() * ntp_time64_seconds( sync.now - last );
       }
-      uint32_t end=micros();
-      double runtime = ( ((double)(end)-(double)(start) ) / ( (double)(1000000.0) * (double)(1024) ) )+((double)(1)) ; // One second as we don't keep track on the fractions
-      __calloverhead = log2(runtime);
+    }
+    if( dispersion >= ( (uint64_t)( NTP_MAX_DISPERSION >> 16 ) * 1000000000 ) ){
+      state->rootDispersion = NTP_MAX_DISPERSION;
+    } else {
+      state->rootDispersion = (uint32_t)( ( dispersion << 16 ) / 1000000000 );
+    }
+    state->reference = last;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_sysvars
+ *    Description   : Fills the mode 6 variables only the clock knows
+ *    Input         : ntp_control_sysvars_t* vars
+ *    Output        : none
+ *    Remarks       : Called by the responder for each mode 6 request
+ **************************************************************************************************/
+static void ntp_sysvars( ntp_control_sysvars_t* vars ){
+    if(ntp_timecore != NULL){
+      vars->offset = ntp_timecore->GetPPSOffset();
+      vars->jitter = ntp_timecore->GetPPSJitter();
+    }
+    vars->uptime = millis() / 1000;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_client_of
+ *    Description   : Returns the client an address is kept as in the per client tables
+ *    Input         : const ip_addr_t* addr
+ *    Output        : ntp_client_t
+ *    Remarks       : none
+ **************************************************************************************************/
+static ntp_client_t ntp_client_of( const ip_addr_t* addr ){
+    if( true == IP_IS_V6(addr) ){
+      return NTP_Responder::ClientV6((const uint8_t*)ip_2_ip6(addr)->addr);
+    }
+    return NTP_Responder::ClientV4(ip4_addr_get_u32(ip_2_ip4(addr)));
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_latency_add
+ *    Description   : Counts the stages of an answered request for all and for its interface
+ *    Input         : uint8_t netif, uint32_t dispatch, uint32_t parsed, uint32_t send, uint32_t sent
+ *    Output        : none
+ *    Remarks       : dispatch in cycles, the others are cycle stamps of the answering task.
+ *                    Interfaces without their own stats go with the first one
+ **************************************************************************************************/
+static void ntp_latency_add( uint8_t netif, uint32_t dispatch, uint32_t parsed, uint32_t send, uint32_t sent ){
+    NTP_LatencyStats* nif = &ntp_latency_nif[( netif < NTP_INTERFACES ) ? netif : 0];
+    /* The total starts where the dispatch did, on the clock of the answering task */
+    uint32_t arrival = parsed - dispatch;
+    ntp_latency.Add(NTP_LATENCY_DISPATCH, arrival, parsed);
+    ntp_latency.Add(NTP_LATENCY_RESPOND, parsed, send);
+    ntp_latency.Add(NTP_LATENCY_SEND, send, sent);
+    ntp_latency.Add(NTP_LATENCY_TOTAL, arrival, sent);
+    nif->Add(NTP_LATENCY_DISPATCH, arrival, parsed);
+    nif->Add(NTP_LATENCY_RESPOND, parsed, send);
+    nif->Add(NTP_LATENCY_SEND, send, sent);
+    nif->Add(NTP_LATENCY_TOTAL, arrival, sent);
+}
+
+/**************************************************************************************************
+ *    Function      : GetStats
+ *    Class         : NTP_Server
+ *    Description   : Returns the request and response counters
+ *    Input         : none
+ *    Output        : ntp_server_stats_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_server_stats_t NTP_Server::GetStats( void ){
+    return ntp_responder.GetStats();
+}
+
+/**************************************************************************************************
+ *    Function      : GetStats
+ *    Class         : NTP_Server
+ *    Description   : Returns the request and response counters of one interface
+ *    Input         : uint8_t netif
+ *    Output        : ntp_server_stats_t
+ *    Remarks       : netif as in tcpip_adapter_if_t, broadcasts are not counted per interface
+ **************************************************************************************************/
+ntp_server_stats_t NTP_Server::GetStats( uint8_t netif ){
+    return ntp_responder.GetStats(netif);
+}
+
+/**************************************************************************************************
+ *    Function      : GetLatency
+ *    Class         : NTP_Server
+ *    Description   : Returns the cycles spent in one stage of the packet path
+ *    Input         : ntp_latency_stage_t stage
+ *    Output        : ntp_latency_summary_t
+ *    Remarks       : Only answered requests are counted, all zero if compiled out
+ **************************************************************************************************/
+ntp_latency_summary_t NTP_Server::GetLatency( ntp_latency_stage_t stage ){
+    return ntp_latency.GetSummary(stage);
+}
+
+/**************************************************************************************************
+ *    Function      : GetLatency
+ *    Class         : NTP_Server
+ *    Description   : Returns the cycles spent in one stage of the packet path for one interface
+ *    Input         : uint8_t netif, ntp_latency_stage_t stage
+ *    Output        : ntp_latency_summary_t
+ *    Remarks       : All zero for an interface without its own stats
+ **************************************************************************************************/
+ntp_latency_summary_t NTP_Server::GetLatency( uint8_t netif, ntp_latency_stage_t stage ){
+    ntp_latency_summary_t s;
+    if(netif >= NTP_INTERFACES){
+      memset(&s, 0, sizeof(s));
+      return s;
+    }
+    return ntp_latency_nif[netif].GetSummary(stage);
+}
+
+/**************************************************************************************************
+ *    Function      : SetTxCalibration
+ *    Class         : NTP_Server
+ *    Description   : Sets the transmit delays of the interfaces
+ *    Input         : const ntp_txcal_settings_t* conf
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_Server::SetTxCalibration( const ntp_txcal_settings_t* conf ){
+    ntp_txcal.SetConfig(conf);
+}
+
+/**************************************************************************************************
+ *    Function      : GetTxCalibration
+ *    Class         : NTP_Server
+ *    Description   : Returns the transmit delays of the interfaces
+ *    Input         : none
+ *    Output        : ntp_txcal_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_txcal_settings_t NTP_Server::GetTxCalibration( void ){
+    return ntp_txcal.GetConfig();
+}
+
+/**************************************************************************************************
+ *    Function      : StartTxCalibration
+ *    Class         : NTP_Server
+ *    Description   : Starts to measure the transmit delay of an interface
+ *    Input         : uint8_t netif, uint16_t samples
+ *    Output        : bool
+ *    Remarks       : Samples are taken from the requests answered on that interface
+ **************************************************************************************************/
+bool NTP_Server::StartTxCalibration( uint8_t netif, uint16_t samples ){
+    return ntp_txcal.Start(netif, samples);
+}
+
+/**************************************************************************************************
+ *    Function      : StopTxCalibration
+ *    Class         : NTP_Server
+ *    Description   : Drops a running transmit calibration
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_Server::StopTxCalibration( void ){
+    ntp_txcal.Stop();
+}
+
+/**************************************************************************************************
+ *    Function      : GetTxCalibrationProgress
+ *    Class         : NTP_Server
+ *    Description   : Returns the state of the transmit calibration
+ *    Input         : none
+ *    Output        : ntp_txcal_progress_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_txcal_progress_t NTP_Server::GetTxCalibrationProgress( void ){
+    return ntp_txcal.GetProgress();
+}
+
+/**************************************************************************************************
+ *    Function      : TakeTxCalibration
+ *    Class         : NTP_Server
+ *    Description   : Applies a finished transmit calibration
+ *    Input         : ntp_txcal_settings_t* conf
+ *    Output        : bool
+ *    Remarks       : True once per calibration, conf then holds the config to be stored
+ **************************************************************************************************/
+bool NTP_Server::TakeTxCalibration( ntp_txcal_settings_t* conf ){
+    return ntp_txcal.TakeResult(conf);
+}
+
+/**************************************************************************************************
+ *    Function      : ResetLatency
+ *    Class         : NTP_Server
+ *    Description   : Clears the latency histograms
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_Server::ResetLatency( void ){
+    ntp_latency.Reset();
+    for(uint8_t i=0;i<NTP_INTERFACES;i++){
+      ntp_latency_nif[i].Reset();
+    }
+}
+
+/**************************************************************************************************
+ *    Function      : RefreshServerState
+ *    Class         : NTP_Server
+ *    Description   : Updates the response header from the sync state of the clock
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : Needs a clock set with SetTimecore, call it periodically. A change of the sync
+ *                    source only asks for a new precision, PrecisionService measures it
+ **************************************************************************************************/
+void NTP_Server::RefreshServerState( void ){
+    ntp_server_state_t state;
+    if(ntp_timecore == NULL){
+      return;
+    }
+    /* A new source may interpolate the fraction from a differently measured timebase */
+    timecore_sync_t sync = ntp_timecore->GetSyncState();
+    if( (sync.source != ntp_precision_sync.source) ||
+        (sync.synced != ntp_precision_sync.synced) ||
+        (sync.pps != ntp_precision_sync.pps) ){
+      ntp_precision_sync = sync;
+      ntp_precision_due = true;
+    }
+    ntp_state_from_timecore(ntp_timecore, &state);
+    UpdateServerState(state);
+}
 
-      
+/**************************************************************************************************
+ *    Function      : GetServerState
+ *    Class         : NTP_Server
+ *    Description   : Returns the state the response header is built from
+ *    Input         : none
+ *    Output        : ntp_server_state_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_server_state_t NTP_Server::GetServerState( void ){
+    return ntp_responder.GetServerState();
+}
+
+/**************************************************************************************************
+ *    Function      : SetTimecore
+ *    Class         : NTP_Server
+ *    Description   : Sets the clock the mode 6 variables are read from
+ *    Input         : Timecore* tc
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_Server::SetTimecore( Timecore* tc ){
+    ntp_timecore = tc;
+}
+
+/**************************************************************************************************
+ *    Function      : SetBroadcast
+ *    Class         : NTP_Server
+ *    Description   : Configures the broadcast and multicast mode
+ *    Input         : broadcast_settings_t conf
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_Server::SetBroadcast( broadcast_settings_t conf ){
+    if(conf.poll < NTP_BROADCAST_POLL_MIN){
+      conf.poll = NTP_BROADCAST_POLL_MIN;
+    } else if(conf.poll > NTP_BROADCAST_POLL_MAX){
+      conf.poll = NTP_BROADCAST_POLL_MAX;
+    }
+    if(conf.ttl == 0){
+      conf.ttl = 1;
+    }
+    ntp_bcast_conf = conf;
+}
+
+/**************************************************************************************************
+ *    Function      : GetBroadcast
+ *    Class         : NTP_Server
+ *    Description   : Returns the broadcast and multicast config
+ *    Input         : none
+ *    Output        : broadcast_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+broadcast_settings_t NTP_Server::GetBroadcast( void ){
+    return ntp_bcast_conf;
+}
+
+/**************************************************************************************************
+ *    Function      : SecondTick
+ *    Class         : NTP_Server
+ *    Description   : Needs to be called on every second tick of the clock
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : Can be called from the PPS interrupt, wakes the broadcast task
+ **************************************************************************************************/
+void IRAM_ATTR NTP_Server::SecondTick( void ){
+    if(ntp_bcast_task == NULL){
+      return;
+    }
+    if(xPortInIsrContext()){
+      BaseType_t woken = pdFALSE;
+      vTaskNotifyGiveFromISR(ntp_bcast_task, &woken);
+      if(woken == pdTRUE){
+        portYIELD_FROM_ISR();
+      }
     } else {
-      /* this is a bad one ! */
-      configASSERT( fnc_read_utc != NULL );
+      xTaskNotifyGive(ntp_bcast_task);
     }
-  return 0;
+}
 
-    
+/**************************************************************************************************
+ *    Function      : SetKeys
+ *    Class         : NTP_Server
+ *    Description   : Loads the symmetric keys
+ *    Input         : const ntp_keys_settings_t* conf
+ *    Output        : none
+ *    Remarks       : The keys are prepared in the spare table, the one in use is left alone
+ **************************************************************************************************/
+void NTP_Server::SetKeys( const ntp_keys_settings_t* conf ){
+    ntp_responder.SetKeys(conf);
+}
+
+/**************************************************************************************************
+ *    Function      : SetNTS
+ *    Class         : NTP_Server
+ *    Description   : Loads the NTS master keys
+ *    Input         : const nts_settings_t* conf
+ *    Output        : none
+ *    Remarks       : The keys are prepared in the spare slot, the one in use is left alone
+ **************************************************************************************************/
+void NTP_Server::SetNTS( const nts_settings_t* conf ){
+    ntp_responder.SetNTS(conf);
+}
+
+/**************************************************************************************************
+ *    Function      : GetClients
+ *    Class         : NTP_Server
+ *    Description   : Copies a part of the client list, most recently seen client first
+ *    Input         : ntp_mru_entry_t* out, uint16_t start, uint16_t max
+ *    Output        : uint16_t ( entries copied )
+ *    Remarks       : none
+ **************************************************************************************************/
+uint16_t NTP_Server::GetClients( ntp_mru_entry_t* out, uint16_t start, uint16_t max ){
+    return ntp_responder.GetClients(out, start, max);
+}
+
+/**************************************************************************************************
+ *    Function      : GetClientCount
+ *    Class         : NTP_Server
+ *    Description   : Returns the number of clients in the client list
+ *    Input         : none
+ *    Output        : uint16_t
+ *    Remarks       : none
+ **************************************************************************************************/
+uint16_t NTP_Server::GetClientCount( void ){
+    return ntp_responder.GetClientCount();
 }
 
-bool NTP_Server::begin(uint16_t port , uint32_t(*fnc_getutc_time)(void) , uint32_t(*fnc_get_subsecond)(void) ){
+/**************************************************************************************************
+ *    Function      : GetCensus
+ *    Class         : NTP_Server
+ *    Description   : Returns the population histogram of the client clock errors
+ *    Input         : none
+ *    Output        : ntp_census_stats_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_census_stats_t NTP_Server::GetCensus( void ){
+    return ntp_responder.GetCensus();
+}
+
+/**************************************************************************************************
+ *    Function      : GetCensusFlagged
+ *    Class         : NTP_Server
+ *    Description   : Copies the clients whose clocks are far off or drifting
+ *    Input         : ntp_census_entry_t* out, uint16_t max
+ *    Output        : uint16_t ( entries copied )
+ *    Remarks       : none
+ **************************************************************************************************/
+uint16_t NTP_Server::GetCensusFlagged( ntp_census_entry_t* out, uint16_t max ){
+    return ntp_responder.GetCensusFlagged(out, max);
+}
+
+/**************************************************************************************************
+ *    Function      : SetRateLimit
+ *    Class         : NTP_Server
+ *    Description   : Configures the per client rate limit
+ *    Input         : ratelimit_settings_t conf
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_Server::SetRateLimit( ratelimit_settings_t conf ){
+    ntp_responder.SetRateLimit(conf);
+}
+
+/**************************************************************************************************
+ *    Function      : GetRateLimit
+ *    Class         : NTP_Server
+ *    Description   : Returns the per client rate limit config
+ *    Input         : none
+ *    Output        : ratelimit_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ratelimit_settings_t NTP_Server::GetRateLimit( void ){
+    return ntp_responder.GetRateLimit();
+}
+
+/**************************************************************************************************
+ *    Function      : GetRateLimitStats
+ *    Class         : NTP_Server
+ *    Description   : Returns the rate limiter counters
+ *    Input         : none
+ *    Output        : ntp_ratelimit_stats_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_ratelimit_stats_t NTP_Server::GetRateLimitStats( void ){
+    return ntp_responder.GetRateLimitStats();
+}
+
+/**************************************************************************************************
+ *    Function      : GetRateLimitStats
+ *    Class         : NTP_Server
+ *    Description   : Returns the rate limiter counters of one interface
+ *    Input         : uint8_t netif
+ *    Output        : ntp_ratelimit_stats_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_ratelimit_stats_t NTP_Server::GetRateLimitStats( uint8_t netif ){
+    return ntp_responder.GetRateLimitStats(netif);
+}
+
+#if ( NTP_USE_RAW_LWIP > 0 )
+
+/**************************************************************************************************
+ *    Function      : ntp_interface_of
+ *    Description   : Returns the tcpip_adapter interface a netif belongs to
+ *    Input         : struct netif* nif
+ *    Output        : uint8_t
+ *    Remarks       : TCPIP_ADAPTER_IF_MAX if it is none of them
+ **************************************************************************************************/
+static uint8_t ntp_interface_of( struct netif* nif ){
+    for(uint8_t i=0;i<TCPIP_ADAPTER_IF_MAX;i++){
+      void* adapter_nif = NULL;
+      if( (ESP_OK == tcpip_adapter_get_netif((tcpip_adapter_if_t)i, &adapter_nif)) && (adapter_nif == nif) ){
+        return i;
+      }
+    }
+    return TCPIP_ADAPTER_IF_MAX;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_raw_recv
+ *    Description   : lwIP receive callback, queues the request for the responder task
+ *    Input         : void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t port
+ *    Output        : none
+ *    Remarks       : Runs in the tcpip thread, the receive time is taken here
+ **************************************************************************************************/
+static void ntp_raw_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t port){
+    ntp_raw_request_t req;
+    /* Taken on the core of the tcpip thread, read on the one of the responder task */
+    req.cycles = NTP_LatencyStats::Shared();
+    req.rx = fnc_read_ntp_time();
+    req.netif = ntp_interface_of(ip_current_netif());
+    req.p = p;
+    ip_addr_copy(req.addr, *addr);
+    req.port = port;
+    if( pdTRUE != xQueueSend(ntp_raw_queue[( req.netif < NTP_INTERFACES ) ? req.netif : 0], &req, 0 ) ){
+      ntp_responder.CountDrop(req.netif);
+      pbuf_free(p);
+      return;
+    }
+    /* One notification per queued request */
+    xTaskNotifyGive(ntp_raw_task);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_raw_bind_api
+ *    Description   : Creates and binds the pcb 
+ *    Input         : struct tcpip_api_call_data *api_call_msg
+ *    Output        : err_t
+ *    Remarks       : Runs in the tcpip thread
+ **************************************************************************************************/
+static err_t ntp_raw_bind_api(struct tcpip_api_call_data *api_call_msg){
+    ntp_raw_api_call_t* msg = (ntp_raw_api_call_t*)api_call_msg;
+    /* One pcb of any type takes IPv4 and IPv6 requests */
+    msg->pcb = udp_new_ip_type(IPADDR_TYPE_ANY);
+    if(msg->pcb == NULL){
+      msg->err = ERR_MEM;
+      return msg->err;
+    }
+    msg->err = udp_bind(msg->pcb, IP_ANY_TYPE, msg->port);
+    if(msg->err != ERR_OK){
+      udp_remove(msg->pcb);
+      msg->pcb = NULL;
+      return msg->err;
+    }
+    udp_recv(msg->pcb, ntp_raw_recv, NULL);
+    return msg->err;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_raw_sendto_api
+ *    Description   : Sends a pbuf
+ *    Input         : struct tcpip_api_call_data *api_call_msg
+ *    Output        : err_t
+ *    Remarks       : Runs in the tcpip thread
+ **************************************************************************************************/
+static err_t ntp_raw_sendto_api(struct tcpip_api_call_data *api_call_msg){
+    ntp_raw_api_call_t* msg = (ntp_raw_api_call_t*)api_call_msg;
+    msg->err = udp_sendto(msg->pcb, msg->p, msg->addr, msg->port);
+    return msg->err;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_raw_control_send
+ *    Description   : Sends a mode 6 fragment back to the client of a raw request
+ *    Input         : void* ctx, const uint8_t* data, uint16_t len
+ *    Output        : bool
+ *    Remarks       : ctx is the ntp_raw_request_t that is answered
+ **************************************************************************************************/
+static bool ntp_raw_control_send( void* ctx, const uint8_t* data, uint16_t len ){
+    ntp_raw_request_t* req = (ntp_raw_request_t*)ctx;
+    ntp_raw_api_call_t call;
+    struct pbuf* p = pbuf_alloc(PBUF_TRANSPORT, len, PBUF_RAM);
+    if(p == NULL){
+      return false;
+    }
+    memcpy(p->payload, data, len);
+    call.pcb = ntp_pcb;
+    call.p = p;
+    call.addr = &req->addr;
+    call.port = req->port;
+    tcpip_api_call(ntp_raw_sendto_api, (struct tcpip_api_call_data*)&call);
+    pbuf_free(p);
+    return ( call.err == ERR_OK );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_raw_task_loop
+ *    Description   : Responder task, rewrites the request pbuf into the response and sends it back
+ *    Input         : void* param
+ *    Output        : none
+ *    Remarks       : The queues of the interfaces are served in turns, one request each
+ **************************************************************************************************/
+static void ntp_raw_task_loop( void* param ){
+    ntp_raw_request_t req;
+    uint16_t resp_len;
+    ntp_raw_api_call_t call;
+    uint8_t next = 0;
+
+    while(1==1){
+      ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+      bool found = false;
+      for(uint8_t i=0;( i < NTP_INTERFACES ) && ( false == found );i++){
+        found = ( pdTRUE == xQueueReceive(ntp_raw_queue[next], &req, 0) );
+        next = ( next + 1 ) % NTP_INTERFACES;
+      }
+      if(false == found){
+        continue;
+      }
+      ntp_client_t client = ntp_client_of(&req.addr);
+      client.netif = req.netif;
+      if( (req.p->tot_len == req.p->len) && 
+          (true == NTP_ControlResponder::IsControlRequest((const uint8_t*)req.p->payload, req.p->len)) ){
+        ntp_responder.Control(&client, (const uint8_t*)req.p->payload, req.p->len, req.rx, ntp_raw_control_send, &req);
+      } else if( (req.p->tot_len == req.p->len) && (req.p->len >= sizeof(ntp_packet_t)) ){
+        uint32_t cycles_dispatch = NTP_LatencyStats::Shared() - req.cycles;
+        uint32_t cycles_parsed = NTP_LatencyStats::Now();
+        resp_len = ntp_responder.Respond(&client, (const uint8_t*)req.p->payload, req.p->len, ntp_resp_buffer, req.rx, ntp_txcal.GetAdvance(req.netif));
+        /* The response never is longer than the request, so the pbuf only needs to shrink */
+        if( (resp_len > 0) && (resp_len <= req.p->len) ){
+          memcpy(req.p->payload, ntp_resp_buffer, resp_len);
+          pbuf_realloc(req.p, resp_len);
+          call.pcb = ntp_pcb;
+          call.p = req.p;
+          call.addr = &req.addr;
+          call.port = req.port;
+          uint32_t cycles_send = NTP_LatencyStats::Now();
+          tcpip_api_call(ntp_raw_sendto_api, (struct tcpip_api_call_data*)&call);
+          uint32_t cycles_sent = NTP_LatencyStats::Now();
+          if(call.err == ERR_OK){
+            ntp_timestamp_t sent = fnc_read_ntp_time();
+            ntp_responder.Sent(&client, req.rx, sent);
+            ntp_txcal.Sample(req.netif, ntp_responder.GetLastStamp(), sent);
+            /* Includes the time spent in the queue to this task */
+            ntp_latency_add(req.netif, cycles_dispatch, cycles_parsed, cycles_send, cycles_sent);
+          }
+        }
+      }
+      pbuf_free(req.p);
+    }
+}
+
+#endif
+
+/**************************************************************************************************
+ *    Function      : ntp_bcast_setup_api
+ *    Description   : Gets the pcb the broadcasts are sent with
+ *    Input         : struct tcpip_api_call_data *api_call_msg
+ *    Output        : err_t
+ *    Remarks       : Runs in the tcpip thread. The broadcasts go out from an ephemeral port, a
+ *                    server that answers them anyway answers there and not on port 123
+ **************************************************************************************************/
+static err_t ntp_bcast_setup_api(struct tcpip_api_call_data *api_call_msg){
+    ntp_bcast_api_call_t* msg = (ntp_bcast_api_call_t*)api_call_msg;
+    ntp_bcast_pcb = udp_new();
+    if(ntp_bcast_pcb == NULL){
+      msg->err = ERR_MEM;
+      return msg->err;
+    }
+    ip_set_option(ntp_bcast_pcb, SOF_BROADCAST);
+    msg->err = ERR_OK;
+    return msg->err;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_bcast_send_api
+ *    Description   : Stamps and sends a broadcast packet
+ *    Input         : struct tcpip_api_call_data *api_call_msg
+ *    Output        : err_t
+ *    Remarks       : Runs in the tcpip thread, the transmit time is taken right before the send
+ **************************************************************************************************/
+static err_t ntp_bcast_send_api(struct tcpip_api_call_data *api_call_msg){
+    ntp_bcast_api_call_t* msg = (ntp_bcast_api_call_t*)api_call_msg;
+    ntp_packet_t pkt;
+    udp_set_multicast_ttl(ntp_bcast_pcb, msg->ttl);
+    memcpy(&pkt, msg->p->payload, sizeof(ntp_packet_t));
+    ntp_stamp_transmit(&pkt, ntp_time64_from_timestamp( fnc_read_ntp_time() ));
+    memcpy(msg->p->payload, &pkt, sizeof(ntp_packet_t));
+    msg->err = udp_sendto(ntp_bcast_pcb, msg->p, msg->addr, ntp_bcast_port);
+    return msg->err;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_bcast_send
+ *    Description   : Sends a broadcast packet to an address
+ *    Input         : const ntp_packet_t* pkt, const ip_addr_t* addr, uint8_t ttl
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+static void ntp_bcast_send( const ntp_packet_t* pkt, const ip_addr_t* addr, uint8_t ttl ){
+    ntp_bcast_api_call_t call;
+    struct pbuf* p = pbuf_alloc(PBUF_TRANSPORT, sizeof(ntp_packet_t), PBUF_RAM);
+    if(p == NULL){
+      return;
+    }
+    memcpy(p->payload, pkt, sizeof(ntp_packet_t));
+    call.p = p;
+    call.addr = addr;
+    call.ttl = ttl;
+    tcpip_api_call(ntp_bcast_send_api, (struct tcpip_api_call_data*)&call);
+    if(call.err == ERR_OK){
+      ntp_responder.CountBroadcast();
+    }
+    pbuf_free(p);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_bcast_task_loop
+ *    Description   : Sends the broadcast packets
+ *    Input         : void* param
+ *    Output        : none
+ *    Remarks       : Woken by every second tick, sends if the second is a multiple of the interval
+ **************************************************************************************************/
+static void ntp_bcast_task_loop( void* param ){
+    ntp_packet_t pkt;
+    while(1==1){
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      broadcast_settings_t conf = ntp_bcast_conf;
+      if( (ntp_bcast_pcb == NULL) || ( false == ntp_broadcast_due(&conf, fnc_read_ntp_time().seconds) ) ){
+        continue;
+      }
+      ntp_packet_t tmpl = ntp_responder.GetTemplate();
+      ntp_build_broadcast(&pkt, &tmpl, conf.poll);
+      if(true == conf.broadcast){
+        ntp_bcast_send(&pkt, IP_ADDR_BROADCAST, conf.ttl);
+      }
+      if(true == conf.multicast){
+        ntp_bcast_send(&pkt, &ntp_mcast_addr, conf.ttl);
+      }
+    }
+}
+
+bool NTP_Server::begin(uint16_t port , ntp_timestamp_t(*fnc_get_ntp_time)(void) ){
     bool started=false;
-    fnc_read_utc = fnc_getutc_time;
-    fnc_read_subsecond = fnc_get_subsecond;
-    if(udp.listen(port)) {
+    fnc_read_ntp_time = fnc_get_ntp_time;
+    ntp_precision = ntp_measure_precision(fnc_read_ntp_time);
+    /* Until the clock is known we are unsynchronized */
+    ntp_server_state_t state;
+    memset(&state, 0, sizeof(state));
+    state.leap = 3;
+    state.stratum = NTP_STRATUM_UNSYNC;
+    memcpy(state.refid, "INIT", sizeof(state.refid));
+    state.rootDispersion = NTP_MAX_DISPERSION;
+    UpdateServerState(state);
+    ntp_responder.SetClock(fnc_get_ntp_time, ntp_sysvars);
+    uint8_t salt[NTP_RESPONDER_SALT_LEN];
+    for(uint8_t i=0;i<sizeof(salt);i+=4){
+      uint32_t r = esp_random();
+      memcpy(&salt[i], &r, sizeof(r));
+    }
+    ntp_responder.SetSalt(salt);
+#if ( NTP_USE_RAW_LWIP > 0 )
+    for(uint8_t i=0;i<NTP_INTERFACES;i++){
+      ntp_raw_queue[i] = xQueueCreate(NTP_TASK_QUEUE_LEN, sizeof(ntp_raw_request_t));
+      if(ntp_raw_queue[i] == NULL){
+        return false;
+      }
+    }
+    xTaskCreatePinnedToCore(
+      ntp_raw_task_loop,
+      "NTP_Task",
+      4096,
+      NULL,
+      NTP_TASK_PRIORITY,
+      &ntp_raw_task,
+      NTP_TASK_CORE);
+    ntp_raw_api_call_t call;
+    call.pcb = NULL;
+    call.port = port;
+    tcpip_api_call(ntp_raw_bind_api, (struct tcpip_api_call_data*)&call);
+    ntp_pcb = call.pcb;
+    started = ( ntp_pcb != NULL );
+#else
+    /* Bound to any type, so IPv4 and IPv6 requests share the port and the code */
+    if(udp.listen(IP_ANY_TYPE, port)) {
         started=true;
         udp.onPacket(NTP_Server::processUDPPacket);
         /* udp.onPacket([](AsyncUDPPacket packet) {
@@ -110,90 +945,93 @@ bool NTP_Server::begin(uint16_t port , uint32_t(*fnc_getutc_time)(void) , uint32
             Serial.println();
         }); */
       }
+#endif
+    if(true == started){
+      ntp_bcast_api_call_t bcast_call;
+      ntp_bcast_port = port;
+      IP_ADDR4(&ntp_mcast_addr, 224, 0, 1, 1);
+      tcpip_api_call(ntp_bcast_setup_api, (struct tcpip_api_call_data*)&bcast_call);
+      xTaskCreatePinnedToCore(
+        ntp_bcast_task_loop,
+        "NTP_Bcast",
+        3072,
+        NULL,
+        NTP_TASK_PRIORITY,
+        &ntp_bcast_task,
+        NTP_TASK_CORE);
+    }
 return started;
 }
 
-/* static function */
+/**************************************************************************************************
+ *    Function      : ntp_udp_control_send
+ *    Description   : Sends a mode 6 fragment back to the client of an AsyncUDP request
+ *    Input         : void* ctx, const uint8_t* data, uint16_t len
+ *    Output        : bool
+ *    Remarks       : ctx is the AsyncUDPPacket that is answered
+ **************************************************************************************************/
+static bool ntp_udp_control_send( void* ctx, const uint8_t* data, uint16_t len ){
+    AsyncUDPPacket* packet = (AsyncUDPPacket*)ctx;
+    return ( len == packet->write(data, len) );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_udp_remote_addr
+ *    Description   : Copies the address of the client an AsyncUDP request came from
+ *    Input         : AsyncUDPPacket& packet, ip_addr_t* addr
+ *    Output        : none
+ *    Remarks       : AsyncUDP only hands out IPAddress and IPv6Address
+ **************************************************************************************************/
+static void ntp_udp_remote_addr( AsyncUDPPacket& packet, ip_addr_t* addr ){
+    memset(addr, 0, sizeof(ip_addr_t));
+    if(true == packet.isIPv6()){
+      memcpy(ip_2_ip6(addr)->addr, (const uint8_t*)packet.remoteIPv6(), 16);
+      IP_SET_TYPE_VAL(*addr, IPADDR_TYPE_V6);
+    } else {
+      ip_addr_set_ip4_u32(addr, (uint32_t)packet.remoteIP());
+    }
+}
+
+/* static function, used by the AsyncUDP transport */
 void NTP_Server::processUDPPacket(AsyncUDPPacket& packet) {
-           uint32_t processing_start = 0;
-           uint32_t millisec = 0;
-           ntp_packet_t ntp_req;
-           
-          if(NULL != fnc_read_subsecond){
-              millisec = fnc_read_subsecond();
-          }
-           
+           uint32_t cycles_entry = NTP_LatencyStats::Now();
+           ntp_timestamp_t processing_start;
+           uint16_t resp_len;
+           ip_addr_t addr;
+           ntp_client_t client;
 
-           if(fnc_read_utc!=NULL){
-              processing_start=fnc_read_utc()+NTP_TIMESTAMP_DELTA;
+           if(fnc_read_ntp_time!=NULL){
+              processing_start=fnc_read_ntp_time();
            } else {
               return;
            }
-           if(packet.length() != sizeof(ntp_packet_t)){
+           ntp_udp_remote_addr(packet, &addr);
+           client = ntp_client_of(&addr);
+           client.netif = packet.interface();
+           if( true == NTP_ControlResponder::IsControlRequest(packet.data(), packet.length()) ){
+            ntp_responder.Control(&client, packet.data(), packet.length(), processing_start, ntp_udp_control_send, &packet);
+            return;
+           }
+           if(packet.length() < sizeof(ntp_packet_t)){
             /* this is not what we want ! */
             return;
            }
            
-           memcpy(&ntp_req, packet.data(), sizeof(ntp_packet_t));
-           
-           /* Next is to swap the data arround */
-  
-          ntp_req.rootDelay = ntohl( ntp_req.rootDelay );    
-          ntp_req.rootDispersion = ntohl( ntp_req.rootDispersion );
-          ntp_req.refId.data = ntohl( ntp_req.refId.data );        
-        
-          ntp_req.refTm_s = ntohl(ntp_req.refTm_s );      
-          ntp_req.refTm_f = ntohl(ntp_req.refTm_f  );      
-         
-          ntp_req.origTm_s = ntohl( ntp_req.txTm_s );      
-          ntp_req.origTm_f = ntohl( ntp_req.txTm_f );                
-
-        
-          ntp_req.rxTm_s = ntohl( ntp_req.rxTm_s );        
-          ntp_req.rxTm_f = ntohl( ntp_req.rxTm_f );       
-        
-          ntp_req.txTm_s = ntohl( ntp_req.txTm_s );        
-          ntp_req.txTm_f = ntohl( ntp_req.txTm_f );       
-
-          ntp_req.flags.li = 0; //NONE
-          ntp_req.flags.vn = 4; // NTP Version 4
-          ntp_req.flags.mode = 4; // Server
-
-          strncpy(ntp_req.refId.c_str ,"PPS", sizeof(ntp_req.refId.c_str) );
-          ntp_req.stratum = 1; 
-          // We don't touch ntp_req.poll 
-          ntp_req.precision = __calloverhead;
-          ntp_req.rootDelay=1;      
-          ntp_req.rootDispersion=1; 
-          /* We don't touch the originate timestamp */
-
-          ntp_req.rxTm_s= processing_start;
-          ntp_req.rxTm_f= 0;
-          /* UNIX Start is 1.1.1970 and GPS Start is 1.1.1900 */ 
-          //ntp_req.refTm_s=  ntp_req.refTm_s +  NTP_TIMESTAMP_DELTA; // We need to add 70 Years
-          ntp_req.refTm_s = processing_start;
-          ntp_req.refTm_f = 0;
-          
-          ntp_req.txTm_s = fnc_read_utc()+NTP_TIMESTAMP_DELTA;
-          ntp_req.txTm_f = 0;  
-
-          ntp_req.rootDelay = htonl( ntp_req.rootDelay );    
-          ntp_req.rootDispersion = htonl( ntp_req.rootDispersion );
-        
-          ntp_req.refTm_s = htonl(ntp_req.refTm_s );      
-          ntp_req.refTm_f = htonl(ntp_req.refTm_f  );      
-          ntp_req.origTm_s = htonl( ntp_req.origTm_s );      
-          ntp_req.origTm_f = htonl( ntp_req.origTm_f );      
-        
-          ntp_req.rxTm_s = htonl( ntp_req.rxTm_s );        
-          //ntp_req.rxTm_f = htonl( ntp_req.rxTm_f );       
-          ntp_req.txTm_s = htonl( ntp_req.txTm_s ); 
-          ntp_req.rxTm_f = htonl(millisec * 4294967);  
-          ntp_req.txTm_f = htonl(millisec * 4294967);
-
-          ntp_req.txTm_f = htonl( ntp_req.txTm_f );   
+           uint32_t cycles_parsed = NTP_LatencyStats::Now();
+           uint8_t netif = client.netif;
+           resp_len = ntp_responder.Respond(&client, packet.data(), packet.length(), ntp_resp_buffer, processing_start, ntp_txcal.GetAdvance(netif));
+           if( 0 == resp_len ){
+            return;
+           }
 
-          packet.write((uint8_t*)&ntp_req, sizeof(ntp_packet_t));
+          uint32_t cycles_send = NTP_LatencyStats::Now();
+          if( resp_len == packet.write(ntp_resp_buffer, resp_len) ){
+            uint32_t cycles_sent = NTP_LatencyStats::Now();
+            ntp_timestamp_t sent = fnc_read_ntp_time();
+            ntp_responder.Sent(&client, processing_start, sent);
+            ntp_txcal.Sample(netif, ntp_responder.GetLastStamp(), sent);
+            ntp_latency_add(netif, cycles_parsed - cycles_entry, cycles_parsed, cycles_send, cycles_sent);
+          }
         
             
         }
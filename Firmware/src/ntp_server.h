@@ -1,5 +1,43 @@
 #include "Arduino.h"
 #include "AsyncUDP.h"
+#include "timecore.h"
+#include "ntp_packet.h"
+#include "ntp_ratelimit.h"
+#include "ntp_mru.h"
+#include "ntp_broadcast.h"
+#include "ntp_auth.h"
+#include "ntp_nts.h"
+#include "ntp_responder.h"
+#include "ntp_latency.h"
+#include "ntp_txcal.h"
+#include "ntp_precision.h"
+
+/* 
+ * Set NTP_USE_RAW_LWIP to 1 to serve NTP from a dedicated task on the raw lwIP API 
+ * instead of AsyncUDP. The request pbuf is reused for the response. 
+ */
+#ifndef NTP_USE_RAW_LWIP
+ #define NTP_USE_RAW_LWIP ( 0 )
+#endif
+
+/* Core, priority and queue depth for the raw lwIP responder task, the tcpip thread runs at 18 */
+#ifndef NTP_TASK_CORE
+ #define NTP_TASK_CORE ( 0 )
+#endif
+
+#ifndef NTP_TASK_PRIORITY
+ #define NTP_TASK_PRIORITY ( 19 )
+#endif
+
+#ifndef NTP_TASK_QUEUE_LEN
+ #define NTP_TASK_QUEUE_LEN ( 32 )
+#endif
+
+/* Stratum announced while the clock runs from the RTC or free, like the local clock driver of ntpd */
+#define NTP_STRATUM_LOCAL ( 10 )
+
+/* Dispersion of a time set without a PPS edge, the phase of the second is not known, 0.5s */
+#define NTP_DISPERSION_NO_PPS ( 500000000ul )
 
 class NTP_Server {
     
@@ -7,7 +45,38 @@ public:
     NTP_Server( );
     ~NTP_Server();
     
-    bool begin(uint16_t port , uint32_t(*fnc_getutc_time)(void) , uint32_t(*fnc_get_subsecond)(void) );
+    bool begin(uint16_t port , ntp_timestamp_t(*fnc_get_ntp_time)(void) );
     static void processUDPPacket(AsyncUDPPacket& packet);
+    void UpdateServerState( ntp_server_state_t state );
+    void RefreshServerState( void );
+    void MeasurePrecision( void );
+    void PrecisionService( void );
+    ntp_precision_t GetPrecision( void );
+    ntp_server_state_t GetServerState( void );
+    ntp_server_stats_t GetStats( void );
+    ntp_server_stats_t GetStats( uint8_t netif );
+    ntp_latency_summary_t GetLatency( ntp_latency_stage_t stage );
+    ntp_latency_summary_t GetLatency( uint8_t netif, ntp_latency_stage_t stage );
+    void ResetLatency( void );
+    void SetTxCalibration( const ntp_txcal_settings_t* conf );
+    ntp_txcal_settings_t GetTxCalibration( void );
+    bool StartTxCalibration( uint8_t netif, uint16_t samples );
+    void StopTxCalibration( void );
+    ntp_txcal_progress_t GetTxCalibrationProgress( void );
+    bool TakeTxCalibration( ntp_txcal_settings_t* conf );
+    void SetRateLimit( ratelimit_settings_t conf );
+    ratelimit_settings_t GetRateLimit( void );
+    ntp_ratelimit_stats_t GetRateLimitStats( void );
+    ntp_ratelimit_stats_t GetRateLimitStats( uint8_t netif );
+    uint16_t GetClients( ntp_mru_entry_t* out, uint16_t start, uint16_t max );
+    uint16_t GetClientCount( void );
+    ntp_census_stats_t GetCensus( void );
+    uint16_t GetCensusFlagged( ntp_census_entry_t* out, uint16_t max );
+    void SetTimecore( Timecore* tc );
+    void SetBroadcast( broadcast_settings_t conf );
+    broadcast_settings_t GetBroadcast( void );
+    void SecondTick( void );
+    void SetKeys( const ntp_keys_settings_t* conf );
+    void SetNTS( const nts_settings_t* conf );
       
 };
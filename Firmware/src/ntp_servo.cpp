@@ -0,0 +1,447 @@
+#include <string.h>
+#include "ntp_servo.h"
+
+#ifdef ARDUINO
+ #include "Arduino.h"
+#else
+ /* Edge and Hold run from the PPS interrupt on the ESP32 */
+ #define IRAM_ATTR
+#endif
+
+static const char* const ntp_servo_state_names[NTP_SERVO_STATES] = { "unset", "fll", "pll", "spike", "hold" };
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_ClockServo
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : Does nothing until Begin
+ **************************************************************************************************/
+NTP_ClockServo::NTP_ClockServo( ){
+  ntp_servo_settings_t conf = GetDefaultConfig();
+  Begin(0, &conf);
+}
+
+/**************************************************************************************************
+ *    Function      : GetDefaultConfig
+ *    Class         : NTP_ClockServo
+ *    Description   : Gets the default config, no frequency learned
+ *    Input         : none
+ *    Output        : ntp_servo_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_servo_settings_t NTP_ClockServo::GetDefaultConfig( void ){
+  ntp_servo_settings_t conf;
+  conf.valid = false;
+  conf.frequency = 0;
+  return conf;
+}
+
+/**************************************************************************************************
+ *    Function      : Begin
+ *    Class         : NTP_ClockServo
+ *    Description   : Starts the loop over for a timer
+ *    Input         : uint32_t nominal ( ticks per second ), const ntp_servo_settings_t* conf
+ *    Output        : none
+ *    Remarks       : A learned frequency in conf skips the FLL
+ **************************************************************************************************/
+void NTP_ClockServo::Begin( uint32_t nominal, const ntp_servo_settings_t* conf ){
+  this->nominal = nominal;
+  state = NTP_SERVO_UNSET;
+  phase = 0;
+  phase_frac = 0;
+  freq = (int64_t)nominal << 32;
+  freq_max = ( (int64_t)nominal << 32 ) / ( 1000000000 / NTP_SERVO_MAX_PPB );
+  tau = NTP_SERVO_MINTAU;
+  jiggle = 0;
+  error = 0;
+  jitter = 0;
+  noise = 0;
+  fll_sum = 0;
+  fll_count = 0;
+  spike_count = 0;
+  edges = 0;
+  missed = 0;
+  spikes = 0;
+  steps = 0;
+  saved_valid = false;
+  saved_ppb = 0;
+  saved_edge = 0;
+  if( (conf != NULL) && (true == conf->valid) && (conf->frequency <= NTP_SERVO_MAX_PPB) && (conf->frequency >= -NTP_SERVO_MAX_PPB) ){
+    freq += FromPPB(conf->frequency);
+    saved_valid = true;
+    saved_ppb = conf->frequency;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : Advance
+ *    Class         : NTP_ClockServo
+ *    Description   : Moves the second boundary on by seconds of the current frequency
+ *    Input         : uint64_t seconds
+ *    Output        : none
+ *    Remarks       : Seconds below 2^32
+ **************************************************************************************************/
+void IRAM_ATTR NTP_ClockServo::Advance( uint64_t seconds ){
+  uint64_t f = (uint64_t)freq;
+  uint64_t frac = (uint64_t)phase_frac + ( (uint64_t)(uint32_t)f * seconds );
+  phase += ( ( f >> 32 ) * seconds ) + ( frac >> 32 );
+  phase_frac = (uint32_t)frac;
+}
+
+/**************************************************************************************************
+ *    Function      : Step
+ *    Class         : NTP_ClockServo
+ *    Description   : Sets the second boundary to an edge
+ *    Input         : uint64_t latch
+ *    Output        : none
+ *    Remarks       : Keeps the frequency, the loop starts over with the shortest time constant
+ **************************************************************************************************/
+void IRAM_ATTR NTP_ClockServo::Step( uint64_t latch ){
+  phase = latch;
+  phase_frac = 0;
+  tau = NTP_SERVO_MINTAU;
+  jiggle = 0;
+  spike_count = 0;
+  steps++;
+}
+
+/**************************************************************************************************
+ *    Function      : Limit
+ *    Class         : NTP_ClockServo
+ *    Description   : Keeps the frequency within NTP_SERVO_MAX_PPB of nominal
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void IRAM_ATTR NTP_ClockServo::Limit( void ){
+  if(freq > ( (int64_t)nominal << 32 ) + freq_max){
+    freq = ( (int64_t)nominal << 32 ) + freq_max;
+  } else if(freq < ( (int64_t)nominal << 32 ) - freq_max){
+    freq = ( (int64_t)nominal << 32 ) - freq_max;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : FromPPB
+ *    Class         : NTP_ClockServo
+ *    Description   : Converts a frequency offset to ticks per second
+ *    Input         : int32_t ppb
+ *    Output        : int64_t ( 32.32 )
+ *    Remarks       : nominal * 2^32 / 10^9 does not overflow for the timers we have
+ **************************************************************************************************/
+int64_t NTP_ClockServo::FromPPB( int32_t ppb ){
+  return ( ( (int64_t)nominal << 32 ) / 1000000000 ) * ppb;
+}
+
+/**************************************************************************************************
+ *    Function      : TicksToNs
+ *    Class         : NTP_ClockServo
+ *    Description   : Converts timer ticks to ns
+ *    Input         : int64_t ticks
+ *    Output        : int32_t
+ *    Remarks       : Saturates at about 2s
+ **************************************************************************************************/
+int32_t NTP_ClockServo::TicksToNs( int64_t ticks ){
+  if(nominal == 0){
+    return 0;
+  }
+  int64_t ns = ( ticks * 1000000000 ) / nominal;
+  if(ns > INT32_MAX){
+    return INT32_MAX;
+  }
+  if(ns < -INT32_MAX){
+    return -INT32_MAX;
+  }
+  return (int32_t)ns;
+}
+
+/**************************************************************************************************
+ *    Function      : GetPPB
+ *    Class         : NTP_ClockServo
+ *    Description   : Returns the frequency offset from nominal
+ *    Input         : none
+ *    Output        : int32_t ( ppb )
+ *    Remarks       : none
+ **************************************************************************************************/
+int32_t NTP_ClockServo::GetPPB( void ){
+  if(nominal == 0){
+    return 0;
+  }
+  /* The offset relative to nominal in 1/2^32, times 10^9 */
+  int64_t ratio = ( freq - ( (int64_t)nominal << 32 ) ) / nominal;
+  return (int32_t)( ( ratio * 1000000000 ) / 4294967296ll );
+}
+
+/**************************************************************************************************
+ *    Function      : Edge
+ *    Class         : NTP_ClockServo
+ *    Description   : Takes the timer value of a PPS edge
+ *    Input         : uint64_t latch
+ *    Output        : uint8_t ( seconds that passed since the last boundary )
+ *    Remarks       : 0 for a glitch within the same second
+ **************************************************************************************************/
+uint8_t IRAM_ATTR NTP_ClockServo::Edge( uint64_t latch ){
+  if(nominal == 0){
+    return 1;
+  }
+  edges++;
+  if(state == NTP_SERVO_UNSET){
+    phase = latch;
+    phase_frac = 0;
+    state = ( true == saved_valid ) ? NTP_SERVO_LOCK : NTP_SERVO_FREQ;
+    return 1;
+  }
+
+  /* Whole seconds since the last boundary, more than one if edges were missed */
+  uint32_t f = (uint32_t)( (uint64_t)freq >> 32 );
+  uint64_t interval = latch - phase;
+  uint64_t seconds = ( interval + ( f / 2 ) ) / f;
+  if( (seconds == 0) && (state != NTP_SERVO_HOLD) ){
+    /* A glitch on the PPS line within the same second */
+    spikes++;
+    return 0;
+  }
+  if(seconds > NTP_SERVO_CATCHUP){
+    /* Nothing to predict from over such a gap */
+    Step(latch);
+    if(state != NTP_SERVO_FREQ){
+      state = NTP_SERVO_LOCK;
+    }
+    return 1;
+  }
+  if(seconds > 1){
+    missed += (uint32_t)( seconds - 1 );
+  }
+
+  if(state == NTP_SERVO_FREQ){
+    if(seconds != 1){
+      /* Only whole single intervals are measured */
+      fll_sum = 0;
+      fll_count = 0;
+    } else {
+      fll_sum += interval;
+      fll_count++;
+    }
+    phase = latch;
+    phase_frac = 0;
+    if(fll_count >= NTP_SERVO_FLL_EDGES){
+      freq = (int64_t)( ( fll_sum << 32 ) / fll_count );
+      Limit();
+      fll_sum = 0;
+      fll_count = 0;
+      state = NTP_SERVO_LOCK;
+    }
+    return (uint8_t)seconds;
+  }
+
+  Advance(seconds);
+  int64_t e = (int64_t)( latch - phase );
+  int64_t change = e - error;
+  error = (int32_t)( ( e > INT32_MAX ) ? INT32_MAX : ( ( e < -INT32_MAX ) ? -INT32_MAX : e ) );
+  int64_t limit = ( (int64_t)nominal * ( NTP_SERVO_STEP_NS / 1000 ) ) / 1000000;
+  if( (e > limit) || (e < -limit) ){
+    spikes++;
+    spike_count++;
+    if( (state == NTP_SERVO_HOLD) || (spike_count >= NTP_SERVO_STEPOUT) ){
+      /* Back from holdover or the edges moved for good */
+      Step(latch);
+      state = NTP_SERVO_LOCK;
+    } else {
+      /* The prediction stands in for the edge */
+      state = NTP_SERVO_SPIKE;
+    }
+    return (uint8_t)seconds;
+  }
+  spike_count = 0;
+  state = NTP_SERVO_LOCK;
+
+  /* Type II loop, 1/2^tau of the phase error now and the frequency from its integral */
+  /* The phase part goes into the fraction of a tick, errors below 2^tau ticks would be lost else */
+  int64_t adjust = e * ( 1ll << ( 32 - tau ) );
+  uint64_t frac = (uint64_t)phase_frac + (uint32_t)adjust;
+  phase += (uint64_t)( adjust >> 32 ) + ( frac >> 32 );
+  phase_frac = (uint32_t)frac;
+  freq += e * ( 1ll << ( 30 - ( 2 * tau ) ) );
+  Limit();
+
+  uint32_t deviation = (uint32_t)( ( e < 0 ) ? -e : e );
+  jitter = (uint32_t)( (int32_t)jitter + ( ( (int32_t)( deviation << 4 ) - (int32_t)jitter ) / 8 ) );
+  /* Wander of the crystal hardly changes the error from one edge to the next, the latency does */
+  uint32_t step = (uint32_t)( ( change < 0 ) ? -change : change );
+  if(step > 2 * limit){
+    /* The error before was a spike or a step */
+    step = (uint32_t)( 2 * limit );
+  }
+  noise = (uint32_t)( (int32_t)noise + ( ( (int32_t)( step << 4 ) - (int32_t)noise ) / 8 ) );
+
+  /* Errors within the noise are averaged over a longer time, larger ones are wander to follow */
+  if( ( deviation << 4 ) <= ( NTP_SERVO_PGATE * noise ) ){
+    jiggle += tau;
+    if(jiggle > NTP_SERVO_LIMIT){
+      jiggle = 0;
+      if(tau < NTP_SERVO_MAXTAU){
+        tau++;
+      }
+    }
+  } else {
+    jiggle -= 2 * tau;
+    if(jiggle < -NTP_SERVO_LIMIT){
+      jiggle = 0;
+      if(tau > NTP_SERVO_MINTAU){
+        tau--;
+      }
+    }
+  }
+  return (uint8_t)seconds;
+}
+
+/**************************************************************************************************
+ *    Function      : Hold
+ *    Class         : NTP_ClockServo
+ *    Description   : Runs the second boundary on without PPS edges
+ *    Input         : uint64_t latch ( timer value now )
+ *    Output        : uint8_t ( seconds that passed since the last boundary )
+ *    Remarks       : Once locked the boundaries are predicted from the held frequency, the caller
+ *                    runs on the same crystal and only tells when to look. The next edge may step
+ *                    the phase at once
+ **************************************************************************************************/
+uint8_t IRAM_ATTR NTP_ClockServo::Hold( uint64_t latch ){
+  if( (state == NTP_SERVO_LOCK) || (state == NTP_SERVO_SPIKE) ){
+    state = NTP_SERVO_HOLD;
+  } else if(state == NTP_SERVO_FREQ){
+    /* The intervals measured so far would be taken across the gap */
+    fll_sum = 0;
+    fll_count = 0;
+  }
+  if( (nominal == 0) || (state != NTP_SERVO_HOLD) ){
+    return 1;
+  }
+  uint8_t seconds = 0;
+  int64_t f = (int64_t)( (uint64_t)freq >> 32 );
+  while( ( (int64_t)( latch - phase ) >= f ) && (seconds < NTP_SERVO_CATCHUP) ){
+    Advance(1);
+    seconds++;
+  }
+  return seconds;
+}
+
+/**************************************************************************************************
+ *    Function      : SetHoldFrequency
+ *    Class         : NTP_ClockServo
+ *    Description   : Sets the frequency the boundaries are predicted from in holdover
+ *    Input         : int32_t ppb ( the timer runs fast )
+ *    Output        : none
+ *    Remarks       : Ignored unless in holdover, the loop goes on from it on the next edge
+ **************************************************************************************************/
+void NTP_ClockServo::SetHoldFrequency( int32_t ppb ){
+  if(state != NTP_SERVO_HOLD){
+    return;
+  }
+  freq = ( (int64_t)nominal << 32 ) + FromPPB(ppb);
+  Limit();
+}
+
+/**************************************************************************************************
+ *    Function      : GetState
+ *    Class         : NTP_ClockServo
+ *    Description   : Returns the state of the loop
+ *    Input         : none
+ *    Output        : ntp_servo_state_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_servo_state_t IRAM_ATTR NTP_ClockServo::GetState( void ){
+  return state;
+}
+
+/**************************************************************************************************
+ *    Function      : GetPhase
+ *    Class         : NTP_ClockServo
+ *    Description   : Returns the timer value the second of the last edge started at
+ *    Input         : none
+ *    Output        : uint64_t
+ *    Remarks       : May be a few ticks after the edge itself
+ **************************************************************************************************/
+uint64_t IRAM_ATTR NTP_ClockServo::GetPhase( void ){
+  return phase;
+}
+
+/**************************************************************************************************
+ *    Function      : GetFrequency
+ *    Class         : NTP_ClockServo
+ *    Description   : Returns the disciplined ticks per second
+ *    Input         : none
+ *    Output        : uint32_t
+ *    Remarks       : 0 before Begin
+ **************************************************************************************************/
+uint32_t IRAM_ATTR NTP_ClockServo::GetFrequency( void ){
+  return (uint32_t)( ( (uint64_t)freq + 0x80000000ull ) >> 32 );
+}
+
+/**************************************************************************************************
+ *    Function      : GetStatus
+ *    Class         : NTP_ClockServo
+ *    Description   : Returns the state of the loop
+ *    Input         : none
+ *    Output        : ntp_servo_status_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_servo_status_t NTP_ClockServo::GetStatus( void ){
+  ntp_servo_status_t status;
+  status.state = state;
+  status.tau = tau;
+  status.offset = TicksToNs(error);
+  status.jitter = (uint32_t)TicksToNs( jitter >> 4 );
+  status.frequency = GetPPB();
+  status.edges = edges;
+  status.missed = missed;
+  status.spikes = spikes;
+  status.steps = steps;
+  return status;
+}
+
+/**************************************************************************************************
+ *    Function      : TakeSettings
+ *    Class         : NTP_ClockServo
+ *    Description   : Hands out the learned frequency for storage
+ *    Input         : ntp_servo_settings_t* out
+ *    Output        : bool
+ *    Remarks       : True if locked and the frequency moved NTP_SERVO_SAVE_PPB from the last one
+ *                    handed out, at most every NTP_SERVO_SAVE_INTERVAL edges
+ **************************************************************************************************/
+bool NTP_ClockServo::TakeSettings( ntp_servo_settings_t* out ){
+  if( (state != NTP_SERVO_LOCK) || (tau < NTP_SERVO_MAXTAU) ){
+    /* Only a settled loop knows the frequency well enough */
+    return false;
+  }
+  if( (true == saved_valid) && ( (uint32_t)( edges - saved_edge ) < NTP_SERVO_SAVE_INTERVAL ) ){
+    return false;
+  }
+  int32_t ppb = GetPPB();
+  int32_t moved = ppb - saved_ppb;
+  if( (true == saved_valid) && (moved < NTP_SERVO_SAVE_PPB) && (moved > -NTP_SERVO_SAVE_PPB) ){
+    return false;
+  }
+  saved_valid = true;
+  saved_ppb = ppb;
+  saved_edge = edges;
+  out->valid = true;
+  out->frequency = ppb;
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : GetStateName
+ *    Class         : NTP_ClockServo
+ *    Description   : Returns the name of a loop state for reports
+ *    Input         : ntp_servo_state_t state
+ *    Output        : const char*
+ *    Remarks       : none
+ **************************************************************************************************/
+const char* NTP_ClockServo::GetStateName( ntp_servo_state_t state ){
+  if(state >= NTP_SERVO_STATES){
+    return "unknown";
+  }
+  return ntp_servo_state_names[state];
+}
@@ -0,0 +1,222 @@
+#ifndef NTP_SERVO_H_
+ #define NTP_SERVO_H_
+
+#include <stdint.h>
+
+/* Loop time constant range, log2 seconds */
+#define NTP_SERVO_MINTAU ( 2 )
+#define NTP_SERVO_MAXTAU ( 8 )
+
+/* Errors within this many times the edge to edge noise make the loop slower, RFC 5905 PGATE */
+#define NTP_SERVO_PGATE ( 4 )
+
+/* Hysteresis of the time constant, RFC 5905 LIMIT */
+#define NTP_SERVO_LIMIT ( 30 )
+
+/* Intervals averaged before the frequency is known without a stored one */
+#define NTP_SERVO_FLL_EDGES ( 16 )
+
+/* Larger phase errors are spikes, 500us */
+#define NTP_SERVO_STEP_NS ( 500000 )
+
+/* Spikes in a row before the phase is stepped */
+#define NTP_SERVO_STEPOUT ( 4 )
+
+/* Seconds bridged at most by one edge or one look in holdover, beyond the phase is set again */
+#define NTP_SERVO_CATCHUP ( 4 )
+
+/* Frequency offsets beyond are a wrong nominal frequency and not a crystal, 500ppm */
+#define NTP_SERVO_MAX_PPB ( 500000 )
+
+/* The learned frequency is handed out for storage if it moved this far, at most once per interval */
+#define NTP_SERVO_SAVE_PPB ( 20 )
+#define NTP_SERVO_SAVE_INTERVAL ( 3600 )
+
+typedef enum {
+  NTP_SERVO_UNSET = 0,  /* No PPS edge seen yet */
+  NTP_SERVO_FREQ,       /* Measuring the frequency from the intervals, FLL */
+  NTP_SERVO_LOCK,       /* Tracking phase and frequency, PLL */
+  NTP_SERVO_SPIKE,      /* The last edge was far off and not used */
+  NTP_SERVO_HOLD,       /* No PPS, the boundaries are predicted from the held frequency */
+  NTP_SERVO_STATES
+} ntp_servo_state_t;
+
+typedef struct {
+  bool valid;           /* A frequency was learned */
+  int32_t frequency;    /* ppb the timer runs fast against PPS */
+} ntp_servo_settings_t;
+/* 8 byte */
+
+typedef struct {
+  ntp_servo_state_t state;
+  uint8_t tau;          /* Time constant, log2 seconds */
+  int32_t offset;       /* Phase error at the last edge in ns, positive if the edge came late */
+  uint32_t jitter;      /* Average deviation of the phase errors in ns */
+  int32_t frequency;    /* ppb the timer runs fast against PPS */
+  uint32_t edges;       /* PPS edges taken */
+  uint32_t missed;      /* Seconds without an edge in between two edges */
+  uint32_t spikes;      /* Edges not used */
+  uint32_t steps;       /* Times the phase was set to an edge again */
+} ntp_servo_status_t;
+
+/*
+ * Disciplines a free running timer to the PPS edges. The timer value of each
+ * edge is compared with the one predicted from the last second boundary and
+ * the frequency, a type II loop absorbs 1/2^tau of the phase error per second
+ * and integrates the frequency from it. The time constant grows while the
+ * errors are within the noise seen from edge to edge and shrinks if they are
+ * not, so the loop follows the crystal as it wanders with temperature. The
+ * disciplined boundary and frequency are what the sub seconds are interpolated
+ * from, so the interrupt latency of a single edge no longer moves the time.
+ * Integer only, Edge and Hold are called from the PPS interrupt.
+ */
+class NTP_ClockServo {
+
+public:
+    NTP_ClockServo( );
+
+    /**************************************************************************************************
+     *    Function      : GetDefaultConfig
+     *    Class         : NTP_ClockServo
+     *    Description   : Gets the default config, no frequency learned
+     *    Input         : none
+     *    Output        : ntp_servo_settings_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    static ntp_servo_settings_t GetDefaultConfig( void );
+
+    /**************************************************************************************************
+     *    Function      : Begin
+     *    Class         : NTP_ClockServo
+     *    Description   : Starts the loop over for a timer
+     *    Input         : uint32_t nominal ( ticks per second ), const ntp_servo_settings_t* conf
+     *    Output        : none
+     *    Remarks       : A learned frequency in conf skips the FLL
+     **************************************************************************************************/
+    void Begin( uint32_t nominal, const ntp_servo_settings_t* conf );
+
+    /**************************************************************************************************
+     *    Function      : Edge
+     *    Class         : NTP_ClockServo
+     *    Description   : Takes the timer value of a PPS edge
+     *    Input         : uint64_t latch
+     *    Output        : uint8_t ( seconds that passed since the last boundary )
+     *    Remarks       : 0 for a glitch within the same second
+     **************************************************************************************************/
+    uint8_t Edge( uint64_t latch );
+
+    /**************************************************************************************************
+     *    Function      : Hold
+     *    Class         : NTP_ClockServo
+     *    Description   : Runs the second boundary on without PPS edges
+     *    Input         : uint64_t latch ( timer value now )
+     *    Output        : uint8_t ( seconds that passed since the last boundary )
+     *    Remarks       : Once locked the boundaries are predicted from the held frequency, the caller
+     *                    runs on the same crystal and only tells when to look. The next edge may step
+     *                    the phase at once
+     **************************************************************************************************/
+    uint8_t Hold( uint64_t latch );
+
+    /**************************************************************************************************
+     *    Function      : SetHoldFrequency
+     *    Class         : NTP_ClockServo
+     *    Description   : Sets the frequency the boundaries are predicted from in holdover
+     *    Input         : int32_t ppb ( the timer runs fast )
+     *    Output        : none
+     *    Remarks       : Ignored unless in holdover, the loop goes on from it on the next edge
+     **************************************************************************************************/
+    void SetHoldFrequency( int32_t ppb );
+
+    /**************************************************************************************************
+     *    Function      : GetState
+     *    Class         : NTP_ClockServo
+     *    Description   : Returns the state of the loop
+     *    Input         : none
+     *    Output        : ntp_servo_state_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    ntp_servo_state_t GetState( void );
+
+    /**************************************************************************************************
+     *    Function      : GetPhase
+     *    Class         : NTP_ClockServo
+     *    Description   : Returns the timer value the second of the last edge started at
+     *    Input         : none
+     *    Output        : uint64_t
+     *    Remarks       : May be a few ticks after the edge itself
+     **************************************************************************************************/
+    uint64_t GetPhase( void );
+
+    /**************************************************************************************************
+     *    Function      : GetFrequency
+     *    Class         : NTP_ClockServo
+     *    Description   : Returns the disciplined ticks per second
+     *    Input         : none
+     *    Output        : uint32_t
+     *    Remarks       : 0 before Begin
+     **************************************************************************************************/
+    uint32_t GetFrequency( void );
+
+    /**************************************************************************************************
+     *    Function      : GetStatus
+     *    Class         : NTP_ClockServo
+     *    Description   : Returns the state of the loop
+     *    Input         : none
+     *    Output        : ntp_servo_status_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    ntp_servo_status_t GetStatus( void );
+
+    /**************************************************************************************************
+     *    Function      : TakeSettings
+     *    Class         : NTP_ClockServo
+     *    Description   : Hands out the learned frequency for storage
+     *    Input         : ntp_servo_settings_t* out
+     *    Output        : bool
+     *    Remarks       : True if locked and the frequency moved NTP_SERVO_SAVE_PPB from the last one
+     *                    handed out, at most every NTP_SERVO_SAVE_INTERVAL edges
+     **************************************************************************************************/
+    bool TakeSettings( ntp_servo_settings_t* out );
+
+    /**************************************************************************************************
+     *    Function      : GetStateName
+     *    Class         : NTP_ClockServo
+     *    Description   : Returns the name of a loop state for reports
+     *    Input         : ntp_servo_state_t state
+     *    Output        : const char*
+     *    Remarks       : none
+     **************************************************************************************************/
+    static const char* GetStateName( ntp_servo_state_t state );
+
+private:
+    uint32_t nominal;
+    ntp_servo_state_t state;
+    uint64_t phase;       /* Timer value of the disciplined second boundary */
+    uint32_t phase_frac;  /* and its fraction of a tick, 1/2^32 */
+    int64_t freq;         /* Ticks per second, 32.32 */
+    int64_t freq_max;     /* Largest offset of freq from nominal */
+    uint8_t tau;
+    int32_t jiggle;       /* Counts towards a longer or shorter time constant */
+    int32_t error;        /* Phase error at the last edge, ticks */
+    uint32_t jitter;      /* Average deviation of the phase errors, 1/16 ticks */
+    uint32_t noise;       /* Average change of the phase error from edge to edge, 1/16 ticks */
+    uint64_t fll_sum;     /* Ticks of the intervals measured so far */
+    uint8_t fll_count;
+    uint8_t spike_count;
+    uint32_t edges;
+    uint32_t missed;
+    uint32_t spikes;
+    uint32_t steps;
+    bool saved_valid;
+    int32_t saved_ppb;
+    uint32_t saved_edge;
+
+    void Advance( uint64_t seconds );
+    void Step( uint64_t latch );
+    void Limit( void );
+    int64_t FromPPB( int32_t ppb );
+    int32_t TicksToNs( int64_t ticks );
+    int32_t GetPPB( void );
+};
+
+#endif
@@ -0,0 +1,211 @@
+#ifndef NTP_TIMESTAMP_H_
+ #define NTP_TIMESTAMP_H_
+
+#include <stdint.h>
+
+/* Offset between the NTP epoch ( 1.1.1900 ) and the UNIX epoch ( 1.1.1970 ) */
+#define NTP_TIMESTAMP_DELTA  2208988800ull
+
+/* NTP style timestamp, seconds since 1.1.1900 and the fraction in 1/2^32 seconds */
+typedef struct {
+   uint32_t seconds;
+   uint32_t fraction;
+} ntp_timestamp_t;
+
+/* The same in one 32.32 fixed point number, seconds in the upper half. The seconds wrap every
+   2^32 s, era 0 ends on 7.2.2036 06:28:16 UTC. Differences are taken modulo 2^64 and hold across
+   an era change, dates are resolved with ntp_time64_to_unix against a pivot close to them. */
+typedef uint64_t ntp_time64_t;
+
+/* One second in 32.32 */
+#define NTP_TIME64_SECOND ( 1ull << 32 )
+
+/* Pivot for dates read without a clock to compare with, 1.1.2040. Resolves 13.12.1971 20:45:52 to
+   20.1.2108 03:14:07 UTC */
+#define NTP_TIME64_PIVOT ( 2208988800ll )
+
+/**************************************************************************************************
+ *    Function      : ntp_time64_make
+ *    Description   : Builds a 32.32 time from seconds and fraction
+ *    Input         : uint32_t seconds, uint32_t fraction
+ *    Output        : ntp_time64_t
+ *    Remarks       : none
+ **************************************************************************************************/
+constexpr ntp_time64_t ntp_time64_make( uint32_t seconds, uint32_t fraction ){
+  return ( (ntp_time64_t)seconds << 32 ) | fraction;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_time64_seconds
+ *    Description   : Returns the seconds within the era of a 32.32 time
+ *    Input         : ntp_time64_t t
+ *    Output        : uint32_t
+ *    Remarks       : none
+ **************************************************************************************************/
+constexpr uint32_t ntp_time64_seconds( ntp_time64_t t ){
+  return (uint32_t)( t >> 32 );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_time64_fraction
+ *    Description   : Returns the fraction of a 32.32 time
+ *    Input         : ntp_time64_t t
+ *    Output        : uint32_t ( 1/2^32 s )
+ *    Remarks       : none
+ **************************************************************************************************/
+constexpr uint32_t ntp_time64_fraction( ntp_time64_t t ){
+  return (uint32_t)t;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_time64_from_timestamp
+ *    Description   : Converts a timestamp to 32.32
+ *    Input         : ntp_timestamp_t ts
+ *    Output        : ntp_time64_t
+ *    Remarks       : none
+ **************************************************************************************************/
+constexpr ntp_time64_t ntp_time64_from_timestamp( ntp_timestamp_t ts ){
+  return ntp_time64_make(ts.seconds, ts.fraction);
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_time64_to_timestamp
+ *    Description   : Converts a 32.32 time to a timestamp
+ *    Input         : ntp_time64_t t
+ *    Output        : ntp_timestamp_t
+ *    Remarks       : none
+ **************************************************************************************************/
+constexpr ntp_timestamp_t ntp_time64_to_timestamp( ntp_time64_t t ){
+  return ntp_timestamp_t{ ntp_time64_seconds(t), ntp_time64_fraction(t) };
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_time64_diff
+ *    Description   : Returns a - b as signed 32.32
+ *    Input         : ntp_time64_t a, ntp_time64_t b
+ *    Output        : int64_t ( 1/2^32 s )
+ *    Remarks       : Valid across an era change as long as the times are less than 68 years apart
+ **************************************************************************************************/
+constexpr int64_t ntp_time64_diff( ntp_time64_t a, ntp_time64_t b ){
+  return (int64_t)( a - b );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_time64_from_unix
+ *    Description   : Converts UNIX seconds and a fraction to 32.32
+ *    Input         : int64_t unix_seconds, uint32_t fraction
+ *    Output        : ntp_time64_t
+ *    Remarks       : The era is dropped, seconds before 1.1.1900 are not supported
+ **************************************************************************************************/
+constexpr ntp_time64_t ntp_time64_from_unix( int64_t unix_seconds, uint32_t fraction ){
+  return ntp_time64_make( (uint32_t)( (uint64_t)unix_seconds + NTP_TIMESTAMP_DELTA ), fraction );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_time64_era
+ *    Description   : Returns the NTP era of a UNIX time
+ *    Input         : int64_t unix_seconds
+ *    Output        : uint32_t
+ *    Remarks       : Era 0 started on 1.1.1900, era 1 on 7.2.2036
+ **************************************************************************************************/
+constexpr uint32_t ntp_time64_era( int64_t unix_seconds ){
+  return (uint32_t)( ( (uint64_t)unix_seconds + NTP_TIMESTAMP_DELTA ) >> 32 );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_time64_to_unix
+ *    Description   : Converts a 32.32 time to UNIX seconds, the era is taken from a pivot
+ *    Input         : ntp_time64_t t, int64_t pivot ( UNIX seconds )
+ *    Output        : int64_t ( UNIX seconds, the fraction is dropped )
+ *    Remarks       : Picks the era that puts the time within 68 years of the pivot, RFC 5905 6.
+ *                    Use the current time as pivot once it is known
+ **************************************************************************************************/
+constexpr int64_t ntp_time64_to_unix( ntp_time64_t t, int64_t pivot ){
+  return pivot + (int32_t)( ntp_time64_seconds(t) - ntp_time64_seconds( ntp_time64_from_unix(pivot, 0) ) );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_interpolate_fraction
+ *    Description   : Interpolates the fraction of a second from the timer ticks since it started
+ *    Input         : uint64_t* seconds, uint64_t elapsed, uint32_t frequency ( ticks per second ),
+ *                    bool extrapolate
+ *    Output        : uint32_t ( 1/2^32 s )
+ *    Remarks       : Past the end of the second whole seconds are added to seconds if extrapolate
+ *                    is set, else the time is held at the end of it. A timer value before the start,
+ *                    read as huge elapsed, gives the start of the second
+ **************************************************************************************************/
+static inline uint32_t ntp_interpolate_fraction( uint64_t* seconds, uint64_t elapsed, uint32_t frequency, bool extrapolate ){
+  if( (frequency == 0) || ( (int64_t)elapsed < 0 ) ){
+    return 0;
+  }
+  if(elapsed >= frequency){
+    if(false == extrapolate){
+      return 0xFFFFFFFF;
+    }
+    *seconds += elapsed / frequency;
+    elapsed %= frequency;
+  }
+  return (uint32_t)( ( elapsed << 32 ) / frequency );
+}
+
+/* Steps of ntp_days_from_civil, a C++11 constexpr function is a single return */
+constexpr int32_t ntp_civil_year_of_era( int32_t y ){
+  return ( y >= 0 ) ? ( y % 400 ) : ( ( y % 400 + 400 ) % 400 );
+}
+
+constexpr int32_t ntp_civil_era( int32_t y ){
+  return ( y >= 0 ) ? ( y / 400 ) : ( ( y - 399 ) / 400 );
+}
+
+constexpr int32_t ntp_civil_day_of_year( uint32_t month, uint32_t day ){
+  return ( 153 * (int32_t)( ( month > 2 ) ? ( month - 3 ) : ( month + 9 ) ) + 2 ) / 5 + (int32_t)day - 1;
+}
+
+constexpr int64_t ntp_civil_days( int32_t y, uint32_t month, uint32_t day ){
+  return (int64_t)ntp_civil_era(y) * 146097 +
+         (int64_t)ntp_civil_year_of_era(y) * 365 + ntp_civil_year_of_era(y) / 4 - ntp_civil_year_of_era(y) / 100 +
+         ntp_civil_day_of_year(month, day) - 719468;
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_days_from_civil
+ *    Description   : Returns the days since 1.1.1970 of a date in the proleptic Gregorian calendar
+ *    Input         : int32_t year, uint32_t month ( 1 - 12 ), uint32_t day ( 1 - 31 )
+ *    Output        : int64_t
+ *    Remarks       : The year starts in March, so the leap day is the last day of it
+ **************************************************************************************************/
+constexpr int64_t ntp_days_from_civil( int32_t year, uint32_t month, uint32_t day ){
+  return ntp_civil_days( ( month <= 2 ) ? ( year - 1 ) : year, month, day );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_civil_from_days
+ *    Description   : Returns the date of a day since 1.1.1970 in the proleptic Gregorian calendar
+ *    Input         : int64_t days, int32_t* year, uint8_t* month, uint8_t* day
+ *    Output        : none
+ *    Remarks       : Inverse of ntp_days_from_civil
+ **************************************************************************************************/
+static inline void ntp_civil_from_days( int64_t days, int32_t* year, uint8_t* month, uint8_t* day ){
+  days += 719468;
+  int64_t era = ( ( days >= 0 ) ? days : ( days - 146096 ) ) / 146097;
+  uint32_t doe = (uint32_t)( days - era * 146097 );
+  uint32_t yoe = ( doe - doe / 1460 + doe / 36524 - doe / 146096 ) / 365;
+  uint32_t doy = doe - ( 365 * yoe + yoe / 4 - yoe / 100 );
+  uint32_t mp = ( 5 * doy + 2 ) / 153;
+  *day = (uint8_t)( doy - ( 153 * mp + 2 ) / 5 + 1 );
+  *month = (uint8_t)( ( mp < 10 ) ? ( mp + 3 ) : ( mp - 9 ) );
+  *year = (int32_t)( (int64_t)yoe + era * 400 ) + ( ( *month <= 2 ) ? 1 : 0 );
+}
+
+/**************************************************************************************************
+ *    Function      : ntp_weekday_from_days
+ *    Description   : Returns the day of the week of a day since 1.1.1970
+ *    Input         : int64_t days
+ *    Output        : uint8_t ( 0 Sunday to 6 Saturday )
+ *    Remarks       : 1.1.1970 was a Thursday
+ **************************************************************************************************/
+constexpr uint8_t ntp_weekday_from_days( int64_t days ){
+  return (uint8_t)( ( days >= -4 ) ? ( ( days + 4 ) % 7 ) : ( ( ( days + 4 ) % 7 + 7 ) % 7 ) );
+}
+
+#endif
@@ -0,0 +1,220 @@
+#include <string.h>
+#include <math.h>
+#include "ntp_txcal.h"
+
+/**************************************************************************************************
+ *    Function      : Constructor
+ *    Class         : NTP_TxCalibration
+ *    Description   : none
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+NTP_TxCalibration::NTP_TxCalibration( ){
+  ntp_txcal_settings_t def = GetDefaultConfig();
+  conf_idx = 0;
+  state = NTP_TXCAL_IDLE;
+  netif = 0;
+  target = 0;
+  count = 0;
+  rejected = 0;
+  sum = 0;
+  sum_sq = 0;
+  memset(&result, 0, sizeof(result));
+  memset(advance, 0, sizeof(advance));
+  conf[0] = def;
+  conf[1] = def;
+}
+
+/**************************************************************************************************
+ *    Function      : GetDefaultConfig
+ *    Class         : NTP_TxCalibration
+ *    Description   : Gets the default config, not calibrated
+ *    Input         : none
+ *    Output        : ntp_txcal_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_txcal_settings_t NTP_TxCalibration::GetDefaultConfig( void ){
+  ntp_txcal_settings_t def;
+  memset(&def, 0, sizeof(def));
+  def.enabled = true;
+  return def;
+}
+
+/**************************************************************************************************
+ *    Function      : SetConfig
+ *    Class         : NTP_TxCalibration
+ *    Description   : Applys the passed config
+ *    Input         : const ntp_txcal_settings_t* new_conf
+ *    Output        : none
+ *    Remarks       : Built in the spare buffer and swapped in
+ **************************************************************************************************/
+void NTP_TxCalibration::SetConfig( const ntp_txcal_settings_t* new_conf ){
+  uint8_t spare = ( conf_idx == 0 ) ? 1 : 0;
+  conf[spare] = *new_conf;
+  for(uint8_t i=0;i<NTP_TXCAL_INTERFACES;i++){
+    const ntp_txcal_entry_t* e = &new_conf->interfaces[i];
+    if( (false == new_conf->enabled) || (e->samples == 0) || (e->delay <= 0) || (e->delay > NTP_TXCAL_MAX_NS) ){
+      advance[spare][i] = 0;
+    } else {
+      advance[spare][i] = (uint32_t)( ( (uint64_t)e->delay << 32 ) / 1000000000ull );
+    }
+  }
+  conf_idx = spare;
+}
+
+/**************************************************************************************************
+ *    Function      : GetConfig
+ *    Class         : NTP_TxCalibration
+ *    Description   : Gets the current config
+ *    Input         : none
+ *    Output        : ntp_txcal_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_txcal_settings_t NTP_TxCalibration::GetConfig( void ){
+  return conf[conf_idx];
+}
+
+/**************************************************************************************************
+ *    Function      : GetAdvance
+ *    Class         : NTP_TxCalibration
+ *    Description   : Returns what to add to a transmit timestamp sent on an interface
+ *    Input         : uint8_t nif
+ *    Output        : uint32_t ( 1/2^32 s )
+ *    Remarks       : 0 while disabled, not calibrated or calibrating
+ **************************************************************************************************/
+uint32_t NTP_TxCalibration::GetAdvance( uint8_t nif ){
+  /* The interface being measured has to be sent uncorrected */
+  if( (nif >= NTP_TXCAL_INTERFACES) || ( (state == NTP_TXCAL_RUNNING) && (nif == netif) ) ){
+    return 0;
+  }
+  return advance[conf_idx][nif];
+}
+
+/**************************************************************************************************
+ *    Function      : Start
+ *    Class         : NTP_TxCalibration
+ *    Description   : Starts to measure the delay of an interface
+ *    Input         : uint8_t nif, uint16_t samples
+ *    Output        : bool
+ *    Remarks       : Fails if the interface is unknown or a calibration is running
+ **************************************************************************************************/
+bool NTP_TxCalibration::Start( uint8_t nif, uint16_t samples ){
+  if( (nif >= NTP_TXCAL_INTERFACES) || (state == NTP_TXCAL_RUNNING) ){
+    return false;
+  }
+  netif = nif;
+  target = ( samples > 0 ) ? samples : NTP_TXCAL_SAMPLES;
+  count = 0;
+  rejected = 0;
+  sum = 0;
+  sum_sq = 0;
+  /* Set last, the sending task only looks at the rest once it sees this */
+  state = NTP_TXCAL_RUNNING;
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : Stop
+ *    Class         : NTP_TxCalibration
+ *    Description   : Drops a running calibration
+ *    Input         : none
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+void NTP_TxCalibration::Stop( void ){
+  if(state == NTP_TXCAL_RUNNING){
+    state = NTP_TXCAL_IDLE;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : Sample
+ *    Class         : NTP_TxCalibration
+ *    Description   : Adds the delay of a response that was just sent
+ *    Input         : uint8_t nif, ntp_timestamp_t stamp, ntp_timestamp_t sent
+ *    Output        : none
+ *    Remarks       : stamp is the clock reading of the transmit timestamp, sent the one after
+ *                    the send returned. Only to be called from the task sending the responses
+ **************************************************************************************************/
+void NTP_TxCalibration::Sample( uint8_t nif, ntp_timestamp_t stamp, ntp_timestamp_t sent ){
+  if( (state != NTP_TXCAL_RUNNING) || (nif != netif) || ( (stamp.seconds == 0) && (stamp.fraction == 0) ) ){
+    return;
+  }
+  uint64_t t_stamp = ( (uint64_t)stamp.seconds << 32 ) | stamp.fraction;
+  uint64_t t_sent = ( (uint64_t)sent.seconds << 32 ) | sent.fraction;
+  int64_t diff = (int64_t)( t_sent - t_stamp );
+  /* A second boundary crossed in between or a clock step gives nonsense, as does a task switch */
+  if( (diff < 0) || (diff > ( ( (int64_t)NTP_TXCAL_MAX_NS << 32 ) / 1000000000ll ) ) ){
+    rejected++;
+    return;
+  }
+  int64_t ns = ( diff * 1000000000ll ) >> 32;
+  sum += ns;
+  sum_sq += (uint64_t)( ns * ns );
+  count++;
+  if(count < target){
+    return;
+  }
+  int64_t mean = sum / count;
+  int64_t variance = (int64_t)( sum_sq / count ) - ( mean * mean );
+  result.delay = (int32_t)mean;
+  result.stddev = ( variance > 0 ) ? (uint32_t)sqrt((double)variance) : 0;
+  result.samples = count;
+  state = NTP_TXCAL_DONE;
+}
+
+/**************************************************************************************************
+ *    Function      : GetProgress
+ *    Class         : NTP_TxCalibration
+ *    Description   : Returns the state of the calibration
+ *    Input         : none
+ *    Output        : ntp_txcal_progress_t
+ *    Remarks       : none
+ **************************************************************************************************/
+ntp_txcal_progress_t NTP_TxCalibration::GetProgress( void ){
+  ntp_txcal_progress_t p;
+  p.running = ( state != NTP_TXCAL_IDLE );
+  p.netif = netif;
+  p.samples = count;
+  p.target = target;
+  p.rejected = rejected;
+  return p;
+}
+
+/**************************************************************************************************
+ *    Function      : TakeResult
+ *    Class         : NTP_TxCalibration
+ *    Description   : Applies a finished calibration
+ *    Input         : ntp_txcal_settings_t* out
+ *    Output        : bool
+ *    Remarks       : Returns true once per calibration with the new config in out, to be stored
+ **************************************************************************************************/
+bool NTP_TxCalibration::TakeResult( ntp_txcal_settings_t* out ){
+  if(state != NTP_TXCAL_DONE){
+    return false;
+  }
+  ntp_txcal_settings_t new_conf = GetConfig();
+  new_conf.interfaces[netif] = result;
+  SetConfig(&new_conf);
+  state = NTP_TXCAL_IDLE;
+  *out = new_conf;
+  return true;
+}
+
+/**************************************************************************************************
+ *    Function      : GetInterfaceName
+ *    Class         : NTP_TxCalibration
+ *    Description   : Returns the name of an interface for reports
+ *    Input         : uint8_t nif
+ *    Output        : const char*
+ *    Remarks       : none
+ **************************************************************************************************/
+const char* NTP_TxCalibration::GetInterfaceName( uint8_t nif ){
+  switch(nif){
+    case 0: return "sta";
+    case 1: return "ap";
+    case 2: return "eth";
+    default: return "";
+  }
+}
@@ -0,0 +1,170 @@
+#ifndef NTP_TXCAL_H_
+ #define NTP_TXCAL_H_
+
+#include <stdint.h>
+#include "ntp_timestamp.h"
+
+/* Interfaces with their own correction, in the order of tcpip_adapter_if_t: STA, AP, ETH */
+#define NTP_TXCAL_INTERFACES ( 3 )
+
+/* Samples taken if none are given */
+#define NTP_TXCAL_SAMPLES ( 256 )
+
+/* Longer delays are a task switch or a busy channel and not part of the fixed delay, 5ms */
+#define NTP_TXCAL_MAX_NS ( 5000000 )
+
+typedef struct {
+  int32_t delay;      /* Mean ns from taking the transmit timestamp to the send returning */
+  uint32_t stddev;    /* Standard deviation of the samples in ns */
+  uint16_t samples;   /* Samples the delay is made of, 0 if not calibrated */
+} ntp_txcal_entry_t;
+
+typedef struct {
+  bool enabled;       /* Advance the transmit timestamp by the delay of the interface */
+  ntp_txcal_entry_t interfaces[NTP_TXCAL_INTERFACES];
+} ntp_txcal_settings_t;
+
+typedef struct {
+  bool running;
+  uint8_t netif;      /* Interface being calibrated */
+  uint16_t samples;   /* Samples taken so far */
+  uint16_t target;    /* Samples to take */
+  uint32_t rejected;  /* Samples over NTP_TXCAL_MAX_NS */
+} ntp_txcal_progress_t;
+
+/*
+ * Measures the time between the transmit timestamp being taken and the
+ * response being handed to the WiFi driver, both read from the same clock.
+ * The mean of that delay is added to the transmit timestamp afterwards, so
+ * the basic mode reports the same time the interleaved mode does. Samples
+ * come from the client requests answered on the interface.
+ */
+class NTP_TxCalibration {
+
+public:
+    NTP_TxCalibration( );
+
+    /**************************************************************************************************
+     *    Function      : GetDefaultConfig
+     *    Class         : NTP_TxCalibration
+     *    Description   : Gets the default config, not calibrated
+     *    Input         : none
+     *    Output        : ntp_txcal_settings_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    static ntp_txcal_settings_t GetDefaultConfig( void );
+
+    /**************************************************************************************************
+     *    Function      : SetConfig
+     *    Class         : NTP_TxCalibration
+     *    Description   : Applys the passed config
+     *    Input         : const ntp_txcal_settings_t* new_conf
+     *    Output        : none
+     *    Remarks       : Built in the spare buffer and swapped in
+     **************************************************************************************************/
+    void SetConfig( const ntp_txcal_settings_t* new_conf );
+
+    /**************************************************************************************************
+     *    Function      : GetConfig
+     *    Class         : NTP_TxCalibration
+     *    Description   : Gets the current config
+     *    Input         : none
+     *    Output        : ntp_txcal_settings_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    ntp_txcal_settings_t GetConfig( void );
+
+    /**************************************************************************************************
+     *    Function      : GetAdvance
+     *    Class         : NTP_TxCalibration
+     *    Description   : Returns what to add to a transmit timestamp sent on an interface
+     *    Input         : uint8_t nif
+     *    Output        : uint32_t ( 1/2^32 s )
+     *    Remarks       : 0 while disabled, not calibrated or calibrating
+     **************************************************************************************************/
+    uint32_t GetAdvance( uint8_t nif );
+
+    /**************************************************************************************************
+     *    Function      : Start
+     *    Class         : NTP_TxCalibration
+     *    Description   : Starts to measure the delay of an interface
+     *    Input         : uint8_t nif, uint16_t samples
+     *    Output        : bool
+     *    Remarks       : Fails if the interface is unknown or a calibration is running
+     **************************************************************************************************/
+    bool Start( uint8_t nif, uint16_t samples );
+
+    /**************************************************************************************************
+     *    Function      : Stop
+     *    Class         : NTP_TxCalibration
+     *    Description   : Drops a running calibration
+     *    Input         : none
+     *    Output        : none
+     *    Remarks       : none
+     **************************************************************************************************/
+    void Stop( void );
+
+    /**************************************************************************************************
+     *    Function      : Sample
+     *    Class         : NTP_TxCalibration
+     *    Description   : Adds the delay of a response that was just sent
+     *    Input         : uint8_t nif, ntp_timestamp_t stamp, ntp_timestamp_t sent
+     *    Output        : none
+     *    Remarks       : stamp is the clock reading of the transmit timestamp, sent the one after
+     *                    the send returned. Only to be called from the task sending the responses
+     **************************************************************************************************/
+    void Sample( uint8_t nif, ntp_timestamp_t stamp, ntp_timestamp_t sent );
+
+    /**************************************************************************************************
+     *    Function      : GetProgress
+     *    Class         : NTP_TxCalibration
+     *    Description   : Returns the state of the calibration
+     *    Input         : none
+     *    Output        : ntp_txcal_progress_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    ntp_txcal_progress_t GetProgress( void );
+
+    /**************************************************************************************************
+     *    Function      : TakeResult
+     *    Class         : NTP_TxCalibration
+     *    Description   : Applies a finished calibration
+     *    Input         : ntp_txcal_settings_t* out
+     *    Output        : bool
+     *    Remarks       : Returns true once per calibration with the new config in out, to be stored
+     **************************************************************************************************/
+    bool TakeResult( ntp_txcal_settings_t* out );
+
+    /**************************************************************************************************
+     *    Function      : GetInterfaceName
+     *    Class         : NTP_TxCalibration
+     *    Description   : Returns the name of an interface for reports
+     *    Input         : uint8_t nif
+     *    Output        : const char*
+     *    Remarks       : none
+     **************************************************************************************************/
+    static const char* GetInterfaceName( uint8_t nif );
+
+private:
+    typedef enum {
+      NTP_TXCAL_IDLE = 0,
+      NTP_TXCAL_RUNNING,
+      NTP_TXCAL_DONE
+    } ntp_txcal_state_t;
+
+    /* The config and the advances made from it, a new one is built in the spare buffer */
+    ntp_txcal_settings_t conf[2];
+    uint32_t advance[2][NTP_TXCAL_INTERFACES];
+    volatile uint8_t conf_idx;
+
+    volatile ntp_txcal_state_t state;
+    uint8_t netif;
+    uint16_t target;
+    volatile uint16_t count;
+    volatile uint32_t rejected;
+    int64_t sum;
+    uint64_t sum_sq;
+    ntp_txcal_entry_t result;
+};
+
+#endif
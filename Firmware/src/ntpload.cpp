@@ -0,0 +1,512 @@
+/*
+ * Load generator for the NTP server, a host tool and not part of the firmware.
+ * Sends mode 3 requests at a given rate from a number of client sockets and
+ * writes a JSON report, so runs against different firmware revisions can be
+ * compared. Works against the board and against the native build.
+ *
+ *   pio run -e ntpload && .pio/build/ntpload/program -a 127.0.0.1 -p 123 -r 100000 -d 10
+ */
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <pthread.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "ntp_timestamp.h"
+
+/* RTTs are kept in 1us bins, anything slower lands in the last one */
+#define NTPLOAD_RTT_BINS ( 65536 )
+
+#define NTPLOAD_WORKERS_MAX ( 64 )
+#define NTPLOAD_CLIENTS_MAX ( 4096 )
+#define NTPLOAD_BATCH ( 64 )
+#define NTPLOAD_PACKET_LEN ( 48 )
+
+typedef struct {
+  const char* host;
+  const char* port;
+  double rate;              /* Requests per second, all workers together */
+  uint32_t burst;           /* Requests sent back to back */
+  uint32_t clients;         /* Sockets, each one a client with its own source port */
+  uint32_t workers;
+  double duration;          /* Seconds of sending */
+  double drain;             /* Seconds to wait for late responses */
+  uint8_t version;
+  const char* report;
+} ntpload_config_t;
+
+typedef struct {
+  uint64_t sent;
+  uint64_t send_errors;
+  uint64_t received;
+  uint64_t kod;             /* Kiss-o'-Death, stratum 0 */
+  uint64_t unsynced;        /* Leap indicator 3 */
+  uint64_t invalid;         /* Wrong mode, length or an origin we never sent */
+  uint64_t backwards;       /* Transmit timestamp older than the one before to this client */
+  uint64_t rx_after_tx;     /* Server receive timestamp after its transmit timestamp */
+  uint32_t rtt_bins[NTPLOAD_RTT_BINS];
+  double rtt_min;
+  double rtt_max;
+  double offset_sum;
+  double offset_sq_sum;
+  double offset_min;
+  double offset_max;
+} ntpload_result_t;
+
+typedef struct {
+  int fd;
+  uint64_t last_tx;         /* Last server transmit timestamp seen, 32.32 */
+} ntpload_client_t;
+
+typedef struct {
+  const ntpload_config_t* conf;
+  struct sockaddr_storage target;
+  socklen_t target_len;
+  uint32_t client_count;
+  ntpload_client_t clients[NTPLOAD_CLIENTS_MAX];
+  ntpload_result_t result;
+  pthread_t thread;
+} ntpload_worker_t;
+
+/**************************************************************************************************
+ *    Function      : ntpload_now
+ *    Description   : Returns the host time as 32.32 NTP timestamp
+ *    Input         : none
+ *    Output        : uint64_t
+ *    Remarks       : none
+ **************************************************************************************************/
+static uint64_t ntpload_now( void ){
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return ( (uint64_t)( ts.tv_sec + NTP_TIMESTAMP_DELTA ) << 32 ) | ( ( (uint64_t)ts.tv_nsec << 32 ) / 1000000000ull );
+}
+
+/**************************************************************************************************
+ *    Function      : ntpload_from_timespec
+ *    Description   : Converts a kernel timestamp to 32.32 NTP format
+ *    Input         : const struct timespec* ts
+ *    Output        : uint64_t
+ *    Remarks       : none
+ **************************************************************************************************/
+static uint64_t ntpload_from_timespec( const struct timespec* ts ){
+  return ( (uint64_t)( ts->tv_sec + NTP_TIMESTAMP_DELTA ) << 32 ) | ( ( (uint64_t)ts->tv_nsec << 32 ) / 1000000000ull );
+}
+
+static double ntpload_monotonic( void ){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ( ts.tv_nsec / 1e9 );
+}
+
+static uint64_t ntpload_get64( const uint8_t* p ){
+  uint64_t v = 0;
+  for(uint8_t i=0;i<8;i++){
+    v = ( v << 8 ) | p[i];
+  }
+  return v;
+}
+
+static void ntpload_put64( uint8_t* p, uint64_t v ){
+  for(int8_t i=7;i>=0;i--){
+    p[i] = v;
+    v >>= 8;
+  }
+}
+
+/* Difference of two 32.32 timestamps in seconds, they are close enough to ignore the era */
+static double ntpload_diff( uint64_t a, uint64_t b ){
+  return (double)(int64_t)( a - b ) / 4294967296.0;
+}
+
+/**************************************************************************************************
+ *    Function      : ntpload_send_burst
+ *    Description   : Sends a burst of requests, one per client in turn
+ *    Input         : ntpload_worker_t* w, uint32_t count, uint32_t* next_client
+ *    Output        : none
+ *    Remarks       : The transmit timestamp is the send time, the server echoes it as origin
+ **************************************************************************************************/
+static void ntpload_send_burst( ntpload_worker_t* w, uint32_t count, uint32_t* next_client ){
+  uint8_t pkt[NTPLOAD_PACKET_LEN];
+  memset(pkt, 0, sizeof(pkt));
+  pkt[0] = ( w->conf->version << 3 ) | 3;
+  for(uint32_t i=0;i<count;i++){
+    ntpload_client_t* c = &w->clients[*next_client];
+    *next_client = ( *next_client + 1 ) % w->client_count;
+    ntpload_put64(&pkt[40], ntpload_now());
+    if(sizeof(pkt) == sendto(c->fd, pkt, sizeof(pkt), 0, (const struct sockaddr*)&w->target, w->target_len)){
+      w->result.sent++;
+    } else {
+      w->result.send_errors++;
+    }
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : ntpload_account
+ *    Description   : Checks a response and adds it to the results
+ *    Input         : ntpload_worker_t* w, ntpload_client_t* c, const uint8_t* pkt, ssize_t len, uint64_t t4
+ *    Output        : none
+ *    Remarks       : t4 is the kernel receive timestamp
+ **************************************************************************************************/
+static void ntpload_account( ntpload_worker_t* w, ntpload_client_t* c, const uint8_t* pkt, ssize_t len, uint64_t t4 ){
+  ntpload_result_t* r = &w->result;
+  if( (len < NTPLOAD_PACKET_LEN) || ( ( pkt[0] & 0x07 ) != 4 ) ){
+    r->invalid++;
+    return;
+  }
+  uint64_t t1 = ntpload_get64(&pkt[24]);
+  uint64_t t2 = ntpload_get64(&pkt[32]);
+  uint64_t t3 = ntpload_get64(&pkt[40]);
+  if( (t1 == 0) || (ntpload_diff(t4, t1) < 0) || (ntpload_diff(t4, t1) > 60) ){
+    r->invalid++;
+    return;
+  }
+  r->received++;
+  if(pkt[1] == 0){
+    r->kod++;
+    return;
+  }
+  if( ( pkt[0] >> 6 ) == 3 ){
+    r->unsynced++;
+  }
+  if(ntpload_diff(t2, t3) > 0){
+    r->rx_after_tx++;
+  }
+  if( (c->last_tx != 0) && (ntpload_diff(t3, c->last_tx) < 0) ){
+    r->backwards++;
+  }
+  c->last_tx = t3;
+
+  double rtt = ntpload_diff(t4, t1) - ntpload_diff(t3, t2);
+  double offset = ( ntpload_diff(t2, t1) + ntpload_diff(t3, t4) ) / 2;
+  bool first = ( ( r->received - r->kod ) == 1 );
+  uint64_t bin = ( rtt <= 0 ) ? 0 : (uint64_t)( rtt * 1e6 );
+  if(bin >= NTPLOAD_RTT_BINS){
+    bin = NTPLOAD_RTT_BINS - 1;
+  }
+  r->rtt_bins[bin]++;
+  if( (true == first) || (rtt < r->rtt_min) ){
+    r->rtt_min = rtt;
+  }
+  if( (true == first) || (rtt > r->rtt_max) ){
+    r->rtt_max = rtt;
+  }
+  if( (true == first) || (offset < r->offset_min) ){
+    r->offset_min = offset;
+  }
+  if( (true == first) || (offset > r->offset_max) ){
+    r->offset_max = offset;
+  }
+  r->offset_sum += offset;
+  r->offset_sq_sum += offset * offset;
+}
+
+/**************************************************************************************************
+ *    Function      : ntpload_receive
+ *    Description   : Reads the responses waiting on the sockets of a worker
+ *    Input         : ntpload_worker_t* w, struct pollfd* fds, int timeout_ms
+ *    Output        : none
+ *    Remarks       : Waits at most timeout_ms for the first one
+ **************************************************************************************************/
+static void ntpload_receive( ntpload_worker_t* w, struct pollfd* fds, int timeout_ms ){
+  struct mmsghdr msgs[NTPLOAD_BATCH];
+  struct iovec iov[NTPLOAD_BATCH];
+  uint8_t bufs[NTPLOAD_BATCH][NTPLOAD_PACKET_LEN + 16];
+  uint8_t ctrl[NTPLOAD_BATCH][64];
+
+  if(poll(fds, w->client_count, timeout_ms) <= 0){
+    return;
+  }
+  uint64_t fallback = ntpload_now();
+  for(uint32_t i=0;i<w->client_count;i++){
+    if(0 == ( fds[i].revents & POLLIN ) ){
+      continue;
+    }
+    for(uint32_t j=0;j<NTPLOAD_BATCH;j++){
+      iov[j].iov_base = bufs[j];
+      iov[j].iov_len = sizeof(bufs[j]);
+      memset(&msgs[j].msg_hdr, 0, sizeof(msgs[j].msg_hdr));
+      msgs[j].msg_hdr.msg_iov = &iov[j];
+      msgs[j].msg_hdr.msg_iovlen = 1;
+      msgs[j].msg_hdr.msg_control = ctrl[j];
+      msgs[j].msg_hdr.msg_controllen = sizeof(ctrl[j]);
+    }
+    int n = recvmmsg(w->clients[i].fd, msgs, NTPLOAD_BATCH, MSG_DONTWAIT, NULL);
+    for(int j=0;j<n;j++){
+      uint64_t t4 = fallback;
+      for(struct cmsghdr* c = CMSG_FIRSTHDR(&msgs[j].msg_hdr); c != NULL; c = CMSG_NXTHDR(&msgs[j].msg_hdr, c)){
+        if( (c->cmsg_level == SOL_SOCKET) && (c->cmsg_type == SCM_TIMESTAMPNS) ){
+          struct timespec ts;
+          memcpy(&ts, CMSG_DATA(c), sizeof(ts));
+          t4 = ntpload_from_timespec(&ts);
+        }
+      }
+      ntpload_account(w, &w->clients[i], bufs[j], msgs[j].msg_len, t4);
+    }
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : ntpload_worker
+ *    Description   : Sends bursts at the configured rate and reads the responses in between
+ *    Input         : void* param
+ *    Output        : void*
+ *    Remarks       : One thread per worker, each with its own clients
+ **************************************************************************************************/
+static void* ntpload_worker( void* param ){
+  ntpload_worker_t* w = (ntpload_worker_t*)param;
+  const ntpload_config_t* conf = w->conf;
+  struct pollfd fds[NTPLOAD_CLIENTS_MAX];
+  uint32_t next_client = 0;
+
+  for(uint32_t i=0;i<w->client_count;i++){
+    fds[i].fd = w->clients[i].fd;
+    fds[i].events = POLLIN;
+  }
+
+  double interval = ( conf->burst * conf->workers ) / conf->rate;
+  double start = ntpload_monotonic();
+  double next = start;
+  double stop = start + conf->duration;
+  while(1==1){
+    double now = ntpload_monotonic();
+    if(now >= stop){
+      break;
+    }
+    if(now >= next){
+      ntpload_send_burst(w, conf->burst, &next_client);
+      next += interval;
+      /* A worker that fell behind does not try to catch up with one huge burst */
+      if(next < now - 1.0){
+        next = now;
+      }
+      continue;
+    }
+    int wait_ms = (int)( ( next - now ) * 1000 );
+    ntpload_receive(w, fds, wait_ms);
+  }
+  stop = ntpload_monotonic() + conf->drain;
+  while(ntpload_monotonic() < stop){
+    ntpload_receive(w, fds, 10);
+  }
+  return NULL;
+}
+
+/**************************************************************************************************
+ *    Function      : ntpload_percentile
+ *    Description   : Returns a percentile of the RTT histogram in microseconds
+ *    Input         : const ntpload_result_t* r, double p
+ *    Output        : double
+ *    Remarks       : none
+ **************************************************************************************************/
+static double ntpload_percentile( const ntpload_result_t* r, double p ){
+  uint64_t total = 0;
+  for(uint32_t i=0;i<NTPLOAD_RTT_BINS;i++){
+    total += r->rtt_bins[i];
+  }
+  if(total == 0){
+    return 0;
+  }
+  uint64_t want = (uint64_t)ceil(total * p);
+  uint64_t seen = 0;
+  for(uint32_t i=0;i<NTPLOAD_RTT_BINS;i++){
+    seen += r->rtt_bins[i];
+    if( (seen >= want) && (seen > 0) ){
+      return i;
+    }
+  }
+  return NTPLOAD_RTT_BINS - 1;
+}
+
+/**************************************************************************************************
+ *    Function      : ntpload_merge
+ *    Description   : Adds the results of a worker to the total
+ *    Input         : ntpload_result_t* total, const ntpload_result_t* r
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+static void ntpload_merge( ntpload_result_t* total, const ntpload_result_t* r ){
+  bool first = ( ( total->received - total->kod ) == 0 );
+  total->sent += r->sent;
+  total->send_errors += r->send_errors;
+  total->kod += r->kod;
+  total->unsynced += r->unsynced;
+  total->invalid += r->invalid;
+  total->backwards += r->backwards;
+  total->rx_after_tx += r->rx_after_tx;
+  for(uint32_t i=0;i<NTPLOAD_RTT_BINS;i++){
+    total->rtt_bins[i] += r->rtt_bins[i];
+  }
+  if( r->received > r->kod ){
+    if( (true == first) || (r->offset_min < total->offset_min) ){
+      total->offset_min = r->offset_min;
+    }
+    if( (true == first) || (r->offset_max > total->offset_max) ){
+      total->offset_max = r->offset_max;
+    }
+    if( (true == first) || (r->rtt_min < total->rtt_min) ){
+      total->rtt_min = r->rtt_min;
+    }
+    if( (true == first) || (r->rtt_max > total->rtt_max) ){
+      total->rtt_max = r->rtt_max;
+    }
+  }
+  total->received += r->received;
+  total->offset_sum += r->offset_sum;
+  total->offset_sq_sum += r->offset_sq_sum;
+}
+
+/**************************************************************************************************
+ *    Function      : ntpload_report
+ *    Description   : Writes the results as JSON
+ *    Input         : FILE* f, const ntpload_config_t* conf, const ntpload_result_t* r, double elapsed
+ *    Output        : none
+ *    Remarks       : Times in microseconds
+ **************************************************************************************************/
+static void ntpload_report( FILE* f, const ntpload_config_t* conf, const ntpload_result_t* r, double elapsed ){
+  uint64_t timed = r->received - r->kod;
+  double mean = ( timed > 0 ) ? r->offset_sum / timed : 0;
+  double var = ( timed > 0 ) ? ( r->offset_sq_sum / timed ) - ( mean * mean ) : 0;
+  uint64_t lost = ( r->sent > r->received ) ? r->sent - r->received : 0;
+  fprintf(f, "{\n");
+  fprintf(f, "  \"target\": \"%s\",\n  \"port\": \"%s\",\n", conf->host, conf->port);
+  fprintf(f, "  \"rate\": %.0f,\n  \"burst\": %u,\n  \"clients\": %u,\n  \"workers\": %u,\n  \"duration\": %.3f,\n",
+          conf->rate, conf->burst, conf->clients, conf->workers, conf->duration);
+  fprintf(f, "  \"sent\": %llu,\n  \"send_errors\": %llu,\n  \"received\": %llu,\n  \"lost\": %llu,\n",
+          (unsigned long long)r->sent, (unsigned long long)r->send_errors, (unsigned long long)r->received, (unsigned long long)lost);
+  fprintf(f, "  \"loss_ratio\": %.6f,\n", ( r->sent > 0 ) ? (double)lost / r->sent : 0.0);
+  fprintf(f, "  \"throughput_pps\": %.1f,\n", r->received / elapsed);
+  fprintf(f, "  \"kod\": %llu,\n  \"unsynced\": %llu,\n  \"invalid\": %llu,\n",
+          (unsigned long long)r->kod, (unsigned long long)r->unsynced, (unsigned long long)r->invalid);
+  fprintf(f, "  \"rtt_us\": { \"min\": %.1f, \"p50\": %.0f, \"p90\": %.0f, \"p99\": %.0f, \"p999\": %.0f, \"max\": %.1f },\n",
+          r->rtt_min * 1e6, ntpload_percentile(r, 0.5), ntpload_percentile(r, 0.9), ntpload_percentile(r, 0.99),
+          ntpload_percentile(r, 0.999), r->rtt_max * 1e6);
+  fprintf(f, "  \"offset_us\": { \"mean\": %.3f, \"stddev\": %.3f, \"min\": %.3f, \"max\": %.3f },\n",
+          mean * 1e6, sqrt( ( var > 0 ) ? var : 0 ) * 1e6, r->offset_min * 1e6, r->offset_max * 1e6);
+  fprintf(f, "  \"monotonic\": { \"backwards\": %llu, \"rx_after_tx\": %llu }\n",
+          (unsigned long long)r->backwards, (unsigned long long)r->rx_after_tx);
+  fprintf(f, "}\n");
+}
+
+static void usage( const char* name ){
+  fprintf(stderr, "usage: %s -a host [-p port] [-r rate/s] [-b burst] [-c clients] [-j workers]\n"
+                  "          [-d seconds] [-w drain seconds] [-v version] [-o report.json]\n", name);
+}
+
+int main( int argc, char** argv ){
+  ntpload_config_t conf;
+  struct addrinfo hints;
+  struct addrinfo* res = NULL;
+  int opt;
+
+  memset(&conf, 0, sizeof(conf));
+  conf.host = "127.0.0.1";
+  conf.port = "123";
+  conf.rate = 1000;
+  conf.burst = 1;
+  conf.clients = 16;
+  conf.workers = 1;
+  conf.duration = 10;
+  conf.drain = 1;
+  conf.version = 4;
+  while( -1 != ( opt = getopt(argc, argv, "a:p:r:b:c:j:d:w:v:o:h") ) ){
+    switch(opt){
+      case 'a': conf.host = optarg; break;
+      case 'p': conf.port = optarg; break;
+      case 'r': conf.rate = atof(optarg); break;
+      case 'b': conf.burst = atoi(optarg); break;
+      case 'c': conf.clients = atoi(optarg); break;
+      case 'j': conf.workers = atoi(optarg); break;
+      case 'd': conf.duration = atof(optarg); break;
+      case 'w': conf.drain = atof(optarg); break;
+      case 'v': conf.version = atoi(optarg); break;
+      case 'o': conf.report = optarg; break;
+      default:{
+        usage(argv[0]);
+        return 1;
+      }
+    }
+  }
+  if( (conf.rate <= 0) || (conf.burst == 0) || (conf.workers == 0) || (conf.workers > NTPLOAD_WORKERS_MAX) ||
+      (conf.clients < conf.workers) || (conf.clients > NTPLOAD_CLIENTS_MAX) || (conf.duration <= 0) ||
+      (conf.version < 1) || (conf.version > 4) ){
+    usage(argv[0]);
+    return 1;
+  }
+
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_socktype = SOCK_DGRAM;
+  if( (0 != getaddrinfo(conf.host, conf.port, &hints, &res)) || (res == NULL) ){
+    fprintf(stderr, "can't resolve %s\n", conf.host);
+    return 1;
+  }
+
+  /* The workers are large, the RTT histogram is part of them */
+  ntpload_worker_t* workers = (ntpload_worker_t*)calloc(conf.workers, sizeof(ntpload_worker_t));
+  ntpload_result_t* total = (ntpload_result_t*)calloc(1, sizeof(ntpload_result_t));
+  if( (workers == NULL) || (total == NULL) ){
+    return 1;
+  }
+  for(uint32_t i=0;i<conf.workers;i++){
+    ntpload_worker_t* w = &workers[i];
+    w->conf = &conf;
+    memcpy(&w->target, res->ai_addr, res->ai_addrlen);
+    w->target_len = res->ai_addrlen;
+    w->client_count = ( conf.clients / conf.workers ) + ( ( i < ( conf.clients % conf.workers ) ) ? 1 : 0 );
+    for(uint32_t j=0;j<w->client_count;j++){
+      int on = 1;
+      int size = 1 << 20;
+      w->clients[j].fd = socket(res->ai_family, SOCK_DGRAM, 0);
+      if(w->clients[j].fd < 0){
+        perror("socket");
+        return 1;
+      }
+      setsockopt(w->clients[j].fd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on));
+      setsockopt(w->clients[j].fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    }
+  }
+  freeaddrinfo(res);
+
+  double start = ntpload_monotonic();
+  for(uint32_t i=0;i<conf.workers;i++){
+    pthread_create(&workers[i].thread, NULL, ntpload_worker, &workers[i]);
+  }
+  for(uint32_t i=0;i<conf.workers;i++){
+    pthread_join(workers[i].thread, NULL);
+    ntpload_merge(total, &workers[i].result);
+  }
+  double elapsed = ntpload_monotonic() - start - conf.drain;
+
+  FILE* f = stdout;
+  if(conf.report != NULL){
+    f = fopen(conf.report, "w");
+    if(f == NULL){
+      perror(conf.report);
+      return 1;
+    }
+  }
+  ntpload_report(f, &conf, total, ( elapsed > 0 ) ? elapsed : conf.duration);
+  if(f != stdout){
+    fclose(f);
+  }
+  for(uint32_t i=0;i<conf.workers;i++){
+    for(uint32_t j=0;j<workers[i].client_count;j++){
+      close(workers[i].clients[j].fd);
+    }
+  }
+  free(workers);
+  free(total);
+  return 0;
+}
+
+#endif
@@ -0,0 +1,289 @@
+#include <string.h>
+#include "mbedtls/sha512.h"
+#include "sodium.h"
+#include "roughtime.h"
+
+/* Leaves and nodes are hashed with a prefix, so a leaf can't pass as a node */
+#define ROUGHTIME_LEAF_PREFIX ( 0x00 )
+#define ROUGHTIME_NODE_PREFIX ( 0x01 )
+
+static uint32_t roughtime_get32( const uint8_t* p ){
+  return (uint32_t)p[0] | ( (uint32_t)p[1] << 8 ) | ( (uint32_t)p[2] << 16 ) | ( (uint32_t)p[3] << 24 );
+}
+
+static void roughtime_put32( uint8_t* p, uint32_t v ){
+  p[0] = v;
+  p[1] = v >> 8;
+  p[2] = v >> 16;
+  p[3] = v >> 24;
+}
+
+static void roughtime_put64( uint8_t* p, uint64_t v ){
+  roughtime_put32(p, (uint32_t)v);
+  roughtime_put32(&p[4], (uint32_t)( v >> 32 ));
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_write_message
+ *    Description   : Encodes a message from its tags and values
+ *    Input         : uint8_t* out, uint8_t count, const uint32_t* tags, const uint8_t* const* values,
+ *                    const uint16_t* lens
+ *    Output        : uint16_t ( length of the message )
+ *    Remarks       : The tags need to be in ascending order and the lengths multiples of four
+ **************************************************************************************************/
+static uint16_t roughtime_write_message( uint8_t* out, uint8_t count, const uint32_t* tags, const uint8_t* const* values, const uint16_t* lens ){
+  uint16_t header = 8 * count;
+  uint16_t offset = 0;
+  roughtime_put32(out, count);
+  for(uint8_t i=0;i<count;i++){
+    if(i > 0){
+      roughtime_put32(&out[4 * i], offset);
+    }
+    roughtime_put32(&out[header - ( 4 * ( count - i ) )], tags[i]);
+    memcpy(&out[header + offset], values[i], lens[i]);
+    offset += lens[i];
+  }
+  return header + offset;
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_find_nonce
+ *    Description   : Checks a request and finds its nonce
+ *    Input         : const uint8_t* data, uint16_t len
+ *    Output        : const uint8_t* ( the nonce or NULL if the request is malformed )
+ *    Remarks       : none
+ **************************************************************************************************/
+const uint8_t* roughtime_find_nonce( const uint8_t* data, uint16_t len ){
+  const uint8_t* nonce = NULL;
+  if( (len < ROUGHTIME_REQUEST_MIN_LEN) || ( (len % 4) != 0 ) ){
+    return NULL;
+  }
+  uint32_t count = roughtime_get32(data);
+  if( (count == 0) || (count > ( len / 8 ) ) ){
+    return NULL;
+  }
+  uint16_t header = 8 * count;
+  uint16_t values = len - header;
+  uint32_t start = 0;
+  uint32_t last_tag = 0;
+  for(uint32_t i=0;i<count;i++){
+    uint32_t end = ( i == ( count - 1 ) ) ? values : roughtime_get32(&data[4 + ( 4 * i )]);
+    uint32_t tag = roughtime_get32(&data[header - ( 4 * ( count - i ) )]);
+    if( (end < start) || (end > values) || ( (end % 4) != 0 ) ){
+      return NULL;
+    }
+    if( (i > 0) && (tag <= last_tag) ){
+      return NULL;
+    }
+    if( (tag == ROUGHTIME_TAG_NONC) && ( ( end - start ) == ROUGHTIME_NONCE_LEN ) ){
+      nonce = &data[header + start];
+    }
+    last_tag = tag;
+    start = end;
+  }
+  return nonce;
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_tree_build
+ *    Description   : Builds the Merkle tree over the nonces of a batch
+ *    Input         : roughtime_tree_t* tree, const uint8_t (*nonces)[ROUGHTIME_NONCE_LEN], uint8_t count
+ *    Output        : const uint8_t* ( the root )
+ *    Remarks       : count is 1 to ROUGHTIME_BATCH_MAX, unused leaves repeat the last nonce
+ **************************************************************************************************/
+const uint8_t* roughtime_tree_build( roughtime_tree_t* tree, const uint8_t (*nonces)[ROUGHTIME_NONCE_LEN], uint8_t count ){
+  const uint8_t leaf_prefix = ROUGHTIME_LEAF_PREFIX;
+  const uint8_t node_prefix = ROUGHTIME_NODE_PREFIX;
+  mbedtls_sha512_context ctx;
+
+  tree->width = 1;
+  tree->depth = 0;
+  while(tree->width < count){
+    tree->width <<= 1;
+    tree->depth++;
+  }
+
+  mbedtls_sha512_init(&ctx);
+  for(uint8_t i=0;i<count;i++){
+    mbedtls_sha512_starts_ret(&ctx, 0);
+    mbedtls_sha512_update_ret(&ctx, &leaf_prefix, 1);
+    mbedtls_sha512_update_ret(&ctx, nonces[i], ROUGHTIME_NONCE_LEN);
+    mbedtls_sha512_finish_ret(&ctx, tree->nodes[i]);
+  }
+  for(uint8_t i=count;i<tree->width;i++){
+    memcpy(tree->nodes[i], tree->nodes[count - 1], ROUGHTIME_HASH_LEN);
+  }
+
+  /* Each level is stored right behind the one below it */
+  uint16_t below = 0;
+  uint16_t level = tree->width;
+  for(uint8_t width = tree->width / 2; width > 0; width /= 2){
+    for(uint8_t i=0;i<width;i++){
+      mbedtls_sha512_starts_ret(&ctx, 0);
+      mbedtls_sha512_update_ret(&ctx, &node_prefix, 1);
+      mbedtls_sha512_update_ret(&ctx, tree->nodes[below + ( 2 * i )], ROUGHTIME_HASH_LEN);
+      mbedtls_sha512_update_ret(&ctx, tree->nodes[below + ( 2 * i ) + 1], ROUGHTIME_HASH_LEN);
+      mbedtls_sha512_finish_ret(&ctx, tree->nodes[level + i]);
+    }
+    below = level;
+    level += width;
+  }
+  mbedtls_sha512_free(&ctx);
+  return tree->nodes[level - 1];
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_tree_path
+ *    Description   : Copies the path from a leaf to the root
+ *    Input         : const roughtime_tree_t* tree, uint8_t index, uint8_t* path
+ *    Output        : none
+ *    Remarks       : path needs room for depth hashes, the sibling of the leaf first
+ **************************************************************************************************/
+void roughtime_tree_path( const roughtime_tree_t* tree, uint8_t index, uint8_t* path ){
+  uint16_t level = 0;
+  uint8_t width = tree->width;
+  for(uint8_t i=0;i<tree->depth;i++){
+    memcpy(&path[i * ROUGHTIME_HASH_LEN], tree->nodes[level + ( index ^ 1 )], ROUGHTIME_HASH_LEN);
+    level += width;
+    width /= 2;
+    index /= 2;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_build_srep
+ *    Description   : Encodes the signed part of a response
+ *    Input         : uint8_t* out, uint32_t radius, uint64_t midpoint, const uint8_t* root
+ *    Output        : uint16_t ( ROUGHTIME_SREP_LEN )
+ *    Remarks       : radius and midpoint in microseconds, the midpoint since the UNIX epoch
+ **************************************************************************************************/
+uint16_t roughtime_build_srep( uint8_t* out, uint32_t radius, uint64_t midpoint, const uint8_t* root ){
+  uint8_t radi[4];
+  uint8_t midp[8];
+  roughtime_put32(radi, radius);
+  roughtime_put64(midp, midpoint);
+  const uint32_t tags[3] = { ROUGHTIME_TAG_RADI, ROUGHTIME_TAG_MIDP, ROUGHTIME_TAG_ROOT };
+  const uint8_t* values[3] = { radi, midp, root };
+  const uint16_t lens[3] = { sizeof(radi), sizeof(midp), ROUGHTIME_HASH_LEN };
+  return roughtime_write_message(out, 3, tags, values, lens);
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_build_dele
+ *    Description   : Encodes the delegation of the online key
+ *    Input         : uint8_t* out, const uint8_t* pubkey, uint64_t mint, uint64_t maxt
+ *    Output        : uint16_t ( ROUGHTIME_DELE_LEN )
+ *    Remarks       : The online key may only sign midpoints between mint and maxt
+ **************************************************************************************************/
+uint16_t roughtime_build_dele( uint8_t* out, const uint8_t* pubkey, uint64_t mint, uint64_t maxt ){
+  uint8_t min[8];
+  uint8_t max[8];
+  roughtime_put64(min, mint);
+  roughtime_put64(max, maxt);
+  const uint32_t tags[3] = { ROUGHTIME_TAG_PUBK, ROUGHTIME_TAG_MINT, ROUGHTIME_TAG_MAXT };
+  const uint8_t* values[3] = { pubkey, min, max };
+  const uint16_t lens[3] = { ROUGHTIME_PUBKEY_LEN, sizeof(min), sizeof(max) };
+  return roughtime_write_message(out, 3, tags, values, lens);
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_build_cert
+ *    Description   : Encodes the delegation with its signature by the long term key
+ *    Input         : uint8_t* out, const uint8_t* sig, const uint8_t* dele
+ *    Output        : uint16_t ( ROUGHTIME_CERT_LEN )
+ *    Remarks       : none
+ **************************************************************************************************/
+uint16_t roughtime_build_cert( uint8_t* out, const uint8_t* sig, const uint8_t* dele ){
+  const uint32_t tags[2] = { ROUGHTIME_TAG_SIG, ROUGHTIME_TAG_DELE };
+  const uint8_t* values[2] = { sig, dele };
+  const uint16_t lens[2] = { ROUGHTIME_SIG_LEN, ROUGHTIME_DELE_LEN };
+  return roughtime_write_message(out, 2, tags, values, lens);
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_build_response
+ *    Description   : Encodes the response to one request of a batch
+ *    Input         : uint8_t* out, const uint8_t* sig, const uint8_t* path, uint8_t depth,
+ *                    const uint8_t* srep, const uint8_t* cert, uint32_t index
+ *    Output        : uint16_t ( length of the response )
+ *    Remarks       : out needs room for ROUGHTIME_RESPONSE_MAX_LEN bytes
+ **************************************************************************************************/
+uint16_t roughtime_build_response( uint8_t* out, const uint8_t* sig, const uint8_t* path, uint8_t depth, const uint8_t* srep, const uint8_t* cert, uint32_t index ){
+  uint8_t indx[4];
+  roughtime_put32(indx, index);
+  const uint32_t tags[5] = { ROUGHTIME_TAG_SIG, ROUGHTIME_TAG_PATH, ROUGHTIME_TAG_SREP, ROUGHTIME_TAG_CERT, ROUGHTIME_TAG_INDX };
+  const uint8_t* values[5] = { sig, path, srep, cert, indx };
+  const uint16_t lens[5] = { ROUGHTIME_SIG_LEN, (uint16_t)( depth * ROUGHTIME_HASH_LEN ), ROUGHTIME_SREP_LEN, ROUGHTIME_CERT_LEN, sizeof(indx) };
+  return roughtime_write_message(out, 5, tags, values, lens);
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_public_key
+ *    Description   : Derives the public long term key from its seed
+ *    Input         : const uint8_t* seed, uint8_t* pubkey
+ *    Output        : none
+ *    Remarks       : pubkey needs room for ROUGHTIME_PUBKEY_LEN bytes
+ **************************************************************************************************/
+void roughtime_public_key( const uint8_t* seed, uint8_t* pubkey ){
+  uint8_t sk[ROUGHTIME_SECRET_LEN];
+  crypto_sign_ed25519_seed_keypair(pubkey, sk, seed);
+  memset(sk, 0, sizeof(sk));
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_delegate
+ *    Description   : Creates a new online key and signs its delegation with the long term key
+ *    Input         : roughtime_online_key_t* key, const uint8_t* seed, uint64_t now
+ *    Output        : none
+ *    Remarks       : now in microseconds since the UNIX epoch, the delegation covers
+ *                    ROUGHTIME_DELE_BEFORE before it to ROUGHTIME_DELE_AFTER after it
+ **************************************************************************************************/
+void roughtime_delegate( roughtime_online_key_t* key, const uint8_t* seed, uint64_t now ){
+  uint8_t lt_pk[ROUGHTIME_PUBKEY_LEN];
+  uint8_t lt_sk[ROUGHTIME_SECRET_LEN];
+  uint8_t online_seed[ROUGHTIME_SEED_LEN];
+  uint8_t online_pk[ROUGHTIME_PUBKEY_LEN];
+  uint8_t msg[sizeof(ROUGHTIME_CONTEXT_DELE) + ROUGHTIME_DELE_LEN];
+  uint8_t sig[ROUGHTIME_SIG_LEN];
+
+  crypto_sign_ed25519_seed_keypair(lt_pk, lt_sk, seed);
+  randombytes_buf(online_seed, sizeof(online_seed));
+  crypto_sign_ed25519_seed_keypair(online_pk, key->sk, online_seed);
+
+  key->mint = ( now > ROUGHTIME_DELE_BEFORE ) ? ( now - ROUGHTIME_DELE_BEFORE ) : 0;
+  key->maxt = now + ROUGHTIME_DELE_AFTER;
+  memcpy(msg, ROUGHTIME_CONTEXT_DELE, sizeof(ROUGHTIME_CONTEXT_DELE));
+  roughtime_build_dele(&msg[sizeof(ROUGHTIME_CONTEXT_DELE)], online_pk, key->mint, key->maxt);
+  crypto_sign_ed25519_detached(sig, NULL, msg, sizeof(msg), lt_sk);
+  roughtime_build_cert(key->cert, sig, &msg[sizeof(ROUGHTIME_CONTEXT_DELE)]);
+
+  memset(lt_sk, 0, sizeof(lt_sk));
+  memset(online_seed, 0, sizeof(online_seed));
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_delegation_due
+ *    Description   : Checks if an online key needs to be replaced before it signs at now
+ *    Input         : const roughtime_online_key_t* key, uint64_t now
+ *    Output        : bool
+ *    Remarks       : True if now is outside the delegation or less than ROUGHTIME_DELE_RENEW is left
+ **************************************************************************************************/
+bool roughtime_delegation_due( const roughtime_online_key_t* key, uint64_t now ){
+  return ( now < key->mint ) || ( ( now + ROUGHTIME_DELE_RENEW ) >= key->maxt );
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_sign_srep
+ *    Description   : Encodes the signed part of a response and signs it with the online key
+ *    Input         : const roughtime_online_key_t* key, uint8_t* srep, uint8_t* sig,
+ *                    uint32_t radius, uint64_t midpoint, const uint8_t* root
+ *    Output        : none
+ *    Remarks       : srep needs room for ROUGHTIME_SREP_LEN bytes, see roughtime_build_srep
+ **************************************************************************************************/
+void roughtime_sign_srep( const roughtime_online_key_t* key, uint8_t* srep, uint8_t* sig, uint32_t radius, uint64_t midpoint, const uint8_t* root ){
+  uint8_t msg[sizeof(ROUGHTIME_CONTEXT_SREP) + ROUGHTIME_SREP_LEN];
+  memcpy(msg, ROUGHTIME_CONTEXT_SREP, sizeof(ROUGHTIME_CONTEXT_SREP));
+  roughtime_build_srep(&msg[sizeof(ROUGHTIME_CONTEXT_SREP)], radius, midpoint, root);
+  crypto_sign_ed25519_detached(sig, NULL, msg, sizeof(msg), key->sk);
+  memcpy(srep, &msg[sizeof(ROUGHTIME_CONTEXT_SREP)], ROUGHTIME_SREP_LEN);
+}
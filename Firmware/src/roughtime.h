@@ -0,0 +1,178 @@
+#ifndef ROUGHTIME_H_
+ #define ROUGHTIME_H_
+
+#include <stdint.h>
+
+/* Requests are padded to 1024 bytes, so a response never is larger than its request */
+#define ROUGHTIME_REQUEST_MIN_LEN ( 1024 )
+
+#define ROUGHTIME_NONCE_LEN ( 64 )
+#define ROUGHTIME_HASH_LEN ( 64 )
+#define ROUGHTIME_SIG_LEN ( 64 )
+#define ROUGHTIME_PUBKEY_LEN ( 32 )
+#define ROUGHTIME_SEED_LEN ( 32 )
+
+/* Secret half of an Ed25519 key as libsodium keeps it, the seed and the public key */
+#define ROUGHTIME_SECRET_LEN ( 64 )
+
+/* An online key may sign midpoints from an hour before it was made to a day after, in microseconds.
+   It is replaced once less than an hour is left, a client with a clock that far off can't check
+   the time anyway */
+#define ROUGHTIME_DELE_BEFORE ( 3600ull * 1000000 )
+#define ROUGHTIME_DELE_AFTER ( 24ull * 3600 * 1000000 )
+#define ROUGHTIME_DELE_RENEW ( 3600ull * 1000000 )
+
+/* Requests signed together at most and the depth of their tree */
+#define ROUGHTIME_TREE_DEPTH_MAX ( 6 )
+#define ROUGHTIME_BATCH_MAX ( 1 << ROUGHTIME_TREE_DEPTH_MAX )
+
+/* Nodes of the largest tree, the leaves and all levels above them */
+#define ROUGHTIME_TREE_NODES ( ( 2 * ROUGHTIME_BATCH_MAX ) - 1 )
+
+/* Encoded sizes of the fixed parts of a response */
+#define ROUGHTIME_SREP_LEN ( 24 + 4 + 8 + ROUGHTIME_HASH_LEN )
+#define ROUGHTIME_DELE_LEN ( 24 + ROUGHTIME_PUBKEY_LEN + 8 + 8 )
+#define ROUGHTIME_CERT_LEN ( 16 + ROUGHTIME_SIG_LEN + ROUGHTIME_DELE_LEN )
+
+/* Response with the path of the largest tree */
+#define ROUGHTIME_RESPONSE_MAX_LEN ( 40 + ROUGHTIME_SIG_LEN + ( ROUGHTIME_TREE_DEPTH_MAX * ROUGHTIME_HASH_LEN ) + ROUGHTIME_SREP_LEN + ROUGHTIME_CERT_LEN + 4 )
+
+/* Tags are four characters read as little endian number, messages list them in ascending order */
+#define ROUGHTIME_TAG( a, b, c, d ) ( (uint32_t)(a) | ( (uint32_t)(b) << 8 ) | ( (uint32_t)(c) << 16 ) | ( (uint32_t)(d) << 24 ) )
+
+#define ROUGHTIME_TAG_SIG  ROUGHTIME_TAG('S', 'I', 'G', 0 )
+#define ROUGHTIME_TAG_NONC ROUGHTIME_TAG('N', 'O', 'N', 'C')
+#define ROUGHTIME_TAG_DELE ROUGHTIME_TAG('D', 'E', 'L', 'E')
+#define ROUGHTIME_TAG_PATH ROUGHTIME_TAG('P', 'A', 'T', 'H')
+#define ROUGHTIME_TAG_RADI ROUGHTIME_TAG('R', 'A', 'D', 'I')
+#define ROUGHTIME_TAG_PUBK ROUGHTIME_TAG('P', 'U', 'B', 'K')
+#define ROUGHTIME_TAG_MIDP ROUGHTIME_TAG('M', 'I', 'D', 'P')
+#define ROUGHTIME_TAG_SREP ROUGHTIME_TAG('S', 'R', 'E', 'P')
+#define ROUGHTIME_TAG_MINT ROUGHTIME_TAG('M', 'I', 'N', 'T')
+#define ROUGHTIME_TAG_ROOT ROUGHTIME_TAG('R', 'O', 'O', 'T')
+#define ROUGHTIME_TAG_CERT ROUGHTIME_TAG('C', 'E', 'R', 'T')
+#define ROUGHTIME_TAG_MAXT ROUGHTIME_TAG('M', 'A', 'X', 'T')
+#define ROUGHTIME_TAG_INDX ROUGHTIME_TAG('I', 'N', 'D', 'X')
+
+/* Signatures are taken over one of these, the terminating zero included */
+#define ROUGHTIME_CONTEXT_DELE "RoughTime v1 delegation signature--"
+#define ROUGHTIME_CONTEXT_SREP "RoughTime v1 response signature"
+
+/* A batch of requests as Merkle tree, the leaves first and each level above behind them */
+typedef struct {
+  uint8_t nodes[ROUGHTIME_TREE_NODES][ROUGHTIME_HASH_LEN];
+  uint8_t width;                    /* Leaves, the count rounded up to a power of two */
+  uint8_t depth;                    /* Hashes in each path */
+} roughtime_tree_t;
+
+/* The online key and its delegation by the long term key */
+typedef struct {
+  uint8_t sk[ROUGHTIME_SECRET_LEN];
+  uint8_t cert[ROUGHTIME_CERT_LEN];
+  uint64_t mint;                    /* Midpoints the delegation covers, microseconds since the UNIX epoch */
+  uint64_t maxt;
+} roughtime_online_key_t;
+
+/**************************************************************************************************
+ *    Function      : roughtime_find_nonce
+ *    Description   : Checks a request and finds its nonce
+ *    Input         : const uint8_t* data, uint16_t len
+ *    Output        : const uint8_t* ( the nonce or NULL if the request is malformed )
+ *    Remarks       : none
+ **************************************************************************************************/
+const uint8_t* roughtime_find_nonce( const uint8_t* data, uint16_t len );
+
+/**************************************************************************************************
+ *    Function      : roughtime_tree_build
+ *    Description   : Builds the Merkle tree over the nonces of a batch
+ *    Input         : roughtime_tree_t* tree, const uint8_t (*nonces)[ROUGHTIME_NONCE_LEN], uint8_t count
+ *    Output        : const uint8_t* ( the root )
+ *    Remarks       : count is 1 to ROUGHTIME_BATCH_MAX, unused leaves repeat the last nonce
+ **************************************************************************************************/
+const uint8_t* roughtime_tree_build( roughtime_tree_t* tree, const uint8_t (*nonces)[ROUGHTIME_NONCE_LEN], uint8_t count );
+
+/**************************************************************************************************
+ *    Function      : roughtime_tree_path
+ *    Description   : Copies the path from a leaf to the root
+ *    Input         : const roughtime_tree_t* tree, uint8_t index, uint8_t* path
+ *    Output        : none
+ *    Remarks       : path needs room for depth hashes, the sibling of the leaf first
+ **************************************************************************************************/
+void roughtime_tree_path( const roughtime_tree_t* tree, uint8_t index, uint8_t* path );
+
+/**************************************************************************************************
+ *    Function      : roughtime_build_srep
+ *    Description   : Encodes the signed part of a response
+ *    Input         : uint8_t* out, uint32_t radius, uint64_t midpoint, const uint8_t* root
+ *    Output        : uint16_t ( ROUGHTIME_SREP_LEN )
+ *    Remarks       : radius and midpoint in microseconds, the midpoint since the UNIX epoch
+ **************************************************************************************************/
+uint16_t roughtime_build_srep( uint8_t* out, uint32_t radius, uint64_t midpoint, const uint8_t* root );
+
+/**************************************************************************************************
+ *    Function      : roughtime_build_dele
+ *    Description   : Encodes the delegation of the online key
+ *    Input         : uint8_t* out, const uint8_t* pubkey, uint64_t mint, uint64_t maxt
+ *    Output        : uint16_t ( ROUGHTIME_DELE_LEN )
+ *    Remarks       : The online key may only sign midpoints between mint and maxt
+ **************************************************************************************************/
+uint16_t roughtime_build_dele( uint8_t* out, const uint8_t* pubkey, uint64_t mint, uint64_t maxt );
+
+/**************************************************************************************************
+ *    Function      : roughtime_public_key
+ *    Description   : Derives the public long term key from its seed
+ *    Input         : const uint8_t* seed, uint8_t* pubkey
+ *    Output        : none
+ *    Remarks       : pubkey needs room for ROUGHTIME_PUBKEY_LEN bytes
+ **************************************************************************************************/
+void roughtime_public_key( const uint8_t* seed, uint8_t* pubkey );
+
+/**************************************************************************************************
+ *    Function      : roughtime_delegate
+ *    Description   : Creates a new online key and signs its delegation with the long term key
+ *    Input         : roughtime_online_key_t* key, const uint8_t* seed, uint64_t now
+ *    Output        : none
+ *    Remarks       : now in microseconds since the UNIX epoch, the delegation covers
+ *                    ROUGHTIME_DELE_BEFORE before it to ROUGHTIME_DELE_AFTER after it
+ **************************************************************************************************/
+void roughtime_delegate( roughtime_online_key_t* key, const uint8_t* seed, uint64_t now );
+
+/**************************************************************************************************
+ *    Function      : roughtime_delegation_due
+ *    Description   : Checks if an online key needs to be replaced before it signs at now
+ *    Input         : const roughtime_online_key_t* key, uint64_t now
+ *    Output        : bool
+ *    Remarks       : True if now is outside the delegation or less than ROUGHTIME_DELE_RENEW is left
+ **************************************************************************************************/
+bool roughtime_delegation_due( const roughtime_online_key_t* key, uint64_t now );
+
+/**************************************************************************************************
+ *    Function      : roughtime_sign_srep
+ *    Description   : Encodes the signed part of a response and signs it with the online key
+ *    Input         : const roughtime_online_key_t* key, uint8_t* srep, uint8_t* sig,
+ *                    uint32_t radius, uint64_t midpoint, const uint8_t* root
+ *    Output        : none
+ *    Remarks       : srep needs room for ROUGHTIME_SREP_LEN bytes, see roughtime_build_srep
+ **************************************************************************************************/
+void roughtime_sign_srep( const roughtime_online_key_t* key, uint8_t* srep, uint8_t* sig, uint32_t radius, uint64_t midpoint, const uint8_t* root );
+
+/**************************************************************************************************
+ *    Function      : roughtime_build_cert
+ *    Description   : Encodes the delegation with its signature by the long term key
+ *    Input         : uint8_t* out, const uint8_t* sig, const uint8_t* dele
+ *    Output        : uint16_t ( ROUGHTIME_CERT_LEN )
+ *    Remarks       : none
+ **************************************************************************************************/
+uint16_t roughtime_build_cert( uint8_t* out, const uint8_t* sig, const uint8_t* dele );
+
+/**************************************************************************************************
+ *    Function      : roughtime_build_response
+ *    Description   : Encodes the response to one request of a batch
+ *    Input         : uint8_t* out, const uint8_t* sig, const uint8_t* path, uint8_t depth,
+ *                    const uint8_t* srep, const uint8_t* cert, uint32_t index
+ *    Output        : uint16_t ( length of the response )
+ *    Remarks       : out needs room for ROUGHTIME_RESPONSE_MAX_LEN bytes
+ **************************************************************************************************/
+uint16_t roughtime_build_response( uint8_t* out, const uint8_t* sig, const uint8_t* path, uint8_t depth, const uint8_t* srep, const uint8_t* cert, uint32_t index );
+
+#endif
@@ -0,0 +1,276 @@
+#include "Arduino.h"
+#include "sodium.h"
+#include "roughtime_server.h"
+
+/* A request waiting for its batch */
+typedef struct {
+  uint8_t nonce[ROUGHTIME_NONCE_LEN];
+  uint32_t addr;
+  uint16_t port;
+} roughtime_request_t;
+
+/* Where a response of the batch goes */
+typedef struct {
+  uint32_t addr;
+  uint16_t port;
+} roughtime_client_t;
+
+ntp_timestamp_t(*rt_read_time)(void) = NULL;
+roughtime_stats_t rt_stats;
+roughtime_settings_t rt_conf;
+
+/* Public half of the long term key, set with the config */
+uint8_t rt_pubkey[ROUGHTIME_PUBKEY_LEN];
+
+/* The long term key has changed, the signing task delegates a new online key */
+volatile bool rt_redelegate = true;
+
+/* Radius in microseconds, taken from the root dispersion */
+volatile bool rt_synced = false;
+volatile uint32_t rt_radius = 1000000;
+
+AsyncUDP rt_udp;
+QueueHandle_t rt_queue = NULL;
+TaskHandle_t rt_task = NULL;
+
+/* Only used from the signing task */
+roughtime_online_key_t rt_online;
+uint8_t rt_nonces[ROUGHTIME_BATCH_MAX][ROUGHTIME_NONCE_LEN];
+roughtime_client_t rt_clients[ROUGHTIME_BATCH_MAX];
+roughtime_tree_t rt_tree;
+uint8_t rt_resp[ROUGHTIME_RESPONSE_MAX_LEN];
+
+RoughtimeServer::RoughtimeServer( ){
+
+}
+
+RoughtimeServer::~RoughtimeServer( ){
+
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_now
+ *    Description   : Reads the clock for a midpoint
+ *    Input         : none
+ *    Output        : uint64_t ( microseconds since the UNIX epoch )
+ *    Remarks       : none
+ **************************************************************************************************/
+static uint64_t roughtime_now( void ){
+  ntp_timestamp_t now = rt_read_time();
+  return ( (uint64_t)( now.seconds - NTP_TIMESTAMP_DELTA ) * 1000000 ) + ( ( (uint64_t)now.fraction * 1000000 ) >> 32 );
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_respond
+ *    Description   : Signs a batch and sends the responses
+ *    Input         : uint8_t count
+ *    Output        : none
+ *    Remarks       : The midpoint is taken right before the signature. The online key is only
+ *                    delegated for a day, it is replaced here before it runs out or after the
+ *                    long term key has changed
+ **************************************************************************************************/
+static void roughtime_respond( uint8_t count ){
+  uint8_t srep[ROUGHTIME_SREP_LEN];
+  uint8_t sig[ROUGHTIME_SIG_LEN];
+  uint8_t path[ROUGHTIME_TREE_DEPTH_MAX * ROUGHTIME_HASH_LEN];
+
+  const uint8_t* root = roughtime_tree_build(&rt_tree, rt_nonces, count);
+  uint64_t midpoint = roughtime_now();
+  if( (true == rt_redelegate) || (true == roughtime_delegation_due(&rt_online, midpoint)) ){
+    rt_redelegate = false;
+    roughtime_delegate(&rt_online, rt_conf.seed, midpoint);
+    midpoint = roughtime_now();
+  }
+  roughtime_sign_srep(&rt_online, srep, sig, rt_radius, midpoint, root);
+  rt_stats.batches++;
+
+  for(uint8_t i=0;i<count;i++){
+    roughtime_tree_path(&rt_tree, i, path);
+    uint16_t len = roughtime_build_response(rt_resp, sig, path, rt_tree.depth, srep, rt_online.cert, i);
+    if( len == rt_udp.writeTo(rt_resp, len, IPAddress(rt_clients[i].addr), rt_clients[i].port) ){
+      rt_stats.responses++;
+    }
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : roughtime_task_loop
+ *    Description   : Collects the requests of a batch and answers them
+ *    Input         : void* param
+ *    Output        : none
+ *    Remarks       : A batch is closed when it is full or the window has passed since its first request
+ **************************************************************************************************/
+static void roughtime_task_loop( void* param ){
+  roughtime_request_t req;
+  while(1==1){
+    if( pdTRUE != xQueueReceive(rt_queue, &req, portMAX_DELAY) ){
+      continue;
+    }
+    TickType_t start = xTaskGetTickCount();
+    TickType_t window = rt_conf.window / portTICK_PERIOD_MS;
+    uint8_t limit = rt_conf.batch;
+    uint8_t count = 0;
+    while(1==1){
+      memcpy(rt_nonces[count], req.nonce, ROUGHTIME_NONCE_LEN);
+      rt_clients[count].addr = req.addr;
+      rt_clients[count].port = req.port;
+      count++;
+      if(count >= limit){
+        break;
+      }
+      /* Once the window has passed only requests already waiting are taken */
+      TickType_t waited = xTaskGetTickCount() - start;
+      TickType_t timeout = ( waited >= window ) ? 0 : ( window - waited );
+      if( pdTRUE != xQueueReceive(rt_queue, &req, timeout) ){
+        break;
+      }
+    }
+    roughtime_respond(count);
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : GetDefaultConfig
+ *    Class         : RoughtimeServer
+ *    Description   : Returns a disabled config with a random long term key
+ *    Input         : none
+ *    Output        : roughtime_settings_t
+ *    Remarks       : none
+ **************************************************************************************************/
+roughtime_settings_t RoughtimeServer::GetDefaultConfig( void ){
+  roughtime_settings_t conf;
+  memset(&conf, 0, sizeof(conf));
+  NewKey(&conf);
+  conf.window = 10;
+  conf.batch = 16;
+  conf.enabled = false;
+  return conf;
+}
+
+/**************************************************************************************************
+ *    Function      : NewKey
+ *    Class         : RoughtimeServer
+ *    Description   : Creates a new random long term key
+ *    Input         : roughtime_settings_t* conf
+ *    Output        : none
+ *    Remarks       : Clients need the new public key afterwards
+ **************************************************************************************************/
+void RoughtimeServer::NewKey( roughtime_settings_t* conf ){
+  for(uint8_t i=0;i<ROUGHTIME_SEED_LEN;i+=4){
+    uint32_t r = esp_random();
+    memcpy(&conf->seed[i], &r, sizeof(r));
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : SetConfig
+ *    Class         : RoughtimeServer
+ *    Description   : Sets the batching and the long term key
+ *    Input         : const roughtime_settings_t* conf
+ *    Output        : none
+ *    Remarks       : A new online key is delegated with the next batch if the long term key has changed
+ **************************************************************************************************/
+void RoughtimeServer::SetConfig( const roughtime_settings_t* conf ){
+  bool changed = ( 0 != memcmp(rt_conf.seed, conf->seed, ROUGHTIME_SEED_LEN) );
+  roughtime_public_key(conf->seed, rt_pubkey);
+  roughtime_settings_t next = *conf;
+  if(next.window > ROUGHTIME_WINDOW_MAX){
+    next.window = ROUGHTIME_WINDOW_MAX;
+  }
+  if(next.batch == 0){
+    next.batch = 1;
+  } else if(next.batch > ROUGHTIME_BATCH_MAX){
+    next.batch = ROUGHTIME_BATCH_MAX;
+  }
+  rt_conf = next;
+  if(true == changed){
+    rt_redelegate = true;
+  }
+}
+
+/**************************************************************************************************
+ *    Function      : UpdateServerState
+ *    Class         : RoughtimeServer
+ *    Description   : Takes the sync state and the radius from the NTP server state
+ *    Input         : ntp_server_state_t state
+ *    Output        : none
+ *    Remarks       : Requests are not answered while the clock is unsynchronized
+ **************************************************************************************************/
+void RoughtimeServer::UpdateServerState( ntp_server_state_t state ){
+  /* Root dispersion is 16.16 seconds */
+  uint32_t radius = (uint32_t)( ( (uint64_t)state.rootDispersion * 1000000 ) >> 16 );
+  rt_radius = ( radius == 0 ) ? 1 : radius;
+  rt_synced = ( state.leap != 3 );
+}
+
+/**************************************************************************************************
+ *    Function      : GetStats
+ *    Class         : RoughtimeServer
+ *    Description   : Returns the request and response counters
+ *    Input         : none
+ *    Output        : roughtime_stats_t
+ *    Remarks       : none
+ **************************************************************************************************/
+roughtime_stats_t RoughtimeServer::GetStats( void ){
+  return rt_stats;
+}
+
+/**************************************************************************************************
+ *    Function      : GetPublicKey
+ *    Class         : RoughtimeServer
+ *    Description   : Copies the public long term key, clients need it to check responses
+ *    Input         : uint8_t* out
+ *    Output        : none
+ *    Remarks       : out needs room for ROUGHTIME_PUBKEY_LEN bytes
+ **************************************************************************************************/
+void RoughtimeServer::GetPublicKey( uint8_t* out ){
+  memcpy(out, rt_pubkey, ROUGHTIME_PUBKEY_LEN);
+}
+
+bool RoughtimeServer::begin( uint16_t port, ntp_timestamp_t(*fnc_get_ntp_time)(void) ){
+  rt_read_time = fnc_get_ntp_time;
+  if( (rt_read_time == NULL) || (sodium_init() < 0) ){
+    return false;
+  }
+  rt_queue = xQueueCreate(ROUGHTIME_QUEUE_LEN, sizeof(roughtime_request_t));
+  if(rt_queue == NULL){
+    return false;
+  }
+  /* Ed25519 needs a bit of stack */
+  xTaskCreatePinnedToCore(
+    roughtime_task_loop,
+    "RT_Task",
+    6144,
+    NULL,
+    ROUGHTIME_TASK_PRIORITY,
+    &rt_task,
+    ROUGHTIME_TASK_CORE);
+  if( false == rt_udp.listen(port) ){
+    return false;
+  }
+  rt_udp.onPacket(RoughtimeServer::processUDPPacket);
+  return true;
+}
+
+/* static function, queues the nonce for the next batch */
+void RoughtimeServer::processUDPPacket( AsyncUDPPacket& packet ){
+  roughtime_request_t req;
+  if(false == rt_conf.enabled){
+    return;
+  }
+  const uint8_t* nonce = roughtime_find_nonce(packet.data(), packet.length());
+  if(nonce == NULL){
+    return;
+  }
+  rt_stats.requests++;
+  if(false == rt_synced){
+    rt_stats.dropped++;
+    return;
+  }
+  memcpy(req.nonce, nonce, ROUGHTIME_NONCE_LEN);
+  req.addr = (uint32_t)packet.remoteIP();
+  req.port = packet.remotePort();
+  if( pdTRUE != xQueueSend(rt_queue, &req, 0) ){
+    rt_stats.dropped++;
+  }
+}
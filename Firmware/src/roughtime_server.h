@@ -0,0 +1,115 @@
+#ifndef ROUGHTIME_SERVER_H_
+ #define ROUGHTIME_SERVER_H_
+
+#include "Arduino.h"
+#include "AsyncUDP.h"
+#include "ntp_packet.h"
+#include "roughtime.h"
+
+/* Core and priority of the signing task, below the NTP responder so it can't delay NTP answers */
+#ifndef ROUGHTIME_TASK_CORE
+ #define ROUGHTIME_TASK_CORE ( 0 )
+#endif
+
+#ifndef ROUGHTIME_TASK_PRIORITY
+ #define ROUGHTIME_TASK_PRIORITY ( 5 )
+#endif
+
+/* Requests waiting for the next batch, more are dropped */
+#ifndef ROUGHTIME_QUEUE_LEN
+ #define ROUGHTIME_QUEUE_LEN ( ROUGHTIME_BATCH_MAX )
+#endif
+
+/* Longest time a request waits for others to share the signature */
+#define ROUGHTIME_WINDOW_MAX ( 1000 )
+
+typedef struct {
+  uint8_t seed[ROUGHTIME_SEED_LEN];   /* Long term key, only its public half leaves the device */
+  uint16_t window;                    /* Milliseconds a batch waits for more requests */
+  uint8_t batch;                      /* Requests signed together at most */
+  bool enabled;
+} roughtime_settings_t;
+
+typedef struct {
+  uint32_t requests;    /* Valid requests received */
+  uint32_t responses;   /* Responses sent */
+  uint32_t batches;     /* Signatures made for responses */
+  uint32_t dropped;     /* Requests dropped as the queue was full or the clock not synchronized */
+} roughtime_stats_t;
+
+/*
+ * Roughtime responder, requests are collected for a short window and
+ * answered together with one signature over the root of a Merkle tree.
+ * Each response carries the path from its nonce to the root.
+ */
+class RoughtimeServer {
+
+public:
+    RoughtimeServer( );
+    ~RoughtimeServer( );
+
+    bool begin( uint16_t port, ntp_timestamp_t(*fnc_get_ntp_time)(void) );
+    static void processUDPPacket( AsyncUDPPacket& packet );
+
+    /**************************************************************************************************
+     *    Function      : SetConfig
+     *    Class         : RoughtimeServer
+     *    Description   : Sets the batching and the long term key
+     *    Input         : const roughtime_settings_t* conf
+     *    Output        : none
+     *    Remarks       : A new online key is delegated if the long term key has changed
+     **************************************************************************************************/
+    void SetConfig( const roughtime_settings_t* conf );
+
+    /**************************************************************************************************
+     *    Function      : UpdateServerState
+     *    Class         : RoughtimeServer
+     *    Description   : Takes the sync state and the radius from the NTP server state
+     *    Input         : ntp_server_state_t state
+     *    Output        : none
+     *    Remarks       : Requests are not answered while the clock is unsynchronized
+     **************************************************************************************************/
+    void UpdateServerState( ntp_server_state_t state );
+
+    /**************************************************************************************************
+     *    Function      : GetStats
+     *    Class         : RoughtimeServer
+     *    Description   : Returns the request and response counters
+     *    Input         : none
+     *    Output        : roughtime_stats_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    roughtime_stats_t GetStats( void );
+
+    /**************************************************************************************************
+     *    Function      : GetPublicKey
+     *    Class         : RoughtimeServer
+     *    Description   : Copies the public long term key, clients need it to check responses
+     *    Input         : uint8_t* out
+     *    Output        : none
+     *    Remarks       : out needs room for ROUGHTIME_PUBKEY_LEN bytes
+     **************************************************************************************************/
+    void GetPublicKey( uint8_t* out );
+
+    /**************************************************************************************************
+     *    Function      : NewKey
+     *    Class         : RoughtimeServer
+     *    Description   : Creates a new random long term key
+     *    Input         : roughtime_settings_t* conf
+     *    Output        : none
+     *    Remarks       : Clients need the new public key afterwards
+     **************************************************************************************************/
+    static void NewKey( roughtime_settings_t* conf );
+
+    /**************************************************************************************************
+     *    Function      : GetDefaultConfig
+     *    Class         : RoughtimeServer
+     *    Description   : Returns a disabled config with a random long term key
+     *    Input         : none
+     *    Output        : roughtime_settings_t
+     *    Remarks       : none
+     **************************************************************************************************/
+    static roughtime_settings_t GetDefaultConfig( void );
+};
+
+#endif
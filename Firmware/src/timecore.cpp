@@ -2,6 +2,17 @@
 #include "timezones.h"
 #include "datastore.h"
 
+/**************************************************************************************************
+ *    Function      : PrintDSTRule
+ *    Description   : Prints the UTC of a DST change
+ *    Input         : const char* name, datum_t d
+ *    Output        : none
+ *    Remarks       : none
+ **************************************************************************************************/
+static void PrintDSTRule( const char* name, datum_t d ){
+  Serial.printf("%s%04u-%02u-%02u %02u:%02u\n\r", name, d.year, d.month, d.day, d.hour, d.minute);
+}
+
 /**************************************************************************************************
  *    Function      : Constructor
  *    Class         : Timecore
@@ -39,16 +50,45 @@ void Timecore::SaveConfig(){
    write_timecoreconf(local_config);
 }
 
+/**************************************************************************************************
+*    Function      : GetUTCSeconds
+*    Class         : Timecore
+*    Description   : Gets the UTC Time
+*    Input         : none
+*    Output        : uint64_t ( seconds since 1.1.1900 across NTP eras )
+*    Remarks       : none
+**************************************************************************************************/
+uint64_t Timecore::GetUTCSeconds( void ){
+    uint64_t now;
+    portENTER_CRITICAL(&TimebaseMux);
+    /* While smearing the counter is still on the UTC from before the leap */
+    now = Leap.ToUTC(local_softrtc_timestamp);
+    portEXIT_CRITICAL(&TimebaseMux);
+    return now ;
+}
+
 /**************************************************************************************************
 *    Function      : GetUTC
 *    Class         : Timecore
 *    Description   : Gets the UTC Time
 *    Input         : none
-*    Output        : uint32_t ( seconds since 1.1.1970)
-*    Remarks       : This is a unix timestamp
+*    Output        : ntp_time64_t ( on the second )
+*    Remarks       : Use GetNTPTimestamp for the fraction
 **************************************************************************************************/
-uint32_t Timecore::GetUTC( void ){
-    return local_softrtc_timestamp ;
+ntp_time64_t Timecore::GetUTC( void ){
+    return (ntp_time64_t)GetUTCSeconds() << 32;
+}
+
+/**************************************************************************************************
+*    Function      : GetUnixTime
+*    Class         : Timecore
+*    Description   : Gets the UTC Time
+*    Input         : none
+*    Output        : int64_t ( seconds since 1.1.1970 )
+*    Remarks       : This is a unix timestamp, it does not wrap in 2038 or 2106
+**************************************************************************************************/
+int64_t Timecore::GetUnixTime( void ){
+    return (int64_t)GetUTCSeconds() - (int64_t)NTP_TIMESTAMP_DELTA;
 }
 
 
@@ -60,18 +100,22 @@ uint32_t Timecore::GetUTC( void ){
 *    Output        : datum_t
 *    Remarks       : Will convert the timestamp to a stuct with hours, minutes, seconds ......
 **************************************************************************************************/    
-datum_t Timecore::ConvertToDatum( uint32_t timestamp ){
+datum_t Timecore::ConvertToDatum( int64_t timestamp ){
  datum_t d;  
- tmElements_t time_element;
- breakTime(timestamp,time_element);
-
- d.year   = time_element.Year+1970;
- d.month  = time_element.Month;
- d.day    = time_element.Day;
- d.dow    = time_element.Wday;
- d.hour   = time_element.Hour;
- d.minute = time_element.Minute;
- d.second = time_element.Second;
+ int32_t year;
+ int64_t days = timestamp / (int64_t)SECS_PER_DAY;
+ int64_t seconds = timestamp % (int64_t)SECS_PER_DAY;
+ if(seconds < 0){
+   seconds += SECS_PER_DAY;
+   days--;
+ }
+ ntp_civil_from_days(days, &year, &d.month, &d.day);
+
+ d.year   = (uint16_t)year;
+ d.dow    = ntp_weekday_from_days(days) + 1; /* Sunday is 1 as with TimeLib */
+ d.hour   = (uint8_t)( seconds / SECS_PER_HOUR );
+ d.minute = (uint8_t)( ( seconds % SECS_PER_HOUR ) / SECS_PER_MIN );
+ d.second = (uint8_t)( seconds % SECS_PER_MIN );
   
  return d;
 }
@@ -127,27 +171,52 @@ timecoreconf_t Timecore::GetDefaultConfig( void) {
 *    Function      : SetUTC
 *    Class         : Timecore
 *    Description   : Sets the UTC Time
-*    Input         : uint32_t time, source_t source
+*    Input         : ntp_time64_t time, source_t source
+*    Output        : none
+*    Remarks       : Only sets the UTC Time if the source is equal or better than the last one.
+*                    The fraction is dropped, the era is the one closest to the current time
+**************************************************************************************************/
+void Timecore::SetUTC( ntp_time64_t time, source_t source ){
+    /* Before the first set there is no time to compare with, the pivot covers 1971 to 2108 */
+    int64_t pivot = ( true == Synced ) ? GetUnixTime() : NTP_TIME64_PIVOT;
+    SetUTCSeconds( (uint64_t)( ntp_time64_to_unix(time, pivot) + (int64_t)NTP_TIMESTAMP_DELTA ), source );
+}
+
+/**************************************************************************************************
+*    Function      : SetUTCSeconds
+*    Class         : Timecore
+*    Description   : Sets the UTC Time
+*    Input         : uint64_t time ( seconds since 1.1.1900 across NTP eras ), source_t source
 *    Output        : none
 *    Remarks       : Only sets the UTC Time if the source is equal or better than the last one
 **************************************************************************************************/
-void Timecore::SetUTC( uint32_t time, source_t source ){
+void Timecore::SetUTCSeconds( uint64_t time, source_t source ){
+    uint64_t counter;
+    portENTER_CRITICAL(&TimebaseMux);
+    bool settled = Leap.FromUTC(time, &counter);
+    portEXIT_CRITICAL(&TimebaseMux);
+    if(false == settled){
+      /* Around the leap itself the sources don't agree on what the second is, we keep our own count */
+      return;
+    }
     if(  source >= CurrentMasterSource ){
       /* exept for user */
       if(source != USER_DEFINED){
         CurrentMasterSource = source;
       }
       /* The priority is higher or equal we sync now */
-      noInterrupts();
-      local_softrtc_timestamp = time;
-      interrupts();
+      portENTER_CRITICAL(&TimebaseMux);
+      local_softrtc_timestamp = counter;
+      LastSet = counter;
+      Synced = true;
+      portEXIT_CRITICAL(&TimebaseMux);
       for(uint32_t i=0;i<  RTC_SRC_CNT  ;i++){
         if( (TimeSources[i].type!=NO_RTC) && (TimeSources[i].type<source) ){
-          TimeSources[i].WriteTime(time);
+          TimeSources[i].WriteTime( (ntp_time64_t)time << 32 );
         }
       }   
     } else {
-      Serial.printf("TS: %i from %i, lower prio as %i",time,source,CurrentMasterSource);
+      Serial.printf("TS: %u from %i, lower prio as %i",(uint32_t)time,source,CurrentMasterSource);
     }
 }
 
@@ -160,10 +229,9 @@ void Timecore::SetUTC( uint32_t time, source_t source ){
 *    Remarks       : Only sets the UTC Time if the source is equal or better than the last one
 **************************************************************************************************/
 void Timecore::SetUTC( datum_t time, source_t source  ){
-    /*This is tricky as we now need to buld a utc timestamp */
-    uint32_t timestamp =0;
-    timestamp = TimeStructToTimeStamp( time );
-    SetUTC(timestamp,source );
+    /* The date carries the full year, so there is no era to guess */
+    int64_t timestamp = TimeStructToTimeStamp( time );
+    SetUTCSeconds( (uint64_t)( timestamp + (int64_t)NTP_TIMESTAMP_DELTA ), source );
     
 }
 
@@ -194,8 +262,74 @@ void Timecore::RegisterTimeSource(rtc_source_t source)  {
 *    Output        : none
 *    Remarks       : Keeps internal time counter running
 **************************************************************************************************/  
-void Timecore::RTC_Tick( void ){ /* Needs to be called once a second */
-    local_softrtc_timestamp++;
+void IRAM_ATTR Timecore::RTC_Tick( void ){ /* Needs to be called once a second */
+    Tick(false);
+}    
+
+/**************************************************************************************************
+*    Function      : PPS_Tick
+*    Class         : Timecore
+*    Description   : Needs to be called on every PPS edge instead of RTC_Tick
+*    Input         : none
+*    Output        : none
+*    Remarks       : Also disciplines the timebase to the edges
+**************************************************************************************************/  
+void IRAM_ATTR Timecore::PPS_Tick( void ){
+    Tick(true);
+}
+
+/**************************************************************************************************
+*    Function      : NextSecond
+*    Class         : Timecore
+*    Description   : Advances the time by one second
+*    Input         : none
+*    Output        : none
+*    Remarks       : Needs TimebaseMux held
+**************************************************************************************************/ 
+void IRAM_ATTR Timecore::NextSecond( void ){
+    /* A leap second repeats or skips the last second of the day */
+    local_softrtc_timestamp = Leap.Next(local_softrtc_timestamp);
+}
+
+/**************************************************************************************************
+*    Function      : Tick
+*    Class         : Timecore
+*    Description   : Advances the time by the seconds passed and latches the timebase
+*    Input         : bool pps_edge
+*    Output        : none
+*    Remarks       : PPS edges go to the servo, without them it predicts the boundaries from the
+*                    held frequency and the caller only tells when to look
+**************************************************************************************************/ 
+void IRAM_ATTR Timecore::Tick( bool pps_edge ){
+    uint8_t seconds = 1;
+    portENTER_CRITICAL_ISR(&TimebaseMux);
+    if(ReadTimebase!=NULL){
+      uint64_t latch = ReadTimebase();
+      if(true == pps_edge){
+        /* The second starts at the disciplined boundary, not at the interrupt latency of this edge */
+        seconds = Servo.Edge(latch);
+        TimebaseLatch = Servo.GetPhase();
+        Holdover.Edge();
+      } else {
+        seconds = Servo.Hold(latch);
+        if(Servo.GetState() == NTP_SERVO_HOLD){
+          TimebaseLatch = Servo.GetPhase();
+          for(uint8_t i=0;i<seconds;i++){
+            Holdover.Second();
+          }
+        } else {
+          TimebaseLatch = latch;
+        }
+      }
+      TimebaseLatchFromPPS = pps_edge;
+    }
+    for(uint8_t i=0;i<seconds;i++){
+      NextSecond();
+    }
+    if(true == pps_edge){
+      LastPPS = local_softrtc_timestamp;
+    }
+    portEXIT_CRITICAL_ISR(&TimebaseMux);
     if(DegradeTimer_Src>0){
      DegradeTimer_Src--;
      
@@ -209,6 +343,323 @@ void Timecore::RTC_Tick( void ){ /* Needs to be called once a second */
 
 
 
+/**************************************************************************************************
+*    Function      : SetTimebase
+*    Class         : Timecore
+*    Description   : Registers a free running hardware timer used for the sub seconds
+*    Input         : uint64_t (*ReadTimer)(void), uint32_t ticks_per_second
+*    Output        : none
+*    Remarks       : ReadTimer is called from RTC_Tick and needs to be placed in RAM
+**************************************************************************************************/
+void Timecore::SetTimebase( uint64_t (*ReadTimer)(void), uint32_t ticks_per_second ){
+    portENTER_CRITICAL(&TimebaseMux);
+    ReadTimebase = ReadTimer;
+    TimebaseFrequency = ticks_per_second;
+    Servo.Begin(ticks_per_second, &ServoConfig);
+    TimebaseLatchFromPPS = false;
+    if(ReadTimebase!=NULL){
+      TimebaseLatch = ReadTimebase();
+    }
+    portEXIT_CRITICAL(&TimebaseMux);
+}
+
+/**************************************************************************************************
+*    Function      : GetPPSOffset
+*    Class         : Timecore
+*    Description   : Gets the time error seen at the last PPS edge
+*    Input         : none
+*    Output        : int32_t ( nanoseconds )
+*    Remarks       : Positive if the clock was running slow
+**************************************************************************************************/
+int32_t Timecore::GetPPSOffset( void ){
+    return GetServoStatus().offset;
+}
+
+/**************************************************************************************************
+*    Function      : GetPPSJitter
+*    Class         : Timecore
+*    Description   : Gets the average deviation of the PPS edges
+*    Input         : none
+*    Output        : uint32_t ( nanoseconds )
+*    Remarks       : none
+**************************************************************************************************/
+uint32_t Timecore::GetPPSJitter( void ){
+    return GetServoStatus().jitter;
+}
+
+/**************************************************************************************************
+*    Function      : SetServoConfig
+*    Class         : Timecore
+*    Description   : Sets the learned timebase frequency the servo starts with
+*    Input         : ntp_servo_settings_t conf
+*    Output        : none
+*    Remarks       : Needs to be called before SetTimebase
+**************************************************************************************************/
+void Timecore::SetServoConfig( ntp_servo_settings_t conf ){
+    portENTER_CRITICAL(&TimebaseMux);
+    ServoConfig = conf;
+    portEXIT_CRITICAL(&TimebaseMux);
+}
+
+/**************************************************************************************************
+*    Function      : TakeServoSettings
+*    Class         : Timecore
+*    Description   : Hands out the learned timebase frequency for storage
+*    Input         : ntp_servo_settings_t* out
+*    Output        : bool
+*    Remarks       : true if it changed enough to be stored again
+**************************************************************************************************/
+bool Timecore::TakeServoSettings( ntp_servo_settings_t* out ){
+    bool taken;
+    portENTER_CRITICAL(&TimebaseMux);
+    taken = Servo.TakeSettings(out);
+    if(true == taken){
+      ServoConfig = *out;
+    }
+    portEXIT_CRITICAL(&TimebaseMux);
+    return taken;
+}
+
+/**************************************************************************************************
+*    Function      : GetServoStatus
+*    Class         : Timecore
+*    Description   : Gets the state of the timebase servo
+*    Input         : none
+*    Output        : ntp_servo_status_t
+*    Remarks       : none
+**************************************************************************************************/
+ntp_servo_status_t Timecore::GetServoStatus( void ){
+    ntp_servo_status_t status;
+    portENTER_CRITICAL(&TimebaseMux);
+    status = Servo.GetStatus();
+    portEXIT_CRITICAL(&TimebaseMux);
+    return status;
+}
+
+/**************************************************************************************************
+*    Function      : SetHoldoverConfig
+*    Class         : Timecore
+*    Description   : Sets the learned frequency over temperature curve
+*    Input         : ntp_holdover_settings_t conf
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void Timecore::SetHoldoverConfig( ntp_holdover_settings_t conf ){
+    portENTER_CRITICAL(&TimebaseMux);
+    Holdover.Begin(&conf);
+    portEXIT_CRITICAL(&TimebaseMux);
+}
+
+/**************************************************************************************************
+*    Function      : TakeHoldoverSettings
+*    Class         : Timecore
+*    Description   : Hands out the learned frequency over temperature curve for storage
+*    Input         : ntp_holdover_settings_t* out
+*    Output        : bool
+*    Remarks       : true if it changed enough to be stored again
+**************************************************************************************************/
+bool Timecore::TakeHoldoverSettings( ntp_holdover_settings_t* out ){
+    bool taken;
+    portENTER_CRITICAL(&TimebaseMux);
+    taken = Holdover.TakeSettings(out);
+    portEXIT_CRITICAL(&TimebaseMux);
+    return taken;
+}
+
+/**************************************************************************************************
+*    Function      : SampleTemperature
+*    Class         : Timecore
+*    Description   : Learns the frequency at a temperature while locked and predicts it in holdover
+*    Input         : bool valid, int16_t temperature ( 1/4 °C )
+*    Output        : none
+*    Remarks       : Call every NTP_HOLDOVER_SAMPLE_INTERVAL, valid is false without a sensor
+**************************************************************************************************/
+void Timecore::SampleTemperature( bool valid, int16_t temperature ){
+    portENTER_CRITICAL(&TimebaseMux);
+    ntp_servo_status_t status = Servo.GetStatus();
+    if(status.state == NTP_SERVO_LOCK){
+      /* The phase jitter spread over the time constant is what the frequency is known to */
+      Holdover.SetReference(valid, temperature, status.frequency, status.jitter >> status.tau);
+      if( (true == valid) && (status.tau >= TIMECORE_HOLDOVER_LEARN_TAU) ){
+        Holdover.Learn(temperature, status.frequency);
+      }
+    }
+    Holdover.Predict(valid, temperature);
+    if( (status.state == NTP_SERVO_HOLD) && (true == Holdover.GetStatus().referenced) ){
+      Servo.SetHoldFrequency(Holdover.GetFrequency());
+    }
+    portEXIT_CRITICAL(&TimebaseMux);
+}
+
+/**************************************************************************************************
+*    Function      : GetHoldoverStatus
+*    Class         : Timecore
+*    Description   : Gets the state of the holdover prediction
+*    Input         : none
+*    Output        : ntp_holdover_status_t
+*    Remarks       : none
+**************************************************************************************************/
+ntp_holdover_status_t Timecore::GetHoldoverStatus( void ){
+    ntp_holdover_status_t status;
+    portENTER_CRITICAL(&TimebaseMux);
+    status = Holdover.GetStatus();
+    portEXIT_CRITICAL(&TimebaseMux);
+    return status;
+}
+
+/**************************************************************************************************
+*    Function      : GetHoldoverCurve
+*    Class         : Timecore
+*    Description   : Gets the learned frequency over temperature curve
+*    Input         : none
+*    Output        : ntp_holdover_settings_t
+*    Remarks       : none
+**************************************************************************************************/
+ntp_holdover_settings_t Timecore::GetHoldoverCurve( void ){
+    ntp_holdover_settings_t curve;
+    portENTER_CRITICAL(&TimebaseMux);
+    curve = Holdover.GetCurve();
+    portEXIT_CRITICAL(&TimebaseMux);
+    return curve;
+}
+
+/**************************************************************************************************
+*    Function      : SetLeap
+*    Class         : Timecore
+*    Description   : Announces a leap second
+*    Input         : leap_settings_t conf
+*    Output        : none
+*    Remarks       : An announcement for a time that is not midnight is ignored
+**************************************************************************************************/
+void Timecore::SetLeap( leap_settings_t conf ){
+    portENTER_CRITICAL(&TimebaseMux);
+    Leap.SetConfig(conf);
+    portEXIT_CRITICAL(&TimebaseMux);
+}
+
+/**************************************************************************************************
+*    Function      : GetLeap
+*    Class         : Timecore
+*    Description   : Gets the leap second announcement
+*    Input         : none
+*    Output        : leap_settings_t
+*    Remarks       : none
+**************************************************************************************************/
+leap_settings_t Timecore::GetLeap( void ){
+    leap_settings_t conf;
+    portENTER_CRITICAL(&TimebaseMux);
+    conf = Leap.GetConfig();
+    portEXIT_CRITICAL(&TimebaseMux);
+    return conf;
+}
+
+/**************************************************************************************************
+*    Function      : GetDefaultLeap
+*    Class         : Timecore
+*    Description   : Gets an empty leap second announcement
+*    Input         : none
+*    Output        : leap_settings_t
+*    Remarks       : none
+**************************************************************************************************/
+leap_settings_t Timecore::GetDefaultLeap( void ){
+    return NTP_LeapSecond::GetDefaultConfig();
+}
+
+/**************************************************************************************************
+*    Function      : GetLeapIndicator
+*    Class         : Timecore
+*    Description   : Gets the NTP leap indicator for the current time
+*    Input         : none
+*    Output        : uint8_t ( 0 none, 1 insert, 2 delete )
+*    Remarks       : Set on the day of the leap only, never while smearing
+**************************************************************************************************/
+uint8_t Timecore::GetLeapIndicator( void ){
+    uint8_t indicator;
+    portENTER_CRITICAL(&TimebaseMux);
+    indicator = Leap.GetIndicator(local_softrtc_timestamp);
+    portEXIT_CRITICAL(&TimebaseMux);
+    return indicator;
+}
+
+/**************************************************************************************************
+*    Function      : GetFrequencyError
+*    Class         : Timecore
+*    Description   : Gets the estimated frequency error of the clock without PPS
+*    Input         : none
+*    Output        : uint32_t ( parts per billion )
+*    Remarks       : Offset of the measured timebase from nominal plus its jitter
+**************************************************************************************************/
+uint32_t Timecore::GetFrequencyError( void ){
+    uint32_t error;
+    portENTER_CRITICAL(&TimebaseMux);
+    ntp_servo_state_t state = Servo.GetState();
+    error = Holdover.GetUncertainty();
+    portEXIT_CRITICAL(&TimebaseMux);
+    if( (state == NTP_SERVO_UNSET) || (state == NTP_SERVO_FREQ) ){
+      return TIMECORE_FREQ_ERROR_DEFAULT;
+    }
+    /* The boundaries are predicted from the held frequency, only its error adds up */
+    return error;
+}
+
+/**************************************************************************************************
+*    Function      : GetSyncState
+*    Class         : Timecore
+*    Description   : Gets the source and the times the clock was last disciplined
+*    Input         : none
+*    Output        : timecore_sync_t
+*    Remarks       : none
+**************************************************************************************************/
+timecore_sync_t Timecore::GetSyncState( void ){
+    timecore_sync_t state;
+    state.source = CurrentMasterSource;
+    portENTER_CRITICAL(&TimebaseMux);
+    state.synced = Synced;
+    state.pps = TimebaseLatchFromPPS;
+    state.now = (ntp_time64_t)local_softrtc_timestamp << 32;
+    state.last_set = (ntp_time64_t)LastSet << 32;
+    state.last_pps = ( LastPPS != 0 ) ? ( (ntp_time64_t)LastPPS << 32 ) : 0;
+    state.holdover = ( Servo.GetState() == NTP_SERVO_HOLD );
+    state.holdover_error = Holdover.GetError();
+    portEXIT_CRITICAL(&TimebaseMux);
+    return state;
+}
+
+/**************************************************************************************************
+*    Function      : GetNTPTimestamp
+*    Class         : Timecore
+*    Description   : Gets the UTC Time as NTP timestamp with full fraction
+*    Input         : none
+*    Output        : ntp_timestamp_t
+*    Remarks       : The fraction is interpolated from the timer latched by the last RTC_Tick
+**************************************************************************************************/
+ntp_timestamp_t Timecore::GetNTPTimestamp( void ){
+    ntp_time64_t ts;
+    uint64_t seconds;
+    uint32_t fraction;
+    uint64_t elapsed = 0;
+    uint32_t frequency;
+
+    portENTER_CRITICAL(&TimebaseMux);
+    seconds = local_softrtc_timestamp;
+    frequency = Servo.GetFrequency();
+    ntp_servo_state_t servo_state = Servo.GetState();
+    bool disciplined = (servo_state == NTP_SERVO_LOCK) || (servo_state == NTP_SERVO_SPIKE) || (servo_state == NTP_SERVO_HOLD);
+    NTP_LeapSecond leap = Leap;
+    if(ReadTimebase!=NULL){
+      elapsed = ReadTimebase() - TimebaseLatch;
+    }
+    portEXIT_CRITICAL(&TimebaseMux);
+
+    /* The disciplined boundary may lie a few ticks after the edge that started the second. Once
+       disciplined the boundaries are known without the next tick, it is only late to look, else an
+       overdue tick holds the time at the end of the second */
+    fraction = ntp_interpolate_fraction(&seconds, elapsed, frequency, disciplined);
+    /* The era is dropped here, the seconds wrap in 2036 as they do on the wire */
+    ts = leap.Smear(seconds, fraction);
+    return ntp_time64_to_timestamp(ts);
+}
+
 /**************************************************************************************************
 *    Function      : SetDLS_Offset
 *    Class         : Timecore
@@ -332,7 +783,7 @@ void Timecore::SetManualDLSEna( bool ena){
 **************************************************************************************************/ 
 bool Timecore::GetDLSstatus( void ){
    bool result=false;
-  uint32_t now = GetUTC();
+  int64_t now = GetUnixTime();
    if(local_config.AutomaticDLTS_Ena==true){
      bool northTZ = (dstEnd>dstStart)?1:0; // Northern or Southern hemisphere TZ?
      if( (northTZ && ( (now >= dstStart) && ( now < dstEnd) ) ) ||( !northTZ && ( (now < dstEnd ) || ( now >= dstStart) ) ) ) {
@@ -383,13 +834,11 @@ void Timecore::SetTimeZone(TIMEZONES_NAMES_t Zone ) {
 **************************************************************************************************/  
 void Timecore::SetLocalTime( datum_t d){
 
-  if(d.year>=2000){
-    d.year-=2000;
-  }
-  uint32_t localtimestamp = TimeStructToTimeStamp( d );
+  int64_t localtimestamp = TimeStructToTimeStamp( d );
+  uint16_t year = calcYear( localtimestamp );
   bool northTZ = (dstEnd>dstStart)?1:0; // Northern or Southern hemisphere TZ?
   /* we need to fix the offset */
- Serial.printf("TS:%i \n\r",localtimestamp);
+ Serial.printf("TS:%u \n\r",(uint32_t)localtimestamp);
  if(local_config.TimeZoneOverride==true){
    localtimestamp = localtimestamp-(local_config.GMTOffset*60);
  } else {
@@ -397,18 +846,16 @@ void Timecore::SetLocalTime( datum_t d){
   /* next is to check if we may have dlst */
  }
  
-  if(dstYear!=d.year+30)
+  if(dstYear!=year)
      {
-      Serial.printf("Year: %i", d.year);
-      dstYear=d.year+30;
+      Serial.printf("Year: %i", year);
+      dstYear=year;
       dstStart = calcTime(&TimeZoneRam.StartRule);
       dstEnd = calcTime(&TimeZoneRam.EndRule);
    
       Serial.println("\nDST Rules Updated:");
-      Serial.print("DST Start: ");
-      Serial.print(ctime(&dstStart));
-      Serial.print("DST End:   ");
-      Serial.println(ctime(&dstEnd));
+      PrintDSTRule("DST Start: ", ConvertToDatum(dstStart));
+      PrintDSTRule("DST End:   ", ConvertToDatum(dstEnd));
   }
 
   if(local_config.AutomaticDLTS_Ena==true){
@@ -450,8 +897,8 @@ void Timecore::SetLocalTime( datum_t d){
     }
     }
   }
-  Serial.printf("TS_UTC:%i \n\r",localtimestamp);
-  SetUTC(localtimestamp, USER_DEFINED);
+  Serial.printf("TS_UTC:%u \n\r",(uint32_t)localtimestamp);
+  SetUTCSeconds( (uint64_t)( localtimestamp + (int64_t)NTP_TIMESTAMP_DELTA ), USER_DEFINED );
  
 }
 
@@ -464,7 +911,7 @@ void Timecore::SetLocalTime( datum_t d){
 *    Remarks       : Returns the local time according to the settings
 **************************************************************************************************/
 datum_t Timecore::GetLocalTimeDate( void ){
-  uint32_t t = GetLocalTime();
+  int64_t t = GetLocalTime();
   return ConvertToDatum(t);
 }
 
@@ -473,13 +920,13 @@ datum_t Timecore::GetLocalTimeDate( void ){
      *    Class         : Timecore
      *    Description   : Gets the UTC Time
      *    Input         : none
-     *    Output        : time_t
+     *    Output        : int64_t
      *    Remarks       : Returns the local time according to the settings
      **************************************************************************************************/
-time_t Timecore::GetLocalTime( void )
+int64_t Timecore::GetLocalTime( void )
 {
  bool northTZ = (dstEnd>dstStart)?1:0; // Northern or Southern hemisphere TZ?
- time_t now = GetUTC();  // Call the original time() function
+ int64_t now = GetUnixTime();
 
   if(local_config.TimeZoneOverride==false){
     if(now>TimeZoneRam.Offset){
@@ -530,7 +977,7 @@ time_t Timecore::GetLocalTime( void )
     /* we are done here */  
    } else {
      
-   uint8_t year = calcYear(now);
+   uint16_t year = calcYear(now);
   
   
    // Init DST variables if necessary
@@ -541,10 +988,8 @@ time_t Timecore::GetLocalTime( void )
       dstEnd = calcTime(&TimeZoneRam.EndRule);
        
       Serial.println("\nDST Rules Updated:");
-      Serial.print("DST Start: ");
-      Serial.print(ctime(&dstStart));
-      Serial.print("DST End:   ");
-      Serial.println(ctime(&dstEnd));
+      PrintDSTRule("DST Start: ", ConvertToDatum(dstStart));
+      PrintDSTRule("DST End:   ", ConvertToDatum(dstEnd));
       northTZ = (dstEnd>dstStart)?1:0; // Northern or Southern hemisphere TZ?
   }
    
@@ -572,22 +1017,21 @@ time_t Timecore::GetLocalTime( void )
 *    Function      : calcYear
 *    Class         : Timecore
 *    Description   : Helperfunction to calculate the year
-*    Input         : time_t
-*    Output        : uint8_t
+*    Input         : int64_t
+*    Output        : uint16_t
 *    Remarks       : none
 **************************************************************************************************/ 
-uint8_t Timecore::calcYear(time_t time)
+uint16_t Timecore::calcYear(int64_t time)
 {
- uint8_t year=0;
- unsigned long days=0;
- 
-  time /= SECS_PER_DAY; // now it is days
-
-  while((unsigned)(days += (LEAP_YEAR(year) ? 366 : 365)) <= time) {
-    year++;
-  }
-  
-  return(year);
+ int32_t year;
+ uint8_t month;
+ uint8_t day;
+ int64_t days = time / (int64_t)SECS_PER_DAY; // now it is days
+ if( (time % (int64_t)SECS_PER_DAY) < 0 ){
+   days--;
+ }
+ ntp_civil_from_days(days, &year, &month, &day);
+ return (uint16_t)year;
 }
 
 
@@ -596,13 +1040,13 @@ uint8_t Timecore::calcYear(time_t time)
 *    Class         : Timecore
 *    Description   : Helperfunction to calculate the DLST-Rule for the current year
 *    Input         : struct dstRule * tr
-*    Output        : time_t
+*    Output        : int64_t
 *    Remarks       : none
 **************************************************************************************************/   
-time_t Timecore::calcTime(struct dstRule * tr)
+int64_t Timecore::calcTime(struct dstRule * tr)
 {
- struct tm tm2;
- time_t t;
+ int64_t days;
+ int32_t year = dstYear;
  uint8_t m, w;            //temp copies
  
     m = tr->month;
@@ -610,83 +1054,46 @@ time_t Timecore::calcTime(struct dstRule * tr)
     if (w == 0) {            //Last week = 0
         if (++m > 11) {      //for "Last", go to the next month
             m = 0;
-            // yr++;
+            year++;
         }
         w = 1;               //and treat as first week of next month, subtract 7 days later
     }
 
-    tm2.tm_hour = tr->hour;
-    tm2.tm_min = tr->minute;
-    tm2.tm_sec = 0;
-    tm2.tm_mday = 1;
-    tm2.tm_mon = m;
-    tm2.tm_year = dstYear;
+    //first day of the month, or first day of next month for "Last" rules
+    days = ntp_days_from_civil(year, m + 1, 1);
 
-    // t = ::mktime(&tm2);        // mktime() seems to be broken, below is replacement
-    t = my_mktime(&tm2);        //first day of the month, or first day of next month for "Last" rules
-
-    t += (7 * (w - 1) + (tr->dow - weekday(t) + 7) % 7) * SECS_PER_DAY;
-    if (tr->week == 0) t -= 7 * SECS_PER_DAY;    //back up a week if this is a "Last" rule
+    /* Both count the days of the week from 0 for Sunday */
+    days += 7 * (w - 1) + (tr->dow - ntp_weekday_from_days(days) + 7) % 7;
+    if (tr->week == 0) days -= 7;    //back up a week if this is a "Last" rule
     
-    return t;
+    return ( days * (int64_t)SECS_PER_DAY ) + ( tr->hour * SECS_PER_HOUR ) + ( tr->minute * SECS_PER_MIN );
 }
 
 /**************************************************************************************************
-*    Function      : my_mktime
+*    Function      : TimeStructToTimeStamp
 *    Class         : Timecore
-*    Description   : Helperfunction to calculate the time_t form a given time struct
-*    Input         : struct dstRule * tr
-*    Output        : time_t
-*    Remarks       : none
-**************************************************************************************************/ 
-time_t Timecore::my_mktime(struct tm *tmptr)
-{   
-  int i;
-  time_t seconds;
-  static int8_t monthDays[]={31,28,31,30,31,30,31,31,30,31,30,31};
-
-  // seconds from 1970 till the given year
-  seconds= tmptr->tm_year*(SECS_PER_DAY * 365);
-  for (i = 0; i < tmptr->tm_year; i++) {
-    if (LEAP_YEAR(i)) {
-      seconds +=  SECS_PER_DAY;   // add extra days for leap years
-    }
-  }
-  
-  // add days for this year
-  for (i = 0; i < tmptr->tm_mon; i++) {
-    if ( (i == 1) && LEAP_YEAR(tmptr->tm_year)) { 
-      seconds += SECS_PER_DAY * 29;
-    } else {
-      seconds += SECS_PER_DAY * monthDays[i];
-    }
-  }
-  seconds+= (tmptr->tm_mday-1) * SECS_PER_DAY;
-  seconds+= tmptr->tm_hour * SECS_PER_HOUR;
-  seconds+= tmptr->tm_min * SECS_PER_MIN;
-  seconds+= tmptr->tm_sec;
-
-  return (time_t)seconds; 
-}
-
-uint32_t Timecore::TimeStructToTimeStamp(datum_t d ){
-// assemble time elements into time_t 
-// note year argument is offset from 1970 (see macros in time.h to convert to other formats)
-// previous version used full four digit year (or digits since 2000),i.e. 2009 was 2009 or 9
-static int8_t monthDays[]={31,28,31,30,31,30,31,31,30,31,30,31};
-uint8_t year =  d.year;
+*    Description   : Helperfunction to get a unixtimestam from a datum_t
+*    Input         : datum_t
+*    Output        : int64_t
+*    Remarks       : The year is either the full year or the years since 2000
+**************************************************************************************************/
+int64_t Timecore::TimeStructToTimeStamp(datum_t d ){
+int32_t year =  d.year;
 uint8_t month = d.month;
 uint8_t day = d.day;
 uint8_t hour = d.hour;
 uint8_t minute = d.minute;
 uint8_t second = d.second;
-uint32_t UnixTamestamp;
 
-if(month>12){
+if(year<1900){
+  year+=2000;
+}
+
+if( (month>12) || (month==0) ){
   month=1;
 }
 
-if(day>31){
+if( (day>31) || (day==0) ){
   day=1;
 }
 
@@ -698,37 +1105,15 @@ if(minute>59){
   minute=0;
 }
 
-if(second>59){
+if(second==60){
+  /* A leap second, it carries the timestamp of the second before */
+  second=59;
+} else if(second>59){
   second=0;
 }
 
-  int i;
-  uint32_t seconds;
-  year=year+30;
-
-  // seconds from 1970 till 1 jan 00:00:00 of the given year
-  seconds= year*(SECS_PER_DAY * 365);
-  for (i = 0; i < year; i++) {
-    if (LEAP_YEAR(i)) {
-      seconds +=  SECS_PER_DAY;   // add extra days for leap years
-    }
-  }
-  
-  // add days for this year, months start from 1
-  for (i = 1; i < month; i++) {
-    if ( (i == 2) && LEAP_YEAR(year)) { 
-      seconds += SECS_PER_DAY * 29;
-    } else {
-      seconds += SECS_PER_DAY * monthDays[i-1];  //monthDay array starts from 0
-    }
-  }
-  seconds+= (day-1) * SECS_PER_DAY;
-  seconds+= hour * SECS_PER_HOUR;
-  seconds+= minute * SECS_PER_MIN;
-  seconds+= second;
-  UnixTamestamp = seconds;
-
-return  UnixTamestamp; 
+return ( ntp_days_from_civil(year, month, day) * (int64_t)SECS_PER_DAY ) +
+       ( hour * SECS_PER_HOUR ) + ( minute * SECS_PER_MIN ) + second; 
 }
 
 /**************************************************************************************************
@@ -29,6 +29,10 @@
 #include "Arduino.h"
 #include <TimeLib.h>
 #include "timezone_enums.h"
+#include "ntp_timestamp.h"
+#include "ntp_servo.h"
+#include "ntp_holdover.h"
+#include "ntp_leap.h"
 
 
 typedef struct{
@@ -50,12 +54,30 @@ typedef enum {
     RTC_SRC_CNT
 } source_t  ;  
 
-/* The RTX Soruce must provice a unix timestamp in GMT*/
+/* Frequency error assumed as long as the timebase has not been measured, 15ppm as in RFC 5905 */
+#define TIMECORE_FREQ_ERROR_DEFAULT ( 15000 )
+
+/* Servo time constant from which its frequency is learned for holdover, log2 s */
+#define TIMECORE_HOLDOVER_LEARN_TAU ( NTP_SERVO_MAXTAU - 2 )
+
+/* How the clock was disciplined, everything in UTC as 32.32 NTP time on the second */
+typedef struct {
+  source_t source;     /* Source the time was last set from, degrades over time */
+  bool synced;         /* Time was set from a source at least once */
+  bool pps;            /* The current second was started by a PPS edge */
+  ntp_time64_t now;
+  ntp_time64_t last_set;   /* Time was last set from a source */
+  ntp_time64_t last_pps;   /* Last PPS edge, 0 if there was none */
+  bool holdover;       /* The seconds since the last PPS edge are predicted by the servo */
+  uint32_t holdover_error; /* Predicted time error of the holdover in ns */
+} timecore_sync_t;
+
+/* The RTC Source reads and writes UTC as 32.32 NTP time, the era is taken from the time core */
 typedef struct {
    source_t type;
    void (*SecondTick)(void);
-   void (*WriteTime)(uint32_t);
-   uint32_t (*ReadTime)(bool* delayed_result);   
+   void (*WriteTime)(ntp_time64_t);
+   ntp_time64_t (*ReadTime)(bool* delayed_result);   
 } rtc_source_t;
 
 
@@ -111,11 +133,12 @@ class Timecore {
      *    Function      : SetUTC
      *    Class         : Timecore
      *    Description   : Sets the UTC Time
-     *    Input         : uint32_t time, source_t source
+     *    Input         : ntp_time64_t time, source_t source
      *    Output        : none
-     *    Remarks       : Only sets the UTC Time if the source is equal or better than the last one
+     *    Remarks       : Only sets the UTC Time if the source is equal or better than the last one.
+     *                    The fraction is dropped, the era is the one closest to the current time
      **************************************************************************************************/
-    void SetUTC( uint32_t time, source_t source );
+    void SetUTC( ntp_time64_t time, source_t source );
     
     /**************************************************************************************************
      *    Function      : SetUTC
@@ -132,20 +155,30 @@ class Timecore {
      *    Class         : Timecore
      *    Description   : Gets the UTC Time
      *    Input         : none
-     *    Output        : uint32_t ( seconds since 1.1.1970)
-     *    Remarks       : This is a unix timestamp
+     *    Output        : ntp_time64_t ( on the second )
+     *    Remarks       : Use GetNTPTimestamp for the fraction
+     **************************************************************************************************/
+    ntp_time64_t GetUTC( void );
+
+    /**************************************************************************************************
+     *    Function      : GetUnixTime
+     *    Class         : Timecore
+     *    Description   : Gets the UTC Time
+     *    Input         : none
+     *    Output        : int64_t ( seconds since 1.1.1970 )
+     *    Remarks       : This is a unix timestamp, it does not wrap in 2038 or 2106
      **************************************************************************************************/
-    uint32_t GetUTC( void );
+    int64_t GetUnixTime( void );
 
     /**************************************************************************************************
      *    Function      : GetLocalTime
      *    Class         : Timecore
      *    Description   : Gets the UTC Time
      *    Input         : none
-     *    Output        : time_t
+     *    Output        : int64_t
      *    Remarks       : Returns the local time according to the settings
      **************************************************************************************************/
-    time_t GetLocalTime( void );
+    int64_t GetLocalTime( void );
 
     
     /**************************************************************************************************
@@ -176,17 +209,17 @@ class Timecore {
      *    Output        : datum_t
      *    Remarks       : Will convert the timestamp to a stuct with hours, minutes, seconds ......
      **************************************************************************************************/ 
-    datum_t ConvertToDatum( uint32_t timestamp);
+    datum_t ConvertToDatum( int64_t timestamp);
 
     /**************************************************************************************************
      *    Function      : TimeStructToTimeStamp
      *    Class         : Timecore
      *    Description   : Helperfunction to get a unixtimestam from a datum_t
      *    Input         : datum_t
-     *    Output        : uint32_t
-     *    Remarks       : none
+     *    Output        : int64_t
+     *    Remarks       : The year is either the full year or the years since 2000
      **************************************************************************************************/
-      uint32_t TimeStructToTimeStamp(datum_t time);
+      int64_t TimeStructToTimeStamp(datum_t time);
   
      /**************************************************************************************************
      *    Function      : SetTimeZone
@@ -349,6 +382,46 @@ class Timecore {
    *    Remarks       : none
    **************************************************************************************************/
     static timecoreconf_t GetDefaultConfig( void );
+
+  /**************************************************************************************************
+   *    Function      : SetLeap
+   *    Class         : Timecore
+   *    Description   : Announces a leap second
+   *    Input         : leap_settings_t conf
+   *    Output        : none
+   *    Remarks       : An announcement for a time that is not midnight is ignored
+   **************************************************************************************************/
+    void SetLeap( leap_settings_t conf );
+
+  /**************************************************************************************************
+   *    Function      : GetLeap
+   *    Class         : Timecore
+   *    Description   : Gets the leap second announcement
+   *    Input         : none
+   *    Output        : leap_settings_t
+   *    Remarks       : none
+   **************************************************************************************************/
+    leap_settings_t GetLeap( void );
+
+  /**************************************************************************************************
+   *    Function      : GetDefaultLeap
+   *    Class         : Timecore
+   *    Description   : Gets an empty leap second announcement
+   *    Input         : none
+   *    Output        : leap_settings_t
+   *    Remarks       : none
+   **************************************************************************************************/
+    static leap_settings_t GetDefaultLeap( void );
+
+  /**************************************************************************************************
+   *    Function      : GetLeapIndicator
+   *    Class         : Timecore
+   *    Description   : Gets the NTP leap indicator for the current time
+   *    Input         : none
+   *    Output        : uint8_t ( 0 none, 1 insert, 2 delete )
+   *    Remarks       : Set on the day of the leap only, never while smearing
+   **************************************************************************************************/
+    uint8_t GetLeapIndicator( void );
   
   /**************************************************************************************************
    *    Function      : RegisterTimeSource
@@ -380,6 +453,156 @@ class Timecore {
    **************************************************************************************************/  
     void RTC_Tick( void ); /* Needs to be called once a second */
 
+  /**************************************************************************************************
+   *    Function      : PPS_Tick
+   *    Class         : Timecore
+   *    Description   : Needs to be called on every PPS edge instead of RTC_Tick
+   *    Input         : none
+   *    Output        : none
+   *    Remarks       : Also disciplines the timebase to the edges
+   **************************************************************************************************/  
+    void PPS_Tick( void );
+
+  /**************************************************************************************************
+   *    Function      : SetTimebase
+   *    Class         : Timecore
+   *    Description   : Registers a free running hardware timer used for the sub seconds
+   *    Input         : uint64_t (*ReadTimer)(void), uint32_t ticks_per_second
+   *    Output        : none
+   *    Remarks       : ReadTimer is called from RTC_Tick and needs to be placed in RAM
+   **************************************************************************************************/
+    void SetTimebase( uint64_t (*ReadTimer)(void), uint32_t ticks_per_second );
+
+  /**************************************************************************************************
+   *    Function      : SetServoConfig
+   *    Class         : Timecore
+   *    Description   : Sets the learned timebase frequency the servo starts with
+   *    Input         : ntp_servo_settings_t conf
+   *    Output        : none
+   *    Remarks       : Needs to be called before SetTimebase
+   **************************************************************************************************/
+    void SetServoConfig( ntp_servo_settings_t conf );
+
+  /**************************************************************************************************
+   *    Function      : TakeServoSettings
+   *    Class         : Timecore
+   *    Description   : Hands out the learned timebase frequency for storage
+   *    Input         : ntp_servo_settings_t* out
+   *    Output        : bool
+   *    Remarks       : true if it changed enough to be stored again
+   **************************************************************************************************/
+    bool TakeServoSettings( ntp_servo_settings_t* out );
+
+  /**************************************************************************************************
+   *    Function      : GetServoStatus
+   *    Class         : Timecore
+   *    Description   : Gets the state of the timebase servo
+   *    Input         : none
+   *    Output        : ntp_servo_status_t
+   *    Remarks       : none
+   **************************************************************************************************/
+    ntp_servo_status_t GetServoStatus( void );
+
+  /**************************************************************************************************
+   *    Function      : SetHoldoverConfig
+   *    Class         : Timecore
+   *    Description   : Sets the learned frequency over temperature curve
+   *    Input         : ntp_holdover_settings_t conf
+   *    Output        : none
+   *    Remarks       : none
+   **************************************************************************************************/
+    void SetHoldoverConfig( ntp_holdover_settings_t conf );
+
+  /**************************************************************************************************
+   *    Function      : TakeHoldoverSettings
+   *    Class         : Timecore
+   *    Description   : Hands out the learned frequency over temperature curve for storage
+   *    Input         : ntp_holdover_settings_t* out
+   *    Output        : bool
+   *    Remarks       : true if it changed enough to be stored again
+   **************************************************************************************************/
+    bool TakeHoldoverSettings( ntp_holdover_settings_t* out );
+
+  /**************************************************************************************************
+   *    Function      : SampleTemperature
+   *    Class         : Timecore
+   *    Description   : Learns the frequency at a temperature while locked and predicts it in holdover
+   *    Input         : bool valid, int16_t temperature ( 1/4 °C )
+   *    Output        : none
+   *    Remarks       : Call every NTP_HOLDOVER_SAMPLE_INTERVAL, valid is false without a sensor
+   **************************************************************************************************/
+    void SampleTemperature( bool valid, int16_t temperature );
+
+  /**************************************************************************************************
+   *    Function      : GetHoldoverStatus
+   *    Class         : Timecore
+   *    Description   : Gets the state of the holdover prediction
+   *    Input         : none
+   *    Output        : ntp_holdover_status_t
+   *    Remarks       : none
+   **************************************************************************************************/
+    ntp_holdover_status_t GetHoldoverStatus( void );
+
+  /**************************************************************************************************
+   *    Function      : GetHoldoverCurve
+   *    Class         : Timecore
+   *    Description   : Gets the learned frequency over temperature curve
+   *    Input         : none
+   *    Output        : ntp_holdover_settings_t
+   *    Remarks       : none
+   **************************************************************************************************/
+    ntp_holdover_settings_t GetHoldoverCurve( void );
+
+  /**************************************************************************************************
+   *    Function      : GetNTPTimestamp
+   *    Class         : Timecore
+   *    Description   : Gets the UTC Time as NTP timestamp with full fraction
+   *    Input         : none
+   *    Output        : ntp_timestamp_t
+   *    Remarks       : The fraction is interpolated from the timer latched by the last RTC_Tick
+   **************************************************************************************************/
+    ntp_timestamp_t GetNTPTimestamp( void );
+
+  /**************************************************************************************************
+   *    Function      : GetPPSOffset
+   *    Class         : Timecore
+   *    Description   : Gets the time error seen at the last PPS edge
+   *    Input         : none
+   *    Output        : int32_t ( nanoseconds )
+   *    Remarks       : Positive if the clock was running slow
+   **************************************************************************************************/
+    int32_t GetPPSOffset( void );
+
+  /**************************************************************************************************
+   *    Function      : GetPPSJitter
+   *    Class         : Timecore
+   *    Description   : Gets the average deviation of the PPS edges
+   *    Input         : none
+   *    Output        : uint32_t ( nanoseconds )
+   *    Remarks       : none
+   **************************************************************************************************/
+    uint32_t GetPPSJitter( void );
+
+  /**************************************************************************************************
+   *    Function      : GetFrequencyError
+   *    Class         : Timecore
+   *    Description   : Gets the estimated frequency error of the clock without PPS
+   *    Input         : none
+   *    Output        : uint32_t ( parts per billion )
+   *    Remarks       : Uncertainty of the frequency predicted for holdover
+   **************************************************************************************************/
+    uint32_t GetFrequencyError( void );
+
+  /**************************************************************************************************
+   *    Function      : GetSyncState
+   *    Class         : Timecore
+   *    Description   : Gets the source and the times the clock was last disciplined
+   *    Input         : none
+   *    Output        : timecore_sync_t
+   *    Remarks       : none
+   **************************************************************************************************/
+    timecore_sync_t GetSyncState( void );
+
   /**************************************************************************************************
    *    Function      : GetTimeZoneName
    *    Class         : Timecore
@@ -393,44 +616,66 @@ class Timecore {
     private:
         timecoreconf_t local_config; 
         timezone_t TimeZoneRam;
-        uint8_t dstYear;
-        time_t dstStart;  // Start of DST in specific Year (seconds since 1970)
-        time_t dstEnd;    // End of DST in listed Year (seconds since 1970)
-        uint32_t local_softrtc_timestamp=0;
+        uint16_t dstYear;
+        int64_t dstStart;  // Start of DST in specific Year (seconds since 1970)
+        int64_t dstEnd;    // End of DST in listed Year (seconds since 1970)
+        uint64_t local_softrtc_timestamp=0; /* Seconds since 1.1.1900 counted on across NTP eras */
+        uint64_t (*ReadTimebase)(void)=NULL; /* Free running timer for the sub seconds */
+        uint32_t TimebaseFrequency=0;
+        uint64_t TimebaseLatch=0; /* Timer value the current second started at */
+        NTP_ClockServo Servo; /* Disciplines the timebase to the PPS edges */
+        ntp_servo_settings_t ServoConfig={false,0};
+        NTP_Holdover Holdover; /* Predicts the timebase frequency from the temperature without PPS */
+        bool TimebaseLatchFromPPS=false;
+        uint64_t LastPPS=0; /* UTC of the last PPS edge, same scale as local_softrtc_timestamp */
+        uint64_t LastSet=0; /* UTC the time was last set from a source */
+        bool Synced=false;
+        NTP_LeapSecond Leap; /* Leap second announcement applied to local_softrtc_timestamp */
+        portMUX_TYPE TimebaseMux = portMUX_INITIALIZER_UNLOCKED;
         source_t CurrentMasterSource=NO_RTC; /* If this is set to none we run from the internal rtc */
         rtc_source_t TimeSources [RTC_SRC_CNT]; 
         void* rtc_event_callback[RTC_EVENT_CNT]={NULL,}; /* Holds the callbacks for the RTC events */
         uint16_t DegradeTimer_Src=3600;
         
       /**************************************************************************************************
-       *    Function      : calcYear
+       *    Function      : GetUTCSeconds
        *    Class         : Timecore
-       *    Description   : Helperfunction to calculate the year
-       *    Input         : time_t
-       *    Output        : uint8_t
+       *    Description   : Gets the UTC Time
+       *    Input         : none
+       *    Output        : uint64_t ( seconds since 1.1.1900 across NTP eras )
        *    Remarks       : none
        **************************************************************************************************/ 
-        uint8_t calcYear(time_t time);
+        uint64_t GetUTCSeconds( void );
 
       /**************************************************************************************************
-       *    Function      : calcTime
+       *    Function      : SetUTCSeconds
        *    Class         : Timecore
-       *    Description   : Helperfunction to calculate the DLST-Rule for the current year
-       *    Input         : struct dstRule * tr
-       *    Output        : time_t
+       *    Description   : Sets the UTC Time
+       *    Input         : uint64_t time ( seconds since 1.1.1900 across NTP eras ), source_t source
+       *    Output        : none
+       *    Remarks       : Only sets the UTC Time if the source is equal or better than the last one
+       **************************************************************************************************/ 
+        void SetUTCSeconds( uint64_t time, source_t source );
+
+      /**************************************************************************************************
+       *    Function      : calcYear
+       *    Class         : Timecore
+       *    Description   : Helperfunction to calculate the year
+       *    Input         : int64_t
+       *    Output        : uint16_t
        *    Remarks       : none
        **************************************************************************************************/ 
-        time_t calcTime(struct dstRule * tr);
+        uint16_t calcYear(int64_t time);
 
       /**************************************************************************************************
-       *    Function      : my_mktime
+       *    Function      : calcTime
        *    Class         : Timecore
-       *    Description   : Helperfunction to calculate the time_t form a given time struct
+       *    Description   : Helperfunction to calculate the DLST-Rule for the current year
        *    Input         : struct dstRule * tr
-       *    Output        : time_t
+       *    Output        : int64_t
        *    Remarks       : none
        **************************************************************************************************/ 
-        time_t my_mktime(struct tm *tmptr);
+        int64_t calcTime(struct dstRule * tr);
 
       /**************************************************************************************************
        *    Function      : SetTimeZone
@@ -453,6 +698,27 @@ class Timecore {
        *    Remarks       : none
        **************************************************************************************************/ 
        void LoadTimezone( uint16_t index);
+
+      /**************************************************************************************************
+       *    Function      : NextSecond
+       *    Class         : Timecore
+       *    Description   : Advances the time by one second
+       *    Input         : none
+       *    Output        : none
+       *    Remarks       : Needs TimebaseMux held
+       **************************************************************************************************/ 
+       void NextSecond( void );
+
+      /**************************************************************************************************
+       *    Function      : Tick
+       *    Class         : Timecore
+       *    Description   : Advances the time by the seconds passed and latches the timebase
+       *    Input         : bool pps_edge
+       *    Output        : none
+       *    Remarks       : PPS edges go to the servo, without them it predicts the boundaries from the
+       *                    held frequency and the caller only tells when to look
+       **************************************************************************************************/ 
+       void Tick( bool pps_edge );
      
 };
 
@@ -17,11 +17,14 @@
 */
 #include <ArduinoJson.h>
 #include <WebServer.h>
+#include <base64.h>
 
 
 #include <TinyGPS++.h>
 #include "timecore.h"
 #include "datastore.h"
+#include "ntp_server.h"
+#include "roughtime_server.h"
 
 #include "webfunctions.h"
 
@@ -31,6 +34,14 @@ extern WebServer * server;
 extern TinyGPSPlus gps;
 
 extern gps_settings_t gps_config;
+extern NTP_Server NTPServer;
+extern RoughtimeServer Roughtime;
+
+/* Clients sent with one page of /ntp/clients.json */
+#define NTP_CLIENTS_PAGE_MAX ( 32 )
+
+/* Flagged clients sent with the census */
+#define NTP_CENSUS_FLAGGED_MAX ( 32 )
 
 /**************************************************************************************************
 *    Function      : response_settings
@@ -331,7 +342,7 @@ const size_t capacity = JSON_ARRAY_SIZE(2) + JSON_OBJECT_SIZE(3);
 DynamicJsonDocument  root(capacity);
 
   root["sensor"] = "gps";
-  root["utc_time"] = timec.GetUTC();
+  root["utc_time"] = timec.GetUnixTime();
 
   if (false == gps.location.isValid())
   {
@@ -530,6 +541,64 @@ void update_ipv4_settings( void ){
   server->send(200);  
   
 }
+
+/**************************************************************************************************
+*    Function      : send_softap_settings
+*    Description   : Sends the access point settings as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : The passphrase is never sent, only if one is set
+**************************************************************************************************/
+void send_softap_settings( void ){
+  softap_settings_t conf = read_softap_settings();
+  String response ="";
+  const size_t capacity = JSON_OBJECT_SIZE(3);
+  DynamicJsonDocument  root(capacity);
+
+  root["with_sta"] = conf.with_sta;
+  root["max_clients"] = conf.max_clients;
+  root["has_pass"] = ( strlen(conf.pass) >= 8 );
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : update_softap_settings
+*    Description   : Updates the access point settings from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : Arguments are AP_WITH_STA, AP_MAX_CLIENTS and AP_PASS, applied after a restart.
+*                    An empty AP_PASS keeps the passphrase, a single - clears it
+**************************************************************************************************/
+void update_softap_settings( void ){
+  softap_settings_t conf = read_softap_settings();
+
+  if( ! server->hasArg("AP_WITH_STA") || server->arg("AP_WITH_STA") == NULL ) {
+    conf.with_sta = false;
+  } else {
+    conf.with_sta = ( server->arg("AP_WITH_STA") == "true" );
+  }
+
+  if( server->hasArg("AP_MAX_CLIENTS") && server->arg("AP_MAX_CLIENTS") != NULL ) {
+    int32_t max_clients = server->arg("AP_MAX_CLIENTS").toInt();
+    if( (max_clients > 0) && (max_clients <= 10) ){
+      conf.max_clients = max_clients;
+    }
+  }
+
+  if( server->hasArg("AP_PASS") && server->arg("AP_PASS") != NULL ) {
+    String ap_pass = server->arg("AP_PASS");
+    if(ap_pass == "-"){
+      memset(conf.pass, 0, sizeof(conf.pass));
+    } else if( (ap_pass.length() >= 8) && (ap_pass.length() < sizeof(conf.pass)) ){
+      memset(conf.pass, 0, sizeof(conf.pass));
+      strncpy(conf.pass, ap_pass.c_str(), sizeof(conf.pass) - 1);
+    }
+  }
+
+  write_softap_settings(conf);
+  server->send(200);
+}
 /**************************************************************************************************
 *    Function      : send_display_settings
 *    Description   : set or unset form web if the display will be swapped
@@ -548,3 +617,765 @@ void send_display_settings( void ){
   sendData(response);
 
 }
+
+/**************************************************************************************************
+*    Function      : send_ntp_status
+*    Description   : Sends the ntp server counters as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_ntp_status( void ){
+  ntp_server_stats_t stats = NTPServer.GetStats();
+  ntp_ratelimit_stats_t rl_stats = NTPServer.GetRateLimitStats();
+  ntp_precision_t precision = NTPServer.GetPrecision();
+  String response ="";
+  const size_t capacity = JSON_OBJECT_SIZE(4) + JSON_OBJECT_SIZE(11) + JSON_OBJECT_SIZE(5) + JSON_OBJECT_SIZE(4) +
+                          JSON_ARRAY_SIZE(NTP_INTERFACES) + NTP_INTERFACES * JSON_OBJECT_SIZE(6);
+  DynamicJsonDocument  root(capacity);
+
+  JsonObject server_stats = root.createNestedObject("server");
+  server_stats["requests"] = stats.requests;
+  server_stats["requests_v4"] = stats.requests_v4;
+  server_stats["requests_v6"] = stats.requests_v6;
+  server_stats["responses"] = stats.responses;
+  server_stats["interleaved"] = stats.interleaved;
+  server_stats["dropped"] = stats.dropped;
+  server_stats["broadcasts"] = stats.broadcasts;
+  server_stats["authenticated"] = stats.authenticated;
+  server_stats["authfailed"] = stats.authfailed;
+  server_stats["nts"] = stats.nts;
+  server_stats["ntsnak"] = stats.ntsnak;
+
+  JsonObject ratelimit = root.createNestedObject("ratelimit");
+  ratelimit["hits"] = rl_stats.hits;
+  ratelimit["misses"] = rl_stats.misses;
+  ratelimit["evictions"] = rl_stats.evictions;
+  ratelimit["limited"] = rl_stats.limited;
+  ratelimit["kod"] = rl_stats.kod;
+
+  /* What the clock was measured at, resolution and read cost in ns */
+  JsonObject clock = root.createNestedObject("clock");
+  clock["valid"] = precision.valid;
+  clock["precision"] = precision.precision;
+  clock["resolution"] = (uint32_t)( ( precision.resolution * 1000000000ull ) >> 32 );
+  clock["read_cost"] = (uint32_t)( ( precision.read_cost * 1000000000ull ) >> 32 );
+
+  /* Every interface has its own counters and rate limiter */
+  JsonArray interfaces = root.createNestedArray("interfaces");
+  for(uint8_t i=0;i<NTP_INTERFACES;i++){
+    ntp_server_stats_t nif_stats = NTPServer.GetStats(i);
+    ntp_ratelimit_stats_t nif_rl = NTPServer.GetRateLimitStats(i);
+    JsonObject nif = interfaces.createNestedObject();
+    nif["name"] = NTP_TxCalibration::GetInterfaceName(i);
+    nif["requests"] = nif_stats.requests;
+    nif["responses"] = nif_stats.responses;
+    nif["dropped"] = nif_stats.dropped;
+    nif["limited"] = nif_rl.limited;
+    nif["kod"] = nif_rl.kod;
+  }
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : send_ntp_latency
+*    Description   : Sends the latency histograms of the packet path as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : Values are cycles, cycles_per_us converts them
+**************************************************************************************************/
+void send_ntp_latency( void ){
+  String response ="";
+  const size_t capacity = JSON_OBJECT_SIZE(4) + JSON_OBJECT_SIZE(NTP_LATENCY_STAGES) + NTP_LATENCY_STAGES * JSON_OBJECT_SIZE(4) +
+                          JSON_ARRAY_SIZE(NTP_INTERFACES) + NTP_INTERFACES * JSON_OBJECT_SIZE(5);
+  DynamicJsonDocument  root(capacity);
+
+  root["enabled"] = ( NTP_LATENCY_STATS > 0 );
+  root["cycles_per_us"] = NTP_LatencyStats::GetCyclesPerUs();
+  JsonObject stages = root.createNestedObject("stages");
+  for(uint8_t i=0;i<NTP_LATENCY_STAGES;i++){
+    ntp_latency_summary_t summary = NTPServer.GetLatency((ntp_latency_stage_t)i);
+    JsonObject stage = stages.createNestedObject(NTP_LatencyStats::GetStageName((ntp_latency_stage_t)i));
+    stage["count"] = summary.count;
+    stage["p50"] = summary.p50;
+    stage["p99"] = summary.p99;
+    stage["max"] = summary.max;
+  }
+  /* Arrival to sent of the requests of each interface */
+  JsonArray interfaces = root.createNestedArray("interfaces");
+  for(uint8_t i=0;i<NTP_INTERFACES;i++){
+    ntp_latency_summary_t summary = NTPServer.GetLatency(i, NTP_LATENCY_TOTAL);
+    JsonObject nif = interfaces.createNestedObject();
+    nif["name"] = NTP_TxCalibration::GetInterfaceName(i);
+    nif["count"] = summary.count;
+    nif["p50"] = summary.p50;
+    nif["p99"] = summary.p99;
+    nif["max"] = summary.max;
+  }
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : reset_ntp_latency
+*    Description   : Clears the latency histograms of the packet path
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void reset_ntp_latency( void ){
+  NTPServer.ResetLatency();
+  server->send(200);
+}
+
+/**************************************************************************************************
+*    Function      : send_ntp_servo
+*    Description   : Sends the state of the timebase servo as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : Offset and jitter in ns, the frequency in ppb
+**************************************************************************************************/
+void send_ntp_servo( void ){
+  ntp_servo_status_t status = timec.GetServoStatus();
+  String response ="";
+  const size_t capacity = JSON_OBJECT_SIZE(9);
+  DynamicJsonDocument  root(capacity);
+
+  root["state"] = NTP_ClockServo::GetStateName(status.state);
+  root["tau"] = status.tau;
+  root["offset"] = status.offset;
+  root["jitter"] = status.jitter;
+  root["frequency"] = status.frequency;
+  root["edges"] = status.edges;
+  root["missed"] = status.missed;
+  root["spikes"] = status.spikes;
+  root["steps"] = status.steps;
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : send_ntp_holdover
+*    Description   : Sends the holdover prediction and the learned curve as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : Temperatures in °C, frequencies in ppb, the error in ns
+**************************************************************************************************/
+void send_ntp_holdover( void ){
+  ntp_holdover_status_t status = timec.GetHoldoverStatus();
+  ntp_holdover_settings_t curve = timec.GetHoldoverCurve();
+  String response ="";
+  const size_t capacity = JSON_OBJECT_SIZE(11) + JSON_ARRAY_SIZE(NTP_HOLDOVER_BINS) + NTP_HOLDOVER_BINS * JSON_OBJECT_SIZE(4);
+  DynamicJsonDocument  root(capacity);
+
+  root["referenced"] = status.referenced;
+  root["compensated"] = status.compensated;
+  if(true == status.has_temperature){
+    root["temperature"] = status.temperature / 4.0;
+  }
+  root["reference_temperature"] = status.reference_temperature / 4.0;
+  root["reference"] = status.reference;
+  root["frequency"] = status.frequency;
+  root["uncertainty"] = status.uncertainty;
+  root["seconds"] = status.seconds;
+  root["error"] = status.error;
+  root["bins"] = status.bins;
+  JsonArray bins = root.createNestedArray("curve");
+  for(uint8_t i=0;i<NTP_HOLDOVER_BINS;i++){
+    if(curve.bins[i].samples == 0){
+      continue;
+    }
+    JsonObject entry = bins.createNestedObject();
+    entry["temperature"] = NTP_Holdover::GetBinTemperature(i) / 4.0;
+    entry["frequency"] = curve.bins[i].frequency;
+    entry["deviation"] = curve.bins[i].deviation;
+    entry["samples"] = curve.bins[i].samples;
+  }
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : send_ntp_txcal
+*    Description   : Sends the transmit delays and the state of the calibration as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : Delays in ns, the variance in us^2
+**************************************************************************************************/
+void send_ntp_txcal( void ){
+  ntp_txcal_settings_t conf = NTPServer.GetTxCalibration();
+  ntp_txcal_progress_t progress = NTPServer.GetTxCalibrationProgress();
+  String response ="";
+  const size_t capacity = JSON_OBJECT_SIZE(3) + JSON_OBJECT_SIZE(5) + JSON_ARRAY_SIZE(NTP_TXCAL_INTERFACES) + NTP_TXCAL_INTERFACES * JSON_OBJECT_SIZE(5);
+  DynamicJsonDocument  root(capacity);
+
+  root["enabled"] = conf.enabled;
+  JsonObject cal = root.createNestedObject("calibration");
+  cal["running"] = progress.running;
+  cal["interface"] = NTP_TxCalibration::GetInterfaceName(progress.netif);
+  cal["samples"] = progress.samples;
+  cal["target"] = progress.target;
+  cal["rejected"] = progress.rejected;
+  JsonArray interfaces = root.createNestedArray("interfaces");
+  for(uint8_t i=0;i<NTP_TXCAL_INTERFACES;i++){
+    JsonObject entry = interfaces.createNestedObject();
+    float stddev_us = conf.interfaces[i].stddev / 1000.0;
+    entry["name"] = NTP_TxCalibration::GetInterfaceName(i);
+    entry["delay"] = conf.interfaces[i].delay;
+    entry["stddev"] = conf.interfaces[i].stddev;
+    entry["variance"] = stddev_us * stddev_us;
+    entry["samples"] = conf.interfaces[i].samples;
+  }
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : update_ntp_txcal
+*    Description   : Starts or stops a transmit calibration or switches the correction on or off
+*    Input         : none
+*    Output        : none
+*    Remarks       : TXCAL_START is the interface, 0 STA, 1 AP, 2 ETH. The result is stored once
+*                    the samples are taken
+**************************************************************************************************/
+void update_ntp_txcal( void ){
+  if( server->hasArg("TXCAL_STOP") ){
+    NTPServer.StopTxCalibration();
+    server->send(200);
+    return;
+  }
+
+  if( server->hasArg("TXCAL_START") && server->arg("TXCAL_START") != NULL ) {
+    int32_t netif = server->arg("TXCAL_START").toInt();
+    int32_t samples = NTP_TXCAL_SAMPLES;
+    if( server->hasArg("TXCAL_SAMPLES") && server->arg("TXCAL_SAMPLES") != NULL ) {
+      samples = server->arg("TXCAL_SAMPLES").toInt();
+    }
+    if( (netif < 0) || (netif >= NTP_TXCAL_INTERFACES) || (samples < 16) || (samples > 4096) ||
+        (false == NTPServer.StartTxCalibration(netif, samples)) ){
+      server->send(400);
+      return;
+    }
+    server->send(200);
+    return;
+  }
+
+  ntp_txcal_settings_t conf = NTPServer.GetTxCalibration();
+  if( ! server->hasArg("TXCAL_ENABLED") || server->arg("TXCAL_ENABLED") == NULL ) {
+    conf.enabled = false;
+  } else {
+    conf.enabled = ( server->arg("TXCAL_ENABLED") == "true" );
+  }
+  write_txcal_config(conf);
+  NTPServer.SetTxCalibration(&conf);
+  server->send(200);
+}
+
+/**************************************************************************************************
+*    Function      : send_ntp_ratelimit_settings
+*    Description   : Sends the ntp rate limit settings as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_ntp_ratelimit_settings( void ){
+  ratelimit_settings_t conf = read_ratelimit_config();
+  String response ="";
+  const size_t capacity = JSON_OBJECT_SIZE(4);
+  DynamicJsonDocument  root(capacity);
+
+  root["enabled"] = conf.enabled;
+  root["send_kod"] = conf.send_kod;
+  root["rate"] = conf.rate;
+  root["burst"] = conf.burst;
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : update_ntp_ratelimit_settings
+*    Description   : Updates the ntp rate limit settings from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : The new settings are applied at once
+**************************************************************************************************/
+void update_ntp_ratelimit_settings( void ){
+  ratelimit_settings_t conf = read_ratelimit_config();
+
+  if( ! server->hasArg("RL_ENABLED") || server->arg("RL_ENABLED") == NULL ) {
+    conf.enabled = false;
+  } else {
+    conf.enabled = ( server->arg("RL_ENABLED") == "true" );
+  }
+
+  if( ! server->hasArg("RL_KOD") || server->arg("RL_KOD") == NULL ) {
+    conf.send_kod = false;
+  } else {
+    conf.send_kod = ( server->arg("RL_KOD") == "true" );
+  }
+
+  if( server->hasArg("RL_RATE") && server->arg("RL_RATE") != NULL ) {
+    int32_t rate = server->arg("RL_RATE").toInt();
+    if( (rate > 0) && (rate <= 3600) ){
+      conf.rate = rate;
+    }
+  }
+
+  if( server->hasArg("RL_BURST") && server->arg("RL_BURST") != NULL ) {
+    int32_t burst = server->arg("RL_BURST").toInt();
+    if( (burst > 0) && (burst <= 255) ){
+      conf.burst = burst;
+    }
+  }
+
+  write_ratelimit_config(conf);
+  NTPServer.SetRateLimit(conf);
+  server->send(200);
+}
+
+/**************************************************************************************************
+*    Function      : send_ntp_clients
+*    Description   : Sends a page of the ntp client list as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : Arguments are page and size, the most recently seen client comes first
+**************************************************************************************************/
+void send_ntp_clients( void ){
+  ntp_mru_entry_t clients[NTP_CLIENTS_PAGE_MAX];
+  char addr[NTP_ADDR_STR_LEN];
+  uint16_t page = 0;
+  uint16_t size = NTP_CLIENTS_PAGE_MAX;
+  String response ="";
+
+  if( server->hasArg("page") && server->arg("page") != NULL ) {
+    int32_t p = server->arg("page").toInt();
+    if( (p >= 0) && (p < NTP_MRU_ENTRIES) ){
+      page = p;
+    }
+  }
+  if( server->hasArg("size") && server->arg("size") != NULL ) {
+    int32_t s = server->arg("size").toInt();
+    if( (s > 0) && (s <= NTP_CLIENTS_PAGE_MAX) ){
+      size = s;
+    }
+  }
+
+  uint16_t total = NTPServer.GetClientCount();
+  uint16_t count = NTPServer.GetClients(clients, page * size, size);
+
+  const size_t capacity = JSON_OBJECT_SIZE(4) + JSON_ARRAY_SIZE(NTP_CLIENTS_PAGE_MAX) + NTP_CLIENTS_PAGE_MAX * ( JSON_OBJECT_SIZE(7) + NTP_ADDR_STR_LEN );
+  DynamicJsonDocument  root(capacity);
+  root["total"] = total;
+  root["page"] = page;
+  root["pages"] = ( total + size - 1 ) / size;
+  JsonArray list = root.createNestedArray("clients");
+  for(uint16_t i=0;i<count;i++){
+    JsonObject c = list.createNestedObject();
+    /* A char array is copied into the document */
+    ntp_addr_format(&clients[i].client, addr, sizeof(addr));
+    c["addr"] = addr;
+    c["first"] = clients[i].first.seconds - NTP_TIMESTAMP_DELTA;
+    c["last"] = clients[i].last.seconds - NTP_TIMESTAMP_DELTA;
+    c["count"] = clients[i].count;
+    c["avgint"] = NTP_MRUList::AverageInterval(&clients[i]);
+    c["version"] = clients[i].version;
+    c["mode"] = clients[i].mode;
+  }
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : send_ntp_census
+*    Description   : Sends the census of the client clocks as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : Offsets in ms, drift in ppm, the histogram bins by their upper end in s
+**************************************************************************************************/
+void send_ntp_census( void ){
+  ntp_census_entry_t flagged[NTP_CENSUS_FLAGGED_MAX];
+  char addr[NTP_ADDR_STR_LEN];
+  ntp_census_stats_t stats = NTPServer.GetCensus();
+  uint16_t count = NTPServer.GetCensusFlagged(flagged, NTP_CENSUS_FLAGGED_MAX);
+  String response ="";
+  const size_t capacity = JSON_OBJECT_SIZE(10) + JSON_ARRAY_SIZE(NTP_CENSUS_BINS) + NTP_CENSUS_BINS * JSON_OBJECT_SIZE(2) +
+                          JSON_ARRAY_SIZE(NTP_CENSUS_FLAGGED_MAX) + NTP_CENSUS_FLAGGED_MAX * ( JSON_OBJECT_SIZE(8) + NTP_ADDR_STR_LEN );
+  DynamicJsonDocument  root(capacity);
+
+  root["samples"] = stats.samples;
+  root["opaque"] = stats.opaque;
+  root["evictions"] = stats.evictions;
+  root["clients"] = stats.clients;
+  root["far_off"] = stats.far_off;
+  root["drifting"] = stats.drifting;
+  root["offset_limit"] = NTP_CENSUS_OFFSET_LIMIT * 1000.0;
+  root["drift_limit"] = NTP_CENSUS_DRIFT_LIMIT * 1e6;
+  JsonArray histogram = root.createNestedArray("histogram");
+  for(uint8_t i=0;i<NTP_CENSUS_BINS;i++){
+    JsonObject bin = histogram.createNestedObject();
+    bin["upper"] = NTP_ClientCensus::GetBinLimit(i);
+    bin["count"] = stats.histogram[i];
+  }
+  JsonArray list = root.createNestedArray("flagged");
+  for(uint16_t i=0;i<count;i++){
+    JsonObject c = list.createNestedObject();
+    ntp_addr_format(&flagged[i].client, addr, sizeof(addr));
+    c["addr"] = addr;
+    c["samples"] = flagged[i].samples;
+    c["offset"] = flagged[i].mean * 1000.0;
+    c["stddev"] = NTP_ClientCensus::GetStddev(&flagged[i]) * 1000.0;
+    c["drift"] = NTP_ClientCensus::GetDrift(&flagged[i]) * 1e6;
+    c["far_off"] = ( 0 != ( flagged[i].flags & NTP_CENSUS_FLAG_OFFSET ) );
+    c["drifting"] = ( 0 != ( flagged[i].flags & NTP_CENSUS_FLAG_DRIFT ) );
+    c["last"] = flagged[i].last - NTP_TIMESTAMP_DELTA;
+  }
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : send_ntp_broadcast_settings
+*    Description   : Sends the ntp broadcast settings as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_ntp_broadcast_settings( void ){
+  broadcast_settings_t conf = read_broadcast_config();
+  String response ="";
+  const size_t capacity = JSON_OBJECT_SIZE(4);
+  DynamicJsonDocument  root(capacity);
+
+  root["broadcast"] = conf.broadcast;
+  root["multicast"] = conf.multicast;
+  root["poll"] = conf.poll;
+  root["ttl"] = conf.ttl;
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : update_ntp_broadcast_settings
+*    Description   : Updates the ntp broadcast settings from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : The new settings are applied at once
+**************************************************************************************************/
+void update_ntp_broadcast_settings( void ){
+  broadcast_settings_t conf = read_broadcast_config();
+
+  if( ! server->hasArg("BC_ENABLED") || server->arg("BC_ENABLED") == NULL ) {
+    conf.broadcast = false;
+  } else {
+    conf.broadcast = ( server->arg("BC_ENABLED") == "true" );
+  }
+
+  if( ! server->hasArg("MC_ENABLED") || server->arg("MC_ENABLED") == NULL ) {
+    conf.multicast = false;
+  } else {
+    conf.multicast = ( server->arg("MC_ENABLED") == "true" );
+  }
+
+  if( server->hasArg("BC_POLL") && server->arg("BC_POLL") != NULL ) {
+    int32_t poll = server->arg("BC_POLL").toInt();
+    if( (poll >= NTP_BROADCAST_POLL_MIN) && (poll <= NTP_BROADCAST_POLL_MAX) ){
+      conf.poll = poll;
+    }
+  }
+
+  if( server->hasArg("BC_TTL") && server->arg("BC_TTL") != NULL ) {
+    int32_t ttl = server->arg("BC_TTL").toInt();
+    if( (ttl > 0) && (ttl <= 255) ){
+      conf.ttl = ttl;
+    }
+  }
+
+  write_broadcast_config(conf);
+  NTPServer.SetBroadcast(conf);
+  server->send(200);
+}
+
+/**************************************************************************************************
+*    Function      : send_ntp_keys
+*    Description   : Sends the ntp key table as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : The key values are never sent
+**************************************************************************************************/
+void send_ntp_keys( void ){
+  ntp_keys_settings_t conf = read_ntp_keys_config();
+  String response ="";
+  const size_t capacity = JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(NTP_KEYS_MAX) + NTP_KEYS_MAX*JSON_OBJECT_SIZE(3);
+  DynamicJsonDocument  root(capacity);
+
+  JsonArray keys = root.createNestedArray("keys");
+  for(uint8_t i=0;i<NTP_KEYS_MAX;i++){
+    JsonObject key = keys.createNestedObject();
+    key["slot"] = i;
+    key["id"] = conf.keys[i].id;
+    key["type"] = conf.keys[i].type;
+  }
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : update_ntp_key
+*    Description   : Updates a slot of the ntp key table from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : Arguments are KEY_SLOT, KEY_ID, KEY_TYPE and KEY_VALUE as hex string,
+*                    type 0 clears the slot. Invalid keys are not stored
+**************************************************************************************************/
+void update_ntp_key( void ){
+  ntp_keys_settings_t conf = read_ntp_keys_config();
+  ntp_key_t key;
+  memset(&key, 0, sizeof(key));
+
+  if( ! server->hasArg("KEY_SLOT") || server->arg("KEY_SLOT") == NULL ) {
+    server->send(200);
+    return;
+  }
+  int32_t slot = server->arg("KEY_SLOT").toInt();
+  if( (slot < 0) || (slot >= NTP_KEYS_MAX) ){
+    server->send(200);
+    return;
+  }
+
+  if( server->hasArg("KEY_TYPE") && server->arg("KEY_TYPE") != NULL ) {
+    int32_t type = server->arg("KEY_TYPE").toInt();
+    if( (type >= NTP_KEY_NONE) && (type <= NTP_KEY_AES128CMAC) ){
+      key.type = type;
+    }
+  }
+
+  if( key.type != NTP_KEY_NONE ){
+    if( server->hasArg("KEY_ID") && server->arg("KEY_ID") != NULL ) {
+      key.id = strtoul(server->arg("KEY_ID").c_str(), NULL, 10);
+    }
+    if( server->hasArg("KEY_VALUE") && server->arg("KEY_VALUE") != NULL ) {
+      String value = server->arg("KEY_VALUE");
+      if( ( (value.length() % 2) == 0 ) && ( value.length() <= (2 * NTP_KEY_LEN_MAX) ) ){
+        key.len = value.length() / 2;
+        for(uint8_t i=0;i<key.len;i++){
+          char* end = NULL;
+          String digits = value.substring(2*i, 2*i+2);
+          key.key[i] = strtoul(digits.c_str(), &end, 16);
+          if( (end == NULL) || (*end != '\0') ){
+            key.len = 0;
+            break;
+          }
+        }
+      }
+    }
+    if( false == NTP_KeyTable::IsValid(&key) ){
+      server->send(200);
+      return;
+    }
+  }
+
+  conf.keys[slot] = key;
+  write_ntp_keys_config(conf);
+  NTPServer.SetKeys(&conf);
+  server->send(200);
+}
+
+/**************************************************************************************************
+*    Function      : send_leap_settings
+*    Description   : Sends the leap second announcement as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_leap_settings( void ){
+  leap_settings_t conf = timec.GetLeap();
+  String response ="";
+  const size_t capacity = JSON_OBJECT_SIZE(4);
+  DynamicJsonDocument  root(capacity);
+
+  root["time"] = conf.time;
+  root["direction"] = conf.direction;
+  root["smear"] = conf.smear;
+  root["indicator"] = timec.GetLeapIndicator();
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : update_leap_settings
+*    Description   : Updates the leap second announcement from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : LEAP_TIME is the UTC midnight after the leap as unix timestamp
+**************************************************************************************************/
+void update_leap_settings( void ){
+  leap_settings_t conf = timec.GetLeap();
+
+  if( server->hasArg("LEAP_DIR") && server->arg("LEAP_DIR") != NULL ) {
+    int32_t direction = server->arg("LEAP_DIR").toInt();
+    if( (direction >= -1) && (direction <= 1) ){
+      conf.direction = direction;
+    }
+  }
+
+  if( server->hasArg("LEAP_TIME") && server->arg("LEAP_TIME") != NULL ) {
+    uint32_t time = strtoul(server->arg("LEAP_TIME").c_str(), NULL, 10);
+    if( (time % SECS_PER_DAY) == 0 ){
+      conf.time = time;
+    }
+  }
+
+  if( ! server->hasArg("LEAP_SMEAR") || server->arg("LEAP_SMEAR") == NULL ) {
+    conf.smear = false;
+  } else {
+    conf.smear = ( server->arg("LEAP_SMEAR") == "true" );
+  }
+
+  if(conf.direction == 0){
+    conf = Timecore::GetDefaultLeap();
+  }
+  write_leap_config(conf);
+  timec.SetLeap(conf);
+  server->send(200);
+}
+
+/**************************************************************************************************
+*    Function      : send_nts_settings
+*    Description   : Sends the nts settings as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : The master keys are never sent, experimental tells if NTS is in this build
+**************************************************************************************************/
+void send_nts_settings( void ){
+  nts_settings_t conf = read_nts_config();
+  String response ="";
+  const size_t capacity = JSON_OBJECT_SIZE(4);
+  DynamicJsonDocument  root(capacity);
+
+  root["experimental"] = ( NTP_NTS_EXPERIMENTAL != 0 );
+  root["enabled"] = conf.enabled;
+  root["keyid"] = conf.keyid;
+  root["prev_keyid"] = conf.prev_keyid;
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : update_nts_settings
+*    Description   : Updates the nts settings from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : Arguments are NTS_ENABLED, NTS_ROTATE to create a new random master key or
+*                    NTS_KEY_ID and NTS_KEY as hex string to set the key of an external NTS-KE
+*                    server. The current key becomes the previous one in both cases
+**************************************************************************************************/
+void update_nts_settings( void ){
+  nts_settings_t conf = read_nts_config();
+
+  if( ! server->hasArg("NTS_ENABLED") || server->arg("NTS_ENABLED") == NULL ) {
+    conf.enabled = false;
+  } else {
+    conf.enabled = ( server->arg("NTS_ENABLED") == "true" );
+  }
+
+  if( server->hasArg("NTS_ROTATE") && ( server->arg("NTS_ROTATE") == "true" ) ) {
+    NTP_NTS::NewKey(&conf);
+  } else if( server->hasArg("NTS_KEY") && server->arg("NTS_KEY") != NULL && server->arg("NTS_KEY") != "" ) {
+    uint8_t key[NTP_SIV_KEY_LEN];
+    uint32_t id = 0;
+    String value = server->arg("NTS_KEY");
+    if( server->hasArg("NTS_KEY_ID") && server->arg("NTS_KEY_ID") != NULL ) {
+      id = strtoul(server->arg("NTS_KEY_ID").c_str(), NULL, 10);
+    }
+    if( (id == 0) || (id == conf.keyid) || ( value.length() != (2 * NTP_SIV_KEY_LEN) ) ){
+      server->send(200);
+      return;
+    }
+    for(uint8_t i=0;i<NTP_SIV_KEY_LEN;i++){
+      char* end = NULL;
+      String digits = value.substring(2*i, 2*i+2);
+      key[i] = strtoul(digits.c_str(), &end, 16);
+      if( (end == NULL) || (*end != '\0') ){
+        server->send(200);
+        return;
+      }
+    }
+    conf.prev_keyid = conf.keyid;
+    memcpy(conf.prev_key, conf.key, sizeof(conf.prev_key));
+    conf.keyid = id;
+    memcpy(conf.key, key, sizeof(conf.key));
+  }
+
+  write_nts_config(conf);
+  NTPServer.SetNTS(&conf);
+  server->send(200);
+}
+
+/**************************************************************************************************
+*    Function      : send_roughtime_settings
+*    Description   : Sends the roughtime settings, public key and counters as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : The public key is base64 encoded as roughtime clients expect it
+**************************************************************************************************/
+void send_roughtime_settings( void ){
+  roughtime_settings_t conf = read_roughtime_config();
+  roughtime_stats_t stats = Roughtime.GetStats();
+  uint8_t pubkey[ROUGHTIME_PUBKEY_LEN];
+  Roughtime.GetPublicKey(pubkey);
+  String response ="";
+  const size_t capacity = JSON_OBJECT_SIZE(5) + JSON_OBJECT_SIZE(4) + 64;
+  DynamicJsonDocument  root(capacity);
+
+  root["enabled"] = conf.enabled;
+  root["window"] = conf.window;
+  root["batch"] = conf.batch;
+  root["pubkey"] = base64::encode(pubkey, sizeof(pubkey));
+  JsonObject rt_stats = root.createNestedObject("stats");
+  rt_stats["requests"] = stats.requests;
+  rt_stats["responses"] = stats.responses;
+  rt_stats["batches"] = stats.batches;
+  rt_stats["dropped"] = stats.dropped;
+  serializeJson(root, response);
+  sendData(response);
+}
+
+/**************************************************************************************************
+*    Function      : update_roughtime_settings
+*    Description   : Updates the roughtime settings from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : RT_WINDOW is in milliseconds, RT_NEWKEY creates a new long term key
+**************************************************************************************************/
+void update_roughtime_settings( void ){
+  roughtime_settings_t conf = read_roughtime_config();
+
+  if( ! server->hasArg("RT_ENABLED") || server->arg("RT_ENABLED") == NULL ) {
+    conf.enabled = false;
+  } else {
+    conf.enabled = ( server->arg("RT_ENABLED") == "true" );
+  }
+
+  if( server->hasArg("RT_WINDOW") && server->arg("RT_WINDOW") != NULL ) {
+    int32_t window = server->arg("RT_WINDOW").toInt();
+    if( (window >= 0) && (window <= ROUGHTIME_WINDOW_MAX) ){
+      conf.window = window;
+    }
+  }
+
+  if( server->hasArg("RT_BATCH") && server->arg("RT_BATCH") != NULL ) {
+    int32_t batch = server->arg("RT_BATCH").toInt();
+    if( (batch >= 1) && (batch <= ROUGHTIME_BATCH_MAX) ){
+      conf.batch = batch;
+    }
+  }
+
+  if( server->hasArg("RT_NEWKEY") && ( server->arg("RT_NEWKEY") == "true" ) ) {
+    RoughtimeServer::NewKey(&conf);
+  }
+
+  write_roughtime_config(conf);
+  Roughtime.SetConfig(&conf);
+  server->send(200);
+}
@@ -118,4 +118,211 @@ void update_ipv4_settings( void );
 **************************************************************************************************/ 
 void getipv4settings_settings( void );
 
+/**************************************************************************************************
+*    Function      : send_softap_settings
+*    Description   : Sends the access point settings as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : The passphrase is never sent
+**************************************************************************************************/
+void send_softap_settings( void );
+
+/**************************************************************************************************
+*    Function      : update_softap_settings
+*    Description   : Updates the access point settings from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : Applied after a restart
+**************************************************************************************************/
+void update_softap_settings( void );
+
+/**************************************************************************************************
+*    Function      : send_ntp_status
+*    Description   : Sends the ntp server counters as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_ntp_status( void );
+
+/**************************************************************************************************
+*    Function      : send_ntp_latency
+*    Description   : Sends the latency histograms of the packet path as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_ntp_latency( void );
+
+/**************************************************************************************************
+*    Function      : reset_ntp_latency
+*    Description   : Clears the latency histograms of the packet path
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void reset_ntp_latency( void );
+
+/**************************************************************************************************
+*    Function      : send_ntp_servo
+*    Description   : Sends the state of the timebase servo as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_ntp_servo( void );
+
+/**************************************************************************************************
+*    Function      : send_ntp_holdover
+*    Description   : Sends the holdover prediction and the learned curve as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_ntp_holdover( void );
+
+/**************************************************************************************************
+*    Function      : send_ntp_txcal
+*    Description   : Sends the transmit delays and the state of the calibration as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_ntp_txcal( void );
+
+/**************************************************************************************************
+*    Function      : update_ntp_txcal
+*    Description   : Starts or stops a transmit calibration or switches the correction on or off
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void update_ntp_txcal( void );
+
+/**************************************************************************************************
+*    Function      : send_ntp_ratelimit_settings
+*    Description   : Sends the ntp rate limit settings as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_ntp_ratelimit_settings( void );
+
+/**************************************************************************************************
+*    Function      : update_ntp_ratelimit_settings
+*    Description   : Updates the ntp rate limit settings from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void update_ntp_ratelimit_settings( void );
+
+/**************************************************************************************************
+*    Function      : send_ntp_clients
+*    Description   : Sends a page of the ntp client list as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : Arguments are page and size
+**************************************************************************************************/
+void send_ntp_clients( void );
+
+/**************************************************************************************************
+*    Function      : send_ntp_census
+*    Description   : Sends the census of the client clocks as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_ntp_census( void );
+
+/**************************************************************************************************
+*    Function      : send_ntp_broadcast_settings
+*    Description   : Sends the ntp broadcast settings as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_ntp_broadcast_settings( void );
+
+/**************************************************************************************************
+*    Function      : update_ntp_broadcast_settings
+*    Description   : Updates the ntp broadcast settings from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void update_ntp_broadcast_settings( void );
+
+/**************************************************************************************************
+*    Function      : send_ntp_keys
+*    Description   : Sends the ntp key table as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : The key values are never sent
+**************************************************************************************************/
+void send_ntp_keys( void );
+
+/**************************************************************************************************
+*    Function      : update_ntp_key
+*    Description   : Updates a slot of the ntp key table from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void update_ntp_key( void );
+
+/**************************************************************************************************
+*    Function      : send_leap_settings
+*    Description   : Sends the leap second announcement as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_leap_settings( void );
+
+/**************************************************************************************************
+*    Function      : update_leap_settings
+*    Description   : Updates the leap second announcement from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void update_leap_settings( void );
+
+/**************************************************************************************************
+*    Function      : send_nts_settings
+*    Description   : Sends the nts settings as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : The master keys are never sent
+**************************************************************************************************/
+void send_nts_settings( void );
+
+/**************************************************************************************************
+*    Function      : update_nts_settings
+*    Description   : Updates the nts settings from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : Arguments are NTS_ENABLED, NTS_ROTATE, NTS_KEY_ID and NTS_KEY
+**************************************************************************************************/
+void update_nts_settings( void );
+
+/**************************************************************************************************
+*    Function      : send_roughtime_settings
+*    Description   : Sends the roughtime settings, public key and counters as json
+*    Input         : none
+*    Output        : none
+*    Remarks       : none
+**************************************************************************************************/
+void send_roughtime_settings( void );
+
+/**************************************************************************************************
+*    Function      : update_roughtime_settings
+*    Description   : Updates the roughtime settings from web
+*    Input         : none
+*    Output        : none
+*    Remarks       : Arguments are RT_ENABLED, RT_WINDOW, RT_BATCH and RT_NEWKEY
+**************************************************************************************************/
+void update_roughtime_settings( void );
+
 #endif
@@ -0,0 +1,201 @@
+/*
+ * Symmetric key MACs. AES-CMAC against the vectors of RFC 4493, the MD5 and
+ * SHA1 digests of ntpd, taken over key and packet, against known values. Signed
+ * requests through the responder and the crypto-NAK for a bad MAC.
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include "ntp_auth.h"
+#include "ntp_cmac.h"
+#include "ntp_packet.h"
+#include "ntp_responder.h"
+
+/* RFC 4493 4., key and message */
+static const char* rfc4493_key = "2b7e151628aed2a6abf7158809cf4f3c";
+static const char* rfc4493_msg = "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+                                 "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+
+static NTP_KeyTable* table;
+static ntp_keys_settings_t conf;
+
+static void hex( const char* s, uint8_t* out ){
+  for(uint16_t i=0;s[2*i]!=0;i++){
+    sscanf(&s[2*i], "%2hhx", &out[i]);
+  }
+}
+
+/* A 48 byte packet that is not a valid request, the digests are known for it */
+static void vector_packet( uint8_t* pkt ){
+  memset(pkt, 0x5A, NTP_HEADER_LEN);
+  pkt[0] = 0x23;
+}
+
+static ntp_timestamp_t fixed_time( void ){
+  ntp_timestamp_t t = { 3900000000u, 0x80000000u };
+  return t;
+}
+
+void setUp( void ){
+  table = new NTP_KeyTable();
+  conf = NTP_KeyTable::GetDefaultConfig();
+  conf.keys[0].id = 1;
+  conf.keys[0].type = NTP_KEY_AES128CMAC;
+  conf.keys[0].len = NTP_KEY_AES128_LEN;
+  hex(rfc4493_key, conf.keys[0].key);
+  conf.keys[1].id = 7;
+  conf.keys[1].type = NTP_KEY_MD5;
+  conf.keys[1].len = 5;
+  memcpy(conf.keys[1].key, "hello", 5);
+  conf.keys[2].id = 9;
+  conf.keys[2].type = NTP_KEY_SHA1;
+  conf.keys[2].len = 20;
+  memset(conf.keys[2].key, 0x11, 20);
+  /* Not a valid AES-128 key, it is left out */
+  conf.keys[3].id = 10;
+  conf.keys[3].type = NTP_KEY_AES128CMAC;
+  conf.keys[3].len = 5;
+  table->Load(&conf);
+}
+
+void tearDown( void ){
+  delete table;
+}
+
+/* RFC 4493 2.4, the subkeys of the example key */
+void test_cmac_subkeys( void ){
+  ntp_cmac_key_t key;
+  uint8_t raw[16];
+  uint8_t k1[16];
+  uint8_t k2[16];
+  hex(rfc4493_key, raw);
+  hex("fbeed618357133667c85e08f7236a8de", k1);
+  hex("f7ddac306ae266ccf90bc11ee46d513b", k2);
+  ntp_cmac_setkey(&key, raw);
+  TEST_ASSERT_EQUAL_MEMORY(k1, key.k1, 16);
+  TEST_ASSERT_EQUAL_MEMORY(k2, key.k2, 16);
+  ntp_cmac_free(&key);
+}
+
+/* RFC 4493 4., the four examples, signed through the key table */
+void test_cmac_rfc4493( void ){
+  const uint16_t lens[] = { 0, 16, 40, 64 };
+  const char* tags[] = { "bb1d6929e95937287fa37d129b756746", "070a16b46b4d4144f79bdd9dd04a287c",
+                         "dfa66747de9ae63030ca32611497c827", "51f0bebf7e3b9d92fc49741779363cfe" };
+  uint8_t msg[64];
+  hex(rfc4493_msg, msg);
+  int8_t slot = table->Find(1);
+  TEST_ASSERT_EQUAL_INT8(0, slot);
+  for(uint8_t i=0;i<4;i++){
+    uint8_t buf[64 + NTP_MAC_MAX_LEN];
+    uint8_t tag[16];
+    hex(tags[i], tag);
+    memcpy(buf, msg, lens[i]);
+    uint16_t n = table->Sign(slot, buf, lens[i]);
+    TEST_ASSERT_EQUAL_UINT16(4 + 16, n);
+    TEST_ASSERT_EQUAL_UINT32(1, ntohl(*(uint32_t*)&buf[lens[i]]));
+    TEST_ASSERT_EQUAL_MEMORY(tag, &buf[lens[i] + 4], 16);
+    TEST_ASSERT_TRUE(table->Verify(slot, buf, lens[i], &buf[lens[i]], n));
+  }
+  /* The incremental interface with odd pieces gives the same tag */
+  ntp_cmac_key_t key;
+  ntp_cmac_ctx_t ctx;
+  uint8_t raw[16];
+  uint8_t tag[16];
+  uint8_t ref[16];
+  hex(rfc4493_key, raw);
+  hex(tags[2], ref);
+  ntp_cmac_setkey(&key, raw);
+  ntp_cmac_start(&ctx, &key);
+  ntp_cmac_update(&ctx, msg, 7);
+  ntp_cmac_update(&ctx, &msg[7], 16);
+  ntp_cmac_update(&ctx, &msg[23], 17);
+  ntp_cmac_finish(&ctx, tag);
+  TEST_ASSERT_EQUAL_MEMORY(ref, tag, 16);
+  ntp_cmac_free(&key);
+}
+
+/* MD5 over key and packet, as ntpd does */
+void test_md5_vector( void ){
+  uint8_t pkt[NTP_HEADER_LEN + NTP_MAC_MAX_LEN];
+  uint8_t ref[16];
+  vector_packet(pkt);
+  hex("34d1da054b3807373105a9d422f2bc1d", ref);
+  int8_t slot = table->Find(7);
+  TEST_ASSERT_EQUAL_INT8(1, slot);
+  uint16_t n = table->Sign(slot, pkt, NTP_HEADER_LEN);
+  TEST_ASSERT_EQUAL_UINT16(NTP_MAC_MIN_LEN, n);
+  TEST_ASSERT_EQUAL_MEMORY(ref, &pkt[NTP_HEADER_LEN + 4], 16);
+  TEST_ASSERT_TRUE(table->Verify(slot, pkt, NTP_HEADER_LEN, &pkt[NTP_HEADER_LEN], n));
+  /* Signing again starts from the hashed key, not from the last packet */
+  table->Sign(slot, pkt, NTP_HEADER_LEN);
+  TEST_ASSERT_EQUAL_MEMORY(ref, &pkt[NTP_HEADER_LEN + 4], 16);
+  /* One bit of the packet changed */
+  pkt[10] ^= 1;
+  TEST_ASSERT_FALSE(table->Verify(slot, pkt, NTP_HEADER_LEN, &pkt[NTP_HEADER_LEN], n));
+}
+
+/* SHA1 over key and packet, the digest is 20 bytes */
+void test_sha1_vector( void ){
+  uint8_t pkt[NTP_HEADER_LEN + NTP_MAC_MAX_LEN];
+  uint8_t ref[20];
+  vector_packet(pkt);
+  hex("c6ac1be02723eee8cecfeb4eda17c1c345672d53", ref);
+  int8_t slot = table->Find(9);
+  TEST_ASSERT_EQUAL_INT8(2, slot);
+  uint16_t n = table->Sign(slot, pkt, NTP_HEADER_LEN);
+  TEST_ASSERT_EQUAL_UINT16(NTP_MAC_MAX_LEN, n);
+  TEST_ASSERT_EQUAL_MEMORY(ref, &pkt[NTP_HEADER_LEN + 4], 20);
+  TEST_ASSERT_TRUE(table->Verify(slot, pkt, NTP_HEADER_LEN, &pkt[NTP_HEADER_LEN], n));
+  /* A MAC cut to the MD5 length does not pass */
+  TEST_ASSERT_FALSE(table->Verify(slot, pkt, NTP_HEADER_LEN, &pkt[NTP_HEADER_LEN], NTP_MAC_MIN_LEN));
+}
+
+/* Keys that are not valid are not loaded, unknown ids are not found */
+void test_key_table( void ){
+  TEST_ASSERT_EQUAL_INT8(-1, table->Find(10));
+  TEST_ASSERT_EQUAL_INT8(-1, table->Find(2));
+  TEST_ASSERT_EQUAL_INT8(-1, table->Find(0));
+  TEST_ASSERT_FALSE(NTP_KeyTable::IsValid(&conf.keys[3]));
+  TEST_ASSERT_EQUAL_UINT8(20, NTP_KeyTable::DigestLength(NTP_KEY_SHA1));
+}
+
+/* A signed request gets a signed response, a bad MAC a crypto-NAK */
+void test_responder_signed( void ){
+  NTP_Responder* responder = new NTP_Responder();
+  responder->SetClock(fixed_time, NULL);
+  responder->SetKeys(&conf);
+  ntp_client_t client = NTP_Responder::ClientV4(htonl(0x0A000001u));
+  uint8_t req[NTP_HEADER_LEN + NTP_MAC_MAX_LEN];
+  uint8_t out[NTP_PACKET_MAX_LEN];
+  ntp_packet_info_t info;
+  memset(req, 0, sizeof(req));
+  req[0] = ( 4 << 3 ) | 3;
+  req[43] = 1;
+  uint16_t mac_len = table->Sign(table->Find(9), req, NTP_HEADER_LEN);
+  uint16_t len = responder->Respond(&client, req, NTP_HEADER_LEN + mac_len, out, fixed_time(), 0);
+  TEST_ASSERT_EQUAL_UINT16(NTP_HEADER_LEN + NTP_MAC_MAX_LEN, len);
+  TEST_ASSERT_TRUE(ntp_parse_packet(out, len, &info));
+  TEST_ASSERT_EQUAL_UINT32(9, info.keyid);
+  TEST_ASSERT_TRUE(table->Verify(table->Find(9), out, NTP_HEADER_LEN, &out[info.mac_offset], info.mac_len));
+  TEST_ASSERT_EQUAL_UINT32(1, responder->GetStats().authenticated);
+
+  req[20] ^= 1;
+  len = responder->Respond(&client, req, NTP_HEADER_LEN + mac_len, out, fixed_time(), 0);
+  TEST_ASSERT_EQUAL_UINT16(NTP_HEADER_LEN + NTP_CRYPTO_NAK_LEN, len);
+  TEST_ASSERT_EQUAL_UINT32(0, *(uint32_t*)&out[NTP_HEADER_LEN]);
+  TEST_ASSERT_EQUAL_UINT32(1, responder->GetStats().authfailed);
+  delete responder;
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_cmac_subkeys);
+  RUN_TEST(test_cmac_rfc4493);
+  RUN_TEST(test_md5_vector);
+  RUN_TEST(test_sha1_vector);
+  RUN_TEST(test_key_table);
+  RUN_TEST(test_responder_signed);
+  return UNITY_END();
+}
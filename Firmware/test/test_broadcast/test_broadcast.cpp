@@ -0,0 +1,167 @@
+/*
+ * Broadcast mode. The broadcast task is woken by every second tick and asks
+ * ntp_broadcast_due with the second it reads, a fake clock stands in for the
+ * tick with the task waking late. Packets of other servers are not answered.
+ */
+#include <unity.h>
+#include <string.h>
+#include <random>
+#include <arpa/inet.h>
+#include "ntp_broadcast.h"
+#include "ntp_responder.h"
+
+/* Time of the fake clock, the tick comes at the start of every second */
+static ntp_time64_t fake_now;
+static std::mt19937 rng;
+
+typedef struct {
+  uint32_t sent;
+  uint32_t off_boundary;
+  uint32_t wrong_gap;
+  uint32_t last;
+} cadence_t;
+
+void setUp( void ){
+  rng.seed(3);
+}
+
+void tearDown( void ){
+}
+
+static ntp_timestamp_t fake_read_time( void ){
+  return ntp_time64_to_timestamp(fake_now);
+}
+
+/* The task for one tick, wakes after latency and sends if the second read is due */
+static void fake_task( const broadcast_settings_t* conf, const ntp_packet_t* tmpl, uint32_t latency, cadence_t* c ){
+  ntp_packet_t pkt;
+  ntp_time64_t wake = fake_now + ( ( (uint64_t)latency << 32 ) / 1000000 );
+  if(false == ntp_broadcast_due(conf, ntp_time64_seconds(wake))){
+    return;
+  }
+  ntp_build_broadcast(&pkt, tmpl, conf->poll);
+  ntp_stamp_transmit(&pkt, wake);
+  uint32_t sent = ntohl(pkt.txTm_s);
+  uint32_t interval = 1UL << conf->poll;
+  if( 0 != ( sent % interval ) ){
+    c->off_boundary++;
+  }
+  if( (c->sent > 0) && ( ( sent - c->last ) != interval ) ){
+    c->wrong_gap++;
+  }
+  c->last = sent;
+  c->sent++;
+}
+
+/* Runs the fake clock for seconds ticks from start, the task wakes up to 900ms late */
+static cadence_t run_ticks( const broadcast_settings_t* conf, uint32_t start, uint32_t seconds ){
+  cadence_t c;
+  ntp_packet_t tmpl;
+  ntp_server_state_t state;
+  memset(&c, 0, sizeof(c));
+  memset(&state, 0, sizeof(state));
+  state.stratum = 1;
+  memcpy(state.refid, "GPS", 4);
+  ntp_build_template(&tmpl, &state);
+  fake_now = ntp_time64_make(start, 0);
+  for(uint32_t i=0;i<seconds;i++){
+    fake_task(conf, &tmpl, rng() % 900000, &c);
+    fake_now += NTP_TIME64_SECOND;
+  }
+  return c;
+}
+
+/* Every 2^poll seconds, on the boundary of the interval */
+void test_cadence_aligned( void ){
+  broadcast_settings_t conf = ntp_broadcast_default_config();
+  conf.broadcast = true;
+  cadence_t c = run_ticks(&conf, 3900000007u, 64 * 100);
+  TEST_ASSERT_EQUAL_UINT32(100, c.sent);
+  TEST_ASSERT_EQUAL_UINT32(0, c.off_boundary);
+  TEST_ASSERT_EQUAL_UINT32(0, c.wrong_gap);
+}
+
+/* The interval is kept within its limits */
+void test_poll_limits( void ){
+  broadcast_settings_t conf = ntp_broadcast_default_config();
+  conf.multicast = true;
+  conf.poll = 2;
+  cadence_t c = run_ticks(&conf, 3900000000u, 160);
+  TEST_ASSERT_EQUAL_UINT32(160 >> NTP_BROADCAST_POLL_MIN, c.sent);
+  TEST_ASSERT_EQUAL_UINT32(0, c.off_boundary);
+  conf.poll = 14;
+  c = run_ticks(&conf, 3900000000u, 4096);
+  TEST_ASSERT_EQUAL_UINT32(4096 >> NTP_BROADCAST_POLL_MAX, c.sent);
+}
+
+/* Switched off nothing is sent */
+void test_disabled( void ){
+  broadcast_settings_t conf = ntp_broadcast_default_config();
+  cadence_t c = run_ticks(&conf, 3900000000u, 1024);
+  TEST_ASSERT_EQUAL_UINT32(0, c.sent);
+}
+
+/* The second counter wraps in 2036, the interval divides the era so the cadence holds */
+void test_cadence_era_change( void ){
+  broadcast_settings_t conf = ntp_broadcast_default_config();
+  conf.broadcast = true;
+  cadence_t c = run_ticks(&conf, 0xFFFFFFFFu - 300, 600);
+  TEST_ASSERT_TRUE(c.sent >= 9);
+  TEST_ASSERT_EQUAL_UINT32(0, c.off_boundary);
+  TEST_ASSERT_EQUAL_UINT32(0, c.wrong_gap);
+}
+
+/* A broadcast packet carries mode 5, the interval and only the transmit time */
+void test_broadcast_packet( void ){
+  ntp_packet_t tmpl;
+  ntp_packet_t pkt;
+  ntp_server_state_t state;
+  memset(&state, 0, sizeof(state));
+  state.stratum = 1;
+  memcpy(state.refid, "GPS", 4);
+  ntp_build_template(&tmpl, &state);
+  ntp_build_broadcast(&pkt, &tmpl, 6);
+  TEST_ASSERT_EQUAL_UINT8(5, pkt.flags.mode);
+  TEST_ASSERT_EQUAL_UINT8(4, pkt.flags.vn);
+  TEST_ASSERT_EQUAL_UINT8(6, pkt.poll);
+  TEST_ASSERT_EQUAL_UINT8(1, pkt.stratum);
+  TEST_ASSERT_EQUAL_UINT32(0, pkt.origTm_s);
+  TEST_ASSERT_EQUAL_UINT32(0, pkt.rxTm_s);
+}
+
+/* Only mode 3 is answered, a broadcast or server packet leaves no trace */
+void test_only_client_requests( void ){
+  NTP_Responder* responder = new NTP_Responder();
+  responder->SetClock(fake_read_time, NULL);
+  fake_now = ntp_time64_make(3900000000u, 0);
+  ntp_client_t client = NTP_Responder::ClientV4(htonl(0x0A000001u));
+  ntp_packet_t req;
+  uint8_t out[NTP_PACKET_MAX_LEN];
+  memset(&req, 0, sizeof(req));
+  req.flags.vn = 4;
+  const uint8_t modes[] = { 0, 1, 2, 4, 5, 7 };
+  for(uint8_t i=0;i<sizeof(modes);i++){
+    req.flags.mode = modes[i];
+    TEST_ASSERT_EQUAL_UINT16(0, responder->Respond(&client, (const uint8_t*)&req, sizeof(req), out, fake_read_time(), 0));
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, responder->GetStats().requests);
+  TEST_ASSERT_EQUAL_UINT16(0, responder->GetClientCount());
+  TEST_ASSERT_EQUAL_UINT32(0, responder->GetRateLimitStats().misses);
+  TEST_ASSERT_EQUAL_UINT32(0, responder->GetCensus().clients);
+  req.flags.mode = 3;
+  TEST_ASSERT_EQUAL_UINT16(sizeof(ntp_packet_t), responder->Respond(&client, (const uint8_t*)&req, sizeof(req), out, fake_read_time(), 0));
+  TEST_ASSERT_EQUAL_UINT32(1, responder->GetStats().requests);
+  TEST_ASSERT_EQUAL_UINT16(1, responder->GetClientCount());
+  delete responder;
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_cadence_aligned);
+  RUN_TEST(test_poll_limits);
+  RUN_TEST(test_disabled);
+  RUN_TEST(test_cadence_era_change);
+  RUN_TEST(test_broadcast_packet);
+  RUN_TEST(test_only_client_requests);
+  return UNITY_END();
+}
@@ -0,0 +1,118 @@
+/*
+ * Dual-stack transport. NTP_PosixServer binds one AF_INET6 socket with
+ * IPV6_V6ONLY off, requests to 127.0.0.1 and to ::1 are both answered from it.
+ * IPv4 clients arrive as mapped addresses and are counted as IPv4.
+ */
+#include <unity.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "ntp_posix.h"
+
+#define TEST_PORT ( 12124 )
+#define TEST_REQUESTS ( 10 )
+#define TEST_TIMEOUT_MS ( 1000 )
+
+static NTP_PosixServer* server;
+
+static ntp_timestamp_t host_time( void ){
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  ntp_timestamp_t t;
+  t.seconds = (uint32_t)( ts.tv_sec + NTP_TIMESTAMP_DELTA );
+  t.fraction = (uint32_t)( ( (uint64_t)ts.tv_nsec << 32 ) / 1000000000ull );
+  return t;
+}
+
+void setUp( void ){
+  ntp_server_state_t state;
+  ratelimit_settings_t rl = NTP_RateLimiter::GetDefaultConfig();
+  memset(&state, 0, sizeof(state));
+  state.stratum = 1;
+  state.precision = -20;
+  memcpy(state.refid, "GPS", 4);
+  rl.enabled = false;
+  server = new NTP_PosixServer();
+  TEST_ASSERT_TRUE(server->begin(TEST_PORT, 1, host_time, NULL));
+  server->SetRateLimit(rl);
+  server->UpdateServerState(state);
+}
+
+void tearDown( void ){
+  server->end();
+  delete server;
+}
+
+/* Sends requests one at a time to the address, returns the valid responses */
+static uint32_t exchange( int family, const struct sockaddr* to, socklen_t to_len ){
+  uint32_t answered = 0;
+  int fd = socket(family, SOCK_DGRAM, 0);
+  TEST_ASSERT_TRUE(fd >= 0);
+  for(uint32_t i=0;i<TEST_REQUESTS;i++){
+    ntp_packet_t req;
+    ntp_packet_t resp;
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    memset(&req, 0, sizeof(req));
+    req.flags.vn = 4;
+    req.flags.mode = 3;
+    req.txTm_s = htonl(0x12345678u);
+    req.txTm_f = htonl(i);
+    TEST_ASSERT_EQUAL(sizeof(req), sendto(fd, &req, sizeof(req), 0, to, to_len));
+    if(poll(&pfd, 1, TEST_TIMEOUT_MS) <= 0){
+      continue;
+    }
+    if( (sizeof(resp) == recv(fd, &resp, sizeof(resp), 0)) && (resp.flags.mode == 4) && (resp.stratum == 1) &&
+        (resp.origTm_s == req.txTm_s) && (resp.origTm_f == req.txTm_f) ){
+      answered++;
+    }
+  }
+  close(fd);
+  return answered;
+}
+
+static uint32_t exchange_v4( void ){
+  struct sockaddr_in to;
+  memset(&to, 0, sizeof(to));
+  to.sin_family = AF_INET;
+  to.sin_port = htons(TEST_PORT);
+  to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  return exchange(AF_INET, (const struct sockaddr*)&to, sizeof(to));
+}
+
+static uint32_t exchange_v6( const char* addr ){
+  struct sockaddr_in6 to;
+  memset(&to, 0, sizeof(to));
+  to.sin6_family = AF_INET6;
+  to.sin6_port = htons(TEST_PORT);
+  TEST_ASSERT_EQUAL(1, inet_pton(AF_INET6, addr, &to.sin6_addr));
+  return exchange(AF_INET6, (const struct sockaddr*)&to, sizeof(to));
+}
+
+/* Both families on the same port and socket, each counted as what it is */
+void test_both_families( void ){
+  TEST_ASSERT_EQUAL_UINT32(TEST_REQUESTS, exchange_v4());
+  TEST_ASSERT_EQUAL_UINT32(TEST_REQUESTS, exchange_v6("::1"));
+  ntp_server_stats_t stats = server->GetStats(0);
+  TEST_ASSERT_EQUAL_UINT32(2 * TEST_REQUESTS, stats.requests);
+  TEST_ASSERT_EQUAL_UINT32(TEST_REQUESTS, stats.requests_v4);
+  TEST_ASSERT_EQUAL_UINT32(TEST_REQUESTS, stats.requests_v6);
+}
+
+/* An IPv6 socket sending to a mapped IPv4 address is an IPv4 client */
+void test_mapped_address( void ){
+  TEST_ASSERT_EQUAL_UINT32(TEST_REQUESTS, exchange_v6("::ffff:127.0.0.1"));
+  ntp_server_stats_t stats = server->GetStats(0);
+  TEST_ASSERT_EQUAL_UINT32(TEST_REQUESTS, stats.requests_v4);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.requests_v6);
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_both_families);
+  RUN_TEST(test_mapped_address);
+  return UNITY_END();
+}
@@ -0,0 +1,210 @@
+/*
+ * Holdover prediction. A crystal with a parabolic frequency over temperature,
+ * 35ppb/°C² around its turnover at 25°C, is learned into the bins of the curve
+ * and predicted from them. Between learned bins the curve is interpolated, with
+ * only one side learned its value is held, without a temperature or a curve the
+ * prediction falls back to the last locked frequency with a wider uncertainty.
+ * The curve is handed out for storage as NTP_HOLDOVER_SAVE_SAMPLES asks.
+ */
+#include <unity.h>
+#include <stdio.h>
+#include "ntp_holdover.h"
+
+/* Frequency of the crystal at the turnover and its curvature */
+#define XTAL_PPB ( 20000 )
+#define XTAL_CURVE ( -35 )
+#define XTAL_TURNOVER ( 25 * 4 )
+
+static NTP_Holdover* holdover;
+
+/* ppb the crystal runs fast at a temperature in 1/4 °C */
+static int32_t xtal_ppb( int16_t temperature ){
+  int32_t d = temperature - XTAL_TURNOVER;
+  return XTAL_PPB + ( ( XTAL_CURVE * d * d ) / 16 );
+}
+
+/* Learns from from_c to to_c °C in the 1/4 °C steps of the sensor, samples around the crystal curve */
+static void learn_range( int16_t from_c, int16_t to_c, uint8_t samples ){
+  for(int16_t t=from_c * 4;t<=to_c * 4;t++){
+    for(uint8_t i=0;i<samples;i++){
+      /* The servo reads a few ppb off, alternately */
+      holdover->Learn(t, xtal_ppb(t) + ( ( i & 1 ) ? 5 : -5 ));
+    }
+  }
+}
+
+void setUp( void ){
+  holdover = new NTP_Holdover();
+}
+
+void tearDown( void ){
+  delete holdover;
+}
+
+/* A bin is used from NTP_HOLDOVER_MIN_SAMPLES on and then follows a running average */
+void test_bin_learning( void ){
+  int16_t t = 25 * 4;
+  int8_t bin = ( t - ( NTP_HOLDOVER_TEMP_MIN * 4 ) ) / ( NTP_HOLDOVER_BIN_WIDTH * 4 );
+  for(uint8_t i=0;i<NTP_HOLDOVER_MIN_SAMPLES - 1;i++){
+    holdover->Learn(t, 1000 + ( ( i & 1 ) ? 40 : 0 ));
+  }
+  TEST_ASSERT_EQUAL_UINT8(0, holdover->GetStatus().bins);
+  holdover->Learn(t, 1040);
+  TEST_ASSERT_EQUAL_UINT8(1, holdover->GetStatus().bins);
+  ntp_holdover_bin_t b = holdover->GetCurve().bins[bin];
+  TEST_ASSERT_EQUAL_UINT16(NTP_HOLDOVER_MIN_SAMPLES, b.samples);
+  TEST_ASSERT_INT32_WITHIN(2, 1020, b.frequency);
+  TEST_ASSERT_INT32_WITHIN(2, 20, b.deviation);
+  /* Full, the bin follows aging of the crystal */
+  for(uint16_t i=0;i<10 * NTP_HOLDOVER_AVERAGE;i++){
+    holdover->Learn(t, 1500);
+  }
+  b = holdover->GetCurve().bins[bin];
+  TEST_ASSERT_EQUAL_UINT16(NTP_HOLDOVER_AVERAGE, b.samples);
+  TEST_ASSERT_INT32_WITHIN(NTP_HOLDOVER_AVERAGE, 1500, b.frequency);
+  /* Out of the bins, nothing is learned */
+  holdover->Learn(( NTP_HOLDOVER_TEMP_MIN * 4 ) - 1, 0);
+  holdover->Learn(( NTP_HOLDOVER_TEMP_MIN + ( NTP_HOLDOVER_BINS * NTP_HOLDOVER_BIN_WIDTH ) ) * 4, 0);
+  TEST_ASSERT_EQUAL_UINT8(1, holdover->GetStatus().bins);
+  TEST_ASSERT_EQUAL_UINT16(0, holdover->GetCurve().bins[0].samples);
+  TEST_ASSERT_EQUAL_UINT16(0, holdover->GetCurve().bins[NTP_HOLDOVER_BINS - 1].samples);
+}
+
+/* Between two learned bins the curve is interpolated, an offset of the whole curve cancels out */
+void test_interpolation( void ){
+  /* Bin centers at 21°C and 29°C, nothing in between */
+  int16_t low = 21 * 4;
+  int16_t high = 29 * 4;
+  for(uint8_t i=0;i<NTP_HOLDOVER_MIN_SAMPLES;i++){
+    holdover->Learn(low, xtal_ppb(low));
+    holdover->Learn(high, 1000 + xtal_ppb(high));
+  }
+  /* The crystal aged by 300ppb since, the locked reference has it */
+  holdover->SetReference(true, low, xtal_ppb(low) + 300, 10);
+  holdover->Predict(true, 25 * 4);
+  ntp_holdover_status_t st = holdover->GetStatus();
+  TEST_ASSERT_TRUE(st.compensated);
+  /* Halfway between the bins, half the difference of the two */
+  int32_t expect = xtal_ppb(low) + 300 + ( ( 1000 + xtal_ppb(high) - xtal_ppb(low) ) / 2 );
+  TEST_ASSERT_INT32_WITHIN(1, expect, st.frequency);
+  TEST_ASSERT_EQUAL_UINT32(10 + NTP_HOLDOVER_FLOOR_PPB, st.uncertainty);
+  /* At the reference temperature the reference itself */
+  holdover->Predict(true, low);
+  TEST_ASSERT_EQUAL_INT32(xtal_ppb(low) + 300, holdover->GetFrequency());
+}
+
+/* A learned curve predicts the crystal within the uncertainty it gives */
+void test_learned_curve( void ){
+  char msg[120];
+  int32_t worst = 0;
+  learn_range(5, 45, 2);
+  holdover->SetReference(true, 25 * 4, xtal_ppb(25 * 4), 10);
+  for(int16_t t=10 * 4;t<=40 * 4;t++){
+    holdover->Predict(true, t);
+    /* At the reference temperature the reference is taken as it is */
+    TEST_ASSERT_TRUE( (t == 25 * 4) || (true == holdover->GetStatus().compensated) );
+    int32_t miss = holdover->GetFrequency() - xtal_ppb(t);
+    miss = ( miss < 0 ) ? -miss : miss;
+    worst = ( miss > worst ) ? miss : worst;
+    /* The spread of the samples within a bin goes into the uncertainty */
+    TEST_ASSERT_TRUE(holdover->GetUncertainty() >= 10 + NTP_HOLDOVER_FLOOR_PPB);
+    TEST_ASSERT_TRUE((uint32_t)miss <= holdover->GetUncertainty());
+  }
+  snprintf(msg, sizeof(msg), "10°C to 40°C predicted within %dppb, the crystal moves by %dppb",
+           worst, xtal_ppb(25 * 4) - xtal_ppb(10 * 4));
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(worst < 4 * NTP_HOLDOVER_FLOOR_PPB);
+}
+
+/* With one side learned its value is held, the uncertainty grows with the distance */
+void test_one_side( void ){
+  int16_t learned = 21 * 4;
+  for(uint8_t i=0;i<NTP_HOLDOVER_MIN_SAMPLES;i++){
+    holdover->Learn(learned, 1000);
+  }
+  holdover->SetReference(true, learned, 2000, 10);
+  holdover->Predict(true, 23 * 4);
+  ntp_holdover_status_t st = holdover->GetStatus();
+  TEST_ASSERT_TRUE(st.compensated);
+  TEST_ASSERT_EQUAL_INT32(2000, st.frequency);
+  TEST_ASSERT_EQUAL_UINT32(10 + NTP_HOLDOVER_FLOOR_PPB + ( 2 * NTP_HOLDOVER_SLOPE_PPB ), st.uncertainty);
+  /* Beyond NTP_HOLDOVER_REACH bins nothing is learned, the slope is assumed all the way */
+  holdover->Predict(true, 35 * 4);
+  st = holdover->GetStatus();
+  TEST_ASSERT_FALSE(st.compensated);
+  TEST_ASSERT_EQUAL_INT32(2000, st.frequency);
+  TEST_ASSERT_EQUAL_UINT32(10 + NTP_HOLDOVER_FLOOR_PPB + ( 14 * NTP_HOLDOVER_SLOPE_PPB ), st.uncertainty);
+}
+
+/* Without a temperature the last locked frequency is held, the error adds up per second */
+void test_uncompensated( void ){
+  holdover->Predict(false, 0);
+  TEST_ASSERT_FALSE(holdover->GetStatus().referenced);
+  TEST_ASSERT_EQUAL_INT32(0, holdover->GetFrequency());
+  TEST_ASSERT_EQUAL_UINT32(NTP_HOLDOVER_UNCOMP_PPB, holdover->GetUncertainty());
+  learn_range(20, 30, 2);
+  holdover->SetReference(true, 25 * 4, 20000, 10);
+  holdover->Predict(false, 0);
+  ntp_holdover_status_t st = holdover->GetStatus();
+  TEST_ASSERT_FALSE(st.compensated);
+  TEST_ASSERT_EQUAL_INT32(20000, st.frequency);
+  TEST_ASSERT_EQUAL_UINT32(10 + NTP_HOLDOVER_UNCOMP_PPB, st.uncertainty);
+  /* A reference without a temperature can't be compensated either */
+  holdover->SetReference(false, 0, 20000, 10);
+  holdover->Predict(true, 28 * 4);
+  TEST_ASSERT_FALSE(holdover->GetStatus().compensated);
+  TEST_ASSERT_EQUAL_UINT32(10 + NTP_HOLDOVER_UNCOMP_PPB, holdover->GetUncertainty());
+  /* ppb held for a second are ns */
+  for(uint16_t i=0;i<100;i++){
+    holdover->Second();
+  }
+  st = holdover->GetStatus();
+  TEST_ASSERT_EQUAL_UINT32(100, st.seconds);
+  TEST_ASSERT_EQUAL_UINT32(100 * ( 10 + NTP_HOLDOVER_UNCOMP_PPB ), st.error);
+  holdover->Edge();
+  TEST_ASSERT_EQUAL_UINT32(0, holdover->GetError());
+  TEST_ASSERT_EQUAL_UINT32(0, holdover->GetStatus().seconds);
+}
+
+/* Handed out when a bin becomes usable and after NTP_HOLDOVER_SAVE_SAMPLES samples */
+void test_save_trigger( void ){
+  ntp_holdover_settings_t out;
+  int16_t t = 25 * 4;
+  TEST_ASSERT_FALSE(holdover->TakeSettings(&out));
+  for(uint8_t i=0;i<NTP_HOLDOVER_MIN_SAMPLES - 1;i++){
+    holdover->Learn(t, 1000);
+  }
+  TEST_ASSERT_FALSE(holdover->TakeSettings(&out));
+  holdover->Learn(t, 1000);
+  TEST_ASSERT_TRUE(holdover->TakeSettings(&out));
+  TEST_ASSERT_FALSE(holdover->TakeSettings(&out));
+  /* More samples into a usable bin only count */
+  for(uint16_t i=0;i<NTP_HOLDOVER_SAVE_SAMPLES - 1;i++){
+    holdover->Learn(t, 1000);
+  }
+  TEST_ASSERT_FALSE(holdover->TakeSettings(&out));
+  holdover->Learn(t, 1000);
+  TEST_ASSERT_TRUE(holdover->TakeSettings(&out));
+  TEST_ASSERT_FALSE(holdover->TakeSettings(&out));
+  /* What is handed out starts the next holdover */
+  NTP_Holdover restored;
+  restored.Begin(&out);
+  TEST_ASSERT_EQUAL_UINT8(1, restored.GetStatus().bins);
+  ntp_holdover_settings_t curve = restored.GetCurve();
+  TEST_ASSERT_EQUAL_MEMORY(&out, &curve, sizeof(out));
+  /* A curve with more samples than we keep was not written by us */
+  out.bins[0].samples = NTP_HOLDOVER_AVERAGE + 1;
+  restored.Begin(&out);
+  TEST_ASSERT_EQUAL_UINT8(0, restored.GetStatus().bins);
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_bin_learning);
+  RUN_TEST(test_interpolation);
+  RUN_TEST(test_learned_curve);
+  RUN_TEST(test_one_side);
+  RUN_TEST(test_uncompensated);
+  RUN_TEST(test_save_trigger);
+  return UNITY_END();
+}
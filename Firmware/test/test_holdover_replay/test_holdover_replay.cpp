@@ -0,0 +1,152 @@
+/*
+ * Holdover over a temperature trace. trace_holdover.h is replayed second by
+ * second into NTP_ClockServo and NTP_Holdover as Timecore drives them: PPS
+ * edges or a look into the second to the servo, the temperature every
+ * NTP_HOLDOVER_SAMPLE_INTERVAL. The 40MHz timer runs at the frequency of the
+ * crystal in the trace. After 78 hours locked the PPS is lost for 12 hours,
+ * the time error at the end is compared for a prediction from the learned
+ * curve, one without a temperature and the seconds counted at the nominal
+ * rate as the Ticker did before the servo.
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include "ntp_servo.h"
+#include "ntp_holdover.h"
+#include "trace_holdover.h"
+
+#define SIM_NOMINAL ( 40000000u )
+#define SIM_LATENCY_NS ( 4000 )
+#define SIM_NS_PER_TICK ( 1e9 / SIM_NOMINAL )
+
+/* As TIMECORE_HOLDOVER_LEARN_TAU */
+#define SIM_LEARN_TAU ( NTP_SERVO_MAXTAU - 2 )
+
+typedef struct {
+  NTP_ClockServo servo;
+  NTP_Holdover holdover;
+  double ticks;          /* Timer value at the true second boundary */
+  double ticker;         /* Timer value the nominal seconds would have reached */
+  uint32_t rng;
+} sim_t;
+
+static sim_t* sim;
+
+/* xorshift32, the latency is the same on every run */
+static uint32_t sim_random( void ){
+  uint32_t x = sim->rng;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  sim->rng = x;
+  return x;
+}
+
+/* As Timecore::SampleTemperature */
+static void sim_sample( bool valid, int16_t temperature ){
+  ntp_servo_status_t status = sim->servo.GetStatus();
+  if(status.state == NTP_SERVO_LOCK){
+    sim->holdover.SetReference(valid, temperature, status.frequency, status.jitter >> status.tau);
+    if( (true == valid) && (status.tau >= SIM_LEARN_TAU) ){
+      sim->holdover.Learn(temperature, status.frequency);
+    }
+  }
+  sim->holdover.Predict(valid, temperature);
+  if( (status.state == NTP_SERVO_HOLD) && (true == sim->holdover.GetStatus().referenced) ){
+    sim->servo.SetHoldFrequency(sim->holdover.GetFrequency());
+  }
+}
+
+/* One second of a row, the ticker starts over at every edge */
+static void sim_second( uint32_t row ){
+  sim->ticks += SIM_NOMINAL * ( 1.0 + ( trace_holdover[row].ppb * 1e-9 ) );
+  sim->ticker += SIM_NOMINAL;
+  if(trace_holdover[row].pps != 0){
+    sim->ticker = sim->ticks;
+    double latency = (double)( sim_random() % SIM_LATENCY_NS ) / SIM_NS_PER_TICK;
+    sim->servo.Edge((uint64_t)( sim->ticks + latency ));
+    sim->holdover.Edge();
+  } else {
+    /* The caller looks some time into each second */
+    uint8_t seconds = sim->servo.Hold((uint64_t)( sim->ticks + ( 0.4 * SIM_NOMINAL ) ));
+    for(uint8_t i=0;i<seconds;i++){
+      sim->holdover.Second();
+    }
+  }
+}
+
+/* Replays the trace, returns the error of the servo at the end in ns */
+static double sim_replay( bool temperature ){
+  ntp_servo_settings_t conf = NTP_ClockServo::GetDefaultConfig();
+  sim->servo.Begin(SIM_NOMINAL, &conf);
+  for(uint32_t row=0;row<sizeof(trace_holdover) / sizeof(trace_holdover[0]);row++){
+    sim_sample(temperature, trace_holdover[row].temperature);
+    for(uint8_t s=0;s<TRACE_INTERVAL;s++){
+      sim_second(row);
+    }
+  }
+  TEST_ASSERT_EQUAL(NTP_SERVO_HOLD, sim->servo.GetState());
+  TEST_ASSERT_EQUAL_UINT32(0, sim->servo.GetStatus().steps);
+  return ( (double)sim->servo.GetPhase() - sim->ticks ) * SIM_NS_PER_TICK;
+}
+
+static double sim_ticker_error_ns( void ){
+  return ( sim->ticker - sim->ticks ) * SIM_NS_PER_TICK;
+}
+
+void setUp( void ){
+  sim = new sim_t;
+  sim->ticks = 12345.0;
+  sim->ticker = sim->ticks;
+  sim->rng = 0x12345678u;
+}
+
+void tearDown( void ){
+  delete sim;
+}
+
+/* The learned curve follows the crystal through the warm up, within the error it predicts */
+void test_curve( void ){
+  char msg[120];
+  double error = sim_replay(true);
+  ntp_holdover_status_t st = sim->holdover.GetStatus();
+  snprintf(msg, sizeof(msg), "12h with the curve: %.3fms, predicted %.3fms, %u bins learned",
+           error / 1e6, st.error / 1e6, st.bins);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(st.compensated);
+  TEST_ASSERT_EQUAL_UINT32(TRACE_HOLD_ROWS * TRACE_INTERVAL, st.seconds);
+  TEST_ASSERT_TRUE(fabs(error) < 1.5e6);
+  TEST_ASSERT_TRUE(fabs(error) < st.error);
+}
+
+/* Without a temperature the frequency of the morning is held all day */
+void test_no_temperature( void ){
+  char msg[120];
+  double error = sim_replay(false);
+  ntp_holdover_status_t st = sim->holdover.GetStatus();
+  snprintf(msg, sizeof(msg), "12h without temperature: %.3fms, predicted %.3fms", error / 1e6, st.error / 1e6);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_FALSE(st.compensated);
+  TEST_ASSERT_TRUE(fabs(error) > 30e6);
+  TEST_ASSERT_TRUE(fabs(error) < 80e6);
+}
+
+/* The seconds counted at the nominal rate carry the whole 11ppm of the crystal */
+void test_ticker( void ){
+  char msg[120];
+  double curve = sim_replay(true);
+  double error = sim_ticker_error_ns();
+  snprintf(msg, sizeof(msg), "12h at the nominal rate: %.3fms, with the curve %.3fms", error / 1e6, curve / 1e6);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(fabs(error) > 300e6);
+  TEST_ASSERT_TRUE(fabs(error) < 600e6);
+  TEST_ASSERT_TRUE(fabs(error) > 100 * fabs(curve));
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_curve);
+  RUN_TEST(test_no_temperature);
+  RUN_TEST(test_ticker);
+  return UNITY_END();
+}
@@ -0,0 +1,874 @@
+#ifndef TRACE_HOLDOVER_H_
+ #define TRACE_HOLDOVER_H_
+
+#include <stdint.h>
+
+/*
+ * 3.75 days of a DS3231 next to the timebase crystal, one row every
+ * TRACE_INTERVAL seconds. A row holds the temperature as the sensor reads
+ * it at the start of the row, the mean frequency of the crystal in the row
+ * and if the PPS edges came. The PPS is lost for the last 12 hours, from
+ * 06:00 to 18:00 of the fourth day.
+ * The trace is simulated: a room with a daily cycle of 8°C around 26°C, a
+ * slower drift of 3°C and steps of 2.5°C from the air conditioning. The
+ * crystal lags the sensor by 5 minutes, its curve is an AT cut one with
+ * -180ppb/°C around 27°C and a small cubic term, 11ppm fast there and aging
+ * by 1.5ppb a day.
+ */
+#define TRACE_INTERVAL ( 64 )
+#define TRACE_HOLD_ROWS ( 675 )
+
+typedef struct {
+  int16_t temperature;  /* 1/4 °C */
+  int32_t ppb;          /* The crystal runs fast */
+  uint8_t pps;          /* 1 if the edges came */
+} trace_row_t;
+
+static const trace_row_t trace_holdover[] = {
+  { 100, 11362, 1 }, { 98, 11377, 1 }, { 97, 11401, 1 }, { 96, 11430, 1 }, { 95, 11463, 1 }, { 93, 11499, 1 },
+  { 93, 11536, 1 }, { 92, 11571, 1 }, { 90, 11611, 1 }, { 90, 11646, 1 }, { 90, 11679, 1 }, { 89, 11712, 1 },
+  { 89, 11741, 1 }, { 88, 11767, 1 }, { 88, 11791, 1 }, { 87, 11815, 1 }, { 87, 11839, 1 }, { 86, 11862, 1 },
+  { 86, 11882, 1 }, { 86, 11901, 1 }, { 86, 11918, 1 }, { 85, 11933, 1 }, { 85, 11946, 1 }, { 86, 11956, 1 },
+  { 84, 11970, 1 }, { 84, 11986, 1 }, { 84, 11999, 1 }, { 84, 12012, 1 }, { 83, 12023, 1 }, { 84, 12029, 1 },
+  { 84, 12034, 1 }, { 84, 12038, 1 }, { 84, 12043, 1 }, { 83, 12050, 1 }, { 83, 12061, 1 }, { 82, 12072, 1 },
+  { 83, 12079, 1 }, { 83, 12083, 1 }, { 83, 12085, 1 }, { 83, 12086, 1 }, { 83, 12087, 1 }, { 83, 12086, 1 },
+  { 84, 12085, 1 }, { 83, 12087, 1 }, { 83, 12091, 1 }, { 82, 12096, 1 }, { 83, 12095, 1 }, { 83, 12094, 1 },
+  { 83, 12097, 1 }, { 82, 12101, 1 }, { 82, 12105, 1 }, { 83, 12108, 1 }, { 83, 12108, 1 }, { 83, 12107, 1 },
+  { 83, 12107, 1 }, { 83, 12105, 1 }, { 83, 12105, 1 }, { 83, 12107, 1 }, { 83, 12109, 1 }, { 83, 12109, 1 },
+  { 83, 12108, 1 }, { 83, 12106, 1 }, { 83, 12107, 1 }, { 83, 12109, 1 }, { 83, 12109, 1 }, { 83, 12106, 1 },
+  { 83, 12102, 1 }, { 83, 12099, 1 }, { 83, 12097, 1 }, { 83, 12096, 1 }, { 84, 12093, 1 }, { 84, 12089, 1 },
+  { 83, 12087, 1 }, { 83, 12088, 1 }, { 83, 12092, 1 }, { 83, 12095, 1 }, { 83, 12097, 1 }, { 83, 12098, 1 },
+  { 83, 12097, 1 }, { 83, 12094, 1 }, { 83, 12091, 1 }, { 83, 12090, 1 }, { 83, 12088, 1 }, { 83, 12089, 1 },
+  { 83, 12087, 1 }, { 83, 12092, 1 }, { 82, 12104, 1 }, { 81, 12120, 1 }, { 80, 12138, 1 }, { 79, 12158, 1 },
+  { 79, 12178, 1 }, { 79, 12197, 1 }, { 79, 12213, 1 }, { 78, 12231, 1 }, { 78, 12250, 1 }, { 77, 12269, 1 },
+  { 77, 12285, 1 }, { 77, 12301, 1 }, { 76, 12315, 1 }, { 76, 12329, 1 }, { 76, 12339, 1 }, { 76, 12348, 1 },
+  { 76, 12355, 1 }, { 76, 12364, 1 }, { 76, 12370, 1 }, { 76, 12375, 1 }, { 75, 12382, 1 }, { 75, 12389, 1 },
+  { 75, 12395, 1 }, { 75, 12401, 1 }, { 75, 12406, 1 }, { 75, 12411, 1 }, { 75, 12416, 1 }, { 74, 12420, 1 },
+  { 75, 12423, 1 }, { 75, 12425, 1 }, { 75, 12427, 1 }, { 75, 12426, 1 }, { 75, 12426, 1 }, { 75, 12428, 1 },
+  { 75, 12428, 1 }, { 75, 12429, 1 }, { 75, 12428, 1 }, { 75, 12427, 1 }, { 75, 12427, 1 }, { 75, 12424, 1 },
+  { 75, 12422, 1 }, { 76, 12418, 1 }, { 75, 12416, 1 }, { 75, 12416, 1 }, { 75, 12413, 1 }, { 76, 12409, 1 },
+  { 76, 12406, 1 }, { 76, 12403, 1 }, { 76, 12402, 1 }, { 76, 12403, 1 }, { 76, 12402, 1 }, { 76, 12399, 1 },
+  { 76, 12395, 1 }, { 76, 12394, 1 }, { 76, 12393, 1 }, { 76, 12393, 1 }, { 75, 12396, 1 }, { 75, 12402, 1 },
+  { 75, 12406, 1 }, { 75, 12409, 1 }, { 75, 12410, 1 }, { 75, 12411, 1 }, { 75, 12411, 1 }, { 76, 12409, 1 },
+  { 76, 12406, 1 }, { 75, 12405, 1 }, { 76, 12403, 1 }, { 76, 12400, 1 }, { 76, 12399, 1 }, { 76, 12398, 1 },
+  { 76, 12398, 1 }, { 76, 12397, 1 }, { 76, 12393, 1 }, { 76, 12391, 1 }, { 76, 12388, 1 }, { 77, 12382, 1 },
+  { 77, 12378, 1 }, { 76, 12377, 1 }, { 77, 12373, 1 }, { 77, 12370, 1 }, { 76, 12368, 1 }, { 77, 12366, 1 },
+  { 77, 12363, 1 }, { 77, 12357, 1 }, { 77, 12350, 1 }, { 78, 12344, 1 }, { 77, 12341, 1 }, { 77, 12338, 1 },
+  { 78, 12332, 1 }, { 78, 12325, 1 }, { 78, 12318, 1 }, { 78, 12315, 1 }, { 78, 12313, 1 }, { 78, 12311, 1 },
+  { 78, 12306, 1 }, { 78, 12304, 1 }, { 78, 12302, 1 }, { 78, 12298, 1 }, { 78, 12296, 1 }, { 78, 12295, 1 },
+  { 79, 12292, 1 }, { 79, 12290, 1 }, { 79, 12288, 1 }, { 79, 12283, 1 }, { 79, 12281, 1 }, { 79, 12276, 1 },
+  { 79, 12271, 1 }, { 79, 12267, 1 }, { 79, 12263, 1 }, { 80, 12259, 1 }, { 79, 12256, 1 }, { 80, 12254, 1 },
+  { 79, 12254, 1 }, { 79, 12255, 1 }, { 79, 12258, 1 }, { 79, 12261, 1 }, { 79, 12258, 1 }, { 80, 12252, 1 },
+  { 80, 12244, 1 }, { 80, 12236, 1 }, { 81, 12227, 1 }, { 81, 12217, 1 }, { 82, 12206, 1 }, { 82, 12196, 1 },
+  { 82, 12185, 1 }, { 82, 12176, 1 }, { 82, 12168, 1 }, { 82, 12160, 1 }, { 82, 12154, 1 }, { 82, 12148, 1 },
+  { 82, 12143, 1 }, { 83, 12138, 1 }, { 83, 12134, 1 }, { 82, 12134, 1 }, { 82, 12135, 1 }, { 82, 12136, 1 },
+  { 83, 12131, 1 }, { 83, 12122, 1 }, { 83, 12114, 1 }, { 83, 12109, 1 }, { 83, 12105, 1 }, { 83, 12102, 1 },
+  { 83, 12101, 1 }, { 83, 12099, 1 }, { 83, 12098, 1 }, { 83, 12096, 1 }, { 83, 12093, 1 }, { 84, 12090, 1 },
+  { 83, 12089, 1 }, { 84, 12085, 1 }, { 84, 12081, 1 }, { 84, 12078, 1 }, { 84, 12074, 1 }, { 84, 12070, 1 },
+  { 84, 12067, 1 }, { 84, 12065, 1 }, { 84, 12062, 1 }, { 84, 12058, 1 }, { 85, 12052, 1 }, { 85, 12045, 1 },
+  { 85, 12036, 1 }, { 85, 12029, 1 }, { 86, 12019, 1 }, { 86, 12011, 1 }, { 86, 12004, 1 }, { 86, 11999, 1 },
+  { 86, 11993, 1 }, { 86, 11988, 1 }, { 87, 11977, 1 }, { 88, 11958, 1 }, { 89, 11936, 1 }, { 90, 11909, 1 },
+  { 91, 11878, 1 }, { 92, 11845, 1 }, { 93, 11813, 1 }, { 93, 11784, 1 }, { 94, 11756, 1 }, { 94, 11730, 1 },
+  { 94, 11708, 1 }, { 95, 11685, 1 }, { 96, 11660, 1 }, { 96, 11638, 1 }, { 96, 11616, 1 }, { 97, 11594, 1 },
+  { 97, 11575, 1 }, { 97, 11559, 1 }, { 97, 11547, 1 }, { 97, 11536, 1 }, { 97, 11525, 1 }, { 97, 11513, 1 },
+  { 98, 11499, 1 }, { 98, 11487, 1 }, { 98, 11479, 1 }, { 98, 11475, 1 }, { 98, 11474, 1 }, { 98, 11471, 1 },
+  { 98, 11468, 1 }, { 98, 11463, 1 }, { 99, 11453, 1 }, { 99, 11442, 1 }, { 100, 11430, 1 }, { 100, 11419, 1 },
+  { 100, 11410, 1 }, { 100, 11402, 1 }, { 100, 11394, 1 }, { 100, 11385, 1 }, { 101, 11373, 1 }, { 101, 11362, 1 },
+  { 101, 11352, 1 }, { 101, 11342, 1 }, { 101, 11337, 1 }, { 101, 11333, 1 }, { 102, 11325, 1 }, { 102, 11317, 1 },
+  { 102, 11309, 1 }, { 102, 11300, 1 }, { 103, 11292, 1 }, { 102, 11288, 1 }, { 102, 11282, 1 }, { 103, 11274, 1 },
+  { 103, 11266, 1 }, { 103, 11259, 1 }, { 103, 11251, 1 }, { 104, 11242, 1 }, { 104, 11231, 1 }, { 104, 11222, 1 },
+  { 104, 11214, 1 }, { 104, 11204, 1 }, { 104, 11197, 1 }, { 105, 11190, 1 }, { 105, 11182, 1 }, { 105, 11173, 1 },
+  { 105, 11166, 1 }, { 105, 11160, 1 }, { 105, 11154, 1 }, { 105, 11148, 1 }, { 105, 11143, 1 }, { 105, 11137, 1 },
+  { 106, 11131, 1 }, { 106, 11125, 1 }, { 106, 11119, 1 }, { 106, 11112, 1 }, { 106, 11105, 1 }, { 107, 11091, 1 },
+  { 107, 11078, 1 }, { 107, 11069, 1 }, { 107, 11064, 1 }, { 107, 11061, 1 }, { 107, 11057, 1 }, { 107, 11054, 1 },
+  { 107, 11051, 1 }, { 107, 11046, 1 }, { 107, 11047, 1 }, { 105, 11060, 1 }, { 105, 11075, 1 }, { 105, 11089, 1 },
+  { 104, 11104, 1 }, { 103, 11122, 1 }, { 103, 11144, 1 }, { 102, 11164, 1 }, { 103, 11182, 1 }, { 102, 11200, 1 },
+  { 102, 11216, 1 }, { 102, 11228, 1 }, { 102, 11236, 1 }, { 102, 11243, 1 }, { 103, 11245, 1 }, { 102, 11246, 1 },
+  { 102, 11247, 1 }, { 102, 11251, 1 }, { 102, 11258, 1 }, { 102, 11264, 1 }, { 102, 11266, 1 }, { 102, 11267, 1 },
+  { 102, 11270, 1 }, { 102, 11272, 1 }, { 102, 11273, 1 }, { 102, 11274, 1 }, { 102, 11274, 1 }, { 102, 11273, 1 },
+  { 102, 11271, 1 }, { 102, 11267, 1 }, { 103, 11263, 1 }, { 103, 11258, 1 }, { 103, 11250, 1 }, { 103, 11245, 1 },
+  { 103, 11240, 1 }, { 103, 11235, 1 }, { 103, 11229, 1 }, { 103, 11225, 1 }, { 104, 11219, 1 }, { 104, 11211, 1 },
+  { 105, 11200, 1 }, { 105, 11191, 1 }, { 105, 11184, 1 }, { 105, 11177, 1 }, { 105, 11170, 1 }, { 105, 11165, 1 },
+  { 105, 11160, 1 }, { 105, 11158, 1 }, { 105, 11153, 1 }, { 105, 11146, 1 }, { 105, 11140, 1 }, { 106, 11134, 1 },
+  { 106, 11128, 1 }, { 106, 11125, 1 }, { 106, 11121, 1 }, { 106, 11115, 1 }, { 106, 11110, 1 }, { 107, 11102, 1 },
+  { 107, 11094, 1 }, { 107, 11087, 1 }, { 107, 11079, 1 }, { 107, 11070, 1 }, { 107, 11064, 1 }, { 108, 11055, 1 },
+  { 108, 11047, 1 }, { 108, 11039, 1 }, { 108, 11032, 1 }, { 108, 11022, 1 }, { 109, 11011, 1 }, { 109, 11001, 1 },
+  { 109, 10990, 1 }, { 110, 10976, 1 }, { 110, 10965, 1 }, { 110, 10956, 1 }, { 110, 10949, 1 }, { 110, 10945, 1 },
+  { 110, 10940, 1 }, { 110, 10936, 1 }, { 110, 10929, 1 }, { 111, 10920, 1 }, { 111, 10908, 1 }, { 111, 10896, 1 },
+  { 112, 10883, 1 }, { 112, 10871, 1 }, { 112, 10862, 1 }, { 112, 10854, 1 }, { 112, 10847, 1 }, { 112, 10842, 1 },
+  { 112, 10837, 1 }, { 112, 10834, 1 }, { 112, 10829, 1 }, { 113, 10821, 1 }, { 113, 10812, 1 }, { 113, 10804, 1 },
+  { 113, 10794, 1 }, { 114, 10783, 1 }, { 114, 10775, 1 }, { 114, 10767, 1 }, { 114, 10758, 1 }, { 114, 10751, 1 },
+  { 114, 10744, 1 }, { 114, 10740, 1 }, { 114, 10737, 1 }, { 114, 10733, 1 }, { 115, 10726, 1 }, { 115, 10722, 1 },
+  { 115, 10719, 1 }, { 115, 10713, 1 }, { 115, 10704, 1 }, { 115, 10696, 1 }, { 116, 10687, 1 }, { 116, 10678, 1 },
+  { 116, 10673, 1 }, { 116, 10667, 1 }, { 116, 10661, 1 }, { 117, 10651, 1 }, { 117, 10642, 1 }, { 117, 10634, 1 },
+  { 117, 10622, 1 }, { 118, 10609, 1 }, { 118, 10596, 1 }, { 118, 10585, 1 }, { 119, 10575, 1 }, { 118, 10568, 1 },
+  { 118, 10563, 1 }, { 118, 10559, 1 }, { 118, 10555, 1 }, { 118, 10553, 1 }, { 118, 10551, 1 }, { 118, 10550, 1 },
+  { 118, 10550, 1 }, { 118, 10547, 1 }, { 119, 10540, 1 }, { 119, 10531, 1 }, { 119, 10522, 1 }, { 120, 10514, 1 },
+  { 120, 10509, 1 }, { 120, 10503, 1 }, { 119, 10499, 1 }, { 120, 10497, 1 }, { 120, 10492, 1 }, { 120, 10488, 1 },
+  { 120, 10482, 1 }, { 120, 10476, 1 }, { 120, 10472, 1 }, { 120, 10469, 1 }, { 120, 10469, 1 }, { 120, 10467, 1 },
+  { 120, 10463, 1 }, { 121, 10458, 1 }, { 121, 10455, 1 }, { 120, 10453, 1 }, { 121, 10446, 1 }, { 122, 10433, 1 },
+  { 122, 10419, 1 }, { 122, 10409, 1 }, { 122, 10399, 1 }, { 123, 10390, 1 }, { 122, 10384, 1 }, { 122, 10380, 1 },
+  { 122, 10376, 1 }, { 123, 10367, 1 }, { 123, 10360, 1 }, { 123, 10357, 1 }, { 123, 10354, 1 }, { 123, 10349, 1 },
+  { 123, 10344, 1 }, { 123, 10340, 1 }, { 123, 10338, 1 }, { 124, 10328, 1 }, { 125, 10309, 1 }, { 126, 10285, 1 },
+  { 128, 10255, 1 }, { 128, 10225, 1 }, { 129, 10195, 1 }, { 130, 10166, 1 }, { 130, 10135, 1 }, { 131, 10104, 1 },
+  { 132, 10076, 1 }, { 132, 10051, 1 }, { 132, 10027, 1 }, { 133, 10003, 1 }, { 133, 9981, 1 }, { 134, 9961, 1 },
+  { 134, 9941, 1 }, { 135, 9921, 1 }, { 135, 9905, 1 }, { 135, 9892, 1 }, { 135, 9881, 1 }, { 135, 9872, 1 },
+  { 135, 9861, 1 }, { 135, 9852, 1 }, { 135, 9845, 1 }, { 135, 9837, 1 }, { 136, 9829, 1 }, { 136, 9821, 1 },
+  { 136, 9811, 1 }, { 136, 9800, 1 }, { 137, 9787, 1 }, { 137, 9776, 1 }, { 137, 9767, 1 }, { 138, 9757, 1 },
+  { 138, 9748, 1 }, { 137, 9744, 1 }, { 137, 9741, 1 }, { 137, 9738, 1 }, { 138, 9731, 1 }, { 138, 9723, 1 },
+  { 139, 9713, 1 }, { 138, 9707, 1 }, { 139, 9700, 1 }, { 139, 9690, 1 }, { 140, 9679, 1 }, { 140, 9671, 1 },
+  { 139, 9665, 1 }, { 140, 9659, 1 }, { 140, 9653, 1 }, { 140, 9649, 1 }, { 139, 9647, 1 }, { 140, 9644, 1 },
+  { 140, 9639, 1 }, { 140, 9633, 1 }, { 140, 9627, 1 }, { 141, 9619, 1 }, { 141, 9611, 1 }, { 141, 9602, 1 },
+  { 141, 9595, 1 }, { 141, 9587, 1 }, { 142, 9578, 1 }, { 142, 9570, 1 }, { 142, 9563, 1 }, { 142, 9558, 1 },
+  { 142, 9553, 1 }, { 142, 9547, 1 }, { 142, 9542, 1 }, { 143, 9537, 1 }, { 142, 9534, 1 }, { 142, 9532, 1 },
+  { 143, 9529, 1 }, { 142, 9526, 1 }, { 143, 9522, 1 }, { 143, 9516, 1 }, { 144, 9509, 1 }, { 144, 9502, 1 },
+  { 144, 9495, 1 }, { 144, 9488, 1 }, { 144, 9482, 1 }, { 144, 9477, 1 }, { 144, 9472, 1 }, { 144, 9467, 1 },
+  { 144, 9463, 1 }, { 145, 9458, 1 }, { 144, 9456, 1 }, { 144, 9456, 1 }, { 144, 9460, 1 }, { 143, 9469, 1 },
+  { 143, 9477, 1 }, { 142, 9486, 1 }, { 142, 9499, 1 }, { 141, 9517, 1 }, { 140, 9537, 1 }, { 139, 9558, 1 },
+  { 139, 9577, 1 }, { 139, 9595, 1 }, { 139, 9609, 1 }, { 139, 9619, 1 }, { 139, 9626, 1 }, { 139, 9634, 1 },
+  { 139, 9640, 1 }, { 139, 9646, 1 }, { 138, 9654, 1 }, { 138, 9660, 1 }, { 138, 9664, 1 }, { 138, 9668, 1 },
+  { 138, 9671, 1 }, { 138, 9675, 1 }, { 138, 9679, 1 }, { 138, 9681, 1 }, { 138, 9684, 1 }, { 138, 9686, 1 },
+  { 138, 9686, 1 }, { 138, 9685, 1 }, { 138, 9683, 1 }, { 139, 9680, 1 }, { 139, 9677, 1 }, { 139, 9671, 1 },
+  { 139, 9665, 1 }, { 139, 9661, 1 }, { 139, 9657, 1 }, { 140, 9652, 1 }, { 140, 9644, 1 }, { 140, 9636, 1 },
+  { 140, 9631, 1 }, { 140, 9626, 1 }, { 140, 9622, 1 }, { 141, 9617, 1 }, { 141, 9610, 1 }, { 141, 9604, 1 },
+  { 141, 9596, 1 }, { 142, 9588, 1 }, { 142, 9579, 1 }, { 141, 9575, 1 }, { 141, 9575, 1 }, { 141, 9578, 1 },
+  { 141, 9579, 1 }, { 140, 9583, 1 }, { 140, 9587, 1 }, { 141, 9590, 1 }, { 141, 9591, 1 }, { 140, 9593, 1 },
+  { 141, 9593, 1 }, { 141, 9592, 1 }, { 141, 9590, 1 }, { 141, 9587, 1 }, { 142, 9582, 1 }, { 141, 9578, 1 },
+  { 141, 9574, 1 }, { 142, 9569, 1 }, { 142, 9562, 1 }, { 143, 9553, 1 }, { 143, 9546, 1 }, { 143, 9540, 1 },
+  { 143, 9535, 1 }, { 143, 9530, 1 }, { 143, 9524, 1 }, { 143, 9517, 1 }, { 143, 9512, 1 }, { 143, 9507, 1 },
+  { 143, 9504, 1 }, { 143, 9503, 1 }, { 143, 9501, 1 }, { 143, 9500, 1 }, { 143, 9500, 1 }, { 143, 9500, 1 },
+  { 143, 9502, 1 }, { 143, 9503, 1 }, { 143, 9505, 1 }, { 143, 9507, 1 }, { 143, 9506, 1 }, { 143, 9506, 1 },
+  { 143, 9504, 1 }, { 143, 9501, 1 }, { 143, 9498, 1 }, { 143, 9494, 1 }, { 143, 9491, 1 }, { 143, 9490, 1 },
+  { 143, 9489, 1 }, { 144, 9486, 1 }, { 144, 9483, 1 }, { 144, 9478, 1 }, { 144, 9472, 1 }, { 144, 9467, 1 },
+  { 144, 9463, 1 }, { 144, 9460, 1 }, { 144, 9458, 1 }, { 144, 9456, 1 }, { 144, 9455, 1 }, { 144, 9457, 1 },
+  { 144, 9458, 1 }, { 144, 9457, 1 }, { 145, 9454, 1 }, { 145, 9449, 1 }, { 145, 9445, 1 }, { 145, 9442, 1 },
+  { 145, 9440, 1 }, { 145, 9440, 1 }, { 145, 9440, 1 }, { 145, 9438, 1 }, { 145, 9436, 1 }, { 145, 9433, 1 },
+  { 145, 9432, 1 }, { 145, 9431, 1 }, { 145, 9432, 1 }, { 145, 9434, 1 }, { 144, 9435, 1 }, { 145, 9435, 1 },
+  { 145, 9435, 1 }, { 144, 9437, 1 }, { 144, 9439, 1 }, { 144, 9442, 1 }, { 144, 9444, 1 }, { 145, 9440, 1 },
+  { 145, 9435, 1 }, { 146, 9429, 1 }, { 145, 9424, 1 }, { 146, 9419, 1 }, { 146, 9414, 1 }, { 146, 9407, 1 },
+  { 147, 9397, 1 }, { 147, 9388, 1 }, { 147, 9382, 1 }, { 147, 9379, 1 }, { 146, 9380, 1 }, { 146, 9383, 1 },
+  { 146, 9385, 1 }, { 146, 9387, 1 }, { 145, 9391, 1 }, { 145, 9395, 1 }, { 145, 9399, 1 }, { 145, 9403, 1 },
+  { 145, 9406, 1 }, { 145, 9410, 1 }, { 145, 9413, 1 }, { 145, 9417, 1 }, { 145, 9419, 1 }, { 145, 9423, 1 },
+  { 145, 9425, 1 }, { 144, 9427, 1 }, { 145, 9429, 1 }, { 144, 9431, 1 }, { 145, 9431, 1 }, { 145, 9427, 1 },
+  { 146, 9421, 1 }, { 146, 9415, 1 }, { 146, 9410, 1 }, { 146, 9405, 1 }, { 146, 9400, 1 }, { 146, 9394, 1 },
+  { 147, 9389, 1 }, { 146, 9388, 1 }, { 146, 9389, 1 }, { 146, 9390, 1 }, { 146, 9387, 1 }, { 147, 9378, 1 },
+  { 149, 9361, 1 }, { 150, 9339, 1 }, { 151, 9315, 1 }, { 151, 9291, 1 }, { 152, 9270, 1 }, { 152, 9249, 1 },
+  { 153, 9229, 1 }, { 153, 9211, 1 }, { 153, 9194, 1 }, { 153, 9179, 1 }, { 154, 9165, 1 }, { 154, 9150, 1 },
+  { 155, 9136, 1 }, { 155, 9122, 1 }, { 155, 9109, 1 }, { 156, 9096, 1 }, { 156, 9085, 1 }, { 156, 9077, 1 },
+  { 156, 9069, 1 }, { 155, 9064, 1 }, { 155, 9062, 1 }, { 155, 9062, 1 }, { 155, 9062, 1 }, { 155, 9064, 1 },
+  { 155, 9065, 1 }, { 155, 9066, 1 }, { 155, 9065, 1 }, { 155, 9063, 1 }, { 155, 9061, 1 }, { 155, 9060, 1 },
+  { 155, 9059, 1 }, { 155, 9057, 1 }, { 155, 9056, 1 }, { 156, 9054, 1 }, { 155, 9054, 1 }, { 155, 9054, 1 },
+  { 155, 9056, 1 }, { 155, 9058, 1 }, { 155, 9060, 1 }, { 154, 9065, 1 }, { 154, 9068, 1 }, { 155, 9069, 1 },
+  { 155, 9069, 1 }, { 155, 9069, 1 }, { 155, 9070, 1 }, { 155, 9070, 1 }, { 155, 9070, 1 }, { 154, 9072, 1 },
+  { 155, 9074, 1 }, { 155, 9074, 1 }, { 155, 9074, 1 }, { 155, 9072, 1 }, { 155, 9071, 1 }, { 155, 9071, 1 },
+  { 155, 9072, 1 }, { 154, 9073, 1 }, { 154, 9074, 1 }, { 154, 9077, 1 }, { 154, 9081, 1 }, { 154, 9081, 1 },
+  { 154, 9083, 1 }, { 155, 9083, 1 }, { 154, 9084, 1 }, { 154, 9085, 1 }, { 154, 9086, 1 }, { 154, 9087, 1 },
+  { 154, 9086, 1 }, { 155, 9083, 1 }, { 155, 9081, 1 }, { 155, 9080, 1 }, { 154, 9081, 1 }, { 154, 9083, 1 },
+  { 154, 9085, 1 }, { 154, 9088, 1 }, { 154, 9091, 1 }, { 154, 9092, 1 }, { 154, 9092, 1 }, { 154, 9092, 1 },
+  { 154, 9092, 1 }, { 155, 9091, 1 }, { 154, 9091, 1 }, { 154, 9092, 1 }, { 154, 9097, 1 }, { 152, 9108, 1 },
+  { 152, 9123, 1 }, { 150, 9142, 1 }, { 150, 9163, 1 }, { 149, 9184, 1 }, { 148, 9206, 1 }, { 147, 9229, 1 },
+  { 147, 9254, 1 }, { 147, 9275, 1 }, { 146, 9295, 1 }, { 146, 9312, 1 }, { 145, 9330, 1 }, { 145, 9347, 1 },
+  { 145, 9361, 1 }, { 145, 9374, 1 }, { 145, 9387, 1 }, { 144, 9401, 1 }, { 143, 9417, 1 }, { 144, 9431, 1 },
+  { 143, 9442, 1 }, { 143, 9451, 1 }, { 143, 9459, 1 }, { 143, 9468, 1 }, { 142, 9478, 1 }, { 142, 9487, 1 },
+  { 142, 9495, 1 }, { 142, 9504, 1 }, { 142, 9512, 1 }, { 142, 9519, 1 }, { 141, 9527, 1 }, { 141, 9535, 1 },
+  { 141, 9542, 1 }, { 141, 9550, 1 }, { 140, 9560, 1 }, { 140, 9572, 1 }, { 140, 9582, 1 }, { 140, 9587, 1 },
+  { 140, 9592, 1 }, { 140, 9599, 1 }, { 140, 9605, 1 }, { 140, 9609, 1 }, { 140, 9609, 1 }, { 141, 9604, 1 },
+  { 141, 9601, 1 }, { 140, 9601, 1 }, { 140, 9603, 1 }, { 140, 9604, 1 }, { 140, 9605, 1 }, { 140, 9606, 1 },
+  { 140, 9607, 1 }, { 140, 9609, 1 }, { 140, 9610, 1 }, { 140, 9612, 1 }, { 140, 9616, 1 }, { 140, 9619, 1 },
+  { 140, 9621, 1 }, { 140, 9623, 1 }, { 140, 9624, 1 }, { 140, 9622, 1 }, { 140, 9620, 1 }, { 140, 9622, 1 },
+  { 140, 9623, 1 }, { 140, 9623, 1 }, { 140, 9623, 1 }, { 140, 9625, 1 }, { 139, 9629, 1 }, { 139, 9633, 1 },
+  { 139, 9636, 1 }, { 139, 9638, 1 }, { 139, 9644, 1 }, { 139, 9650, 1 }, { 138, 9657, 1 }, { 139, 9662, 1 },
+  { 138, 9666, 1 }, { 139, 9667, 1 }, { 138, 9670, 1 }, { 138, 9674, 1 }, { 138, 9679, 1 }, { 138, 9684, 1 },
+  { 138, 9688, 1 }, { 137, 9694, 1 }, { 138, 9697, 1 }, { 138, 9695, 1 }, { 138, 9692, 1 }, { 139, 9689, 1 },
+  { 138, 9690, 1 }, { 137, 9698, 1 }, { 136, 9709, 1 }, { 136, 9719, 1 }, { 136, 9729, 1 }, { 136, 9738, 1 },
+  { 136, 9744, 1 }, { 136, 9749, 1 }, { 136, 9755, 1 }, { 136, 9763, 1 }, { 135, 9769, 1 }, { 136, 9773, 1 },
+  { 136, 9777, 1 }, { 135, 9781, 1 }, { 136, 9785, 1 }, { 135, 9789, 1 }, { 135, 9793, 1 }, { 135, 9798, 1 },
+  { 135, 9804, 1 }, { 135, 9809, 1 }, { 135, 9814, 1 }, { 134, 9819, 1 }, { 134, 9827, 1 }, { 134, 9836, 1 },
+  { 134, 9845, 1 }, { 133, 9855, 1 }, { 133, 9867, 1 }, { 132, 9878, 1 }, { 132, 9885, 1 }, { 133, 9889, 1 },
+  { 133, 9889, 1 }, { 133, 9889, 1 }, { 134, 9887, 1 }, { 133, 9887, 1 }, { 133, 9888, 1 }, { 133, 9889, 1 },
+  { 132, 9897, 1 }, { 132, 9906, 1 }, { 132, 9911, 1 }, { 132, 9914, 1 }, { 132, 9916, 1 }, { 132, 9919, 1 },
+  { 132, 9923, 1 }, { 132, 9930, 1 }, { 132, 9937, 1 }, { 131, 9945, 1 }, { 131, 9954, 1 }, { 131, 9962, 1 },
+  { 130, 9973, 1 }, { 130, 9984, 1 }, { 129, 9997, 1 }, { 129, 10012, 1 }, { 129, 10024, 1 }, { 129, 10035, 1 },
+  { 128, 10047, 1 }, { 128, 10057, 1 }, { 129, 10062, 1 }, { 129, 10064, 1 }, { 129, 10066, 1 }, { 129, 10068, 1 },
+  { 129, 10069, 1 }, { 129, 10071, 1 }, { 129, 10073, 1 }, { 129, 10075, 1 }, { 129, 10077, 1 }, { 129, 10079, 1 },
+  { 128, 10081, 1 }, { 129, 10081, 1 }, { 128, 10083, 1 }, { 128, 10086, 1 }, { 128, 10090, 1 }, { 128, 10094, 1 },
+  { 127, 10103, 1 }, { 127, 10117, 1 }, { 126, 10130, 1 }, { 127, 10139, 1 }, { 127, 10144, 1 }, { 127, 10148, 1 },
+  { 127, 10151, 1 }, { 127, 10153, 1 }, { 127, 10155, 1 }, { 127, 10156, 1 }, { 127, 10159, 1 }, { 127, 10159, 1 },
+  { 128, 10154, 1 }, { 128, 10146, 1 }, { 129, 10130, 1 }, { 130, 10109, 1 }, { 131, 10088, 1 }, { 131, 10066, 1 },
+  { 132, 10045, 1 }, { 132, 10027, 1 }, { 132, 10012, 1 }, { 132, 9997, 1 }, { 132, 9985, 1 }, { 132, 9974, 1 },
+  { 133, 9962, 1 }, { 133, 9952, 1 }, { 133, 9943, 1 }, { 133, 9937, 1 }, { 133, 9932, 1 }, { 133, 9928, 1 },
+  { 133, 9923, 1 }, { 133, 9920, 1 }, { 133, 9921, 1 }, { 132, 9924, 1 }, { 132, 9926, 1 }, { 132, 9929, 1 },
+  { 132, 9933, 1 }, { 132, 9937, 1 }, { 132, 9938, 1 }, { 133, 9936, 1 }, { 133, 9933, 1 }, { 133, 9930, 1 },
+  { 133, 9928, 1 }, { 133, 9928, 1 }, { 132, 9930, 1 }, { 132, 9933, 1 }, { 132, 9935, 1 }, { 132, 9939, 1 },
+  { 132, 9942, 1 }, { 132, 9944, 1 }, { 132, 9945, 1 }, { 132, 9946, 1 }, { 131, 9949, 1 }, { 132, 9953, 1 },
+  { 131, 9957, 1 }, { 131, 9960, 1 }, { 132, 9962, 1 }, { 132, 9962, 1 }, { 131, 9963, 1 }, { 132, 9962, 1 },
+  { 132, 9959, 1 }, { 132, 9957, 1 }, { 132, 9956, 1 }, { 132, 9958, 1 }, { 131, 9962, 1 }, { 131, 9968, 1 },
+  { 131, 9976, 1 }, { 130, 9986, 1 }, { 130, 9996, 1 }, { 130, 10006, 1 }, { 129, 10016, 1 }, { 129, 10027, 1 },
+  { 128, 10042, 1 }, { 128, 10056, 1 }, { 127, 10071, 1 }, { 127, 10086, 1 }, { 128, 10096, 1 }, { 127, 10107, 1 },
+  { 127, 10116, 1 }, { 127, 10123, 1 }, { 127, 10131, 1 }, { 126, 10140, 1 }, { 127, 10146, 1 }, { 126, 10153, 1 },
+  { 126, 10161, 1 }, { 126, 10170, 1 }, { 126, 10178, 1 }, { 126, 10186, 1 }, { 126, 10191, 1 }, { 125, 10199, 1 },
+  { 125, 10207, 1 }, { 125, 10215, 1 }, { 125, 10223, 1 }, { 125, 10231, 1 }, { 124, 10241, 1 }, { 124, 10254, 1 },
+  { 123, 10270, 1 }, { 122, 10291, 1 }, { 121, 10316, 1 }, { 120, 10342, 1 }, { 120, 10367, 1 }, { 119, 10393, 1 },
+  { 118, 10421, 1 }, { 118, 10450, 1 }, { 117, 10478, 1 }, { 117, 10503, 1 }, { 116, 10529, 1 }, { 116, 10553, 1 },
+  { 115, 10576, 1 }, { 115, 10595, 1 }, { 115, 10611, 1 }, { 115, 10629, 1 }, { 113, 10650, 1 }, { 114, 10669, 1 },
+  { 113, 10686, 1 }, { 113, 10704, 1 }, { 112, 10723, 1 }, { 112, 10742, 1 }, { 112, 10759, 1 }, { 112, 10775, 1 },
+  { 112, 10788, 1 }, { 111, 10802, 1 }, { 111, 10815, 1 }, { 111, 10822, 1 }, { 111, 10828, 1 }, { 111, 10834, 1 },
+  { 111, 10840, 1 }, { 111, 10846, 1 }, { 111, 10852, 1 }, { 110, 10863, 1 }, { 109, 10876, 1 }, { 110, 10886, 1 },
+  { 109, 10897, 1 }, { 109, 10909, 1 }, { 109, 10920, 1 }, { 109, 10928, 1 }, { 109, 10937, 1 }, { 108, 10949, 1 },
+  { 108, 10961, 1 }, { 108, 10971, 1 }, { 107, 10982, 1 }, { 107, 10991, 1 }, { 107, 11001, 1 }, { 107, 11010, 1 },
+  { 107, 11019, 1 }, { 107, 11028, 1 }, { 107, 11036, 1 }, { 107, 11041, 1 }, { 107, 11044, 1 }, { 107, 11049, 1 },
+  { 106, 11055, 1 }, { 107, 11060, 1 }, { 106, 11066, 1 }, { 106, 11071, 1 }, { 106, 11073, 1 }, { 107, 11070, 1 },
+  { 107, 11070, 1 }, { 106, 11073, 1 }, { 106, 11077, 1 }, { 106, 11082, 1 }, { 106, 11088, 1 }, { 105, 11095, 1 },
+  { 105, 11103, 1 }, { 105, 11112, 1 }, { 105, 11120, 1 }, { 105, 11125, 1 }, { 105, 11127, 1 }, { 105, 11130, 1 },
+  { 105, 11133, 1 }, { 104, 11139, 1 }, { 104, 11145, 1 }, { 104, 11151, 1 }, { 104, 11156, 1 }, { 104, 11160, 1 },
+  { 104, 11164, 1 }, { 104, 11166, 1 }, { 104, 11170, 1 }, { 103, 11178, 1 }, { 103, 11187, 1 }, { 103, 11198, 1 },
+  { 102, 11210, 1 }, { 102, 11221, 1 }, { 102, 11230, 1 }, { 102, 11236, 1 }, { 102, 11245, 1 }, { 102, 11252, 1 },
+  { 102, 11260, 1 }, { 101, 11269, 1 }, { 101, 11278, 1 }, { 100, 11289, 1 }, { 100, 11299, 1 }, { 101, 11305, 1 },
+  { 101, 11308, 1 }, { 101, 11312, 1 }, { 101, 11313, 1 }, { 101, 11314, 1 }, { 100, 11318, 1 }, { 101, 11322, 1 },
+  { 101, 11324, 1 }, { 101, 11325, 1 }, { 101, 11326, 1 }, { 100, 11331, 1 }, { 100, 11338, 1 }, { 100, 11344, 1 },
+  { 100, 11349, 1 }, { 100, 11353, 1 }, { 100, 11358, 1 }, { 100, 11359, 1 }, { 100, 11359, 1 }, { 100, 11358, 1 },
+  { 100, 11356, 1 }, { 101, 11353, 1 }, { 100, 11355, 1 }, { 100, 11360, 1 }, { 99, 11368, 1 }, { 99, 11374, 1 },
+  { 99, 11379, 1 }, { 99, 11385, 1 }, { 99, 11391, 1 }, { 98, 11399, 1 }, { 98, 11410, 1 }, { 98, 11422, 1 },
+  { 97, 11433, 1 }, { 98, 11441, 1 }, { 97, 11449, 1 }, { 97, 11457, 1 }, { 97, 11467, 1 }, { 96, 11481, 1 },
+  { 96, 11494, 1 }, { 96, 11503, 1 }, { 96, 11509, 1 }, { 96, 11514, 1 }, { 96, 11516, 1 }, { 97, 11515, 1 },
+  { 97, 11515, 1 }, { 96, 11515, 1 }, { 96, 11516, 1 }, { 97, 11517, 1 }, { 96, 11521, 1 }, { 95, 11528, 1 },
+  { 95, 11534, 1 }, { 96, 11538, 1 }, { 96, 11541, 1 }, { 95, 11545, 1 }, { 95, 11549, 1 }, { 96, 11550, 1 },
+  { 95, 11552, 1 }, { 95, 11555, 1 }, { 95, 11561, 1 }, { 95, 11568, 1 }, { 94, 11578, 1 }, { 94, 11587, 1 },
+  { 94, 11595, 1 }, { 94, 11601, 1 }, { 94, 11609, 1 }, { 93, 11619, 1 }, { 93, 11628, 1 }, { 93, 11635, 1 },
+  { 93, 11639, 1 }, { 94, 11640, 1 }, { 93, 11644, 1 }, { 93, 11649, 1 }, { 93, 11653, 1 }, { 94, 11653, 1 },
+  { 94, 11650, 1 }, { 94, 11643, 1 }, { 95, 11631, 1 }, { 95, 11617, 1 }, { 96, 11601, 1 }, { 97, 11581, 1 },
+  { 97, 11562, 1 }, { 98, 11544, 1 }, { 98, 11525, 1 }, { 98, 11509, 1 }, { 98, 11495, 1 }, { 99, 11481, 1 },
+  { 99, 11471, 1 }, { 98, 11465, 1 }, { 98, 11459, 1 }, { 98, 11457, 1 }, { 98, 11453, 1 }, { 98, 11451, 1 },
+  { 98, 11450, 1 }, { 98, 11450, 1 }, { 98, 11450, 1 }, { 98, 11446, 1 }, { 99, 11442, 1 }, { 99, 11438, 1 },
+  { 99, 11433, 1 }, { 99, 11427, 1 }, { 99, 11421, 1 }, { 99, 11418, 1 }, { 99, 11418, 1 }, { 99, 11414, 1 },
+  { 99, 11410, 1 }, { 99, 11407, 1 }, { 99, 11407, 1 }, { 99, 11408, 1 }, { 99, 11410, 1 }, { 99, 11412, 1 },
+  { 99, 11413, 1 }, { 99, 11412, 1 }, { 98, 11415, 1 }, { 99, 11417, 1 }, { 98, 11421, 1 }, { 98, 11425, 1 },
+  { 99, 11424, 1 }, { 99, 11420, 1 }, { 99, 11416, 1 }, { 99, 11415, 1 }, { 98, 11419, 1 }, { 98, 11424, 1 },
+  { 98, 11428, 1 }, { 98, 11432, 1 }, { 98, 11435, 1 }, { 98, 11436, 1 }, { 98, 11436, 1 }, { 99, 11432, 1 },
+  { 99, 11429, 1 }, { 99, 11427, 1 }, { 99, 11424, 1 }, { 98, 11424, 1 }, { 98, 11426, 1 }, { 99, 11426, 1 },
+  { 98, 11426, 1 }, { 98, 11427, 1 }, { 98, 11428, 1 }, { 98, 11429, 1 }, { 99, 11426, 1 }, { 99, 11424, 1 },
+  { 99, 11425, 1 }, { 98, 11430, 1 }, { 98, 11432, 1 }, { 98, 11436, 1 }, { 98, 11437, 1 }, { 98, 11437, 1 },
+  { 98, 11439, 1 }, { 97, 11444, 1 }, { 97, 11450, 1 }, { 98, 11454, 1 }, { 97, 11458, 1 }, { 98, 11461, 1 },
+  { 97, 11466, 1 }, { 97, 11471, 1 }, { 97, 11472, 1 }, { 97, 11473, 1 }, { 97, 11475, 1 }, { 97, 11479, 1 },
+  { 97, 11485, 1 }, { 96, 11497, 1 }, { 94, 11517, 1 }, { 94, 11538, 1 }, { 93, 11564, 1 }, { 92, 11594, 1 },
+  { 91, 11624, 1 }, { 90, 11654, 1 }, { 90, 11680, 1 }, { 90, 11705, 1 }, { 89, 11732, 1 }, { 89, 11756, 1 },
+  { 88, 11778, 1 }, { 88, 11802, 1 }, { 87, 11828, 1 }, { 86, 11853, 1 }, { 86, 11874, 1 }, { 87, 11888, 1 },
+  { 87, 11898, 1 }, { 87, 11906, 1 }, { 86, 11915, 1 }, { 86, 11924, 1 }, { 86, 11933, 1 }, { 86, 11939, 1 },
+  { 86, 11944, 1 }, { 86, 11953, 1 }, { 85, 11962, 1 }, { 85, 11972, 1 }, { 85, 11980, 1 }, { 85, 11987, 1 },
+  { 85, 11991, 1 }, { 86, 11991, 1 }, { 85, 11993, 1 }, { 85, 11999, 1 }, { 85, 12005, 1 }, { 84, 12010, 1 },
+  { 85, 12011, 1 }, { 85, 12010, 1 }, { 85, 12009, 1 }, { 85, 12010, 1 }, { 85, 12012, 1 }, { 85, 12017, 1 },
+  { 84, 12026, 1 }, { 84, 12033, 1 }, { 84, 12036, 1 }, { 84, 12039, 1 }, { 84, 12044, 1 }, { 84, 12050, 1 },
+  { 83, 12055, 1 }, { 84, 12058, 1 }, { 84, 12060, 1 }, { 84, 12059, 1 }, { 84, 12059, 1 }, { 84, 12062, 1 },
+  { 84, 12064, 1 }, { 84, 12064, 1 }, { 84, 12064, 1 }, { 84, 12063, 1 }, { 84, 12062, 1 }, { 84, 12061, 1 },
+  { 84, 12060, 1 }, { 84, 12056, 1 }, { 85, 12050, 1 }, { 85, 12044, 1 }, { 85, 12039, 1 }, { 85, 12037, 1 },
+  { 85, 12035, 1 }, { 85, 12030, 1 }, { 85, 12028, 1 }, { 84, 12031, 1 }, { 84, 12036, 1 }, { 84, 12041, 1 },
+  { 84, 12048, 1 }, { 83, 12054, 1 }, { 83, 12060, 1 }, { 84, 12061, 1 }, { 84, 12061, 1 }, { 84, 12059, 1 },
+  { 84, 12057, 1 }, { 84, 12057, 1 }, { 84, 12059, 1 }, { 84, 12062, 1 }, { 84, 12063, 1 }, { 84, 12065, 1 },
+  { 83, 12067, 1 }, { 84, 12067, 1 }, { 84, 12065, 1 }, { 84, 12062, 1 }, { 84, 12060, 1 }, { 84, 12059, 1 },
+  { 84, 12056, 1 }, { 84, 12053, 1 }, { 84, 12051, 1 }, { 84, 12049, 1 }, { 85, 12043, 1 }, { 85, 12039, 1 },
+  { 85, 12036, 1 }, { 84, 12038, 1 }, { 84, 12044, 1 }, { 83, 12053, 1 }, { 83, 12063, 1 }, { 83, 12070, 1 },
+  { 83, 12076, 1 }, { 83, 12079, 1 }, { 83, 12081, 1 }, { 83, 12083, 1 }, { 83, 12084, 1 }, { 84, 12084, 1 },
+  { 83, 12086, 1 }, { 83, 12087, 1 }, { 83, 12090, 1 }, { 83, 12092, 1 }, { 83, 12090, 1 }, { 84, 12087, 1 },
+  { 84, 12082, 1 }, { 84, 12076, 1 }, { 84, 12072, 1 }, { 84, 12068, 1 }, { 84, 12063, 1 }, { 84, 12058, 1 },
+  { 85, 12054, 1 }, { 84, 12054, 1 }, { 84, 12055, 1 }, { 84, 12055, 1 }, { 84, 12055, 1 }, { 84, 12052, 1 },
+  { 85, 12049, 1 }, { 84, 12046, 1 }, { 85, 12043, 1 }, { 85, 12041, 1 }, { 85, 12037, 1 }, { 85, 12035, 1 },
+  { 85, 12033, 1 }, { 85, 12030, 1 }, { 85, 12026, 1 }, { 85, 12021, 1 }, { 86, 12015, 1 }, { 86, 12009, 1 },
+  { 86, 12005, 1 }, { 86, 12003, 1 }, { 85, 12004, 1 }, { 85, 12009, 1 }, { 84, 12016, 1 }, { 84, 12021, 1 },
+  { 85, 12023, 1 }, { 85, 12021, 1 }, { 85, 12019, 1 }, { 85, 12016, 1 }, { 85, 12012, 1 }, { 86, 12009, 1 },
+  { 85, 12009, 1 }, { 85, 12009, 1 }, { 85, 12008, 1 }, { 86, 12005, 1 }, { 86, 12001, 1 }, { 85, 12001, 1 },
+  { 85, 12001, 1 }, { 85, 12000, 1 }, { 86, 11996, 1 }, { 86, 11994, 1 }, { 86, 11993, 1 }, { 86, 11992, 1 },
+  { 86, 11991, 1 }, { 86, 11989, 1 }, { 86, 11989, 1 }, { 86, 11986, 1 }, { 86, 11986, 1 }, { 86, 11985, 1 },
+  { 85, 11987, 1 }, { 86, 11983, 1 }, { 87, 11971, 1 }, { 88, 11955, 1 }, { 89, 11935, 1 }, { 89, 11914, 1 },
+  { 90, 11892, 1 }, { 91, 11867, 1 }, { 91, 11843, 1 }, { 92, 11815, 1 }, { 93, 11786, 1 }, { 94, 11759, 1 },
+  { 94, 11730, 1 }, { 95, 11703, 1 }, { 95, 11677, 1 }, { 96, 11655, 1 }, { 96, 11635, 1 }, { 96, 11614, 1 },
+  { 97, 11595, 1 }, { 97, 11578, 1 }, { 97, 11566, 1 }, { 97, 11555, 1 }, { 97, 11546, 1 }, { 97, 11536, 1 },
+  { 97, 11526, 1 }, { 98, 11516, 1 }, { 98, 11506, 1 }, { 97, 11498, 1 }, { 98, 11492, 1 }, { 98, 11484, 1 },
+  { 98, 11478, 1 }, { 98, 11476, 1 }, { 98, 11471, 1 }, { 98, 11468, 1 }, { 98, 11463, 1 }, { 99, 11454, 1 },
+  { 99, 11445, 1 }, { 99, 11439, 1 }, { 99, 11431, 1 }, { 99, 11426, 1 }, { 99, 11423, 1 }, { 99, 11420, 1 },
+  { 100, 11412, 1 }, { 100, 11401, 1 }, { 100, 11392, 1 }, { 100, 11386, 1 }, { 100, 11377, 1 }, { 101, 11366, 1 },
+  { 101, 11358, 1 }, { 101, 11350, 1 }, { 101, 11342, 1 }, { 101, 11335, 1 }, { 101, 11328, 1 }, { 102, 11320, 1 },
+  { 102, 11313, 1 }, { 102, 11303, 1 }, { 102, 11295, 1 }, { 102, 11291, 1 }, { 102, 11287, 1 }, { 102, 11286, 1 },
+  { 102, 11286, 1 }, { 102, 11285, 1 }, { 101, 11286, 1 }, { 102, 11286, 1 }, { 102, 11282, 1 }, { 102, 11280, 1 },
+  { 102, 11280, 1 }, { 101, 11285, 1 }, { 101, 11290, 1 }, { 101, 11293, 1 }, { 101, 11295, 1 }, { 101, 11297, 1 },
+  { 101, 11297, 1 }, { 102, 11296, 1 }, { 102, 11292, 1 }, { 102, 11291, 1 }, { 102, 11290, 1 }, { 102, 11289, 1 },
+  { 102, 11284, 1 }, { 102, 11280, 1 }, { 103, 11274, 1 }, { 102, 11270, 1 }, { 102, 11266, 1 }, { 103, 11261, 1 },
+  { 103, 11255, 1 }, { 103, 11250, 1 }, { 102, 11249, 1 }, { 102, 11252, 1 }, { 101, 11262, 1 }, { 101, 11276, 1 },
+  { 100, 11290, 1 }, { 100, 11305, 1 }, { 99, 11322, 1 }, { 99, 11340, 1 }, { 99, 11357, 1 }, { 98, 11373, 1 },
+  { 98, 11390, 1 }, { 98, 11405, 1 }, { 97, 11418, 1 }, { 98, 11428, 1 }, { 98, 11434, 1 }, { 98, 11440, 1 },
+  { 98, 11447, 1 }, { 97, 11453, 1 }, { 98, 11456, 1 }, { 98, 11457, 1 }, { 98, 11460, 1 }, { 98, 11462, 1 },
+  { 98, 11463, 1 }, { 98, 11461, 1 }, { 98, 11460, 1 }, { 98, 11459, 1 }, { 98, 11459, 1 }, { 97, 11463, 1 },
+  { 97, 11468, 1 }, { 97, 11471, 1 }, { 97, 11471, 1 }, { 98, 11468, 1 }, { 98, 11465, 1 }, { 98, 11462, 1 },
+  { 98, 11458, 1 }, { 98, 11459, 1 }, { 98, 11460, 1 }, { 98, 11462, 1 }, { 98, 11461, 1 }, { 98, 11459, 1 },
+  { 98, 11457, 1 }, { 97, 11459, 1 }, { 98, 11458, 1 }, { 98, 11457, 1 }, { 98, 11457, 1 }, { 98, 11455, 1 },
+  { 98, 11453, 1 }, { 98, 11451, 1 }, { 98, 11449, 1 }, { 98, 11447, 1 }, { 99, 11442, 1 }, { 99, 11435, 1 },
+  { 99, 11430, 1 }, { 99, 11424, 1 }, { 100, 11416, 1 }, { 100, 11408, 1 }, { 100, 11399, 1 }, { 100, 11392, 1 },
+  { 100, 11383, 1 }, { 101, 11374, 1 }, { 101, 11367, 1 }, { 100, 11362, 1 }, { 100, 11359, 1 }, { 100, 11355, 1 },
+  { 101, 11348, 1 }, { 101, 11344, 1 }, { 101, 11339, 1 }, { 101, 11331, 1 }, { 102, 11322, 1 }, { 102, 11311, 1 },
+  { 102, 11302, 1 }, { 102, 11298, 1 }, { 101, 11297, 1 }, { 102, 11296, 1 }, { 102, 11295, 1 }, { 102, 11292, 1 },
+  { 102, 11287, 1 }, { 102, 11281, 1 }, { 103, 11272, 1 }, { 103, 11260, 1 }, { 103, 11250, 1 }, { 104, 11240, 1 },
+  { 104, 11230, 1 }, { 104, 11221, 1 }, { 104, 11215, 1 }, { 104, 11212, 1 }, { 104, 11210, 1 }, { 104, 11208, 1 },
+  { 104, 11206, 1 }, { 104, 11205, 1 }, { 104, 11202, 1 }, { 104, 11201, 1 }, { 104, 11198, 1 }, { 105, 11189, 1 },
+  { 105, 11179, 1 }, { 105, 11172, 1 }, { 105, 11163, 1 }, { 106, 11153, 1 }, { 105, 11147, 1 }, { 105, 11144, 1 },
+  { 105, 11140, 1 }, { 105, 11137, 1 }, { 105, 11132, 1 }, { 106, 11125, 1 }, { 106, 11116, 1 }, { 107, 11107, 1 },
+  { 106, 11100, 1 }, { 107, 11092, 1 }, { 106, 11090, 1 }, { 106, 11087, 1 }, { 107, 11082, 1 }, { 106, 11080, 1 },
+  { 107, 11074, 1 }, { 108, 11064, 1 }, { 108, 11055, 1 }, { 107, 11050, 1 }, { 108, 11044, 1 }, { 108, 11038, 1 },
+  { 107, 11036, 1 }, { 108, 11032, 1 }, { 108, 11026, 1 }, { 108, 11020, 1 }, { 108, 11013, 1 }, { 109, 11004, 1 },
+  { 109, 10998, 1 }, { 109, 10991, 1 }, { 109, 10984, 1 }, { 109, 10979, 1 }, { 110, 10971, 1 }, { 110, 10962, 1 },
+  { 110, 10954, 1 }, { 110, 10945, 1 }, { 110, 10935, 1 }, { 110, 10926, 1 }, { 111, 10918, 1 }, { 111, 10910, 1 },
+  { 111, 10901, 1 }, { 111, 10897, 1 }, { 111, 10893, 1 }, { 111, 10890, 1 }, { 111, 10884, 1 }, { 111, 10878, 1 },
+  { 111, 10875, 1 }, { 111, 10873, 1 }, { 111, 10875, 1 }, { 111, 10876, 1 }, { 111, 10878, 1 }, { 111, 10876, 1 },
+  { 111, 10873, 1 }, { 111, 10869, 1 }, { 111, 10865, 1 }, { 112, 10856, 1 }, { 112, 10847, 1 }, { 112, 10838, 1 },
+  { 113, 10829, 1 }, { 113, 10822, 1 }, { 113, 10817, 1 }, { 113, 10812, 1 }, { 113, 10807, 1 }, { 113, 10799, 1 },
+  { 114, 10788, 1 }, { 114, 10775, 1 }, { 114, 10764, 1 }, { 114, 10757, 1 }, { 114, 10754, 1 }, { 114, 10752, 1 },
+  { 114, 10750, 1 }, { 114, 10748, 1 }, { 115, 10737, 1 }, { 116, 10721, 1 }, { 117, 10701, 1 }, { 117, 10679, 1 },
+  { 118, 10653, 1 }, { 119, 10622, 1 }, { 120, 10588, 1 }, { 121, 10555, 1 }, { 122, 10523, 1 }, { 123, 10489, 1 },
+  { 123, 10460, 1 }, { 123, 10434, 1 }, { 124, 10408, 1 }, { 124, 10381, 1 }, { 125, 10357, 1 }, { 125, 10336, 1 },
+  { 125, 10318, 1 }, { 125, 10303, 1 }, { 126, 10288, 1 }, { 126, 10274, 1 }, { 126, 10259, 1 }, { 126, 10245, 1 },
+  { 126, 10235, 1 }, { 126, 10225, 1 }, { 126, 10215, 1 }, { 127, 10207, 1 }, { 127, 10199, 1 }, { 127, 10192, 1 },
+  { 127, 10183, 1 }, { 127, 10175, 1 }, { 128, 10165, 1 }, { 128, 10153, 1 }, { 128, 10142, 1 }, { 129, 10133, 1 },
+  { 129, 10124, 1 }, { 129, 10114, 1 }, { 129, 10104, 1 }, { 129, 10098, 1 }, { 129, 10095, 1 }, { 129, 10087, 1 },
+  { 129, 10081, 1 }, { 129, 10079, 1 }, { 130, 10073, 1 }, { 130, 10065, 1 }, { 131, 10055, 1 }, { 130, 10047, 1 },
+  { 130, 10041, 1 }, { 130, 10036, 1 }, { 130, 10034, 1 }, { 130, 10031, 1 }, { 130, 10027, 1 }, { 131, 10019, 1 },
+  { 131, 10011, 1 }, { 132, 10002, 1 }, { 132, 9993, 1 }, { 132, 9986, 1 }, { 132, 9979, 1 }, { 132, 9974, 1 },
+  { 132, 9970, 1 }, { 132, 9964, 1 }, { 133, 9956, 1 }, { 133, 9949, 1 }, { 132, 9946, 1 }, { 132, 9941, 1 },
+  { 133, 9931, 1 }, { 134, 9921, 1 }, { 133, 9916, 1 }, { 133, 9913, 1 }, { 133, 9913, 1 }, { 133, 9911, 1 },
+  { 133, 9905, 1 }, { 134, 9898, 1 }, { 134, 9893, 1 }, { 134, 9890, 1 }, { 134, 9883, 1 }, { 135, 9873, 1 },
+  { 135, 9861, 1 }, { 136, 9847, 1 }, { 137, 9831, 1 }, { 137, 9814, 1 }, { 137, 9800, 1 }, { 137, 9787, 1 },
+  { 137, 9775, 1 }, { 138, 9764, 1 }, { 138, 9755, 1 }, { 137, 9753, 1 }, { 136, 9759, 1 }, { 135, 9770, 1 },
+  { 134, 9786, 1 }, { 133, 9804, 1 }, { 133, 9825, 1 }, { 132, 9846, 1 }, { 132, 9865, 1 }, { 132, 9882, 1 },
+  { 132, 9898, 1 }, { 131, 9914, 1 }, { 131, 9932, 1 }, { 130, 9949, 1 }, { 130, 9963, 1 }, { 130, 9974, 1 },
+  { 130, 9985, 1 }, { 130, 9995, 1 }, { 130, 10003, 1 }, { 130, 10010, 1 }, { 130, 10017, 1 }, { 130, 10020, 1 },
+  { 130, 10025, 1 }, { 130, 10030, 1 }, { 130, 10029, 1 }, { 130, 10026, 1 }, { 130, 10023, 1 }, { 131, 10020, 1 },
+  { 131, 10015, 1 }, { 131, 10010, 1 }, { 131, 10005, 1 }, { 131, 10003, 1 }, { 130, 10004, 1 }, { 130, 10007, 1 },
+  { 130, 10010, 1 }, { 130, 10011, 1 }, { 131, 10008, 1 }, { 131, 10006, 1 }, { 130, 10008, 1 }, { 130, 10012, 1 },
+  { 130, 10018, 1 }, { 130, 10021, 1 }, { 131, 10020, 1 }, { 131, 10016, 1 }, { 131, 10009, 1 }, { 132, 10001, 1 },
+  { 132, 9993, 1 }, { 132, 9987, 1 }, { 132, 9981, 1 }, { 132, 9976, 1 }, { 132, 9969, 1 }, { 132, 9965, 1 },
+  { 132, 9959, 1 }, { 132, 9954, 1 }, { 132, 9951, 1 }, { 132, 9947, 1 }, { 133, 9941, 1 }, { 133, 9934, 1 },
+  { 133, 9926, 1 }, { 133, 9924, 1 }, { 133, 9920, 1 }, { 133, 9917, 1 }, { 133, 9915, 1 }, { 133, 9915, 1 },
+  { 133, 9912, 1 }, { 134, 9904, 1 }, { 134, 9895, 1 }, { 135, 9886, 1 }, { 135, 9876, 1 }, { 135, 9869, 1 },
+  { 135, 9864, 1 }, { 134, 9861, 1 }, { 135, 9855, 1 }, { 135, 9847, 1 }, { 135, 9841, 1 }, { 135, 9836, 1 },
+  { 136, 9829, 1 }, { 136, 9822, 1 }, { 135, 9818, 1 }, { 135, 9817, 1 }, { 135, 9817, 1 }, { 135, 9817, 1 },
+  { 135, 9818, 1 }, { 135, 9818, 1 }, { 135, 9818, 1 }, { 135, 9816, 1 }, { 135, 9813, 1 }, { 136, 9808, 1 },
+  { 136, 9804, 1 }, { 136, 9803, 1 }, { 136, 9801, 1 }, { 136, 9799, 1 }, { 136, 9795, 1 }, { 136, 9789, 1 },
+  { 137, 9780, 1 }, { 137, 9770, 1 }, { 138, 9758, 1 }, { 138, 9747, 1 }, { 138, 9739, 1 }, { 137, 9736, 1 },
+  { 137, 9734, 1 }, { 138, 9731, 1 }, { 137, 9730, 1 }, { 137, 9731, 1 }, { 137, 9732, 1 }, { 137, 9732, 1 },
+  { 138, 9730, 1 }, { 137, 9728, 1 }, { 137, 9726, 1 }, { 138, 9724, 1 }, { 137, 9723, 1 }, { 137, 9722, 1 },
+  { 138, 9720, 1 }, { 138, 9717, 1 }, { 138, 9715, 1 }, { 138, 9714, 1 }, { 137, 9715, 1 }, { 137, 9717, 1 },
+  { 138, 9716, 1 }, { 138, 9715, 1 }, { 138, 9711, 1 }, { 138, 9708, 1 }, { 138, 9705, 1 }, { 138, 9700, 1 },
+  { 139, 9695, 1 }, { 139, 9690, 1 }, { 139, 9686, 1 }, { 139, 9682, 1 }, { 139, 9679, 1 }, { 139, 9676, 1 },
+  { 139, 9675, 1 }, { 139, 9672, 1 }, { 140, 9664, 1 }, { 140, 9654, 1 }, { 140, 9644, 1 }, { 141, 9633, 1 },
+  { 141, 9626, 1 }, { 140, 9621, 1 }, { 141, 9615, 1 }, { 141, 9610, 1 }, { 140, 9608, 1 }, { 141, 9603, 1 },
+  { 141, 9597, 1 }, { 141, 9592, 1 }, { 141, 9590, 1 }, { 141, 9587, 1 }, { 141, 9584, 1 }, { 141, 9581, 1 },
+  { 141, 9578, 1 }, { 141, 9577, 1 }, { 141, 9577, 1 }, { 141, 9578, 1 }, { 141, 9579, 1 }, { 141, 9582, 1 },
+  { 141, 9584, 1 }, { 141, 9586, 1 }, { 141, 9586, 1 }, { 141, 9584, 1 }, { 141, 9582, 1 }, { 141, 9580, 1 },
+  { 141, 9580, 1 }, { 141, 9578, 1 }, { 141, 9580, 1 }, { 141, 9583, 1 }, { 140, 9587, 1 }, { 141, 9589, 1 },
+  { 140, 9591, 1 }, { 141, 9589, 1 }, { 141, 9586, 1 }, { 142, 9579, 1 }, { 142, 9568, 1 }, { 143, 9552, 1 },
+  { 144, 9534, 1 }, { 145, 9513, 1 }, { 146, 9492, 1 }, { 146, 9469, 1 }, { 147, 9448, 1 }, { 147, 9429, 1 },
+  { 147, 9412, 1 }, { 147, 9398, 1 }, { 148, 9385, 1 }, { 148, 9372, 1 }, { 148, 9358, 1 }, { 149, 9345, 1 },
+  { 149, 9332, 1 }, { 149, 9320, 1 }, { 149, 9310, 1 }, { 150, 9298, 1 }, { 150, 9288, 1 }, { 149, 9283, 1 },
+  { 149, 9278, 1 }, { 150, 9273, 1 }, { 150, 9268, 1 }, { 150, 9263, 1 }, { 150, 9259, 1 }, { 150, 9256, 1 },
+  { 150, 9251, 1 }, { 150, 9248, 1 }, { 150, 9246, 1 }, { 150, 9242, 1 }, { 151, 9238, 1 }, { 151, 9234, 1 },
+  { 151, 9231, 1 }, { 151, 9229, 1 }, { 151, 9226, 1 }, { 150, 9225, 1 }, { 151, 9221, 1 }, { 151, 9219, 1 },
+  { 151, 9218, 1 }, { 151, 9215, 1 }, { 151, 9213, 1 }, { 151, 9209, 1 }, { 152, 9203, 1 }, { 152, 9198, 1 },
+  { 152, 9196, 1 }, { 152, 9193, 1 }, { 152, 9188, 1 }, { 152, 9182, 1 }, { 153, 9172, 1 }, { 153, 9163, 1 },
+  { 153, 9156, 1 }, { 153, 9152, 1 }, { 153, 9151, 1 }, { 153, 9151, 1 }, { 152, 9152, 1 }, { 152, 9153, 1 },
+  { 153, 9153, 1 }, { 153, 9152, 1 }, { 152, 9152, 1 }, { 153, 9151, 1 }, { 153, 9150, 1 }, { 153, 9150, 1 },
+  { 152, 9151, 1 }, { 152, 9153, 1 }, { 152, 9155, 1 }, { 152, 9156, 1 }, { 152, 9156, 1 }, { 153, 9154, 1 },
+  { 153, 9152, 1 }, { 152, 9151, 1 }, { 153, 9148, 1 }, { 153, 9146, 1 }, { 153, 9144, 1 }, { 153, 9144, 1 },
+  { 153, 9144, 1 }, { 153, 9145, 1 }, { 152, 9148, 1 }, { 152, 9154, 1 }, { 152, 9158, 1 }, { 152, 9160, 1 },
+  { 152, 9160, 1 }, { 152, 9161, 1 }, { 152, 9163, 1 }, { 152, 9167, 1 }, { 151, 9175, 1 }, { 150, 9188, 1 },
+  { 149, 9203, 1 }, { 149, 9220, 1 }, { 148, 9238, 1 }, { 148, 9255, 1 }, { 147, 9273, 1 }, { 146, 9292, 1 },
+  { 146, 9311, 1 }, { 145, 9329, 1 }, { 145, 9344, 1 }, { 145, 9357, 1 }, { 145, 9369, 1 }, { 145, 9383, 1 },
+  { 144, 9395, 1 }, { 145, 9403, 1 }, { 144, 9412, 1 }, { 144, 9422, 1 }, { 144, 9432, 1 }, { 143, 9444, 1 },
+  { 143, 9454, 1 }, { 143, 9464, 1 }, { 143, 9472, 1 }, { 143, 9477, 1 }, { 143, 9481, 1 }, { 143, 9487, 1 },
+  { 143, 9493, 1 }, { 142, 9502, 1 }, { 142, 9511, 1 }, { 142, 9517, 1 }, { 142, 9524, 1 }, { 142, 9530, 1 },
+  { 141, 9537, 1 }, { 141, 9541, 1 }, { 142, 9543, 1 }, { 142, 9545, 1 }, { 141, 9549, 1 }, { 142, 9551, 1 },
+  { 141, 9554, 1 }, { 141, 9558, 1 }, { 141, 9561, 1 }, { 141, 9562, 1 }, { 141, 9563, 1 }, { 141, 9562, 1 },
+  { 141, 9566, 1 }, { 141, 9570, 1 }, { 141, 9574, 1 }, { 141, 9579, 1 }, { 140, 9585, 1 }, { 140, 9593, 1 },
+  { 140, 9600, 1 }, { 140, 9604, 1 }, { 140, 9607, 1 }, { 140, 9606, 1 }, { 141, 9602, 1 }, { 141, 9600, 1 },
+  { 141, 9598, 1 }, { 140, 9599, 1 }, { 140, 9603, 1 }, { 140, 9607, 1 }, { 140, 9611, 1 }, { 139, 9618, 1 },
+  { 139, 9626, 1 }, { 139, 9630, 1 }, { 139, 9635, 1 }, { 139, 9639, 1 }, { 139, 9641, 1 }, { 139, 9643, 1 },
+  { 139, 9646, 1 }, { 138, 9652, 1 }, { 139, 9657, 1 }, { 139, 9660, 1 }, { 138, 9664, 1 }, { 139, 9667, 1 },
+  { 138, 9670, 1 }, { 138, 9676, 1 }, { 137, 9683, 1 }, { 138, 9688, 1 }, { 138, 9694, 1 }, { 137, 9702, 1 },
+  { 137, 9710, 1 }, { 137, 9716, 1 }, { 137, 9719, 1 }, { 138, 9718, 1 }, { 137, 9719, 1 }, { 137, 9721, 1 },
+  { 137, 9724, 1 }, { 137, 9729, 1 }, { 137, 9733, 1 }, { 137, 9737, 1 }, { 136, 9741, 1 }, { 137, 9746, 1 },
+  { 136, 9749, 1 }, { 136, 9755, 1 }, { 136, 9758, 1 }, { 136, 9760, 1 }, { 136, 9761, 1 }, { 137, 9760, 1 },
+  { 137, 9759, 1 }, { 137, 9756, 1 }, { 137, 9754, 1 }, { 137, 9756, 1 }, { 136, 9757, 1 }, { 136, 9761, 1 },
+  { 136, 9767, 1 }, { 136, 9771, 1 }, { 136, 9775, 1 }, { 135, 9780, 1 }, { 136, 9783, 1 }, { 136, 9785, 1 },
+  { 136, 9786, 1 }, { 136, 9787, 1 }, { 135, 9791, 1 }, { 135, 9795, 1 }, { 135, 9799, 1 }, { 135, 9805, 1 },
+  { 134, 9812, 1 }, { 135, 9815, 1 }, { 135, 9818, 1 }, { 135, 9823, 1 }, { 134, 9827, 1 }, { 135, 9830, 1 },
+  { 134, 9835, 1 }, { 134, 9838, 1 }, { 134, 9841, 1 }, { 134, 9845, 1 }, { 134, 9848, 1 }, { 134, 9852, 1 },
+  { 134, 9856, 1 }, { 133, 9861, 1 }, { 133, 9869, 1 }, { 133, 9877, 1 }, { 133, 9884, 1 }, { 132, 9890, 1 },
+  { 132, 9897, 1 }, { 133, 9900, 1 }, { 133, 9903, 1 }, { 133, 9905, 1 }, { 133, 9908, 1 }, { 132, 9912, 1 },
+  { 132, 9917, 1 }, { 132, 9921, 1 }, { 133, 9923, 1 }, { 132, 9929, 1 }, { 132, 9936, 1 }, { 131, 9942, 1 },
+  { 131, 9949, 1 }, { 131, 9956, 1 }, { 131, 9965, 1 }, { 130, 9973, 1 }, { 130, 9981, 1 }, { 130, 9987, 1 },
+  { 131, 9991, 1 }, { 130, 9998, 1 }, { 130, 10006, 1 }, { 130, 10013, 1 }, { 130, 10021, 1 }, { 129, 10030, 1 },
+  { 129, 10039, 1 }, { 128, 10049, 1 }, { 129, 10054, 1 }, { 129, 10058, 1 }, { 129, 10063, 1 }, { 128, 10073, 1 },
+  { 128, 10083, 1 }, { 128, 10093, 1 }, { 128, 10099, 1 }, { 128, 10098, 1 }, { 129, 10093, 1 }, { 130, 10084, 1 },
+  { 130, 10070, 1 }, { 131, 10056, 1 }, { 131, 10038, 1 }, { 132, 10016, 1 }, { 133, 9992, 1 }, { 134, 9971, 1 },
+  { 133, 9954, 1 }, { 134, 9938, 1 }, { 134, 9922, 1 }, { 134, 9908, 1 }, { 134, 9895, 1 }, { 135, 9883, 1 },
+  { 135, 9870, 1 }, { 135, 9859, 1 }, { 135, 9851, 1 }, { 135, 9844, 1 }, { 135, 9839, 1 }, { 135, 9836, 1 },
+  { 135, 9833, 1 }, { 135, 9834, 1 }, { 135, 9833, 1 }, { 135, 9831, 1 }, { 135, 9832, 1 }, { 134, 9834, 1 },
+  { 134, 9838, 1 }, { 134, 9843, 1 }, { 134, 9847, 1 }, { 134, 9851, 1 }, { 134, 9857, 1 }, { 133, 9864, 1 },
+  { 133, 9871, 1 }, { 133, 9877, 1 }, { 133, 9881, 1 }, { 133, 9881, 1 }, { 134, 9875, 1 }, { 135, 9868, 1 },
+  { 134, 9866, 1 }, { 134, 9866, 1 }, { 134, 9865, 1 }, { 134, 9865, 1 }, { 133, 9868, 1 }, { 134, 9871, 1 },
+  { 134, 9872, 1 }, { 133, 9874, 1 }, { 134, 9876, 1 }, { 134, 9878, 1 }, { 134, 9878, 1 }, { 133, 9880, 1 },
+  { 133, 9882, 1 }, { 134, 9883, 1 }, { 133, 9887, 1 }, { 133, 9893, 1 }, { 133, 9897, 1 }, { 133, 9902, 1 },
+  { 132, 9908, 1 }, { 132, 9913, 1 }, { 132, 9919, 1 }, { 132, 9926, 1 }, { 132, 9932, 1 }, { 132, 9939, 1 },
+  { 131, 9946, 1 }, { 131, 9957, 1 }, { 130, 9967, 1 }, { 131, 9977, 1 }, { 130, 9986, 1 }, { 130, 9994, 1 },
+  { 130, 10000, 1 }, { 130, 10004, 1 }, { 130, 10010, 1 }, { 130, 10014, 1 }, { 130, 10021, 1 }, { 129, 10032, 1 },
+  { 128, 10045, 1 }, { 128, 10059, 1 }, { 127, 10078, 1 }, { 127, 10093, 1 }, { 128, 10101, 1 }, { 128, 10104, 1 },
+  { 128, 10103, 1 }, { 128, 10103, 1 }, { 128, 10106, 1 }, { 128, 10113, 1 }, { 127, 10124, 1 }, { 126, 10137, 1 },
+  { 126, 10155, 1 }, { 124, 10178, 1 }, { 123, 10205, 1 }, { 122, 10235, 1 }, { 122, 10263, 1 }, { 121, 10292, 1 },
+  { 120, 10322, 1 }, { 120, 10354, 1 }, { 119, 10385, 1 }, { 118, 10414, 1 }, { 118, 10442, 1 }, { 117, 10467, 1 },
+  { 117, 10489, 1 }, { 117, 10509, 1 }, { 117, 10528, 1 }, { 116, 10547, 1 }, { 116, 10564, 1 }, { 116, 10581, 1 },
+  { 115, 10599, 1 }, { 115, 10618, 1 }, { 114, 10635, 1 }, { 114, 10653, 1 }, { 113, 10673, 1 }, { 113, 10692, 1 },
+  { 113, 10711, 1 }, { 112, 10731, 1 }, { 112, 10748, 1 }, { 112, 10760, 1 }, { 113, 10767, 1 }, { 112, 10775, 1 },
+  { 112, 10782, 1 }, { 112, 10790, 1 }, { 112, 10798, 1 }, { 112, 10807, 1 }, { 111, 10818, 1 }, { 112, 10823, 1 },
+  { 112, 10826, 1 }, { 112, 10828, 1 }, { 111, 10833, 1 }, { 111, 10842, 1 }, { 111, 10851, 1 }, { 110, 10859, 1 },
+  { 110, 10866, 1 }, { 110, 10875, 1 }, { 109, 10887, 1 }, { 109, 10899, 1 }, { 109, 10911, 1 }, { 109, 10922, 1 },
+  { 109, 10931, 1 }, { 109, 10936, 1 }, { 109, 10940, 1 }, { 109, 10943, 1 }, { 109, 10947, 1 }, { 109, 10951, 1 },
+  { 109, 10954, 1 }, { 109, 10954, 1 }, { 109, 10955, 1 }, { 109, 10958, 1 }, { 109, 10961, 1 }, { 108, 10966, 1 },
+  { 108, 10972, 1 }, { 108, 10981, 1 }, { 107, 10993, 1 }, { 107, 11002, 1 }, { 107, 11011, 1 }, { 106, 11023, 1 },
+  { 107, 11031, 1 }, { 107, 11038, 1 }, { 107, 11040, 1 }, { 107, 11040, 1 }, { 107, 11042, 1 }, { 106, 11049, 1 },
+  { 105, 11062, 1 }, { 105, 11075, 1 }, { 105, 11085, 1 }, { 105, 11094, 1 }, { 105, 11103, 1 }, { 105, 11110, 1 },
+  { 105, 11113, 1 }, { 106, 11115, 1 }, { 105, 11120, 1 }, { 105, 11127, 1 }, { 104, 11137, 1 }, { 104, 11146, 1 },
+  { 104, 11157, 1 }, { 103, 11168, 1 }, { 103, 11179, 1 }, { 103, 11191, 1 }, { 102, 11205, 1 }, { 102, 11221, 1 },
+  { 102, 11234, 1 }, { 102, 11245, 1 }, { 102, 11252, 1 }, { 102, 11258, 1 }, { 102, 11261, 1 }, { 102, 11264, 1 },
+  { 102, 11268, 1 }, { 101, 11275, 1 }, { 101, 11280, 1 }, { 101, 11286, 1 }, { 101, 11292, 1 }, { 101, 11298, 1 },
+  { 101, 11305, 1 }, { 100, 11314, 1 }, { 99, 11327, 1 }, { 99, 11342, 1 }, { 99, 11353, 1 }, { 99, 11363, 1 },
+  { 99, 11370, 1 }, { 99, 11375, 1 }, { 99, 11381, 1 }, { 99, 11387, 1 }, { 99, 11393, 1 }, { 99, 11399, 1 },
+  { 99, 11404, 1 }, { 98, 11411, 1 }, { 98, 11417, 1 }, { 98, 11425, 1 }, { 98, 11434, 1 }, { 98, 11441, 1 },
+  { 97, 11451, 1 }, { 97, 11461, 1 }, { 97, 11470, 1 }, { 97, 11477, 1 }, { 97, 11484, 1 }, { 96, 11495, 1 },
+  { 96, 11507, 1 }, { 95, 11521, 1 }, { 95, 11534, 1 }, { 95, 11546, 1 }, { 95, 11557, 1 }, { 94, 11568, 1 },
+  { 95, 11576, 1 }, { 94, 11586, 1 }, { 94, 11591, 1 }, { 95, 11593, 1 }, { 95, 11593, 1 }, { 94, 11596, 1 },
+  { 94, 11600, 1 }, { 94, 11605, 1 }, { 94, 11609, 1 }, { 94, 11612, 1 }, { 95, 11612, 1 }, { 94, 11611, 1 },
+  { 94, 11610, 1 }, { 95, 11607, 1 }, { 94, 11608, 1 }, { 94, 11612, 1 }, { 94, 11619, 1 }, { 93, 11626, 1 },
+  { 93, 11636, 1 }, { 93, 11645, 1 }, { 93, 11654, 1 }, { 93, 11660, 1 }, { 93, 11665, 1 }, { 92, 11672, 1 },
+  { 92, 11681, 1 }, { 92, 11691, 1 }, { 92, 11700, 1 }, { 91, 11708, 1 }, { 92, 11713, 1 }, { 92, 11716, 1 },
+  { 92, 11718, 1 }, { 92, 11722, 1 }, { 91, 11727, 1 }, { 91, 11734, 1 }, { 91, 11741, 1 }, { 91, 11747, 1 },
+  { 91, 11747, 1 }, { 92, 11741, 1 }, { 92, 11732, 1 }, { 93, 11721, 1 }, { 94, 11707, 1 }, { 94, 11694, 1 },
+  { 94, 11679, 1 }, { 95, 11664, 1 }, { 95, 11650, 1 }, { 95, 11633, 1 }, { 96, 11615, 1 }, { 96, 11596, 1 },
+  { 97, 11576, 1 }, { 97, 11561, 1 }, { 97, 11551, 1 }, { 97, 11543, 1 }, { 97, 11534, 1 }, { 97, 11528, 1 },
+  { 97, 11523, 1 }, { 97, 11521, 1 }, { 96, 11522, 1 }, { 97, 11519, 1 }, { 97, 11514, 1 }, { 97, 11510, 1 },
+  { 97, 11509, 1 }, { 97, 11510, 1 }, { 96, 11515, 1 }, { 96, 11519, 1 }, { 96, 11522, 1 }, { 96, 11528, 1 },
+  { 96, 11532, 1 }, { 95, 11538, 1 }, { 96, 11542, 1 }, { 95, 11546, 1 }, { 96, 11547, 1 }, { 95, 11550, 1 },
+  { 95, 11555, 1 }, { 95, 11559, 1 }, { 95, 11562, 1 }, { 95, 11566, 1 }, { 95, 11570, 1 }, { 95, 11576, 1 },
+  { 94, 11584, 1 }, { 94, 11593, 1 }, { 94, 11602, 1 }, { 93, 11612, 1 }, { 93, 11622, 1 }, { 93, 11630, 1 },
+  { 93, 11635, 1 }, { 93, 11639, 1 }, { 93, 11644, 1 }, { 93, 11651, 1 }, { 93, 11657, 1 }, { 92, 11664, 1 },
+  { 92, 11671, 1 }, { 93, 11676, 1 }, { 92, 11680, 1 }, { 93, 11684, 1 }, { 92, 11689, 1 }, { 92, 11695, 1 },
+  { 92, 11702, 1 }, { 91, 11711, 1 }, { 91, 11719, 1 }, { 91, 11726, 1 }, { 91, 11732, 1 }, { 91, 11734, 1 },
+  { 91, 11737, 1 }, { 91, 11744, 1 }, { 90, 11753, 1 }, { 90, 11761, 1 }, { 90, 11768, 1 }, { 90, 11776, 1 },
+  { 90, 11783, 1 }, { 90, 11786, 1 }, { 90, 11788, 1 }, { 90, 11791, 1 }, { 90, 11796, 1 }, { 89, 11801, 1 },
+  { 90, 11804, 1 }, { 90, 11805, 1 }, { 90, 11806, 1 }, { 90, 11810, 1 }, { 89, 11815, 1 }, { 89, 11820, 1 },
+  { 89, 11828, 1 }, { 88, 11842, 1 }, { 87, 11858, 1 }, { 86, 11878, 1 }, { 86, 11898, 1 }, { 85, 11920, 1 },
+  { 85, 11941, 1 }, { 84, 11963, 1 }, { 83, 11989, 1 }, { 82, 12016, 1 }, { 82, 12043, 1 }, { 81, 12068, 1 },
+  { 81, 12091, 1 }, { 81, 12108, 1 }, { 81, 12124, 1 }, { 80, 12140, 1 }, { 80, 12156, 1 }, { 80, 12171, 1 },
+  { 79, 12186, 1 }, { 79, 12200, 1 }, { 79, 12213, 1 }, { 79, 12226, 1 }, { 78, 12238, 1 }, { 78, 12249, 1 },
+  { 78, 12261, 1 }, { 78, 12273, 1 }, { 77, 12287, 1 }, { 76, 12302, 1 }, { 77, 12312, 1 }, { 77, 12322, 1 },
+  { 76, 12332, 1 }, { 76, 12342, 1 }, { 76, 12351, 1 }, { 76, 12359, 1 }, { 76, 12368, 1 }, { 75, 12376, 1 },
+  { 75, 12385, 1 }, { 75, 12394, 1 }, { 75, 12398, 1 }, { 75, 12403, 1 }, { 75, 12408, 1 }, { 75, 12411, 1 },
+  { 75, 12414, 1 }, { 75, 12417, 1 }, { 75, 12422, 1 }, { 74, 12427, 1 }, { 74, 12431, 1 }, { 75, 12434, 1 },
+  { 74, 12441, 1 }, { 74, 12450, 1 }, { 74, 12456, 1 }, { 73, 12462, 1 }, { 73, 12468, 1 }, { 73, 12475, 1 },
+  { 73, 12482, 1 }, { 73, 12487, 1 }, { 73, 12489, 1 }, { 73, 12493, 1 }, { 72, 12502, 1 }, { 72, 12510, 1 },
+  { 72, 12514, 1 }, { 72, 12517, 1 }, { 72, 12520, 1 }, { 72, 12523, 1 }, { 72, 12525, 1 }, { 73, 12525, 1 },
+  { 72, 12525, 1 }, { 72, 12528, 1 }, { 72, 12532, 1 }, { 72, 12535, 1 }, { 72, 12536, 1 }, { 72, 12539, 1 },
+  { 72, 12541, 1 }, { 71, 12546, 1 }, { 71, 12551, 1 }, { 71, 12556, 1 }, { 71, 12563, 1 }, { 70, 12572, 1 },
+  { 70, 12581, 1 }, { 70, 12588, 1 }, { 70, 12594, 1 }, { 70, 12599, 1 }, { 70, 12602, 1 }, { 70, 12607, 1 },
+  { 69, 12613, 1 }, { 70, 12617, 1 }, { 70, 12618, 1 }, { 70, 12618, 1 }, { 70, 12617, 1 }, { 70, 12617, 1 },
+  { 70, 12618, 1 }, { 70, 12620, 1 }, { 70, 12622, 1 }, { 70, 12624, 1 }, { 70, 12625, 1 }, { 69, 12627, 1 },
+  { 70, 12626, 1 }, { 70, 12625, 1 }, { 70, 12625, 1 }, { 70, 12627, 1 }, { 70, 12628, 1 }, { 70, 12628, 1 },
+  { 70, 12627, 1 }, { 70, 12625, 1 }, { 70, 12625, 1 }, { 70, 12625, 1 }, { 70, 12625, 1 }, { 70, 12626, 1 },
+  { 70, 12627, 1 }, { 70, 12626, 1 }, { 70, 12625, 1 }, { 70, 12625, 1 }, { 70, 12624, 1 }, { 70, 12623, 1 },
+  { 70, 12620, 1 }, { 70, 12621, 1 }, { 69, 12624, 1 }, { 70, 12625, 1 }, { 70, 12626, 1 }, { 70, 12626, 1 },
+  { 70, 12627, 1 }, { 70, 12628, 1 }, { 69, 12630, 1 }, { 70, 12630, 1 }, { 70, 12630, 1 }, { 70, 12630, 1 },
+  { 70, 12628, 1 }, { 70, 12626, 1 }, { 69, 12629, 1 }, { 69, 12634, 1 }, { 69, 12637, 1 }, { 69, 12641, 1 },
+  { 69, 12646, 1 }, { 68, 12651, 1 }, { 69, 12655, 1 }, { 69, 12659, 1 }, { 68, 12663, 1 }, { 68, 12667, 1 },
+  { 68, 12672, 1 }, { 68, 12677, 1 }, { 68, 12678, 1 }, { 69, 12675, 1 }, { 69, 12672, 1 }, { 69, 12670, 1 },
+  { 69, 12669, 1 }, { 69, 12670, 1 }, { 69, 12668, 1 }, { 69, 12666, 1 }, { 69, 12665, 1 }, { 69, 12663, 1 },
+  { 69, 12661, 1 }, { 69, 12657, 1 }, { 69, 12655, 1 }, { 69, 12655, 1 }, { 69, 12657, 1 }, { 69, 12657, 1 },
+  { 69, 12657, 1 }, { 69, 12654, 1 }, { 69, 12653, 1 }, { 69, 12653, 1 }, { 69, 12655, 1 }, { 69, 12654, 1 },
+  { 69, 12653, 1 }, { 69, 12653, 1 }, { 69, 12655, 1 }, { 69, 12657, 1 }, { 68, 12660, 1 }, { 69, 12663, 1 },
+  { 68, 12666, 1 }, { 69, 12664, 1 }, { 70, 12652, 1 }, { 71, 12637, 1 }, { 72, 12620, 1 }, { 72, 12602, 1 },
+  { 73, 12585, 1 }, { 73, 12569, 1 }, { 73, 12554, 1 }, { 74, 12538, 1 }, { 74, 12523, 1 }, { 74, 12509, 1 },
+  { 75, 12494, 1 }, { 76, 12475, 1 }, { 76, 12453, 1 }, { 77, 12433, 1 }, { 77, 12415, 1 }, { 77, 12400, 1 },
+  { 78, 12384, 1 }, { 78, 12370, 1 }, { 78, 12357, 1 }, { 78, 12345, 1 }, { 79, 12333, 1 }, { 79, 12323, 1 },
+  { 79, 12316, 1 }, { 78, 12311, 1 }, { 78, 12307, 1 }, { 78, 12304, 1 }, { 79, 12300, 1 }, { 79, 12293, 1 },
+  { 79, 12287, 1 }, { 79, 12283, 1 }, { 79, 12284, 1 }, { 78, 12289, 1 }, { 78, 12292, 1 }, { 78, 12294, 1 },
+  { 78, 12294, 1 }, { 79, 12292, 1 }, { 79, 12289, 1 }, { 79, 12289, 1 }, { 78, 12290, 1 }, { 79, 12290, 1 },
+  { 79, 12288, 1 }, { 78, 12288, 1 }, { 78, 12289, 1 }, { 79, 12288, 1 }, { 79, 12286, 1 }, { 79, 12286, 1 },
+  { 78, 12287, 1 }, { 78, 12289, 1 }, { 78, 12289, 1 }, { 79, 12285, 1 }, { 80, 12278, 1 }, { 80, 12270, 1 },
+  { 80, 12263, 1 }, { 80, 12259, 1 }, { 79, 12259, 1 }, { 79, 12262, 1 }, { 79, 12267, 1 }, { 78, 12273, 1 },
+  { 78, 12278, 1 }, { 79, 12280, 1 }, { 79, 12278, 1 }, { 79, 12276, 1 }, { 79, 12275, 1 }, { 79, 12273, 1 },
+  { 79, 12271, 1 }, { 79, 12268, 1 }, { 79, 12266, 1 }, { 79, 12266, 1 }, { 79, 12266, 1 }, { 79, 12266, 1 },
+  { 79, 12266, 1 }, { 79, 12265, 1 }, { 79, 12264, 1 }, { 79, 12265, 1 }, { 79, 12265, 1 }, { 79, 12266, 1 },
+  { 79, 12267, 1 }, { 79, 12267, 1 }, { 79, 12267, 1 }, { 79, 12264, 1 }, { 79, 12263, 1 }, { 79, 12262, 1 },
+  { 80, 12260, 1 }, { 79, 12259, 1 }, { 79, 12264, 1 }, { 78, 12273, 1 }, { 77, 12285, 1 }, { 77, 12300, 1 },
+  { 76, 12318, 1 }, { 76, 12336, 1 }, { 75, 12353, 1 }, { 75, 12369, 1 }, { 75, 12383, 1 }, { 74, 12397, 1 },
+  { 74, 12412, 1 }, { 73, 12428, 1 }, { 73, 12442, 1 }, { 73, 12457, 1 }, { 72, 12474, 1 }, { 72, 12488, 1 },
+  { 72, 12497, 1 }, { 72, 12507, 1 }, { 72, 12517, 1 }, { 72, 12524, 1 }, { 72, 12527, 1 }, { 73, 12526, 1 },
+  { 73, 12526, 1 }, { 72, 12525, 1 }, { 73, 12523, 1 }, { 73, 12520, 1 }, { 72, 12521, 1 }, { 72, 12524, 1 },
+  { 72, 12527, 1 }, { 72, 12528, 1 }, { 72, 12529, 1 }, { 72, 12531, 1 }, { 72, 12537, 1 }, { 71, 12546, 1 },
+  { 71, 12553, 1 }, { 71, 12558, 1 }, { 71, 12562, 1 }, { 71, 12564, 1 }, { 72, 12565, 1 }, { 71, 12564, 1 },
+  { 72, 12562, 1 }, { 72, 12561, 1 }, { 72, 12556, 1 }, { 72, 12551, 1 }, { 73, 12545, 1 }, { 73, 12535, 1 },
+  { 74, 12525, 1 }, { 74, 12514, 1 }, { 74, 12503, 1 }, { 74, 12494, 1 }, { 74, 12487, 1 }, { 74, 12483, 1 },
+  { 74, 12480, 1 }, { 74, 12475, 1 }, { 75, 12468, 1 }, { 75, 12463, 1 }, { 75, 12460, 1 }, { 74, 12461, 1 },
+  { 74, 12463, 1 }, { 74, 12465, 1 }, { 74, 12464, 1 }, { 74, 12463, 1 }, { 74, 12462, 1 }, { 75, 12458, 1 },
+  { 75, 12453, 1 }, { 75, 12451, 1 }, { 75, 12446, 1 }, { 75, 12443, 1 }, { 75, 12440, 1 }, { 75, 12437, 1 },
+  { 75, 12435, 1 }, { 75, 12430, 1 }, { 76, 12425, 1 }, { 76, 12420, 1 }, { 76, 12415, 1 }, { 76, 12410, 1 },
+  { 76, 12406, 1 }, { 76, 12403, 1 }, { 77, 12397, 1 }, { 76, 12395, 1 }, { 75, 12397, 1 }, { 76, 12399, 1 },
+  { 76, 12399, 1 }, { 76, 12399, 1 }, { 76, 12399, 1 }, { 76, 12395, 1 }, { 77, 12389, 1 }, { 77, 12383, 1 },
+  { 76, 12381, 1 }, { 77, 12378, 1 }, { 77, 12375, 1 }, { 76, 12373, 1 }, { 76, 12373, 1 }, { 76, 12374, 1 },
+  { 76, 12373, 1 }, { 77, 12368, 1 }, { 77, 12362, 1 }, { 77, 12357, 1 }, { 77, 12355, 1 }, { 77, 12351, 1 },
+  { 78, 12346, 1 }, { 78, 12342, 1 }, { 77, 12339, 1 }, { 77, 12338, 1 }, { 77, 12337, 1 }, { 77, 12336, 1 },
+  { 78, 12330, 1 }, { 78, 12323, 1 }, { 79, 12314, 1 }, { 78, 12309, 1 }, { 78, 12307, 1 }, { 79, 12302, 1 },
+  { 79, 12296, 1 }, { 79, 12291, 1 }, { 79, 12288, 1 }, { 79, 12285, 1 }, { 79, 12283, 1 }, { 79, 12282, 1 },
+  { 78, 12283, 1 }, { 79, 12279, 1 }, { 79, 12274, 1 }, { 80, 12267, 1 }, { 80, 12260, 1 }, { 80, 12256, 1 },
+  { 80, 12254, 1 }, { 79, 12254, 1 }, { 79, 12254, 1 }, { 79, 12252, 1 }, { 80, 12245, 1 }, { 81, 12235, 1 },
+  { 81, 12228, 1 }, { 81, 12223, 1 }, { 81, 12218, 1 }, { 81, 12214, 1 }, { 81, 12207, 1 }, { 81, 12201, 1 },
+  { 81, 12197, 1 }, { 81, 12193, 1 }, { 81, 12189, 1 }, { 82, 12183, 1 }, { 82, 12175, 1 }, { 82, 12169, 1 },
+  { 82, 12166, 1 }, { 82, 12162, 1 }, { 82, 12154, 1 }, { 83, 12144, 1 }, { 83, 12136, 1 }, { 83, 12129, 1 },
+  { 84, 12118, 1 }, { 84, 12110, 1 }, { 83, 12105, 1 }, { 83, 12102, 1 }, { 83, 12101, 1 }, { 83, 12102, 1 },
+  { 83, 12102, 1 }, { 83, 12103, 1 }, { 83, 12103, 1 }, { 83, 12102, 1 }, { 83, 12099, 1 }, { 83, 12098, 1 },
+  { 83, 12097, 1 }, { 84, 12094, 1 }, { 84, 12089, 1 }, { 84, 12081, 1 }, { 85, 12072, 1 }, { 85, 12064, 1 },
+  { 85, 12055, 1 }, { 85, 12048, 1 }, { 85, 12041, 1 }, { 86, 12026, 1 }, { 87, 12005, 1 }, { 88, 11980, 1 },
+  { 90, 11950, 1 }, { 90, 11922, 1 }, { 90, 11898, 1 }, { 91, 11871, 1 }, { 92, 11844, 1 }, { 92, 11820, 1 },
+  { 93, 11794, 1 }, { 94, 11766, 1 }, { 94, 11739, 1 }, { 95, 11711, 1 }, { 95, 11685, 1 }, { 96, 11660, 1 },
+  { 96, 11635, 1 }, { 97, 11612, 1 }, { 97, 11590, 1 }, { 97, 11570, 1 }, { 98, 11551, 1 }, { 98, 11533, 1 },
+  { 98, 11515, 1 }, { 98, 11499, 1 }, { 98, 11484, 1 }, { 99, 11471, 1 }, { 99, 11461, 1 }, { 99, 11449, 1 },
+  { 100, 11435, 1 }, { 100, 11423, 1 }, { 100, 11411, 1 }, { 100, 11399, 1 }, { 100, 11389, 1 }, { 101, 11380, 1 },
+  { 101, 11370, 1 }, { 101, 11362, 1 }, { 101, 11354, 1 }, { 101, 11348, 1 }, { 101, 11340, 1 }, { 101, 11334, 1 },
+  { 102, 11325, 1 }, { 102, 11313, 1 }, { 102, 11302, 1 }, { 102, 11295, 1 }, { 102, 11291, 1 }, { 102, 11290, 1 },
+  { 102, 11288, 1 }, { 102, 11285, 1 }, { 102, 11281, 1 }, { 102, 11277, 1 }, { 102, 11274, 1 }, { 103, 11268, 1 },
+  { 103, 11261, 1 }, { 103, 11253, 1 }, { 103, 11244, 1 }, { 104, 11235, 1 }, { 103, 11229, 1 }, { 103, 11225, 1 },
+  { 104, 11221, 1 }, { 104, 11216, 1 }, { 104, 11211, 1 }, { 104, 11205, 1 }, { 104, 11198, 1 }, { 104, 11194, 1 },
+  { 104, 11187, 1 }, { 105, 11180, 1 }, { 105, 11176, 1 }, { 104, 11175, 1 }, { 104, 11173, 1 }, { 105, 11167, 1 },
+  { 105, 11160, 1 }, { 106, 11152, 1 }, { 106, 11144, 1 }, { 105, 11140, 1 }, { 105, 11140, 1 }, { 105, 11139, 1 },
+  { 106, 11136, 1 }, { 105, 11134, 1 }, { 105, 11132, 1 }, { 105, 11130, 1 }, { 105, 11126, 1 }, { 106, 11120, 1 },
+  { 106, 11113, 1 }, { 106, 11105, 1 }, { 106, 11102, 1 }, { 105, 11107, 1 }, { 105, 11119, 1 }, { 103, 11140, 1 },
+  { 102, 11164, 1 }, { 102, 11187, 1 }, { 102, 11208, 1 }, { 101, 11227, 1 }, { 101, 11241, 1 }, { 101, 11256, 1 },
+  { 101, 11270, 1 }, { 101, 11284, 1 }, { 100, 11297, 1 }, { 101, 11306, 1 }, { 100, 11315, 1 }, { 100, 11322, 1 },
+  { 101, 11325, 1 }, { 101, 11327, 1 }, { 100, 11330, 1 }, { 100, 11333, 1 }, { 101, 11334, 1 }, { 101, 11335, 1 },
+  { 101, 11334, 1 }, { 101, 11331, 1 }, { 101, 11326, 1 }, { 101, 11323, 1 }, { 101, 11322, 1 }, { 101, 11316, 1 },
+  { 102, 11309, 1 }, { 102, 11303, 1 }, { 102, 11296, 1 }, { 102, 11290, 1 }, { 103, 11280, 1 }, { 103, 11270, 1 },
+  { 103, 11260, 1 }, { 103, 11255, 1 }, { 103, 11251, 1 }, { 103, 11249, 1 }, { 103, 11249, 1 }, { 103, 11248, 1 },
+  { 103, 11243, 1 }, { 103, 11239, 1 }, { 103, 11239, 1 }, { 103, 11238, 1 }, { 103, 11236, 1 }, { 103, 11234, 1 },
+  { 103, 11236, 1 }, { 102, 11242, 1 }, { 102, 11250, 1 }, { 102, 11256, 1 }, { 102, 11261, 1 }, { 102, 11262, 1 },
+  { 103, 11258, 1 }, { 103, 11254, 1 }, { 103, 11248, 1 }, { 103, 11241, 1 }, { 104, 11229, 1 }, { 104, 11217, 1 },
+  { 105, 11204, 1 }, { 105, 11192, 1 }, { 105, 11182, 1 }, { 105, 11174, 1 }, { 105, 11166, 1 }, { 105, 11157, 1 },
+  { 106, 11147, 1 }, { 106, 11139, 1 }, { 105, 11135, 1 }, { 105, 11134, 1 }, { 105, 11134, 1 }, { 105, 11133, 1 },
+  { 105, 11131, 1 }, { 105, 11129, 1 }, { 105, 11127, 1 }, { 106, 11123, 1 }, { 106, 11116, 1 }, { 106, 11111, 1 },
+  { 106, 11109, 1 }, { 106, 11106, 1 }, { 107, 11099, 1 }, { 106, 11094, 1 }, { 107, 11088, 1 }, { 107, 11078, 1 },
+  { 107, 11071, 1 }, { 107, 11068, 1 }, { 107, 11063, 1 }, { 107, 11060, 1 }, { 107, 11058, 1 }, { 107, 11058, 1 },
+  { 108, 11051, 1 }, { 108, 11044, 1 }, { 108, 11037, 1 }, { 108, 11033, 1 }, { 108, 11029, 1 }, { 108, 11023, 1 },
+  { 108, 11016, 1 }, { 109, 11006, 1 }, { 109, 10995, 1 }, { 110, 10984, 1 }, { 109, 10975, 1 }, { 110, 10967, 1 },
+  { 110, 10961, 1 }, { 110, 10954, 1 }, { 110, 10944, 1 }, { 111, 10931, 1 }, { 111, 10919, 1 }, { 112, 10905, 1 },
+  { 112, 10891, 1 }, { 112, 10881, 1 }, { 111, 10877, 1 }, { 111, 10876, 1 }, { 111, 10875, 1 }, { 111, 10873, 1 },
+  { 111, 10870, 1 }, { 111, 10866, 1 }, { 112, 10862, 1 }, { 112, 10857, 1 }, { 112, 10854, 1 }, { 112, 10849, 1 },
+  { 112, 10843, 1 }, { 112, 10835, 1 }, { 113, 10826, 1 }, { 113, 10819, 1 }, { 113, 10810, 1 }, { 114, 10800, 1 },
+  { 114, 10791, 1 }, { 113, 10785, 1 }, { 114, 10779, 1 }, { 114, 10771, 1 }, { 114, 10767, 1 }, { 114, 10764, 1 },
+  { 114, 10758, 1 }, { 114, 10751, 1 }, { 115, 10744, 1 }, { 114, 10739, 1 }, { 114, 10736, 1 }, { 114, 10733, 1 },
+  { 114, 10731, 1 }, { 114, 10728, 1 }, { 114, 10728, 1 }, { 114, 10729, 1 }, { 114, 10728, 1 }, { 114, 10726, 1 },
+  { 114, 10724, 1 }, { 115, 10719, 1 }, { 115, 10714, 1 }, { 115, 10708, 1 }, { 115, 10702, 1 }, { 116, 10695, 1 },
+  { 116, 10687, 1 }, { 116, 10677, 1 }, { 116, 10668, 1 }, { 117, 10656, 1 }, { 117, 10647, 1 }, { 116, 10642, 1 },
+  { 117, 10635, 1 }, { 117, 10629, 1 }, { 117, 10622, 1 }, { 118, 10613, 1 }, { 117, 10607, 1 }, { 117, 10606, 1 },
+  { 117, 10604, 1 }, { 117, 10602, 1 }, { 117, 10600, 1 }, { 118, 10594, 1 }, { 118, 10588, 1 }, { 118, 10584, 1 },
+  { 118, 10581, 1 }, { 118, 10578, 1 }, { 118, 10574, 1 }, { 118, 10570, 1 }, { 119, 10559, 1 }, { 120, 10542, 1 },
+  { 121, 10521, 1 }, { 122, 10497, 1 }, { 122, 10473, 1 }, { 123, 10447, 1 }, { 124, 10420, 1 }, { 124, 10394, 1 },
+  { 125, 10368, 1 }, { 125, 10344, 1 }, { 126, 10320, 1 }, { 126, 10301, 1 }, { 126, 10285, 1 }, { 126, 10269, 1 },
+  { 127, 10251, 1 }, { 127, 10232, 1 }, { 128, 10214, 1 }, { 128, 10194, 1 }, { 128, 10178, 1 }, { 128, 10166, 1 },
+  { 128, 10154, 1 }, { 128, 10143, 1 }, { 128, 10133, 1 }, { 129, 10123, 1 }, { 130, 10111, 1 }, { 129, 10101, 1 },
+  { 130, 10092, 1 }, { 130, 10082, 1 }, { 130, 10070, 1 }, { 131, 10059, 1 }, { 131, 10048, 1 }, { 131, 10037, 1 },
+  { 131, 10026, 1 }, { 131, 10015, 1 }, { 132, 10004, 1 }, { 131, 10001, 1 }, { 131, 10000, 1 }, { 131, 9997, 1 },
+  { 131, 9996, 1 }, { 131, 9994, 1 }, { 131, 9992, 1 }, { 131, 9992, 1 }, { 131, 9991, 1 }, { 132, 9986, 1 },
+  { 132, 9982, 1 }, { 131, 9983, 1 }, { 131, 9984, 1 }, { 131, 9984, 1 }, { 131, 9984, 1 }, { 132, 9981, 1 },
+  { 132, 9977, 1 }, { 132, 9974, 1 }, { 131, 9974, 1 }, { 132, 9970, 1 }, { 132, 9966, 1 }, { 132, 9963, 1 },
+  { 132, 9962, 1 }, { 132, 9959, 1 }, { 131, 9962, 1 }, { 131, 9966, 1 }, { 131, 9969, 1 }, { 131, 9972, 1 },
+  { 131, 9972, 1 }, { 132, 9969, 1 }, { 132, 9964, 1 }, { 132, 9958, 1 }, { 132, 9956, 1 }, { 132, 9957, 1 },
+  { 132, 9957, 1 }, { 132, 9955, 1 }, { 133, 9950, 1 }, { 133, 9944, 1 }, { 133, 9937, 1 }, { 133, 9928, 1 },
+  { 133, 9923, 1 }, { 133, 9919, 1 }, { 133, 9919, 1 }, { 133, 9918, 1 }, { 133, 9917, 1 }, { 133, 9913, 1 },
+  { 133, 9908, 1 }, { 133, 9907, 1 }, { 133, 9907, 1 }, { 133, 9907, 1 }, { 132, 9915, 1 }, { 131, 9930, 1 },
+  { 130, 9948, 1 }, { 129, 9968, 1 }, { 129, 9991, 1 }, { 128, 10014, 1 }, { 127, 10037, 1 }, { 127, 10057, 1 },
+  { 128, 10074, 1 }, { 127, 10092, 1 }, { 127, 10108, 1 }, { 127, 10120, 1 }, { 127, 10134, 1 }, { 126, 10147, 1 },
+  { 126, 10156, 1 }, { 126, 10165, 1 }, { 126, 10173, 1 }, { 126, 10176, 1 }, { 127, 10176, 1 }, { 127, 10176, 1 },
+  { 127, 10177, 1 }, { 126, 10180, 1 }, { 126, 10187, 1 }, { 126, 10193, 1 }, { 126, 10196, 1 }, { 126, 10200, 1 },
+  { 126, 10204, 1 }, { 125, 10210, 1 }, { 125, 10217, 1 }, { 125, 10222, 1 }, { 125, 10227, 1 }, { 125, 10232, 1 },
+  { 125, 10237, 1 }, { 125, 10241, 1 }, { 125, 10240, 1 }, { 126, 10236, 1 }, { 126, 10232, 1 }, { 126, 10230, 1 },
+  { 125, 10229, 1 }, { 125, 10230, 1 }, { 125, 10233, 1 }, { 125, 10233, 1 }, { 125, 10233, 1 }, { 126, 10231, 1 },
+  { 126, 10229, 1 }, { 125, 10228, 1 }, { 126, 10226, 1 }, { 126, 10225, 1 }, { 125, 10228, 1 }, { 125, 10229, 1 },
+  { 126, 10228, 1 }, { 125, 10228, 1 }, { 126, 10228, 1 }, { 125, 10230, 1 }, { 125, 10233, 1 }, { 125, 10236, 1 },
+  { 125, 10238, 1 }, { 125, 10238, 1 }, { 125, 10237, 1 }, { 125, 10240, 1 }, { 125, 10242, 1 }, { 125, 10244, 1 },
+  { 125, 10247, 1 }, { 125, 10250, 1 }, { 124, 10253, 1 }, { 125, 10254, 1 }, { 125, 10255, 1 }, { 125, 10254, 1 },
+  { 125, 10252, 1 }, { 125, 10249, 1 }, { 125, 10251, 1 }, { 124, 10256, 1 }, { 124, 10261, 1 }, { 124, 10265, 1 },
+  { 124, 10270, 1 }, { 123, 10279, 1 }, { 123, 10287, 1 }, { 124, 10291, 1 }, { 124, 10294, 1 }, { 124, 10297, 1 },
+  { 124, 10299, 1 }, { 124, 10302, 1 }, { 124, 10301, 1 }, { 124, 10296, 1 }, { 125, 10288, 1 }, { 125, 10279, 1 },
+  { 125, 10269, 1 }, { 126, 10256, 1 }, { 126, 10245, 1 }, { 126, 10241, 1 }, { 125, 10241, 1 }, { 125, 10242, 1 },
+  { 125, 10246, 1 }, { 125, 10249, 1 }, { 124, 10253, 1 }, { 124, 10260, 1 }, { 124, 10267, 1 }, { 124, 10273, 1 },
+  { 124, 10276, 1 }, { 125, 10275, 1 }, { 125, 10274, 1 }, { 124, 10273, 1 }, { 125, 10272, 1 }, { 125, 10271, 1 },
+  { 125, 10271, 1 }, { 124, 10272, 1 }, { 124, 10276, 1 }, { 124, 10279, 1 }, { 124, 10281, 1 }, { 124, 10282, 1 },
+  { 124, 10285, 1 }, { 123, 10292, 1 }, { 123, 10297, 1 }, { 124, 10298, 1 }, { 124, 10297, 1 }, { 124, 10295, 1 },
+  { 124, 10294, 1 }, { 124, 10292, 1 }, { 125, 10288, 1 }, { 125, 10283, 1 }, { 125, 10280, 1 }, { 124, 10280, 1 },
+  { 124, 10282, 1 }, { 124, 10281, 1 }, { 124, 10281, 1 }, { 124, 10281, 1 }, { 125, 10281, 1 }, { 123, 10287, 1 },
+  { 123, 10294, 1 }, { 123, 10299, 1 }, { 123, 10304, 1 }, { 123, 10307, 1 }, { 124, 10307, 1 }, { 123, 10311, 1 },
+  { 123, 10318, 1 }, { 123, 10325, 1 }, { 123, 10329, 1 }, { 123, 10334, 1 }, { 122, 10338, 1 }, { 123, 10338, 1 },
+  { 123, 10337, 1 }, { 123, 10336, 1 }, { 123, 10334, 1 }, { 123, 10334, 1 }, { 123, 10333, 1 }, { 123, 10330, 1 },
+  { 123, 10327, 1 }, { 123, 10326, 1 }, { 123, 10329, 1 }, { 123, 10333, 1 }, { 123, 10335, 1 }, { 123, 10334, 1 },
+  { 123, 10336, 1 }, { 123, 10340, 1 }, { 123, 10342, 1 }, { 123, 10346, 1 }, { 122, 10354, 1 }, { 122, 10362, 1 },
+  { 122, 10369, 1 }, { 122, 10374, 1 }, { 122, 10377, 1 }, { 121, 10381, 1 }, { 122, 10385, 1 }, { 122, 10387, 1 },
+  { 121, 10390, 1 }, { 121, 10395, 1 }, { 121, 10400, 1 }, { 121, 10401, 1 }, { 122, 10395, 1 }, { 123, 10383, 1 },
+  { 124, 10368, 1 }, { 125, 10347, 1 }, { 126, 10324, 1 }, { 126, 10305, 1 }, { 125, 10291, 1 }, { 126, 10277, 1 },
+  { 126, 10262, 1 }, { 126, 10248, 1 }, { 126, 10236, 1 }, { 127, 10220, 1 }, { 127, 10205, 1 }, { 128, 10190, 1 },
+  { 128, 10176, 1 }, { 128, 10163, 1 }, { 128, 10153, 1 }, { 128, 10146, 1 }, { 128, 10140, 1 }, { 128, 10136, 1 },
+  { 128, 10132, 1 }, { 128, 10126, 1 }, { 128, 10122, 1 }, { 128, 10120, 1 }, { 128, 10119, 1 }, { 128, 10117, 1 },
+  { 128, 10116, 1 }, { 128, 10117, 1 }, { 128, 10118, 1 }, { 128, 10118, 1 }, { 128, 10121, 1 }, { 127, 10128, 1 },
+  { 127, 10135, 1 }, { 127, 10140, 1 }, { 127, 10142, 1 }, { 127, 10143, 1 }, { 128, 10140, 1 }, { 128, 10137, 1 },
+  { 128, 10133, 1 }, { 128, 10130, 1 }, { 128, 10128, 1 }, { 128, 10127, 1 }, { 128, 10127, 1 }, { 127, 10129, 1 },
+  { 128, 10128, 1 }, { 128, 10125, 1 }, { 128, 10122, 1 }, { 128, 10121, 1 }, { 128, 10119, 1 }, { 128, 10117, 1 },
+  { 128, 10116, 1 }, { 128, 10118, 1 }, { 127, 10123, 1 }, { 128, 10126, 1 }, { 128, 10122, 1 }, { 128, 10120, 1 },
+  { 128, 10121, 1 }, { 128, 10122, 1 }, { 128, 10124, 1 }, { 127, 10128, 1 }, { 128, 10130, 1 }, { 127, 10134, 1 },
+  { 127, 10138, 1 }, { 127, 10141, 1 }, { 127, 10146, 1 }, { 127, 10153, 1 }, { 127, 10157, 1 }, { 127, 10160, 1 },
+  { 127, 10163, 1 }, { 127, 10168, 1 }, { 126, 10173, 1 }, { 126, 10179, 1 }, { 126, 10185, 1 }, { 126, 10192, 1 },
+  { 126, 10198, 1 }, { 126, 10204, 1 }, { 125, 10211, 1 }, { 125, 10218, 1 }, { 125, 10226, 1 }, { 124, 10236, 1 },
+  { 124, 10247, 1 }, { 124, 10257, 1 }, { 123, 10269, 1 }, { 123, 10282, 1 }, { 123, 10295, 1 }, { 122, 10312, 1 },
+  { 120, 10336, 1 }, { 120, 10360, 1 }, { 120, 10382, 1 }, { 119, 10405, 1 }, { 119, 10430, 1 }, { 118, 10457, 1 },
+  { 117, 10482, 1 }, { 117, 10504, 1 }, { 116, 10527, 1 }, { 116, 10547, 1 }, { 116, 10566, 1 }, { 116, 10583, 1 },
+  { 115, 10602, 1 }, { 115, 10620, 1 }, { 115, 10638, 1 }, { 114, 10658, 1 }, { 113, 10679, 1 }, { 113, 10701, 1 },
+  { 113, 10720, 1 }, { 113, 10735, 1 }, { 112, 10750, 1 }, { 112, 10764, 1 }, { 112, 10775, 1 }, { 112, 10786, 1 },
+  { 112, 10794, 1 }, { 112, 10802, 1 }, { 111, 10814, 1 }, { 110, 10830, 1 }, { 110, 10848, 1 }, { 110, 10863, 1 },
+  { 110, 10876, 1 }, { 109, 10890, 1 }, { 109, 10904, 1 }, { 109, 10915, 1 }, { 109, 10923, 1 }, { 109, 10932, 1 },
+  { 109, 10940, 1 }, { 108, 10950, 1 }, { 108, 10959, 1 }, { 108, 10967, 1 }, { 108, 10976, 1 }, { 108, 10985, 1 },
+  { 108, 10993, 1 }, { 108, 10999, 1 }, { 108, 11001, 1 }, { 108, 10999, 1 }, { 108, 10997, 1 }, { 108, 10995, 1 },
+  { 109, 10993, 1 }, { 109, 10991, 1 }, { 108, 10992, 1 }, { 108, 10992, 1 }, { 107, 10999, 1 }, { 107, 11006, 1 },
+  { 107, 11015, 1 }, { 107, 11022, 1 }, { 107, 11027, 1 }, { 106, 11036, 1 }, { 106, 11050, 1 }, { 105, 11063, 1 },
+  { 106, 11071, 1 }, { 106, 11080, 1 }, { 105, 11091, 1 }, { 105, 11100, 1 }, { 105, 11106, 1 }, { 105, 11112, 1 },
+  { 105, 11118, 1 }, { 105, 11123, 1 }, { 105, 11128, 1 }, { 105, 11133, 1 }, { 105, 11136, 1 }, { 105, 11139, 1 },
+  { 105, 11142, 1 }, { 105, 11145, 1 }, { 105, 11147, 1 }, { 105, 11149, 1 }, { 104, 11153, 1 }, { 104, 11158, 1 },
+  { 104, 11163, 1 }, { 104, 11168, 1 }, { 103, 11177, 1 }, { 103, 11185, 1 }, { 103, 11194, 1 }, { 102, 11206, 1 },
+  { 102, 11217, 1 }, { 102, 11227, 1 }, { 102, 11235, 1 }, { 102, 11241, 1 }, { 102, 11247, 1 }, { 102, 11252, 1 },
+  { 102, 11258, 1 }, { 101, 11265, 1 }, { 101, 11273, 1 }, { 101, 11280, 1 }, { 101, 11286, 1 }, { 101, 11294, 1 },
+  { 101, 11301, 1 }, { 101, 11303, 1 }, { 101, 11304, 1 }, { 101, 11308, 1 }, { 101, 11311, 1 }, { 101, 11314, 1 },
+  { 101, 11316, 1 }, { 101, 11320, 1 }, { 100, 11325, 1 }, { 100, 11330, 1 }, { 100, 11337, 1 }, { 99, 11348, 1 },
+  { 99, 11363, 1 }, { 98, 11376, 1 }, { 98, 11390, 1 }, { 98, 11405, 1 }, { 97, 11420, 1 }, { 97, 11431, 1 },
+  { 98, 11438, 1 }, { 98, 11444, 1 }, { 98, 11448, 1 }, { 97, 11455, 1 }, { 98, 11459, 1 }, { 98, 11460, 1 },
+  { 98, 11460, 1 }, { 98, 11457, 1 }, { 98, 11457, 1 }, { 97, 11461, 1 }, { 97, 11464, 1 }, { 97, 11467, 1 },
+  { 97, 11469, 1 }, { 97, 11471, 1 }, { 97, 11472, 1 }, { 98, 11469, 1 }, { 98, 11467, 1 }, { 97, 11469, 1 },
+  { 97, 11474, 1 }, { 97, 11479, 1 }, { 97, 11482, 1 }, { 97, 11486, 1 }, { 96, 11492, 1 }, { 96, 11501, 1 },
+  { 96, 11509, 1 }, { 96, 11515, 1 }, { 96, 11521, 1 }, { 96, 11528, 1 }, { 95, 11537, 1 }, { 95, 11544, 1 },
+  { 95, 11551, 1 }, { 95, 11560, 1 }, { 94, 11570, 1 }, { 94, 11579, 1 }, { 94, 11589, 1 }, { 94, 11597, 1 },
+  { 94, 11601, 1 }, { 93, 11610, 1 }, { 94, 11618, 1 }, { 94, 11624, 1 }, { 94, 11628, 1 }, { 93, 11633, 1 },
+  { 93, 11640, 1 }, { 93, 11650, 1 }, { 92, 11659, 1 }, { 92, 11669, 1 }, { 92, 11681, 1 }, { 92, 11690, 1 },
+  { 92, 11698, 1 }, { 91, 11707, 1 }, { 91, 11717, 1 }, { 91, 11727, 1 }, { 91, 11736, 1 }, { 91, 11741, 1 },
+  { 92, 11738, 1 }, { 93, 11729, 1 }, { 94, 11713, 1 }, { 94, 11695, 1 }, { 95, 11675, 1 }, { 95, 11659, 1 },
+  { 95, 11646, 1 }, { 95, 11636, 1 }, { 95, 11625, 1 }, { 95, 11614, 1 }, { 96, 11602, 1 }, { 96, 11588, 1 },
+  { 96, 11576, 1 }, { 97, 11565, 1 }, { 97, 11554, 1 }, { 97, 11544, 1 }, { 97, 11533, 1 }, { 98, 11522, 1 },
+  { 98, 11513, 1 }, { 98, 11506, 1 }, { 97, 11502, 1 }, { 97, 11500, 1 }, { 97, 11500, 1 }, { 97, 11503, 1 },
+  { 96, 11507, 1 }, { 97, 11511, 1 }, { 96, 11514, 1 }, { 97, 11514, 1 }, { 97, 11514, 1 }, { 96, 11517, 1 },
+  { 97, 11517, 1 }, { 96, 11519, 1 }, { 96, 11522, 1 }, { 96, 11526, 1 }, { 96, 11527, 1 }, { 96, 11527, 1 },
+  { 96, 11527, 1 }, { 96, 11530, 1 }, { 96, 11535, 1 }, { 96, 11540, 1 }, { 95, 11548, 1 }, { 95, 11553, 1 },
+  { 95, 11558, 1 }, { 95, 11562, 1 }, { 95, 11565, 1 }, { 95, 11569, 1 }, { 95, 11571, 1 }, { 95, 11574, 1 },
+  { 95, 11580, 1 }, { 94, 11587, 1 }, { 94, 11593, 1 }, { 94, 11596, 1 }, { 94, 11601, 1 }, { 94, 11604, 1 },
+  { 94, 11608, 1 }, { 93, 11614, 1 }, { 93, 11621, 1 }, { 93, 11628, 1 }, { 93, 11635, 1 }, { 93, 11644, 1 },
+  { 92, 11657, 1 }, { 92, 11672, 1 }, { 91, 11686, 1 }, { 91, 11697, 1 }, { 91, 11711, 1 }, { 91, 11723, 1 },
+  { 90, 11733, 1 }, { 90, 11742, 1 }, { 91, 11750, 1 }, { 90, 11761, 1 }, { 90, 11771, 1 }, { 90, 11777, 1 },
+  { 90, 11781, 1 }, { 90, 11787, 1 }, { 90, 11792, 1 }, { 89, 11798, 1 }, { 90, 11802, 1 }, { 90, 11807, 1 },
+  { 90, 11810, 1 }, { 90, 11812, 1 }, { 89, 11816, 1 }, { 89, 11819, 1 }, { 89, 11822, 1 }, { 89, 11826, 1 },
+  { 88, 11835, 1 }, { 87, 11851, 1 }, { 86, 11874, 1 }, { 85, 11899, 1 }, { 85, 11925, 1 }, { 83, 11955, 1 },
+  { 82, 11987, 1 }, { 82, 12021, 1 }, { 80, 12058, 1 }, { 80, 12090, 1 }, { 80, 12119, 1 }, { 79, 12144, 1 },
+  { 79, 12168, 1 }, { 79, 12190, 1 }, { 78, 12211, 1 }, { 78, 12231, 1 }, { 78, 12247, 1 }, { 77, 12262, 1 },
+  { 78, 12274, 1 }, { 77, 12287, 1 }, { 77, 12299, 1 }, { 77, 12312, 1 }, { 77, 12322, 1 }, { 76, 12334, 1 },
+  { 76, 12346, 1 }, { 75, 12359, 1 }, { 75, 12371, 1 }, { 75, 12383, 1 }, { 75, 12392, 1 }, { 75, 12398, 1 },
+  { 75, 12402, 1 }, { 75, 12404, 1 }, { 75, 12407, 1 }, { 75, 12409, 1 }, { 75, 12411, 1 }, { 75, 12412, 1 },
+  { 74, 12419, 1 }, { 74, 12425, 1 }, { 74, 12431, 1 }, { 74, 12437, 1 }, { 74, 12440, 1 }, { 74, 12443, 1 },
+  { 74, 12445, 1 }, { 74, 12449, 1 }, { 74, 12455, 1 }, { 74, 12461, 1 }, { 73, 12470, 1 }, { 73, 12479, 1 },
+  { 73, 12483, 1 }, { 73, 12485, 1 }, { 73, 12488, 1 }, { 73, 12493, 1 }, { 72, 12501, 1 }, { 72, 12509, 1 },
+  { 72, 12516, 1 }, { 72, 12522, 1 }, { 72, 12528, 1 }, { 71, 12533, 1 }, { 72, 12538, 1 }, { 72, 12541, 1 },
+  { 72, 12545, 1 }, { 72, 12548, 1 }, { 71, 12551, 1 }, { 71, 12555, 1 }, { 71, 12560, 1 }, { 71, 12565, 1 },
+  { 71, 12569, 1 }, { 71, 12574, 1 }, { 71, 12579, 1 }, { 70, 12584, 1 }, { 70, 12590, 1 }, { 70, 12596, 1 },
+  { 70, 12602, 1 }, { 69, 12612, 1 }, { 68, 12624, 1 }, { 68, 12635, 1 }, { 68, 12643, 1 }, { 69, 12649, 1 },
+  { 69, 12653, 1 }, { 69, 12657, 1 }, { 68, 12665, 1 }, { 68, 12672, 1 }, { 68, 12676, 1 }, { 68, 12680, 1 },
+  { 68, 12682, 1 }, { 68, 12683, 1 }, { 68, 12684, 1 }, { 68, 12684, 1 }, { 68, 12685, 1 }, { 68, 12686, 1 },
+  { 68, 12688, 1 }, { 68, 12691, 1 }, { 68, 12693, 1 }, { 68, 12693, 1 }, { 68, 12693, 1 }, { 68, 12694, 1 },
+  { 68, 12693, 1 }, { 68, 12694, 1 }, { 67, 12696, 1 }, { 67, 12700, 1 }, { 68, 12703, 1 }, { 67, 12706, 1 },
+  { 67, 12709, 1 }, { 67, 12712, 1 }, { 67, 12716, 1 }, { 67, 12718, 1 }, { 67, 12722, 1 }, { 66, 12729, 1 },
+  { 66, 12737, 1 }, { 66, 12741, 1 }, { 67, 12742, 1 }, { 66, 12744, 1 }, { 66, 12745, 1 }, { 67, 12747, 1 },
+  { 66, 12751, 1 }, { 66, 12753, 1 }, { 66, 12755, 1 }, { 66, 12757, 1 }, { 66, 12759, 1 }, { 66, 12761, 1 },
+  { 66, 12761, 1 }, { 66, 12763, 1 }, { 66, 12766, 1 }, { 65, 12770, 1 }, { 66, 12772, 1 }, { 65, 12775, 1 },
+  { 65, 12777, 1 }, { 65, 12779, 1 }, { 65, 12782, 1 }, { 66, 12783, 1 }, { 65, 12785, 1 }, { 65, 12790, 1 },
+  { 64, 12797, 1 }, { 64, 12806, 1 }, { 63, 12816, 1 }, { 63, 12826, 1 }, { 64, 12830, 1 }, { 64, 12834, 1 },
+  { 63, 12839, 1 }, { 63, 12843, 1 }, { 63, 12846, 1 }, { 64, 12846, 1 }, { 64, 12844, 1 }, { 64, 12842, 1 },
+  { 64, 12841, 1 }, { 64, 12840, 1 }, { 64, 12841, 1 }, { 64, 12842, 1 }, { 63, 12846, 1 }, { 63, 12853, 1 },
+  { 62, 12861, 1 }, { 62, 12867, 1 }, { 62, 12870, 1 }, { 63, 12873, 1 }, { 63, 12874, 1 }, { 63, 12875, 1 },
+  { 63, 12877, 1 }, { 62, 12881, 1 }, { 62, 12884, 1 }, { 63, 12886, 1 }, { 62, 12888, 1 }, { 62, 12893, 1 },
+  { 62, 12896, 1 }, { 62, 12898, 1 }, { 62, 12899, 1 }, { 62, 12900, 1 }, { 62, 12899, 1 }, { 63, 12897, 1 },
+  { 62, 12895, 1 }, { 64, 12885, 1 }, { 65, 12871, 1 }, { 66, 12851, 1 }, { 67, 12829, 1 }, { 68, 12806, 1 },
+  { 68, 12783, 1 }, { 69, 12761, 1 }, { 69, 12740, 1 }, { 70, 12721, 1 }, { 70, 12703, 1 }, { 70, 12686, 1 },
+  { 71, 12669, 1 }, { 71, 12652, 1 }, { 71, 12637, 1 }, { 72, 12621, 1 }, { 72, 12608, 1 }, { 72, 12597, 1 },
+  { 72, 12587, 1 }, { 72, 12579, 1 }, { 72, 12572, 1 }, { 72, 12567, 1 }, { 72, 12564, 1 }, { 72, 12560, 1 },
+  { 72, 12557, 1 }, { 72, 12553, 1 }, { 72, 12552, 1 }, { 72, 12555, 1 }, { 71, 12559, 1 }, { 71, 12560, 1 },
+  { 72, 12559, 1 }, { 72, 12558, 1 }, { 72, 12558, 1 }, { 71, 12559, 1 }, { 72, 12558, 1 }, { 71, 12558, 1 },
+  { 72, 12559, 1 }, { 71, 12561, 1 }, { 71, 12562, 1 }, { 72, 12558, 1 }, { 72, 12553, 1 }, { 72, 12550, 1 },
+  { 72, 12549, 1 }, { 72, 12546, 1 }, { 72, 12545, 1 }, { 72, 12546, 1 }, { 71, 12549, 1 }, { 71, 12552, 1 },
+  { 72, 12554, 1 }, { 71, 12556, 1 }, { 72, 12556, 1 }, { 72, 12555, 1 }, { 72, 12554, 1 }, { 72, 12554, 1 },
+  { 72, 12556, 1 }, { 72, 12556, 1 }, { 72, 12556, 1 }, { 72, 12557, 1 }, { 71, 12560, 1 }, { 72, 12560, 1 },
+  { 72, 12560, 1 }, { 72, 12558, 1 }, { 72, 12558, 1 }, { 71, 12560, 1 }, { 71, 12565, 1 }, { 70, 12574, 1 },
+  { 70, 12581, 1 }, { 70, 12585, 1 }, { 70, 12591, 1 }, { 70, 12595, 1 }, { 70, 12599, 1 }, { 70, 12601, 1 },
+  { 71, 12600, 1 }, { 71, 12598, 1 }, { 71, 12598, 1 }, { 71, 12594, 1 }, { 71, 12589, 1 }, { 71, 12584, 1 },
+  { 72, 12580, 1 }, { 71, 12578, 1 }, { 72, 12574, 1 }, { 72, 12568, 1 }, { 73, 12560, 1 }, { 72, 12556, 1 },
+  { 72, 12554, 1 }, { 72, 12557, 1 }, { 70, 12568, 1 }, { 69, 12584, 1 }, { 69, 12601, 1 }, { 67, 12622, 1 },
+  { 67, 12644, 1 }, { 66, 12666, 1 }, { 66, 12686, 1 }, { 65, 12706, 1 }, { 65, 12725, 1 }, { 65, 12741, 1 },
+  { 64, 12760, 1 }, { 64, 12779, 1 }, { 63, 12797, 1 }, { 63, 12813, 1 }, { 63, 12827, 1 }, { 63, 12837, 1 },
+  { 62, 12847, 1 }, { 62, 12858, 1 }, { 62, 12864, 1 }, { 62, 12869, 1 }, { 62, 12873, 1 }, { 63, 12875, 1 },
+  { 63, 12876, 1 }, { 63, 12874, 1 }, { 64, 12871, 1 }, { 64, 12867, 1 }, { 63, 12865, 1 }, { 63, 12865, 1 },
+  { 63, 12865, 1 }, { 63, 12866, 1 }, { 63, 12865, 1 }, { 64, 12863, 1 }, { 64, 12862, 1 }, { 64, 12860, 1 },
+  { 63, 12860, 1 }, { 64, 12859, 1 }, { 64, 12857, 1 }, { 63, 12856, 1 }, { 64, 12855, 1 }, { 64, 12853, 1 },
+  { 64, 12853, 1 }, { 63, 12854, 1 }, { 63, 12859, 1 }, { 63, 12864, 1 }, { 63, 12866, 1 }, { 63, 12866, 1 },
+  { 63, 12867, 1 }, { 63, 12867, 1 }, { 63, 12868, 1 }, { 63, 12869, 1 }, { 63, 12870, 1 }, { 63, 12871, 1 },
+  { 63, 12872, 1 }, { 63, 12873, 1 }, { 63, 12875, 1 }, { 63, 12875, 1 }, { 63, 12876, 1 }, { 63, 12876, 1 },
+  { 63, 12875, 1 }, { 63, 12873, 1 }, { 64, 12870, 1 }, { 63, 12871, 1 }, { 63, 12873, 1 }, { 63, 12875, 1 },
+  { 63, 12875, 1 }, { 63, 12872, 1 }, { 64, 12866, 1 }, { 64, 12861, 1 }, { 64, 12857, 1 }, { 64, 12853, 1 },
+  { 64, 12849, 1 }, { 64, 12845, 1 }, { 64, 12843, 1 }, { 64, 12843, 1 }, { 64, 12842, 1 }, { 65, 12838, 1 },
+  { 65, 12833, 1 }, { 65, 12829, 1 }, { 65, 12827, 1 }, { 65, 12826, 1 }, { 64, 12825, 1 }, { 64, 12825, 1 },
+  { 64, 12827, 1 }, { 63, 12832, 1 }, { 64, 12836, 1 }, { 63, 12840, 1 }, { 64, 12841, 1 }, { 64, 12843, 1 },
+  { 63, 12846, 1 }, { 64, 12848, 1 }, { 64, 12848, 1 }, { 64, 12844, 1 }, { 64, 12840, 1 }, { 64, 12837, 1 },
+  { 65, 12835, 1 }, { 64, 12832, 1 }, { 65, 12828, 1 }, { 65, 12826, 1 }, { 65, 12824, 1 }, { 65, 12819, 1 },
+  { 65, 12814, 1 }, { 65, 12811, 1 }, { 65, 12807, 1 }, { 66, 12802, 1 }, { 66, 12799, 1 }, { 66, 12796, 1 },
+  { 65, 12795, 1 }, { 65, 12795, 1 }, { 66, 12794, 1 }, { 65, 12794, 1 }, { 65, 12792, 1 }, { 66, 12787, 1 },
+  { 67, 12779, 1 }, { 67, 12771, 1 }, { 67, 12763, 1 }, { 67, 12755, 1 }, { 68, 12743, 1 }, { 68, 12733, 1 },
+  { 68, 12723, 1 }, { 69, 12713, 1 }, { 68, 12706, 1 }, { 68, 12703, 1 }, { 68, 12701, 1 }, { 68, 12698, 1 },
+  { 68, 12694, 1 }, { 69, 12690, 1 }, { 68, 12687, 1 }, { 69, 12685, 1 }, { 68, 12685, 1 }, { 68, 12686, 1 },
+  { 68, 12687, 1 }, { 68, 12686, 1 }, { 69, 12681, 1 }, { 70, 12674, 1 }, { 69, 12671, 1 }, { 69, 12667, 1 },
+  { 69, 12663, 1 }, { 70, 12658, 1 }, { 70, 12652, 1 }, { 70, 12646, 1 }, { 70, 12639, 1 }, { 70, 12634, 1 },
+  { 70, 12630, 1 }, { 70, 12628, 1 }, { 70, 12626, 1 }, { 71, 12622, 1 }, { 70, 12619, 1 }, { 71, 12615, 1 },
+  { 71, 12609, 1 }, { 71, 12604, 1 }, { 71, 12600, 1 }, { 71, 12596, 1 }, { 71, 12592, 1 }, { 71, 12587, 1 },
+  { 72, 12581, 1 }, { 72, 12574, 1 }, { 72, 12570, 1 }, { 71, 12568, 1 }, { 71, 12566, 1 }, { 72, 12565, 1 },
+  { 72, 12562, 1 }, { 72, 12560, 1 }, { 72, 12557, 1 }, { 72, 12552, 1 }, { 73, 12546, 1 }, { 72, 12544, 1 },
+  { 72, 12543, 1 }, { 73, 12537, 1 }, { 74, 12525, 1 }, { 75, 12509, 1 }, { 76, 12488, 1 }, { 76, 12465, 1 },
+  { 77, 12441, 1 }, { 78, 12417, 1 }, { 79, 12389, 1 }, { 80, 12359, 1 }, { 80, 12331, 1 }, { 81, 12307, 1 },
+  { 81, 12285, 1 }, { 81, 12266, 1 }, { 82, 12247, 1 }, { 82, 12227, 1 }, { 83, 12207, 1 }, { 83, 12189, 1 },
+  { 83, 12174, 1 }, { 83, 12163, 1 }, { 83, 12153, 1 }, { 83, 12142, 1 }, { 84, 12127, 1 }, { 84, 12111, 1 },
+  { 84, 12099, 1 }, { 85, 12087, 1 }, { 84, 12078, 1 }, { 84, 12071, 1 }, { 85, 12064, 1 }, { 85, 12056, 1 },
+  { 86, 12044, 1 }, { 86, 12033, 1 }, { 86, 12023, 1 }, { 86, 12014, 1 }, { 86, 12004, 1 }, { 86, 11996, 1 },
+  { 87, 11987, 1 }, { 87, 11977, 1 }, { 87, 11966, 1 }, { 88, 11953, 1 }, { 88, 11943, 1 }, { 88, 11934, 1 },
+  { 88, 11925, 1 }, { 88, 11916, 1 }, { 88, 11909, 1 }, { 88, 11901, 1 }, { 90, 11888, 1 }, { 90, 11873, 1 },
+  { 90, 11862, 1 }, { 90, 11853, 1 }, { 90, 11847, 1 }, { 89, 11846, 1 }, { 89, 11844, 1 }, { 90, 11841, 1 },
+  { 90, 11837, 1 }, { 90, 11833, 1 }, { 90, 11829, 1 }, { 90, 11827, 1 }, { 89, 11828, 1 }, { 89, 11828, 1 },
+  { 90, 11825, 1 }, { 90, 11821, 1 }, { 91, 11814, 1 }, { 90, 11808, 1 }, { 91, 11801, 1 }, { 91, 11792, 1 },
+  { 91, 11782, 1 }, { 91, 11776, 1 }, { 92, 11769, 1 }, { 92, 11760, 1 }, { 92, 11749, 1 }, { 92, 11743, 1 },
+  { 92, 11739, 1 }, { 92, 11734, 1 }, { 92, 11728, 1 }, { 93, 11723, 1 }, { 92, 11718, 1 }, { 93, 11710, 1 },
+  { 93, 11699, 1 }, { 94, 11684, 1 }, { 95, 11666, 1 }, { 95, 11651, 1 }, { 95, 11639, 1 }, { 95, 11628, 1 },
+  { 96, 11614, 1 }, { 96, 11599, 0 }, { 96, 11592, 0 }, { 95, 11592, 0 }, { 94, 11600, 0 }, { 93, 11614, 0 },
+  { 92, 11633, 0 }, { 91, 11653, 0 }, { 91, 11671, 0 }, { 91, 11688, 0 }, { 91, 11704, 0 }, { 91, 11718, 0 },
+  { 91, 11730, 0 }, { 90, 11744, 0 }, { 90, 11757, 0 }, { 90, 11771, 0 }, { 90, 11781, 0 }, { 90, 11788, 0 },
+  { 89, 11797, 0 }, { 89, 11803, 0 }, { 90, 11807, 0 }, { 89, 11813, 0 }, { 89, 11817, 0 }, { 90, 11819, 0 },
+  { 90, 11819, 0 }, { 90, 11819, 0 }, { 90, 11819, 0 }, { 90, 11817, 0 }, { 90, 11812, 0 }, { 90, 11809, 0 },
+  { 90, 11806, 0 }, { 90, 11805, 0 }, { 90, 11805, 0 }, { 90, 11805, 0 }, { 90, 11803, 0 }, { 90, 11800, 0 },
+  { 90, 11802, 0 }, { 90, 11803, 0 }, { 91, 11800, 0 }, { 90, 11798, 0 }, { 90, 11797, 0 }, { 91, 11793, 0 },
+  { 91, 11786, 0 }, { 91, 11779, 0 }, { 91, 11773, 0 }, { 91, 11769, 0 }, { 91, 11765, 0 }, { 91, 11759, 0 },
+  { 92, 11749, 0 }, { 92, 11741, 0 }, { 92, 11735, 0 }, { 92, 11730, 0 }, { 92, 11725, 0 }, { 93, 11718, 0 },
+  { 93, 11710, 0 }, { 93, 11701, 0 }, { 93, 11692, 0 }, { 93, 11684, 0 }, { 93, 11678, 0 }, { 94, 11670, 0 },
+  { 94, 11662, 0 }, { 94, 11654, 0 }, { 94, 11647, 0 }, { 95, 11639, 0 }, { 94, 11636, 0 }, { 94, 11633, 0 },
+  { 94, 11628, 0 }, { 95, 11622, 0 }, { 95, 11618, 0 }, { 95, 11614, 0 }, { 95, 11610, 0 }, { 95, 11606, 0 },
+  { 95, 11601, 0 }, { 95, 11596, 0 }, { 95, 11591, 0 }, { 95, 11588, 0 }, { 96, 11583, 0 }, { 96, 11574, 0 },
+  { 97, 11562, 0 }, { 97, 11552, 0 }, { 97, 11543, 0 }, { 97, 11535, 0 }, { 97, 11526, 0 }, { 97, 11520, 0 },
+  { 97, 11519, 0 }, { 97, 11516, 0 }, { 97, 11512, 0 }, { 98, 11504, 0 }, { 98, 11496, 0 }, { 98, 11491, 0 },
+  { 98, 11484, 0 }, { 98, 11475, 0 }, { 98, 11466, 0 }, { 99, 11458, 0 }, { 99, 11448, 0 }, { 99, 11441, 0 },
+  { 99, 11434, 0 }, { 100, 11423, 0 }, { 100, 11414, 0 }, { 100, 11406, 0 }, { 100, 11400, 0 }, { 99, 11396, 0 },
+  { 99, 11395, 0 }, { 100, 11389, 0 }, { 101, 11379, 0 }, { 101, 11372, 0 }, { 101, 11364, 0 }, { 101, 11353, 0 },
+  { 101, 11343, 0 }, { 102, 11333, 0 }, { 102, 11324, 0 }, { 102, 11317, 0 }, { 102, 11308, 0 }, { 102, 11296, 0 },
+  { 103, 11280, 0 }, { 103, 11266, 0 }, { 104, 11251, 0 }, { 104, 11236, 0 }, { 104, 11224, 0 }, { 104, 11215, 0 },
+  { 105, 11206, 0 }, { 105, 11196, 0 }, { 105, 11187, 0 }, { 105, 11179, 0 }, { 105, 11174, 0 }, { 104, 11174, 0 },
+  { 104, 11176, 0 }, { 104, 11176, 0 }, { 104, 11175, 0 }, { 105, 11173, 0 }, { 104, 11175, 0 }, { 104, 11176, 0 },
+  { 104, 11175, 0 }, { 105, 11171, 0 }, { 105, 11168, 0 }, { 105, 11164, 0 }, { 105, 11158, 0 }, { 106, 11149, 0 },
+  { 106, 11139, 0 }, { 106, 11128, 0 }, { 107, 11116, 0 }, { 107, 11102, 0 }, { 107, 11090, 0 }, { 107, 11080, 0 },
+  { 107, 11073, 0 }, { 108, 11065, 0 }, { 108, 11057, 0 }, { 108, 11050, 0 }, { 108, 11043, 0 }, { 108, 11039, 0 },
+  { 108, 11033, 0 }, { 108, 11026, 0 }, { 109, 11015, 0 }, { 109, 11004, 0 }, { 109, 10995, 0 }, { 109, 10986, 0 },
+  { 109, 10978, 0 }, { 110, 10968, 0 }, { 110, 10959, 0 }, { 110, 10950, 0 }, { 110, 10942, 0 }, { 110, 10934, 0 },
+  { 111, 10924, 0 }, { 111, 10916, 0 }, { 111, 10908, 0 }, { 111, 10900, 0 }, { 111, 10895, 0 }, { 110, 10895, 0 },
+  { 110, 10899, 0 }, { 110, 10903, 0 }, { 110, 10902, 0 }, { 111, 10894, 0 }, { 112, 10879, 0 }, { 113, 10858, 0 },
+  { 114, 10831, 0 }, { 115, 10800, 0 }, { 116, 10768, 0 }, { 117, 10734, 0 }, { 118, 10699, 0 }, { 119, 10666, 0 },
+  { 119, 10634, 0 }, { 120, 10603, 0 }, { 120, 10574, 0 }, { 121, 10545, 0 }, { 122, 10518, 0 }, { 122, 10492, 0 },
+  { 122, 10471, 0 }, { 122, 10450, 0 }, { 123, 10429, 0 }, { 123, 10408, 0 }, { 124, 10387, 0 }, { 124, 10368, 0 },
+  { 124, 10353, 0 }, { 124, 10339, 0 }, { 125, 10326, 0 }, { 124, 10318, 0 }, { 124, 10310, 0 }, { 125, 10301, 0 },
+  { 125, 10290, 0 }, { 125, 10279, 0 }, { 126, 10268, 0 }, { 126, 10258, 0 }, { 126, 10251, 0 }, { 125, 10249, 0 },
+  { 125, 10246, 0 }, { 126, 10240, 0 }, { 126, 10230, 0 }, { 127, 10218, 0 }, { 128, 10202, 0 }, { 128, 10188, 0 },
+  { 128, 10177, 0 }, { 128, 10168, 0 }, { 128, 10157, 0 }, { 128, 10149, 0 }, { 128, 10144, 0 }, { 128, 10138, 0 },
+  { 128, 10133, 0 }, { 128, 10128, 0 }, { 128, 10123, 0 }, { 128, 10119, 0 }, { 128, 10117, 0 }, { 129, 10114, 0 },
+  { 128, 10113, 0 }, { 128, 10111, 0 }, { 129, 10107, 0 }, { 129, 10103, 0 }, { 129, 10098, 0 }, { 129, 10095, 0 },
+  { 129, 10092, 0 }, { 129, 10089, 0 }, { 129, 10084, 0 }, { 130, 10078, 0 }, { 130, 10069, 0 }, { 130, 10061, 0 },
+  { 130, 10057, 0 }, { 130, 10053, 0 }, { 131, 10047, 0 }, { 130, 10041, 0 }, { 130, 10038, 0 }, { 130, 10034, 0 },
+  { 131, 10027, 0 }, { 130, 10024, 0 }, { 131, 10022, 0 }, { 131, 10019, 0 }, { 131, 10015, 0 }, { 131, 10012, 0 },
+  { 131, 10009, 0 }, { 131, 10006, 0 }, { 131, 10003, 0 }, { 131, 10000, 0 }, { 131, 9995, 0 }, { 131, 9991, 0 },
+  { 132, 9985, 0 }, { 132, 9979, 0 }, { 132, 9971, 0 }, { 132, 9965, 0 }, { 131, 9969, 0 }, { 130, 9980, 0 },
+  { 130, 9995, 0 }, { 129, 10011, 0 }, { 128, 10027, 0 }, { 128, 10042, 0 }, { 128, 10056, 0 }, { 127, 10072, 0 },
+  { 127, 10088, 0 }, { 127, 10105, 0 }, { 126, 10122, 0 }, { 126, 10137, 0 }, { 126, 10152, 0 }, { 125, 10166, 0 },
+  { 125, 10178, 0 }, { 126, 10187, 0 }, { 126, 10193, 0 }, { 126, 10198, 0 }, { 126, 10203, 0 }, { 126, 10206, 0 },
+  { 126, 10208, 0 }, { 126, 10210, 0 }, { 126, 10210, 0 }, { 126, 10212, 0 }, { 126, 10213, 0 }, { 126, 10215, 0 },
+  { 126, 10217, 0 }, { 125, 10222, 0 }, { 125, 10225, 0 }, { 125, 10230, 0 }, { 125, 10232, 0 }, { 126, 10229, 0 },
+  { 126, 10225, 0 }, { 126, 10222, 0 }, { 126, 10217, 0 }, { 126, 10212, 0 }, { 127, 10205, 0 }, { 127, 10197, 0 },
+  { 127, 10188, 0 }, { 128, 10176, 0 }, { 128, 10167, 0 }, { 127, 10163, 0 }, { 127, 10159, 0 }, { 128, 10155, 0 },
+  { 128, 10150, 0 }, { 128, 10148, 0 }, { 127, 10148, 0 }, { 127, 10149, 0 }, { 128, 10147, 0 }, { 128, 10144, 0 },
+  { 128, 10141, 0 }, { 128, 10139, 0 }, { 128, 10136, 0 }, { 128, 10131, 0 }, { 128, 10130, 0 }, { 127, 10133, 0 },
+  { 128, 10134, 0 }, { 128, 10134, 0 }, { 127, 10136, 0 }, { 127, 10137, 0 }, { 128, 10136, 0 }, { 128, 10135, 0 },
+  { 127, 10137, 0 }, { 127, 10140, 0 }, { 127, 10143, 0 }, { 128, 10140, 0 }, { 128, 10134, 0 }, { 128, 10129, 0 },
+  { 128, 10125, 0 }, { 129, 10121, 0 }, { 128, 10117, 0 }, { 129, 10111, 0 }, { 129, 10105, 0 }, { 129, 10102, 0 },
+  { 128, 10101, 0 }, { 128, 10103, 0 }, { 128, 10105, 0 }, { 128, 10108, 0 }, { 128, 10109, 0 }, { 128, 10110, 0 },
+  { 128, 10109, 0 }, { 129, 10105, 0 }, { 129, 10101, 0 }, { 130, 10092, 0 }, { 129, 10086, 0 }, { 130, 10079, 0 },
+  { 130, 10071, 0 }, { 130, 10063, 0 }, { 130, 10056, 0 }, { 130, 10050, 0 }, { 130, 10045, 0 }, { 130, 10040, 0 },
+  { 131, 10034, 0 }, { 131, 10027, 0 }, { 131, 10020, 0 }, { 131, 10016, 0 }, { 131, 10013, 0 }, { 131, 10010, 0 },
+  { 131, 10008, 0 }, { 131, 10007, 0 }, { 131, 10004, 0 }, { 131, 10000, 0 }, { 131, 9999, 0 }, { 131, 9996, 0 },
+  { 131, 9994, 0 }, { 132, 9990, 0 }, { 132, 9984, 0 }, { 132, 9980, 0 }, { 132, 9977, 0 }, { 132, 9973, 0 },
+  { 132, 9969, 0 }, { 132, 9966, 0 }, { 132, 9962, 0 }, { 132, 9959, 0 }, { 132, 9956, 0 }, { 132, 9956, 0 },
+  { 132, 9956, 0 }, { 132, 9955, 0 }, { 132, 9952, 0 }, { 132, 9952, 0 }, { 132, 9951, 0 }, { 132, 9951, 0 },
+  { 132, 9951, 0 }, { 132, 9951, 0 }, { 132, 9951, 0 }, { 132, 9948, 0 }, { 133, 9944, 0 }, { 133, 9941, 0 },
+  { 133, 9939, 0 }, { 133, 9936, 0 }, { 133, 9931, 0 }, { 133, 9926, 0 }, { 133, 9923, 0 }, { 133, 9923, 0 },
+  { 133, 9924, 0 }, { 132, 9925, 0 }, { 132, 9927, 0 }, { 133, 9927, 0 }, { 132, 9929, 0 }, { 132, 9933, 0 },
+  { 132, 9939, 0 }, { 132, 9941, 0 }, { 132, 9940, 0 }, { 133, 9937, 0 }, { 132, 9935, 0 }, { 133, 9930, 0 },
+  { 133, 9925, 0 }, { 133, 9920, 0 }, { 133, 9918, 0 }, { 133, 9917, 0 }, { 133, 9915, 0 }, { 133, 9913, 0 },
+  { 133, 9911, 0 }, { 133, 9909, 0 }, { 133, 9908, 0 }, { 133, 9909, 0 }, { 133, 9908, 0 }, { 134, 9902, 0 },
+  { 134, 9898, 0 }, { 133, 9897, 0 }, { 133, 9897, 0 }, { 134, 9892, 0 }, { 134, 9884, 0 }, { 134, 9880, 0 },
+  { 134, 9879, 0 }, { 134, 9876, 0 }, { 134, 9874, 0 }, { 134, 9871, 0 }, { 134, 9866, 0 }, { 135, 9857, 0 },
+  { 136, 9843, 0 }, { 137, 9826, 0 }, { 137, 9808, 0 }, { 138, 9788, 0 }, { 138, 9769, 0 }, { 139, 9748, 0 },
+  { 140, 9726, 0 }, { 140, 9707, 0 }, { 140, 9690, 0 }, { 140, 9675, 0 }, { 141, 9661, 0 }, { 141, 9650, 0 },
+  { 140, 9641, 0 }, { 141, 9633, 0 }, { 141, 9625, 0 }, { 141, 9616, 0 }, { 141, 9607, 0 }, { 142, 9597, 0 },
+  { 142, 9587, 0 }, { 142, 9579, 0 }, { 142, 9569, 0 }, { 143, 9560, 0 }, { 143, 9550, 0 }, { 143, 9540, 0 },
+  { 143, 9532, 0 }, { 143, 9527, 0 }, { 143, 9523, 0 }, { 143, 9519, 0 }, { 143, 9513, 0 }, { 144, 9509, 0 },
+  { 143, 9508, 0 }, { 143, 9507, 0 }, { 143, 9509, 0 }, { 142, 9514, 0 }, { 142, 9520, 0 }, { 142, 9524, 0 },
+  { 142, 9528, 0 }, { 142, 9533, 0 }, { 141, 9539, 0 }, { 141, 9545, 0 }, { 141, 9551, 0 }, { 141, 9554, 0 },
+  { 142, 9552, 0 }, { 142, 9550, 0 }, { 142, 9548, 0 }, { 142, 9548, 0 }, { 141, 9550, 0 }, { 142, 9548, 0 },
+  { 142, 9545, 0 }, { 142, 9541, 0 }, { 142, 9538, 0 }, { 142, 9535, 0 }, { 143, 9531, 0 }, { 143, 9526, 0 },
+  { 143, 9521, 0 }, { 143, 9517, 0 }, { 143, 9513, 0 }, { 143, 9512, 0 }, { 143, 9513, 0 }, { 142, 9516, 0 },
+  { 142, 9521, 0 }, { 141, 9529, 0 }, { 141, 9538, 0 }, { 141, 9546, 0 }, { 141, 9550, 0 }, { 141, 9557, 0 },
+  { 141, 9562, 0 }, { 141, 9566, 0 }, { 141, 9566, 0 }, { 142, 9562, 0 }, { 142, 9559, 0 }, { 142, 9557, 0 },
+  { 142, 9557, 0 }, { 142, 9553, 0 }, { 142, 9548, 0 }, { 143, 9542, 0 }, { 143, 9537, 0 }, { 143, 9532, 0 },
+  { 143, 9528, 0 }, { 143, 9527, 0 }, { 142, 9530, 0 }, { 142, 9534, 0 }, { 141, 9541, 0 }, { 140, 9553, 0 },
+  { 140, 9570, 0 }, { 138, 9593, 0 }, { 137, 9618, 0 }, { 137, 9643, 0 }, { 136, 9669, 0 }, { 136, 9695, 0 },
+  { 135, 9720, 0 }, { 135, 9743, 0 }, { 134, 9768, 0 }, { 134, 9790, 0 }, { 133, 9809, 0 }, { 133, 9827, 0 },
+  { 133, 9843, 0 }, { 133, 9857, 0 }, { 133, 9870, 0 }, { 132, 9884, 0 }, { 132, 9900, 0 }, { 131, 9918, 0 },
+  { 131, 9932, 0 }, { 131, 9942, 0 }, { 131, 9953, 0 }, { 131, 9964, 0 }, { 130, 9977, 0 }, { 130, 9989, 0 },
+  { 130, 10000, 0 }, { 130, 10009, 0 }, { 130, 10017, 0 }, { 129, 10026, 0 }, { 129, 10034, 0 }, { 129, 10042, 0 },
+  { 129, 10051, 0 }, { 129, 10059, 0 }, { 129, 10064, 0 }, { 128, 10071, 0 }, { 128, 10078, 0 }, { 128, 10084, 0 },
+  { 129, 10087, 0 }, { 128, 10091, 0 }, { 128, 10095, 0 }, { 128, 10100, 0 }, { 128, 10103, 0 }, { 128, 10106, 0 },
+  { 128, 10111, 0 }, { 128, 10114, 0 }, { 128, 10115, 0 }, { 128, 10116, 0 }, { 128, 10114, 0 }, { 128, 10113, 0 },
+  { 128, 10114, 0 }, { 128, 10116, 0 }, { 128, 10118, 0 }, { 128, 10120, 0 }, { 128, 10120, 0 }, { 128, 10117, 0 },
+  { 128, 10114, 0 }, { 128, 10111, 0 }, { 128, 10111, 0 }, { 128, 10115, 0 }, { 127, 10121, 0 }, { 127, 10127, 0 },
+  { 127, 10132, 0 }, { 127, 10137, 0 }, { 127, 10142, 0 }, { 127, 10147, 0 }, { 127, 10153, 0 }, { 126, 10162, 0 },
+  { 126, 10168, 0 }, { 126, 10172, 0 }, { 126, 10174, 0 }, { 126, 10178, 0 }, { 126, 10180, 0 }, { 126, 10182, 0 },
+  { 126, 10187, 0 }, { 126, 10190, 0 }, { 126, 10195, 0 }, { 126, 10200, 0 }, { 126, 10204, 0 }, { 126, 10208, 0 },
+  { 126, 10211, 0 }, { 126, 10212, 0 }, { 126, 10211, 0 }, { 126, 10212, 0 }, { 126, 10214, 0 }, { 126, 10213, 0 },
+  { 126, 10213, 0 }, { 126, 10214, 0 }, { 126, 10216, 0 }, { 125, 10222, 0 }, { 124, 10231, 0 }, { 124, 10240, 0 },
+  { 124, 10250, 0 }, { 124, 10258, 0 }, { 124, 10265, 0 }, { 124, 10269, 0 }, { 124, 10272, 0 }, { 124, 10275, 0 },
+  { 124, 10279, 0 }, { 124, 10279, 0 }, { 124, 10282, 0 }, { 124, 10285, 0 }, { 124, 10290, 0 }, { 123, 10295, 0 },
+  { 123, 10303, 0 }, { 123, 10310, 0 }, { 123, 10315, 0 }, { 123, 10320, 0 }, { 122, 10327, 0 }, { 123, 10334, 0 },
+  { 122, 10341, 0 }, { 122, 10347, 0 }, { 122, 10354, 0 }, { 122, 10359, 0 }, { 122, 10365, 0 }, { 122, 10368, 0 },
+  { 122, 10369, 0 }, { 122, 10368, 0 }, { 122, 10372, 0 }, { 122, 10376, 0 }, { 122, 10377, 0 }, { 122, 10380, 0 },
+  { 121, 10386, 0 }, { 121, 10395, 0 }, { 121, 10402, 0 }, { 121, 10407, 0 }, { 121, 10413, 0 }, { 120, 10422, 0 },
+  { 121, 10426, 0 }, { 121, 10426, 0 }, { 121, 10427, 0 }, { 121, 10428, 0 }, { 121, 10431, 0 }, { 120, 10437, 0 },
+  { 120, 10446, 0 }, { 120, 10453, 0 }, { 119, 10461, 0 }, { 119, 10468, 0 }, { 119, 10476, 0 }, { 119, 10484, 0 },
+  { 118, 10495, 0 }, { 118, 10505, 0 }, { 118, 10515, 0 }, { 118, 10518, 0 }, { 119, 10516, 0 }, { 119, 10516, 0 },
+  { 119, 10518, 0 }, { 118, 10528, 0 }, { 118, 10538, 0 }, { 117, 10546, 0 }, { 117, 10555, 0 }, { 117, 10566, 0 },
+  { 117, 10576, 0 }, { 116, 10586, 0 }, { 116, 10596, 0 }, { 116, 10601, 0 }, { 117, 10601, 0 }, { 117, 10604, 0 },
+  { 117, 10606, 0 }, { 117, 10608, 0 }, { 117, 10610, 0 }, { 117, 10611, 0 }, { 117, 10612, 0 }, { 117, 10611, 0 },
+  { 117, 10611, 0 }, { 117, 10610, 0 }, { 117, 10610, 0 }, { 117, 10609, 0 }
+};
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ * Client simulator for the interleaved mode. A client polls like chrony with
+ * xleave, against a responder whose responses leave the stack some hundred
+ * microseconds after the transmit timestamp was read. Client and server clocks
+ * are the same, so every offset the client measures is an error. In basic mode
+ * the transmit timestamp misses the send delay and the offset follows it, in
+ * interleaved mode the real send time of the previous response is used.
+ */
+#include <unity.h>
+#include <string.h>
+#include <math.h>
+#include <random>
+#include <arpa/inet.h>
+#include "ntp_responder.h"
+
+#define SIM_POLLS ( 64 )
+#define SIM_POLL_NS ( 16000000000ll )
+#define SIM_PATH_NS ( 1000000 )       /* One way network delay */
+#define SIM_PATH_JITTER_NS ( 20000 )
+#define SIM_PROCESS_NS ( 20000 )      /* Receive to transmit timestamp */
+#define SIM_SEND_NS ( 400000 )        /* Transmit timestamp to the packet on the air */
+#define SIM_SEND_JITTER_NS ( 200000 )
+
+typedef struct {
+  int64_t t1;
+  int64_t t2;
+  int64_t t3;
+  int64_t t4;
+} sim_exchange_t;
+
+/* Time of the simulation in ns, the server clock reads it */
+static int64_t sim_now;
+static std::mt19937 rng;
+
+void setUp( void ){
+  sim_now = 0;
+  rng.seed(7);
+}
+
+void tearDown( void ){
+}
+
+static ntp_timestamp_t sim_stamp( int64_t ns ){
+  ntp_timestamp_t ts;
+  ts.seconds = 3900000000u + (uint32_t)( ns / 1000000000ll );
+  ts.fraction = (uint32_t)( ( (uint64_t)( ns % 1000000000ll ) << 32 ) / 1000000000ull );
+  return ts;
+}
+
+static int64_t sim_ns( uint32_t s_net, uint32_t f_net ){
+  uint32_t s = ntohl(s_net) - 3900000000u;
+  uint64_t f = ntohl(f_net);
+  return ( (int64_t)s * 1000000000ll ) + (int64_t)( ( f * 1000000000ull + 0x80000000ull ) >> 32 );
+}
+
+static void sim_put( uint32_t* s, uint32_t* f, int64_t ns ){
+  ntp_timestamp_t ts = sim_stamp(ns);
+  *s = htonl(ts.seconds);
+  *f = htonl(ts.fraction);
+}
+
+static ntp_timestamp_t sim_read_time( void ){
+  return sim_stamp(sim_now);
+}
+
+static int64_t sim_jitter( int64_t range ){
+  return (int64_t)( rng() % ( range + 1 ) );
+}
+
+/* Offset the client computes from an exchange, zero is right */
+static double sim_offset( const sim_exchange_t* x ){
+  return ( (double)( x->t2 - x->t1 ) + (double)( x->t3 - x->t4 ) ) / 2.0;
+}
+
+/* Polls the responder, returns the mean absolute offset measured and the interleaved responses */
+static double sim_client( bool xleave, uint32_t* interleaved ){
+  NTP_Responder responder;
+  ntp_server_state_t state = responder.GetServerState();
+  state.leap = 0;
+  state.stratum = 1;
+  memcpy(state.refid, "GPS", 4);
+  responder.SetServerState(&state);
+  responder.SetClock(sim_read_time, NULL);
+  ntp_client_t client = NTP_Responder::ClientV4(htonl(0x0A000001u));
+
+  sim_exchange_t prev;
+  memset(&prev, 0, sizeof(prev));
+  bool have_prev = false;
+  double sum = 0;
+  uint32_t samples = 0;
+  *interleaved = 0;
+  for(uint16_t poll=0;poll<SIM_POLLS;poll++){
+    ntp_packet_t req;
+    ntp_packet_t resp;
+    uint8_t out[NTP_PACKET_MAX_LEN];
+    sim_exchange_t x;
+    memset(&req, 0, sizeof(req));
+    req.flags.vn = 4;
+    req.flags.mode = 3;
+    x.t1 = (int64_t)poll * SIM_POLL_NS;
+    sim_put(&req.txTm_s, &req.txTm_f, x.t1);
+    if( (true == xleave) && (true == have_prev) ){
+      /* Like chrony, our last receive and the server receive of the previous exchange */
+      sim_put(&req.origTm_s, &req.origTm_f, prev.t2);
+      sim_put(&req.rxTm_s, &req.rxTm_f, prev.t4);
+    }
+
+    /* The server takes the request, reads the transmit time and the packet leaves later */
+    x.t2 = x.t1 + SIM_PATH_NS + sim_jitter(SIM_PATH_JITTER_NS);
+    sim_now = x.t2 + SIM_PROCESS_NS;
+    uint16_t len = responder.Respond(&client, (const uint8_t*)&req, sizeof(req), out, sim_stamp(x.t2), 0);
+    TEST_ASSERT_EQUAL_UINT16(sizeof(ntp_packet_t), len);
+    int64_t sent = sim_now + SIM_SEND_NS + sim_jitter(SIM_SEND_JITTER_NS);
+    responder.Sent(&client, sim_stamp(x.t2), sim_stamp(sent));
+    x.t4 = sent + SIM_PATH_NS + sim_jitter(SIM_PATH_JITTER_NS);
+    memcpy(&resp, out, sizeof(resp));
+    TEST_ASSERT_EQUAL_INT64(x.t2, sim_ns(resp.rxTm_s, resp.rxTm_f));
+
+    x.t3 = sim_ns(resp.txTm_s, resp.txTm_f);
+    int64_t origin = sim_ns(resp.origTm_s, resp.origTm_f);
+    if( (true == have_prev) && ( origin == prev.t4 ) ){
+      /* Interleaved, the transmit time belongs to the previous exchange */
+      (*interleaved)++;
+      prev.t3 = x.t3;
+      sum += fabs(sim_offset(&prev));
+      samples++;
+    } else {
+      TEST_ASSERT_EQUAL_INT64(x.t1, origin);
+      sum += fabs(sim_offset(&x));
+      samples++;
+    }
+    prev = x;
+    have_prev = true;
+  }
+  return sum / samples;
+}
+
+/* Basic mode, the send delay shows up as half of it in the offset */
+void test_basic_asymmetry( void ){
+  char msg[80];
+  uint32_t interleaved;
+  double offset = sim_client(false, &interleaved);
+  snprintf(msg, sizeof(msg), "basic: mean offset error %.1f us", offset / 1000.0);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL_UINT32(0, interleaved);
+  TEST_ASSERT_TRUE(offset > ( SIM_SEND_NS / 2 ) * 0.9);
+}
+
+/* Interleaved mode, what is left is the jitter of the path */
+void test_interleaved_symmetry( void ){
+  char msg[80];
+  uint32_t interleaved;
+  double offset = sim_client(true, &interleaved);
+  snprintf(msg, sizeof(msg), "interleaved: mean offset error %.1f us", offset / 1000.0);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL_UINT32(SIM_POLLS - 1, interleaved);
+  TEST_ASSERT_TRUE(offset < SIM_PATH_JITTER_NS);
+}
+
+/* A client that lost a response falls back to a basic one and picks up again */
+void test_lost_response( void ){
+  NTP_Responder responder;
+  responder.SetClock(sim_read_time, NULL);
+  ntp_client_t client = NTP_Responder::ClientV4(htonl(0x0A000002u));
+  ntp_packet_t req;
+  ntp_packet_t resp;
+  uint8_t out[NTP_PACKET_MAX_LEN];
+  memset(&req, 0, sizeof(req));
+  req.flags.vn = 4;
+  req.flags.mode = 3;
+  sim_now = 1000;
+  responder.Respond(&client, (const uint8_t*)&req, sizeof(req), out, sim_stamp(1000), 0);
+  responder.Sent(&client, sim_stamp(1000), sim_stamp(5000));
+  /* Origin that does not match the last receive time */
+  sim_put(&req.origTm_s, &req.origTm_f, 999);
+  sim_now = SIM_POLL_NS;
+  responder.Respond(&client, (const uint8_t*)&req, sizeof(req), out, sim_stamp(SIM_POLL_NS), 0);
+  memcpy(&resp, out, sizeof(resp));
+  TEST_ASSERT_EQUAL_INT64(SIM_POLL_NS, sim_ns(resp.txTm_s, resp.txTm_f));
+  TEST_ASSERT_EQUAL_UINT32(0, responder.GetStats().interleaved);
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_basic_asymmetry);
+  RUN_TEST(test_interleaved_symmetry);
+  RUN_TEST(test_lost_response);
+  return UNITY_END();
+}
@@ -0,0 +1,134 @@
+/*
+ * Sub second interpolation from a PPS latched free running timer. A simulated
+ * 40MHz timer that runs off nominal is latched by PPS edges with interrupt
+ * latency, the servo disciplines the second boundary and the time read in
+ * between is compared with the true time.
+ */
+#include <unity.h>
+#include <math.h>
+#include <random>
+#include "ntp_timestamp.h"
+#include "ntp_servo.h"
+
+#define TIMER_NOMINAL ( 40000000 )
+
+/* Interrupt latency of the PPS edge, 0 to 500ns */
+#define LATENCY_TICKS ( 20 )
+
+typedef struct {
+  NTP_ClockServo servo;
+  double ticks_per_second;  /* True rate of the timer */
+  double boundary;          /* Timer value at the true start of the current second */
+  uint64_t seconds;         /* Second counter, as Timecore keeps it */
+  std::mt19937 rng;
+} sim_clock_t;
+
+static sim_clock_t sim;
+
+void setUp( void ){
+}
+
+void tearDown( void ){
+}
+
+/* Starts a timer that runs ppm off nominal */
+static void sim_begin( double ppm ){
+  ntp_servo_settings_t conf = NTP_ClockServo::GetDefaultConfig();
+  sim.servo.Begin(TIMER_NOMINAL, &conf);
+  sim.ticks_per_second = TIMER_NOMINAL * ( 1.0 + ppm * 1e-6 );
+  sim.boundary = 123456789.0;
+  sim.seconds = 3900000000ull;
+  sim.rng.seed(1);
+}
+
+/* Lets a second pass and latches the timer at its PPS edge */
+static void sim_pps( void ){
+  sim.boundary += sim.ticks_per_second;
+  uint64_t latch = (uint64_t)sim.boundary + ( sim.rng() % ( LATENCY_TICKS + 1 ) );
+  sim.seconds += sim.servo.Edge(latch);
+}
+
+/* Reads the clock at a point of the current second, returns the error in ns */
+static double sim_read_error( double part ){
+  uint64_t now = (uint64_t)( sim.boundary + ( part * sim.ticks_per_second ) );
+  uint64_t seconds = sim.seconds;
+  uint32_t fraction = ntp_interpolate_fraction(&seconds, now - sim.servo.GetPhase(), sim.servo.GetFrequency(), true);
+  double read = (double)( seconds - sim.seconds ) + ( (double)fraction / 4294967296.0 );
+  return ( read - part ) * 1e9;
+}
+
+/* Runs a timer ppm off nominal to lock and returns the largest read error after that */
+static double run_locked( double ppm ){
+  sim_begin(ppm);
+  for(uint16_t i=0;i<600;i++){
+    sim_pps();
+  }
+  TEST_ASSERT_EQUAL(NTP_SERVO_LOCK, sim.servo.GetState());
+  double worst = 0;
+  std::uniform_real_distribution<double> part(0.0, 1.0);
+  for(uint16_t i=0;i<600;i++){
+    sim_pps();
+    for(uint8_t j=0;j<16;j++){
+      double err = fabs(sim_read_error(part(sim.rng)));
+      if(err > worst){
+        worst = err;
+      }
+    }
+  }
+  return worst;
+}
+
+/* Edge cases of the interpolation itself */
+void test_fraction_limits( void ){
+  uint64_t seconds = 10;
+  TEST_ASSERT_EQUAL_UINT32(0, ntp_interpolate_fraction(&seconds, 1000, 0, true));
+  TEST_ASSERT_EQUAL_UINT32(0, ntp_interpolate_fraction(&seconds, (uint64_t)-5, TIMER_NOMINAL, true));
+  TEST_ASSERT_EQUAL_UINT32(0x80000000u, ntp_interpolate_fraction(&seconds, TIMER_NOMINAL / 2, TIMER_NOMINAL, false));
+  TEST_ASSERT_EQUAL_UINT64(10, seconds);
+  /* Overdue, held at the end of the second or carried into the next ones */
+  TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFu, ntp_interpolate_fraction(&seconds, 2 * TIMER_NOMINAL + 10, TIMER_NOMINAL, false));
+  TEST_ASSERT_EQUAL_UINT64(10, seconds);
+  TEST_ASSERT_EQUAL_UINT32(0x80000000u, ntp_interpolate_fraction(&seconds, ( 2 * TIMER_NOMINAL ) + ( TIMER_NOMINAL / 2 ), TIMER_NOMINAL, true));
+  TEST_ASSERT_EQUAL_UINT64(12, seconds);
+}
+
+/* One tick of a 40MHz timer is 25ns, the fraction resolves it */
+void test_fraction_resolution( void ){
+  uint64_t seconds = 0;
+  uint32_t prev = ntp_interpolate_fraction(&seconds, 0, TIMER_NOMINAL, false);
+  for(uint32_t tick=1;tick<TIMER_NOMINAL;tick+=9973){
+    uint32_t f = ntp_interpolate_fraction(&seconds, tick, TIMER_NOMINAL, false);
+    TEST_ASSERT_TRUE(f > prev);
+    prev = f;
+  }
+  /* Two reads one tick apart differ, the old 1ms counter gave both the same fraction */
+  TEST_ASSERT_TRUE( ntp_interpolate_fraction(&seconds, 1000, TIMER_NOMINAL, false) != ntp_interpolate_fraction(&seconds, 1001, TIMER_NOMINAL, false) );
+}
+
+/* A timer on nominal and ones off by the usual crystal tolerance stay within 1us */
+void test_error_below_1us( void ){
+  const double offsets[] = { 0.0, 23.0, -41.5, 80.0 };
+  char msg[80];
+  for(uint8_t i=0;i<sizeof(offsets)/sizeof(offsets[0]);i++){
+    double worst = run_locked(offsets[i]);
+    snprintf(msg, sizeof(msg), "%+.1f ppm: largest interpolation error %.0f ns", offsets[i], worst);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_THAN(1000.0, worst);
+  }
+}
+
+/* Reads late in a second that had no edge yet carry on at the disciplined rate */
+void test_missing_edge( void ){
+  run_locked(23.0);
+  double err = fabs(sim_read_error(1.5));
+  TEST_ASSERT_LESS_THAN(1000.0, err);
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_fraction_limits);
+  RUN_TEST(test_fraction_resolution);
+  RUN_TEST(test_error_below_1us);
+  RUN_TEST(test_missing_edge);
+  return UNITY_END();
+}
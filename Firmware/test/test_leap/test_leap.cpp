@@ -0,0 +1,216 @@
+/*
+ * Leap seconds. A day around the leap replayed through the second counter as
+ * the PPS tick advances it, read four times a second. Insert and delete, step
+ * and smear. The leap indicator goes on the wire through the responder on the
+ * day of the leap only.
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include "ntp_leap.h"
+#include "ntp_responder.h"
+
+/* 2017-01-01 00:00:00, the last leap second was inserted before it */
+#define LEAP_UNIX ( 1483228800u )
+#define LEAP_NTP ( (uint64_t)LEAP_UNIX + NTP_TIMESTAMP_DELTA )
+/* The replay starts a day and a bit before the leap and ends a day after it */
+#define REPLAY_START ( LEAP_NTP - NTP_LEAP_DAY - 10 )
+#define REPLAY_SECONDS ( ( 2 * NTP_LEAP_DAY ) + 20 )
+
+typedef struct {
+  uint32_t backward;     /* Reads earlier than the one before */
+  uint32_t jumps;        /* Reads more than a quarter second plus the smear rate after the one before */
+  double min_step;
+  double max_step;
+  uint32_t li_wire;      /* Responses with the leap indicator set */
+  uint64_t li_first;     /* Counter of the first and last response with it */
+  uint64_t li_last;
+  uint8_t li_value;
+  uint32_t roundtrip;    /* Seconds FromUTC ( ToUTC ) does not give back */
+  uint64_t end;          /* Counter after the replay */
+} replay_t;
+
+static ntp_time64_t served;
+
+static ntp_timestamp_t served_time( void ){
+  return ntp_time64_to_timestamp(served);
+}
+
+void setUp( void ){
+}
+
+void tearDown( void ){
+}
+
+/* One PPS tick per second, the time is read a quarter second apart in between */
+static replay_t replay( int8_t direction, bool smear ){
+  replay_t r;
+  NTP_LeapSecond leap;
+  NTP_Responder* responder = new NTP_Responder();
+  ntp_server_state_t state;
+  ntp_packet_t req;
+  uint8_t out[NTP_PACKET_MAX_LEN];
+  leap_settings_t conf = { LEAP_UNIX, direction, smear };
+  memset(&r, 0, sizeof(r));
+  memset(&state, 0, sizeof(state));
+  memset(&req, 0, sizeof(req));
+  r.min_step = 1.0;
+  state.stratum = 1;
+  memcpy(state.refid, "GPS", 4);
+  responder->SetClock(served_time, NULL);
+  responder->SetServerState(&state);
+  req.flags.vn = 4;
+  req.flags.mode = 3;
+  leap.SetConfig(conf);
+
+  uint64_t counter = REPLAY_START;
+  bool first = true;
+  ntp_time64_t prev = 0;
+  for(uint32_t s=0;s<REPLAY_SECONDS;s++){
+    counter = leap.Next(counter);
+    uint64_t check;
+    if( (true == leap.FromUTC(leap.ToUTC(counter), &check)) && (check != counter) ){
+      r.roundtrip++;
+    }
+    /* The server refreshes its header from the indicator, as RefreshServerState does */
+    uint8_t li = leap.GetIndicator(counter);
+    if(li != state.leap){
+      state.leap = li;
+      responder->SetServerState(&state);
+    }
+    for(uint8_t q=0;q<4;q++){
+      served = leap.Smear(counter, (uint32_t)q << 30);
+      if(false == first){
+        double d = (double)ntp_time64_diff(served, prev) / NTP_TIME64_SECOND;
+        r.backward += ( d < 0 ) ? 1 : 0;
+        r.jumps += ( d > 0.25 + 1e-4 ) ? 1 : 0;
+        r.min_step = ( d < r.min_step ) ? d : r.min_step;
+        r.max_step = ( d > r.max_step ) ? d : r.max_step;
+      }
+      first = false;
+      prev = served;
+    }
+    /* One request per second, every second from another client */
+    ntp_client_t client = NTP_Responder::ClientV4(htonl(0x0A000000u + s));
+    req.txTm_s = htonl((uint32_t)counter);
+    TEST_ASSERT_EQUAL_UINT16(sizeof(ntp_packet_t), responder->Respond(&client, (const uint8_t*)&req, sizeof(req), out, served_time(), 0));
+    uint8_t wire = ((ntp_packet_t*)out)->flags.li;
+    if(wire != 0){
+      if(0 == r.li_wire){
+        r.li_first = counter;
+      }
+      r.li_last = counter;
+      r.li_value = wire;
+      r.li_wire++;
+    }
+  }
+  r.end = counter;
+  delete responder;
+  return r;
+}
+
+/* 23:59:59 is repeated, the time read steps back once by a second */
+void test_insert_step( void ){
+  replay_t r = replay(1, false);
+  TEST_ASSERT_EQUAL_UINT64(REPLAY_START + REPLAY_SECONDS - 1, r.end);
+  TEST_ASSERT_EQUAL_UINT32(1, r.backward);
+  TEST_ASSERT_EQUAL_UINT32(0, r.jumps);
+  TEST_ASSERT_TRUE(r.min_step == -0.75);
+  TEST_ASSERT_EQUAL_UINT32(0, r.roundtrip);
+  /* The whole day before the leap and nothing after it */
+  TEST_ASSERT_EQUAL_UINT8(1, r.li_value);
+  TEST_ASSERT_EQUAL_UINT64(LEAP_NTP - NTP_LEAP_DAY, r.li_first);
+  TEST_ASSERT_EQUAL_UINT64(LEAP_NTP - 1, r.li_last);
+  TEST_ASSERT_EQUAL_UINT32(NTP_LEAP_DAY + 1, r.li_wire);
+}
+
+/* 23:59:59 is skipped, the time read jumps ahead once by a second */
+void test_delete_step( void ){
+  replay_t r = replay(-1, false);
+  TEST_ASSERT_EQUAL_UINT64(REPLAY_START + REPLAY_SECONDS + 1, r.end);
+  TEST_ASSERT_EQUAL_UINT32(0, r.backward);
+  TEST_ASSERT_EQUAL_UINT32(1, r.jumps);
+  TEST_ASSERT_TRUE(r.max_step == 1.25);
+  TEST_ASSERT_EQUAL_UINT32(0, r.roundtrip);
+  TEST_ASSERT_EQUAL_UINT8(2, r.li_value);
+  TEST_ASSERT_EQUAL_UINT64(LEAP_NTP - NTP_LEAP_DAY, r.li_first);
+  TEST_ASSERT_EQUAL_UINT64(LEAP_NTP - 2, r.li_last);
+  TEST_ASSERT_EQUAL_UINT32(NTP_LEAP_DAY - 1, r.li_wire);
+}
+
+/* Smeared the time read never steps, the rate changes by one part in NTP_LEAP_SMEAR */
+static void check_smear( const replay_t* r, int8_t direction ){
+  char msg[120];
+  double rate = 0.25 / NTP_LEAP_SMEAR;
+  snprintf(msg, sizeof(msg), "direction %d, steps of %.9f to %.9f s read every 0.25 s",
+           direction, r->min_step, r->max_step);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL_UINT64(REPLAY_START + REPLAY_SECONDS - direction, r->end);
+  TEST_ASSERT_EQUAL_UINT32(0, r->backward);
+  TEST_ASSERT_TRUE(r->min_step > 0.25 - ( 1.01 * rate ));
+  TEST_ASSERT_TRUE(r->max_step < 0.25 + ( 1.01 * rate ));
+  TEST_ASSERT_EQUAL_UINT32(0, r->roundtrip);
+  /* Clients would step on their own, the indicator stays off */
+  TEST_ASSERT_EQUAL_UINT32(0, r->li_wire);
+}
+
+void test_insert_smear( void ){
+  replay_t r = replay(1, true);
+  check_smear(&r, 1);
+  TEST_ASSERT_TRUE(r.min_step < 0.25);
+}
+
+void test_delete_smear( void ){
+  replay_t r = replay(-1, true);
+  check_smear(&r, -1);
+  TEST_ASSERT_TRUE(r.max_step > 0.25);
+}
+
+/* Within the smear the counter is on the old UTC, the time read is half a second off at the leap */
+void test_smear_midpoint( void ){
+  NTP_LeapSecond leap;
+  leap_settings_t conf = { LEAP_UNIX, 1, true };
+  leap.SetConfig(conf);
+  TEST_ASSERT_EQUAL_UINT64(LEAP_NTP - 1, leap.ToUTC(LEAP_NTP));
+  ntp_time64_t t = leap.Smear(LEAP_NTP, 0);
+  int64_t off = ntp_time64_diff(ntp_time64_make((uint32_t)LEAP_NTP, 0), t);
+  TEST_ASSERT_INT64_WITHIN(NTP_TIME64_SECOND / 1000, NTP_TIME64_SECOND / 2, off);
+  /* Well before and after the smear nothing is changed */
+  TEST_ASSERT_EQUAL_UINT64(ntp_time64_make((uint32_t)( LEAP_NTP - NTP_LEAP_DAY ), 5), leap.Smear(LEAP_NTP - NTP_LEAP_DAY, 5));
+  TEST_ASSERT_EQUAL_UINT64(ntp_time64_make((uint32_t)( LEAP_NTP + NTP_LEAP_DAY ), 5), leap.Smear(LEAP_NTP + NTP_LEAP_DAY, 5));
+}
+
+/* A source read at the leap is not taken, the sources don't agree on that second */
+void test_source_around_leap( void ){
+  NTP_LeapSecond leap;
+  leap_settings_t conf = { LEAP_UNIX, 1, false };
+  uint64_t counter = 0;
+  leap.SetConfig(conf);
+  TEST_ASSERT_FALSE(leap.FromUTC(LEAP_NTP - 1, &counter));
+  TEST_ASSERT_FALSE(leap.FromUTC(LEAP_NTP + 1, &counter));
+  TEST_ASSERT_TRUE(leap.FromUTC(LEAP_NTP + 2, &counter));
+  TEST_ASSERT_EQUAL_UINT64(LEAP_NTP + 2, counter);
+}
+
+/* An announcement that is not at midnight is dropped */
+void test_invalid_config( void ){
+  NTP_LeapSecond leap;
+  leap_settings_t conf = { LEAP_UNIX + 1, 1, false };
+  leap.SetConfig(conf);
+  TEST_ASSERT_EQUAL_INT8(0, leap.GetConfig().direction);
+  TEST_ASSERT_EQUAL_UINT8(0, leap.GetIndicator(LEAP_NTP - 1));
+  TEST_ASSERT_EQUAL_UINT64(LEAP_NTP, leap.Next(LEAP_NTP - 1));
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_insert_step);
+  RUN_TEST(test_delete_step);
+  RUN_TEST(test_insert_smear);
+  RUN_TEST(test_delete_smear);
+  RUN_TEST(test_smear_midpoint);
+  RUN_TEST(test_source_around_leap);
+  RUN_TEST(test_invalid_config);
+  return UNITY_END();
+}
@@ -0,0 +1,181 @@
+/*
+ * Client list, 100k distinct clients pushed through the table. The memory is
+ * the size of the object, the list holds the most recent ones in order and the
+ * time per packet does not grow with the clients seen. IPv6 clients are kept
+ * with their full address and read back as they were seen.
+ */
+#include <unity.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <set>
+#include "ntp_mru.h"
+#include "ntp_latency.h"
+
+#define STRESS_CLIENTS ( 100000 )
+#define STRESS_CHUNK ( 10000 )
+
+static NTP_MRUList* list;
+static ntp_mru_entry_t out[NTP_MRU_ENTRIES];
+static const uint8_t hash_key[NTP_ADDR_KEY_LEN] = { 0x5A, 0x17, 0xC3, 0x08, 0x91, 0x2E, 0x44, 0xF0,
+                                                     0x3B, 0x6D, 0xA2, 0x7F, 0x10, 0xE9, 0x55, 0xC6 };
+
+/* Records an IPv4 client given in host order, hashed as the responder does */
+static void update( uint32_t addr, ntp_timestamp_t now, uint8_t version, uint8_t mode ){
+  ntp_addr_t a = ntp_addr_from_v4(htonl(addr));
+  list->Update(&a, ntp_addr_hash(&a, hash_key), now, version, mode);
+}
+
+/* The IPv4 address of an entry in host order */
+static uint32_t v4_of( const ntp_mru_entry_t* e ){
+  uint32_t addr;
+  TEST_ASSERT_TRUE(ntp_addr_is_v4(&e->client));
+  memcpy(&addr, &e->client.bytes[12], sizeof(addr));
+  return ntohl(addr);
+}
+
+void setUp( void ){
+  list = new NTP_MRUList();
+}
+
+void tearDown( void ){
+  delete list;
+}
+
+/* Every client sends one request, every third packet comes from a client seen before */
+void test_stress_100k( void ){
+  char msg[120];
+  ntp_timestamp_t t = { 3900000000u, 0 };
+  double chunk_ns[STRESS_CLIENTS / STRESS_CHUNK];
+  uint32_t packets = 0;
+  for(uint32_t chunk=0;chunk<STRESS_CLIENTS/STRESS_CHUNK;chunk++){
+    uint32_t start = NTP_LatencyStats::Now();
+    uint32_t n = 0;
+    for(uint32_t i=chunk*STRESS_CHUNK;i<(chunk+1)*STRESS_CHUNK;i++){
+      t.fraction += 0x01000000u;
+      if(t.fraction == 0){
+        t.seconds++;
+      }
+      update(0x0A000000u + ( i * 7919u ), t, 4, 3);
+      n++;
+      if( (i % 3) == 0 ){
+        update(0x0A000000u + ( ( i / 2 ) * 7919u ), t, 4, 3);
+        n++;
+      }
+    }
+    uint32_t end = NTP_LatencyStats::Now();
+    chunk_ns[chunk] = (double)(uint32_t)( end - start ) * 1000.0 / NTP_LatencyStats::GetCyclesPerUs() / n;
+    packets += n;
+  }
+  double lo = chunk_ns[0];
+  double hi = chunk_ns[0];
+  for(uint32_t c=1;c<STRESS_CLIENTS/STRESS_CHUNK;c++){
+    lo = ( chunk_ns[c] < lo ) ? chunk_ns[c] : lo;
+    hi = ( chunk_ns[c] > hi ) ? chunk_ns[c] : hi;
+  }
+  snprintf(msg, sizeof(msg), "%u packets, %u bytes, %u evictions, %.1f to %.1f ns per packet over the chunks of %u clients",
+           packets, (unsigned)sizeof(NTP_MRUList), list->GetEvictions(), lo, hi, STRESS_CHUNK);
+  TEST_MESSAGE(msg);
+
+  /* Full and no more than full, the rest was thrown out */
+  TEST_ASSERT_EQUAL_UINT16(NTP_MRU_ENTRIES, list->Count());
+  TEST_ASSERT_TRUE(list->GetEvictions() >= STRESS_CLIENTS - NTP_MRU_ENTRIES);
+  TEST_ASSERT_TRUE(sizeof(NTP_MRUList) < ( NTP_MRU_ENTRIES * ( sizeof(ntp_mru_entry_t) + 4 ) ) + 64);
+  /* The cost of the last chunk is that of the first, within the noise of the host */
+  TEST_ASSERT_TRUE(hi < 4 * lo + 50.0);
+
+  /* Most recent first, every client once */
+  uint16_t n = list->GetClients(out, 0, NTP_MRU_ENTRIES);
+  TEST_ASSERT_EQUAL_UINT16(NTP_MRU_ENTRIES, n);
+  std::set<uint32_t> seen;
+  for(uint16_t i=0;i<n;i++){
+    seen.insert(v4_of(&out[i]));
+    if(i > 0){
+      TEST_ASSERT_TRUE(ntp_time64_diff(ntp_time64_from_timestamp(out[i-1].last), ntp_time64_from_timestamp(out[i].last)) >= 0);
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(n, seen.size());
+  /* The newest client is the last one sent */
+  TEST_ASSERT_TRUE( ( v4_of(&out[0]) == 0x0A000000u + ( ( STRESS_CLIENTS - 1 ) * 7919u ) ) ||
+                    ( v4_of(&out[0]) == 0x0A000000u + ( ( ( STRESS_CLIENTS - 1 ) / 2 ) * 7919u ) ) );
+}
+
+/* A client polling at a fixed interval, the count and the average interval */
+void test_repeated_client( void ){
+  ntp_timestamp_t t = { 3900000000u, 0 };
+  for(uint8_t i=0;i<10;i++){
+    t.seconds += 64;
+    update(42, t, 4, 3);
+  }
+  update(43, t, 3, 3);
+  TEST_ASSERT_EQUAL_UINT16(2, list->GetClients(out, 0, 2));
+  TEST_ASSERT_EQUAL_UINT32(43, v4_of(&out[0]));
+  TEST_ASSERT_EQUAL_UINT8(3, out[0].version);
+  TEST_ASSERT_EQUAL_UINT32(42, v4_of(&out[1]));
+  TEST_ASSERT_EQUAL_UINT32(10, out[1].count);
+  TEST_ASSERT_EQUAL_UINT32(3900000064u, out[1].first.seconds);
+  TEST_ASSERT_EQUAL_UINT32(64, NTP_MRUList::AverageInterval(&out[1]));
+  TEST_ASSERT_EQUAL_UINT32(0, list->GetEvictions());
+}
+
+/* Pages of the list join up without gaps */
+void test_paging( void ){
+  ntp_timestamp_t t = { 3900000000u, 0 };
+  for(uint16_t i=0;i<100;i++){
+    t.seconds++;
+    update(1000 + i, t, 4, 3);
+  }
+  uint16_t start = 0;
+  uint16_t total = 0;
+  while(true){
+    uint16_t n = list->GetClients(out, start, 16);
+    for(uint16_t i=0;i<n;i++){
+      TEST_ASSERT_EQUAL_UINT32(1000 + 99 - ( start + i ), v4_of(&out[i]));
+    }
+    total += n;
+    if(n < 16){
+      break;
+    }
+    start += n;
+  }
+  TEST_ASSERT_EQUAL_UINT16(100, total);
+}
+
+/* IPv6 clients of one /64 are each kept, the resume point finds them by their full address */
+void test_ipv6_clients( void ){
+  ntp_timestamp_t t = { 3900000000u, 0 };
+  char text[NTP_ADDR_STR_LEN];
+  uint8_t bytes[NTP_ADDR_LEN] = { 0x20, 0x01, 0x0D, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+  for(uint8_t i=1;i<=3;i++){
+    bytes[15] = i;
+    ntp_addr_t a = ntp_addr_from_v6(bytes);
+    t.seconds++;
+    list->Update(&a, ntp_addr_hash(&a, hash_key), t, 4, 3);
+  }
+  TEST_ASSERT_EQUAL_UINT16(3, list->GetClients(out, 0, 3));
+  ntp_addr_format(&out[0].client, text, sizeof(text));
+  TEST_ASSERT_EQUAL_STRING("2001:db8::3", text);
+  ntp_addr_format(&out[2].client, text, sizeof(text));
+  TEST_ASSERT_EQUAL_STRING("2001:db8::1", text);
+  /* Read back from the text a mrulist reader sends, the oldest client is the resume point */
+  ntp_mru_resume_t resume;
+  TEST_ASSERT_TRUE(ntp_addr_parse("[2001:db8::1]:123", &resume.client));
+  resume.hash = ntp_addr_hash(&resume.client, hash_key);
+  resume.last = out[2].last;
+  TEST_ASSERT_EQUAL_INT32(2, list->GetNewer(&resume, 1, out, NTP_MRU_ENTRIES));
+  ntp_addr_format(&out[0].client, text, sizeof(text));
+  TEST_ASSERT_EQUAL_STRING("2001:db8::2", text);
+  /* An IPv4 client has its dotted address */
+  update(0xC0000201u, t, 4, 3);
+  TEST_ASSERT_EQUAL_UINT16(1, list->GetClients(out, 0, 1));
+  ntp_addr_format(&out[0].client, text, sizeof(text));
+  TEST_ASSERT_EQUAL_STRING("192.0.2.1", text);
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_stress_100k);
+  RUN_TEST(test_repeated_client);
+  RUN_TEST(test_paging);
+  RUN_TEST(test_ipv6_clients);
+  return UNITY_END();
+}
@@ -0,0 +1,281 @@
+/*
+ * NTS for NTP. The cookies are made the way ntp_nts.h asks it of an external
+ * NTS-KE server, the client side is built here on the AES-SIV of the firmware.
+ * Requests go through the responder, the response is checked as a client
+ * would. Responses per second and the time added to a plain response.
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include "ntp_nts.h"
+#include "ntp_responder.h"
+#include "ntp_latency.h"
+
+#define BENCH_REQUESTS ( 20000 )
+
+/* Header, unique identifier, cookie, placeholders and authenticator of a request */
+#define UID_LEN ( 32 )
+#define COOKIE_EF_LEN ( 4 + NTP_NTS_COOKIE_LEN )
+#define AUTH_EF_LEN ( 8 + NTP_NTS_NONCE_LEN + NTP_SIV_TAG_LEN )
+
+typedef struct {
+  uint8_t c2s[NTP_SIV_KEY_LEN];
+  uint8_t s2c[NTP_SIV_KEY_LEN];
+  uint8_t cookie[NTP_NTS_COOKIE_LEN];
+  uint8_t uid[UID_LEN];
+} nts_client_t;
+
+static nts_settings_t conf;
+static NTP_Responder* responder;
+static nts_client_t client;
+static ntp_client_t addr;
+static uint8_t req[NTP_PACKET_MAX_LEN];
+static uint8_t out[NTP_PACKET_MAX_LEN];
+
+static ntp_timestamp_t fixed_time( void ){
+  ntp_timestamp_t t = { 3900000000u, 0x80000000u };
+  return t;
+}
+
+static void put16( uint8_t* p, uint16_t v ){
+  p[0] = v >> 8;
+  p[1] = v;
+}
+
+static uint16_t get16( const uint8_t* p ){
+  return ( (uint16_t)p[0] << 8 ) | p[1];
+}
+
+/* The cookie of the contract in ntp_nts.h, as an external NTS-KE server makes it */
+static void ke_cookie( uint32_t keyid, const uint8_t* master, const nts_client_t* c, uint8_t* cookie ){
+  ntp_siv_key_t key;
+  uint8_t* plain = &cookie[4 + NTP_NTS_NONCE_LEN + NTP_SIV_TAG_LEN];
+  cookie[0] = keyid >> 24;
+  cookie[1] = keyid >> 16;
+  cookie[2] = keyid >> 8;
+  cookie[3] = keyid;
+  for(uint8_t i=0;i<NTP_NTS_NONCE_LEN;i++){
+    cookie[4 + i] = 0x30 + i;
+  }
+  put16(plain, NTP_NTS_AEAD_AES_SIV_CMAC_256);
+  put16(&plain[2], 0);
+  memcpy(&plain[4], c->c2s, NTP_SIV_KEY_LEN);
+  memcpy(&plain[4 + NTP_SIV_KEY_LEN], c->s2c, NTP_SIV_KEY_LEN);
+  ntp_siv_setkey(&key, master);
+  ntp_siv_encrypt(&key, cookie, 4, &cookie[4], NTP_NTS_NONCE_LEN, plain, NTP_NTS_COOKIE_PLAIN_LEN, &cookie[4 + NTP_NTS_NONCE_LEN]);
+  ntp_siv_free(&key);
+}
+
+/* A mode 3 request with the cookie of the client and placeholders, authenticated with C2S */
+static uint16_t client_request( const nts_client_t* c, uint8_t placeholders, uint8_t* pkt ){
+  ntp_siv_key_t key;
+  uint16_t pos = NTP_HEADER_LEN;
+  memset(pkt, 0, NTP_HEADER_LEN);
+  pkt[0] = ( 4 << 3 ) | 3;
+  pkt[40] = 0x12;
+  put16(&pkt[pos], NTP_NTS_EF_UID);
+  put16(&pkt[pos + 2], 4 + UID_LEN);
+  memcpy(&pkt[pos + 4], c->uid, UID_LEN);
+  pos += 4 + UID_LEN;
+  put16(&pkt[pos], NTP_NTS_EF_COOKIE);
+  put16(&pkt[pos + 2], COOKIE_EF_LEN);
+  memcpy(&pkt[pos + 4], c->cookie, NTP_NTS_COOKIE_LEN);
+  pos += COOKIE_EF_LEN;
+  for(uint8_t i=0;i<placeholders;i++){
+    put16(&pkt[pos], NTP_NTS_EF_PLACEHOLDER);
+    put16(&pkt[pos + 2], COOKIE_EF_LEN);
+    memset(&pkt[pos + 4], 0, NTP_NTS_COOKIE_LEN);
+    pos += COOKIE_EF_LEN;
+  }
+  uint16_t auth = pos;
+  put16(&pkt[pos], NTP_NTS_EF_AUTH);
+  put16(&pkt[pos + 2], AUTH_EF_LEN);
+  put16(&pkt[pos + 4], NTP_NTS_NONCE_LEN);
+  put16(&pkt[pos + 6], NTP_SIV_TAG_LEN);
+  for(uint8_t i=0;i<NTP_NTS_NONCE_LEN;i++){
+    pkt[pos + 8 + i] = 0x50 + i;
+  }
+  ntp_siv_setkey(&key, c->c2s);
+  ntp_siv_encrypt(&key, pkt, auth, &pkt[pos + 8], NTP_NTS_NONCE_LEN, &pkt[pos + 8 + NTP_NTS_NONCE_LEN + NTP_SIV_TAG_LEN], 0, &pkt[pos + 8 + NTP_NTS_NONCE_LEN]);
+  ntp_siv_free(&key);
+  return pos + AUTH_EF_LEN;
+}
+
+/* Checks the response as a client, returns the cookies in it and keeps the first one */
+static uint8_t client_check( nts_client_t* c, const uint8_t* pkt, uint16_t len ){
+  ntp_siv_key_t key;
+  uint8_t plain[NTP_PACKET_MAX_LEN];
+  uint16_t pos = NTP_HEADER_LEN;
+  TEST_ASSERT_EQUAL_UINT16(NTP_NTS_EF_UID, get16(&pkt[pos]));
+  TEST_ASSERT_EQUAL_MEMORY(c->uid, &pkt[pos + 4], UID_LEN);
+  pos += get16(&pkt[pos + 2]);
+  TEST_ASSERT_EQUAL_UINT16(NTP_NTS_EF_AUTH, get16(&pkt[pos]));
+  TEST_ASSERT_EQUAL_UINT16(len - pos, get16(&pkt[pos + 2]));
+  uint16_t nonce_len = get16(&pkt[pos + 4]);
+  uint16_t ct_len = get16(&pkt[pos + 6]);
+  const uint8_t* nonce = &pkt[pos + 8];
+  const uint8_t* ct = &nonce[( nonce_len + 3 ) & ~3];
+  uint16_t plain_len = ct_len - NTP_SIV_TAG_LEN;
+  memcpy(plain, &ct[NTP_SIV_TAG_LEN], plain_len);
+  ntp_siv_setkey(&key, c->s2c);
+  TEST_ASSERT_TRUE(ntp_siv_decrypt(&key, pkt, pos, nonce, nonce_len, plain, plain_len, ct));
+  ntp_siv_free(&key);
+  uint8_t cookies = 0;
+  for(uint16_t p=0;p<plain_len;p+=get16(&plain[p + 2])){
+    TEST_ASSERT_EQUAL_UINT16(NTP_NTS_EF_COOKIE, get16(&plain[p]));
+    TEST_ASSERT_EQUAL_UINT16(COOKIE_EF_LEN, get16(&plain[p + 2]));
+    if(0 == cookies){
+      memcpy(c->cookie, &plain[p + 4], NTP_NTS_COOKIE_LEN);
+    }
+    cookies++;
+  }
+  return cookies;
+}
+
+void setUp( void ){
+  ntp_server_state_t state;
+  ratelimit_settings_t rl = NTP_RateLimiter::GetDefaultConfig();
+  memset(&state, 0, sizeof(state));
+  state.stratum = 1;
+  memcpy(state.refid, "GPS", 4);
+  rl.enabled = false;
+  conf = NTP_NTS::GetDefaultConfig();
+  conf.enabled = true;
+  responder = new NTP_Responder();
+  responder->SetClock(fixed_time, NULL);
+  responder->SetServerState(&state);
+  responder->SetRateLimit(rl);
+  responder->SetNTS(&conf);
+  addr = NTP_Responder::ClientV4(htonl(0x0A000001u));
+  for(uint8_t i=0;i<NTP_SIV_KEY_LEN;i++){
+    client.c2s[i] = i;
+    client.s2c[i] = 0x80 + i;
+  }
+  for(uint8_t i=0;i<UID_LEN;i++){
+    client.uid[i] = 0xA0 + i;
+  }
+  ke_cookie(conf.keyid, conf.key, &client, client.cookie);
+}
+
+void tearDown( void ){
+  delete responder;
+}
+
+/* A cookie of the external NTS-KE is taken, the response authenticates and carries fresh cookies */
+void test_external_ke_cookie( void ){
+  uint16_t len = client_request(&client, 2, req);
+  uint16_t resp = responder->Respond(&addr, req, len, out, fixed_time(), 0);
+  TEST_ASSERT_TRUE(resp > NTP_HEADER_LEN);
+  TEST_ASSERT_TRUE(resp <= len);
+  TEST_ASSERT_EQUAL_UINT8(4, ((ntp_packet_t*)out)->flags.mode);
+  TEST_ASSERT_EQUAL_MEMORY("GPS", &out[12], 4);
+  TEST_ASSERT_EQUAL_UINT8(3, client_check(&client, out, resp));
+  TEST_ASSERT_EQUAL_UINT32(1, responder->GetStats().nts);
+
+  /* The cookie we made is taken in turn */
+  len = client_request(&client, 0, req);
+  resp = responder->Respond(&addr, req, len, out, fixed_time(), 0);
+  TEST_ASSERT_EQUAL_UINT8(1, client_check(&client, out, resp));
+  TEST_ASSERT_EQUAL_UINT32(2, responder->GetStats().nts);
+}
+
+/* A changed header or an unknown key id gets the NTSN Kiss-o'-Death with the identifier echoed */
+void test_nak( void ){
+  uint16_t len = client_request(&client, 0, req);
+  req[45] ^= 1;
+  uint16_t resp = responder->Respond(&addr, req, len, out, fixed_time(), 0);
+  TEST_ASSERT_EQUAL_UINT16(NTP_HEADER_LEN + 4 + UID_LEN, resp);
+  TEST_ASSERT_EQUAL_MEMORY("NTSN", &out[12], 4);
+  TEST_ASSERT_EQUAL_MEMORY(client.uid, &out[NTP_HEADER_LEN + 4], UID_LEN);
+
+  ke_cookie(conf.keyid + 7, conf.key, &client, client.cookie);
+  len = client_request(&client, 0, req);
+  resp = responder->Respond(&addr, req, len, out, fixed_time(), 0);
+  TEST_ASSERT_EQUAL_MEMORY("NTSN", &out[12], 4);
+  TEST_ASSERT_EQUAL_UINT32(2, responder->GetStats().ntsnak);
+}
+
+/* Cookies of the previous master key are still taken, those of the one before are not */
+void test_rotation( void ){
+  uint16_t len = client_request(&client, 0, req);
+  NTP_NTS::NewKey(&conf);
+  responder->SetNTS(&conf);
+  uint16_t resp = responder->Respond(&addr, req, len, out, fixed_time(), 0);
+  TEST_ASSERT_EQUAL_UINT8(1, client_check(&client, out, resp));
+  /* The new cookie is made with the new key */
+  TEST_ASSERT_EQUAL_UINT8((uint8_t)conf.keyid, client.cookie[3]);
+  NTP_NTS::NewKey(&conf);
+  NTP_NTS::NewKey(&conf);
+  responder->SetNTS(&conf);
+  responder->Respond(&addr, req, len, out, fixed_time(), 0);
+  TEST_ASSERT_EQUAL_MEMORY("NTSN", &out[12], 4);
+}
+
+/* Switched off a NTS request is answered as a plain one, the client rejects it */
+void test_disabled( void ){
+  conf.enabled = false;
+  responder->SetNTS(&conf);
+  uint16_t len = client_request(&client, 0, req);
+  TEST_ASSERT_EQUAL_UINT16(NTP_HEADER_LEN, responder->Respond(&addr, req, len, out, fixed_time(), 0));
+  TEST_ASSERT_EQUAL_UINT32(0, responder->GetStats().nts);
+}
+
+/* Extension fields reaching past the packet or a field too short to step over are dropped */
+void test_bounds( void ){
+  NTP_NTS nts;
+  ntp_packet_info_t info;
+  ntp_nts_request_t nreq;
+  uint8_t scratch[NTP_PACKET_MAX_LEN];
+  nts.Load(&conf);
+  uint16_t len = client_request(&client, 0, req);
+  TEST_ASSERT_TRUE(ntp_parse_packet(req, len, &info));
+  TEST_ASSERT_EQUAL(NTP_NTS_OK, nts.Verify(req, len, &info, &nreq, scratch));
+  /* The authenticator would end behind the data handed in */
+  TEST_ASSERT_EQUAL(NTP_NTS_DROP, nts.Verify(req, len - 4, &info, &nreq, scratch));
+  /* A zero length field would never be left */
+  put16(&req[NTP_HEADER_LEN + 2], 0);
+  TEST_ASSERT_EQUAL(NTP_NTS_DROP, nts.Verify(req, len, &info, &nreq, scratch));
+}
+
+/* Responses per second through the responder, plain and with NTS and n new cookies */
+static double bench( const uint8_t* pkt, uint16_t len, uint16_t expect ){
+  uint32_t start = NTP_LatencyStats::Now();
+  for(uint32_t i=0;i<BENCH_REQUESTS;i++){
+    TEST_ASSERT_EQUAL_UINT16(expect, responder->Respond(&addr, pkt, len, out, fixed_time(), 0));
+  }
+  uint32_t end = NTP_LatencyStats::Now();
+  return (double)(uint32_t)( end - start ) * 1000.0 / NTP_LatencyStats::GetCyclesPerUs() / BENCH_REQUESTS;
+}
+
+void test_bench( void ){
+  char msg[120];
+  uint8_t plain[NTP_HEADER_LEN];
+  memset(plain, 0, sizeof(plain));
+  plain[0] = ( 4 << 3 ) | 3;
+  double plain_ns = bench(plain, sizeof(plain), NTP_HEADER_LEN);
+  snprintf(msg, sizeof(msg), "plain: %.0f ns per response, %.0f responses/s", plain_ns, 1e9 / plain_ns);
+  TEST_MESSAGE(msg);
+  for(uint8_t placeholders=0;placeholders<8;placeholders+=7){
+    uint16_t len = client_request(&client, placeholders, req);
+    uint16_t resp = responder->Respond(&addr, req, len, out, fixed_time(), 0);
+    TEST_ASSERT_EQUAL_UINT8(placeholders + 1, client_check(&client, out, resp));
+    /* The request is used again and again, so is its cookie */
+    double nts_ns = bench(req, len, resp);
+    snprintf(msg, sizeof(msg), "NTS with %u cookies: %.0f ns per response, %.0f responses/s, %.0f ns more than plain",
+             placeholders + 1, nts_ns, 1e9 / nts_ns, nts_ns - plain_ns);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(nts_ns > plain_ns);
+  }
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_external_ke_cookie);
+  RUN_TEST(test_nak);
+  RUN_TEST(test_rotation);
+  RUN_TEST(test_disabled);
+  RUN_TEST(test_bounds);
+  RUN_TEST(test_bench);
+  return UNITY_END();
+}
@@ -0,0 +1,158 @@
+/*
+ * Microbenchmark of the packet builder. The response built from the pre encoded
+ * template against the builder it replaced, which swapped every field of the
+ * request to host order and back and copied the refid for each packet.
+ */
+#include <unity.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include "ntp_packet.h"
+#include "ntp_latency.h"
+
+#define BENCH_RUNS ( 1000000 )
+
+static ntp_packet_t request;
+static ntp_packet_t tmpl;
+static ntp_server_state_t state;
+
+void setUp( void ){
+  memset(&request, 0, sizeof(request));
+  request.flags.vn = 4;
+  request.flags.mode = 3;
+  request.poll = 6;
+  request.txTm_s = htonl(3900000000u);
+  request.txTm_f = htonl(0x12345678u);
+  memset(&state, 0, sizeof(state));
+  state.stratum = 1;
+  state.precision = -20;
+  memcpy(state.refid, "PPS", 4);
+  state.rootDelay = 1;
+  state.rootDispersion = 1;
+  state.reference = ntp_time64_make(3900000000u, 0);
+  ntp_build_template(&tmpl, &state);
+}
+
+void tearDown( void ){
+}
+
+/* The builder of processUDPPacket before the template, kept as reference */
+static void __attribute__((noinline)) legacy_build( ntp_packet_t* resp, const ntp_packet_t* req, ntp_timestamp_t start, ntp_timestamp_t end ){
+  ntp_packet_t ntp_req;
+  memcpy(&ntp_req, req, sizeof(ntp_packet_t));
+  ntp_req.rootDelay = ntohl( ntp_req.rootDelay );
+  ntp_req.rootDispersion = ntohl( ntp_req.rootDispersion );
+  ntp_req.refId.data = ntohl( ntp_req.refId.data );
+  ntp_req.refTm_s = ntohl( ntp_req.refTm_s );
+  ntp_req.refTm_f = ntohl( ntp_req.refTm_f );
+  ntp_req.origTm_s = ntohl( ntp_req.txTm_s );
+  ntp_req.origTm_f = ntohl( ntp_req.txTm_f );
+  ntp_req.rxTm_s = ntohl( ntp_req.rxTm_s );
+  ntp_req.rxTm_f = ntohl( ntp_req.rxTm_f );
+  ntp_req.txTm_s = ntohl( ntp_req.txTm_s );
+  ntp_req.txTm_f = ntohl( ntp_req.txTm_f );
+
+  ntp_req.flags.li = 0;
+  ntp_req.flags.vn = 4;
+  ntp_req.flags.mode = 4;
+  strncpy(ntp_req.refId.c_str, "PPS", sizeof(ntp_req.refId.c_str));
+  ntp_req.stratum = 1;
+  ntp_req.precision = (uint8_t)-20;
+  ntp_req.rootDelay = 1;
+  ntp_req.rootDispersion = 1;
+  ntp_req.rxTm_s = start.seconds;
+  ntp_req.rxTm_f = start.fraction;
+  ntp_req.refTm_s = start.seconds;
+  ntp_req.refTm_f = 0;
+
+  ntp_req.rootDelay = htonl( ntp_req.rootDelay );
+  ntp_req.rootDispersion = htonl( ntp_req.rootDispersion );
+  ntp_req.refTm_s = htonl( ntp_req.refTm_s );
+  ntp_req.refTm_f = htonl( ntp_req.refTm_f );
+  ntp_req.origTm_s = htonl( ntp_req.origTm_s );
+  ntp_req.origTm_f = htonl( ntp_req.origTm_f );
+  ntp_req.rxTm_s = htonl( ntp_req.rxTm_s );
+  ntp_req.rxTm_f = htonl( ntp_req.rxTm_f );
+  ntp_req.txTm_s = htonl( end.seconds );
+  ntp_req.txTm_f = htonl( end.fraction );
+  memcpy(resp, &ntp_req, sizeof(ntp_packet_t));
+}
+
+/* The builder of the responder, template plus the timestamps */
+static void template_build( ntp_packet_t* resp, const ntp_packet_t* req, ntp_timestamp_t start, ntp_timestamp_t end ){
+  ntp_build_response(resp, &tmpl, req, ntp_time64_from_timestamp(start));
+  ntp_stamp_transmit(resp, ntp_time64_from_timestamp(end));
+}
+
+/* Time stamp counter of the host if there is one, 0 else */
+static inline uint64_t bench_cycles( void ){
+#if defined(__x86_64__) || defined(__i386__)
+  return __builtin_ia32_rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/* Runs a builder BENCH_RUNS times, returns the ns and reports the cycles per response */
+static double bench( const char* name, void(*build)(ntp_packet_t*, const ntp_packet_t*, ntp_timestamp_t, ntp_timestamp_t) ){
+  char msg[100];
+  ntp_packet_t resp;
+  volatile uint32_t sink = 0;
+  ntp_timestamp_t start = { 3900000000u, 0 };
+  uint64_t c0 = bench_cycles();
+  uint32_t t0 = NTP_LatencyStats::Now();
+  for(uint32_t i=0;i<BENCH_RUNS;i++){
+    start.fraction = i;
+    ntp_timestamp_t end = { start.seconds, i + 100 };
+    build(&resp, &request, start, end);
+    sink = sink + resp.txTm_f;
+  }
+  uint32_t t1 = NTP_LatencyStats::Now();
+  uint64_t c1 = bench_cycles();
+  double ns = (double)(uint32_t)( t1 - t0 ) * 1000.0 / NTP_LatencyStats::GetCyclesPerUs() / BENCH_RUNS;
+  snprintf(msg, sizeof(msg), "%s: %.1f ns, %.1f cycles per response", name, ns, (double)( c1 - c0 ) / BENCH_RUNS);
+  TEST_MESSAGE(msg);
+  (void)sink;
+  return ns;
+}
+
+/* Both builders put the same request dependent fields on the wire */
+void test_same_response( void ){
+  ntp_packet_t a;
+  ntp_packet_t b;
+  ntp_timestamp_t start = { 3900000001u, 0x40000000u };
+  ntp_timestamp_t end = { 3900000001u, 0x40001000u };
+  legacy_build(&a, &request, start, end);
+  template_build(&b, &request, start, end);
+  TEST_ASSERT_EQUAL_UINT8(*(uint8_t*)&a.flags, *(uint8_t*)&b.flags);
+  TEST_ASSERT_EQUAL_UINT8(a.stratum, b.stratum);
+  TEST_ASSERT_EQUAL_UINT8(a.poll, b.poll);
+  TEST_ASSERT_EQUAL_UINT8(a.precision, b.precision);
+  TEST_ASSERT_EQUAL_UINT32(a.rootDelay, b.rootDelay);
+  TEST_ASSERT_EQUAL_UINT32(a.rootDispersion, b.rootDispersion);
+  TEST_ASSERT_EQUAL_MEMORY(a.refId.c_str, b.refId.c_str, 4);
+  TEST_ASSERT_EQUAL_UINT32(request.txTm_s, b.origTm_s);
+  TEST_ASSERT_EQUAL_UINT32(request.txTm_f, b.origTm_f);
+  TEST_ASSERT_EQUAL_UINT32(a.origTm_s, b.origTm_s);
+  TEST_ASSERT_EQUAL_UINT32(a.origTm_f, b.origTm_f);
+  TEST_ASSERT_EQUAL_UINT32(a.rxTm_s, b.rxTm_s);
+  TEST_ASSERT_EQUAL_UINT32(a.rxTm_f, b.rxTm_f);
+  TEST_ASSERT_EQUAL_UINT32(a.txTm_s, b.txTm_s);
+  TEST_ASSERT_EQUAL_UINT32(a.txTm_f, b.txTm_f);
+}
+
+/* Time per response before and after */
+void test_bench_builders( void ){
+  char msg[80];
+  double before = bench("per field swap", legacy_build);
+  double after = bench("template", template_build);
+  snprintf(msg, sizeof(msg), "template takes %.0f%% of the time", after * 100.0 / before);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(after > 0);
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_same_response);
+  RUN_TEST(test_bench_builders);
+  return UNITY_END();
+}
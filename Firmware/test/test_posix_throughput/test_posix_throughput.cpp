@@ -0,0 +1,253 @@
+/*
+ * Throughput and loss of the POSIX backend over loopback. NTP_PosixServer, the
+ * batched transport of the Linux build, against a reference that works like the
+ * AsyncUDP path, one datagram per callback through a std::function and a reply
+ * buffer allocated for each response. A client sends bursts of requests at a
+ * fixed rate and counts the responses that come back. The raw lwIP transport of
+ * NTP_USE_RAW_LWIP is not built here, its numbers come from the target only.
+ */
+#include <unity.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <atomic>
+#include <functional>
+#include "ntp_posix.h"
+
+#define BENCH_PORT ( 12123 )
+#define BENCH_SECONDS_NS ( 500000000ull )
+#define BENCH_BURST ( 64 )
+
+typedef struct {
+  uint32_t sent;
+  uint32_t received;
+  double rate;      /* Responses per second */
+  double loss;      /* Percent */
+} bench_result_t;
+
+typedef struct {
+  int fd;
+  uint32_t received;
+  std::atomic<bool> done;
+} bench_client_t;
+
+static std::atomic<bool> reference_run;
+
+void setUp( void ){
+}
+
+void tearDown( void ){
+}
+
+static uint64_t host_ns( void ){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ( (uint64_t)ts.tv_sec * 1000000000ull ) + ts.tv_nsec;
+}
+
+static ntp_timestamp_t bench_time( void ){
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  ntp_timestamp_t t;
+  t.seconds = (uint32_t)( ts.tv_sec + NTP_TIMESTAMP_DELTA );
+  t.fraction = (uint32_t)( ( (uint64_t)ts.tv_nsec << 32 ) / 1000000000ull );
+  return t;
+}
+
+static ntp_server_state_t bench_state( void ){
+  ntp_server_state_t state;
+  memset(&state, 0, sizeof(state));
+  state.stratum = 1;
+  state.precision = -20;
+  memcpy(state.refid, "GPS", 4);
+  return state;
+}
+
+/* The reference transport, the callback gets one datagram and allocates the reply */
+static void* reference_loop( void* arg ){
+  int fd = *(int*)arg;
+  NTP_Responder responder;
+  ntp_server_state_t state = bench_state();
+  ratelimit_settings_t rl = NTP_RateLimiter::GetDefaultConfig();
+  rl.enabled = false;
+  responder.SetClock(bench_time, NULL);
+  responder.SetServerState(&state);
+  responder.SetRateLimit(rl);
+  std::function<void(const uint8_t*, uint16_t, const struct sockaddr_in*, ntp_timestamp_t)> on_packet =
+    [&]( const uint8_t* data, uint16_t len, const struct sockaddr_in* from, ntp_timestamp_t rx ){
+      ntp_client_t client = NTP_Responder::ClientV4(from->sin_addr.s_addr);
+      uint8_t* reply = new uint8_t[NTP_RESPONSE_MAX_LEN];
+      uint16_t reply_len = responder.Respond(&client, data, len, reply, rx, 0);
+      if(reply_len > 0){
+        sendto(fd, reply, reply_len, 0, (const struct sockaddr*)from, sizeof(*from));
+      }
+      delete[] reply;
+    };
+  uint8_t buf[NTP_PACKET_MAX_LEN];
+  while(true == reference_run.load()){
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    if(poll(&pfd, 1, 50) <= 0){
+      continue;
+    }
+    struct sockaddr_in from;
+    socklen_t from_len = sizeof(from);
+    ssize_t len = recvfrom(fd, buf, sizeof(buf), 0, (struct sockaddr*)&from, &from_len);
+    if(len > 0){
+      on_packet(buf, (uint16_t)len, &from, bench_time());
+    }
+  }
+  return NULL;
+}
+
+/* Reads responses until none came for 200ms after the client is done sending */
+static void* client_receive( void* arg ){
+  bench_client_t* c = (bench_client_t*)arg;
+  uint8_t resp[NTP_PACKET_MAX_LEN];
+  struct pollfd pfd = { c->fd, POLLIN, 0 };
+  while( (false == c->done.load()) || (poll(&pfd, 1, 200) > 0) ){
+    if(recv(c->fd, resp, sizeof(resp), MSG_DONTWAIT) > 0){
+      c->received++;
+    }
+  }
+  return NULL;
+}
+
+/* Sends rate requests a second for the run time in bursts and counts the responses */
+static bench_result_t run_client( uint32_t rate ){
+  bench_result_t r;
+  bench_client_t c;
+  memset(&r, 0, sizeof(r));
+  c.fd = socket(AF_INET, SOCK_DGRAM, 0);
+  c.received = 0;
+  c.done.store(false);
+  TEST_ASSERT_TRUE(c.fd >= 0);
+  int rcvbuf = 4 << 20;
+  setsockopt(c.fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+  struct sockaddr_in to;
+  memset(&to, 0, sizeof(to));
+  to.sin_family = AF_INET;
+  to.sin_port = htons(BENCH_PORT);
+  to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  TEST_ASSERT_EQUAL(0, connect(c.fd, (const struct sockaddr*)&to, sizeof(to)));
+  pthread_t receiver;
+  TEST_ASSERT_EQUAL(0, pthread_create(&receiver, NULL, client_receive, &c));
+
+  uint8_t req[BENCH_BURST][NTP_HEADER_LEN];
+  struct iovec iov[BENCH_BURST];
+  struct mmsghdr msg[BENCH_BURST];
+  memset(req, 0, sizeof(req));
+  memset(msg, 0, sizeof(msg));
+  for(uint8_t i=0;i<BENCH_BURST;i++){
+    req[i][0] = ( 4 << 3 ) | 3;
+    iov[i].iov_base = req[i];
+    iov[i].iov_len = NTP_HEADER_LEN;
+    msg[i].msg_hdr.msg_iov = &iov[i];
+    msg[i].msg_hdr.msg_iovlen = 1;
+  }
+  uint64_t start = host_ns();
+  uint64_t end = start + BENCH_SECONDS_NS;
+  uint64_t burst_ns = ( 1000000000ull * BENCH_BURST ) / rate;
+  struct timespec next;
+  clock_gettime(CLOCK_MONOTONIC, &next);
+  while(host_ns() < end){
+    for(uint8_t i=0;i<BENCH_BURST;i++){
+      uint32_t n = r.sent + i;
+      req[i][40] = (uint8_t)( n >> 24 );
+      req[i][41] = (uint8_t)( n >> 16 );
+      req[i][42] = (uint8_t)( n >> 8 );
+      req[i][43] = (uint8_t)n;
+    }
+    int sent = sendmmsg(c.fd, msg, BENCH_BURST, MSG_DONTWAIT);
+    if(sent > 0){
+      r.sent += sent;
+    }
+    next.tv_nsec += burst_ns;
+    while(next.tv_nsec >= 1000000000){
+      next.tv_nsec -= 1000000000;
+      next.tv_sec++;
+    }
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+  }
+  c.done.store(true);
+  pthread_join(receiver, NULL);
+  close(c.fd);
+  r.received = c.received;
+  r.rate = (double)r.received * 1e9 / (double)BENCH_SECONDS_NS;
+  r.loss = ( r.sent == 0 ) ? 100.0 : ( ( (double)( r.sent - r.received ) * 100.0 ) / r.sent );
+  return r;
+}
+
+static void report( const char* name, uint32_t rate, bench_result_t r ){
+  char msg[120];
+  snprintf(msg, sizeof(msg), "%s at %u/s: %u sent, %u answered, %.0f responses/s, %.2f%% lost",
+           name, rate, r.sent, r.received, r.rate, r.loss);
+  TEST_MESSAGE(msg);
+}
+
+static const uint32_t bench_rates[] = { 20000, 100000, 400000 };
+
+/* Client and server compete for the cores, the rates only compare on the same host */
+void test_host( void ){
+  char msg[60];
+  snprintf(msg, sizeof(msg), "%ld cores for client and server", sysconf(_SC_NPROCESSORS_ONLN));
+  TEST_MESSAGE(msg);
+}
+
+/* One datagram per callback and an allocation per reply */
+void test_reference_transport( void ){
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  int on = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(BENCH_PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  TEST_ASSERT_EQUAL(0, bind(fd, (const struct sockaddr*)&addr, sizeof(addr)));
+  pthread_t thread;
+  reference_run.store(true);
+  TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, reference_loop, &fd));
+  for(uint8_t i=0;i<sizeof(bench_rates)/sizeof(bench_rates[0]);i++){
+    bench_result_t r = run_client(bench_rates[i]);
+    report("per datagram", bench_rates[i], r);
+    TEST_ASSERT_TRUE(r.received > 0);
+  }
+  reference_run.store(false);
+  pthread_join(thread, NULL);
+  close(fd);
+}
+
+/* The batched transport with one shard and one thread */
+void test_posix_transport( void ){
+  NTP_PosixServer server;
+  TEST_ASSERT_TRUE(server.begin(BENCH_PORT, 1, bench_time, NULL));
+  ratelimit_settings_t rl = NTP_RateLimiter::GetDefaultConfig();
+  rl.enabled = false;
+  server.SetRateLimit(rl);
+  server.UpdateServerState(bench_state());
+  for(uint8_t i=0;i<sizeof(bench_rates)/sizeof(bench_rates[0]);i++){
+    bench_result_t r = run_client(bench_rates[i]);
+    report("batched", bench_rates[i], r);
+    if(i == 0){
+      /* A rate well below what a core answers gets through, client and server may share the core */
+      TEST_ASSERT_TRUE(r.loss < 5.0);
+    }
+  }
+  ntp_server_stats_t stats = server.GetStats(0);
+  TEST_ASSERT_TRUE(stats.responses > 0);
+  TEST_ASSERT_EQUAL_UINT32(stats.requests, stats.requests_v4);
+  server.end();
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_host);
+  RUN_TEST(test_reference_transport);
+  RUN_TEST(test_posix_transport);
+  return UNITY_END();
+}
@@ -0,0 +1,116 @@
+/*
+ * Clock precision. The measurement reads a simulated clock that ticks in fixed
+ * steps and advances by a fixed cost per read. The advertised exponent covers
+ * the larger of both, a clock that never moved is not trusted and a step back
+ * in the middle of the reads is left out.
+ */
+#include <unity.h>
+#include <stdio.h>
+#include "ntp_precision.h"
+
+#define SIM_SECOND ( 1000000000ull )
+
+/* Simulated time in ns, it steps by step_ns and every read costs cost_ns */
+static uint64_t sim_ns;
+static uint64_t step_ns;
+static uint64_t cost_ns;
+static uint32_t sim_reads;
+static uint32_t back_at;
+
+static ntp_timestamp_t sim_read( void ){
+  sim_ns += cost_ns;
+  sim_reads++;
+  uint64_t t = ( sim_ns / step_ns ) * step_ns;
+  if(sim_reads == back_at){
+    /* The clock was set back by 100us for this one read */
+    t -= 100000;
+  }
+  ntp_timestamp_t ts;
+  ts.seconds = (uint32_t)( 3900000000ull + ( t / SIM_SECOND ) );
+  ts.fraction = (uint32_t)( ( ( t % SIM_SECOND ) << 32 ) / SIM_SECOND );
+  return ts;
+}
+
+static ntp_precision_t simulate( uint64_t step, uint64_t cost, uint32_t back ){
+  char msg[120];
+  sim_ns = 0;
+  sim_reads = 0;
+  step_ns = step;
+  cost_ns = cost;
+  back_at = back;
+  ntp_precision_t p = ntp_measure_precision(sim_read);
+  snprintf(msg, sizeof(msg), "step %lluns read %lluns: precision %d valid %d reads %u steps %u back %u",
+           (unsigned long long)step, (unsigned long long)cost, p.precision, p.valid, p.reads, p.steps, p.backwards);
+  TEST_MESSAGE(msg);
+  return p;
+}
+
+void setUp( void ){
+}
+
+void tearDown( void ){
+}
+
+/* Rounded up to the next power of two, exactly one second is 2^0 */
+void test_log2( void ){
+  TEST_ASSERT_EQUAL_INT8(0, ntp_precision_log2(1ull << 32));
+  TEST_ASSERT_EQUAL_INT8(1, ntp_precision_log2((1ull << 32) + 1));
+  TEST_ASSERT_EQUAL_INT8(-20, ntp_precision_log2(1ull << 12));
+  /* 1us is a little over 2^-20 s */
+  TEST_ASSERT_EQUAL_INT8(-19, ntp_precision_log2(4295));
+}
+
+/* A fine timer behind a slow read, the read cost sets the precision */
+void test_read_cost_bound( void ){
+  ntp_precision_t p = simulate(25, 1000, 0);
+  TEST_ASSERT_TRUE(p.valid);
+  TEST_ASSERT_EQUAL_INT8(-19, p.precision);
+  TEST_ASSERT_INT64_WITHIN(2, 4295, (int64_t)p.read_cost);
+}
+
+/* A 1ms tick read quickly, the resolution sets the precision */
+void test_resolution_bound( void ){
+  ntp_precision_t p = simulate(1000000, 300, 0);
+  TEST_ASSERT_TRUE(p.valid);
+  TEST_ASSERT_EQUAL_INT8(-9, p.precision);
+  TEST_ASSERT_TRUE(p.reads <= NTP_PRECISION_MAX_READS);
+}
+
+/* A clock that only counts seconds never steps often enough within the reads */
+void test_seconds_clock( void ){
+  ntp_precision_t p = simulate(SIM_SECOND, 1000, 0);
+  TEST_ASSERT_FALSE(p.valid);
+  TEST_ASSERT_EQUAL_INT8(NTP_PRECISION_UNKNOWN, p.precision);
+  TEST_ASSERT_EQUAL_UINT32(NTP_PRECISION_MAX_READS, p.reads);
+  /* Read slow enough it does step, a second is all it is good for */
+  p = simulate(SIM_SECOND, 200000, 0);
+  TEST_ASSERT_TRUE(p.valid);
+  TEST_ASSERT_EQUAL_INT8(0, p.precision);
+}
+
+/* The step back and the read making it up again are left out */
+void test_step_back( void ){
+  ntp_precision_t p = simulate(25, 1000, 500);
+  TEST_ASSERT_TRUE(p.valid);
+  TEST_ASSERT_EQUAL_UINT32(1, p.backwards);
+  TEST_ASSERT_EQUAL_INT8(-19, p.precision);
+  TEST_ASSERT_INT64_WITHIN(2, 4295, (int64_t)p.read_cost);
+}
+
+/* Without a clock nothing is measured */
+void test_no_clock( void ){
+  ntp_precision_t p = ntp_measure_precision(NULL);
+  TEST_ASSERT_FALSE(p.valid);
+  TEST_ASSERT_EQUAL_INT8(NTP_PRECISION_UNKNOWN, p.precision);
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_log2);
+  RUN_TEST(test_read_cost_bound);
+  RUN_TEST(test_resolution_bound);
+  RUN_TEST(test_seconds_clock);
+  RUN_TEST(test_step_back);
+  RUN_TEST(test_no_clock);
+  return UNITY_END();
+}
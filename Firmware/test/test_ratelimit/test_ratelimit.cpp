@@ -0,0 +1,195 @@
+/*
+ * Rate limiter, the token bucket per client, the KoD RATE answer and the cost
+ * of a lookup with 10k clients polling. Clients are told apart by their full
+ * address, one that shares the hash or the /64 of another does not use up its
+ * bucket.
+ */
+#include <unity.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include "ntp_ratelimit.h"
+#include "ntp_responder.h"
+#include "ntp_latency.h"
+
+#define BENCH_CLIENTS ( 10000 )
+#define BENCH_ROUNDS ( 100 )
+
+static NTP_RateLimiter limiter;
+static ntp_timestamp_t now;
+static const uint8_t hash_key[NTP_ADDR_KEY_LEN] = { 0x5A, 0x17, 0xC3, 0x08, 0x91, 0x2E, 0x44, 0xF0,
+                                                     0x3B, 0x6D, 0xA2, 0x7F, 0x10, 0xE9, 0x55, 0xC6 };
+
+/* Checks an IPv4 client given in host order, hashed as the responder does */
+static ntp_ratelimit_result_t check( uint32_t addr ){
+  ntp_addr_t a = ntp_addr_from_v4(htonl(addr));
+  return limiter.Check(&a, ntp_addr_hash(&a, hash_key), now);
+}
+
+void setUp( void ){
+  limiter = NTP_RateLimiter();
+  now.seconds = 3900000000u;
+  now.fraction = 0;
+}
+
+void tearDown( void ){
+}
+
+/* Moves the clock on by 1/16 s */
+static void tick( void ){
+  now.fraction += 0x10000000u;
+  if(now.fraction == 0){
+    now.seconds++;
+  }
+}
+
+/* The burst passes, the first request over it gets a KoD, the rest is dropped */
+void test_burst_then_kod( void ){
+  ratelimit_settings_t conf = NTP_RateLimiter::GetDefaultConfig();
+  uint8_t pass = 0;
+  uint8_t kod = 0;
+  uint8_t drop = 0;
+  for(uint8_t i=0;i<20;i++){
+    switch(check(0x0A000001u)){
+      case NTP_RATELIMIT_PASS: pass++; break;
+      case NTP_RATELIMIT_KOD: kod++; break;
+      default: drop++; break;
+    }
+    tick();
+  }
+  /* 30 per minute refill one token in 2s, the 1.25s of the burst adds none */
+  TEST_ASSERT_EQUAL_UINT8(conf.burst, pass);
+  TEST_ASSERT_EQUAL_UINT8(1, kod);
+  TEST_ASSERT_EQUAL_UINT8(20 - conf.burst - 1, drop);
+  /* Another client is not affected */
+  TEST_ASSERT_EQUAL(NTP_RATELIMIT_PASS, check(0x0A000002u));
+  /* A token is back after 2s and the KoD can be sent again once it is used */
+  now.seconds += 2;
+  TEST_ASSERT_EQUAL(NTP_RATELIMIT_PASS, check(0x0A000001u));
+  TEST_ASSERT_EQUAL(NTP_RATELIMIT_KOD, check(0x0A000001u));
+  ntp_ratelimit_stats_t s = limiter.GetStats();
+  TEST_ASSERT_EQUAL_UINT32(2, s.kod);
+  TEST_ASSERT_EQUAL_UINT32(20 - conf.burst + 1, s.limited);
+}
+
+/* Without KoD the requests over the limit are dropped silently */
+void test_silent_drop( void ){
+  ratelimit_settings_t conf = NTP_RateLimiter::GetDefaultConfig();
+  conf.send_kod = false;
+  limiter.SetConfig(conf);
+  for(uint8_t i=0;i<conf.burst;i++){
+    TEST_ASSERT_EQUAL(NTP_RATELIMIT_PASS, check(0x0A000001u));
+  }
+  TEST_ASSERT_EQUAL(NTP_RATELIMIT_DROP, check(0x0A000001u));
+  TEST_ASSERT_EQUAL_UINT32(0, limiter.GetStats().kod);
+}
+
+/* Two IPv6 clients in one /64 and with the same hash still have a bucket each */
+void test_full_address( void ){
+  uint8_t bytes[NTP_ADDR_LEN] = { 0x20, 0x01, 0x0D, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+  ntp_addr_t victim = ntp_addr_from_v6(bytes);
+  bytes[15] = 2;
+  ntp_addr_t attacker = ntp_addr_from_v6(bytes);
+  uint32_t hash = ntp_addr_hash(&victim, hash_key);
+  for(uint8_t i=0;i<NTP_RateLimiter::GetDefaultConfig().burst;i++){
+    TEST_ASSERT_EQUAL(NTP_RATELIMIT_PASS, limiter.Check(&attacker, hash, now));
+  }
+  TEST_ASSERT_EQUAL(NTP_RATELIMIT_KOD, limiter.Check(&attacker, hash, now));
+  TEST_ASSERT_EQUAL(NTP_RATELIMIT_PASS, limiter.Check(&victim, hash, now));
+  TEST_ASSERT_EQUAL_UINT32(2, limiter.GetStats().misses);
+  /* The keyed hash tells them apart anyway, and another key places them elsewhere */
+  uint8_t other_key[NTP_ADDR_KEY_LEN];
+  memcpy(other_key, hash_key, sizeof(other_key));
+  other_key[0] ^= 1;
+  TEST_ASSERT_TRUE(ntp_addr_hash(&attacker, hash_key) != hash);
+  TEST_ASSERT_TRUE(ntp_addr_hash(&victim, other_key) != hash);
+}
+
+static ntp_timestamp_t read_now( void ){
+  return now;
+}
+
+/* The responder answers with stratum 0 and refid RATE, then stays silent */
+void test_responder_kod( void ){
+  NTP_Responder* responder = new NTP_Responder();
+  responder->SetClock(read_now, NULL);
+  ntp_client_t client = NTP_Responder::ClientV4(htonl(0x0A000001u));
+  ntp_packet_t req;
+  ntp_packet_t resp;
+  uint8_t out[NTP_PACKET_MAX_LEN];
+  memset(&req, 0, sizeof(req));
+  req.flags.vn = 4;
+  req.flags.mode = 3;
+  req.txTm_s = htonl(now.seconds);
+  uint8_t answered = 0;
+  uint16_t len = 0;
+  for(uint8_t i=0;i<NTP_RateLimiter::GetDefaultConfig().burst;i++){
+    len = responder->Respond(&client, (const uint8_t*)&req, sizeof(req), out, now, 0);
+    answered += ( len > 0 ) ? 1 : 0;
+  }
+  TEST_ASSERT_EQUAL_UINT8(NTP_RateLimiter::GetDefaultConfig().burst, answered);
+  len = responder->Respond(&client, (const uint8_t*)&req, sizeof(req), out, now, 0);
+  TEST_ASSERT_EQUAL_UINT16(sizeof(ntp_packet_t), len);
+  memcpy(&resp, out, sizeof(resp));
+  TEST_ASSERT_EQUAL_UINT8(0, resp.stratum);
+  TEST_ASSERT_EQUAL_UINT8(3, resp.flags.li);
+  TEST_ASSERT_EQUAL_MEMORY("RATE", resp.refId.c_str, 4);
+  TEST_ASSERT_EQUAL_UINT32(req.txTm_s, resp.origTm_s);
+  TEST_ASSERT_EQUAL_UINT16(0, responder->Respond(&client, (const uint8_t*)&req, sizeof(req), out, now, 0));
+  ntp_ratelimit_stats_t s = responder->GetRateLimitStats();
+  TEST_ASSERT_EQUAL_UINT32(1, s.kod);
+  TEST_ASSERT_EQUAL_UINT32(1, responder->GetStats().dropped);
+  delete responder;
+}
+
+/* Lets clients poll in turn, every one once a minute, and returns the ns per lookup */
+static double bench_lookup( uint32_t clients, uint32_t rounds ){
+  char msg[120];
+  /* First contact of every client is left out */
+  for(uint32_t c=0;c<clients;c++){
+    check(0x0A000000u + ( c * 7919u ));
+  }
+  now.seconds += 64;
+  uint32_t start = NTP_LatencyStats::Now();
+  for(uint32_t round=0;round<rounds;round++){
+    for(uint32_t c=0;c<clients;c++){
+      check(0x0A000000u + ( c * 7919u ));
+    }
+    now.seconds += 64;
+  }
+  uint32_t end = NTP_LatencyStats::Now();
+  double ns = (double)(uint32_t)( end - start ) * 1000.0 / NTP_LatencyStats::GetCyclesPerUs() / ( (double)clients * rounds );
+  ntp_ratelimit_stats_t s = limiter.GetStats();
+  snprintf(msg, sizeof(msg), "%u clients, %u slots: %.1f ns per lookup, %u hits, %u misses, %u evictions",
+           clients, NTP_RATELIMIT_ENTRIES, ns, s.hits, s.misses, s.evictions);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL_UINT32(0, s.limited);
+  return ns;
+}
+
+/* 10k clients tracked, they are found again and nearly none is thrown out */
+void test_bench_10k_clients( void ){
+  TEST_ASSERT_TRUE(NTP_RATELIMIT_ENTRIES >= BENCH_CLIENTS);
+  double ns = bench_lookup(BENCH_CLIENTS, BENCH_ROUNDS);
+  ntp_ratelimit_stats_t s = limiter.GetStats();
+  TEST_ASSERT_TRUE(s.evictions < ( BENCH_CLIENTS * BENCH_ROUNDS ) / 100);
+  TEST_ASSERT_TRUE(s.hits > ( BENCH_CLIENTS * BENCH_ROUNDS ) * 0.98);
+  TEST_ASSERT_TRUE(ns < 300.0);
+}
+
+/* Twice as many clients as slots, every lookup evicts and the cost stays bounded */
+void test_bench_overflow( void ){
+  double ns = bench_lookup(2 * NTP_RATELIMIT_ENTRIES, BENCH_ROUNDS / 10);
+  TEST_ASSERT_TRUE(limiter.GetStats().evictions > 0);
+  TEST_ASSERT_TRUE(ns < 300.0);
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_burst_then_kod);
+  RUN_TEST(test_silent_drop);
+  RUN_TEST(test_full_address);
+  RUN_TEST(test_responder_kod);
+  RUN_TEST(test_bench_10k_clients);
+  RUN_TEST(test_bench_overflow);
+  return UNITY_END();
+}
@@ -0,0 +1,209 @@
+/*
+ * Header and key swaps while responses are in flight. A response held inside
+ * its clock read keeps the header it started with, the next rebuild of that
+ * buffer waits for it. A thread answering signed requests while another swaps
+ * headers and keys never sends a torn header or a MAC that does not verify.
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include "ntp_auth.h"
+#include "ntp_responder.h"
+
+#define SWAP_RESPONSES ( 200000 )
+
+static NTP_Responder* responder;
+static ntp_keys_settings_t keys;
+
+/* The clock read can be held, the response in flight waits in it */
+static pthread_mutex_t hold_mux = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t hold_cond = PTHREAD_COND_INITIALIZER;
+static bool hold = false;
+static bool holding = false;
+
+static ntp_timestamp_t held_time( void ){
+  pthread_mutex_lock(&hold_mux);
+  holding = true;
+  pthread_cond_broadcast(&hold_cond);
+  while(true == hold){
+    pthread_cond_wait(&hold_cond, &hold_mux);
+  }
+  holding = false;
+  pthread_mutex_unlock(&hold_mux);
+  ntp_timestamp_t t = { 3900000000u, 0 };
+  return t;
+}
+
+/* Stratum and reference go together, a header mixing two states is torn */
+static ntp_server_state_t make_state( uint8_t stratum ){
+  ntp_server_state_t state;
+  memset(&state, 0, sizeof(state));
+  state.stratum = stratum;
+  state.precision = -20;
+  state.rootDispersion = stratum;
+  memcpy(state.refid, ( stratum == 1 ) ? "GPS" : "PPS", 4);
+  return state;
+}
+
+static void make_request( uint8_t* req, uint16_t* len ){
+  NTP_KeyTable table;
+  ntp_packet_t pkt;
+  memset(&pkt, 0, sizeof(pkt));
+  pkt.flags.vn = 4;
+  pkt.flags.mode = 3;
+  pkt.txTm_s = htonl(0x12345678u);
+  memcpy(req, &pkt, sizeof(pkt));
+  table.Load(&keys);
+  *len = sizeof(pkt) + table.Sign(table.Find(1), req, sizeof(pkt));
+}
+
+void setUp( void ){
+  ratelimit_settings_t rl = NTP_RateLimiter::GetDefaultConfig();
+  ntp_server_state_t state = make_state(1);
+  keys = NTP_KeyTable::GetDefaultConfig();
+  keys.keys[0].id = 1;
+  keys.keys[0].type = NTP_KEY_AES128CMAC;
+  keys.keys[0].len = NTP_KEY_AES128_LEN;
+  memset(keys.keys[0].key, 0x2B, NTP_KEY_AES128_LEN);
+  rl.enabled = false;
+  hold = false;
+  responder = new NTP_Responder();
+  responder->SetClock(held_time, NULL);
+  responder->SetRateLimit(rl);
+  responder->SetServerState(&state);
+  responder->SetKeys(&keys);
+}
+
+void tearDown( void ){
+  delete responder;
+}
+
+typedef struct {
+  uint8_t out[NTP_PACKET_MAX_LEN];
+  uint16_t len;
+} held_response_t;
+
+static void* respond_held( void* arg ){
+  held_response_t* r = (held_response_t*)arg;
+  uint8_t req[NTP_PACKET_MAX_LEN];
+  uint16_t len;
+  ntp_client_t client = NTP_Responder::ClientV4(htonl(0x0A000001u));
+  ntp_timestamp_t rx = { 3900000000u, 0 };
+  make_request(req, &len);
+  r->len = responder->Respond(&client, req, len, r->out, rx, 0);
+  return NULL;
+}
+
+/* Flags between the threads, atomic so the test itself is race free */
+static bool rebuilt;
+
+static void* rebuild( void* arg ){
+  responder->SetServerState((const ntp_server_state_t*)arg);
+  __atomic_store_n(&rebuilt, true, __ATOMIC_SEQ_CST);
+  return NULL;
+}
+
+/* The buffer a response still reads from is rebuilt only once the response is done */
+void test_spare_waits( void ){
+  pthread_t resp_thread;
+  pthread_t set_thread;
+  held_response_t r;
+  ntp_server_state_t second = make_state(2);
+  ntp_server_state_t third = make_state(3);
+  hold = true;
+  pthread_create(&resp_thread, NULL, respond_held, &r);
+  pthread_mutex_lock(&hold_mux);
+  while(false == holding){
+    pthread_cond_wait(&hold_cond, &hold_mux);
+  }
+  pthread_mutex_unlock(&hold_mux);
+  /* The spare is free, the first swap goes through at once */
+  responder->SetServerState(&second);
+  TEST_ASSERT_EQUAL_UINT8(2, responder->GetTemplate().stratum);
+  /* The next spare is the one the held response reads from */
+  rebuilt = false;
+  pthread_create(&set_thread, NULL, rebuild, &third);
+  usleep(50000);
+  TEST_ASSERT_FALSE(__atomic_load_n(&rebuilt, __ATOMIC_SEQ_CST));
+  TEST_ASSERT_EQUAL_UINT8(2, responder->GetTemplate().stratum);
+  pthread_mutex_lock(&hold_mux);
+  hold = false;
+  pthread_cond_broadcast(&hold_cond);
+  pthread_mutex_unlock(&hold_mux);
+  pthread_join(resp_thread, NULL);
+  pthread_join(set_thread, NULL);
+  TEST_ASSERT_TRUE(rebuilt);
+  /* The response has the header it started with */
+  TEST_ASSERT_EQUAL_UINT16(sizeof(ntp_packet_t) + 4 + 16, r.len);
+  TEST_ASSERT_EQUAL_UINT8(1, ((ntp_packet_t*)r.out)->stratum);
+  TEST_ASSERT_EQUAL_MEMORY("GPS", &r.out[12], 4);
+  TEST_ASSERT_EQUAL_UINT8(3, responder->GetTemplate().stratum);
+}
+
+typedef struct {
+  uint32_t responses;
+  uint32_t torn;
+  uint32_t badmac;
+} swap_result_t;
+
+static bool answering;
+
+static void* answer_loop( void* arg ){
+  swap_result_t* res = (swap_result_t*)arg;
+  NTP_KeyTable check;
+  uint8_t req[NTP_PACKET_MAX_LEN];
+  uint8_t out[NTP_PACKET_MAX_LEN];
+  uint16_t len;
+  ntp_timestamp_t rx = { 3900000000u, 0 };
+  check.Load(&keys);
+  make_request(req, &len);
+  for(uint32_t i=0;i<SWAP_RESPONSES;i++){
+    ntp_client_t client = NTP_Responder::ClientV4(htonl(0x0A000000u + ( i & 0xFFFF )));
+    uint16_t n = responder->Respond(&client, req, len, out, rx, 0);
+    const ntp_packet_t* resp = (const ntp_packet_t*)out;
+    const char* refid = ( resp->stratum == 1 ) ? "GPS" : "PPS";
+    if( (0 != memcmp(refid, &out[12], 4)) || (ntohl(resp->rootDispersion) != resp->stratum) ){
+      res->torn++;
+    }
+    if( (n != len) || (false == check.Verify(check.Find(1), out, sizeof(ntp_packet_t), &out[sizeof(ntp_packet_t)], n - sizeof(ntp_packet_t))) ){
+      res->badmac++;
+    }
+    res->responses++;
+  }
+  __atomic_store_n(&answering, false, __ATOMIC_SEQ_CST);
+  return NULL;
+}
+
+/* Headers and keys swapped as fast as they can be while a thread answers */
+void test_swap_under_load( void ){
+  pthread_t thread;
+  swap_result_t res;
+  char msg[120];
+  uint32_t swaps = 0;
+  memset(&res, 0, sizeof(res));
+  answering = true;
+  pthread_create(&thread, NULL, answer_loop, &res);
+  while(true == __atomic_load_n(&answering, __ATOMIC_SEQ_CST)){
+    ntp_server_state_t state = make_state(1 + ( swaps & 1 ));
+    responder->SetServerState(&state);
+    responder->SetKeys(&keys);
+    swaps++;
+  }
+  pthread_join(thread, NULL);
+  snprintf(msg, sizeof(msg), "%u responses, %u swaps of header and keys", res.responses, swaps);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL_UINT32(SWAP_RESPONSES, res.responses);
+  TEST_ASSERT_TRUE(swaps > 0);
+  TEST_ASSERT_EQUAL_UINT32(0, res.torn);
+  TEST_ASSERT_EQUAL_UINT32(0, res.badmac);
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_spare_waits);
+  RUN_TEST(test_swap_under_load);
+  return UNITY_END();
+}
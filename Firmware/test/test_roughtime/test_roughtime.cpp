@@ -0,0 +1,216 @@
+/*
+ * Roughtime. Batches of requests signed and checked as a client would, the
+ * delegation of the online key with its bounded window and its renewal over a
+ * few simulated days. Signatures and responses per second at several batch
+ * sizes.
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "sodium.h"
+#include "mbedtls/sha512.h"
+#include "roughtime.h"
+#include "ntp_latency.h"
+
+/* Batches signed for each size of the benchmark */
+#define BENCH_BATCHES ( 200 )
+
+/* 2026-01-01, in microseconds since the UNIX epoch */
+#define START_US ( 1767225600ull * 1000000 )
+#define HOUR_US ( 3600ull * 1000000 )
+
+static uint8_t seed[ROUGHTIME_SEED_LEN];
+static uint8_t pubkey[ROUGHTIME_PUBKEY_LEN];
+static roughtime_online_key_t online;
+static roughtime_tree_t tree;
+static uint8_t nonces[ROUGHTIME_BATCH_MAX][ROUGHTIME_NONCE_LEN];
+static uint8_t resp[ROUGHTIME_RESPONSE_MAX_LEN];
+
+static uint32_t get32( const uint8_t* p ){
+  return (uint32_t)p[0] | ( (uint32_t)p[1] << 8 ) | ( (uint32_t)p[2] << 16 ) | ( (uint32_t)p[3] << 24 );
+}
+
+static uint64_t get64( const uint8_t* p ){
+  return (uint64_t)get32(p) | ( (uint64_t)get32(&p[4]) << 32 );
+}
+
+/* Finds the value of a tag in a message */
+static const uint8_t* find_tag( const uint8_t* msg, uint32_t len, uint32_t tag, uint32_t* value_len ){
+  uint32_t count = get32(msg);
+  uint32_t header = 8 * count;
+  for(uint32_t i=0;i<count;i++){
+    uint32_t start = ( i == 0 ) ? 0 : get32(&msg[4 * i]);
+    uint32_t end = ( i == ( count - 1 ) ) ? ( len - header ) : get32(&msg[4 + ( 4 * i )]);
+    if(get32(&msg[header - ( 4 * ( count - i ) )]) == tag){
+      *value_len = end - start;
+      return &msg[header + start];
+    }
+  }
+  TEST_FAIL_MESSAGE("tag missing");
+  return NULL;
+}
+
+/* Checks a signature over a context and a message */
+static bool check_sig( const uint8_t* sig, const char* context, uint16_t context_len, const uint8_t* msg, uint32_t len, const uint8_t* key ){
+  uint8_t buf[sizeof(ROUGHTIME_CONTEXT_DELE) + ROUGHTIME_SREP_LEN + ROUGHTIME_DELE_LEN];
+  memcpy(buf, context, context_len);
+  memcpy(&buf[context_len], msg, len);
+  return 0 == crypto_sign_ed25519_verify_detached(sig, buf, context_len + len, key);
+}
+
+static void hash_node( uint8_t prefix, const uint8_t* a, uint16_t a_len, const uint8_t* b, uint8_t* out ){
+  mbedtls_sha512_context ctx;
+  mbedtls_sha512_init(&ctx);
+  mbedtls_sha512_starts_ret(&ctx, 0);
+  mbedtls_sha512_update_ret(&ctx, &prefix, 1);
+  mbedtls_sha512_update_ret(&ctx, a, a_len);
+  if(b != NULL){
+    mbedtls_sha512_update_ret(&ctx, b, ROUGHTIME_HASH_LEN);
+  }
+  mbedtls_sha512_finish_ret(&ctx, out);
+  mbedtls_sha512_free(&ctx);
+}
+
+/* Checks a response as a client with the long term key, returns the midpoint */
+static uint64_t client_check( const uint8_t* msg, uint16_t len, const uint8_t* nonce ){
+  uint32_t cert_len, srep_len, path_len, indx_len, sig_len, dele_len, dsig_len, pk_len, root_len, midp_len, t_len;
+  const uint8_t* cert = find_tag(msg, len, ROUGHTIME_TAG_CERT, &cert_len);
+  const uint8_t* srep = find_tag(msg, len, ROUGHTIME_TAG_SREP, &srep_len);
+  const uint8_t* path = find_tag(msg, len, ROUGHTIME_TAG_PATH, &path_len);
+  const uint8_t* indx = find_tag(msg, len, ROUGHTIME_TAG_INDX, &indx_len);
+  const uint8_t* sig = find_tag(msg, len, ROUGHTIME_TAG_SIG, &sig_len);
+  const uint8_t* dele = find_tag(cert, cert_len, ROUGHTIME_TAG_DELE, &dele_len);
+  const uint8_t* dsig = find_tag(cert, cert_len, ROUGHTIME_TAG_SIG, &dsig_len);
+  const uint8_t* pk = find_tag(dele, dele_len, ROUGHTIME_TAG_PUBK, &pk_len);
+  uint64_t mint = get64(find_tag(dele, dele_len, ROUGHTIME_TAG_MINT, &t_len));
+  uint64_t maxt = get64(find_tag(dele, dele_len, ROUGHTIME_TAG_MAXT, &t_len));
+  const uint8_t* root = find_tag(srep, srep_len, ROUGHTIME_TAG_ROOT, &root_len);
+  uint64_t midpoint = get64(find_tag(srep, srep_len, ROUGHTIME_TAG_MIDP, &midp_len));
+
+  TEST_ASSERT_TRUE(check_sig(dsig, ROUGHTIME_CONTEXT_DELE, sizeof(ROUGHTIME_CONTEXT_DELE), dele, dele_len, pubkey));
+  TEST_ASSERT_TRUE(check_sig(sig, ROUGHTIME_CONTEXT_SREP, sizeof(ROUGHTIME_CONTEXT_SREP), srep, srep_len, pk));
+  TEST_ASSERT_TRUE( (midpoint >= mint) && (midpoint <= maxt) );
+
+  uint8_t node[ROUGHTIME_HASH_LEN];
+  uint32_t index = get32(indx);
+  hash_node(0x00, nonce, ROUGHTIME_NONCE_LEN, NULL, node);
+  for(uint32_t i=0;i<path_len/ROUGHTIME_HASH_LEN;i++){
+    const uint8_t* sibling = &path[i * ROUGHTIME_HASH_LEN];
+    if(index & 1){
+      hash_node(0x01, sibling, ROUGHTIME_HASH_LEN, node, node);
+    } else {
+      hash_node(0x01, node, ROUGHTIME_HASH_LEN, sibling, node);
+    }
+    index >>= 1;
+  }
+  TEST_ASSERT_EQUAL_MEMORY(root, node, ROUGHTIME_HASH_LEN);
+  return midpoint;
+}
+
+/* Signs a batch of count requests at midpoint and builds all responses, the one of index is left in resp */
+static uint16_t sign_batch( uint8_t count, uint64_t midpoint, uint8_t index ){
+  uint8_t srep[ROUGHTIME_SREP_LEN];
+  uint8_t sig[ROUGHTIME_SIG_LEN];
+  uint8_t path[ROUGHTIME_TREE_DEPTH_MAX * ROUGHTIME_HASH_LEN];
+  uint16_t len = 0;
+  const uint8_t* root = roughtime_tree_build(&tree, nonces, count);
+  roughtime_sign_srep(&online, srep, sig, 1000, midpoint, root);
+  for(uint8_t i=0;i<count;i++){
+    roughtime_tree_path(&tree, i, path);
+    roughtime_build_response(resp, sig, path, tree.depth, srep, online.cert, i);
+  }
+  if(index < count){
+    roughtime_tree_path(&tree, index, path);
+    len = roughtime_build_response(resp, sig, path, tree.depth, srep, online.cert, index);
+  }
+  return len;
+}
+
+void setUp( void ){
+  randombytes_buf(seed, sizeof(seed));
+  randombytes_buf(nonces, sizeof(nonces));
+  roughtime_public_key(seed, pubkey);
+  roughtime_delegate(&online, seed, START_US);
+}
+
+void tearDown( void ){
+}
+
+/* The delegation is signed by the long term key and covers an hour before to a day after */
+void test_delegation_window( void ){
+  uint32_t dele_len, t_len, sig_len;
+  const uint8_t* dele = find_tag(online.cert, ROUGHTIME_CERT_LEN, ROUGHTIME_TAG_DELE, &dele_len);
+  const uint8_t* sig = find_tag(online.cert, ROUGHTIME_CERT_LEN, ROUGHTIME_TAG_SIG, &sig_len);
+  TEST_ASSERT_EQUAL_UINT32(ROUGHTIME_DELE_LEN, dele_len);
+  TEST_ASSERT_TRUE(check_sig(sig, ROUGHTIME_CONTEXT_DELE, sizeof(ROUGHTIME_CONTEXT_DELE), dele, dele_len, pubkey));
+  TEST_ASSERT_EQUAL_UINT64(START_US - HOUR_US, get64(find_tag(dele, dele_len, ROUGHTIME_TAG_MINT, &t_len)));
+  TEST_ASSERT_EQUAL_UINT64(START_US + ( 24 * HOUR_US ), get64(find_tag(dele, dele_len, ROUGHTIME_TAG_MAXT, &t_len)));
+  TEST_ASSERT_EQUAL_UINT64(START_US - HOUR_US, online.mint);
+  TEST_ASSERT_EQUAL_UINT64(START_US + ( 24 * HOUR_US ), online.maxt);
+  /* Near the epoch the window does not wrap */
+  roughtime_delegate(&online, seed, 5);
+  TEST_ASSERT_EQUAL_UINT64(0, online.mint);
+}
+
+/* Renewed an hour before it runs out and after the clock went back, never out of its window */
+void test_delegation_renewal( void ){
+  TEST_ASSERT_FALSE(roughtime_delegation_due(&online, START_US));
+  TEST_ASSERT_FALSE(roughtime_delegation_due(&online, START_US - HOUR_US));
+  TEST_ASSERT_TRUE(roughtime_delegation_due(&online, START_US - HOUR_US - 1));
+  TEST_ASSERT_FALSE(roughtime_delegation_due(&online, START_US + ( 23 * HOUR_US ) - 1));
+  TEST_ASSERT_TRUE(roughtime_delegation_due(&online, START_US + ( 23 * HOUR_US )));
+
+  /* A batch every ten minutes for three days, the signing task checks before each */
+  uint32_t delegations = 0;
+  for(uint64_t now=START_US;now<START_US + ( 72 * HOUR_US );now+=( HOUR_US / 6 )){
+    if(true == roughtime_delegation_due(&online, now)){
+      roughtime_delegate(&online, seed, now);
+      delegations++;
+    }
+    uint16_t len = sign_batch(3, now, 1);
+    TEST_ASSERT_EQUAL_UINT64(now, client_check(resp, len, nonces[1]));
+  }
+  TEST_ASSERT_EQUAL_UINT32(3, delegations);
+
+  /* The clock stepped back to before the window */
+  TEST_ASSERT_TRUE(roughtime_delegation_due(&online, online.mint - HOUR_US));
+}
+
+/* Every response of batches of any size checks out against the long term key */
+void test_batches( void ){
+  const uint8_t counts[] = { 1, 2, 3, 5, 8, 17, 64 };
+  for(uint8_t c=0;c<sizeof(counts);c++){
+    for(uint8_t i=0;i<counts[c];i++){
+      uint16_t len = sign_batch(counts[c], START_US, i);
+      TEST_ASSERT_TRUE(len <= ROUGHTIME_RESPONSE_MAX_LEN);
+      TEST_ASSERT_TRUE(len <= ROUGHTIME_REQUEST_MIN_LEN);
+      TEST_ASSERT_EQUAL_UINT64(START_US, client_check(resp, len, nonces[i]));
+    }
+  }
+}
+
+/* One signature per batch, the responses only add the path */
+void test_bench( void ){
+  char msg[120];
+  const uint8_t counts[] = { 1, 4, 16, 64 };
+  for(uint8_t c=0;c<sizeof(counts);c++){
+    uint32_t start = NTP_LatencyStats::Now();
+    for(uint32_t b=0;b<BENCH_BATCHES;b++){
+      sign_batch(counts[c], START_US + b, 0xFF);
+    }
+    uint32_t end = NTP_LatencyStats::Now();
+    double s = (double)(uint32_t)( end - start ) / NTP_LatencyStats::GetCyclesPerUs() / 1e6;
+    snprintf(msg, sizeof(msg), "batch %2u: %.0f signatures/s, %.0f responses/s",
+             counts[c], BENCH_BATCHES / s, ( BENCH_BATCHES * counts[c] ) / s);
+    TEST_MESSAGE(msg);
+  }
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_delegation_window);
+  RUN_TEST(test_delegation_renewal);
+  RUN_TEST(test_batches);
+  RUN_TEST(test_bench);
+  return UNITY_END();
+}
@@ -0,0 +1,232 @@
+/*
+ * PPS clock servo. A 40MHz timer on a crystal 23ppm fast is disciplined to
+ * simulated PPS edges that come late by a random interrupt latency of up to
+ * 4us. The FLL hands over to the PLL after NTP_SERVO_FLL_EDGES intervals, the
+ * loop then tracks phase and frequency. Missed edges, spikes and a holdover
+ * without edges are bridged, a gap too long or a phase too far off is stepped.
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include "ntp_servo.h"
+
+#define SIM_NOMINAL ( 40000000u )
+#define SIM_PPM ( 23.0 )
+#define SIM_LATENCY_NS ( 4000 )
+#define SIM_NS_PER_TICK ( 1e9 / SIM_NOMINAL )
+
+typedef struct {
+  NTP_ClockServo servo;
+  double ticks;          /* Timer value at the true second boundary */
+  double freq;           /* True timer ticks per second */
+  uint32_t rng;
+} sim_t;
+
+static sim_t* sim;
+
+/* xorshift32, the latency is the same on every run */
+static uint32_t sim_random( void ){
+  uint32_t x = sim->rng;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  sim->rng = x;
+  return x;
+}
+
+/* The next true second, the edge is latched after the interrupt latency */
+static uint64_t sim_second( void ){
+  sim->ticks += sim->freq;
+  double latency = (double)( sim_random() % SIM_LATENCY_NS ) / SIM_NS_PER_TICK;
+  return (uint64_t)( sim->ticks + latency );
+}
+
+static uint8_t sim_edge( void ){
+  return sim->servo.Edge(sim_second());
+}
+
+/* Error of the disciplined boundary against the true one */
+static double sim_phase_error_ns( void ){
+  return ( (double)sim->servo.GetPhase() - sim->ticks ) * SIM_NS_PER_TICK;
+}
+
+static double sim_true_ppb( void ){
+  return ( ( sim->freq / SIM_NOMINAL ) - 1.0 ) * 1e9;
+}
+
+static void sim_begin( const ntp_servo_settings_t* conf ){
+  sim->ticks = 12345.0;
+  sim->freq = SIM_NOMINAL * ( 1.0 + ( SIM_PPM * 1e-6 ) );
+  sim->rng = 0x12345678u;
+  sim->servo.Begin(SIM_NOMINAL, conf);
+}
+
+/* Runs edges until the loop has settled */
+static void sim_settle( void ){
+  for(uint32_t i=0;i<2000;i++){
+    sim_edge();
+  }
+  TEST_ASSERT_EQUAL(NTP_SERVO_LOCK, sim->servo.GetState());
+}
+
+void setUp( void ){
+  ntp_servo_settings_t conf = NTP_ClockServo::GetDefaultConfig();
+  sim = new sim_t;
+  sim_begin(&conf);
+}
+
+void tearDown( void ){
+  delete sim;
+}
+
+/* The intervals are averaged first, the PLL starts from their frequency */
+void test_fll_to_pll( void ){
+  sim_edge();
+  TEST_ASSERT_EQUAL(NTP_SERVO_FREQ, sim->servo.GetState());
+  for(uint8_t i=1;i<NTP_SERVO_FLL_EDGES;i++){
+    TEST_ASSERT_EQUAL_UINT8(1, sim_edge());
+    TEST_ASSERT_EQUAL(NTP_SERVO_FREQ, sim->servo.GetState());
+  }
+  sim_edge();
+  TEST_ASSERT_EQUAL(NTP_SERVO_LOCK, sim->servo.GetState());
+  /* 16 intervals with 4us of latency know the frequency to a few hundred ppb */
+  ntp_servo_status_t st = sim->servo.GetStatus();
+  TEST_ASSERT_INT32_WITHIN(500, (int32_t)sim_true_ppb(), st.frequency);
+  TEST_ASSERT_EQUAL_UINT8(NTP_SERVO_MINTAU, st.tau);
+}
+
+/* Locked the loop follows the crystal well within the latency */
+void test_lock( void ){
+  char msg[120];
+  double worst = 0;
+  for(uint32_t i=0;i<6000;i++){
+    sim_edge();
+    if( (i > 2000) && (fabs(sim_phase_error_ns()) > worst) ){
+      worst = fabs(sim_phase_error_ns());
+    }
+  }
+  ntp_servo_status_t st = sim->servo.GetStatus();
+  snprintf(msg, sizeof(msg), "%s tau %u, %d ppb for %.0f, jitter %uns, worst phase error %.0fns",
+           NTP_ClockServo::GetStateName(st.state), st.tau, st.frequency, sim_true_ppb(), st.jitter, worst);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL(NTP_SERVO_LOCK, st.state);
+  TEST_ASSERT_INT32_WITHIN(100, (int32_t)sim_true_ppb(), st.frequency);
+  TEST_ASSERT_TRUE(st.tau > NTP_SERVO_MINTAU);
+  TEST_ASSERT_TRUE(worst < SIM_LATENCY_NS);
+  TEST_ASSERT_EQUAL_UINT32(0, st.steps);
+  TEST_ASSERT_EQUAL_UINT32(0, st.spikes);
+  TEST_ASSERT_EQUAL_UINT32(6000, st.edges);
+  /* Settled, the frequency is handed out for storage once */
+  ntp_servo_settings_t out;
+  TEST_ASSERT_TRUE(sim->servo.TakeSettings(&out));
+  TEST_ASSERT_TRUE(out.valid);
+  TEST_ASSERT_INT32_WITHIN(100, (int32_t)sim_true_ppb(), out.frequency);
+  TEST_ASSERT_FALSE(sim->servo.TakeSettings(&out));
+}
+
+/* A stored frequency skips the FLL */
+void test_stored_frequency( void ){
+  ntp_servo_settings_t conf = { true, (int32_t)( SIM_PPM * 1000 ) };
+  sim_begin(&conf);
+  sim_edge();
+  TEST_ASSERT_EQUAL(NTP_SERVO_LOCK, sim->servo.GetState());
+  for(uint32_t i=0;i<100;i++){
+    sim_edge();
+  }
+  TEST_ASSERT_EQUAL(NTP_SERVO_LOCK, sim->servo.GetState());
+  TEST_ASSERT_EQUAL_UINT32(0, sim->servo.GetStatus().steps);
+  TEST_ASSERT_TRUE(fabs(sim_phase_error_ns()) < SIM_LATENCY_NS);
+}
+
+/* Up to NTP_SERVO_CATCHUP seconds are bridged, a longer gap is stepped */
+void test_missed_edges( void ){
+  sim_settle();
+  sim_second();
+  sim_second();
+  TEST_ASSERT_EQUAL_UINT8(3, sim_edge());
+  ntp_servo_status_t st = sim->servo.GetStatus();
+  TEST_ASSERT_EQUAL(NTP_SERVO_LOCK, st.state);
+  TEST_ASSERT_EQUAL_UINT32(2, st.missed);
+  TEST_ASSERT_EQUAL_UINT32(0, st.steps);
+  TEST_ASSERT_TRUE(fabs(sim_phase_error_ns()) < SIM_LATENCY_NS);
+  for(uint8_t i=0;i<NTP_SERVO_CATCHUP;i++){
+    sim_second();
+  }
+  TEST_ASSERT_EQUAL_UINT8(1, sim_edge());
+  st = sim->servo.GetStatus();
+  TEST_ASSERT_EQUAL(NTP_SERVO_LOCK, st.state);
+  TEST_ASSERT_EQUAL_UINT32(1, st.steps);
+  TEST_ASSERT_EQUAL_UINT8(NTP_SERVO_MINTAU, st.tau);
+}
+
+/* One edge far off is left out, NTP_SERVO_STEPOUT in a row move the phase */
+void test_spikes( void ){
+  sim_settle();
+  double off = 0.001 * sim->freq;
+  sim->servo.Edge(sim_second() + (uint64_t)off);
+  TEST_ASSERT_EQUAL(NTP_SERVO_SPIKE, sim->servo.GetState());
+  sim_edge();
+  TEST_ASSERT_EQUAL(NTP_SERVO_LOCK, sim->servo.GetState());
+  TEST_ASSERT_EQUAL_UINT32(0, sim->servo.GetStatus().steps);
+  /* A glitch within the same second is not an edge */
+  TEST_ASSERT_EQUAL_UINT8(0, sim->servo.Edge((uint64_t)( sim->ticks + ( 0.3 * sim->freq ) )));
+  TEST_ASSERT_EQUAL(NTP_SERVO_LOCK, sim->servo.GetState());
+  for(uint8_t i=0;i<NTP_SERVO_STEPOUT;i++){
+    sim->servo.Edge(sim_second() + (uint64_t)off);
+  }
+  ntp_servo_status_t st = sim->servo.GetStatus();
+  TEST_ASSERT_EQUAL(NTP_SERVO_LOCK, st.state);
+  TEST_ASSERT_EQUAL_UINT32(1, st.steps);
+  TEST_ASSERT_EQUAL_UINT32(2 + NTP_SERVO_STEPOUT, st.spikes);
+}
+
+/* Without edges the boundaries are predicted, the loop goes on once they are back */
+void test_holdover( void ){
+  char msg[120];
+  sim_settle();
+  for(uint32_t i=0;i<60;i++){
+    sim_second();
+    /* The caller looks some time into each second */
+    TEST_ASSERT_EQUAL_UINT8(1, sim->servo.Hold((uint64_t)( sim->ticks + ( 0.4 * sim->freq ) )));
+    TEST_ASSERT_EQUAL(NTP_SERVO_HOLD, sim->servo.GetState());
+  }
+  double held = sim_phase_error_ns();
+  snprintf(msg, sizeof(msg), "phase error after 60s of holdover %.0fns", held);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(fabs(held) < 2 * SIM_LATENCY_NS);
+  TEST_ASSERT_EQUAL_UINT8(1, sim_edge());
+  ntp_servo_status_t st = sim->servo.GetStatus();
+  TEST_ASSERT_EQUAL(NTP_SERVO_LOCK, st.state);
+  TEST_ASSERT_EQUAL_UINT32(0, st.steps);
+  TEST_ASSERT_EQUAL_UINT32(0, st.missed);
+}
+
+/* A holdover predicted from a frequency far off is stepped by the first edge */
+void test_holdover_step( void ){
+  sim_settle();
+  sim->servo.Hold((uint64_t)( sim->ticks + ( 0.4 * sim->freq ) ));
+  /* 50ppm off, 60s make 3ms */
+  sim->servo.SetHoldFrequency((int32_t)( SIM_PPM * 1000 ) + 50000);
+  for(uint32_t i=0;i<60;i++){
+    sim_second();
+    sim->servo.Hold((uint64_t)( sim->ticks + ( 0.4 * sim->freq ) ));
+  }
+  TEST_ASSERT_TRUE(fabs(sim_phase_error_ns()) > 1000000);
+  sim_edge();
+  ntp_servo_status_t st = sim->servo.GetStatus();
+  TEST_ASSERT_EQUAL(NTP_SERVO_LOCK, st.state);
+  TEST_ASSERT_EQUAL_UINT32(1, st.steps);
+  TEST_ASSERT_TRUE(fabs(sim_phase_error_ns()) < SIM_LATENCY_NS);
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_fll_to_pll);
+  RUN_TEST(test_lock);
+  RUN_TEST(test_stored_frequency);
+  RUN_TEST(test_missed_edges);
+  RUN_TEST(test_spikes);
+  RUN_TEST(test_holdover);
+  RUN_TEST(test_holdover_step);
+  return UNITY_END();
+}
@@ -0,0 +1,216 @@
+/*
+ * Load of the sub second clock. The old clock counted milliseconds in a 1kHz
+ * timer interrupt, the new one interpolates the timer on demand. Both are run
+ * as clock of the responder under 1000 requests a second, with the simulated
+ * interrupt on the same core as the requests, and the time per response and
+ * the interrupts taken are reported.
+ */
+#include <unity.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <atomic>
+#include "ntp_timestamp.h"
+#include "ntp_latency.h"
+#include "ntp_responder.h"
+
+#define LOAD_RATE ( 1000 )
+#define LOAD_REQUESTS ( 2000 )
+#define LOAD_CLIENTS ( 4096 )
+
+/* Start of the current second on the host clock, in ns */
+static uint64_t boundary_ns;
+static uint32_t boundary_seconds;
+
+/* The legacy clock, the millisecond counter and the interrupt driving it */
+static volatile uint32_t millisec;
+static volatile uint32_t legacy_seconds;
+static std::atomic_flag legacy_mux = ATOMIC_FLAG_INIT;
+static std::atomic<bool> legacy_run;
+static uint32_t legacy_isr_count;
+static uint64_t legacy_isr_ns;
+
+void setUp( void ){
+}
+
+void tearDown( void ){
+}
+
+static uint64_t host_ns( void ){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ( (uint64_t)ts.tv_sec * 1000000000ull ) + ts.tv_nsec;
+}
+
+/* Keeps the calling thread on the first core, the interrupt and the requests share it */
+static void pin_core0( void ){
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(0, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+/* The 1kHz interrupt, counts milliseconds and the seconds on overflow */
+static void* legacy_isr( void* arg ){
+  (void)arg;
+  pin_core0();
+  struct timespec next;
+  clock_gettime(CLOCK_MONOTONIC, &next);
+  while(true == legacy_run.load()){
+    next.tv_nsec += 1000000;
+    if(next.tv_nsec >= 1000000000){
+      next.tv_nsec -= 1000000000;
+      next.tv_sec++;
+    }
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+    uint64_t start = host_ns();
+    while(true == legacy_mux.test_and_set(std::memory_order_acquire)){
+    }
+    millisec = millisec + 1;
+    if(millisec >= 1000){
+      millisec = 0;
+      legacy_seconds = legacy_seconds + 1;
+    }
+    legacy_mux.clear(std::memory_order_release);
+    legacy_isr_ns += host_ns() - start;
+    legacy_isr_count++;
+  }
+  return NULL;
+}
+
+/* Time from the millisecond counter, as GetNTPTimestamp read it before */
+static ntp_timestamp_t legacy_read_time( void ){
+  ntp_timestamp_t ts;
+  while(true == legacy_mux.test_and_set(std::memory_order_acquire)){
+  }
+  ts.seconds = legacy_seconds;
+  ts.fraction = millisec * 4294967u;
+  legacy_mux.clear(std::memory_order_release);
+  return ts;
+}
+
+/* Time interpolated from the timer at the read, the host clock stands in for the timer */
+static ntp_timestamp_t ondemand_read_time( void ){
+  uint64_t seconds = boundary_seconds;
+  ntp_timestamp_t ts;
+  ts.fraction = ntp_interpolate_fraction(&seconds, host_ns() - boundary_ns, 1000000000u, true);
+  ts.seconds = (uint32_t)seconds;
+  return ts;
+}
+
+/* A mode 3 request of a client */
+static void build_request( uint8_t* data, uint32_t n ){
+  memset(data, 0, sizeof(ntp_packet_t));
+  data[0] = ( 4 << 3 ) | 3;
+  data[40] = (uint8_t)( n >> 24 );
+  data[41] = (uint8_t)( n >> 16 );
+  data[42] = (uint8_t)( n >> 8 );
+  data[43] = (uint8_t)n;
+}
+
+/* Answers LOAD_RATE requests a second from as many clients and returns the summary of the time per response */
+static ntp_latency_summary_t run_load( NTP_Responder* responder, ntp_timestamp_t(*read_time)(void), uint32_t* answered ){
+  static NTP_LatencyStats stats;
+  stats = NTP_LatencyStats();
+  uint8_t data[sizeof(ntp_packet_t)];
+  uint8_t out[NTP_PACKET_MAX_LEN];
+  ntp_server_state_t state = responder->GetServerState();
+  state.leap = 0;
+  state.stratum = 1;
+  memcpy(state.refid, "GPS", 4);
+  responder->SetServerState(&state);
+  responder->SetClock(read_time, NULL);
+  *answered = 0;
+  struct timespec next;
+  clock_gettime(CLOCK_MONOTONIC, &next);
+  for(uint32_t i=0;i<LOAD_REQUESTS;i++){
+    next.tv_nsec += 1000000000 / LOAD_RATE;
+    if(next.tv_nsec >= 1000000000){
+      next.tv_nsec -= 1000000000;
+      next.tv_sec++;
+    }
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+    ntp_client_t client = NTP_Responder::ClientV4(0x0A000000u + ( i % LOAD_CLIENTS ));
+    build_request(data, i);
+    uint32_t start = NTP_LatencyStats::Now();
+    uint16_t len = responder->Respond(&client, data, sizeof(data), out, read_time(), 0);
+    stats.Add(NTP_LATENCY_RESPOND, start, NTP_LatencyStats::Now());
+    if(len == sizeof(ntp_packet_t)){
+      (*answered)++;
+    }
+  }
+  return stats.GetSummary(NTP_LATENCY_RESPOND);
+}
+
+static void report( const char* name, ntp_latency_summary_t s ){
+  char msg[120];
+  uint32_t per_us = NTP_LatencyStats::GetCyclesPerUs();
+  snprintf(msg, sizeof(msg), "%s: %u responses, p50 %.2f us, p99 %.2f us, max %.2f us", name, s.count,
+           (double)s.p50 / per_us, (double)s.p99 / per_us, (double)s.max / per_us);
+  TEST_MESSAGE(msg);
+}
+
+/* The on demand clock resolves the timer, the millisecond counter only whole ms */
+void test_ondemand_resolution( void ){
+  boundary_ns = host_ns();
+  boundary_seconds = 3900000000u;
+  ntp_timestamp_t a = ondemand_read_time();
+  ntp_timestamp_t b = ondemand_read_time();
+  for(uint16_t i=0;(i<1000) && (a.fraction == b.fraction);i++){
+    b = ondemand_read_time();
+  }
+  TEST_ASSERT_EQUAL_UINT32(a.seconds, b.seconds);
+  TEST_ASSERT_TRUE(b.fraction > a.fraction);
+  TEST_ASSERT_TRUE( ( b.fraction - a.fraction ) < 4294967u );
+  /* A second with the PPS overdue runs on into the next one */
+  boundary_ns = host_ns() - 1500000000ull;
+  ntp_timestamp_t c = ondemand_read_time();
+  TEST_ASSERT_EQUAL_UINT32(boundary_seconds + 1, c.seconds);
+}
+
+/* The same load with the interrupt ticking and with the clock read on demand */
+void test_load_1000_per_second( void ){
+  char msg[120];
+  uint32_t answered;
+  pin_core0();
+
+  NTP_Responder* legacy = new NTP_Responder();
+  pthread_t isr;
+  millisec = 0;
+  legacy_seconds = 3900000000u;
+  legacy_isr_count = 0;
+  legacy_isr_ns = 0;
+  legacy_run.store(true);
+  TEST_ASSERT_EQUAL(0, pthread_create(&isr, NULL, legacy_isr, NULL));
+  uint64_t start = host_ns();
+  ntp_latency_summary_t with_isr = run_load(legacy, legacy_read_time, &answered);
+  uint64_t elapsed = host_ns() - start;
+  legacy_run.store(false);
+  pthread_join(isr, NULL);
+  delete legacy;
+  TEST_ASSERT_EQUAL_UINT32(LOAD_REQUESTS, answered);
+  report("1kHz interrupt", with_isr);
+
+  NTP_Responder* ondemand = new NTP_Responder();
+  boundary_ns = host_ns();
+  boundary_seconds = 3900000000u;
+  ntp_latency_summary_t without_isr = run_load(ondemand, ondemand_read_time, &answered);
+  delete ondemand;
+  TEST_ASSERT_EQUAL_UINT32(LOAD_REQUESTS, answered);
+  report("on demand", without_isr);
+
+  /* All of the interrupts are gone, the counter ran at close to its rate while the load ran */
+  double rate = (double)legacy_isr_count * 1e9 / (double)elapsed;
+  snprintf(msg, sizeof(msg), "interrupts removed: %.0f/s, %.2f us each, %.3f%% of the core",
+           rate, (double)legacy_isr_ns / 1000.0 / legacy_isr_count, (double)legacy_isr_ns * 100.0 / (double)elapsed);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(rate > 0.9 * 1000);
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_ondemand_resolution);
+  RUN_TEST(test_load_1000_per_second);
+  return UNITY_END();
+}
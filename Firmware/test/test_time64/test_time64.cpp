@@ -0,0 +1,134 @@
+/*
+ * 32.32 NTP time and civil dates. The seconds wrap on 7.2.2036, differences
+ * hold across the wrap and the era is resolved against a pivot. Every day from
+ * 1900 to 2400 goes through the civil date conversion and back and is checked
+ * against the C library.
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <time.h>
+#include "ntp_timestamp.h"
+
+/* 7.2.2036 06:28:16 UTC, the first second of NTP era 1 */
+#define ERA1_UNIX ( 2085978496ll )
+
+/* Half the range of the 32 bit seconds, the farthest a time may be from its pivot */
+#define PIVOT_RANGE ( 2147483647ll )
+
+/* The conversions are constexpr, the constants below are checked while compiling */
+static_assert(ntp_days_from_civil(1970, 1, 1) == 0, "UNIX epoch");
+static_assert(ntp_days_from_civil(2040, 1, 1) * 86400 == NTP_TIME64_PIVOT, "pivot is 1.1.2040");
+static_assert(ntp_time64_from_unix(0, 0) == ( NTP_TIMESTAMP_DELTA << 32 ), "UNIX epoch in NTP time");
+
+void setUp( void ){
+}
+
+void tearDown( void ){
+}
+
+/* The last second of era 0 and the first of era 1 */
+void test_rollover_2036( void ){
+  ntp_time64_t last = ntp_time64_from_unix(ERA1_UNIX - 1, 0x80000000u);
+  ntp_time64_t first = ntp_time64_from_unix(ERA1_UNIX, 0);
+  TEST_ASSERT_EQUAL_UINT32(0, ntp_time64_era(ERA1_UNIX - 1));
+  TEST_ASSERT_EQUAL_UINT32(1, ntp_time64_era(ERA1_UNIX));
+  TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFu, ntp_time64_seconds(last));
+  TEST_ASSERT_EQUAL_UINT32(0, ntp_time64_seconds(first));
+  /* On the wire the seconds start over from 0 */
+  ntp_timestamp_t ts = ntp_time64_to_timestamp(first);
+  TEST_ASSERT_EQUAL_UINT32(0, ts.seconds);
+  TEST_ASSERT_EQUAL_UINT32(0, ts.fraction);
+  TEST_ASSERT_TRUE(ntp_time64_from_timestamp(ts) == first);
+  /* Differences are taken across the wrap */
+  TEST_ASSERT_TRUE(ntp_time64_diff(first, last) == (int64_t)( NTP_TIME64_SECOND / 2 ));
+  TEST_ASSERT_TRUE(ntp_time64_diff(last, first) == -(int64_t)( NTP_TIME64_SECOND / 2 ));
+  TEST_ASSERT_TRUE(ntp_time64_diff(first + ( 10 * NTP_TIME64_SECOND ), last) == (int64_t)( 21 * NTP_TIME64_SECOND / 2 ));
+  /* Both resolve to their era with the default pivot */
+  TEST_ASSERT_TRUE(ntp_time64_to_unix(last, NTP_TIME64_PIVOT) == ERA1_UNIX - 1);
+  TEST_ASSERT_TRUE(ntp_time64_to_unix(first, NTP_TIME64_PIVOT) == ERA1_UNIX);
+}
+
+/* The default pivot covers 13.12.1971 20:45:52 to 20.1.2108 03:14:07 */
+void test_pivot_window( void ){
+  int64_t low = NTP_TIME64_PIVOT - PIVOT_RANGE - 1;
+  int64_t high = NTP_TIME64_PIVOT + PIVOT_RANGE;
+  int32_t year;
+  uint8_t month;
+  uint8_t day;
+  ntp_civil_from_days(low / 86400, &year, &month, &day);
+  TEST_ASSERT_EQUAL_INT32(1971, year);
+  TEST_ASSERT_EQUAL_UINT8(12, month);
+  TEST_ASSERT_EQUAL_UINT8(13, day);
+  TEST_ASSERT_TRUE(low % 86400 == ( 20 * 3600 ) + ( 45 * 60 ) + 52);
+  ntp_civil_from_days(high / 86400, &year, &month, &day);
+  TEST_ASSERT_EQUAL_INT32(2108, year);
+  TEST_ASSERT_EQUAL_UINT8(1, month);
+  TEST_ASSERT_EQUAL_UINT8(20, day);
+  TEST_ASSERT_TRUE(high % 86400 == ( 3 * 3600 ) + ( 14 * 60 ) + 7);
+  TEST_ASSERT_TRUE(ntp_time64_to_unix(ntp_time64_from_unix(low, 0), NTP_TIME64_PIVOT) == low);
+  TEST_ASSERT_TRUE(ntp_time64_to_unix(ntp_time64_from_unix(high, 0), NTP_TIME64_PIVOT) == high);
+  /* One second past either end lands in the neighbouring era */
+  TEST_ASSERT_TRUE(ntp_time64_to_unix(ntp_time64_from_unix(low - 1, 0), NTP_TIME64_PIVOT) == low - 1 + ( 1ll << 32 ));
+  TEST_ASSERT_TRUE(ntp_time64_to_unix(ntp_time64_from_unix(high + 1, 0), NTP_TIME64_PIVOT) == high + 1 - ( 1ll << 32 ));
+}
+
+/* Dates around 2036, 2038 and 2106 resolved against pivots up to 68 years away */
+void test_pivot_distance( void ){
+  const int64_t dates[] = {
+    0,
+    946684800,                                          /* 1.1.2000 */
+    ERA1_UNIX,
+    ntp_days_from_civil(2038, 1, 19) * 86400 + 11647,   /* 32 bit time_t overflow */
+    ntp_days_from_civil(2106, 2, 7) * 86400 + 23296,    /* 32 bit unsigned time_t overflow */
+    ntp_days_from_civil(2200, 6, 1) * 86400
+  };
+  uint32_t checked = 0;
+  for(uint8_t i=0;i<sizeof(dates)/sizeof(dates[0]);i++){
+    ntp_time64_t t = ntp_time64_from_unix(dates[i], 0x80000000u);
+    TEST_ASSERT_EQUAL_UINT32(0x80000000u, ntp_time64_fraction(t));
+    for(int64_t off=-PIVOT_RANGE;off<=PIVOT_RANGE;off+=( 86400ll * 365 * 7 ) + 12345){
+      TEST_ASSERT_TRUE(ntp_time64_to_unix(t, dates[i] + off) == dates[i]);
+      checked++;
+    }
+    TEST_ASSERT_TRUE(ntp_time64_to_unix(t, dates[i] + PIVOT_RANGE) == dates[i]);
+  }
+  TEST_ASSERT_TRUE(checked > 50);
+}
+
+/* Every day from 1900 to 2400 through the civil date and back, against gmtime */
+void test_civil_round_trip( void ){
+  int64_t first = ntp_days_from_civil(1900, 1, 1);
+  int64_t last = ntp_days_from_civil(2400, 12, 31);
+  TEST_ASSERT_TRUE(sizeof(time_t) >= 8);
+  for(int64_t d=first;d<=last;d++){
+    int32_t year;
+    uint8_t month;
+    uint8_t day;
+    struct tm tm;
+    time_t t = (time_t)( d * 86400 );
+    ntp_civil_from_days(d, &year, &month, &day);
+    gmtime_r(&t, &tm);
+    if( (ntp_days_from_civil(year, month, day) != d) || (tm.tm_year + 1900 != year) ||
+        (tm.tm_mon + 1 != month) || (tm.tm_mday != day) || (tm.tm_wday != ntp_weekday_from_days(d)) ){
+      char msg[80];
+      snprintf(msg, sizeof(msg), "day %lld gives %d-%u-%u", (long long)d, year, month, day);
+      TEST_FAIL_MESSAGE(msg);
+    }
+  }
+  /* 1900 and 2100 are no leap years, 2000 and 2400 are */
+  TEST_ASSERT_TRUE(ntp_days_from_civil(1900, 3, 1) - ntp_days_from_civil(1900, 2, 28) == 1);
+  TEST_ASSERT_TRUE(ntp_days_from_civil(2000, 3, 1) - ntp_days_from_civil(2000, 2, 28) == 2);
+  TEST_ASSERT_TRUE(ntp_days_from_civil(2100, 3, 1) - ntp_days_from_civil(2100, 2, 28) == 1);
+  TEST_ASSERT_TRUE(ntp_days_from_civil(2400, 3, 1) - ntp_days_from_civil(2400, 2, 28) == 2);
+  /* 1.1.1970 was a Thursday */
+  TEST_ASSERT_EQUAL_UINT8(4, ntp_weekday_from_days(0));
+}
+
+int main( int argc, char **argv ){
+  UNITY_BEGIN();
+  RUN_TEST(test_rollover_2036);
+  RUN_TEST(test_pivot_window);
+  RUN_TEST(test_pivot_distance);
+  RUN_TEST(test_civil_round_trip);
+  return UNITY_END();
+}